@@ -16,6 +16,7 @@
 #include "db/config.hh"
 #include "cdc/generation_service.hh"
 #include "service/memory_limiter.hh"
+#include "service/strong_consistency/coordinator.hh"
 #include "auth/service.hh"
 #include "service/qos/service_level_controller.hh"
 #include "vector_search/vector_store_client.hh"
@@ -29,6 +30,7 @@ static logging::logger logger("alternator_controller");
 controller::controller(
         sharded<gms::gossiper>& gossiper,
         sharded<service::storage_proxy>& proxy,
+        sharded<service::strong_consistency::coordinator>& sc_coordinator,
         sharded<service::storage_service>& ss,
         sharded<service::migration_manager>& mm,
         sharded<db::system_distributed_keyspace>& sys_dist_ks,
@@ -38,12 +40,14 @@ controller::controller(
         sharded<auth::service>& auth_service,
         sharded<qos::service_level_controller>& sl_controller,
         sharded<vector_search::vector_store_client>& vsc,
+        sharded<netw::messaging_service>& ms,
         sharded<updateable_timeout_config>& timeout_config,
         const db::config& config,
         seastar::scheduling_group sg)
     : protocol_server(sg)
     , _gossiper(gossiper)
     , _proxy(proxy)
+    , _sc_coordinator(sc_coordinator)
     , _ss(ss)
     , _mm(mm)
     , _sys_dist_ks(sys_dist_ks)
@@ -53,6 +57,7 @@ controller::controller(
     , _auth_service(auth_service)
     , _sl_controller(sl_controller)
     , _vsc(vsc)
+    , _ms(ms)
     , _timeout_config(timeout_config)
     , _config(config)
 {
@@ -98,9 +103,10 @@ future<> controller::start_server() {
         auto get_timeout_in_ms = [] (const db::config& cfg) -> utils::updateable_value<uint32_t> {
             return cfg.alternator_timeout_in_ms;
         };
-        _executor.start(std::ref(_gossiper), std::ref(_proxy), std::ref(_ss), std::ref(_mm), std::ref(_sys_dist_ks), std::ref(_sys_ks),
-                        sharded_parameter(get_cdc_metadata, std::ref(_cdc_gen_svc)), std::ref(_vsc), _ssg.value(),
+        _executor.start(std::ref(_gossiper), std::ref(_proxy), std::ref(_sc_coordinator), std::ref(_ss), std::ref(_mm), std::ref(_sys_dist_ks), std::ref(_sys_ks),
+                        sharded_parameter(get_cdc_metadata, std::ref(_cdc_gen_svc)), std::ref(_vsc), std::ref(_ms), std::ref(_auth_service), std::ref(_sl_controller), _ssg.value(),
                         sharded_parameter(get_timeout_in_ms, std::ref(_config))).get();
+        _executor.invoke_on_all(&executor::start).get();
         _server.start(std::ref(_executor), std::ref(_proxy), std::ref(_gossiper), std::ref(_auth_service), std::ref(_sl_controller), std::ref(_timeout_config)).get();
         // Note: from this point on, if start_server() throws for any reason,
         // it must first call stop_server() to stop the executor and server
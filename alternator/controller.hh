@@ -18,6 +18,9 @@ class storage_proxy;
 class storage_service;
 class migration_manager;
 class memory_limiter;
+namespace strong_consistency {
+class coordinator;
+}
 }
 
 namespace db {
@@ -48,6 +51,10 @@ namespace vector_search {
 class vector_store_client;
 }
 
+namespace netw {
+class messaging_service;
+}
+
 class updateable_timeout_config;
 
 namespace alternator {
@@ -65,6 +72,7 @@ class server;
 class controller : public protocol_server {
     sharded<gms::gossiper>& _gossiper;
     sharded<service::storage_proxy>& _proxy;
+    sharded<service::strong_consistency::coordinator>& _sc_coordinator;
     sharded<service::storage_service>& _ss;
     sharded<service::migration_manager>& _mm;
     sharded<db::system_distributed_keyspace>& _sys_dist_ks;
@@ -74,6 +82,7 @@ class controller : public protocol_server {
     sharded<auth::service>& _auth_service;
     sharded<qos::service_level_controller>& _sl_controller;
     sharded<vector_search::vector_store_client>& _vsc;
+    sharded<netw::messaging_service>& _ms;
     sharded<updateable_timeout_config>& _timeout_config;
     const db::config& _config;
 
@@ -86,6 +95,7 @@ class controller : public protocol_server {
     controller(
         sharded<gms::gossiper>& gossiper,
         sharded<service::storage_proxy>& proxy,
+        sharded<service::strong_consistency::coordinator>& sc_coordinator,
         sharded<service::storage_service>& ss,
         sharded<service::migration_manager>& mm,
         sharded<db::system_distributed_keyspace>& sys_dist_ks,
@@ -95,6 +105,7 @@ class controller : public protocol_server {
         sharded<auth::service>& auth_service,
         sharded<qos::service_level_controller>& sl_controller,
         sharded<vector_search::vector_store_client>& vsc,
+        sharded<netw::messaging_service>& ms,
         sharded<updateable_timeout_config>& timeout_config,
         const db::config& config,
         seastar::scheduling_group sg);
@@ -63,6 +63,7 @@
 #include "gms/feature_service.hh"
 #include "gms/gossiper.hh"
 #include "utils/error_injection.hh"
+#include "utils/exceptions.hh"
 #include "db/schema_tables.hh"
 #include "utils/rjson.hh"
 #include "alternator/extract_from_attrs.hh"
@@ -70,11 +71,18 @@
 #include "db/system_keyspace.hh"
 #include "cql3/statements/ks_prop_defs.hh"
 #include "cql3/statements/index_target.hh"
+#include "cql3/statements/strong_consistency/statement_helpers.hh"
 #include "index/secondary_index.hh"
 #include "alternator/ttl_tag.hh"
 #include "vector_search/vector_store_client.hh"
 #include "utils/simple_value_with_expiry.hh"
 #include "service/paxos/paxos_state.hh"
+#include "service/strong_consistency/coordinator.hh"
+#include "locator/tablet_replication_strategy.hh"
+#include "alternator/forward.hh"
+#include "idl/alternator.dist.hh"
+#include "message/messaging_service.hh"
+#include "tracing/tracing.hh"
 
 using namespace std::chrono_literals;
 
@@ -280,22 +288,30 @@ class executor::describe_table_info_manager : public service::migration_listener
 
 executor::executor(gms::gossiper& gossiper,
          service::storage_proxy& proxy,
+         service::strong_consistency::coordinator& sc_coordinator,
          service::storage_service& ss,
          service::migration_manager& mm,
          db::system_distributed_keyspace& sdks,
          db::system_keyspace& system_keyspace,
          cdc::metadata& cdc_metadata,
          vector_search::vector_store_client& vsc,
+         netw::messaging_service& ms,
+         auth::service& auth_service,
+         qos::service_level_controller& sl_controller,
          smp_service_group ssg,
          utils::updateable_value<uint32_t> default_timeout_in_ms)
     : _gossiper(gossiper),
       _ss(ss),
       _proxy(proxy),
+      _sc_coordinator(sc_coordinator),
       _mm(mm),
       _sdks(sdks),
       _system_keyspace(system_keyspace),
       _cdc_metadata(cdc_metadata),
       _vsc(vsc),
+      _ms(ms),
+      _auth_service(auth_service),
+      _sl_controller(sl_controller),
       _enforce_authorization(_proxy.data_dictionary().get_config().alternator_enforce_authorization),
       _warn_authorization(_proxy.data_dictionary().get_config().alternator_warn_authorization),
       _audit(audit::audit::audit_instance()),
@@ -2430,6 +2446,10 @@ class put_or_delete_item {
     // that length can have different meaning depends on the operation but the
     // the calculation of length in bytes to WCU is the same.
     uint64_t _length_in_bytes = 0;
+    // BatchWriteItem: the WriteRequest the item was parsed from. An item of a
+    // strongly consistent table is forwarded in a BatchWriteItem of its own
+    // to the Raft leader of its tablet, see executor::raft_write().
+    const rjson::value* _write_request = nullptr;
 public:
     struct delete_item {};
     struct put_item {};
@@ -2449,6 +2469,12 @@ class put_or_delete_item {
     bool is_put_item() noexcept {
         return _cells.has_value();
     }
+    const rjson::value* write_request() const noexcept {
+        return _write_request;
+    }
+    void set_write_request(const rjson::value& write_request) noexcept {
+        _write_request = &write_request;
+    }
 };
 
 put_or_delete_item::put_or_delete_item(const rjson::value& key, schema_ptr schema, delete_item)
@@ -2645,7 +2671,7 @@ put_or_delete_item::put_or_delete_item(const rjson::value& item, schema_ptr sche
                 // ScyllaDB uses one extra byte compared to DynamoDB for the bytes length
                 _length_in_bytes += value.size() - 1;
             }
-            _cells->push_back({std::move(column_name), serialize_item(it->value)});
+            _cells->push_back({std::move(column_name), std::move(value)});
         } else if (!cdef->is_primary_key()) {
             // Fixed-type regular columns were used for LSIs and also (in the
             // slightly more distant past) GSIs, before they were moved to
@@ -2815,10 +2841,32 @@ rmw_operation::parse_returnvalues_on_condition_check_failure(const rjson::value&
     }
 }
 
+// Writes to a table in a strongly consistent keyspace are done by the Raft group
+// of the item's tablet. CDC isn't supported for them, so tables with Streams
+// enabled keep writing through storage_proxy.
+static bool writes_through_raft(service::storage_proxy& proxy, const schema& schema) {
+    return cql3::statements::strong_consistency::is_strongly_consistent(proxy.data_dictionary(), schema.ks_name())
+            && !schema.cdc_options().enabled();
+}
+
+// Thrown by a write which another node forwarded to this one, when this node
+// doesn't lead the Raft group of the item's tablet anymore. It isn't forwarded
+// again; instead handle_forwarded_write() tells the forwarding node where to
+// send it.
+class raft_redirect : public std::exception {
+public:
+    locator::tablet_replica target;
+    explicit raft_redirect(locator::tablet_replica target) : target(target) {}
+    virtual const char* what() const noexcept override {
+        return "The write must be redirected to the leader of the tablet's Raft group";
+    }
+};
+
 rmw_operation::rmw_operation(service::storage_proxy& proxy, rjson::value&& request)
     : _request(std::move(request))
     , _schema(get_table_for_write(proxy, _request))
     , _write_isolation(get_write_isolation_for_schema(_schema))
+    , _write_through_raft(writes_through_raft(proxy, *_schema))
     , _consumed_capacity(_request)
     , _returnvalues(parse_returnvalues(_request))
     , _returnvalues_on_condition_check_failure(parse_returnvalues_on_condition_check_failure(_request))
@@ -2879,6 +2927,11 @@ rmw_operation::write_isolation rmw_operation::get_write_isolation_for_schema(sch
 // the tablet shard won't change. The caller must hold the returned object for
 // the duration of execution, even if we were already on the right shard - so it doesn't move.
 std::optional<service::cas_shard> rmw_operation::shard_for_execute(bool needs_read_before_write) {
+    // A write through Raft must be done on the shard of the tablet's Raft group,
+    // which is the same shard cas() would be called on.
+    if (_write_through_raft) {
+        return service::cas_shard(*_schema, dht::get_token(*_schema, _pk));
+    }
     if (_write_isolation == write_isolation::FORBID_RMW ||
         (_write_isolation == write_isolation::LWT_RMW_ONLY && !needs_read_before_write) ||
         _write_isolation == write_isolation::UNSAFE_RMW) {
@@ -2949,6 +3002,7 @@ static future<std::variant<uint64_t, api_error>> get_previous_item_size(
 }
 
 future<executor::request_return_type> rmw_operation::execute(service::storage_proxy& proxy,
+        service::strong_consistency::coordinator& sc_coordinator,
         std::optional<service::cas_shard> cas_shard,
         service::client_state& client_state,
         tracing::trace_state_ptr trace_state,
@@ -2967,7 +3021,7 @@ future<executor::request_return_type> rmw_operation::execute(service::storage_pr
         }
         global_stats.reads_before_write++;
         per_table_stats.reads_before_write++;
-        if (_write_isolation == write_isolation::UNSAFE_RMW) {
+        if (_write_isolation == write_isolation::UNSAFE_RMW && !_write_through_raft) {
             // This is the old, unsafe, read before write which does first
             // a read, then a write. TODO: remove this mode entirely.
             return get_previous_item(proxy, client_state, schema(), _pk, _ck, permit, db::consistency_level::LOCAL_QUORUM, _consumed_capacity._total_bytes).then(
@@ -2987,15 +3041,86 @@ future<executor::request_return_type> rmw_operation::execute(service::storage_pr
                 });
             });
         }
-    } else if (_write_isolation != write_isolation::LWT_ALWAYS) {
+    } else if (_write_isolation != write_isolation::LWT_ALWAYS && !_write_through_raft) {
         std::optional<mutation> m = apply(nullptr, api::new_timestamp(), cdc_opts);
         throwing_assert(m); // !needs_read_before_write, so apply() did not check a condition
         return proxy.mutate(utils::chunked_vector<mutation>{std::move(*m)}, db::consistency_level::LOCAL_QUORUM, executor::default_timeout(), trace_state, std::move(permit), db::allow_per_partition_rate_limit::yes, false, std::move(cdc_opts)).then([this, &wcu_total] () mutable {
             return rmw_operation_return(std::move(_return_attributes), _consumed_capacity, wcu_total);
         });
     }
+    if (_write_through_raft) {
+        // Whatever the write isolation policy, neither storage_proxy::mutate()
+        // nor LWT may bypass the Raft group which orders the writes of the item.
+        return execute_through_raft(proxy, sc_coordinator, trace_state, needs_read_before_write, global_stats, per_table_stats, wcu_total);
+    }
     throwing_assert(cas_shard);
-    // If we're still here, we need to do this write using LWT:
+    return execute_using_lwt(proxy, std::move(*cas_shard), client_state, std::move(trace_state), std::move(permit),
+            needs_read_before_write, global_stats, per_table_stats, wcu_total, std::move(cdc_opts));
+}
+
+// The item is written by the Raft group of its tablet, which orders the writes,
+// so neither a conditional write, nor an unconditional one, needs LWT: the
+// condition is checked on the leader, which then writes the item in a single
+// Raft round trip. If the leader is on another shard or node, nothing is
+// written: _raft_redirect is set instead, and the caller sends the request to
+// the leader, see executor::redirect_raft_write().
+future<executor::request_return_type> rmw_operation::execute_through_raft(service::storage_proxy& proxy,
+        service::strong_consistency::coordinator& sc_coordinator,
+        tracing::trace_state_ptr trace_state,
+        bool needs_read_before_write,
+        stats& global_stats,
+        stats& per_table_stats,
+        uint64_t& wcu_total) {
+    // CDC is disabled for tables written through Raft, see writes_through_raft().
+    auto cdc_opts = cdc::per_request_options{.alternator = true};
+    auto timeout = executor::default_timeout();
+    auto dk = dht::decorate_key(*_schema, _pk);
+    abort_source as;
+    service::strong_consistency::value_or_redirect<bool> result;
+    if (!needs_read_before_write) {
+        auto mutate_result = co_await sc_coordinator.mutate(_schema, dk.token(), [&] (api::timestamp_type ts) {
+            std::optional<mutation> m = apply(nullptr, ts, cdc_opts);
+            throwing_assert(m); // !needs_read_before_write, so apply() did not check a condition
+            return std::move(*m);
+        }, timeout, as);
+        if (auto* redirect = std::get_if<service::strong_consistency::need_redirect>(&mutate_result)) {
+            result = std::move(*redirect);
+        } else {
+            result = true;
+        }
+    } else {
+        auto selection = cql3::selection::selection::wildcard(schema());
+        auto read_command = previous_item_read_command(proxy, schema(), _ck, selection);
+        result = co_await sc_coordinator.mutate_if(_schema, dk, *read_command,
+                [&] (lw_shared_ptr<query::result> qr, api::timestamp_type ts) {
+            return apply(make_foreign(std::move(qr)), read_command->slice, ts, cdc_opts);
+        }, trace_state, timeout, as);
+    }
+    if (auto* redirect = std::get_if<service::strong_consistency::need_redirect>(&result)) {
+        // The caller ignores the return value when _raft_redirect is set.
+        _raft_redirect = std::move(*redirect);
+        co_return executor::request_return_type{};
+    }
+    global_stats.write_using_raft++;
+    per_table_stats.write_using_raft++;
+    if (!std::get<bool>(result)) {
+        global_stats.conditional_check_failed++;
+        per_table_stats.conditional_check_failed++;
+        co_return api_error::conditional_check_failed("The conditional request failed", std::move(_return_attributes));
+    }
+    co_return rmw_operation_return(std::move(_return_attributes), _consumed_capacity, wcu_total);
+}
+
+future<executor::request_return_type> rmw_operation::execute_using_lwt(service::storage_proxy& proxy,
+        service::cas_shard cas_shard,
+        service::client_state& client_state,
+        tracing::trace_state_ptr trace_state,
+        service_permit permit,
+        bool needs_read_before_write,
+        stats& global_stats,
+        stats& per_table_stats,
+        uint64_t& wcu_total,
+        cdc::per_request_options cdc_opts) {
     global_stats.write_using_lwt++;
     per_table_stats.write_using_lwt++;
     auto timeout = executor::default_timeout();
@@ -3003,7 +3128,7 @@ future<executor::request_return_type> rmw_operation::execute(service::storage_pr
     auto read_command = needs_read_before_write ?
             previous_item_read_command(proxy, schema(), _ck, selection) :
             nullptr;
-    return proxy.cas(schema(), std::move(*cas_shard), *this, read_command, to_partition_ranges(*schema(), _pk),
+    return proxy.cas(schema(), std::move(cas_shard), *this, read_command, to_partition_ranges(*schema(), _pk),
             {timeout, std::move(permit), client_state, trace_state},
             db::consistency_level::LOCAL_SERIAL, db::consistency_level::LOCAL_QUORUM, timeout, timeout, true, std::move(cdc_opts)).then([this, read_command, &wcu_total, &global_stats, &per_table_stats] (service::storage_proxy::cas_result cas_result) mutable {
         if (!cas_result.is_applied) {
@@ -3103,7 +3228,7 @@ class put_item_operation : public rmw_operation {
     virtual ~put_item_operation() = default;
 };
 
-future<executor::request_return_type> executor::put_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info) {
+future<executor::request_return_type> executor::put_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info, is_forwarded forwarded) {
     _stats.api_operations.put_item++;
     auto start_time = std::chrono::steady_clock::now();
     elogger.trace("put_item {}", request);
@@ -3128,23 +3253,28 @@ future<executor::request_return_type> executor::put_item(client_state& client_st
 
     if (cas_shard && !cas_shard->this_shard()) {
         _stats.api_operations.put_item--; // uncount on this shard, will be counted in other shard
-        _stats.shard_bounce_for_lwt++;
+        ++(op->write_through_raft() ? _stats.shard_bounce_for_raft : _stats.shard_bounce_for_lwt);
         co_return co_await container().invoke_on(cas_shard->shard(), _ssg,
-                [request = std::move(*op).move_request(), cs = client_state.move_to_other_shard(), gt = tracing::global_trace_state_ptr(trace_state), permit = std::move(permit), &audit_info]
+                [request = std::move(*op).move_request(), cs = client_state.move_to_other_shard(), gt = tracing::global_trace_state_ptr(trace_state), permit = std::move(permit), &audit_info, forwarded]
                 (executor& e) mutable {
-            return do_with(cs.get(), [&e, request = std::move(request), trace_state = tracing::trace_state_ptr(gt), &audit_info]
+            return do_with(cs.get(), [&e, request = std::move(request), trace_state = tracing::trace_state_ptr(gt), &audit_info, forwarded]
                                      (service::client_state& client_state) mutable {
                 //FIXME: Instead of passing empty_service_permit() to the background operation,
                 // the current permit's lifetime should be prolonged, so that it's destructed
                 // only after all background operations are finished as well.
-                return e.put_item(client_state, std::move(trace_state), empty_service_permit(), std::move(request), audit_info);
+                return e.put_item(client_state, std::move(trace_state), empty_service_permit(), std::move(request), audit_info, forwarded);
             });
         });
     }
     lw_shared_ptr<stats> per_table_stats = get_stats_from_schema(_proxy, *(op->schema()));
     per_table_stats->api_operations.put_item++;
     uint64_t wcu_total = 0;
-    auto res = co_await op->execute(_proxy, std::move(cas_shard), client_state, trace_state, std::move(permit), needs_read_before_write, _stats, *per_table_stats, wcu_total);
+    auto res = co_await op->execute(_proxy, _sc_coordinator, std::move(cas_shard), client_state, trace_state, std::move(permit), needs_read_before_write, _stats, *per_table_stats, wcu_total);
+    if (auto redirect = op->take_raft_redirect()) {
+        _stats.api_operations.put_item--; // uncount on this node, will be counted where the write is done
+        per_table_stats->api_operations.put_item--;
+        co_return co_await redirect_raft_write("PutItem", std::move(*op).move_request(), std::move(*redirect), client_state, std::move(trace_state), forwarded);
+    }
     per_table_stats->operation_sizes.put_item_op_size_kb.add(bytes_to_kb_ceil(op->consumed_capacity()._total_bytes));
     per_table_stats->wcu_total[stats::wcu_types::PUT_ITEM] += wcu_total;
     _stats.wcu_total[stats::wcu_types::PUT_ITEM] += wcu_total;
@@ -3216,7 +3346,7 @@ class delete_item_operation : public rmw_operation {
     virtual ~delete_item_operation() = default;
 };
 
-future<executor::request_return_type> executor::delete_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info) {
+future<executor::request_return_type> executor::delete_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info, is_forwarded forwarded) {
     _stats.api_operations.delete_item++;
     auto start_time = std::chrono::steady_clock::now();
     elogger.trace("delete_item {}", request);
@@ -3242,23 +3372,28 @@ future<executor::request_return_type> executor::delete_item(client_state& client
 
     if (cas_shard && !cas_shard->this_shard()) {
         _stats.api_operations.delete_item--; // uncount on this shard, will be counted in other shard
-        _stats.shard_bounce_for_lwt++;
-        per_table_stats->shard_bounce_for_lwt++;
+        ++(op->write_through_raft() ? _stats.shard_bounce_for_raft : _stats.shard_bounce_for_lwt);
+        ++(op->write_through_raft() ? per_table_stats->shard_bounce_for_raft : per_table_stats->shard_bounce_for_lwt);
         co_return co_await container().invoke_on(cas_shard->shard(), _ssg,
-                [request = std::move(*op).move_request(), cs = client_state.move_to_other_shard(), gt = tracing::global_trace_state_ptr(trace_state), permit = std::move(permit), &audit_info]
+                [request = std::move(*op).move_request(), cs = client_state.move_to_other_shard(), gt = tracing::global_trace_state_ptr(trace_state), permit = std::move(permit), &audit_info, forwarded]
                 (executor& e) mutable {
-            return do_with(cs.get(), [&e, request = std::move(request), trace_state = tracing::trace_state_ptr(gt), &audit_info]
+            return do_with(cs.get(), [&e, request = std::move(request), trace_state = tracing::trace_state_ptr(gt), &audit_info, forwarded]
                                      (service::client_state& client_state) mutable {
                 //FIXME: Instead of passing  empty_service_permit() to the background operation,
                 // the current permit's lifetime should be prolonged, so that it's destructed
                 // only after all background operations are finished as well.
-                return e.delete_item(client_state, std::move(trace_state), empty_service_permit(), std::move(request), audit_info);
+                return e.delete_item(client_state, std::move(trace_state), empty_service_permit(), std::move(request), audit_info, forwarded);
             });
         });
     }
     per_table_stats->api_operations.delete_item++;
     uint64_t wcu_total = 0;
-    auto res = co_await op->execute(_proxy, std::move(cas_shard), client_state, trace_state, std::move(permit), needs_read_before_write, _stats, *per_table_stats, wcu_total);
+    auto res = co_await op->execute(_proxy, _sc_coordinator, std::move(cas_shard), client_state, trace_state, std::move(permit), needs_read_before_write, _stats, *per_table_stats, wcu_total);
+    if (auto redirect = op->take_raft_redirect()) {
+        _stats.api_operations.delete_item--; // uncount on this node, will be counted where the write is done
+        per_table_stats->api_operations.delete_item--;
+        co_return co_await redirect_raft_write("DeleteItem", std::move(*op).move_request(), std::move(*redirect), client_state, std::move(trace_state), forwarded);
+    }
     if (op->consumed_capacity()._total_bytes > 1) {
         per_table_stats->operation_sizes.delete_item_op_size_kb.add(bytes_to_kb_ceil(op->consumed_capacity()._total_bytes));
     }
@@ -3373,6 +3508,220 @@ struct schema_decorated_key_equal {
         return k1.schema == k2.schema && k1.dk.equal(*k1.schema, k2.dk);
     }
 };
+// Multiple mutations may be destined for the same partition, adding
+// or deleting different items of one partition. They are joined together
+// to be written by one cas() call, or one write of the tablet's Raft group.
+using schema_decorated_key_builders = std::unordered_map<schema_decorated_key,
+    std::vector<put_or_delete_item>,
+    schema_decorated_key_hash,
+    schema_decorated_key_equal>;
+
+static std::unique_ptr<schema_decorated_key_builders> group_by_partition(std::vector<std::pair<schema_ptr, put_or_delete_item>> mutation_builders) {
+    auto key_builders = std::make_unique<schema_decorated_key_builders>(1, schema_decorated_key_hash{}, schema_decorated_key_equal{});
+    for (auto&& b : std::move(mutation_builders)) {
+        auto [it, added] = key_builders->try_emplace(schema_decorated_key {
+            .schema = b.first,
+            .dk = dht::decorate_key(*b.first, b.second.pk())
+        });
+        it->second.push_back(std::move(b.second));
+    }
+    return key_builders;
+}
+
+future<> executor::raft_write(schema_ptr schema, service::cas_shard cas_shard, const dht::decorated_key& dk,
+        const std::vector<put_or_delete_item>& mutation_builders, service::client_state& client_state,
+        tracing::trace_state_ptr trace_state, service_permit permit, is_forwarded forwarded)
+{
+    if (!cas_shard.this_shard()) {
+        _stats.shard_bounce_for_raft++;
+        co_await container().invoke_on(cas_shard.shard(), _ssg,
+                    [cs = client_state.move_to_other_shard(),
+                    &mb = mutation_builders,
+                    &dk,
+                    ks = schema->ks_name(),
+                    cf = schema->cf_name(),
+                    gt = tracing::global_trace_state_ptr(trace_state),
+                    forwarded]
+                    (executor& self) mutable {
+            return do_with(cs.get(), [&mb, &dk, ks = std::move(ks), cf = std::move(cf),
+                                    trace_state = tracing::trace_state_ptr(gt), &self, forwarded]
+                                    (service::client_state& client_state) mutable {
+                auto schema = self._proxy.data_dictionary().find_schema(ks, cf);
+                service::cas_shard cas_shard(*schema, dk.token());
+                return self.raft_write(schema, std::move(cas_shard), dk, mb, client_state, std::move(trace_state), empty_service_permit(), forwarded);
+            });
+        });
+        co_return;
+    }
+
+    // CDC is disabled for tables written through Raft, see writes_through_raft().
+    abort_source as;
+    auto res = co_await _sc_coordinator.mutate(schema, dk.token(), [&] (api::timestamp_type ts) {
+        // All these builders have the same partition.
+        mutation m = mutation_builders.front().build(schema, ts);
+        for (const put_or_delete_item& mutation_builder : mutation_builders | std::views::drop(1)) {
+            m.apply(mutation_builder.build(schema, ts));
+        }
+        return m;
+    }, executor::default_timeout(), as);
+    if (auto* redirect = std::get_if<service::strong_consistency::need_redirect>(&res)) {
+        // Send the leader a BatchWriteItem of only this partition's items.
+        rjson::value items = rjson::empty_array();
+        for (const put_or_delete_item& mutation_builder : mutation_builders) {
+            rjson::push_back(items, rjson::copy(*mutation_builder.write_request()));
+        }
+        rjson::value request_items = rjson::empty_object();
+        rjson::add_with_string_name(request_items, schema->cf_name(), std::move(items));
+        rjson::value request = rjson::empty_object();
+        rjson::add(request, "RequestItems", std::move(request_items));
+        auto ret = co_await redirect_raft_write("BatchWriteItem", std::move(request), std::move(*redirect), client_state, std::move(trace_state), forwarded);
+        if (auto* error = std::get_if<api_error>(&ret)) {
+            co_await coroutine::return_exception(std::move(*error));
+        }
+        co_return;
+    }
+    _stats.write_using_raft++;
+    get_stats_from_schema(_proxy, *schema)->write_using_raft++;
+}
+
+future<executor::request_return_type> executor::execute_write(std::string_view operation, service::client_state& client_state,
+        tracing::trace_state_ptr trace_state, rjson::value request, is_forwarded forwarded) {
+    // The write is audited by the node the client sent it to.
+    std::unique_ptr<audit::audit_info_alternator> audit_info;
+    if (operation == "PutItem") {
+        co_return co_await put_item(client_state, std::move(trace_state), empty_service_permit(), std::move(request), audit_info, forwarded);
+    } else if (operation == "UpdateItem") {
+        co_return co_await update_item(client_state, std::move(trace_state), empty_service_permit(), std::move(request), audit_info, forwarded);
+    } else if (operation == "DeleteItem") {
+        co_return co_await delete_item(client_state, std::move(trace_state), empty_service_permit(), std::move(request), audit_info, forwarded);
+    } else if (operation == "BatchWriteItem") {
+        co_return co_await batch_write_item(client_state, std::move(trace_state), empty_service_permit(), std::move(request), audit_info, forwarded);
+    }
+    co_return api_error::unknown_operation(fmt::format("Unsupported operation {}", operation));
+}
+
+future<executor::request_return_type> executor::redirect_raft_write(std::string_view operation, rjson::value request,
+        service::strong_consistency::need_redirect redirect, service::client_state& client_state,
+        tracing::trace_state_ptr trace_state, is_forwarded forwarded) {
+    const auto my_host_id = _proxy.get_token_metadata_ptr()->get_topology().my_host_id();
+    if (redirect.target.host == my_host_id) {
+        _stats.shard_bounce_for_raft++;
+        co_return co_await container().invoke_on(redirect.target.shard, _ssg,
+                [operation = sstring(operation), request = std::move(request), cs = client_state.move_to_other_shard(),
+                gt = tracing::global_trace_state_ptr(trace_state), forwarded]
+                (executor& e) mutable {
+            return do_with(cs.get(), std::move(operation), [&e, request = std::move(request), trace_state = tracing::trace_state_ptr(gt), forwarded]
+                                     (service::client_state& client_state, const sstring& operation) mutable {
+                return e.execute_write(operation, client_state, std::move(trace_state), std::move(request), forwarded);
+            });
+        });
+    }
+    if (forwarded) {
+        // Don't forward the write again, the node which forwarded it will
+        // send it to the new leader.
+        co_await coroutine::return_exception(raft_redirect(redirect.target));
+    }
+
+    _stats.node_bounce_for_raft++;
+    tracing::trace(trace_state, "Forwarding {} to node {} shard {}", operation, redirect.target.host, redirect.target.shard);
+    bytes_ostream body;
+    auto printed_request = rjson::print(request);
+    body.write(printed_request.data(), printed_request.size());
+    forward_write_request req{
+        .operation = sstring(operation),
+        .request = std::move(body),
+        .client_state = client_state,
+        .trace_info = tracing::make_trace_info(trace_state),
+    };
+    auto timeout = executor::default_timeout();
+    locator::host_id current_host = redirect.target.host;
+    unsigned current_shard = redirect.target.shard;
+    while (true) {
+        auto response_fut = co_await coroutine::as_future(ser::alternator_rpc_verbs::send_alternator_forward_write(&_ms, current_host, timeout, current_shard, req));
+        if (response_fut.failed()) {
+            std::exception_ptr eptr = response_fut.get_exception();
+            elogger.debug("Forwarding {} to node {} shard {} failed: {}", operation, current_host, current_shard, eptr);
+            if (redirect.on_forwarding_finished && (try_catch<seastar::rpc::timeout_error>(eptr) || try_catch<seastar::rpc::closed_error>(eptr))) {
+                redirect.on_forwarding_finished(eptr);
+            }
+            co_return coroutine::exception(std::move(eptr));
+        }
+        auto response = response_fut.get();
+        switch (response.status) {
+        case forward_write_status::success:
+            tracing::trace(trace_state, "Forwarded {} done by node {}", operation, current_host);
+            if (redirect.on_forwarding_finished) {
+                redirect.on_forwarding_finished(current_host);
+            }
+            co_return std::string(response.response_body);
+        case forward_write_status::error:
+            tracing::trace(trace_state, "Forwarded {} failed on node {}", operation, current_host);
+            co_return api_error(std::string(response.error_type), std::string(response.error_message),
+                    static_cast<api_error::status_type>(response.error_http_code),
+                    response.error_extra_fields.empty() ? rjson::null_value() : rjson::parse(response.error_extra_fields));
+        case forward_write_status::redirect:
+            tracing::trace(trace_state, "Node {} redirecting {} to node {} shard {}", current_host, operation, response.target_host, response.target_shard);
+            current_host = response.target_host;
+            current_shard = response.target_shard;
+            continue;
+        }
+    }
+}
+
+static forward_write_response forward_write_error(const api_error& error) {
+    return forward_write_response{
+        .status = forward_write_status::error,
+        .error_type = sstring(error._type),
+        .error_message = sstring(error._msg),
+        .error_http_code = static_cast<int32_t>(error._http_code),
+        .error_extra_fields = error._extra_fields.IsNull() ? sstring() : sstring(rjson::print(error._extra_fields)),
+    };
+}
+
+future<forward_write_response> executor::handle_forwarded_write(forward_write_request req) {
+    service::client_state client_state(_auth_service, &_sl_controller, std::move(req.client_state));
+    tracing::trace_state_ptr trace_state;
+    if (req.trace_info) {
+        trace_state = tracing::tracing::get_local_tracing_instance().create_session(*req.trace_info);
+        tracing::begin(trace_state);
+    }
+    tracing::trace(trace_state, "Handling forwarded {}", req.operation);
+    rjson::chunked_content content;
+    for (bytes_view fragment : req.request.fragments()) {
+        content.emplace_back(reinterpret_cast<const char*>(fragment.data()), fragment.size());
+    }
+    auto ret_fut = co_await coroutine::as_future(execute_write(req.operation, client_state, trace_state, rjson::parse(std::move(content)), is_forwarded::yes));
+    if (ret_fut.failed()) {
+        std::exception_ptr eptr = ret_fut.get_exception();
+        if (auto* redirect = try_catch<raft_redirect>(eptr)) {
+            tracing::trace(trace_state, "Redirecting to node {} shard {}", redirect->target.host, redirect->target.shard);
+            co_return forward_write_response{
+                .status = forward_write_status::redirect,
+                .target_host = redirect->target.host,
+                .target_shard = redirect->target.shard,
+            };
+        }
+        if (auto* error = try_catch<api_error>(eptr)) {
+            co_return forward_write_error(*error);
+        }
+        co_return coroutine::exception(std::move(eptr));
+    }
+    auto ret = ret_fut.get();
+    co_return std::visit(overloaded_functor {
+        [] (std::string& body) {
+            return forward_write_response{
+                .status = forward_write_status::success,
+                .response_body = sstring(body),
+            };
+        },
+        [] (api_error& error) {
+            return forward_write_error(error);
+        },
+        [] (body_writer&) -> forward_write_response {
+            on_internal_error(elogger, "A write returned a streamed response");
+        },
+    }, ret);
+}
 
 // FIXME: if we failed writing some of the mutations, need to return a list
 // of these failed mutations rather than fail the whole write (issue #5650).
@@ -3380,10 +3729,29 @@ future<> executor::do_batch_write(
         std::vector<std::pair<schema_ptr, put_or_delete_item>> mutation_builders,
         service::client_state& client_state,
         tracing::trace_state_ptr trace_state,
-        service_permit permit) {
+        service_permit permit,
+        is_forwarded forwarded) {
     if (mutation_builders.empty()) {
         return make_ready_future<>();
     }
+    // The items of strongly consistent tables are written by the Raft groups
+    // of their tablets, which neither a plain write nor LWT may bypass.
+    auto raft_builders = std::ranges::stable_partition(mutation_builders, [this] (const auto& b) {
+        return !writes_through_raft(_proxy, *b.first);
+    });
+    if (!raft_builders.empty()) {
+        auto key_builders = group_by_partition(std::vector<std::pair<schema_ptr, put_or_delete_item>>(
+                std::make_move_iterator(raft_builders.begin()), std::make_move_iterator(raft_builders.end())));
+        mutation_builders.erase(raft_builders.begin(), raft_builders.end());
+        auto* key_builders_ptr = key_builders.get();
+        return when_all_succeed(
+            do_batch_write(std::move(mutation_builders), client_state, trace_state, permit),
+            parallel_for_each(*key_builders_ptr, [this, &client_state, trace_state, permit, forwarded] (const auto& e) {
+                return raft_write(e.first.schema, service::cas_shard(*e.first.schema, e.first.dk.token()), e.first.dk,
+                        e.second, client_state, trace_state, permit, forwarded);
+            })
+        ).discard_result().finally([key_builders = std::move(key_builders)] {});
+    }
     // NOTE: technically, do_batch_write could be reworked to use LWT only for part
     // of the batched requests and not use it for others, but it's not considered
     // likely that a batch will contain both tables which always demand LWT and ones
@@ -3415,21 +3783,7 @@ future<> executor::do_batch_write(
                 });
     } else {
         // Do the write via LWT:
-        // Multiple mutations may be destined for the same partition, adding
-        // or deleting different items of one partition. Join them together
-        // because we can do them in one cas() call.
-        using map_type = std::unordered_map<schema_decorated_key, 
-            std::vector<put_or_delete_item>, 
-            schema_decorated_key_hash, 
-            schema_decorated_key_equal>;
-        auto key_builders = std::make_unique<map_type>(1, schema_decorated_key_hash{}, schema_decorated_key_equal{});
-        for (auto&& b : std::move(mutation_builders)) {
-            auto [it, added] = key_builders->try_emplace(schema_decorated_key {
-                .schema = b.first,
-                .dk = dht::decorate_key(*b.first, b.second.pk())
-            });
-            it->second.push_back(std::move(b.second));
-        }
+        auto key_builders = group_by_partition(std::move(mutation_builders));
         auto* key_builders_ptr = key_builders.get();
         return parallel_for_each(*key_builders_ptr, [this, &client_state, trace_state, permit = std::move(permit)] (const auto& e) {
             _stats.write_using_lwt++;
@@ -3468,7 +3822,7 @@ sstring print_names_for_audit(const audit::audit_table_set& names) {
     return res;
 }
 
-future<executor::request_return_type> executor::batch_write_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info) {
+future<executor::request_return_type> executor::batch_write_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info, is_forwarded forwarded) {
     _stats.api_operations.batch_write_item++;
     auto start_time = std::chrono::steady_clock::now();
     const rjson::value& request_items = get_member(request, "RequestItems", "BatchWriteItem content");
@@ -3531,6 +3885,7 @@ future<executor::request_return_type> executor::batch_write_item(client_state& c
                         item, schema, put_or_delete_item::put_item{},
                         si_key_attributes(_proxy.data_dictionary().find_table(schema->ks_name(), schema->cf_name())));
                 mutation_builders.emplace_back(schema, std::move(put_item));
+                mutation_builders.back().second.set_write_request(request);
                 auto mut_key = std::make_pair(mutation_builders.back().second.pk(), mutation_builders.back().second.ck());
                 if (used_keys.contains(mut_key)) {
                     co_return api_error::validation("Provided list of item keys contains duplicates");
@@ -3541,6 +3896,7 @@ future<executor::request_return_type> executor::batch_write_item(client_state& c
                 validate_is_object(key, "Key in DeleteRequest");
                 mutation_builders.emplace_back(schema, put_or_delete_item(
                         key, schema, put_or_delete_item::delete_item{}));
+                mutation_builders.back().second.set_write_request(request);
                 auto mut_key = std::make_pair(mutation_builders.back().second.pk(),
                         mutation_builders.back().second.ck());
                 if (used_keys.contains(mut_key)) {
@@ -3639,7 +3995,7 @@ future<executor::request_return_type> executor::batch_write_item(client_state& c
     _stats.wcu_total[stats::DELETE_ITEM] += wcu_delete_units;
     _stats.api_operations.batch_write_item_batch_total += total_items;
     _stats.api_operations.batch_write_item_histogram.add(total_items);
-    co_await do_batch_write(std::move(mutation_builders), client_state, trace_state, std::move(permit));
+    co_await do_batch_write(std::move(mutation_builders), client_state, trace_state, std::move(permit), forwarded);
     // FIXME: Issue #5650: If we failed writing some of the updates,
     // need to return a list of these failed updates in UnprocessedItems
     // rather than fail the whole write (issue #5650).
@@ -4407,7 +4763,7 @@ std::optional<mutation> update_item_operation::apply(std::unique_ptr<rjson::valu
     return m;
 }
 
-future<executor::request_return_type> executor::update_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info) {
+future<executor::request_return_type> executor::update_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info, is_forwarded forwarded) {
     _stats.api_operations.update_item++;
     auto start_time = std::chrono::steady_clock::now();
     elogger.trace("update_item {}", request);
@@ -4432,23 +4788,28 @@ future<executor::request_return_type> executor::update_item(client_state& client
 
     if (cas_shard && !cas_shard->this_shard()) {
         _stats.api_operations.update_item--; // uncount on this shard, will be counted in other shard
-        _stats.shard_bounce_for_lwt++;
+        ++(op->write_through_raft() ? _stats.shard_bounce_for_raft : _stats.shard_bounce_for_lwt);
         co_return co_await container().invoke_on(cas_shard->shard(), _ssg,
-                [request = std::move(*op).move_request(), cs = client_state.move_to_other_shard(), gt = tracing::global_trace_state_ptr(trace_state), permit = std::move(permit), &audit_info]
+                [request = std::move(*op).move_request(), cs = client_state.move_to_other_shard(), gt = tracing::global_trace_state_ptr(trace_state), permit = std::move(permit), &audit_info, forwarded]
                 (executor& e) mutable {
-            return do_with(cs.get(), [&e, request = std::move(request), trace_state = tracing::trace_state_ptr(gt), &audit_info]
+            return do_with(cs.get(), [&e, request = std::move(request), trace_state = tracing::trace_state_ptr(gt), &audit_info, forwarded]
                                      (service::client_state& client_state) mutable {
                 //FIXME: Instead of passing empty_service_permit() to the background operation,
                 // the current permit's lifetime should be prolonged, so that it's destructed
                 // only after all background operations are finished as well.
-                return e.update_item(client_state, std::move(trace_state), empty_service_permit(), std::move(request), audit_info);
+                return e.update_item(client_state, std::move(trace_state), empty_service_permit(), std::move(request), audit_info, forwarded);
             });
         });
     }
     lw_shared_ptr<stats> per_table_stats = get_stats_from_schema(_proxy, *(op->schema()));
     per_table_stats->api_operations.update_item++;
     uint64_t wcu_total = 0;
-    auto res = co_await op->execute(_proxy, std::move(cas_shard), client_state, trace_state, std::move(permit), needs_read_before_write, _stats, *per_table_stats, wcu_total);
+    auto res = co_await op->execute(_proxy, _sc_coordinator, std::move(cas_shard), client_state, trace_state, std::move(permit), needs_read_before_write, _stats, *per_table_stats, wcu_total);
+    if (auto redirect = op->take_raft_redirect()) {
+        _stats.api_operations.update_item--; // uncount on this node, will be counted where the write is done
+        per_table_stats->api_operations.update_item--;
+        co_return co_await redirect_raft_write("UpdateItem", std::move(*op).move_request(), std::move(*redirect), client_state, std::move(trace_state), forwarded);
+    }
     per_table_stats->operation_sizes.update_item_op_size_kb.add(bytes_to_kb_ceil(op->consumed_capacity()._total_bytes));
     per_table_stats->wcu_total[stats::wcu_types::UPDATE_ITEM] += wcu_total;
     _stats.wcu_total[stats::wcu_types::UPDATE_ITEM] += wcu_total;
@@ -4669,12 +5030,22 @@ static lw_shared_ptr<keyspace_metadata> create_keyspace_metadata(std::string_vie
 }
 
 future<> executor::start() {
-    // Currently, nothing to do on initialization. We delay the keyspace
-    // creation (create_keyspace()) until a table is actually created.
+    // We delay the keyspace creation (create_keyspace()) until a table is
+    // actually created, so all there is to do is to accept the writes other
+    // nodes forward to this one, see redirect_raft_write().
+    ser::alternator_rpc_verbs::register_alternator_forward_write(&_ms,
+        [this] (const rpc::client_info& cinfo, rpc::opt_time_point timeout, unsigned shard, forward_write_request req) -> future<forward_write_response> {
+            auto src_host = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+            elogger.trace("Handling write forwarded from {} on shard {}", src_host, shard);
+            co_return co_await container().invoke_on(shard, _ssg, [req = std::move(req)] (executor& e) mutable {
+                return e.handle_forwarded_write(std::move(req));
+            });
+        });
     return make_ready_future<>();
 }
 
 future<> executor::stop() {
+    co_await ser::alternator_rpc_verbs::unregister(&_ms);
     co_await _describe_table_info_manager->stop();
     // disconnect from the value source, but keep the value unchanged.
     s_default_timeout_in_ms = utils::updateable_value<uint32_t>{s_default_timeout_in_ms()};
@@ -14,6 +14,7 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
 #include <seastar/util/noncopyable_function.hh>
+#include <seastar/util/bool_class.hh>
 
 #include "service/migration_manager.hh"
 #include "service/client_state.hh"
@@ -55,6 +56,22 @@ namespace service {
     class storage_proxy;
     class cas_shard;
     class storage_service;
+namespace strong_consistency {
+    class coordinator;
+    struct need_redirect;
+}
+}
+
+namespace netw {
+    class messaging_service;
+}
+
+namespace auth {
+    class service;
+}
+
+namespace qos {
+    class service_level_controller;
 }
 
 namespace vector_search {
@@ -79,6 +96,8 @@ namespace alternator {
 enum class table_status;
 class rmw_operation;
 class put_or_delete_item;
+struct forward_write_request;
+struct forward_write_response;
 
 namespace parsed {
 class expression_cache;
@@ -88,11 +107,15 @@ class executor : public peering_sharded_service<executor> {
     gms::gossiper& _gossiper;
     service::storage_service& _ss;
     service::storage_proxy& _proxy;
+    service::strong_consistency::coordinator& _sc_coordinator;
     service::migration_manager& _mm;
     db::system_distributed_keyspace& _sdks;
     db::system_keyspace& _system_keyspace;
     cdc::metadata& _cdc_metadata;
     vector_search::vector_store_client& _vsc;
+    netw::messaging_service& _ms;
+    auth::service& _auth_service;
+    qos::service_level_controller& _sl_controller;
     utils::updateable_value<bool> _enforce_authorization;
     utils::updateable_value<bool> _warn_authorization;
     seastar::sharded<audit::audit>& _audit;
@@ -121,6 +144,11 @@ class executor : public peering_sharded_service<executor> {
     // handling of large responses without needing to allocate a large buffer
     // in memory.
     using request_return_type = std::variant<std::string, body_writer, api_error>;
+    // Whether a write was forwarded by another node to this one, because this
+    // node leads the Raft group of the item's tablet. If it doesn't anymore,
+    // the write is not forwarded again, but the forwarding node is told to
+    // send it to the new leader.
+    using is_forwarded = bool_class<class is_forwarded_tag>;
     stats _stats;
     // The metric_groups object holds this stat object's metrics registered
     // as long as the stats object is alive.
@@ -131,12 +159,16 @@ class executor : public peering_sharded_service<executor> {
 
     executor(gms::gossiper& gossiper,
              service::storage_proxy& proxy,
+             service::strong_consistency::coordinator& sc_coordinator,
              service::storage_service& ss,
              service::migration_manager& mm,
              db::system_distributed_keyspace& sdks,
              db::system_keyspace& system_keyspace,
              cdc::metadata& cdc_metadata,
              vector_search::vector_store_client& vsc,
+             netw::messaging_service& ms,
+             auth::service& auth_service,
+             qos::service_level_controller& sl_controller,
              smp_service_group ssg,
              utils::updateable_value<uint32_t> default_timeout_in_ms);
     ~executor();
@@ -145,14 +177,14 @@ class executor : public peering_sharded_service<executor> {
     future<request_return_type> describe_table(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
     future<request_return_type> delete_table(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
     future<request_return_type> update_table(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
-    future<request_return_type> put_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
+    future<request_return_type> put_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info, is_forwarded forwarded = is_forwarded::no);
     future<request_return_type> get_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
-    future<request_return_type> delete_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
-    future<request_return_type> update_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
+    future<request_return_type> delete_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info, is_forwarded forwarded = is_forwarded::no);
+    future<request_return_type> update_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info, is_forwarded forwarded = is_forwarded::no);
     future<request_return_type> list_tables(client_state& client_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
     future<request_return_type> scan(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
     future<request_return_type> describe_endpoints(client_state& client_state, service_permit permit, rjson::value request, std::string host_header, std::unique_ptr<audit::audit_info_alternator>& audit_info);
-    future<request_return_type> batch_write_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
+    future<request_return_type> batch_write_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info, is_forwarded forwarded = is_forwarded::no);
     future<request_return_type> batch_get_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
     future<request_return_type> query(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
     future<request_return_type> tag_resource(client_state& client_state, service_permit permit, rjson::value request, std::unique_ptr<audit::audit_info_alternator>& audit_info);
@@ -194,12 +226,35 @@ class executor : public peering_sharded_service<executor> {
         std::vector<std::pair<schema_ptr, put_or_delete_item>> mutation_builders,
         service::client_state& client_state,
         tracing::trace_state_ptr trace_state,
-        service_permit permit);
+        service_permit permit,
+        is_forwarded forwarded = is_forwarded::no);
 
     future<> cas_write(schema_ptr schema, service::cas_shard cas_shard, const dht::decorated_key& dk,
         const std::vector<put_or_delete_item>& mutation_builders, service::client_state& client_state,
         tracing::trace_state_ptr trace_state, service_permit permit);
 
+    // Writes the items of one partition of a strongly consistent table through
+    // the Raft group of its tablet.
+    future<> raft_write(schema_ptr schema, service::cas_shard cas_shard, const dht::decorated_key& dk,
+        const std::vector<put_or_delete_item>& mutation_builders, service::client_state& client_state,
+        tracing::trace_state_ptr trace_state, service_permit permit, is_forwarded forwarded);
+
+    // Executes the write operation (PutItem, UpdateItem, DeleteItem or
+    // BatchWriteItem) with the given name.
+    future<request_return_type> execute_write(std::string_view operation, service::client_state& client_state,
+        tracing::trace_state_ptr trace_state, rjson::value request, is_forwarded forwarded);
+
+    // Sends a write to a strongly consistent table, which has to be done by
+    // the Raft group of a tablet whose leader is on another shard or node, to
+    // the leader. Like CQL's forward_cql(), it follows the leader's
+    // redirections until the write is done.
+    future<request_return_type> redirect_raft_write(std::string_view operation, rjson::value request,
+        service::strong_consistency::need_redirect redirect, service::client_state& client_state,
+        tracing::trace_state_ptr trace_state, is_forwarded forwarded);
+
+    // Executes a write forwarded by redirect_raft_write() on another node.
+    future<forward_write_response> handle_forwarded_write(forward_write_request req);
+
 public:
     static bool add_stream_options(const rjson::value& stream_spec, schema_builder&, service::storage_proxy& sp, const cdc::options& existing_cdc_opts = {});
     static void supplement_table_info(rjson::value& descr, const schema& schema, service::storage_proxy& sp);
@@ -31,6 +31,7 @@
 #include "cql3/selection/selection.hh"
 #include "cql3/result_set.hh"
 #include "query/query-request.hh"
+#include "types/listlike_partial_deserializing_iterator.hh"
 #include "schema/schema.hh"
 #include "service/client_state.hh"
 #include "service/pager/query_pagers.hh"
@@ -42,6 +43,7 @@
 #include "vector_search/vector_store_client.hh"
 #include <seastar/core/abort_on_expiry.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/when_all.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <boost/range/algorithm/find_end.hpp>
 #include <charconv>
@@ -567,6 +569,102 @@ static future<std::tuple<rjson::value, std::optional<utils::chunked_vector<rjson
     co_return std::tuple(std::move(items_descr), std::move(opt_items), size);
 }
 
+// write_items_visitor is a faster variant of describe_items_visitor for the
+// common case of a Query or Scan without a filter, returning entire
+// top-level attributes. There is nothing to check or cut in the items in
+// this case, so their JSON text is written directly to a bytes_ostream,
+// without building an rjson::value for every item and attribute.
+class write_items_visitor {
+    typedef std::vector<const column_definition*> columns_t;
+    const columns_t& _columns;
+    const std::optional<attrs_to_get>& _attrs_to_get;
+    typename columns_t::const_iterator _column_it;
+    item_json_writer _writer;
+    size_t _count = 0;
+
+public:
+    write_items_visitor(const columns_t& columns, const std::optional<attrs_to_get>& attrs_to_get, bytes_ostream& out)
+            : _columns(columns)
+            , _attrs_to_get(attrs_to_get)
+            , _column_it(columns.begin())
+            , _writer(out)
+    { }
+
+    void start_row() {
+        _column_it = _columns.begin();
+        _writer.start_item();
+    }
+
+    void accept_value(managed_bytes_view_opt result_bytes_view) {
+        if (!result_bytes_view) {
+            ++_column_it;
+            return;
+        }
+        result_bytes_view->with_linearized([this] (bytes_view bv) {
+            const column_definition& cdef = **_column_it;
+            std::string column_name = cdef.name_as_text();
+            if (column_name != executor::ATTRS_COLUMN_NAME) {
+                if (!_attrs_to_get || _attrs_to_get->contains(column_name)) {
+                    _writer.write_key_attribute(column_name, bv, cdef);
+                }
+            } else {
+                // Walk the serialized map in place, there is no need to
+                // copy its keys and values like deserializing it would.
+                auto size = read_collection_size(bv);
+                for (int i = 0; i < size; ++i) {
+                    auto key = read_collection_key(bv);
+                    auto value = read_collection_value_nonnull(bv);
+                    std::string_view attr_name(reinterpret_cast<const char*>(key.data()), key.size());
+                    if (!_attrs_to_get || _attrs_to_get->contains(std::string(attr_name))) {
+                        _writer.write_attribute(attr_name, value);
+                    }
+                }
+            }
+        });
+        ++_column_it;
+    }
+
+    void end_row() {
+        _writer.end_item();
+        ++_count;
+    }
+
+    size_t get_count() const {
+        return _count;
+    }
+};
+
+// write_items() can be used instead of describe_items() when there is no
+// filter and attrs_to_get (if given) only asks for entire top-level
+// attributes. It returns the JSON object with "Count" and "ScannedCount",
+// and the text of the items, for make_items_response().
+static future<std::tuple<rjson::value, bytes_ostream, size_t>> write_items(
+        const cql3::selection::selection& selection,
+        std::unique_ptr<cql3::result_set> result_set,
+        const std::optional<attrs_to_get>& attrs_to_get) {
+    bytes_ostream items;
+    write_items_visitor visitor(selection.get_columns(), attrs_to_get, items);
+    co_await result_set->visit_gently(visitor);
+    auto size = visitor.get_count();
+    rjson::value items_descr = rjson::empty_object();
+    rjson::add(items_descr, "Count", rjson::value(size));
+    rjson::add(items_descr, "ScannedCount", rjson::value(size));
+    co_return std::tuple(std::move(items_descr), std::move(items), size);
+}
+
+static bool can_write_items(const filter& filter, const std::optional<attrs_to_get>& attrs_to_get) {
+    if (filter) {
+        return false;
+    }
+    if (!attrs_to_get) {
+        return true;
+    }
+    // An empty attrs_to_get means Select=COUNT, which doesn't return items.
+    return !attrs_to_get->empty() && std::ranges::all_of(*attrs_to_get, [] (const auto& attr) {
+        return attr.second.has_value();
+    });
+}
+
 static rjson::value encode_paging_state(const schema& schema, const service::pager::paging_state& paging_state) {
     rjson::value last_evaluated_key = rjson::empty_object();
     std::vector<bytes> exploded_pk = paging_state.get_partition_key().explode();
@@ -610,6 +708,47 @@ static rjson::value encode_paging_state(const schema& schema, const service::pag
 // point for when to switch from a rapidjson array to a chunked_vector.
 static constexpr int max_items_for_rapidjson_array = 256;
 
+// Query and Scan responses built by make_items_response() up to this size
+// are returned as a single string rather than streamed.
+static constexpr size_t max_unstreamed_items_response_size = 100'000;
+
+// make_items_response() builds the response of a Query or Scan from the
+// JSON object items_descr, with the items written by write_items() added
+// to it as the "Items" array.
+static executor::request_return_type make_items_response(const rjson::value& items_descr, bytes_ostream items) {
+    std::string head = rjson::print(items_descr);
+    // Replace the closing brace of the object by the beginning of the array.
+    head.pop_back();
+    head += ",\"Items\":[";
+    static constexpr std::string_view tail = "]}";
+    if (head.size() + items.size() + tail.size() <= max_unstreamed_items_response_size) {
+        std::string response = std::move(head);
+        response.reserve(response.size() + items.size() + tail.size());
+        for (bytes_view fragment : items.fragments()) {
+            response.append(reinterpret_cast<const char*>(fragment.data()), fragment.size());
+        }
+        response += tail;
+        return response;
+    }
+    return body_writer([head = std::move(head), items = std::move(items)] (output_stream<char>&& _out) mutable -> future<> {
+        auto out = std::move(_out);
+        std::exception_ptr ex;
+        try {
+            co_await out.write(head.data(), head.size());
+            for (bytes_view fragment : items.fragments()) {
+                co_await out.write(reinterpret_cast<const char*>(fragment.data()), fragment.size());
+            }
+            co_await out.write(tail.data(), tail.size());
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await out.close();
+        if (ex) {
+            co_await coroutine::return_exception_ptr(std::move(ex));
+        }
+    });
+}
+
 static future<executor::request_return_type> do_query(service::storage_proxy& proxy,
         schema_ptr table_schema,
         const rjson::value* exclusive_start_key,
@@ -682,6 +821,21 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
         rs->get_metadata().set_paging_state(p->state());
     }
     auto paging_state = rs->get_metadata().paging_state();
+    auto account_returned_items = [&] (size_t size) {
+        stats.returned_items += size;
+        stats.returned_items_histogram.add(size);
+        auto per_table_stats = get_stats_from_schema(proxy, *table_schema);
+        per_table_stats->returned_items += size;
+        per_table_stats->returned_items_histogram.add(size);
+    };
+    if (can_write_items(filter, attrs_to_get)) {
+        auto [items_descr, items, size] = co_await write_items(*selection, std::move(rs), attrs_to_get);
+        if (paging_state) {
+            rjson::add(items_descr, "LastEvaluatedKey", encode_paging_state(*table_schema, *paging_state));
+        }
+        account_returned_items(size);
+        co_return make_items_response(items_descr, std::move(items));
+    }
     bool has_filter = filter;
     auto [items_descr, opt_items, size] = co_await describe_items(*selection, std::move(rs), std::move(attrs_to_get), std::move(filter));
     if (paging_state) {
@@ -695,11 +849,7 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
     if (opt_items) {
         // Note we only update the "returned items" statistics if opt_items is
         // set, meaning that we were asked to return items (Select != COUNT).
-        stats.returned_items += size;
-        stats.returned_items_histogram.add(size);
-        auto per_table_stats = get_stats_from_schema(proxy, *table_schema);
-        per_table_stats->returned_items += size;
-        per_table_stats->returned_items_histogram.add(size);
+        account_returned_items(size);
         if (opt_items->size() >= max_items_for_rapidjson_array) {
             // There are many items, better print the JSON and the array of
             // items (opt_items) separately to avoid RapidJSON's contiguous
@@ -1851,11 +2001,14 @@ static future<executor::request_return_type> query_vector(
     rjson::value scores_json = rjson::empty_array();
     int matched_count = 0;
 
-    // Query each primary key individually, in the order returned by the
-    // vector store, to preserve vector-distance ordering in the response.
-    // FIXME: do this more efficiently with a batched read that preserves ordering.
+    // Read all the primary keys together, and then build the response in the
+    // order returned by the vector store, to preserve vector-distance ordering.
     stats.vector_search.query_items_from_base_table += pkeys.size();
     per_table_stats->vector_search.query_items_from_base_table += pkeys.size();
+    std::vector<lw_shared_ptr<query::read_command>> commands;
+    dht::partition_range_vector partition_ranges;
+    commands.reserve(pkeys.size());
+    partition_ranges.reserve(pkeys.size());
     for (const auto& pkey : pkeys) {
         std::vector<query::clustering_range> bounds{
                 base_schema->clustering_key_size() > 0
@@ -1863,16 +2016,20 @@ static future<executor::request_return_type> query_vector(
                     : query::clustering_range::make_open_ended_both_sides()};
         auto partition_slice = query::partition_slice(std::move(bounds), {},
                 regular_columns, selection->get_query_options());
-        auto command = ::make_lw_shared<query::read_command>(
+        commands.push_back(::make_lw_shared<query::read_command>(
                 base_schema->id(), base_schema->version(), partition_slice,
                 proxy.get_max_result_size(partition_slice),
-                query::tombstone_limit(proxy.get_tombstone_limit()));
-        service::storage_proxy::result<service::storage_proxy::coordinator_query_result> rqr =
-                co_await proxy.query_result(base_schema, command,
-                        {dht::partition_range(pkey.partition)},
-                        db::consistency_level::LOCAL_ONE,
-                        service::storage_proxy::coordinator_query_options(
-                                timeout, permit, client_state, trace_state));
+                query::tombstone_limit(proxy.get_tombstone_limit())));
+        partition_ranges.emplace_back(pkey.partition);
+    }
+    auto query_futures = proxy.query_partitions(base_schema, commands,
+            std::move(partition_ranges), db::consistency_level::LOCAL_ONE,
+            service::storage_proxy::coordinator_query_options(timeout, permit, client_state, trace_state));
+    auto query_results = co_await when_all_succeed(query_futures.begin(), query_futures.end());
+    for (size_t i = 0; i < pkeys.size(); ++i) {
+        const auto& pkey = pkeys[i];
+        const auto& partition_slice = commands[i]->slice;
+        auto& rqr = query_results[i];
         if (!rqr) {
             co_return create_api_error_from_coordinators_exception(std::move(rqr).assume_error());
         }
@@ -2241,8 +2398,20 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
         bool is_quorum = rs.cl == db::consistency_level::LOCAL_QUORUM;
         lw_shared_ptr<stats> per_table_stats = get_stats_from_schema(_proxy, *rs.schema);
         per_table_stats->api_operations.batch_get_item_histogram.add(rs.requests.size());
+        // The partitions of a table are read together, so the reads of the
+        // partitions which have the same replicas are sent to them at once.
+        std::vector<lw_shared_ptr<query::read_command>> commands;
+        std::vector<query::partition_slice> partition_slices;
+        dht::partition_range_vector partition_ranges;
+        commands.reserve(rs.requests.size());
+        partition_slices.reserve(rs.requests.size());
+        partition_ranges.reserve(rs.requests.size());
+        auto regular_columns =
+                rs.schema->regular_columns() | std::views::transform(&column_definition::id)
+                | std::ranges::to<query::column_id_vector>();
+        auto selection = cql3::selection::selection::wildcard(rs.schema);
         for (const auto& [pk, cks] : rs.requests) {
-            dht::partition_range_vector partition_ranges{dht::partition_range(dht::decorate_key(*rs.schema, pk))};
+            partition_ranges.emplace_back(dht::decorate_key(*rs.schema, pk));
             std::vector<query::clustering_range> bounds;
             if (rs.schema->clustering_key_size() == 0) {
                 bounds.push_back(query::clustering_range::make_open_ended_both_sides());
@@ -2251,25 +2420,25 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
                     bounds.push_back(query::clustering_range::make_singular(ck.first));
                 }
             }
-            auto regular_columns =
-                    rs.schema->regular_columns() | std::views::transform(&column_definition::id)
-                    | std::ranges::to<query::column_id_vector>();
-            auto selection = cql3::selection::selection::wildcard(rs.schema);
-            auto partition_slice = query::partition_slice(std::move(bounds), {}, std::move(regular_columns), selection->get_query_options());
+            auto partition_slice = query::partition_slice(std::move(bounds), {}, regular_columns, selection->get_query_options());
             auto command = ::make_lw_shared<query::read_command>(rs.schema->id(), rs.schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
                     query::tombstone_limit(_proxy.get_tombstone_limit()));
             command->allow_limit = db::allow_per_partition_rate_limit::yes;
-            const auto item_callback = [is_quorum, per_table_stats, &rcus_per_table = consumed_rcu_half_units_per_table[i]](uint64_t size) {
-                rcus_per_table += rcu_consumed_capacity_counter::get_half_units(size, is_quorum);
-                // Update item size only if the item exists.
-                if (size > 0) {
-                    per_table_stats->operation_sizes.batch_get_item_op_size_kb.add(bytes_to_kb_ceil(size));
-                }
-            };
-            future<batch_get_item_result> f = 
-                    _proxy.query_result(rs.schema, std::move(command), std::move(partition_ranges), rs.cl,
-                        service::storage_proxy::coordinator_query_options(executor::default_timeout(), permit, client_state, trace_state)).then(
-                    [schema = rs.schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = rs.attrs_to_get, item_callback = std::move(item_callback)] (service::storage_proxy::result<service::storage_proxy::coordinator_query_result> rqr) mutable -> future<batch_get_item_result> {
+            commands.push_back(std::move(command));
+            partition_slices.push_back(std::move(partition_slice));
+        }
+        const auto item_callback = [is_quorum, per_table_stats, &rcus_per_table = consumed_rcu_half_units_per_table[i]](uint64_t size) {
+            rcus_per_table += rcu_consumed_capacity_counter::get_half_units(size, is_quorum);
+            // Update item size only if the item exists.
+            if (size > 0) {
+                per_table_stats->operation_sizes.batch_get_item_op_size_kb.add(bytes_to_kb_ceil(size));
+            }
+        };
+        auto query_futures = _proxy.query_partitions(rs.schema, std::move(commands), std::move(partition_ranges), rs.cl,
+                service::storage_proxy::coordinator_query_options(executor::default_timeout(), permit, client_state, trace_state));
+        for (size_t j = 0; j < query_futures.size(); j++) {
+            future<batch_get_item_result> f = std::move(query_futures[j]).then(
+                    [schema = rs.schema, partition_slice = std::move(partition_slices[j]), selection, attrs_to_get = rs.attrs_to_get, item_callback] (service::storage_proxy::result<service::storage_proxy::coordinator_query_result> rqr) mutable -> future<batch_get_item_result> {
                 if (!rqr) {
                     return make_ready_future<batch_get_item_result>(std::move(rqr).as_failure());
                 }
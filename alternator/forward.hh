@@ -0,0 +1,51 @@
+/*
+ * Copyright 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include "bytes_ostream.hh"
+#include "locator/host_id.hh"
+#include "service/client_state.hh"
+#include "tracing/tracing.hh"
+
+namespace alternator {
+
+// A write to a strongly consistent table which has to be done by the Raft
+// group of a tablet led by another node, so it's forwarded to the leader.
+struct forward_write_request {
+    // The name of the operation, e.g. "PutItem" or "BatchWriteItem"
+    sstring operation;
+    // The JSON request body of the operation
+    bytes_ostream request;
+    service::forwarded_client_state client_state;
+    std::optional<tracing::trace_info> trace_info;
+};
+
+enum class forward_write_status : uint8_t {
+    success = 0,
+    error = 1,
+    redirect = 2,
+};
+
+struct forward_write_response {
+    forward_write_status status;
+    // If status == success, the JSON response body
+    sstring response_body;
+    // If status == error, the api_error to return to the client
+    sstring error_type;
+    sstring error_message;
+    int32_t error_http_code;
+    // The JSON extra fields of the api_error, or empty if it has none
+    sstring error_extra_fields;
+    // If status == redirect, the node isn't the leader anymore and the write
+    // should be sent to this one instead.
+    locator::host_id target_host;
+    unsigned target_shard;
+};
+
+}
@@ -18,6 +18,8 @@
 #include "executor.hh"
 #include "tracing/trace_state.hh"
 #include "keys/keys.hh"
+#include "service/strong_consistency/coordinator.hh"
+
 
 namespace alternator {
 
@@ -71,6 +73,11 @@ class rmw_operation : public service::cas_request, public enable_shared_from_thi
     partition_key _pk = partition_key::make_empty();
     clustering_key _ck = clustering_key::make_empty();
     write_isolation _write_isolation;
+    // Whether the write is done by the Raft group of the item's tablet, instead
+    // of LWT or a plain write, because the table is in a strongly consistent keyspace.
+    // The write isolation policy then only decides whether read-modify-write
+    // operations are forbidden.
+    bool _write_through_raft;
     mutable wcu_consumed_capacity_counter _consumed_capacity;
     // All RMW operations can have a ReturnValues parameter from the following
     // choices. But note that only UpdateItem actually supports all of them:
@@ -92,6 +99,10 @@ class rmw_operation : public service::cas_request, public enable_shared_from_thi
     // Additionally when _returnvalues_on_condition_check_failure is ALL_OLD
     // then condition check failure will also result in storing values here.
     mutable rjson::value _return_attributes;
+    // Set by execute() when the write has to be done by the Raft group of a
+    // tablet whose leader is on another shard or node. The caller then sends
+    // the request there, see executor::redirect_raft_write().
+    std::optional<service::strong_consistency::need_redirect> _raft_redirect;
 public:
     // The constructor of a rmw_operation subclass should parse the request
     // and try to discover as many input errors as it can before really
@@ -117,7 +128,10 @@ class rmw_operation : public service::cas_request, public enable_shared_from_thi
     schema_ptr schema() const { return _schema; }
     const rjson::value& request() const { return _request; }
     rjson::value&& move_request() && { return std::move(_request); }
+    bool write_through_raft() const noexcept { return _write_through_raft; }
+    std::optional<service::strong_consistency::need_redirect> take_raft_redirect() { return std::exchange(_raft_redirect, std::nullopt); }
     future<executor::request_return_type> execute(service::storage_proxy& proxy,
+            service::strong_consistency::coordinator& sc_coordinator,
             std::optional<service::cas_shard> cas_shard,
             service::client_state& client_state,
             tracing::trace_state_ptr trace_state,
@@ -130,6 +144,23 @@ class rmw_operation : public service::cas_request, public enable_shared_from_thi
 
 private:
     inline bool should_fill_preimage() const { return _schema->cdc_options().enabled(); }
+    future<executor::request_return_type> execute_through_raft(service::storage_proxy& proxy,
+            service::strong_consistency::coordinator& sc_coordinator,
+            tracing::trace_state_ptr trace_state,
+            bool needs_read_before_write,
+            stats& global_stats,
+            stats& per_table_stats,
+            uint64_t& wcu_total);
+    future<executor::request_return_type> execute_using_lwt(service::storage_proxy& proxy,
+            service::cas_shard cas_shard,
+            service::client_state& client_state,
+            tracing::trace_state_ptr trace_state,
+            service_permit permit,
+            bool needs_read_before_write,
+            stats& global_stats,
+            stats& per_table_stats,
+            uint64_t& wcu_total,
+            cdc::per_request_options cdc_opts);
 };
 
 } // namespace alternator
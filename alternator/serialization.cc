@@ -198,7 +198,11 @@ bytes serialize_item(const rjson::value& item) {
 
     if (type_info.atype == alternator_type::NOT_SUPPORTED_YET) {
         slogger.trace("Non-optimal serialization of type {}", it->name);
-        return bytes{int8_t(type_info.atype)} + to_bytes(rjson::print(item));
+        auto json = rjson::print(item);
+        bytes out(bytes::initialized_later(), 1 + json.size());
+        out[0] = int8_t(type_info.atype);
+        std::copy_n(json.data(), json.size(), out.data() + 1);
+        return out;
     }
 
     // FLOAT32VECTOR is serialized as a 1-byte type tag followed by the
@@ -287,6 +291,103 @@ rjson::value deserialize_item(bytes_view bv) {
     return deserialized;
 }
 
+// json_writer_visitor writes a value the same way to_json_visitor adds it
+// to the JSON object it builds.
+template <typename Writer>
+struct json_writer_visitor {
+    Writer& writer;
+    bytes_view bv;
+
+    void operator()(const reversed_type_impl& t) const { visit(*t.underlying_type(), json_writer_visitor{writer, bv}); };
+    void operator()(const decimal_type_impl& t) const {
+        auto s = to_json_string(*decimal_type, bytes(bv));
+        writer.String(s.data(), s.size());
+    }
+    void operator()(const string_type_impl& t) const {
+        writer.String(reinterpret_cast<const char*>(bv.data()), bv.size());
+    }
+    void operator()(const bytes_type_impl& t) const {
+        std::string b64 = base64_encode(bv);
+        writer.String(b64.data(), b64.size());
+    }
+    // default
+    void operator()(const abstract_type& t) const {
+        auto s = to_json_string(t, bytes(bv));
+        writer.RawValue(s.data(), s.size(), rapidjson::kNullType);
+    }
+};
+
+item_json_writer::item_json_writer(bytes_ostream& out)
+    : _buffer(out)
+    , _writer(_buffer)
+{ }
+
+void item_json_writer::start_item() {
+    if (!_first_item) {
+        _buffer.Put(',');
+    }
+    _first_item = false;
+    // Each item is written as a separate JSON document.
+    _writer.Reset(_buffer);
+    _writer.StartObject();
+}
+
+void item_json_writer::end_item() {
+    // Ending the top-level object also flushes the buffer.
+    _writer.EndObject();
+}
+
+void item_json_writer::write_attribute(std::string_view name, bytes_view bv) {
+    if (bv.empty()) {
+        throw api_error::validation("Serialized value empty");
+    }
+    _writer.Key(name.data(), name.size());
+    alternator_type atype = alternator_type(bv[0]);
+    bv.remove_prefix(1);
+
+    if (atype == alternator_type::NOT_SUPPORTED_YET) {
+        // The value was stored as the JSON text printed by serialize_item(),
+        // which is what printing the parsed value would produce again.
+        _writer.RawValue(reinterpret_cast<const char*>(bv.data()), bv.size(), rapidjson::kObjectType);
+        return;
+    }
+
+    _writer.StartObject();
+    if (atype == alternator_type::FLOAT32VECTOR) {
+        if (bv.size() % sizeof(uint32_t) != 0) {
+            throw api_error::validation("FLOAT32VECTOR: byte length not a multiple of 4");
+        }
+        _writer.Key(float32vector_type_name.data(), float32vector_type_name.size());
+        _writer.StartArray();
+        while (!bv.empty()) {
+            uint32_t bits_be = read_unaligned<uint32_t>(bv.data());
+            bv.remove_prefix(sizeof(uint32_t));
+            _writer.Double(std::bit_cast<float>(net::ntoh(bits_be)));
+        }
+        _writer.EndArray();
+    } else {
+        type_representation type_representation = represent_type(atype);
+        _writer.Key(type_representation.ident.data(), type_representation.ident.size());
+        visit(*type_representation.dtype, json_writer_visitor{_writer, bv});
+    }
+    _writer.EndObject();
+}
+
+void item_json_writer::write_key_attribute(std::string_view name, bytes_view cell, const column_definition& column) {
+    _writer.Key(name.data(), name.size());
+    _writer.StartObject();
+    auto type = type_to_string(column.type);
+    _writer.Key(type.data(), type.size());
+    if (column.type == bytes_type || column.type == utf8_type || column.type == decimal_type) {
+        visit(*column.type, json_writer_visitor{_writer, cell});
+    } else {
+        // Like json_key_column_value(), represent other types as strings.
+        auto s = column.type->to_string(bytes(cell));
+        _writer.String(s.data(), s.size());
+    }
+    _writer.EndObject();
+}
+
 // This function takes a bytes_view created earlier by serialize_item(), and
 // if has the type "expected_type", the function returns the value as a
 // raw Scylla type. If the type doesn't match, returns an unset optional.
@@ -11,11 +11,13 @@
 #include <string>
 #include <string_view>
 #include <optional>
+#include <array>
 #include "types/types.hh"
 #include "schema/schema_fwd.hh"
 #include "keys/keys.hh"
 #include "utils/rjson.hh"
 #include "utils/big_decimal.hh"
+#include "bytes_ostream.hh"
 
 class position_in_partition;
 
@@ -57,6 +59,46 @@ std::optional<bytes> serialized_value_if_type(bytes_view bv, alternator_type exp
 
 std::string type_to_string(data_type type);
 
+// item_json_writer writes the JSON text of items directly into a
+// bytes_ostream, as a comma-separated list of JSON objects (the caller adds
+// the enclosing brackets). The text is the same as printing the items built
+// with deserialize_item() and json_key_column_value(), but no rjson::value is
+// built for the attributes, which matters for Query and Scan responses with
+// many items.
+class item_json_writer {
+    // Batches the writer's Put() calls into bytes_ostream writes.
+    class buffer {
+        static constexpr size_t buf_size = 512;
+        bytes_ostream& _out;
+        std::array<char, buf_size> _buf;
+        size_t _pos = 0;
+    public:
+        using Ch = char;
+        explicit buffer(bytes_ostream& out) : _out(out) {}
+        void Put(char c) {
+            if (_pos == buf_size) {
+                Flush();
+            }
+            _buf[_pos++] = c;
+        }
+        void Flush() {
+            _out.write(_buf.data(), _pos);
+            _pos = 0;
+        }
+    };
+    buffer _buffer;
+    rapidjson::Writer<buffer, rjson::encoding, rjson::encoding, rjson::allocator> _writer;
+    bool _first_item = true;
+public:
+    explicit item_json_writer(bytes_ostream& out);
+    void start_item();
+    void end_item();
+    // Writes an attribute whose value was serialized by serialize_item().
+    void write_attribute(std::string_view name, bytes_view serialized);
+    // Writes an attribute whose value is the given cell of a key column.
+    void write_key_attribute(std::string_view name, bytes_view cell, const column_definition& column);
+};
+
 bytes get_key_column_value(const rjson::value& item, const column_definition& column);
 bytes get_key_from_typed_value(const rjson::value& key_typed_value, const column_definition& column);
 rjson::value json_key_column_value(bytes_view cell, const column_definition& column);
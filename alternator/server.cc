@@ -851,6 +851,10 @@ future<executor::request_return_type> server::handle_api_request(std::unique_ptr
     auto f = [this, content = std::move(content), &callback = callback_it->second,
             client_state = std::move(client_state), trace_state = std::move(trace_state),
             units = std::move(units), req = std::move(req)] () mutable -> future<executor::request_return_type> {
+        // Write requests are parsed into a DOM too, items included: validation,
+        // key extraction, condition evaluation and forwarding to the Raft leader
+        // of strongly consistent tables all work on the parsed request. Only
+        // the Query and Scan responses are written without building a DOM.
         rjson::value json_request = co_await _json_parser.parse(std::move(content));
         if (!json_request.IsObject()) {
             co_return api_error::validation("Request content must be an object");
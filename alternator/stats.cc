@@ -112,8 +112,14 @@ static void register_metrics_with_optional_table(seastar::metrics::metric_groups
                     seastar::metrics::description("number of performed read-before-write operations"), labels).aggregate(aggregate_labels).set_skip_when_empty(),
             seastar::metrics::make_total_operations("write_using_lwt", stats.write_using_lwt,
                     seastar::metrics::description("number of writes that used LWT"), labels).aggregate(aggregate_labels).set_skip_when_empty(),
+            seastar::metrics::make_total_operations("write_using_raft", stats.write_using_raft,
+                    seastar::metrics::description("number of writes done by the Raft group of a strongly consistent table"), labels).aggregate(aggregate_labels).set_skip_when_empty(),
             seastar::metrics::make_total_operations("shard_bounce_for_lwt", stats.shard_bounce_for_lwt,
                     seastar::metrics::description("number writes that had to be bounced from this shard because of LWT requirements"), labels).aggregate(aggregate_labels).set_skip_when_empty(),
+            seastar::metrics::make_total_operations("shard_bounce_for_raft", stats.shard_bounce_for_raft,
+                    seastar::metrics::description("number of writes that had to be bounced from this shard to the shard of the Raft group of a strongly consistent table"), labels).aggregate(aggregate_labels).set_skip_when_empty(),
+            seastar::metrics::make_total_operations("node_bounce_for_raft", stats.node_bounce_for_raft,
+                    seastar::metrics::description("number of writes that had to be forwarded to the node leading the Raft group of a strongly consistent table"), labels).aggregate(aggregate_labels).set_skip_when_empty(),
             seastar::metrics::make_total_operations("requests_blocked_memory", stats.requests_blocked_memory,
                     seastar::metrics::description("Counts a number of requests blocked due to memory pressure."), labels).aggregate(aggregate_labels).set_skip_when_empty(),
             seastar::metrics::make_total_operations("requests_shed", stats.requests_shed,
@@ -163,7 +163,10 @@ class stats {
     uint64_t unsupported_operations = 0;
     uint64_t reads_before_write = 0;
     uint64_t write_using_lwt = 0;
+    uint64_t write_using_raft = 0;
     uint64_t shard_bounce_for_lwt = 0;
+    uint64_t shard_bounce_for_raft = 0;
+    uint64_t node_bounce_for_raft = 0;
     uint64_t requests_blocked_memory = 0;
     uint64_t requests_shed = 0;
     uint64_t rcu_half_units_total = 0;
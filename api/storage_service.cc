@@ -1700,6 +1700,9 @@ rest_logstor_info(http_context& ctx, std::unique_ptr<http::request> req) {
                 result.table = table;
                 result.compaction_groups = merged_stats.compaction_group_count;
                 result.segments = merged_stats.segment_count;
+                result.separator_data_bytes_written = merged_stats.separator_data_bytes_written;
+                result.compaction_data_bytes_written = merged_stats.compaction_data_bytes_written;
+                result.write_amplification = merged_stats.write_amplification();
 
                 for (const auto& bucket : merged_stats.histogram) {
                     ss::logstor_hist_bucket hist;
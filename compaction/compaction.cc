@@ -35,6 +35,7 @@
 #include "sstables/sstable_writer.hh"
 #include "sstables/progress_monitor.hh"
 #include "sstables/sstables_manager.hh"
+#include "sstables/value_log.hh"
 #include "compaction.hh"
 #include "schema/schema.hh"
 #include "db/system_keyspace.hh"
@@ -603,6 +604,11 @@ class compaction {
     utils::observable<> _stop_request_observable;
     tombstone_gc_state _tombstone_gc_state;
     int64_t _output_repaired_at = 0;
+    // Set when the input is read with the pointers to the values in value files,
+    // so that the output links to the value files instead of rewriting the values.
+    lw_shared_ptr<const sstables::value_log::sources> _value_log_sources;
+    // Reconciles the input cells which only differ in their values, see sstables/value_log.hh.
+    std::unique_ptr<sstables::value_log::reconciler> _value_log_reconciler;
 private:
     // Keeps track of monitors for input sstable.
     // If _update_backlog_tracker is set to true, monitors are responsible for adjusting backlog as compaction progresses.
@@ -707,9 +713,14 @@ class compaction {
         cfg.run_identifier = _run_identifier;
         cfg.replay_position = _rp;
         cfg.sstable_level = _sstable_level;
+        cfg.value_log_sources = _value_log_sources;
         return cfg;
     }
 
+    sstables::value_log::reconciler* value_log_reconciler() const {
+        return _value_log_reconciler.get();
+    }
+
     api::timestamp_type maximum_timestamp() const {
         auto m = std::max_element(_sstables.begin(), _sstables.end(), [] (const sstables::shared_sstable& sst1, const sstables::shared_sstable& sst2) {
             return sst1->get_stats_metadata().max_timestamp < sst2->get_stats_metadata().max_timestamp;
@@ -741,6 +752,7 @@ class compaction {
         sstables::sstable_writer_config cfg = _table_s.configure_writer("garbage_collection");
         cfg.run_identifier = gc_run;
         cfg.monitor = monitor.get();
+        cfg.value_log_sources = _value_log_sources;
         uint64_t estimated_partitions = std::max(1UL, uint64_t(ceil(partitions_per_sstable() * _estimated_droppable_tombstone_ratio)));
         auto writer = sst->get_writer(*schema(), estimated_partitions, cfg, get_encoding_stats());
         return compaction_writer(std::move(monitor), std::move(writer), std::move(sst));
@@ -809,6 +821,14 @@ class compaction {
                                                         mutation_reader::forwarding) = 0;
 
     mutation_reader setup_sstable_reader() {
+        auto rd = setup_input_reader();
+        if (_value_log_reconciler) {
+            return _value_log_reconciler->make_reconciling_reader(std::move(rd));
+        }
+        return rd;
+    }
+
+    mutation_reader setup_input_reader() {
         if (!_owned_ranges_checker) {
             return make_sstable_reader(_schema,
                                        _permit,
@@ -924,6 +944,13 @@ class compaction {
 
         _ms_metadata.min_timestamp = timestamp_tracker.min();
         _ms_metadata.max_timestamp = timestamp_tracker.max();
+
+        // Scrub reads the values, to validate them, and rewrites them.
+        if (auto& opts = _schema->value_log_options(); opts.enabled() && _type != compaction_type::Scrub) {
+            auto all = co_await _table_s.main_sstable_set();
+            _value_log_sources = sstables::value_log::make_sources(_sstables, all.get(), opts.gc_garbage_ratio());
+            _value_log_reconciler = std::make_unique<sstables::value_log::reconciler>(_schema);
+        }
     }
 
     // This consumer will perform mutation compaction on producer side using
@@ -1298,7 +1325,8 @@ class regular_compaction : public compaction {
                 unwrap_monitor_generator(),
                 sstables::default_sstable_predicate(),
                 &_reader_statistics,
-                sstables::integrity_check::yes);
+                sstables::integrity_check::yes,
+                value_log_reconciler());
     }
 
     std::string_view report_start_desc() const override {
@@ -1501,7 +1529,8 @@ class reshape_compaction : public regular_compaction {
                 unwrap_monitor_generator(),
                 sstables::default_sstable_predicate(),
                 nullptr,
-                sstables::integrity_check::yes);
+                sstables::integrity_check::yes,
+                value_log_reconciler());
     }
 
     std::string_view report_start_desc() const override {
@@ -2055,7 +2084,8 @@ class resharding_compaction final : public compaction {
                 sm_fwd,
                 mr_fwd,
                 unwrap_monitor_generator(),
-                sstables::integrity_check::yes);
+                sstables::integrity_check::yes,
+                value_log_reconciler());
 
     }
 
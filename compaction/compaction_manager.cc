@@ -28,6 +28,7 @@
 #include "db/compaction_history_entry.hh"
 #include "db/system_keyspace.hh"
 #include "db/config.hh"
+#include "sstables/value_log.hh"
 #include "tombstone_gc-internals.hh"
 #include <cmath>
 #include "utils/labels.hh"
@@ -1484,6 +1485,42 @@ future<stop_iteration> compaction_task_executor::maybe_retry(std::exception_ptr
     return make_ready_future<stop_iteration>(true);
 }
 
+// When the strategy has nothing to compact, returns a job which rewrites the sstable pointing
+// into the value file with the most garbage, if the garbage ratio of the file reaches the
+// gc_garbage_ratio of the table. The rewrite relocates the values which the sstable points
+// to out of the file, see sstables/value_log.hh.
+static future<compaction_descriptor> get_value_log_gc_job(compaction_group_view& t, strategy_control& control) {
+    auto& opts = t.schema()->value_log_options();
+    if (!opts.enabled()) {
+        co_return compaction_descriptor();
+    }
+    auto main_set = co_await t.main_sstable_set();
+    auto ratios = sstables::value_log::garbage_ratios(*main_set);
+    if (ratios.empty()) {
+        co_return compaction_descriptor();
+    }
+    sstables::shared_sstable sst;
+    double max_ratio = 0;
+    for (auto& candidate : co_await control.candidates(t)) {
+        auto* vl = candidate->get_value_log();
+        if (!vl) {
+            continue;
+        }
+        for (auto& f : vl->files.elements) {
+            auto it = ratios.find(f.id);
+            if (it != ratios.end() && it->second >= opts.gc_garbage_ratio() && it->second > max_ratio) {
+                sst = candidate;
+                max_ratio = it->second;
+            }
+        }
+    }
+    if (!sst) {
+        co_return compaction_descriptor();
+    }
+    cmlog.debug("Rewriting {} of {} to reclaim value files, {:.2f} of which is garbage", sst->get_filename(), t, max_ratio);
+    co_return compaction_descriptor({ sst }, sst->get_sstable_level(), compaction_descriptor::default_max_sstable_bytes, sst->run_identifier());
+}
+
 class regular_compaction_task_executor : public compaction_task_executor, public regular_compaction_task_impl {
 public:
     regular_compaction_task_executor(compaction_manager& mgr, throw_if_stopping do_throw_if_stopping, compaction_group_view& t)
@@ -1529,6 +1566,9 @@ class regular_compaction_task_executor : public compaction_task_executor, public
             compaction_group_view& t = *_compacting_table;
             compaction_strategy cs = t.get_compaction_strategy();
             compaction_descriptor descriptor = co_await cs.get_sstables_for_compaction(t, _cm.get_strategy_control());
+            if (descriptor.sstables.empty()) {
+                descriptor = co_await get_value_log_gc_job(t, _cm.get_strategy_control());
+            }
             int weight = calculate_weight(descriptor);
             cmlog.debug("Started minor compaction sstables={} sstables_reapired_at={} range={} uuid={} compaction_uuid={}",
                     descriptor.sstables, compacting_table()->get_sstables_repaired_at(),
@@ -30,6 +30,7 @@
 #include "leveled_manifest.hh"
 #include "utils/to_string.hh"
 #include "incremental_compaction_strategy.hh"
+#include "lazy_leveled_compaction_strategy.hh"
 #include "sstables/sstable_set_impl.hh"
 
 namespace compaction {
@@ -181,6 +182,9 @@ void compaction_strategy_impl::validate_options_for_strategy_type(const std::map
         case compaction_strategy_type::incremental:
             incremental_compaction_strategy::validate_options(options, unchecked_options);
             break;
+        case compaction_strategy_type::lazy_leveled:
+            lazy_leveled_compaction_strategy::validate_options(options, unchecked_options);
+            break;
         default:
             break;
         case compaction_strategy_type::null:
@@ -569,6 +573,86 @@ class leveled_compaction_backlog_tracker final : public compaction_backlog_track
     }
 };
 
+class lazy_leveled_backlog_tracker final : public compaction_backlog_tracker::impl {
+    // The tiers are compacted like in STCS, and their backlog is accounted for the same way.
+    size_tiered_backlog_tracker _tiers_stcs;
+    uint64_t _tiers_size = 0;
+    uint64_t _last_level_size = 0;
+    unsigned _size_ratio;
+public:
+    lazy_leveled_backlog_tracker(unsigned size_ratio, size_tiered_compaction_strategy_options stcs_options)
+        : _tiers_stcs(stcs_options)
+        , _size_ratio(size_ratio)
+    {}
+
+    virtual double backlog(const compaction_backlog_tracker::ongoing_writes& ow, const compaction_backlog_tracker::ongoing_compactions& oc) const override {
+        int64_t tiers_size = _tiers_size;
+        int64_t last_level_size = _last_level_size;
+        compaction_backlog_tracker::ongoing_writes tiers_partial_writes;
+        compaction_backlog_tracker::ongoing_compactions tiers_compacted;
+
+        for (auto& op : ow) {
+            if (op.second->level() == 0) {
+                tiers_partial_writes.insert(op);
+                tiers_size += op.second->written();
+            } else {
+                last_level_size += op.second->written();
+            }
+        }
+
+        for (auto& cp : oc) {
+            if (lazy_leveled_compaction_strategy::in_last_level(cp.first)) {
+                last_level_size -= cp.second->compacted();
+            } else {
+                tiers_compacted.insert(cp);
+                tiers_size -= cp.second->compacted();
+            }
+        }
+
+        double b = _tiers_stcs.backlog(tiers_partial_writes, tiers_compacted);
+
+        // Every byte of the tiers is eventually merged into the last level, and the merge
+        // rewrites the last level too. At the latest, the merge happens when the last level
+        // is size_ratio times bigger than the tiers, so a byte of the tiers costs at most
+        // size_ratio + 1 bytes of writes.
+        tiers_size = std::max(tiers_size, int64_t(0));
+        last_level_size = std::max(last_level_size, int64_t(0));
+        b += std::min(double(tiers_size) * (_size_ratio + 1), double(tiers_size + last_level_size));
+        return b;
+    }
+
+    // Provides strong exception safety guarantees
+    virtual void replace_sstables(const std::vector<sstables::shared_sstable>& old_ssts, const std::vector<sstables::shared_sstable>& new_ssts) override {
+        auto tmp_tiers_size = _tiers_size;
+        auto tmp_last_level_size = _last_level_size;
+        std::vector<sstables::shared_sstable> tiers_old_ssts, tiers_new_ssts;
+        for (auto& sst : new_ssts) {
+            if (lazy_leveled_compaction_strategy::in_last_level(sst)) {
+                tmp_last_level_size += sst->data_size();
+            } else {
+                tmp_tiers_size += sst->data_size();
+                tiers_new_ssts.push_back(sst);
+            }
+        }
+        for (auto& sst : old_ssts) {
+            if (lazy_leveled_compaction_strategy::in_last_level(sst)) {
+                tmp_last_level_size -= sst->data_size();
+            } else {
+                tmp_tiers_size -= sst->data_size();
+                tiers_old_ssts.push_back(sst);
+            }
+        }
+        if (tiers_old_ssts.size() || tiers_new_ssts.size()) {
+            // stcs replace_sstables guarantees strong exception safety
+            _tiers_stcs.replace_sstables(tiers_old_ssts, tiers_new_ssts);
+        }
+        std::invoke([&] () noexcept {
+            _tiers_size = tmp_tiers_size;
+            _last_level_size = tmp_last_level_size;
+        });
+    }
+};
+
 struct unimplemented_backlog_tracker final : public compaction_backlog_tracker::impl {
     virtual double backlog(const compaction_backlog_tracker::ongoing_writes& ow, const compaction_backlog_tracker::ongoing_compactions& oc) const override {
         return compaction_controller::disable_backlog;
@@ -646,6 +730,10 @@ leveled_compaction_strategy::calculate_max_sstable_size_in_mb(std::optional<sstr
     return max_size;
 }
 
+std::unique_ptr<compaction_backlog_tracker::impl> lazy_leveled_compaction_strategy::make_backlog_tracker() const {
+    return std::make_unique<lazy_leveled_backlog_tracker>(_size_ratio, _stcs_options);
+}
+
 time_window_compaction_strategy::time_window_compaction_strategy(const std::map<sstring, sstring>& options)
     : compaction_strategy_impl(options)
     , _options(options)
@@ -785,6 +873,9 @@ compaction_strategy make_compaction_strategy(compaction_strategy_type strategy,
     case compaction_strategy_type::incremental:
         impl = make_shared<incremental_compaction_strategy>(incremental_compaction_strategy(options));
         break;
+    case compaction_strategy_type::lazy_leveled:
+        impl = ::make_shared<lazy_leveled_compaction_strategy>(options);
+        break;
     default:
         throw std::runtime_error("strategy not supported");
     }
@@ -812,6 +903,7 @@ compaction_strategy_state compaction_strategy_state::make(const compaction_strat
         case compaction_strategy_type::null:
         case compaction_strategy_type::size_tiered:
         case compaction_strategy_type::incremental:
+        case compaction_strategy_type::lazy_leveled:
             return compaction_strategy_state(default_empty_state{});
         case compaction_strategy_type::leveled:
             return compaction_strategy_state(seastar::make_shared<leveled_compaction_strategy_state>());
@@ -75,6 +75,8 @@ class compaction_strategy {
             return "InMemoryCompactionStrategy";
         case compaction_strategy_type::incremental:
             return "IncrementalCompactionStrategy";
+        case compaction_strategy_type::lazy_leveled:
+            return "LazyLeveledCompactionStrategy";
         default:
             throw std::runtime_error("Invalid Compaction Strategy");
         }
@@ -95,6 +97,8 @@ class compaction_strategy {
             return compaction_strategy_type::in_memory;
         } else if (short_name == "IncrementalCompactionStrategy") {
             return compaction_strategy_type::incremental;
+        } else if (short_name == "LazyLeveledCompactionStrategy") {
+            return compaction_strategy_type::lazy_leveled;
         } else {
             throw exceptions::configuration_exception(format("Unable to find compaction strategy class '{}'", name));
         }
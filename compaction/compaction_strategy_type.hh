@@ -19,6 +19,7 @@ enum class compaction_strategy_type {
     time_window,
     in_memory,
     incremental,
+    lazy_leveled,
 };
 
 enum class reshape_mode { strict, relaxed };
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <algorithm>
+#include <functional>
+
+#include "lazy_leveled_compaction_strategy.hh"
+#include "cql3/statements/property_definitions.hh"
+#include "sstables/sstables.hh"
+#include "sstables/sstable_set_impl.hh"
+
+namespace compaction {
+
+extern logging::logger clogger;
+
+static int32_t validate_sstable_size_in_mb(const std::map<sstring, sstring>& options) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, lazy_leveled_compaction_strategy::SSTABLE_SIZE_OPTION);
+    auto sstable_size_in_mb = cql3::statements::property_definitions::to_int(lazy_leveled_compaction_strategy::SSTABLE_SIZE_OPTION, tmp_value,
+            lazy_leveled_compaction_strategy::DEFAULT_MAX_SSTABLE_SIZE_IN_MB);
+    if (sstable_size_in_mb <= 0) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be positive", lazy_leveled_compaction_strategy::SSTABLE_SIZE_OPTION, sstable_size_in_mb));
+    }
+    return sstable_size_in_mb;
+}
+
+static unsigned validate_size_ratio(const std::map<sstring, sstring>& options) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, lazy_leveled_compaction_strategy::SIZE_RATIO_OPTION);
+    auto size_ratio = cql3::statements::property_definitions::to_int(lazy_leveled_compaction_strategy::SIZE_RATIO_OPTION, tmp_value,
+            lazy_leveled_compaction_strategy::DEFAULT_SIZE_RATIO);
+    if (size_ratio < 2) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be at least 2", lazy_leveled_compaction_strategy::SIZE_RATIO_OPTION, size_ratio));
+    }
+    return size_ratio;
+}
+
+static uint64_t total_bytes(const std::vector<sstables::shared_sstable>& sstables) {
+    uint64_t sum = 0;
+    for (auto& sst : sstables) {
+        sum += sst->ondisk_data_size();
+    }
+    return sum;
+}
+
+lazy_leveled_compaction_strategy::lazy_leveled_compaction_strategy(const std::map<sstring, sstring>& options)
+    : compaction_strategy_impl(options)
+    , _max_sstable_size(uint64_t(validate_sstable_size_in_mb(options)) * 1024 * 1024)
+    , _size_ratio(validate_size_ratio(options))
+    , _stcs_options(options)
+{
+}
+
+// options is a map of compaction strategy options and their values.
+// unchecked_options is an analogical map from which already checked options are deleted.
+// This helps making sure that only allowed options are being set.
+void lazy_leveled_compaction_strategy::validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    size_tiered_compaction_strategy_options::validate(options, unchecked_options);
+
+    validate_sstable_size_in_mb(options);
+    unchecked_options.erase(SSTABLE_SIZE_OPTION);
+    validate_size_ratio(options);
+    unchecked_options.erase(SIZE_RATIO_OPTION);
+}
+
+bool lazy_leveled_compaction_strategy::in_last_level(const sstables::shared_sstable& sst) {
+    return sst->get_sstable_level() > 0;
+}
+
+bool lazy_leveled_compaction_strategy::should_merge_into_last_level(uint64_t tiers_size, uint64_t last_level_size, uint64_t max_sstable_size, unsigned size_ratio) {
+    // Leveling a last level smaller than a single sstable is pointless, so the
+    // tiers first have to grow to the size of an sstable.
+    return tiers_size >= max_sstable_size && tiers_size * size_ratio >= last_level_size;
+}
+
+compaction_descriptor lazy_leveled_compaction_strategy::make_last_level_job(std::vector<sstables::shared_sstable> input, sstables::run_id run_identifier) const {
+    return compaction_descriptor(std::move(input), last_level, _max_sstable_size, run_identifier);
+}
+
+future<compaction_descriptor> lazy_leveled_compaction_strategy::get_sstables_for_compaction(compaction_group_view& table_s, strategy_control& control) {
+    int min_threshold = table_s.min_compaction_threshold();
+    int max_threshold = table_s.schema()->max_compaction_threshold();
+    auto candidates = co_await control.candidates(table_s);
+    auto main_set = co_await table_s.main_sstable_set();
+
+    std::vector<sstables::shared_sstable> tiers;
+    std::vector<sstables::shared_sstable> last;
+    for (auto& sst : candidates) {
+        (in_last_level(sst) ? last : tiers).push_back(sst);
+    }
+
+    uint64_t last_level_size = 0;
+    size_t last_level_count = 0;
+    main_set->for_each_sstable([&] (const sstables::shared_sstable& sst) {
+        if (in_last_level(sst)) {
+            last_level_size += sst->ondisk_data_size();
+            last_level_count++;
+        }
+    });
+
+    // A merge rewrites the whole last level, so it can't start while an sstable of the
+    // last level is being compacted. When the last level is empty, the sstables being
+    // compacted may be the tiers of a merge creating it, so any compaction in this
+    // group holds back the merge.
+    bool last_level_idle = last_level_count ? last.size() == last_level_count : !control.has_ongoing_compaction(table_s);
+    if (!tiers.empty() && last_level_idle && should_merge_into_last_level(total_bytes(tiers), last_level_size, _max_sstable_size, _size_ratio)) {
+        // The biggest tiers hold most of the data, the smaller ones are merged by the next merge.
+        if (tiers.size() > size_t(max_threshold)) {
+            std::ranges::partial_sort(tiers, tiers.begin() + max_threshold, std::ranges::greater(), &sstables::sstable::ondisk_data_size);
+            tiers.resize(max_threshold);
+        }
+        clogger.debug("lazy_leveled: merging {} sstables of the tiers into the last level of {} sstables", tiers.size(), last.size());
+        std::ranges::move(tiers, std::back_inserter(last));
+        co_return make_last_level_job(std::move(last));
+    }
+
+    auto bucket = size_tiered_compaction_strategy::most_interesting_bucket(tiers, min_threshold, max_threshold, _stcs_options);
+    // If we are not enforcing min_threshold explicitly, try any pair of SStables in the same tier.
+    if (bucket.empty() && !table_s.compaction_enforce_min_threshold()) {
+        bucket = size_tiered_compaction_strategy::most_interesting_bucket(tiers, 2, max_threshold, _stcs_options);
+    }
+    if (!bucket.empty()) {
+        co_return compaction_descriptor(std::move(bucket));
+    }
+
+    if (!table_s.tombstone_gc_enabled()) {
+        co_return compaction_descriptor();
+    }
+
+    // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
+    // ratio is greater than threshold. The last level holds the oldest data, so its tombstones are the least
+    // likely to shadow data in other sstables. Compacting a single sstable of the last level into the last
+    // level, in the same run, keeps it a single disjoint run.
+    auto compaction_time = gc_clock::now();
+    for (auto* level : {&last, &tiers}) {
+        std::erase_if(*level, [this, compaction_time, &table_s] (const sstables::shared_sstable& sst) -> bool {
+            return !worth_dropping_tombstones(sst, compaction_time, table_s);
+        });
+        if (level->empty()) {
+            continue;
+        }
+        // find oldest sstable
+        auto sst = *std::ranges::min_element(*level, [] (const sstables::shared_sstable& i, const sstables::shared_sstable& j) {
+            return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
+        });
+        if (in_last_level(sst)) {
+            co_return make_last_level_job({ sst }, sst->run_identifier());
+        }
+        co_return compaction_descriptor({ sst });
+    }
+    co_return compaction_descriptor();
+}
+
+compaction_descriptor lazy_leveled_compaction_strategy::get_major_compaction_job(compaction_group_view& table_s, std::vector<sstables::shared_sstable> candidates) {
+    if (candidates.empty()) {
+        return compaction_descriptor();
+    }
+    return make_major_compaction_job(std::move(candidates), last_level, _max_sstable_size);
+}
+
+std::vector<compaction_descriptor>
+lazy_leveled_compaction_strategy::get_cleanup_compaction_jobs(compaction_group_view& table_s, std::vector<sstables::shared_sstable> candidates) const {
+    std::vector<sstables::shared_sstable> tiers;
+    std::vector<sstables::shared_sstable> last;
+    for (auto& sst : candidates) {
+        (in_last_level(sst) ? last : tiers).push_back(std::move(sst));
+    }
+
+    auto ret = size_tiered_compaction_strategy(_stcs_options).get_cleanup_compaction_jobs(table_s, std::move(tiers));
+    if (!last.empty()) {
+        ret.push_back(make_last_level_job(std::move(last)));
+    }
+    return ret;
+}
+
+future<int64_t> lazy_leveled_compaction_strategy::estimated_pending_compactions(compaction_group_view& table_s) const {
+    int min_threshold = table_s.min_compaction_threshold();
+    int max_threshold = table_s.schema()->max_compaction_threshold();
+    std::vector<sstables::shared_sstable> tiers;
+    uint64_t last_level_size = 0;
+
+    auto main_set = co_await table_s.main_sstable_set();
+    main_set->for_each_sstable([&] (const sstables::shared_sstable& sst) {
+        if (in_last_level(sst)) {
+            last_level_size += sst->ondisk_data_size();
+        } else {
+            tiers.push_back(sst);
+        }
+    });
+
+    auto n = size_tiered_compaction_strategy::estimated_pending_compactions(tiers, min_threshold, max_threshold, _stcs_options);
+    if (!tiers.empty() && should_merge_into_last_level(total_bytes(tiers), last_level_size, _max_sstable_size, _size_ratio)) {
+        n++;
+    }
+    co_return n;
+}
+
+compaction_descriptor
+lazy_leveled_compaction_strategy::get_reshaping_job(std::vector<sstables::shared_sstable> input, schema_ptr schema, reshape_config cfg) const {
+    auto mode = cfg.mode;
+    std::vector<sstables::shared_sstable> tiers;
+    std::vector<sstables::shared_sstable> last;
+    for (auto& sst : input) {
+        (in_last_level(sst) ? last : tiers).push_back(sst);
+    }
+
+    auto by_first_key = [&schema] (const sstables::shared_sstable& a, const sstables::shared_sstable& b) {
+        return dht::ring_position(a->get_first_decorated_key()).less_compare(*schema, dht::ring_position(b->get_first_decorated_key()));
+    };
+    std::ranges::sort(tiers, by_first_key);
+    std::ranges::sort(last, by_first_key);
+
+    // If there's only disjoint sstables in the tiers like on bootstrap, they make a last level.
+    size_t offstrategy_threshold = std::max(schema->min_compaction_threshold(), 4);
+    if (mode == reshape_mode::strict && last.empty() && tiers.size() >= offstrategy_threshold && sstable_set_overlapping_count(schema, tiers) == 0) {
+        clogger.info("Reshaping {} disjoint sstables into the last level", tiers.size());
+        auto desc = make_last_level_job(std::move(tiers));
+        desc.options = compaction_type_options::make_reshape();
+        return desc;
+    }
+
+    auto desc = size_tiered_compaction_strategy(_stcs_options).get_reshaping_job(std::move(tiers), schema, cfg);
+    if (!desc.sstables.empty()) {
+        return desc;
+    }
+
+    // The last level may be overlapping when it comes from another strategy, e.g. from
+    // the levels of LCS, so it's rewritten into a single run.
+    unsigned tolerance = mode == reshape_mode::strict ? 0 : _size_ratio;
+    auto overlapping_sstables = sstable_set_overlapping_count(schema, last);
+    if (overlapping_sstables > tolerance) {
+        clogger.warn("The last level of {}.{} is not disjoint, found {} overlapping SSTables, so it will be entirely compacted",
+                schema->ks_name(), schema->cf_name(), overlapping_sstables);
+        desc = make_last_level_job(std::move(last));
+        desc.options = compaction_type_options::make_reshape();
+        return desc;
+    }
+
+    return compaction_descriptor();
+}
+
+std::unique_ptr<sstables::sstable_set_impl> lazy_leveled_compaction_strategy::make_sstable_set(const compaction_group_view& ts) const {
+    return std::make_unique<sstables::partitioned_sstable_set>(ts.schema(), ts.token_range());
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <seastar/core/sstring.hh>
+
+#include "compaction_strategy_type.hh"
+#include "size_tiered_compaction_strategy.hh"
+#include "compaction_strategy_impl.hh"
+#include "compaction_backlog_manager.hh"
+#include "sstables/shared_sstable.hh"
+
+namespace sstables {
+class sstable_set_impl;
+}
+
+namespace compaction {
+
+class lazy_leveled_backlog_tracker;
+
+// Lazy leveling keeps the data of a compaction group in two parts:
+//  - the tiers, in level 0, which are compacted with each other like in STCS,
+//  - the last level, a single run of disjoint sstables.
+//
+// When the tiers grow to 1/size_ratio of the last level, all of them are merged
+// with the last level, into a new last level. So a write is rewritten about
+// log(size) times in the tiers, like in STCS, plus size_ratio times into the last
+// level, where LCS rewrites it size_ratio times in every level. A read looks at
+// the tiers, and at a single sstable of the last level, which holds most of the
+// data.
+//
+// A merge rewrites the whole last level in one job. The last level is a single
+// run, so the compaction releases each of its sstables once it has written past
+// their last key, like with ICS. A merge thus temporarily needs extra space for
+// about the tiers and one sstable of the last level, not a copy of the last level.
+class lazy_leveled_compaction_strategy : public compaction_strategy_impl {
+public:
+    static constexpr int32_t DEFAULT_MAX_SSTABLE_SIZE_IN_MB = 160;
+    static constexpr unsigned DEFAULT_SIZE_RATIO = 10;
+    static constexpr auto SSTABLE_SIZE_OPTION = "sstable_size_in_mb";
+    static constexpr auto SIZE_RATIO_OPTION = "size_ratio";
+    // Sstables of a level greater than 0 belong to the last level, and the
+    // last level is written to this level.
+    static constexpr int last_level = 1;
+private:
+    uint64_t _max_sstable_size;
+    unsigned _size_ratio;
+    size_tiered_compaction_strategy_options _stcs_options;
+private:
+    compaction_descriptor make_last_level_job(std::vector<sstables::shared_sstable> input,
+            sstables::run_id run_identifier = sstables::run_id::create_random_id()) const;
+public:
+    static void validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
+
+    lazy_leveled_compaction_strategy(const std::map<sstring, sstring>& options);
+
+    static bool in_last_level(const sstables::shared_sstable& sst);
+
+    // Returns whether tiers of tiers_size bytes are to be merged into a last level
+    // of last_level_size bytes.
+    static bool should_merge_into_last_level(uint64_t tiers_size, uint64_t last_level_size, uint64_t max_sstable_size, unsigned size_ratio);
+
+    virtual future<compaction_descriptor> get_sstables_for_compaction(compaction_group_view& table_s, strategy_control& control) override;
+
+    virtual compaction_descriptor get_major_compaction_job(compaction_group_view& table_s, std::vector<sstables::shared_sstable> candidates) override;
+
+    virtual std::vector<compaction_descriptor> get_cleanup_compaction_jobs(compaction_group_view& table_s, std::vector<sstables::shared_sstable> candidates) const override;
+
+    virtual future<int64_t> estimated_pending_compactions(compaction_group_view& table_s) const override;
+
+    virtual compaction_strategy_type type() const override {
+        return compaction_strategy_type::lazy_leveled;
+    }
+
+    virtual std::unique_ptr<sstables::sstable_set_impl> make_sstable_set(const compaction_group_view& ts) const override;
+
+    virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const override;
+
+    virtual compaction_descriptor get_reshaping_job(std::vector<sstables::shared_sstable> input, schema_ptr schema, reshape_config cfg) const override;
+
+    friend class ::compaction::lazy_leveled_backlog_tracker;
+};
+
+}
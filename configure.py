@@ -593,6 +593,7 @@ scylla_tests = set([
     'test/boost/index_reader_test',
     'test/boost/input_stream_test',
     'test/boost/intrusive_array_test',
+    'test/boost/inverted_index_test',
     'test/boost/json_test',
     'test/boost/keys_test',
     'test/boost/like_matcher_test',
@@ -714,6 +715,8 @@ perf_tests = set([
     'test/perf/perf_big_decimal',
     'test/perf/perf_bti_key_translation',
     'test/perf/perf_sort_by_proximity',
+    'test/perf/perf_vector_similarity',
+    'test/perf/perf_bloom_filter',
 ])
 
 perf_standalone_tests = set([
@@ -738,6 +741,7 @@ vector_search_tests = set([
     'test/vector_search/load_balancer_test',
     'test/vector_search/client_test',
     'test/vector_search/filter_test',
+    'test/vector_search/hnsw_index_test',
 ])
 
 wasms = set([
@@ -909,12 +913,14 @@ scylla_core = (['message/messaging_service.cc',
                 'replica/dirty_memory_manager.cc',
                 'replica/multishard_query.cc',
                 'replica/mutation_dump.cc',
+                'replica/local_index.cc',
                 'replica/querier.cc',
                 'replica/logstor/segment_io.cc',
                 'replica/logstor/segment_manager.cc',
                 'replica/logstor/logstor.cc',
                 'replica/logstor/write_buffer.cc',
                 'replica/logstor/cache.cc',
+                'replica/logstor/compression.cc',
                 'mutation/atomic_cell.cc',
                 'mutation/canonical_mutation.cc',
                 'mutation/frozen_mutation.cc',
@@ -971,7 +977,11 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/sstables.cc',
                 'sstables/sstables_manager.cc',
                 'sstables/sstable_set.cc',
+                'sstables/combined_filter.cc',
+                'sstables/decompressed_chunk_cache.cc',
+                'sstables/repair_summary.cc',
                 'sstables/storage.cc',
+                'sstables/value_log.cc',
                 'sstables/mx/partition_reversing_data_source.cc',
                 'sstables/mx/reader.cc',
                 'sstables/mx/writer.cc',
@@ -991,6 +1001,7 @@ scylla_core = (['message/messaging_service.cc',
                 'compaction/compaction_manager.cc',
                 'compaction/incremental_compaction_strategy.cc',
                 'compaction/incremental_backlog_tracker.cc',
+                'compaction/lazy_leveled_compaction_strategy.cc',
                 'sstables/integrity_checked_file_impl.cc',
                 'sstables/object_storage_client.cc',
                 'sstables/prepended_input_stream.cc',
@@ -1075,6 +1086,7 @@ scylla_core = (['message/messaging_service.cc',
                 'cql3/statements/external_search/fulltext_indexed_table_select_statement.cc',
                 'cql3/statements/external_search/external_score_provider.cc',
                 'cql3/statements/external_search/filter.cc',
+                'cql3/statements/external_search/local_index.cc',
                 'cql3/statements/use_statement.cc',
                 'cql3/statements/index_prop_defs.cc',
                 'cql3/statements/index_target.cc',
@@ -1161,6 +1173,7 @@ scylla_core = (['message/messaging_service.cc',
                 'db/large_data_handler.cc',
                 'db/marshal/type_parser.cc',
                 'db/per_partition_rate_limit_options.cc',
+                'db/value_log_options.cc',
                 'db/rate_limiter.cc',
                 'db/row_cache.cc',
                 'db/schema_applier.cc',
@@ -1190,10 +1203,13 @@ scylla_core = (['message/messaging_service.cc',
                 'index/external_index.cc',
                 'index/vector_index.cc',
                 'index/fulltext_index.cc',
+                'index/inverted_index.cc',
                 'index/index_option_utils.cc',
                 'utils/UUID_gen.cc',
                 'utils/i_filter.cc',
                 'utils/bloom_filter.cc',
+                'utils/binary_fuse_filter.cc',
+                'utils/frequency_sketch.cc',
                 'utils/bloom_calculations.cc',
                 'utils/rate_limiter.cc',
                 'utils/file_lock.cc',
@@ -1405,7 +1421,8 @@ scylla_core = (['message/messaging_service.cc',
                 'vector_search/dns.cc',
                 'vector_search/client.cc',
                 'vector_search/clients.cc',
-                'vector_search/truststore.cc'
+                'vector_search/truststore.cc',
+                'vector_search/hnsw_index.cc'
                 ] + [Antlr3Grammar('cql3/Cql.g')] \
                   + scylla_raft_core
                )
@@ -1538,6 +1555,7 @@ idls = ['idl/gossip_digest.idl.hh',
         "idl/tasks.idl.hh",
         "idl/client_state.idl.hh",
         "idl/forward_cql.idl.hh",
+        "idl/alternator.idl.hh",
         ]
 
 scylla_tests_generic_dependencies = [
@@ -1638,6 +1656,7 @@ pure_boost_tests = set([
     'test/boost/top_k_test',
     'test/boost/vint_serialization_test',
     'test/boost/utf8_test',
+    'test/boost/inverted_index_test',
     'test/boost/string_format_test',
     'test/manual/streaming_histogram_test',
 ])
@@ -1815,6 +1834,7 @@ deps['test/boost/reusable_buffer_test'] = [
 deps['test/boost/utf8_test'] = ['utils/utf8.cc', 'test/boost/utf8_test.cc']
 deps['test/boost/small_vector_test'] = ['test/boost/small_vector_test.cc']
 deps['test/boost/vint_serialization_test'] = ['test/boost/vint_serialization_test.cc', 'vint-serialization.cc', 'bytes.cc']
+deps['test/boost/inverted_index_test'] = ['test/boost/inverted_index_test.cc', 'index/inverted_index.cc', 'vint-serialization.cc', 'bytes.cc']
 deps['test/boost/linearizing_input_stream_test'] = [
     "test/boost/linearizing_input_stream_test.cc",
     "test/lib/log.cc",
@@ -1848,6 +1868,7 @@ deps['test/vector_search/vector_store_client_test'] =  ['test/vector_search/vect
 deps['test/vector_search/load_balancer_test'] = ['test/vector_search/load_balancer_test.cc'] + scylla_tests_dependencies
 deps['test/vector_search/client_test'] = ['test/vector_search/client_test.cc'] + scylla_tests_dependencies
 deps['test/vector_search/filter_test'] = ['test/vector_search/filter_test.cc'] + scylla_tests_dependencies
+deps['test/vector_search/hnsw_index_test'] = ['test/vector_search/hnsw_index_test.cc'] + scylla_tests_dependencies
 
 boost_tests_prefixes = ["test/boost/", "test/vector_search/", "test/raft/", "test/manual/", "test/ldap/"]
 
@@ -14,22 +14,32 @@
 #include <span>
 #include <seastar/core/byteorder.hh>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace cql3 {
 namespace functions {
 
 namespace detail {
 
+void validate_float_vector_size(bytes_view param, vector_dimension_t dimension) {
+    const size_t expected_size = dimension * sizeof(float);
+    if (param.size() != expected_size) {
+        throw exceptions::invalid_request_exception(
+            fmt::format("Invalid vector size: expected {} bytes for {} floats, got {} bytes",
+                       expected_size, dimension, param.size()));
+    }
+}
+
 std::vector<float> extract_float_vector(const bytes_opt& param, vector_dimension_t dimension) {
     if (!param) {
         throw exceptions::invalid_request_exception("Cannot extract float vector from null parameter");
     }
 
-    const size_t expected_size = dimension * sizeof(float);
-    if (param->size() != expected_size) {
-        throw exceptions::invalid_request_exception(
-            fmt::format("Invalid vector size: expected {} bytes for {} floats, got {} bytes",
-                       expected_size, dimension, param->size()));
-    }
+    validate_float_vector_size(*param, dimension);
 
     std::vector<float> result(dimension);
     const char* p = reinterpret_cast<const char*>(param->data());
@@ -44,28 +54,157 @@ std::vector<float> extract_float_vector(const bytes_opt& param, vector_dimension
 
 namespace {
 
-// The computations of similarity scores match the exact formulas of Cassandra's (jVector's) implementation to ensure compatibility.
-// There exist tests checking the compliance of the results.
-// Reference:
-// https://github.com/datastax/jvector/blob/f967f1c9249035b63b55a566fac7d4dc38380349/jvector-base/src/main/java/io/github/jbellis/jvector/vector/VectorSimilarityFunction.java#L36-L69
+// The kernels below work on two kinds of vector representations:
+//  - `const float*` points to native floats (e.g. the query vector),
+//  - `const int8_t*` points to the vector<float, N> wire format, i.e. N
+//    big-endian IEEE 754 values, which is how vectors are stored in cells.
+// Reading the wire format directly avoids deserializing every candidate
+// row into a temporary std::vector<float> during rescoring.
+//
+// The SIMD flavour is chosen at compile time, based on the target
+// architecture (x86-64-v3, i.e. AVX2 + FMA, by default), with a scalar
+// fallback for the remaining architectures and for the tail elements.
+
+inline float load_scalar(const float* p, size_t i) {
+    return p[i];
+}
 
-// You should only use this function if you need to preserve the original vectors and cannot normalize
-// them in advance.
-float compute_cosine_similarity(std::span<const float> v1, std::span<const float> v2) {
-    #pragma clang fp contract(fast) reassociate(on) // Allow the compiler to optimize the loop.
-    float dot_product = 0.0;
-    float squared_norm_a = 0.0;
-    float squared_norm_b = 0.0;
+inline float load_scalar(const int8_t* p, size_t i) {
+    return std::bit_cast<float>(read_be<uint32_t>(reinterpret_cast<const char*>(p) + i * sizeof(float)));
+}
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+
+struct simd {
+    using reg = __m512;
+    static constexpr size_t width = 16;
+
+    static reg zero() { return _mm512_setzero_ps(); }
+    static reg load(const float* p, size_t i) { return _mm512_loadu_ps(p + i); }
+    static reg load(const int8_t* p, size_t i) {
+        const __m512i bswap32 = _mm512_set4_epi32(0x0c0d0e0f, 0x08090a0b, 0x04050607, 0x00010203);
+        auto raw = _mm512_loadu_si512(p + i * sizeof(float));
+        return _mm512_castsi512_ps(_mm512_shuffle_epi8(raw, bswap32));
+    }
+    static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+    // Returns a * b + c.
+    static reg fma(reg a, reg b, reg c) { return _mm512_fmadd_ps(a, b, c); }
+    static float sum(reg a) { return _mm512_reduce_add_ps(a); }
+};
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+struct simd {
+    using reg = __m256;
+    static constexpr size_t width = 8;
+
+    static reg zero() { return _mm256_setzero_ps(); }
+    static reg load(const float* p, size_t i) { return _mm256_loadu_ps(p + i); }
+    static reg load(const int8_t* p, size_t i) {
+        const __m256i bswap32 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                                 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        auto raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i * sizeof(float)));
+        return _mm256_castsi256_ps(_mm256_shuffle_epi8(raw, bswap32));
+    }
+    static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+    static reg fma(reg a, reg b, reg c) { return _mm256_fmadd_ps(a, b, c); }
+    static float sum(reg a) {
+        auto s = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        s = _mm_hadd_ps(s, s);
+        s = _mm_hadd_ps(s, s);
+        return _mm_cvtss_f32(s);
+    }
+};
+
+#elif defined(__aarch64__)
+
+struct simd {
+    using reg = float32x4_t;
+    static constexpr size_t width = 4;
+
+    static reg zero() { return vdupq_n_f32(0); }
+    static reg load(const float* p, size_t i) { return vld1q_f32(p + i); }
+    static reg load(const int8_t* p, size_t i) {
+        return vreinterpretq_f32_u8(vrev32q_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(p + i * sizeof(float)))));
+    }
+    static reg sub(reg a, reg b) { return vsubq_f32(a, b); }
+    static reg fma(reg a, reg b, reg c) { return vfmaq_f32(c, a, b); }
+    static float sum(reg a) { return vaddvq_f32(a); }
+};
+
+#else
+
+struct simd {
+    using reg = float;
+    static constexpr size_t width = 1;
+
+    static reg zero() { return 0; }
+    static reg load(const float* p, size_t i) { return load_scalar(p, i); }
+    static reg load(const int8_t* p, size_t i) { return load_scalar(p, i); }
+    static reg sub(reg a, reg b) { return a - b; }
+    static reg fma(reg a, reg b, reg c) { return a * b + c; }
+    static float sum(reg a) { return a; }
+};
 
-    for (size_t i = 0; i < v1.size(); ++i) {
-        float a = v1[i];
-        float b = v2[i];
+#endif
+
+struct dot_product_terms {
+    float dot_product = 0;
+    float squared_norm_a = 0;
+    float squared_norm_b = 0;
+};
+
+// Accumulates a.b, and optionally |a|^2 and |b|^2, in a single pass.
+template <bool WithNormA, typename A, typename B>
+dot_product_terms compute_dot_product_terms(A a, B b, size_t dimension) {
+    auto dot_product = simd::zero();
+    auto squared_norm_a = simd::zero();
+    auto squared_norm_b = simd::zero();
+    size_t i = 0;
+    for (; i + simd::width <= dimension; i += simd::width) {
+        auto va = simd::load(a, i);
+        auto vb = simd::load(b, i);
+        dot_product = simd::fma(va, vb, dot_product);
+        if constexpr (WithNormA) {
+            squared_norm_a = simd::fma(va, va, squared_norm_a);
+        }
+        squared_norm_b = simd::fma(vb, vb, squared_norm_b);
+    }
+    dot_product_terms ret{simd::sum(dot_product), simd::sum(squared_norm_a), simd::sum(squared_norm_b)};
+    for (; i < dimension; ++i) {
+        float va = load_scalar(a, i);
+        float vb = load_scalar(b, i);
+        ret.dot_product += va * vb;
+        if constexpr (WithNormA) {
+            ret.squared_norm_a += va * va;
+        }
+        ret.squared_norm_b += vb * vb;
+    }
+    return ret;
+}
 
-        dot_product += a * b;
-        squared_norm_a += a * a;
-        squared_norm_b += b * b;
+template <typename A, typename B>
+float compute_squared_distance(A a, B b, size_t dimension) {
+    auto sum = simd::zero();
+    size_t i = 0;
+    for (; i + simd::width <= dimension; i += simd::width) {
+        auto diff = simd::sub(simd::load(a, i), simd::load(b, i));
+        sum = simd::fma(diff, diff, sum);
     }
+    float ret = simd::sum(sum);
+    for (; i < dimension; ++i) {
+        float diff = load_scalar(a, i) - load_scalar(b, i);
+        ret += diff * diff;
+    }
+    return ret;
+}
 
+// The computations of similarity scores match the exact formulas of Cassandra's (jVector's) implementation to ensure compatibility.
+// There exist tests checking the compliance of the results.
+// Reference:
+// https://github.com/datastax/jvector/blob/f967f1c9249035b63b55a566fac7d4dc38380349/jvector-base/src/main/java/io/github/jbellis/jvector/vector/VectorSimilarityFunction.java#L36-L69
+
+float cosine_similarity_from_terms(float dot_product, float squared_norm_a, float squared_norm_b) {
     if (squared_norm_a == 0 || squared_norm_b == 0) {
         return std::numeric_limits<float>::quiet_NaN();
     }
@@ -76,48 +215,98 @@ float compute_cosine_similarity(std::span<const float> v1, std::span<const float
     return (1 + (dot_product / (std::sqrt(squared_norm_a * squared_norm_b)))) / 2;
 }
 
-float compute_euclidean_similarity(std::span<const float> v1, std::span<const float> v2) {
-    #pragma clang fp contract(fast) reassociate(on) // Allow the compiler to optimize the loop.
-    float sum = 0.0;
-
-    for (size_t i = 0; i < v1.size(); ++i) {
-        float a = v1[i];
-        float b = v2[i];
-
-        float diff = a - b;
-        sum += diff * diff;
-    }
-
+float euclidean_similarity_from_distance(float squared_distance) {
     // The squared Euclidean (L2) distance is of range [0, inf).
     // It is mapped to a similarity score in the range (0, 1] (0 -> 1, inf -> 0)
     // for consistency with other similarity functions.
-    return (1 / (1 + sum));
+    return (1 / (1 + squared_distance));
+}
+
+float dot_product_similarity_from_dot_product(float dot_product) {
+    // The dot product is in the range [-1, 1] for L2-normalized vectors.
+    // It is mapped to a similarity score in the range [0, 1] (-1 -> 0, 1 -> 1)
+    // for consistency with other similarity functions.
+    return ((1 + dot_product) / 2);
+}
+
+// You should only use this function if you need to preserve the original vectors and cannot normalize
+// them in advance.
+template <typename A, typename B>
+float compute_cosine_similarity(A a, B b, size_t dimension) {
+    auto terms = compute_dot_product_terms<true>(a, b, dimension);
+    return cosine_similarity_from_terms(terms.dot_product, terms.squared_norm_a, terms.squared_norm_b);
+}
+
+template <typename A, typename B>
+float compute_euclidean_similarity(A a, B b, size_t dimension) {
+    return euclidean_similarity_from_distance(compute_squared_distance(a, b, dimension));
 }
 
 // Assumes that both vectors are L2-normalized.
 // This similarity is intended as an optimized way to perform cosine similarity calculation.
-float compute_dot_product_similarity(std::span<const float> v1, std::span<const float> v2) {
-    #pragma clang fp contract(fast) reassociate(on) // Allow the compiler to optimize the loop.
-    float dot_product = 0.0;
+template <typename A, typename B>
+float compute_dot_product_similarity(A a, B b, size_t dimension) {
+    return dot_product_similarity_from_dot_product(compute_dot_product_terms<false>(a, b, dimension).dot_product);
+}
+
+template <float (*Kernel)(const float*, const float*, size_t)>
+float native_similarity(std::span<const float> v1, std::span<const float> v2) {
+    return Kernel(v1.data(), v2.data(), v1.size());
+}
+
+template <float (*Kernel)(const int8_t*, const int8_t*, size_t)>
+float serialized_similarity(bytes_view v1, bytes_view v2) {
+    return Kernel(v1.data(), v2.data(), v1.size() / sizeof(float));
+}
+
+void validate_batch(std::span<const float> query, std::span<const bytes_view> vectors, std::span<float> results) {
+    if (results.size() != vectors.size()) {
+        throw std::invalid_argument(fmt::format("Similarity batch of {} vectors was given room for {} results", vectors.size(), results.size()));
+    }
+    for (auto v : vectors) {
+        detail::validate_float_vector_size(v, query.size());
+    }
+}
 
-    for (size_t i = 0; i < v1.size(); ++i) {
-        float a = v1[i];
-        float b = v2[i];
-        dot_product += a * b;
+void cosine_similarity_batch(std::span<const float> query, std::span<const bytes_view> vectors, std::span<float> results) {
+    validate_batch(query, vectors, results);
+    // The query norm is shared by all rows, so it is computed only once.
+    auto squared_norm_query = compute_dot_product_terms<false>(query.data(), query.data(), query.size()).squared_norm_b;
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        auto terms = compute_dot_product_terms<false>(query.data(), vectors[i].data(), query.size());
+        results[i] = cosine_similarity_from_terms(terms.dot_product, squared_norm_query, terms.squared_norm_b);
     }
+}
 
-    // The dot product is in the range [-1, 1] for L2-normalized vectors.
-    // It is mapped to a similarity score in the range [0, 1] (-1 -> 0, 1 -> 1)
-    // for consistency with other similarity functions.
-    return ((1 + dot_product) / 2);
+void euclidean_similarity_batch(std::span<const float> query, std::span<const bytes_view> vectors, std::span<float> results) {
+    validate_batch(query, vectors, results);
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        results[i] = compute_euclidean_similarity(query.data(), vectors[i].data(), query.size());
+    }
+}
+
+void dot_product_similarity_batch(std::span<const float> query, std::span<const bytes_view> vectors, std::span<float> results) {
+    validate_batch(query, vectors, results);
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        results[i] = compute_dot_product_similarity(query.data(), vectors[i].data(), query.size());
+    }
 }
 
 } // namespace
 
-thread_local const std::unordered_map<function_name, similarity_function_t> SIMILARITY_FUNCTIONS = {
-        {SIMILARITY_COSINE_FUNCTION_NAME, compute_cosine_similarity},
-        {SIMILARITY_EUCLIDEAN_FUNCTION_NAME, compute_euclidean_similarity},
-        {SIMILARITY_DOT_PRODUCT_FUNCTION_NAME, compute_dot_product_similarity},
+thread_local const std::unordered_map<function_name, similarity_kernels> SIMILARITY_FUNCTIONS = {
+        {SIMILARITY_COSINE_FUNCTION_NAME, {
+                native_similarity<compute_cosine_similarity<const float*, const float*>>,
+                serialized_similarity<compute_cosine_similarity<const int8_t*, const int8_t*>>,
+                cosine_similarity_batch}},
+        {SIMILARITY_EUCLIDEAN_FUNCTION_NAME, {
+                native_similarity<compute_euclidean_similarity<const float*, const float*>>,
+                serialized_similarity<compute_euclidean_similarity<const int8_t*, const int8_t*>>,
+                euclidean_similarity_batch}},
+        {SIMILARITY_DOT_PRODUCT_FUNCTION_NAME, {
+                native_similarity<compute_dot_product_similarity<const float*, const float*>>,
+                serialized_similarity<compute_dot_product_similarity<const int8_t*, const int8_t*>>,
+                dot_product_similarity_batch}},
 };
 
 std::vector<data_type> retrieve_vector_arg_types(const function_name& name, const std::vector<shared_ptr<assignment_testable>>& provided_args) {
@@ -172,11 +361,11 @@ bytes_opt vector_similarity_fct::execute(std::span<const bytes_opt> parameters)
     const auto& type = static_cast<const vector_type_impl&>(*arg_types()[0]);
     vector_dimension_t dimension = type.get_dimension();
 
-    // Optimized path: extract floats directly from bytes, bypassing data_value overhead
-    std::vector<float> v1 = detail::extract_float_vector(parameters[0], dimension);
-    std::vector<float> v2 = detail::extract_float_vector(parameters[1], dimension);
+    // Optimized path: compute directly on the serialized bytes, bypassing data_value overhead
+    detail::validate_float_vector_size(*parameters[0], dimension);
+    detail::validate_float_vector_size(*parameters[1], dimension);
 
-    float result = SIMILARITY_FUNCTIONS.at(_name)(v1, v2);
+    float result = SIMILARITY_FUNCTIONS.at(_name).serialized(*parameters[0], *parameters[1]);
     return float_type->decompose(result);
 }
 
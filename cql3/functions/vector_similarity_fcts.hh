@@ -21,7 +21,23 @@ static const function_name SIMILARITY_EUCLIDEAN_FUNCTION_NAME = function_name::n
 static const function_name SIMILARITY_DOT_PRODUCT_FUNCTION_NAME = function_name::native_function("similarity_dot_product");
 
 using similarity_function_t = float (*)(std::span<const float>, std::span<const float>);
-extern thread_local const std::unordered_map<function_name, similarity_function_t> SIMILARITY_FUNCTIONS;
+
+// Similarity of two vectors in the vector<float, N> wire format (N big-endian floats).
+// Both views must hold the same number of floats.
+using serialized_similarity_function_t = float (*)(bytes_view, bytes_view);
+
+// Similarity of each serialized vector to a single native query vector, written to
+// the corresponding element of the results span. Intended for rescoring many candidate
+// rows at once. Throws invalid_request_exception if a vector has the wrong size.
+using batch_similarity_function_t = void (*)(std::span<const float> query, std::span<const bytes_view> vectors, std::span<float> results);
+
+struct similarity_kernels {
+    similarity_function_t native;
+    serialized_similarity_function_t serialized;
+    batch_similarity_function_t batch;
+};
+
+extern thread_local const std::unordered_map<function_name, similarity_kernels> SIMILARITY_FUNCTIONS;
 
 std::vector<data_type> retrieve_vector_arg_types(const function_name& name, const std::vector<shared_ptr<assignment_testable>>& provided_args);
 
@@ -41,6 +57,9 @@ namespace detail {
 // Vector<float, N> wire format: N floats as big-endian uint32_t values, 4 bytes each.
 std::vector<float> extract_float_vector(const bytes_opt& param, vector_dimension_t dimension);
 
+// Throws invalid_request_exception unless param holds exactly `dimension` serialized floats.
+void validate_float_vector_size(bytes_view param, vector_dimension_t dimension);
+
 } // namespace detail
 
 } // namespace functions
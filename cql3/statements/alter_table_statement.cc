@@ -34,6 +34,7 @@
 #include "cdc/cdc_partitioner.hh"
 #include "db/tags/extension.hh"
 #include "db/tags/utils.hh"
+#include "db/value_log_extension.hh"
 #include "alternator/ttl_tag.hh"
 
 namespace cql3 {
@@ -426,6 +427,14 @@ std::pair<schema_ptr, std::vector<view_ptr>> alter_table_statement::prepare_sche
                 throw exceptions::invalid_request_exception("Cannot set default_time_to_live on a table with counters");
             }
 
+            // Tables with value_log are streamed as mutations, since their value files aren't
+            // sstable components. So the option stays enabled while sstables may point into them.
+            if (auto value_log_ext = get_schema_extension<db::value_log_extension>(schema_extensions, db::value_log_extension::NAME)) {
+                if (s->value_log_options().enabled() && !value_log_ext->get_options().enabled()) {
+                    throw exceptions::invalid_request_exception("value_log cannot be disabled once enabled");
+                }
+            }
+
             if (auto cdc_ext = get_schema_extension<cdc::cdc_extension>(schema_extensions, cdc::cdc_extension::NAME)) {
                 const auto& cdc_opts = cdc_ext->get_options();
                 if (!cdc_opts.is_enabled_set()) {
@@ -22,6 +22,7 @@
 #include "tombstone_gc.hh"
 #include "db/per_partition_rate_limit_extension.hh"
 #include "db/per_partition_rate_limit_options.hh"
+#include "db/value_log_extension.hh"
 #include "db/tablet_options.hh"
 #include "utils/bloom_calculations.hh"
 #include "utils/overloaded_functor.hh"
@@ -61,6 +62,7 @@ const sstring cf_prop_defs::KW_TABLETS = "tablets";
 
 const sstring cf_prop_defs::KW_STORAGE_ENGINE = "storage_engine";
 const sstring cf_prop_defs::KW_LARGE_DATA_GUARDRAILS_ENABLED = "large_data_guardrails_enabled";
+const sstring cf_prop_defs::KW_FILTER_TYPE = "filter_type";
 
 schema::extensions_map cf_prop_defs::make_schema_extensions(const db::extensions& exts) const {
     schema::extensions_map er;
@@ -111,6 +113,7 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
         KW_SYNCHRONOUS_UPDATES, KW_TABLETS,
         KW_STORAGE_ENGINE,
         KW_LARGE_DATA_GUARDRAILS_ENABLED,
+        KW_FILTER_TYPE,
     });
     static std::set<sstring> obsolete_keywords({
         sstring("index_interval"),
@@ -151,6 +154,9 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
         }
         compression_parameters cp(*compression_options);
         cp.validate(compression_parameters::dicts_feature_enabled(bool(db.features().sstable_compression_dicts)));
+        if (cp.sub_chunk_length() && !db.features().sstable_compression_sub_chunks) {
+            throw exceptions::configuration_exception(format("{} cannot be used until all nodes in the cluster enable this feature", compression_parameters::SUB_CHUNK_LENGTH_KB));
+        }
     }
 
     auto per_partition_rate_limit_options = get_per_partition_rate_limit_options(schema_extensions);
@@ -158,6 +164,21 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
         throw exceptions::configuration_exception("Per-partition rate limit is not supported yet by the whole cluster");
     }
 
+    auto value_log_options = get_value_log_options(schema_extensions);
+    if (value_log_options && value_log_options->enabled()) {
+        if (!db.features().value_log) {
+            throw exceptions::configuration_exception("value_log cannot be used until all nodes in the cluster enable this feature");
+        }
+        // Value files are written next to the sstables, and only the storage of local
+        // sstables knows to link them.
+        if (!ks.metadata()->get_storage_options().is_local_type()) {
+            throw exceptions::configuration_exception("value_log can only be used with tables on local storage");
+        }
+        if (has_property(KW_STORAGE_ENGINE)) {
+            throw exceptions::configuration_exception(format("value_log cannot be used with the '{}' option", KW_STORAGE_ENGINE));
+        }
+    }
+
     auto tombstone_gc_options = get_tombstone_gc_options(schema_extensions);
     validate_tombstone_gc_options(tombstone_gc_options, db, ks_name);
 
@@ -218,6 +239,16 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
             throw exceptions::configuration_exception("large_data_guardrails_enabled cannot be used until all nodes in the cluster enable this feature");
         }
     }
+
+    if (has_property(KW_FILTER_TYPE)) {
+        auto filter_type = sstable_filter_type_from_sstring(get_string(KW_FILTER_TYPE, ""));
+        if (!filter_type) {
+            throw exceptions::configuration_exception(format("Illegal value for '{}': must be 'bloom' or 'binary_fuse'", KW_FILTER_TYPE));
+        }
+        if (*filter_type != sstable_filter_type::bloom && !db.features().binary_fuse_filter) {
+            throw exceptions::configuration_exception(format("{} cannot be used until all nodes in the cluster enable this feature", KW_FILTER_TYPE));
+        }
+    }
 }
 
 std::map<sstring, sstring> cf_prop_defs::get_compaction_type_options() const {
@@ -293,6 +324,11 @@ const db::per_partition_rate_limit_options* cf_prop_defs::get_per_partition_rate
     return ext ? &ext->get_options() : nullptr;
 }
 
+const db::value_log_options* cf_prop_defs::get_value_log_options(const schema::extensions_map& schema_exts) const {
+    auto ext = get_schema_extension<db::value_log_extension>(schema_exts, db::value_log_extension::NAME);
+    return ext ? &ext->get_options() : nullptr;
+}
+
 std::optional<db::tablet_options::map_type> cf_prop_defs::get_tablet_options() const {
     if (auto tablet_options = get_map(KW_TABLETS)) {
         return tablet_options.value();
@@ -413,6 +449,9 @@ void cf_prop_defs::apply_to_builder(schema_builder& builder, schema::extensions_
     if (has_property(KW_LARGE_DATA_GUARDRAILS_ENABLED)) {
         builder.set_large_data_guardrails_enabled(get_boolean(KW_LARGE_DATA_GUARDRAILS_ENABLED, false));
     }
+    if (has_property(KW_FILTER_TYPE)) {
+        builder.set_filter_type(sstable_filter_type_from_sstring(get_string(KW_FILTER_TYPE, "")).value());
+    }
 }
 
 void cf_prop_defs::validate_minimum_int(const sstring& field, int32_t minimum_value, int32_t default_value) const
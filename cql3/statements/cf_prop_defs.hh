@@ -26,6 +26,7 @@ class tombstone_gc_options;
 namespace db {
 class extensions;
 class tablet_options;
+class value_log_options;
 }
 namespace cdc {
 class options;
@@ -66,6 +67,7 @@ class cf_prop_defs : public property_definitions {
 
     static const sstring KW_STORAGE_ENGINE;
     static const sstring KW_LARGE_DATA_GUARDRAILS_ENABLED;
+    static const sstring KW_FILTER_TYPE;
 
     // FIXME: In origin the following consts are in CFMetaData.
     static constexpr int32_t DEFAULT_DEFAULT_TIME_TO_LIVE = 0;
@@ -89,6 +91,7 @@ class cf_prop_defs : public property_definitions {
     std::optional<caching_options> get_caching_options() const;
     const tombstone_gc_options* get_tombstone_gc_options(const schema::extensions_map&) const;
     const db::per_partition_rate_limit_options* get_per_partition_rate_limit_options(const schema::extensions_map&) const;
+    const db::value_log_options* get_value_log_options(const schema::extensions_map&) const;
 #if 0
     public CachingOptions getCachingOptions() throws SyntaxException, ConfigurationException
     {
@@ -8,6 +8,7 @@
 
 #include "cql3/statements/external_search/fulltext_indexed_table_select_statement.hh"
 #include "cql3/statements/external_search/external_score_provider.hh"
+#include "cql3/statements/external_search/local_index.hh"
 #include "cql3/statements/raw/select_statement.hh"
 #include "cql3/expr/evaluate.hh"
 #include "cql3/expr/expression.hh"
@@ -15,6 +16,7 @@
 #include "cql3/functions/scoring_fcts.hh"
 #include "cql3/query_processor.hh"
 #include "cql3/restrictions/statement_restrictions.hh"
+#include "index/external_index.hh"
 #include "index/secondary_index_manager.hh"
 #include "data_dictionary/data_dictionary.hh"
 #include "db/consistency_level_validations.hh"
@@ -276,18 +278,25 @@ future<shared_ptr<cql_transport::messages::result_message>> fulltext_indexed_tab
     auto search_term_bytes = std::move(search_term_val).to_bytes();
     sstring search_term_text = value_cast<sstring>(utf8_type->deserialize(search_term_bytes));
 
-    auto pkeys = co_await qp.vector_store_client().bm25(_schema->ks_name(), _index.metadata().name(), _schema, search_term_text, limit, aoe.abort_source());
-    if (!pkeys.has_value()) {
-        co_await coroutine::return_exception(
-                exceptions::invalid_request_exception(std::visit(vector_search::vector_store_client::fts_error_visitor{}, pkeys.error())));
+    std::vector<vector_search::primary_key> pkeys;
+    if (secondary_index::external_index::uses_local_engine(_index.metadata().options())) {
+        pkeys = co_await external_search::local_bm25(qp, _schema, _index, std::move(search_term_text), limit,
+                timeout, state.get_trace_state());
+    } else {
+        auto result = co_await qp.vector_store_client().bm25(_schema->ks_name(), _index.metadata().name(), _schema, search_term_text, limit, aoe.abort_source());
+        if (!result.has_value()) {
+            co_await coroutine::return_exception(
+                    exceptions::invalid_request_exception(std::visit(vector_search::vector_store_client::fts_error_visitor{}, result.error())));
+        }
+        pkeys = std::move(result.value());
     }
 
-    throwing_assert(pkeys->size() <= limit);
+    throwing_assert(pkeys.size() <= limit);
 
     auto provider = _bm25_ordering_info.temporary_index
-                            ? std::make_unique<external_score_provider>(pkeys.value(), *_bm25_ordering_info.temporary_index, *_schema)
+                            ? std::make_unique<external_score_provider>(pkeys, *_bm25_ordering_info.temporary_index, *_schema)
                             : nullptr;
-    co_return co_await query_base_table(qp, state, options, pkeys.value(), timeout, std::move(provider));
+    co_return co_await query_base_table(qp, state, options, pkeys, timeout, std::move(provider));
 }
 
 } // namespace cql3::statements
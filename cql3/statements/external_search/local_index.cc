@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "cql3/statements/external_search/local_index.hh"
+
+#include "cql3/query_processor.hh"
+#include "dht/i_partitioner.hh"
+#include "index/secondary_index_manager.hh"
+#include "replica/local_index.hh"
+#include "service/storage_proxy.hh"
+
+namespace cql3::statements::external_search {
+
+namespace {
+
+std::vector<vector_search::primary_key> to_primary_keys(const schema& s, replica::local_index_result result) {
+    return result.matches | std::views::transform([&] (replica::local_index_match& m) {
+        return vector_search::primary_key{
+            .partition = dht::decorate_key(s, std::move(m.partition)),
+            .clustering = std::move(m.clustering),
+            .similarity = m.score,
+        };
+    }) | std::ranges::to<std::vector>();
+}
+
+} // anonymous namespace
+
+future<std::vector<vector_search::primary_key>> local_ann(query_processor& qp, schema_ptr schema, const secondary_index::index& index,
+        std::vector<float> query, size_t k, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_state) {
+    auto result = co_await qp.proxy().query_local_index(schema, replica::local_index_request{
+        .index_name = index.metadata().name(),
+        .vector = std::move(query),
+        .limit = static_cast<uint32_t>(k),
+    }, timeout, std::move(trace_state));
+    co_return to_primary_keys(*schema, std::move(result));
+}
+
+future<std::vector<vector_search::primary_key>> local_bm25(query_processor& qp, schema_ptr schema, const secondary_index::index& index,
+        sstring query, size_t k, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_state) {
+    auto result = co_await qp.proxy().query_local_index(schema, replica::local_index_request{
+        .index_name = index.metadata().name(),
+        .text = std::move(query),
+        .limit = static_cast<uint32_t>(k),
+    }, timeout, std::move(trace_state));
+    co_return to_primary_keys(*schema, std::move(result));
+}
+
+} // namespace cql3::statements::external_search
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include "db/timeout_clock.hh"
+#include "schema/schema_fwd.hh"
+#include "tracing/trace_state.hh"
+#include "vector_search/vector_store_client.hh"
+
+#include <seastar/core/future.hh>
+
+#include <vector>
+
+namespace secondary_index {
+class index;
+}
+
+namespace cql3 {
+
+class query_processor;
+
+}
+
+namespace cql3::statements::external_search {
+
+/// Indexes with the 'engine': 'local' option are served by the replicas, from
+/// indexes of the sstables and memtables they store, instead of by the Vector
+/// Store, see replica/local_index.hh.
+
+/// Returns the primary keys of up to k rows with the vectors most similar to
+/// the query, in decreasing similarity order, from the HNSW indexes of a vector index.
+future<std::vector<vector_search::primary_key>> local_ann(query_processor& qp, schema_ptr schema, const secondary_index::index& index,
+        std::vector<float> query, size_t k, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_state);
+
+/// Returns the primary keys of up to k rows with the highest BM25 score for the
+/// query, in decreasing score order, from the inverted indexes of a fulltext index.
+/// Rows which match none of the terms of the query are not returned.
+future<std::vector<vector_search::primary_key>> local_bm25(query_processor& qp, schema_ptr schema, const secondary_index::index& index,
+        sstring query, size_t k, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_state);
+
+} // namespace cql3::statements::external_search
@@ -13,6 +13,7 @@
 #include "cql3/functions/functions.hh"
 #include "cql3/functions/scoring_fcts.hh"
 #include "cql3/statements/raw/select_statement.hh"
+#include "cql3/statements/external_search/local_index.hh"
 #include "cql3/query_processor.hh"
 #include "cql3/util.hh"
 
@@ -170,6 +171,11 @@ ::shared_ptr<cql3::statements::select_statement> vector_indexed_table_select_sta
         throw exceptions::invalid_request_exception("ANN() is not supported in the WHERE clause");
     }
 
+    // The local engine has no filtering, the vector store filters the candidates itself.
+    if (secondary_index::external_index::uses_local_engine(index.metadata().options()) && !restrictions->is_empty()) {
+        throw exceptions::invalid_request_exception("Filtering is not supported by vector indexes with the local engine");
+    }
+
     auto prepared_filter = external_search::prepare_filter(*restrictions, parameters->allow_filtering());
 
     return ::make_shared<cql3::statements::vector_indexed_table_select_statement>(schema, bound_terms, parameters, std::move(selection), std::move(restrictions),
@@ -213,18 +219,25 @@ future<shared_ptr<cql_transport::messages::result_message>> vector_indexed_table
     auto aoe = abort_on_expiry(timeout);
     auto filter_json = _prepared_filter.to_json(options);
     uint64_t fetch = static_cast<uint64_t>(std::ceil(limit * secondary_index::vector_index::get_oversampling(_index.metadata().options())));
-    auto pkeys = co_await qp.vector_store_client().ann(_schema->ks_name(), _index.metadata().name(), _schema,
-            get_ann_ordering_vector(_prepared_ann_ordering, options), fetch, filter_json, aoe.abort_source());
-    if (!pkeys.has_value()) {
-        co_await coroutine::return_exception(
-                exceptions::invalid_request_exception(std::visit(vector_search::vector_store_client::ann_error_visitor{}, pkeys.error())));
+    std::vector<vector_search::primary_key> pkeys;
+    if (secondary_index::external_index::uses_local_engine(_index.metadata().options())) {
+        pkeys = co_await external_search::local_ann(qp, _schema, _index, get_ann_ordering_vector(_prepared_ann_ordering, options), fetch,
+                timeout, state.get_trace_state());
+    } else {
+        auto result = co_await qp.vector_store_client().ann(_schema->ks_name(), _index.metadata().name(), _schema,
+                get_ann_ordering_vector(_prepared_ann_ordering, options), fetch, filter_json, aoe.abort_source());
+        if (!result.has_value()) {
+            co_await coroutine::return_exception(
+                    exceptions::invalid_request_exception(std::visit(vector_search::vector_store_client::ann_error_visitor{}, result.error())));
+        }
+        pkeys = std::move(result.value());
     }
 
-    if (pkeys->size() > limit && !secondary_index::vector_index::is_rescoring_enabled(_index.metadata().options())) {
-        pkeys->erase(pkeys->begin() + limit, pkeys->end());
+    if (pkeys.size() > limit && !secondary_index::vector_index::is_rescoring_enabled(_index.metadata().options())) {
+        pkeys.erase(pkeys.begin() + limit, pkeys.end());
     }
 
-    co_return co_await query_base_table(qp, state, options, pkeys.value(), timeout);
+    co_return co_await query_base_table(qp, state, options, pkeys, timeout);
 }
 
 } // namespace statements
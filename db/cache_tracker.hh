@@ -14,10 +14,12 @@
 #include "mutation/partition_version.hh"
 #include "mutation/mutation_cleaner.hh"
 #include "utils/cached_file_stats.hh"
+#include "utils/frequency_sketch.hh"
 #include "sstables/partition_index_cache_stats.hh"
 
 #include <seastar/core/metrics_registration.hh>
 
+#include <optional>
 #include <stdint.h>
 
 class cache_entry;
@@ -62,6 +64,7 @@ class cache_tracker final {
         uint64_t partitions;
         uint64_t rows;
         uint64_t mispopulations;
+        uint64_t partitions_not_admitted;
         uint64_t underlying_recreations;
         uint64_t underlying_partition_skips;
         uint64_t underlying_row_skips;
@@ -81,6 +84,7 @@ class cache_tracker final {
 private:
     stats _stats{};
     cached_file_stats _index_cached_file_stats{};
+    cached_file_stats _data_chunk_cache_stats{};
     partition_index_cache_stats _partition_index_cache_stats{};
     seastar::metrics::metric_groups _metrics;
     logalloc::region _region;
@@ -89,6 +93,9 @@ class cache_tracker final {
     mutation_cleaner _memtable_cleaner;
     mutation_application_stats& _app_stats;
     utils::updateable_value<double> _index_cache_fraction;
+    utils::updateable_value<bool> _admission_filter_enabled{false};
+    // Allocated when the admission filter is first used.
+    std::optional<utils::frequency_sketch> _admission_sketch;
 private:
     void setup_metrics();
 public:
@@ -102,8 +109,16 @@ class cache_tracker final {
     void insert(cache_entry&);
     void insert(partition_entry&) noexcept;
     void insert(partition_version&) noexcept;
+    // Inserts the rows of pv, a version just added right after more_recent, such that they're
+    // evicted right before the last dummy of more_recent in the absence of later touches.
+    void insert(partition_version& more_recent, partition_version& pv) noexcept;
+    // Inserts the rows of pv, a version just added as the latest version of its entry, such that
+    // they're evicted after the rows of the older versions in the absence of later touches.
+    void insert_latest(partition_version& pv) noexcept;
     void insert(mutation_partition_v2&) noexcept;
     void insert(rows_entry&) noexcept;
+    // Like insert(rows_entry&), for a row inserted into the version of the given snapshot.
+    void insert(const partition_snapshot&, rows_entry&) noexcept;
     void remove(rows_entry&) noexcept;
     // Inserts e such that it will be evicted right before more_recent in the absence of later touches.
     void insert(rows_entry& more_recent, rows_entry& e) noexcept;
@@ -138,8 +153,19 @@ class cache_tracker final {
     const stats& get_stats() const noexcept { return _stats; }
     stats& get_stats() noexcept { return _stats; }
     void set_compaction_scheduling_group(seastar::scheduling_group);
+    void set_admission_filter(utils::updateable_value<bool> enabled);
+    // Decides whether a partition which reads found missing in cache should be
+    // inserted into it. Called on each such miss, with a key identifying the partition.
+    //
+    // When the admission filter is enabled, only partitions which were missed
+    // recently already are admitted, so that one-off reads of cold partitions, like
+    // those of scans, don't evict the partitions which are read often. Otherwise,
+    // all partitions are admitted.
+    bool should_admit(uint64_t key) noexcept;
     lru& get_lru() { return _lru; }
     cached_file_stats& get_index_cached_file_stats() { return _index_cached_file_stats; }
+    // Stats of the decompressed_chunk_cache:s of sstables.
+    cached_file_stats& get_data_chunk_cache_stats() { return _data_chunk_cache_stats; }
     partition_index_cache_stats& get_partition_index_cache_stats() { return _partition_index_cache_stats; }
     seastar::memory::reclaiming_result evict_from_lru_shallow() noexcept;
 };
@@ -162,6 +188,19 @@ void cache_tracker::insert(rows_entry& entry) noexcept {
     _lru.add(entry);
 }
 
+inline
+void cache_tracker::insert(const partition_snapshot& snp, rows_entry& entry) noexcept {
+    ++_stats.row_insertions;
+    ++_stats.rows;
+    if (snp.at_oldest_version()) {
+        _lru.add(entry);
+    } else {
+        // Older versions must be evicted first (see docs/dev/mvcc.md), but their rows
+        // may be in the protected segment of the LRU.
+        _lru.add_last(entry);
+    }
+}
+
 inline
 void cache_tracker::insert(rows_entry& more_recent, rows_entry& entry) noexcept {
     ++_stats.row_insertions;
@@ -174,6 +213,29 @@ void cache_tracker::insert(partition_version& pv) noexcept {
     insert(pv.partition());
 }
 
+inline
+void cache_tracker::insert(partition_version& more_recent, partition_version& pv) noexcept {
+    auto& rows = more_recent.partition().clustered_rows();
+    if (rows.empty() || !rows.rbegin()->is_linked()) {
+        insert(pv);
+        return;
+    }
+    for (rows_entry& row : pv.partition().clustered_rows()) {
+        insert(*rows.rbegin(), row);
+    }
+}
+
+inline
+void cache_tracker::insert_latest(partition_version& pv) noexcept {
+    // Older versions must be evicted first (see docs/dev/mvcc.md), but their rows
+    // may be in the protected segment of the LRU.
+    for (rows_entry& row : pv.partition().clustered_rows()) {
+        ++_stats.row_insertions;
+        ++_stats.rows;
+        _lru.add_last(row);
+    }
+}
+
 inline
 void cache_tracker::insert(mutation_partition_v2& p) noexcept {
     for (rows_entry& row : p.clustered_rows()) {
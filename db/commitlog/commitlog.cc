@@ -108,6 +108,7 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
     c.extensions = &cfg.extensions();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
+    c.compress_entries = cfg.commitlog_compression();
     c.allow_going_over_size_limit = false;
 
     if (cfg.commitlog_flush_threshold_in_mb() >= 0) {
@@ -896,6 +897,9 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     auto descriptor_tag() const {
         return _segment_manager->cfg.descriptor_tag;
     }
+    bool compress_entries() const {
+        return _segment_manager->cfg.compress_entries;
+    }
 
     void release_cf_count(const cf_id_type& cf) {
         mark_clean(cf, 1);
@@ -3131,7 +3135,7 @@ future<db::rp_handle> db::commitlog::add_entry(const cf_id_type& id, const commi
             return _writer.schema()->id();
         }
         size_t size(segment& seg) override {
-            _writer.setup_for_segment(seg.descriptor_tag(), !seg.is_schema_version_known(_writer.schema()));
+            _writer.setup_for_segment(seg.descriptor_tag(), !seg.is_schema_version_known(_writer.schema()), seg.compress_entries());
             return _writer.size();
         }
         size_t size(segment& seg, size_t) override {
@@ -3186,7 +3190,7 @@ db::commitlog::add_entries(utils::chunked_vector<commitlog_mutation_entry_writer
                 if (!known) {
                     _known.emplace(i->schema()->version());
                 }
-                i->setup_for_segment(seg.descriptor_tag(), !known);
+                i->setup_for_segment(seg.descriptor_tag(), !known, seg.compress_entries());
                 res += i->size();
             }
             _sizes_computed = &seg;
@@ -3195,7 +3199,7 @@ db::commitlog::add_entries(utils::chunked_vector<commitlog_mutation_entry_writer
         size_t size(segment& seg, size_t i) override {
             auto& w = _writers.at(i);
             if (_sizes_computed != &seg) {
-                w.setup_for_segment(seg.descriptor_tag(), !seg.is_schema_version_known(w.schema()));
+                w.setup_for_segment(seg.descriptor_tag(), !seg.is_schema_version_known(w.schema()), seg.compress_entries());
             }
             return w.size();
         }
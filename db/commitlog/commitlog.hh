@@ -114,6 +114,9 @@ class commitlog {
         std::string descriptor_tag;
 
         bool use_o_dsync = false;
+        // Compress mutation entries with lz4. Segments with compressed entries
+        // can't be replayed by versions which don't support them.
+        bool compress_entries = false;
         bool warn_about_segments_left_on_disk_after_shutdown = true;
         bool allow_going_over_size_limit = false;
         bool allow_fragmented_entries = false;
@@ -15,6 +15,7 @@
 #include "idl/raft_storage.dist.hh"
 #include "idl/raft_storage.dist.impl.hh"
 #include <seastar/core/simple-stream.hh>
+#include <lz4.h>
 
 template<typename Output>
 void commitlog_mutation_entry_writer::serialize(Output& out) const {
@@ -32,13 +33,41 @@ void commitlog_mutation_entry_writer::serialize(Output& out) const {
 }
 
 void commitlog_mutation_entry_writer::write(ostream& out) const {
+    if (_compressed) {
+        out.write(reinterpret_cast<const char*>(_compressed->data()), _compressed->size());
+        return;
+    }
     serialize(out);
 }
 
 void commitlog_mutation_entry_writer::compute_size() {
+    _compressed.reset();
     seastar::measuring_output_stream ms;
     serialize(ms);
     _size = ms.size();
+    if (_compress && _size >= detail::min_compressed_entry_size && _size <= detail::max_compressed_entry_size) {
+        compress();
+    }
+}
+
+void commitlog_mutation_entry_writer::compress() {
+    bytes_ostream serialized;
+    serialize(serialized);
+    auto in = serialized.linearize();
+    const int bound = LZ4_compressBound(in.size());
+    bytes out(bytes::initialized_later(), detail::compressed_entry_header_size + bound);
+    auto len = LZ4_compress_default(reinterpret_cast<const char*>(in.data()),
+            reinterpret_cast<char*>(out.data()) + detail::compressed_entry_header_size, in.size(), bound);
+    if (len <= 0 || detail::compressed_entry_header_size + len >= _size) {
+        // Incompressible, keep the entry as it is.
+        return;
+    }
+    auto header = seastar::simple_memory_output_stream(reinterpret_cast<char*>(out.data()), detail::compressed_entry_header_size);
+    ser::serialize(header, detail::compressed_entry_magic);
+    ser::serialize(header, uint32_t(in.size()));
+    out.resize(detail::compressed_entry_header_size + len);
+    _size = out.size();
+    _compressed = std::move(out);
 }
 
 
@@ -52,6 +81,31 @@ void commitlog_raft_log_entry_writer::write(ostream& out) const {
 }
 
 namespace {
+// Decompresses the entry in the buffer, if it's compressed.
+std::optional<fragmented_temporary_buffer> maybe_decompress(const fragmented_temporary_buffer& buffer) {
+    if (buffer.size_bytes() < detail::compressed_entry_header_size) {
+        return std::nullopt;
+    }
+    auto in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(buffer).begin(), buffer.size_bytes());
+    if (ser::deserialize(in, std::type_identity<uint32_t>()) != detail::compressed_entry_magic) {
+        return std::nullopt;
+    }
+    auto size = ser::deserialize(in, std::type_identity<uint32_t>());
+    if (size > detail::max_compressed_entry_size) {
+        throw std::runtime_error(fmt::format("Compressed commitlog entry too large: {}", size));
+    }
+    temporary_buffer<char> compressed(buffer.size_bytes() - detail::compressed_entry_header_size);
+    in.read(compressed.get_write(), compressed.size());
+    temporary_buffer<char> out(size);
+    auto ret = LZ4_decompress_safe(compressed.get(), out.get_write(), compressed.size(), out.size());
+    if (ret < 0 || size_t(ret) != size) {
+        throw std::runtime_error(fmt::format("Corrupted compressed commitlog entry: decompressed {} bytes, expected {}", ret, size));
+    }
+    std::vector<temporary_buffer<char>> frags;
+    frags.push_back(std::move(out));
+    return fragmented_temporary_buffer(std::move(frags), size);
+}
+
 auto read_variant_commitlog_entry(const fragmented_temporary_buffer& buffer) {
     // XXX this is copying of the data, but since this is not critical path, only used during replay from commitlog,
     // we can tolerate this for now. Should be fixed when we fix IDL generator to support deserialization directly from
@@ -93,13 +147,19 @@ auto read_mutation_commitlog_entry(const fragmented_temporary_buffer& buffer) {
 } // namespace
 
 commitlog_entry_reader::commitlog_entry_reader(const fragmented_temporary_buffer& buffer, detail::commitlog_entry_serialization_format format)
-    : _entry(format == detail::commitlog_entry_serialization_format::variant ? read_variant_commitlog_entry(buffer) : read_mutation_commitlog_entry(buffer)) {
+    : _entry([&] {
+        auto decompressed = maybe_decompress(buffer);
+        const auto& buf = decompressed ? *decompressed : buffer;
+        return format == detail::commitlog_entry_serialization_format::variant ? read_variant_commitlog_entry(buf) : read_mutation_commitlog_entry(buf);
+    }()) {
 }
 
 
 commitlog_mutation_entry_reader::commitlog_mutation_entry_reader(const fragmented_temporary_buffer& buffer)
     : _me([&] {
-        auto in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(buffer).begin(), buffer.size_bytes());
+        auto decompressed = maybe_decompress(buffer);
+        const auto& buf = decompressed ? *decompressed : buffer;
+        auto in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(buf).begin(), buf.size_bytes());
         return ser::deserialize(in, std::type_identity<mutation_entry>());
     }()) {
 }
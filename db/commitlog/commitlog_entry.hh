@@ -76,6 +76,19 @@ namespace detail {
     static constexpr std::string_view variant_format_tag = "variant";
 
     enum commitlog_entry_serialization_format : uint8_t { mutation, variant };
+
+    // Compressed entries are laid out as:
+    //
+    //   <uint32_t:compressed_entry_magic><uint32_t:uncompressed size><lz4 block>
+    //
+    // Uncompressed entries start with the size of their IDL frame, which
+    // can't be the magic, so both kinds can be mixed in a segment.
+    static constexpr uint32_t compressed_entry_magic = 0xffffffff;
+    static constexpr size_t compressed_entry_header_size = 2 * sizeof(uint32_t);
+    // Smaller entries don't compress well enough to be worth it.
+    static constexpr size_t min_compressed_entry_size = 256;
+    // Larger entries would need large contiguous buffers to be (de)compressed.
+    static constexpr size_t max_compressed_entry_size = 128 * 1024;
 } // namespace detail
 
 
@@ -118,24 +131,29 @@ class commitlog_mutation_entry_writer {
     schema_ptr _schema;
     const frozen_mutation& _mutation;
     bool _with_schema = true;
+    bool _compress = false;
     size_t _size = std::numeric_limits<size_t>::max();
     force_sync _sync;
     detail::commitlog_entry_serialization_format _entry_format = detail::commitlog_entry_serialization_format::mutation;
+    // The entry, if it's compressed.
+    std::optional<bytes> _compressed;
 private:
     template<typename Output>
     void serialize(Output&) const;
     void compute_size();
+    void compress();
 public:
     commitlog_mutation_entry_writer(schema_ptr s, const frozen_mutation& fm, force_sync sync)
         : _schema(std::move(s)), _mutation(fm), _sync(sync)
     {}
 
-    void setup_for_segment(std::string_view segment_tag, bool encode_schema) {
+    void setup_for_segment(std::string_view segment_tag, bool encode_schema, bool compress = false) {
         const auto new_format = segment_tag == detail::variant_format_tag
             ? detail::commitlog_entry_serialization_format::variant
             : detail::commitlog_entry_serialization_format::mutation;
         bool size_changed = std::exchange(_entry_format, new_format) != new_format;
         size_changed = std::exchange(_with_schema, encode_schema) != encode_schema || size_changed;
+        size_changed = std::exchange(_compress, compress) != compress || size_changed;
         if (size_changed || _size == std::numeric_limits<size_t>::max()) {
             compute_size();
         }
@@ -11,12 +11,17 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <map>
 #include <unordered_map>
 #include <ranges>
 #include "utils/chunked_vector.hh"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 
 #include "commitlog.hh"
 #include "commitlog_replayer.hh"
@@ -84,8 +89,21 @@ class db::commitlog_replayer::impl {
         return _column_mappings.stop();
     }
 
-    future<> process(stats*, detail::commitlog_entry_serialization_format, commitlog::buffer_and_replay_position buf_rp) const;
-    future<stats> recover(const commitlog::descriptor&, const commitlog::replay_state&) const;
+    // The memory, per replaying shard, of the mutations which were read but not applied yet.
+    static constexpr size_t max_pending_memory = 16 * 1024 * 1024;
+    // The segments replayed by a shard are read concurrently, up to this many at a time.
+    static constexpr size_t max_concurrent_segments = 2;
+
+    class shard_batches;
+
+    // The raft entries read from the segments replayed by a shard, with their positions.
+    // Unlike mutations, they have to be added to the replay buffer in the order of the log.
+    using raft_entries = std::vector<std::pair<replay_position, raft_commitlog_entry>>;
+
+    future<> process(stats*, shard_batches&, raft_entries&, detail::commitlog_entry_serialization_format, commitlog::buffer_and_replay_position buf_rp) const;
+    future<stats> recover(const commitlog::descriptor&, const commitlog::replay_state&, semaphore& memory, raft_entries&) const;
+    void add_raft_entries(raft_entries) const;
+    future<> apply(replica::database&, const frozen_mutation&, const column_mapping&, replay_position) const;
     detail::commitlog_entry_serialization_format get_entry_format(const commitlog::descriptor&) const;
 
     typedef std::unordered_map<table_id, replay_position> rp_map;
@@ -129,6 +147,103 @@ db::commitlog_replayer::impl::impl(
     , _raft_buffer(raft_buffer)
 {}
 
+// Groups the mutations replayed from a segment by the shard they are applied on,
+// so that each shard gets them in batches, with a single cross-shard call per batch,
+// instead of one call per mutation. The batches are applied in the background while
+// the segment is read further, with the memory of the pending mutations bounded by
+// a semaphore shared by all the segments replayed by the shard.
+class db::commitlog_replayer::impl::shard_batches {
+    static constexpr size_t max_batch_size = 1024 * 1024;
+    static constexpr size_t max_batch_mutations = 256;
+
+    struct entry {
+        frozen_mutation fm;
+        // Owned by _column_mappings of the replaying shard, which outlives the batch.
+        const column_mapping* cm;
+        replay_position rp;
+    };
+    struct batch {
+        std::vector<entry> entries;
+        size_t size = 0;
+        semaphore_units<> units;
+    };
+
+    const impl& _impl;
+    stats& _stats;
+    semaphore& _memory;
+    std::vector<batch> _batches;
+    seastar::gate _in_flight;
+public:
+    shard_batches(const impl& i, stats& s, semaphore& memory)
+        : _impl(i)
+        , _stats(s)
+        , _memory(memory)
+        , _batches(this_smp_shard_count())
+    {}
+
+    future<> add(seastar::shard_id shard, frozen_mutation fm, const column_mapping& cm, replay_position rp) {
+        auto size = fm.representation().size();
+        auto n = std::min(size, max_pending_memory);
+        auto units = try_get_units(_memory, n);
+        if (!units) {
+            // Our own pending batches may be holding the memory we're waiting for.
+            send_all();
+            units = co_await get_units(_memory, n);
+        }
+        auto& b = _batches[shard];
+        b.entries.push_back(entry{std::move(fm), &cm, rp});
+        b.size += size;
+        b.units.adopt(std::move(*units));
+        if (b.entries.size() >= max_batch_mutations || b.size >= max_batch_size) {
+            send(shard);
+        }
+    }
+
+    // Applies the pending batches and waits for all of them to be applied.
+    future<> close() {
+        send_all();
+        co_await _in_flight.close();
+    }
+private:
+    void send_all() {
+        for (seastar::shard_id shard = 0; shard < _batches.size(); ++shard) {
+            if (!_batches[shard].entries.empty()) {
+                send(shard);
+            }
+        }
+    }
+
+    void send(seastar::shard_id shard) {
+        (void)seastar::with_gate(_in_flight, [this, shard, b = std::exchange(_batches[shard], batch{})] () mutable {
+            return apply(shard, std::move(b));
+        });
+    }
+
+    future<> apply(seastar::shard_id shard, batch b) {
+        try {
+            auto s = co_await _impl._db.invoke_on(shard, [this, &b] (replica::database& db) -> future<stats> {
+                stats s;
+                for (const auto& e : b.entries) {
+                    try {
+                        co_await _impl.apply(db, e.fm, *e.cm, e.rp);
+                        s.applied_mutations++;
+                    } catch (...) {
+                        s.invalid_mutations++;
+                        // TODO: write mutation to file like origin.
+                        rlogger.warn("error replaying: {}", std::current_exception());
+                    }
+                    co_await coroutine::maybe_yield();
+                }
+                co_return s;
+            });
+            _stats += s;
+        } catch (...) {
+            _stats.invalid_mutations += b.entries.size();
+            rlogger.warn("error replaying: {}", std::current_exception());
+        }
+    }
+};
+
 future<> db::commitlog_replayer::impl::init() {
     co_await _db.local().get_tables_metadata().parallel_for_each_table([this] (table_id uuid, lw_shared_ptr<replica::table>) -> future<> {
         const auto rps = co_await _sys_ks.local().get_truncated_positions(uuid);
@@ -174,7 +289,7 @@ future<> db::commitlog_replayer::impl::init() {
 }
 
 future<db::commitlog_replayer::impl::stats>
-db::commitlog_replayer::impl::recover(const commitlog::descriptor& d, const commitlog::replay_state& rpstate) const {
+db::commitlog_replayer::impl::recover(const commitlog::descriptor& d, const commitlog::replay_state& rpstate, semaphore& memory, raft_entries& raft) const {
     SCYLLA_ASSERT(_column_mappings.local_is_initialized());
 
     replay_position rp{d};
@@ -183,33 +298,38 @@ db::commitlog_replayer::impl::recover(const commitlog::descriptor& d, const comm
 
     if (rp.id < gp.id) {
         rlogger.debug("skipping replay of fully-flushed {}", f);
-        return make_ready_future<stats>();
+        co_return stats();
     }
     position_type p = 0;
     if (rp.id == gp.id) {
         p = gp.pos;
     }
 
-    auto s = make_lw_shared<stats>();
+    stats s;
+    shard_batches batches(*this, s, memory);
     auto& exts = _db.local().extensions();
     auto entry_format = get_entry_format(d);
 
-    return db::commitlog::read_log_file(rpstate, f, d.filename_prefix,
-            std::bind(&impl::process, this, s.get(), entry_format, std::placeholders::_1),
-            p, &exts).then_wrapped([s](future<> f) {
-        try {
-            f.get();
-        } catch (commitlog::segment_data_corruption_error& e) {
-            s->corrupt_bytes += e.bytes();
-        } catch (commitlog::segment_truncation& e) {
-            s->truncated_at = e.position();
-        } catch (commitlog::header_checksum_error&) {
-            ++s->broken_files;
-        } catch (...) {
-            throw;
-        }
-        return make_ready_future<stats>(*s);
-    });
+    std::exception_ptr ex;
+    try {
+        co_await db::commitlog::read_log_file(rpstate, f, d.filename_prefix, [&] (commitlog::buffer_and_replay_position buf_rp) {
+            return process(&s, batches, raft, entry_format, std::move(buf_rp));
+        }, p, &exts);
+    } catch (commitlog::segment_data_corruption_error& e) {
+        s.corrupt_bytes += e.bytes();
+    } catch (commitlog::segment_truncation& e) {
+        s.truncated_at = e.position();
+    } catch (commitlog::header_checksum_error&) {
+        ++s.broken_files;
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    // The mutations read before an error are still applied.
+    co_await batches.close();
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+    co_return s;
 }
 
 detail::commitlog_entry_serialization_format db::commitlog_replayer::impl::get_entry_format(const commitlog::descriptor& d) const {
@@ -220,8 +340,20 @@ detail::commitlog_entry_serialization_format db::commitlog_replayer::impl::get_e
     return detail::commitlog_entry_serialization_format::mutation;
 }
 
+void db::commitlog_replayer::impl::add_raft_entries(raft_entries entries) const {
+    if (entries.empty()) {
+        return;
+    }
+    SCYLLA_ASSERT(_raft_buffer);
+    std::ranges::sort(entries, std::less(), [] (const auto& e) { return e.first; });
+    for (auto& [rp, e] : entries) {
+        rlogger.debug("Adding raft log entry for group {} at {} to replay buffer", e.group_id, rp);
+        _raft_buffer->local().add(e.group_id, std::move(e.entry));
+    }
+}
+
 future<> db::commitlog_replayer::impl::process(
-        stats* s, detail::commitlog_entry_serialization_format entry_format, commitlog::buffer_and_replay_position buf_rp) const {
+        stats* s, shard_batches& batches, raft_entries& raft, detail::commitlog_entry_serialization_format entry_format, commitlog::buffer_and_replay_position buf_rp) const {
     auto&& buf = buf_rp.buffer;
     auto&& rp = buf_rp.position;
     try {
@@ -232,8 +364,7 @@ future<> db::commitlog_replayer::impl::process(
         if (std::holds_alternative<raft_commitlog_entry>(read_entry)) {
             const auto& raft_entry = std::get<raft_commitlog_entry>(read_entry);
             SCYLLA_ASSERT(_raft_buffer);
-            rlogger.debug("Adding raft log entry for group {} at {} to replay buffer", raft_entry.group_id, rp);
-            _raft_buffer->local().add(raft_entry.group_id, raft_entry.entry);
+            raft.emplace_back(rp, raft_entry);
             co_return;
         } else if (std::holds_alternative<mutation_entry>(read_entry)) {
             const auto& mut_entry = std::get<mutation_entry>(read_entry);
@@ -279,56 +410,14 @@ future<> db::commitlog_replayer::impl::process(
                 co_return;
             }
 
-            auto apply = [&] (seastar::shard_id shard) {
-                return _db.invoke_on(shard, [this, &fm, &src_cm, rp] (replica::database& db) mutable -> future<> {
-                    // TODO: might need better verification that the deserialized mutation
-                    // is schema compatible. My guess is that just applying the mutation
-                    // will not do this.
-                    auto& cf = db.find_column_family(fm.column_family_id());
-
-                    if (rlogger.is_enabled(logging::log_level::debug)) {
-                        rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
-                                cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
-                    }
-                    if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
-                        throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
-                                fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
-                    }
-                    // Removed forwarding "new" RP. Instead give none/empty.
-                    // This is what origin does, and it should be fine.
-                    // The end result should be that once sstables are flushed out
-                    // their "replay_position" attribute will be empty, which is
-                    // lower than anything the new session will produce.
-                    if (cf.schema()->version() != fm.schema_version()) {
-                        auto& local_cm = _column_mappings.local().map;
-                        auto cm_it = local_cm.try_emplace(fm.schema_version(), src_cm).first;
-                        const column_mapping& cm = cm_it->second;
-                        mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
-                        converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
-                        fm.partition().accept(cm, v);
-                        return do_with(std::move(m), [&db, &cf] (const mutation& m) {
-                            return db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
-                        });
-                    } else {
-                        return db.apply_in_memory(fm, cf.schema(), db::rp_handle(), db::no_timeout, db::noop_large_data_guardrail::instance());
-                    }
-                }).then_wrapped([s] (future<> f) {
-                    try {
-                        f.get();
-                        s->applied_mutations++;
-                    } catch (...) {
-                        s->invalid_mutations++;
-                        // TODO: write mutation to file like origin.
-                        rlogger.warn("error replaying: {}", std::current_exception());
-                    }
-                });
-            };
             auto shards = table.get_effective_replication_map()->shard_for_writes(schema, token);
             if (shards.empty()) {
                 rlogger.debug("no shard for token {} in table {}", token, uuid);
                 s->skipped_mutations++;
             } else {
-                co_await seastar::parallel_for_each(shards, apply);
+                for (auto shard : shards) {
+                    co_await batches.add(shard, fm, src_cm, rp);
+                }
             }
         } else {
             on_fatal_internal_error(rlogger, fmt::format("Unknown variant type in commitlog entry at replay position {}", rp));
@@ -342,6 +431,41 @@ future<> db::commitlog_replayer::impl::process(
     }
 }
 
+future<> db::commitlog_replayer::impl::apply(replica::database& db, const frozen_mutation& fm, const column_mapping& src_cm, replay_position rp) const {
+    // TODO: might need better verification that the deserialized mutation
+    // is schema compatible. My guess is that just applying the mutation
+    // will not do this.
+    auto& cf = db.find_column_family(fm.column_family_id());
+
+    if (rlogger.is_enabled(logging::log_level::debug)) {
+        rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
+                cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
+    }
+    if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
+        throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
+                fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
+    }
+    // Removed forwarding "new" RP. Instead give none/empty.
+    // This is what origin does, and it should be fine.
+    // The end result should be that once sstables are flushed out
+    // their "replay_position" attribute will be empty, which is
+    // lower than anything the new session will produce.
+    //
+    // apply_in_memory() waits for dirty memory, so the memtables are flushed
+    // as replay fills them.
+    if (cf.schema()->version() != fm.schema_version()) {
+        auto& local_cm = _column_mappings.local().map;
+        auto cm_it = local_cm.try_emplace(fm.schema_version(), src_cm).first;
+        const column_mapping& cm = cm_it->second;
+        mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
+        converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
+        fm.partition().accept(cm, v);
+        co_await db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
+    } else {
+        co_await db.apply_in_memory(fm, cf.schema(), db::rp_handle(), db::no_timeout, db::noop_large_data_guardrail::instance());
+    }
+}
+
 db::commitlog_replayer::commitlog_replayer(
         seastar::sharded<replica::database>& db, seastar::sharded<db::system_keyspace>& sys_ks, seastar::sharded<raft_commitlog_replay_buffer>* raft_buffer)
     : _impl(std::make_unique<impl>(db, sys_ks, raft_buffer))
@@ -393,18 +517,26 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
         auto totals = co_await map_reduce(this_smp_all_shards(), [&](unsigned id) -> future<impl::stats> {
             co_return co_await smp::submit_to(id, [&] () -> future<impl::stats> {
                 impl::stats total;
-                std::unordered_map<unsigned, commitlog::replay_state> states;
-                // TODO: or something. For now, we do this serialized per shard,
-                // to reduce mutation congestion. We could probably (says avi)
-                // do 2 segments in parallel or something, but lets use this first.
                 auto it = map.find(id);
                 if (it == map.end()) {
                     co_return total;
                 }
+                // A fragmented entry may continue in the next segments of the same shard, so
+                // the segments of a shard share a replay state, which puts the fragments of
+                // an entry back together in whatever order they are read. Mutations can be
+                // applied in any order, so the segments are replayed concurrently, started
+                // in segment ID order. Only raft entries need the order of the log; they are
+                // added to the replay buffer in replay position order once all are read.
+                std::map<unsigned, commitlog::replay_state> states;
                 for (auto& d : it->second) {
+                    states[replay_position(d).shard_id()];
+                }
+                semaphore memory(impl::max_pending_memory);
+                impl::raft_entries raft;
+                co_await max_concurrent_for_each(it->second, impl::max_concurrent_segments, [&] (const commitlog::descriptor& d) -> future<> {
                     auto f = d.filename();
                     rlogger.debug("Replaying {}", f);
-                    auto stats = co_await _impl->recover(d, states[replay_position(d).shard_id()]);
+                    auto stats = co_await _impl->recover(d, states.at(replay_position(d).shard_id()), memory, raft);
                     if (stats.corrupt_bytes != 0) {
                         rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
                     }
@@ -421,7 +553,8 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
                                     , stats.skipped_mutations
                     );
                     total += stats;
-                }
+                });
+                _impl->add_raft_entries(std::move(raft));
                 co_return total;
             });
         }, impl::stats(), std::plus<impl::stats>());
@@ -30,6 +30,7 @@
 #include "cdc/cdc_extension.hh"
 #include "tombstone_gc_extension.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/value_log_extension.hh"
 #include "db/paxos_grace_seconds_extension.hh"
 #include "db/tags/extension.hh"
 #include "db/object_storage_endpoint_param.hh"
@@ -951,6 +952,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Whether or not to use a hard size limit for commitlog disk usage. Default is true. Enabling this can cause latency spikes, whereas disabling this can lead to occasional disk usage peaks.\n")
     , commitlog_use_fragmented_entries(this, "commitlog_use_fragmented_entries", value_status::Used, true,
         "Whether or not to allow commitlog entries to fragment across segments, allowing for larger entry sizes.\n")
+    , commitlog_compression(this, "commitlog_compression", value_status::Used, false,
+        "Whether or not to compress commitlog entries with LZ4, reducing the commitlog disk bandwidth. Only entries of 256 bytes to 128 kB are compressed. Segments written with compression can't be replayed after a downgrade to a version without it.\n")
     /**
     * @Group Compaction settings
     * @GroupDescription Related information: Configuring compaction
@@ -987,6 +990,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Maximum delay in milliseconds for logstor separator debt control.")
     , logstor_separator_max_memory_in_mb(this, "logstor_separator_max_memory_in_mb", value_status::Used, 256,
         "Maximum memory in megabytes for logstor separator memory buffers.")
+    , logstor_compaction_cold_data_age_in_s(this, "logstor_compaction_cold_data_age_in_s", value_status::Used, 3600,
+        "Age in seconds after which logstor records are considered cold. Logstor compaction rewrites cold records into separate segments from recently written ones, to reduce write amplification. The age of a record is bounded by the age of the segment it is stored in, not by its write timestamp. Set to 0 to disable the separation.")
+    , logstor_record_compression(this, "logstor_record_compression", liveness::LiveUpdate, value_status::Used, false,
+        "Compress the records of logstor tables which use the ZstdCompressor or ZstdWithDictsCompressor compression. Takes effect once all nodes of the cluster support it, and after that the nodes can't be downgraded to versions that don't.")
     , file_cache_size_in_mb(this, "file_cache_size_in_mb", value_status::Unused, 512,
         "Total memory to use for SSTable-reading buffers.")
     , memtable_flush_queue_size(this, "memtable_flush_queue_size", value_status::Unused, 4,
@@ -1489,6 +1496,14 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , enable_sstables_md_format(this, "enable_sstables_md_format", value_status::Unused, true, "Enable SSTables 'md' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , sstable_format(this, "sstable_format", liveness::LiveUpdate, value_status::Used, "me", "Default sstable file format", {"md", "me", "ms", "mt"})
+    , sstable_blocked_bloom_filter(this, "sstable_blocked_bloom_filter", liveness::LiveUpdate, value_status::Used, false,
+        "Write sstable bloom filters in the split-block format, which is faster to probe, since all the bits of a key are in a single cache line, "
+        "but needs somewhat more memory for the same false-positive rate. Takes effect once all nodes in the cluster support it.")
+    , sstable_set_combined_filter(this, "sstable_set_combined_filter", liveness::LiveUpdate, value_status::Used, false,
+        "Combine the split-block bloom filters (see sstable_blocked_bloom_filter) of the sstables of each compaction group into a single "
+        "filter, which single-partition reads probe to skip most of the sstables which don't contain the partition without probing their "
+        "own filters. Costs up to as much memory as the filters themselves. Only applies to sstables spanning most of the token range "
+        "of the compaction group, e.g. with size-tiered or incremental compaction.")
     , sstable_compression_user_table_options(this, "sstable_compression_user_table_options", value_status::Used, compression_parameters{compression_parameters::algorithm::lz4_with_dicts},
         "Server-global user table compression options. If enabled, all user tables"
         "will be compressed using the provided options, unless overridden"
@@ -1497,6 +1512,14 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "* chunk_length_in_kb: (Default: 4) The size of chunks to compress in kilobytes. Allowed values are powers of two between 1 and 128.\n"
         "* crc_check_chance: (Default: 1.0) Not implemented (option value is ignored).\n"
         "* compression_level: (Default: 3) Compression level for ZstdCompressor and ZstdWithDictsCompressor. Higher levels provide better compression ratios at the cost of speed. Allowed values are integers between 1 and 22.")
+    , sstable_compression_adaptive_chunk_length(this, "sstable_compression_adaptive_chunk_length", liveness::LiveUpdate, value_status::Used, false,
+        "Choose the compression chunk length of each written sstable from the size of its partitions, between 4 and 64 kilobytes, "
+        "instead of using chunk_length_in_kb. Tables with small partitions get small chunks, which make single-partition reads cheaper, "
+        "and tables with large partitions get large chunks, which compress better. Doesn't apply to tables which set chunk_length_in_kb.")
+    , sstable_repair_summaries(this, "sstable_repair_summaries", liveness::LiveUpdate, value_status::Used, false,
+        "Store in each written sstable hashes of its contents over fixed token sub-ranges. Repair compares them between the replicas "
+        "before reading a range, and only reads the sub-ranges whose hashes differ, which saves reading data which didn't change since the last repair. "
+        "Only ranges aligned to the sub-ranges (like tablets), with no data in memtables, and with at most one sstable per sub-range benefit.")
     , sstable_compression_dictionaries_allow_in_ddl(this, "sstable_compression_dictionaries_allow_in_ddl", liveness::LiveUpdate, value_status::Deprecated, true,
         "Allows for configuring tables to use SSTable compression with shared dictionaries. "
         "If the option is disabled, Scylla will reject CREATE and ALTER statements which try to set dictionary-based sstable compressors.\n"
@@ -1693,6 +1716,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Keep SSTable index pages in the global cache after a SSTable read. Expected to improve performance for workloads with big partitions, but may degrade performance for workloads with small partitions. The amount of memory usable by index cache is limited with ``index_cache_fraction``.")
     , index_cache_fraction(this, "index_cache_fraction", liveness::LiveUpdate, value_status::Used, 0.2,
         "The maximum fraction of cache memory permitted for use by index cache. Clamped to the [0.0; 1.0] range. Must be small enough to not deprive the row cache of memory, but should be big enough to fit a large fraction of the index. The default value 0.2 means that at least 80\% of cache memory is reserved for the row cache, while at most 20\% is usable by the index cache.")
+    , cache_protected_fraction(this, "cache_protected_fraction", value_status::Used, 0.0,
+        "The maximum fraction of the entries of the cache (rows and index entries) which are protected from eviction by entries which were used only once. Entries used again are protected, and entries used only once, like those read by scans, are evicted first. Clamped to the [0.0; 1.0] range. The default value 0.0 disables protection, so that entries are evicted in least recently used order.")
+    , cache_decompressed_chunks(this, "cache_decompressed_chunks", liveness::LiveUpdate, value_status::Used, false,
+        "Keep the decompressed chunks of compressed SSTables read by single-partition reads in the global cache, so that reading partitions which were evicted from the row cache again doesn't have to read and decompress their chunks. Expected to improve the latency of reads of tables larger than the row cache, at the cost of cache memory usable by the row cache.")
+    , cache_admission_filter(this, "cache_admission_filter", liveness::LiveUpdate, value_status::Used, false,
+        "Insert partitions read from SSTables into the row cache only when they were read recently already, as estimated by a frequency sketch of the partitions missing in cache. Prevents scans and other reads of cold partitions from evicting the partitions which are read often, at the cost of a second read from SSTables for each partition which becomes hot.")
     , consistent_cluster_management(this, "consistent_cluster_management", value_status::Deprecated, true, "Use RAFT for cluster management and DDL.")
     , force_gossip_topology_changes(this, "force_gossip_topology_changes", value_status::Deprecated, false, "Force gossip-based topology operations in a fresh cluster. Only the first node in the cluster must use it. The rest will fall back to gossip-based operations anyway. This option should be used only for testing.  Note: gossip topology changes are incompatible with tablets.")
     , recovery_leader(this, "recovery_leader", liveness::LiveUpdate, value_status::Used, utils::null_uuid(), "Host ID of the node restarted first while performing the Manual Raft-based Recovery Procedure. Warning: this option disables some guardrails for the needs of the Manual Raft-based Recovery Procedure. Make sure you unset it at the end of the procedure.")
@@ -1812,6 +1841,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "true: auto-adjust memtable shares for flush processes")
     , memtable_flush_static_shares(this, "memtable_flush_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the memtable shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity.")
+    , memtable_flush_concurrency(this, "memtable_flush_concurrency", liveness::LiveUpdate, value_status::Used, 1,
+        "The maximum number of sstables a single memtable is flushed into in parallel. Large memtables are split into token ranges, which are written concurrently, shortening the flush and the write throttling during it. Each range covers at least 32MB of the memtable. 1 disables the split.")
     , compaction_static_shares(this, "compaction_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the compaction shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity.")
     , compaction_max_shares(this, "compaction_max_shares", liveness::LiveUpdate, value_status::Used, default_compaction_maximum_shares,
@@ -1865,12 +1896,17 @@ void db::config::add_paxos_grace_seconds_extension() {
     _extensions->add_schema_extension<db::paxos_grace_seconds_extension>(db::paxos_grace_seconds_extension::NAME);
 }
 
+void db::config::add_value_log_extension() {
+    _extensions->add_schema_extension<db::value_log_extension>(db::value_log_extension::NAME);
+}
+
 void db::config::add_all_default_extensions() {
     add_cdc_extension();
     add_per_partition_rate_limit_extension();
     add_tags_extension();
     add_tombstone_gc_extension();
     add_paxos_grace_seconds_extension();
+    add_value_log_extension();
 }
 
 void db::config::setup_directories() {
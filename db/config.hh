@@ -172,6 +172,7 @@ class config final : public utils::config_file {
     void add_tags_extension();
     void add_tombstone_gc_extension();
     void add_paxos_grace_seconds_extension();
+    void add_value_log_extension();
 
     void add_all_default_extensions();
 
@@ -267,6 +268,7 @@ class config final : public utils::config_file {
     named_value<bool> commitlog_use_o_dsync;
     named_value<bool> commitlog_use_hard_size_limit;
     named_value<bool> commitlog_use_fragmented_entries;
+    named_value<bool> commitlog_compression;
     named_value<bool> compaction_preheat_key_cache;
     named_value<uint32_t> concurrent_compactors;
     named_value<uint32_t> in_memory_compaction_limit_in_mb;
@@ -280,6 +282,8 @@ class config final : public utils::config_file {
     named_value<bool> logstor_format_on_startup;
     named_value<uint32_t> logstor_separator_delay_limit_ms;
     named_value<uint32_t> logstor_separator_max_memory_in_mb;
+    named_value<uint32_t> logstor_compaction_cold_data_age_in_s;
+    named_value<bool> logstor_record_compression;
     named_value<uint32_t> file_cache_size_in_mb;
     named_value<uint32_t> memtable_flush_queue_size;
     named_value<uint32_t> memtable_flush_writers;
@@ -459,10 +463,14 @@ class config final : public utils::config_file {
     named_value<bool> enable_sstables_mc_format;
     named_value<bool> enable_sstables_md_format;
     named_value<sstring> sstable_format;
+    named_value<bool> sstable_blocked_bloom_filter;
+    named_value<bool> sstable_set_combined_filter;
 
     // NOTE: Do not use this option directly.
     // Use get_sstable_compression_user_table_options() instead.
     named_value<compression_parameters> sstable_compression_user_table_options;
+    named_value<bool> sstable_compression_adaptive_chunk_length;
+    named_value<bool> sstable_repair_summaries;
 
     compression_parameters get_sstable_compression_user_table_options(bool dicts_feature_enabled) const;
 
@@ -561,6 +569,9 @@ class config final : public utils::config_file {
 
     named_value<bool> cache_index_pages;
     named_value<double> index_cache_fraction;
+    named_value<double> cache_protected_fraction;
+    named_value<bool> cache_decompressed_chunks;
+    named_value<bool> cache_admission_filter;
 
     named_value<bool> consistent_cluster_management;
     named_value<bool> force_gossip_topology_changes;
@@ -670,6 +681,7 @@ class config final : public utils::config_file {
     named_value<double> background_writer_scheduling_quota;
     named_value<bool> auto_adjust_flush_quota;
     named_value<float> memtable_flush_static_shares;
+    named_value<uint32_t> memtable_flush_concurrency;
     named_value<float> compaction_static_shares;
     named_value<float> compaction_max_shares;
     named_value<bool> compaction_enforce_min_threshold;
@@ -658,7 +658,7 @@ class partition_snapshot_row_cursor final {
                     re.set_range_tombstone(l->range_tombstone());
                 }
                 if (res.second) {
-                    _snp.tracker()->insert(re);
+                    _snp.tracker()->insert(_snp, re);
                 }
                 return {*res.first, res.first, res.second};
             } else {
@@ -672,7 +672,7 @@ class partition_snapshot_row_cursor final {
                     e->set_range_tombstone(range_tombstone_for_row());
                 }
                 auto i = rows.insert_before(latest_i, std::move(e));
-                _snp.tracker()->insert(re);
+                _snp.tracker()->insert(_snp, re);
                 return {re, i, true};
             }
         }
@@ -735,7 +735,7 @@ class partition_snapshot_row_cursor final {
             e->set_range_tombstone(range_tombstone());
         }
         auto e_i = rows.insert_before(latest_i, std::move(e));
-        _snp.tracker()->insert(*e_i);
+        _snp.tracker()->insert(_snp, *e_i);
         return ensure_result{*e_i, e_i, true};
     }
 
@@ -142,9 +142,45 @@ void cache_tracker::set_compaction_scheduling_group(seastar::scheduling_group sg
     _garbage.set_scheduling_group(sg);
 }
 
+void cache_tracker::set_admission_filter(utils::updateable_value<bool> enabled) {
+    _admission_filter_enabled = std::move(enabled);
+}
+
+// A partition is admitted on its second miss within the window of the sketch.
+//
+// TinyLFU proper admits a candidate when it's more frequent than the entry it would
+// evict, but the LRU is shared by rows of all tables and by the index caches, so
+// there's no single victim to compare with. Requiring a repeated miss keeps out
+// the partitions which are read once, which is what flushes the hot ones.
+static constexpr unsigned cache_admission_threshold = 2;
+
+bool cache_tracker::should_admit(uint64_t key) noexcept {
+    if (!_admission_filter_enabled()) {
+        return true;
+    }
+    if (!_admission_sketch) {
+        // About one counter per KiB of memory, so that the sketch can tell apart
+        // many more partitions than fit in cache, while taking 0.05% of memory.
+        auto nr_counters = std::clamp<size_t>(memory::stats().total_memory() / 1024, 64 * 1024, 16 * 1024 * 1024);
+        try {
+            _admission_sketch.emplace(nr_counters);
+        } catch (...) {
+            clogger.debug("Failed to allocate the cache admission filter: {}", std::current_exception());
+            return true;
+        }
+    }
+    _admission_sketch->increment(key);
+    if (_admission_sketch->frequency(key) >= cache_admission_threshold) {
+        return true;
+    }
+    ++_stats.partitions_not_admitted;
+    return false;
+}
+
 namespace sstables {
 void register_index_page_cache_metrics(seastar::metrics::metric_groups&, cached_file_stats&);
 void register_index_page_metrics(seastar::metrics::metric_groups&, partition_index_cache_stats&);
+void register_data_chunk_cache_metrics(seastar::metrics::metric_groups&, cached_file_stats&);
 };
 
 void
@@ -170,6 +206,7 @@ cache_tracker::setup_metrics() {
         sm::make_counter("partition_evictions", sm::description("total number of evicted partitions"), _stats.partition_evictions)(basic_level),
         sm::make_counter("partition_removals", sm::description("total number of invalidated partitions"), _stats.partition_removals)(basic_level),
         sm::make_counter("mispopulations", sm::description("number of entries not inserted by reads"), _stats.mispopulations),
+        sm::make_counter("partitions_not_admitted", sm::description("number of partitions read from the underlying source but not inserted by reads, because the admission filter found them cold"), _stats.partitions_not_admitted),
         sm::make_gauge("partitions", sm::description("total number of cached partitions"), _stats.partitions),
         sm::make_gauge("rows", sm::description("total number of cached rows"), _stats.rows),
         sm::make_counter("reads", sm::description("number of started reads"), _stats.reads)(basic_level),
@@ -196,6 +233,7 @@ cache_tracker::setup_metrics() {
     });
     sstables::register_index_page_cache_metrics(_metrics, _index_cached_file_stats);
     sstables::register_index_page_metrics(_metrics, _partition_index_cache_stats);
+    sstables::register_data_chunk_cache_metrics(_metrics, _data_chunk_cache_stats);
 }
 
 void cache_tracker::clear() {
@@ -222,7 +260,7 @@ void cache_tracker::touch(rows_entry& e) {
     if (e.is_linked()) {
         _lru.remove(e);
     }
-    _lru.add(e);
+    _lru.add_last(e);
 }
 
 void cache_tracker::insert(cache_entry& entry) {
@@ -438,13 +476,17 @@ class single_partition_populating_reader final : public mutation_reader::impl {
           return _read_context->underlying().underlying()().then([this, phase] (auto&& mfopt) {
             if (!mfopt) {
                 if (phase == _cache.phase_of(_read_context->range().start()->value())) {
-                    _cache._read_section(_cache._tracker.region(), [this] {
-                        _cache.find_or_create_missing(_read_context->key());
-                    });
+                    if (_cache.should_admit(_read_context->key())) {
+                        _cache._read_section(_cache._tracker.region(), [this] {
+                            _cache.find_or_create_missing(_read_context->key());
+                        });
+                    }
                 } else {
                     _cache._tracker.on_mispopulate();
                 }
                 _end_of_stream = true;
+            } else if (!_cache.should_admit(_read_context->key())) {
+                _reader = read_directly_from_underlying(*_read_context, std::move(*mfopt));
             } else if (phase == _cache.phase_of(_read_context->range().start()->value())) {
                 _reader = _cache._read_section(_cache._tracker.region(), [&] {
                     cache_entry& e = _cache.find_or_create_incomplete(mfopt->as_partition_start(), phase);
@@ -525,6 +567,11 @@ void row_cache::on_mispopulate() {
     _tracker.on_mispopulate();
 }
 
+bool row_cache::should_admit(const dht::decorated_key& dk) {
+    // Mix in the table, so that the same token in different tables is counted separately.
+    return _tracker.should_admit(uint64_t(dk.token().raw()) ^ _schema->id().uuid().get_least_significant_bits());
+}
+
 void row_cache::on_row_miss() {
     _stats.misses.mark();
     _tracker.on_row_miss();
@@ -589,6 +636,12 @@ class range_populating_reader {
                 _cache.on_partition_miss();
                 const partition_start& ps = mfopt->as_partition_start();
                 const dht::decorated_key& key = ps.key();
+                if (!_cache.should_admit(key)) {
+                    // Like on mispopulation, the next partition won't be marked continuous,
+                    // as this one isn't in cache.
+                    _last_key = row_cache::previous_entry_pointer(key);
+                    return make_ready_future<mutation_reader_opt>(read_directly_from_underlying(_read_context, std::move(*mfopt)));
+                }
                 if (_reader.creation_phase() == _cache.phase_of(key)) {
                     return _cache._read_section(_cache._tracker.region(), [&] {
                         cache_entry& e = _cache.find_or_create_incomplete(ps, _reader.creation_phase(),
@@ -267,6 +267,8 @@ class row_cache final {
     void on_row_miss();
     void on_static_row_insert();
     void on_mispopulate();
+    // Whether a partition missing in cache, read from the underlying source, should be inserted.
+    bool should_admit(const dht::decorated_key&);
     void upgrade_entry(cache_entry&);
     void invalidate_locked(const dht::decorated_key&);
     void clear_now() noexcept;
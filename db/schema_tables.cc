@@ -323,6 +323,7 @@ schema_ptr scylla_tables(schema_features features) {
 
         sb.with_column("storage_engine", utf8_type);
         sb.with_column("large_data_guardrails_enabled", boolean_type);
+        sb.with_column("filter_type", utf8_type);
 
         sb.with_hash_version();
         s = sb.build();
@@ -1693,6 +1694,11 @@ mutation make_scylla_tables_mutation(schema_ptr table, api::timestamp_type times
     if (table->logstor_enabled()) {
         m.set_clustered_cell(ckey, "storage_engine", "logstor", timestamp);
     }
+    // Written only when not the default, which can only be set once the
+    // cluster feature is enabled, like large_data_guardrails_enabled below.
+    if (table->filter_type() != sstable_filter_type::bloom) {
+        m.set_clustered_cell(ckey, "filter_type", sstable_filter_type_to_sstring(table->filter_type()), timestamp);
+    }
     // Write the large_data_guardrails_enabled column only when enabled.
     // When disabled (the default), omit the cell entirely so that old nodes
     // that don't know this column can still read the SSTable during rolling
@@ -2219,6 +2225,13 @@ static void prepare_builder_from_scylla_tables_row(const schema_ctxt& ctxt, sche
             throw std::invalid_argument(format("Invalid value for storage_engine: {}", *storage_engine));
         }
     }
+    if (auto filter_type = table_row.get<sstring>("filter_type")) {
+        auto type = sstable_filter_type_from_sstring(*filter_type);
+        if (!type) {
+            throw std::invalid_argument(format("Invalid value for filter_type: {}", *filter_type));
+        }
+        builder.set_filter_type(*type);
+    }
     auto guardrails_enabled = table_row.get<bool>("large_data_guardrails_enabled");
     builder.set_large_data_guardrails_enabled(guardrails_enabled.value_or(false));
 }
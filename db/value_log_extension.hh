@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include "db/value_log_options.hh"
+#include "schema/schema.hh"
+#include "serializer.hh"
+
+namespace db {
+
+class value_log_extension : public schema_extension {
+    value_log_options _options;
+public:
+    static constexpr auto NAME = "value_log";
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    value_log_extension() = default;
+    value_log_extension(const value_log_options& opts) : _options(opts) {}
+
+    explicit value_log_extension(const std::map<sstring, sstring>& map) : _options(map) {}
+    explicit value_log_extension(const bytes& b) : _options(deserialize(b)) {}
+    explicit value_log_extension(const sstring& s) {
+        throw std::logic_error("Cannot create value log info from string");
+    }
+#pragma clang diagnostic pop
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(_options.to_map());
+    }
+    static std::map<sstring, sstring> deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, std::type_identity<std::map<sstring, sstring>>());
+    }
+    const value_log_options& get_options() const {
+        return _options;
+    }
+};
+
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <ranges>
+
+#include <fmt/ranges.h>
+
+#include "db/value_log_options.hh"
+#include "exceptions/exceptions.hh"
+
+namespace db {
+
+const char* value_log_options::enabled_key = "enabled";
+const char* value_log_options::min_value_size_in_kb_key = "min_value_size_in_kb";
+const char* value_log_options::gc_garbage_ratio_key = "gc_garbage_ratio";
+
+value_log_options::value_log_options(std::map<sstring, sstring> map) {
+    if (auto it = map.find(enabled_key); it != map.end()) {
+        if (it->second == "true") {
+            _enabled = true;
+        } else if (it->second != "false") {
+            throw exceptions::configuration_exception(format("Invalid value for {} option: expected true or false", enabled_key));
+        }
+        map.erase(it);
+    }
+
+    if (auto it = map.find(min_value_size_in_kb_key); it != map.end()) {
+        try {
+            size_t pos = 0;
+            auto v = std::stol(it->second, &pos);
+            if (pos != it->second.size()) {
+                throw std::invalid_argument(it->second);
+            }
+            if (v <= 0 || v > std::numeric_limits<int32_t>::max()) {
+                throw std::out_of_range(it->second);
+            }
+            _min_value_size_in_kb = v;
+        } catch (std::invalid_argument&) {
+            throw exceptions::configuration_exception(format("Invalid value for {} option: expected a positive number", min_value_size_in_kb_key));
+        } catch (std::out_of_range&) {
+            throw exceptions::configuration_exception(format("Value for {} must be a positive 32-bit number", min_value_size_in_kb_key));
+        }
+        map.erase(it);
+    }
+
+    if (auto it = map.find(gc_garbage_ratio_key); it != map.end()) {
+        try {
+            size_t pos = 0;
+            _gc_garbage_ratio = std::stod(it->second, &pos);
+            if (pos != it->second.size()) {
+                throw std::invalid_argument(it->second);
+            }
+        } catch (std::exception&) {
+            throw exceptions::configuration_exception(format("Invalid value for {} option: expected a number", gc_garbage_ratio_key));
+        }
+        if (!(_gc_garbage_ratio > 0 && _gc_garbage_ratio <= 1)) {
+            throw exceptions::configuration_exception(format("Value for {} must be in the range (0, 1]", gc_garbage_ratio_key));
+        }
+        map.erase(it);
+    }
+
+    if (!map.empty()) {
+        throw exceptions::configuration_exception(seastar::format(
+                "Unknown keys in map for value_log extension: {}",
+                fmt::join(map | std::views::keys, ", ")));
+    }
+}
+
+std::map<sstring, sstring> value_log_options::to_map() const {
+    return {
+        {enabled_key, _enabled ? "true" : "false"},
+        {min_value_size_in_kb_key, fmt::format("{}", _min_value_size_in_kb)},
+        {gc_garbage_ratio_key, fmt::format("{}", _gc_garbage_ratio)},
+    };
+}
+
+}
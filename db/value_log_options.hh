@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <map>
+
+#include <seastar/core/sstring.hh>
+
+using namespace seastar;
+
+namespace db {
+
+// Options of the value log of a table, see sstables/value_log.hh.
+class value_log_options final {
+private:
+    static const char* enabled_key;
+    static const char* min_value_size_in_kb_key;
+    static const char* gc_garbage_ratio_key;
+
+public:
+    static constexpr uint32_t default_min_value_size_in_kb = 16;
+    static constexpr double default_gc_garbage_ratio = 0.5;
+
+private:
+    bool _enabled = false;
+    uint32_t _min_value_size_in_kb = default_min_value_size_in_kb;
+    double _gc_garbage_ratio = default_gc_garbage_ratio;
+
+public:
+    value_log_options() = default;
+    value_log_options(std::map<sstring, sstring> map);
+
+    std::map<sstring, sstring> to_map() const;
+
+    bool enabled() const {
+        return _enabled;
+    }
+
+    // Values of at least this many bytes are written to value files.
+    uint64_t min_value_size() const {
+        return uint64_t(_min_value_size_in_kb) * 1024;
+    }
+
+    // A value file is rewritten when at least this part of it is no longer referenced.
+    double gc_garbage_ratio() const {
+        return _gc_garbage_ratio;
+    }
+};
+
+}
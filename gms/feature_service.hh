@@ -174,6 +174,7 @@ class feature_service final : public peering_sharded_service<feature_service> {
     gms::feature driver_service_level { *this, "DRIVER_SERVICE_LEVEL"sv };
     gms::feature strongly_consistent_tables { *this, "STRONGLY_CONSISTENT_TABLES"sv };
     gms::feature logstor { *this, "LOGSTOR"sv };
+    gms::feature logstor_record_compression { *this, "LOGSTOR_RECORD_COMPRESSION"sv };
     gms::feature client_routes { *this, "CLIENT_ROUTES"sv };
     gms::feature removenode_with_left_token_ring { *this, "REMOVENODE_WITH_LEFT_TOKEN_RING"sv };
     gms::feature size_based_load_balancing { *this, "SIZE_BASED_LOAD_BALANCING"sv };
@@ -190,12 +191,24 @@ class feature_service final : public peering_sharded_service<feature_service> {
     gms::feature quiesce_topology_enhanced { *this, "QUIESCE_TOPOLOGY_ENHANCED"sv };
     gms::feature tablet_pow2_convergence { *this, "TABLET_POW2_CONVERGENCE"sv };
     gms::feature fetch_column_mappings_on_tablet_migration { *this, "FETCH_COLUMN_MAPPINGS_ON_TABLET_MIGRATION"sv };
+    gms::feature blocked_bloom_filter { *this, "BLOCKED_BLOOM_FILTER"sv };
+    gms::feature binary_fuse_filter { *this, "BINARY_FUSE_FILTER"sv };
+    gms::feature sstable_compression_sub_chunks { *this, "SSTABLE_COMPRESSION_SUB_CHUNKS"sv };
     // Gates the repair_get_table_size RPC verb used to auto-detect small user
     // tables for the RBNO small table optimization. The coordinator only probes
     // table sizes when the whole cluster supports this feature, avoiding doomed
     // RPCs (and their warnings) to nodes that do not register the verb during a
     // rolling upgrade.
     gms::feature small_table_optimization_size_probe { *this, "SMALL_TABLE_OPTIMIZATION_SIZE_PROBE"sv };
+    // Gates the repair_get_range_summary RPC verb, with which the repair master
+    // compares the sstables' repair summaries of a range on all the replicas.
+    gms::feature repair_range_summaries { *this, "REPAIR_RANGE_SUMMARIES"sv };
+    // Gates the read_data_multi RPC verb, with which a coordinator reads several
+    // partitions from a replica with a single request.
+    gms::feature multi_partition_reads { *this, "MULTI_PARTITION_READS"sv };
+    // Gates the value_log table option, with which the sstables of a table keep
+    // large values in separate value files, which older versions can't read.
+    gms::feature value_log { *this, "VALUE_LOG"sv };
 public:
 
     const std::unordered_map<sstring, std::reference_wrapper<feature>>& registered_features() const;
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "message/messaging_service.hh"
+#include "alternator/forward.hh"
+#include "idl/uuid.idl.hh"
+#include "idl/tracing.idl.hh"
+#include "idl/client_state.idl.hh"
+
+namespace alternator {
+
+struct forward_write_request {
+    sstring operation;
+    bytes_ostream request;
+    service::forwarded_client_state client_state;
+    std::optional<tracing::trace_info> trace_info;
+};
+
+enum class forward_write_status : uint8_t {
+    success = 0,
+    error = 1,
+    redirect = 2,
+};
+
+struct forward_write_response {
+    alternator::forward_write_status status;
+    sstring response_body;
+    sstring error_type;
+    sstring error_message;
+    int32_t error_http_code;
+    sstring error_extra_fields;
+    locator::host_id target_host;
+    unsigned target_shard;
+};
+
+// Execute a write to a strongly consistent table on the Raft leader of the item's tablet
+verb [[with_client_info, with_timeout]] alternator_forward_write (unsigned shard, alternator::forward_write_request req [[ref]]) -> alternator::forward_write_response;
+
+}
@@ -120,3 +120,4 @@ verb [[with_client_info]] repair_get_diff_algorithms () -> std::vector<row_level
 verb [[with_client_info]] repair_update_compaction_ctrl (locator::global_tablet_id gid, service::frozen_topology_guard topo_guard);
 verb [[with_client_info]] repair_update_repaired_at_for_merge(table_id);
 verb [[with_client_info]] repair_get_table_size(table_id table) -> uint64_t;
+verb [[with_client_info]] repair_get_range_summary(table_id table, dht::token_range range) -> std::vector<std::optional<uint64_t>>;
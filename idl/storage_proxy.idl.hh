@@ -25,6 +25,32 @@
 #include "idl/storage_service.idl.hh"
 #include "idl/full_position.idl.hh"
 
+#include "replica/local_index.hh"
+
+namespace replica {
+
+struct local_index_request {
+    table_schema_version schema_version;
+    sstring index_name;
+    std::vector<float> vector;
+    sstring text;
+    uint32_t limit;
+    dht::partition_range_vector ranges;
+    std::optional<tracing::trace_info> trace_info;
+};
+
+struct local_index_match {
+    partition_key partition;
+    clustering_key_prefix clustering;
+    float score;
+};
+
+struct local_index_result {
+    std::vector<replica::local_index_match> matches;
+};
+
+}
+
 verb [[with_client_info, with_timeout, one_way]] mutation (frozen_mutation fm [[ref]], inet_address_vector_replica_set forward [[ref]], gms::inet_address reply_to, unsigned shard, uint64_t response_id, std::optional<tracing::trace_info> trace_info [[ref]] [[version 1.3.0]], db::per_partition_rate_limit::info rate_limit_info [[version 5.1.0]], service::fencing_token fence [[version 5.4.0]], host_id_vector_replica_set forward_id [[ref, version 6.3.0]], locator::host_id reply_to_id [[version 6.3.0]], bool skip_large_data_guardrails [[version 2026.3]]);
 verb [[with_client_info, one_way]] mutation_done (unsigned shard, uint64_t response_id, db::view::update_backlog backlog [[version 3.1.0]], uint8_t large_data_violations [[version 2026.3]]);
 verb [[with_client_info, one_way]] mutation_failed (unsigned shard, uint64_t response_id, size_t num_failed, db::view::update_backlog backlog [[version 3.1.0]], replica::exception_variant exception [[version 5.1.0]]);
@@ -33,6 +59,8 @@ verb [[with_client_info, with_timeout, one_way]] hint_mutation (frozen_mutation
 verb [[with_client_info, with_timeout]] read_data (query::read_command cmd [[ref]], ::compat::wrapping_partition_range pr, query::digest_algorithm digest [[version 3.0.0]], db::per_partition_rate_limit::info rate_limit_info [[version 5.1.0]], service::fencing_token fence [[version 5.4.0]]) -> query::result [[lw_shared_ptr]], cache_temperature [[version 2.0.0]], replica::exception_variant [[version 5.1.0]];
 verb [[with_client_info, with_timeout]] read_mutation_data (query::read_command cmd [[ref]], ::compat::wrapping_partition_range pr, service::fencing_token fence [[version 5.4.0]]) -> reconcilable_result [[lw_shared_ptr]], cache_temperature [[version 2.0.0]], replica::exception_variant [[version 5.1.0]];
 verb [[with_client_info, with_timeout]] read_digest (query::read_command cmd [[ref]], ::compat::wrapping_partition_range pr, query::digest_algorithm digest [[version 3.0.0]], db::per_partition_rate_limit::info rate_limit_info [[version 5.1.0]], service::fencing_token fence [[version 5.4.0]]) -> query::result_digest, api::timestamp_type [[version 1.2.0]], cache_temperature [[version 2.0.0]], replica::exception_variant [[version 5.1.0]], std::optional<full_position> [[version 5.2.0]];
+verb [[with_client_info, with_timeout]] read_data_multi (std::vector<query::read_command> cmds [[ref]], dht::partition_range_vector prs [[ref]], query::digest_algorithm digest, bool only_digest, service::fencing_token fence) -> std::vector<query::result>, replica::exception_variant;
+verb [[with_client_info, with_timeout]] local_index_search (replica::local_index_request req [[ref]]) -> replica::local_index_result;
 verb [[with_timeout]] truncate (sstring, sstring);
 verb [[]] truncate_with_tablets (sstring ks_name, sstring cf_name, service::frozen_topology_guard frozen_guard);
 verb [[]] snapshot_with_tablets (utils::chunked_vector<table_id> table_ids, sstring tag, gc_clock::time_point created_at, bool, std::optional<gc_clock::time_point> expiry, service::frozen_topology_guard frozen_guard);
@@ -13,6 +13,8 @@
 #include "index/vector_index.hh"
 #include "utils/UUID_gen.hh"
 
+#include <boost/algorithm/string/predicate.hpp>
+
 namespace secondary_index {
 
 namespace {
@@ -32,6 +34,11 @@ bool external_index::view_should_exist() const {
     return false;
 }
 
+bool external_index::uses_local_engine(const index_options_map& options) {
+    auto it = options.find(ENGINE_OPTION);
+    return it != options.end() && boost::iequals(it->second, "local");
+}
+
 /// Returns a timeuuid representing the time at which the index was created.
 /// This is used to determine if the index needs to be rebuilt, and to enable
 /// routing by creation time when multiple vector indexes exist on the same column.
@@ -35,6 +35,13 @@ class external_index : public custom_index {
         return has_index_impl<external_index>(s);
     }
 
+    // The 'engine' option selects what serves the queries of the index: the
+    // Vector Store, or indexes of the sstables and memtables of the replicas,
+    // see replica/local_index.hh.
+    static constexpr auto ENGINE_OPTION = "engine";
+    static inline const std::vector<sstring> engine_values = {"vector_store", "local"};
+    static bool uses_local_engine(const index_options_map& options);
+
 protected:
     void check_uses_tablets(const schema& schema, const data_dictionary::database& db) const;
 
@@ -30,6 +30,9 @@ const static std::unordered_map<sstring, std::function<void(std::string_view, co
         // 'positions' controls whether token positions are stored in the index.
         // Required for phrase queries. Set to false to save space.
         {"positions", std::bind_front(util::validate_enumerated_option, util::boolean_values)},
+        // 'engine' selects whether queries are served by the vector store, or by inverted indexes
+        // of the sstables of the replicas, see replica/local_index.hh.
+        {external_index::ENGINE_OPTION, std::bind_front(util::validate_enumerated_option, external_index::engine_values)},
 };
 
 std::optional<cql3::description> fulltext_index::describe(const index_metadata& im, const schema& base_schema) const {
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "index/inverted_index.hh"
+#include "vint-serialization.hh"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <fmt/format.h>
+
+namespace secondary_index::fulltext {
+
+namespace {
+
+bool is_ascii_alpha(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool is_ascii_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool is_ascii_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+char ascii_lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+}
+
+class writer {
+    std::vector<int8_t> _buf;
+public:
+    void write_byte(int8_t b) {
+        _buf.push_back(b);
+    }
+    void write_vint(uint64_t v) {
+        std::array<int8_t, max_vint_length> tmp;
+        auto len = unsigned_vint::serialize(v, tmp.data());
+        _buf.insert(_buf.end(), tmp.begin(), tmp.begin() + len);
+    }
+    // Packs each value into `width` bits, least significant bits first.
+    void write_packed(std::span<const uint32_t> values, unsigned width) {
+        uint64_t acc = 0;
+        unsigned bits = 0;
+        for (auto v : values) {
+            acc |= uint64_t(v) << bits;
+            bits += width;
+            while (bits >= 8) {
+                _buf.push_back(int8_t(acc & 0xff));
+                acc >>= 8;
+                bits -= 8;
+            }
+        }
+        if (bits) {
+            _buf.push_back(int8_t(acc & 0xff));
+        }
+    }
+    bytes release() && {
+        return bytes(_buf.data(), _buf.size());
+    }
+};
+
+class reader {
+    bytes_view _in;
+
+    void ensure(size_t n) const {
+        if (_in.size() < n) {
+            throw std::runtime_error(fmt::format("Truncated fulltext index data: need {} bytes, {} left", n, _in.size()));
+        }
+    }
+public:
+    explicit reader(bytes_view in) : _in(in) {}
+
+    int8_t read_byte() {
+        ensure(1);
+        auto b = _in.front();
+        _in.remove_prefix(1);
+        return b;
+    }
+    uint64_t read_vint() {
+        ensure(1);
+        auto len = unsigned_vint::serialized_size_from_first_byte(_in.front());
+        ensure(len);
+        auto v = unsigned_vint::deserialize(_in.substr(0, len));
+        _in.remove_prefix(len);
+        return v;
+    }
+    bytes_view read(size_t n) {
+        ensure(n);
+        auto ret = _in.substr(0, n);
+        _in.remove_prefix(n);
+        return ret;
+    }
+    void read_packed(std::span<uint32_t> values, unsigned width) {
+        auto in = read((values.size() * width + 7) / 8);
+        const uint64_t mask = width == 32 ? 0xffffffff : (uint64_t(1) << width) - 1;
+        uint64_t acc = 0;
+        unsigned bits = 0;
+        size_t pos = 0;
+        for (auto& v : values) {
+            while (bits < width) {
+                acc |= uint64_t(uint8_t(in[pos++])) << bits;
+                bits += 8;
+            }
+            v = uint32_t(acc & mask);
+            acc >>= width;
+            bits -= width;
+        }
+    }
+};
+
+unsigned bit_width_of_max(std::span<const uint32_t> values) {
+    return std::bit_width(std::ranges::max(values));
+}
+
+// The score of a term of the query, which occurs tf times in a document of the given length.
+float bm25_term_score(const corpus_stats& stats, float avgdl, uint64_t df, float tf, float doc_length, const bm25_parameters& params) {
+    const float n = stats.doc_count;
+    // The same (always positive) idf variant as Lucene and Tantivy.
+    const float idf = std::log(1 + (n - df + 0.5f) / (df + 0.5f));
+    const float norm = params.k1 * (1 - params.b + (avgdl > 0 ? params.b * doc_length / avgdl : 0));
+    return idf * (tf * (params.k1 + 1)) / (tf + norm);
+}
+
+uint64_t doc_frequency(const corpus_stats& stats, std::string_view term) {
+    auto it = stats.doc_frequencies.find(term);
+    return it != stats.doc_frequencies.end() ? it->second : 0;
+}
+
+} // anonymous namespace
+
+analyzer analyzer_from_option(std::string_view name) {
+    auto equals = [&] (std::string_view s) {
+        return std::ranges::equal(name, s, [] (char a, char b) { return ascii_lower(a) == b; });
+    };
+    if (equals("simple")) {
+        return analyzer::simple;
+    }
+    if (equals("whitespace")) {
+        return analyzer::whitespace;
+    }
+    return analyzer::standard;
+}
+
+std::vector<std::string> tokenize(std::string_view text, analyzer a) {
+    auto is_word_char = [a] (char c) {
+        switch (a) {
+        case analyzer::standard:
+            return is_ascii_alpha(c) || is_ascii_digit(c) || uint8_t(c) >= 0x80;
+        case analyzer::simple:
+            return is_ascii_alpha(c);
+        case analyzer::whitespace:
+            return !is_ascii_space(c);
+        }
+        return false;
+    };
+    const bool lowercase = a != analyzer::whitespace;
+
+    std::vector<std::string> tokens;
+    std::string current;
+    for (char c : text) {
+        if (is_word_char(c)) {
+            current.push_back(lowercase ? ascii_lower(c) : c);
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        tokens.push_back(std::move(current));
+    }
+    return tokens;
+}
+
+float corpus_stats::average_doc_length() const noexcept {
+    return doc_count ? float(total_length) / doc_count : 0.0f;
+}
+
+std::vector<std::string> query_terms(std::string_view query, analyzer a) {
+    auto terms = tokenize(query, a);
+    std::ranges::sort(terms);
+    auto duplicates = std::ranges::unique(terms);
+    terms.erase(duplicates.begin(), duplicates.end());
+    return terms;
+}
+
+float bm25_score(std::span<const std::string> query_terms, std::span<const std::string> doc_tokens, const corpus_stats& stats,
+        bm25_parameters params) {
+    const float avgdl = stats.average_doc_length();
+    float score = 0;
+    for (const auto& term : query_terms) {
+        auto tf = std::ranges::count(doc_tokens, term);
+        if (tf) {
+            score += bm25_term_score(stats, avgdl, doc_frequency(stats, term), tf, doc_tokens.size(), params);
+        }
+    }
+    return score;
+}
+
+bytes encode_postings(std::span<const posting> postings) {
+    writer w;
+    w.write_vint(postings.size());
+    doc_id previous = 0;
+    std::array<uint32_t, postings_block_size> deltas;
+    std::array<uint32_t, postings_block_size> frequencies;
+    for (size_t start = 0; start < postings.size(); start += postings_block_size) {
+        auto block = postings.subspan(start, std::min(postings_block_size, postings.size() - start));
+        for (size_t i = 0; i < block.size(); ++i) {
+            deltas[i] = block[i].doc - previous;
+            // Term frequency is at least 1 for every posting.
+            frequencies[i] = block[i].term_frequency - 1;
+            previous = block[i].doc;
+        }
+        auto block_deltas = std::span(deltas).first(block.size());
+        auto block_frequencies = std::span(frequencies).first(block.size());
+        auto delta_width = bit_width_of_max(block_deltas);
+        auto frequency_width = bit_width_of_max(block_frequencies);
+        w.write_byte(delta_width);
+        w.write_byte(frequency_width);
+        w.write_packed(block_deltas, delta_width);
+        w.write_packed(block_frequencies, frequency_width);
+    }
+    return std::move(w).release();
+}
+
+std::vector<posting> decode_postings(bytes_view encoded, size_t doc_count) {
+    reader r(encoded);
+    auto count = r.read_vint();
+    // Doc ids are distinct and below doc_count.
+    if (count > doc_count) {
+        throw std::runtime_error(fmt::format("Invalid fulltext postings: {} postings for {} documents", count, doc_count));
+    }
+    std::vector<posting> ret;
+    ret.reserve(count);
+    doc_id previous = 0;
+    std::array<uint32_t, postings_block_size> deltas;
+    std::array<uint32_t, postings_block_size> frequencies;
+    while (ret.size() < count) {
+        auto n = std::min<size_t>(postings_block_size, count - ret.size());
+        unsigned delta_width = r.read_byte();
+        unsigned frequency_width = r.read_byte();
+        if (delta_width > 32 || frequency_width > 32) {
+            throw std::runtime_error(fmt::format("Invalid fulltext postings bit width: {}/{}", delta_width, frequency_width));
+        }
+        r.read_packed(std::span(deltas).first(n), delta_width);
+        r.read_packed(std::span(frequencies).first(n), frequency_width);
+        for (size_t i = 0; i < n; ++i) {
+            // Only the first doc id may be encoded as a zero delta (from 0).
+            uint64_t doc = uint64_t(previous) + deltas[i];
+            if ((!ret.empty() && deltas[i] == 0) || doc >= doc_count || frequencies[i] == std::numeric_limits<uint32_t>::max()) {
+                throw std::runtime_error(fmt::format("Invalid fulltext posting: doc id {} after {} of {} documents, term frequency {}",
+                        doc, previous, doc_count, uint64_t(frequencies[i]) + 1));
+            }
+            previous = doc;
+            ret.push_back(posting{previous, frequencies[i] + 1});
+        }
+    }
+    return ret;
+}
+
+doc_id inverted_index_builder::add(std::string_view text) {
+    auto id = doc_id(_doc_lengths.size());
+    auto tokens = tokenize(text, _analyzer);
+    _doc_lengths.push_back(tokens.size());
+    for (auto& token : tokens) {
+        auto& list = _postings[std::move(token)];
+        if (!list.empty() && list.back().doc == id) {
+            ++list.back().term_frequency;
+        } else {
+            list.push_back(posting{id, 1});
+        }
+    }
+    return id;
+}
+
+inverted_index inverted_index_builder::build() && {
+    inverted_index idx(_analyzer);
+    for (auto& [term, list] : _postings) {
+        idx._terms.emplace(term, inverted_index::term_entry{uint32_t(list.size()), encode_postings(list)});
+    }
+    for (auto len : _doc_lengths) {
+        idx._total_length += len;
+    }
+    idx._doc_lengths = std::move(_doc_lengths);
+    return idx;
+}
+
+float inverted_index::average_doc_length() const noexcept {
+    return _doc_lengths.empty() ? 0.0f : float(_total_length) / _doc_lengths.size();
+}
+
+term_stats inverted_index::stats(std::string_view term) const {
+    auto it = _terms.find(term);
+    if (it == _terms.end()) {
+        return {};
+    }
+    return term_stats{it->second.doc_frequency};
+}
+
+std::vector<posting> inverted_index::postings(std::string_view term) const {
+    auto it = _terms.find(term);
+    if (it == _terms.end()) {
+        return {};
+    }
+    return decode_postings(it->second.postings, doc_count());
+}
+
+void inverted_index::add_stats(corpus_stats& stats, std::span<const std::string> query_terms) const {
+    stats.doc_count += doc_count();
+    stats.total_length += _total_length;
+    for (const auto& term : query_terms) {
+        stats.doc_frequencies[term] += this->stats(term).doc_frequency;
+    }
+}
+
+std::vector<scored_doc> inverted_index::search(std::string_view query, size_t k, bm25_parameters params) const {
+    auto terms = query_terms(query, _analyzer);
+    corpus_stats stats;
+    add_stats(stats, terms);
+    return search(terms, k, stats, params);
+}
+
+std::vector<scored_doc> inverted_index::search(std::span<const std::string> query_terms, size_t k, const corpus_stats& stats,
+        bm25_parameters params) const {
+    const float avgdl = stats.average_doc_length();
+    std::unordered_map<doc_id, float> scores;
+    for (const auto& term : query_terms) {
+        auto it = _terms.find(term);
+        if (it == _terms.end()) {
+            continue;
+        }
+        const auto df = doc_frequency(stats, term);
+        for (const auto& p : decode_postings(it->second.postings, _doc_lengths.size())) {
+            scores[p.doc] += bm25_term_score(stats, avgdl, df, p.term_frequency, _doc_lengths[p.doc], params);
+        }
+    }
+
+    std::vector<scored_doc> ret;
+    ret.reserve(scores.size());
+    for (const auto& [doc, score] : scores) {
+        ret.push_back(scored_doc{doc, score});
+    }
+    auto better = [] (const scored_doc& a, const scored_doc& b) {
+        return a.score > b.score || (a.score == b.score && a.doc < b.doc);
+    };
+    if (ret.size() > k) {
+        std::ranges::partial_sort(ret, ret.begin() + k, better);
+        ret.resize(k);
+    } else {
+        std::ranges::sort(ret, better);
+    }
+    return ret;
+}
+
+} // namespace secondary_index::fulltext
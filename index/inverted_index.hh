@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include "bytes.hh"
+
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// An in-memory inverted index with BM25 scoring, which serves the queries of
+// fulltext indexes with the 'local' engine, see replica/local_index.hh.
+//
+// Documents are identified by dense, segment-local ids (e.g. the ordinal
+// of a row in a scan of an sstable); mapping them back to primary keys
+// is up to the owner of the segment.
+namespace secondary_index::fulltext {
+
+using doc_id = uint32_t;
+
+// Text analysis. Only language-independent analyzers are implemented
+// natively; the language-specific ones accepted by the fulltext index
+// options fall back to `standard` (no stemming or stop words).
+enum class analyzer {
+    // Splits on any character that is not a letter or digit and lowercases ASCII.
+    // Non-ASCII UTF-8 sequences are treated as word characters.
+    standard,
+    // Like standard, but only ASCII letters form words.
+    simple,
+    // Splits on ASCII whitespace only, preserving case.
+    whitespace,
+};
+
+analyzer analyzer_from_option(std::string_view name);
+
+std::vector<std::string> tokenize(std::string_view text, analyzer a);
+
+struct posting {
+    doc_id doc;
+    uint32_t term_frequency;
+
+    bool operator==(const posting&) const = default;
+};
+
+// Postings are stored in blocks of `postings_block_size` entries. Within a
+// block, document ids are delta-encoded and both deltas and term frequencies
+// are bit-packed with the smallest width that fits the block's maximum.
+constexpr size_t postings_block_size = 128;
+
+// Postings must be sorted by strictly increasing doc id.
+bytes encode_postings(std::span<const posting> postings);
+// Throws std::runtime_error unless the postings are valid for a segment of
+// doc_count documents.
+std::vector<posting> decode_postings(bytes_view encoded, size_t doc_count);
+
+struct bm25_parameters {
+    // Term frequency saturation.
+    float k1 = 1.2f;
+    // Document length normalization.
+    float b = 0.75f;
+};
+
+struct scored_doc {
+    doc_id doc;
+    float score;
+};
+
+// Per-term statistics needed for BM25 scoring.
+struct term_stats {
+    uint32_t doc_frequency = 0;
+};
+
+// The statistics of the documents BM25 scores are relative to. Several
+// segments are searched as a single corpus by adding up their statistics.
+struct corpus_stats {
+    uint64_t doc_count = 0;
+    uint64_t total_length = 0;
+    // Of the query terms only.
+    std::map<std::string, uint64_t, std::less<>> doc_frequencies;
+
+    float average_doc_length() const noexcept;
+};
+
+// The distinct terms of a query.
+std::vector<std::string> query_terms(std::string_view query, analyzer a);
+
+// The BM25 score of a document, given as its tokens. Zero if the document
+// contains none of the query terms.
+float bm25_score(std::span<const std::string> query_terms, std::span<const std::string> doc_tokens, const corpus_stats& stats,
+        bm25_parameters params = {});
+
+class inverted_index;
+
+class inverted_index_builder {
+    analyzer _analyzer;
+    std::map<std::string, std::vector<posting>, std::less<>> _postings;
+    std::vector<uint32_t> _doc_lengths;
+public:
+    explicit inverted_index_builder(analyzer a) : _analyzer(a) {}
+
+    // Adds the next document and returns its id. Ids are assigned densely,
+    // starting from 0.
+    doc_id add(std::string_view text);
+
+    inverted_index build() &&;
+};
+
+class inverted_index {
+    struct term_entry {
+        uint32_t doc_frequency;
+        bytes postings;
+    };
+    analyzer _analyzer;
+    std::map<std::string, term_entry, std::less<>> _terms;
+    std::vector<uint32_t> _doc_lengths;
+    uint64_t _total_length = 0;
+
+    friend class inverted_index_builder;
+    inverted_index(analyzer a) : _analyzer(a) {}
+public:
+    analyzer get_analyzer() const noexcept { return _analyzer; }
+    size_t doc_count() const noexcept { return _doc_lengths.size(); }
+    size_t term_count() const noexcept { return _terms.size(); }
+    float average_doc_length() const noexcept;
+    term_stats stats(std::string_view term) const;
+    std::vector<posting> postings(std::string_view term) const;
+    // Adds the statistics of this index, for the given query terms, to `stats`.
+    void add_stats(corpus_stats& stats, std::span<const std::string> query_terms) const;
+
+    // Returns up to k documents with the highest BM25 score for the query,
+    // in decreasing score order. The query is tokenized with the same analyzer
+    // as the indexed documents. Documents that match no query term are not returned.
+    std::vector<scored_doc> search(std::string_view query, size_t k, bm25_parameters params = {}) const;
+    // Like the above, but scores the documents relative to `stats`, which
+    // must include the statistics of this index.
+    std::vector<scored_doc> search(std::span<const std::string> query_terms, size_t k, const corpus_stats& stats,
+            bm25_parameters params = {}) const;
+};
+
+} // namespace secondary_index::fulltext
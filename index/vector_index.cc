@@ -53,6 +53,9 @@ const static std::unordered_map<sstring, std::function<void(std::string_view, co
         {"oversampling", std::bind_front(util::validate_factor_option, 1.0f, 100.0f)},
         // 'rescoring' enables recalculating of similarity scores of candidates retrieved from vector store when quantization is used.
         {"rescoring", std::bind_front(util::validate_enumerated_option, util::boolean_values)},
+        // 'engine' selects whether ANN queries are served by the vector store, or by HNSW indexes
+        // of the sstables of the replicas, see replica/local_index.hh.
+        {external_index::ENGINE_OPTION, std::bind_front(util::validate_enumerated_option, external_index::engine_values)},
         // 'source_model' is a Cassandra SAI option specifying the embedding model name.
         // Used by Cassandra libraries (e.g., CassIO) to tag indexes with the model that produced the vectors.
         // Accepted for compatibility but not used by ScyllaDB.
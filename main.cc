@@ -1924,11 +1924,12 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 raft_gr.stop().get();
             });
 
-            auto compression_dict_updated_callback = [&sstable_compressor_factory] (std::string_view name) -> future<> {
+            auto compression_dict_updated_callback = [&sstable_compressor_factory, &db] (std::string_view name) -> future<> {
                 auto dict = co_await sys_ks.local().query_dict(name);
                 auto sstables_prefix = std::string_view("sstables/");
                 if (name.starts_with(sstables_prefix)) {
                     auto table = table_id(utils::UUID(name.substr(sstables_prefix.size())));
+                    co_await replica::database::set_logstor_compression_dictionary_on_all_shards(db, table, dict.data);
                     co_await sstable_compressor_factory.local().set_recommended_dict(table, std::move(dict.data));
                 } else if (name == dictionary_service::rpc_compression_dict_name) {
                     co_await netw::announce_dict_to_shards(compressor_tracker, std::move(dict));
@@ -1976,6 +1977,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     .critical_disk_utilization_level = cfg->critical_disk_utilization_level,
                     .repair_multishard_reader_buffer_hint_size = cfg->repair_multishard_reader_buffer_hint_size,
                     .repair_multishard_reader_enable_read_ahead = cfg->repair_multishard_reader_enable_read_ahead,
+                    .repair_range_summaries = cfg->sstable_repair_summaries,
                 };
             });
             repair.start(std::ref(tsm), std::ref(gossiper), std::ref(messaging), std::ref(db), std::ref(proxy), std::ref(bm), std::ref(sys_ks), std::ref(view_builder), std::ref(view_building_worker), std::ref(task_manager), std::ref(mm), max_memory_repair, std::move(repair_config)).get();
@@ -2790,7 +2792,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
 
             api::set_server_service_levels(ctx, cql_server_ctl, qp).get();
 
-            alternator::controller alternator_ctl(gossiper, proxy, ss, mm, sys_dist_ks, sys_ks, cdc_generation_service, service_memory_limiter, auth_service, sl_controller, vector_store_client, timeout_cfg, *cfg, dbcfg.statement_scheduling_group);
+            alternator::controller alternator_ctl(gossiper, proxy, sc_coordinator, ss, mm, sys_dist_ks, sys_ks, cdc_generation_service, service_memory_limiter, auth_service, sl_controller, vector_store_client, messaging, timeout_cfg, *cfg, dbcfg.statement_scheduling_group);
 
             // Register at_exit last, so that storage_service::drain_on_shutdown will be called first
             auto do_drain = defer_verbose_shutdown("local storage", [&ss] {
@@ -58,6 +58,7 @@
 #include "service/raft/join_node.hh"
 #include "db/view/view_building_state.hh"
 #include "transport/forward.hh"
+#include "alternator/forward.hh"
 #include "idl/consistency_level.dist.hh"
 #include "idl/tracing.dist.hh"
 #include "idl/result.dist.hh"
@@ -140,6 +141,7 @@
 #include "idl/join_node.dist.impl.hh"
 #include "idl/tasks.dist.impl.hh"
 #include "idl/forward_cql.dist.impl.hh"
+#include "idl/alternator.dist.impl.hh"
 #include "idl/strong_consistency/groups_manager.dist.impl.hh"
 #include "gms/feature_service.hh"
 #include "utils/error_injection.hh"
@@ -779,6 +781,7 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::REPAIR_UPDATE_COMPACTION_CTRL:
     case messaging_verb::REPAIR_UPDATE_REPAIRED_AT_FOR_MERGE:
     case messaging_verb::REPAIR_GET_TABLE_SIZE:
+    case messaging_verb::REPAIR_GET_RANGE_SUMMARY:
     case messaging_verb::NODE_OPS_CMD:
     case messaging_verb::HINT_MUTATION:
     case messaging_verb::TABLET_STREAM_FILES:
@@ -799,6 +802,8 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::READ_DATA:
     case messaging_verb::READ_MUTATION_DATA:
     case messaging_verb::READ_DIGEST:
+    case messaging_verb::READ_DATA_MULTI:
+    case messaging_verb::LOCAL_INDEX_SEARCH:
     case messaging_verb::UNUSED__DEFINITIONS_UPDATE:
     case messaging_verb::TRUNCATE:
     case messaging_verb::TRUNCATE_WITH_TABLETS:
@@ -815,6 +820,7 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::PAXOS_PRUNE:
     case messaging_verb::FORWARD_CQL_EXECUTE:
     case messaging_verb::FORWARD_CQL_PREPARE:
+    case messaging_verb::ALTERNATOR_FORWARD_WRITE:
     case messaging_verb::FETCH_COLUMN_MAPPINGS:
         return 2;
     case messaging_verb::MUTATION_DONE:
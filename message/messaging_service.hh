@@ -220,8 +220,12 @@ enum class messaging_verb : int32_t {
     FETCH_COLUMN_MAPPINGS = 91,
     REPAIR_GET_TABLE_SIZE = 92,
     BACKUP_SNAPSHOT_SSTABLES = 93,
+    REPAIR_GET_RANGE_SUMMARY = 94,
+    READ_DATA_MULTI = 95,
+    ALTERNATOR_FORWARD_WRITE = 96,
+    LOCAL_INDEX_SEARCH = 97,
 
-    LAST = 94,
+    LAST = 98,
 };
 
 } // namespace netw
@@ -11,25 +11,37 @@
 #include "counters.hh"
 #include "types/types.hh"
 
+#include <algorithm>
+
 atomic_cell atomic_cell::make_dead(api::timestamp_type timestamp, gc_clock::time_point deletion_time) {
     return atomic_cell_type::make_dead(timestamp, deletion_time);
 }
 
+// Counter cells are excluded, because their timestamps are updated in place,
+// which may need the full-size field.
+template <FragmentRange Buffer>
+static managed_bytes make_live_cell(const abstract_type& type, api::timestamp_type timestamp, const Buffer& value) {
+    if (!type.is_counter() && atomic_cell_type::can_be_compact(timestamp)) {
+        return atomic_cell_type::make_live_compact(timestamp, value);
+    }
+    return atomic_cell_type::make_live(timestamp, value);
+}
+
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, bytes_view value, atomic_cell::collection_member cm) {
-    return atomic_cell_type::make_live(timestamp, single_fragment_range(value));
+    return make_live_cell(type, timestamp, single_fragment_range(value));
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, managed_bytes_view value, atomic_cell::collection_member cm) {
-    return atomic_cell_type::make_live(timestamp, fragment_range(value));
+    return make_live_cell(type, timestamp, fragment_range(value));
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, ser::buffer_view<bytes_ostream::fragment_iterator> value, atomic_cell::collection_member cm) {
-    return atomic_cell_type::make_live(timestamp, value);
+    return make_live_cell(type, timestamp, value);
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, const fragmented_temporary_buffer::view& value, collection_member cm)
 {
-    return atomic_cell_type::make_live(timestamp, value);
+    return make_live_cell(type, timestamp, value);
 }
 
 atomic_cell atomic_cell::make_live(const abstract_type& type, api::timestamp_type timestamp, bytes_view value,
@@ -133,41 +145,52 @@ atomic_cell_or_collection::atomic_cell_or_collection(const abstract_type& type,
 {
 }
 
-bool atomic_cell_or_collection::equals(const abstract_type& type, const atomic_cell_or_collection& other) const
-{
-    if (_data.empty() || other._data.empty()) {
-        return _data.empty() && other._data.empty();
+// Compares the fields of the cells rather than their bytes, because equal cells
+// may be in different layouts (see atomic_cell_type).
+static bool cells_equal(atomic_cell_view a, atomic_cell_view b) {
+    if (a.timestamp() != b.timestamp()) {
+        return false;
     }
-
-    if (type.is_atomic()) {
-        auto a = atomic_cell_view::from_bytes(_data);
-        auto b = atomic_cell_view::from_bytes(other._data);
-        if (a.timestamp() != b.timestamp()) {
+    if (a.is_live() != b.is_live()) {
+        return false;
+    }
+    if (a.is_live()) {
+        if (a.is_counter_update() != b.is_counter_update()) {
             return false;
         }
-        if (a.is_live() != b.is_live()) {
+        if (a.is_counter_update()) {
+            return a.counter_update_value() == b.counter_update_value();
+        }
+        if (a.is_live_and_has_ttl() != b.is_live_and_has_ttl()) {
             return false;
         }
-        if (a.is_live()) {
-            if (a.is_counter_update() != b.is_counter_update()) {
+        if (a.is_live_and_has_ttl()) {
+            if (a.ttl() != b.ttl() || a.expiry() != b.expiry()) {
                 return false;
             }
-            if (a.is_counter_update()) {
-                return a.counter_update_value() == b.counter_update_value();
-            }
-            if (a.is_live_and_has_ttl() != b.is_live_and_has_ttl()) {
-                return false;
-            }
-            if (a.is_live_and_has_ttl()) {
-                if (a.ttl() != b.ttl() || a.expiry() != b.expiry()) {
-                    return false;
-                }
-            }
-            return a.value() == b.value();
         }
-        return a.deletion_time() == b.deletion_time();
+        return a.value() == b.value();
+    }
+    return a.deletion_time() == b.deletion_time();
+}
+
+bool atomic_cell_or_collection::equals(const abstract_type& type, const atomic_cell_or_collection& other) const
+{
+    if (_data.empty() || other._data.empty()) {
+        return _data.empty() && other._data.empty();
+    }
+
+    if (type.is_atomic()) {
+        return cells_equal(atomic_cell_view::from_bytes(_data), atomic_cell_view::from_bytes(other._data));
     } else {
-        return as_collection_mutation().data == other.as_collection_mutation().data;
+        auto a = as_collection_mutation();
+        auto b = other.as_collection_mutation();
+        if (a.tomb() != b.tomb() || a.size() != b.size()) {
+            return false;
+        }
+        return std::ranges::equal(a, b, [] (const auto& x, const auto& y) {
+            return x.first == y.first && cells_equal(x.second, y.second);
+        });
     }
 }
 
@@ -69,11 +69,21 @@ T get_field(Input in, unsigned offset = 0) {
  *
  *  <live>  := <int8_t:flags><int64_t:timestamp>(<int64_t:expiry><int32_t:ttl>)?<value>
  *  <dead>  := <int8_t:    0><int64_t:timestamp><int64_t:deletion_time>
+ *
+ * Live cells without expiry and with a non-negative timestamp below 2^52 (which
+ * microseconds since the epoch are until 2112) use the compact layout:
+ *
+ *  <compact> := <int8_t:flags><uint16_t:timestamp bits 32..47><uint32_t:timestamp bits 0..31><value>
+ *
+ * where the upper 4 bits of the flags hold the timestamp bits 48..51. Saving the
+ * 2 bytes lets cells with 8-byte values (bigint, double, timestamp, ...) fit into
+ * managed_bytes' inline storage, so they don't need an allocation of their own.
  */
 class atomic_cell_type final {
 private:
     static constexpr int8_t LIVE_FLAG = 0x01;
     static constexpr int8_t EXPIRY_FLAG = 0x02; // When present, expiry field is present. Set only for live cells
+    static constexpr int8_t COMPACT_FLAG = 0x04; // When present, the timestamp is compact. Set only for live cells without expiry
     static constexpr int8_t COUNTER_UPDATE_FLAG = 0x08; // Cell is a counter update.
     static constexpr unsigned flags_size = 1;
     static constexpr unsigned timestamp_offset = flags_size;
@@ -84,8 +94,29 @@ class atomic_cell_type final {
     static constexpr unsigned deletion_time_size = 8;
     static constexpr unsigned ttl_offset = expiry_offset + expiry_size;
     static constexpr unsigned ttl_size = 4;
+    static constexpr unsigned compact_timestamp_size = 6;
+    static constexpr unsigned compact_timestamp_bits = 52;
+    static constexpr uint8_t compact_timestamp_flags_shift = 4;
     friend class counter_cell_builder;
 private:
+    static bool is_compact(atomic_cell_value_view cell) {
+        return cell.front() & COMPACT_FLAG;
+    }
+    static unsigned timestamp_size_of(atomic_cell_value_view cell) {
+        return is_compact(cell) ? compact_timestamp_size : timestamp_size;
+    }
+    static api::timestamp_type compact_timestamp(atomic_cell_value_view cell) {
+        uint64_t high = uint8_t(cell.front()) >> compact_timestamp_flags_shift;
+        uint64_t mid = get_field<uint16_t>(cell, timestamp_offset);
+        uint64_t low = get_field<uint32_t>(cell, timestamp_offset + sizeof(uint16_t));
+        return api::timestamp_type((high << 48) | (mid << 32) | low);
+    }
+    static void set_compact_timestamp(atomic_cell_value_mutable_view& cell, api::timestamp_type timestamp) {
+        auto ts = uint64_t(timestamp);
+        cell[0] = int8_t(LIVE_FLAG | COMPACT_FLAG | ((ts >> 48) << compact_timestamp_flags_shift));
+        set_field(cell, timestamp_offset, uint16_t(ts >> 32));
+        set_field(cell, timestamp_offset + sizeof(uint16_t), uint32_t(ts));
+    }
     static bool is_counter_update(atomic_cell_value_view cell) {
         return cell.front() & COUNTER_UPDATE_FLAG;
     }
@@ -100,9 +131,18 @@ class atomic_cell_type final {
     }
     // Can be called on live and dead cells
     static api::timestamp_type timestamp(atomic_cell_value_view cell) {
+        if (is_compact(cell)) {
+            return compact_timestamp(cell);
+        }
         return get_field<api::timestamp_type>(cell, timestamp_offset);
     }
     static void set_timestamp(atomic_cell_value_mutable_view& cell, api::timestamp_type ts) {
+        if (is_compact(cell)) {
+            // The cell can't grow, but only counter cells have their timestamps changed, and those are never compact.
+            SCYLLA_ASSERT(can_be_compact(ts));
+            set_compact_timestamp(cell, ts);
+            return;
+        }
         set_field(cell, timestamp_offset, ts);
     }
     // Can be called on live cells only
@@ -110,7 +150,7 @@ class atomic_cell_type final {
     template <mutable_view is_mutable>
     static managed_bytes_basic_view<is_mutable> do_get_value(managed_bytes_basic_view<is_mutable> cell) {
         auto expiry_field_size = bool(cell.front() & EXPIRY_FLAG) * (expiry_size + ttl_size);
-        auto value_offset = flags_size + timestamp_size + expiry_field_size;
+        auto value_offset = flags_size + timestamp_size_of(cell) + expiry_field_size;
         cell.remove_prefix(value_offset);
         return cell;
     }
@@ -147,6 +187,9 @@ class atomic_cell_type final {
     static size_t live_serialized_size(size_t value_size) {
         return flags_size + timestamp_size + value_size;
     }
+    static size_t live_compact_serialized_size(size_t value_size) {
+        return flags_size + compact_timestamp_size + value_size;
+    }
     static size_t live_expiring_serialized_size(size_t value_size) {
         return flags_size + timestamp_size + expiry_size + ttl_size + value_size;
     }
@@ -173,6 +216,22 @@ class atomic_cell_type final {
         write_live(b, timestamp, value);
         return b;
     }
+    // Whether a live cell without expiry with the given timestamp can use the compact layout.
+    static bool can_be_compact(api::timestamp_type timestamp) {
+        return timestamp >= 0 && uint64_t(timestamp) < (uint64_t(1) << compact_timestamp_bits);
+    }
+    template <FragmentRange Buffer>
+    static void write_live_compact(atomic_cell_value_mutable_view b, api::timestamp_type timestamp, const Buffer& value) {
+        set_compact_timestamp(b, timestamp);
+        set_value(b, flags_size + compact_timestamp_size, value);
+    }
+    // Can be called only when can_be_compact(timestamp) is true.
+    template <FragmentRange Buffer>
+    static managed_bytes make_live_compact(api::timestamp_type timestamp, const Buffer& value) {
+        managed_bytes b(managed_bytes::initialized_later(), live_compact_serialized_size(value.size_bytes()));
+        write_live_compact(b, timestamp, value);
+        return b;
+    }
     static managed_bytes make_live_counter_update(api::timestamp_type timestamp, int64_t value) {
         auto value_offset = flags_size + timestamp_size;
         managed_bytes b(managed_bytes::initialized_later(), value_offset + sizeof(value));
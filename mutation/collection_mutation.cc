@@ -285,7 +285,12 @@ struct serialized_cell_adaptor {
 
     static size_t value_size(const ser::collection_element_view& v) {
         struct collection_cell_visitor {
-            size_t operator()(const ser::live_cell_view& lcv) const { return atomic_cell_type::live_serialized_size(lcv.value().view().size_bytes()); }
+            size_t operator()(const ser::live_cell_view& lcv) const {
+                auto size = lcv.value().view().size_bytes();
+                return atomic_cell_type::can_be_compact(lcv.created_at())
+                        ? atomic_cell_type::live_compact_serialized_size(size)
+                        : atomic_cell_type::live_serialized_size(size);
+            }
             size_t operator()(const ser::expiring_cell_view& ecv) const { return atomic_cell_type::live_expiring_serialized_size(ecv.c().value().view().size_bytes()); }
             size_t operator()(const ser::dead_cell_view& dcv) const { return atomic_cell_type::dead_serialized_size(); }
             size_t operator()(const ser::counter_cell_view& ccv) const { utils::on_internal_error("Trying to deserialize counter cell from collection"); }
@@ -304,6 +309,12 @@ struct serialized_cell_adaptor {
 
             void operator()(const ser::live_cell_view& lcv) const {
                 const auto v = lcv.value().view();
+                // Like atomic_cell::make_live(), so that cells don't depend on how they were built.
+                if (atomic_cell_type::can_be_compact(lcv.created_at())) {
+                    atomic_cell_type::write_live_compact(out, lcv.created_at(), v);
+                    out.remove_prefix(atomic_cell_type::live_compact_serialized_size(v.size_bytes()));
+                    return;
+                }
                 atomic_cell_type::write_live(out, lcv.created_at(), v);
                 out.remove_prefix(atomic_cell_type::live_serialized_size(v.size_bytes()));
             }
@@ -22,6 +22,7 @@
 #include "service/migration_manager.hh"
 #include "service/storage_service.hh"
 #include "sstables/sstables.hh"
+#include "sstables/repair_summary.hh"
 #include "partition_range_compat.hh"
 #include "utils/assert.hh"
 #include "utils/error_injection.hh"
@@ -721,6 +722,30 @@ future<uint64_t> local_table_on_disk_size(seastar::sharded<replica::database>& d
     );
 }
 
+future<sstables::repair_summary::sub_range_hashes> local_range_summary_hashes(seastar::sharded<replica::database>& db, table_id table, dht::token_range range) {
+    namespace rs = sstables::repair_summary;
+    auto sub_ranges = rs::aligned_sub_ranges(range);
+    if (!sub_ranges) {
+        co_return rs::sub_range_hashes();
+    }
+    auto nr = sub_ranges->second - sub_ranges->first + 1;
+    co_return co_await db.map_reduce0(
+        [table, &range, sub_ranges = *sub_ranges, nr] (const replica::database& db) -> rs::sub_range_hashes {
+            const auto* cf = find_column_family_if_exists(db, table, false);
+            // Data in memtables isn't summarized.
+            if (!cf || cf->uses_logstor() || cf->occupancy().used_space()) {
+                return rs::sub_range_hashes(nr);
+            }
+            return rs::collect_hashes(cf->select_sstables(dht::to_partition_range(range)), sub_ranges);
+        },
+        rs::sub_range_hashes(nr, rs::no_data_hash),
+        [] (rs::sub_range_hashes a, const rs::sub_range_hashes& b) {
+            rs::merge(a, b);
+            return a;
+        }
+    );
+}
+
 repair::shard_repair_task_impl::shard_repair_task_impl(tasks::task_manager::module_ptr module,
         tasks::task_id id,
         sstring keyspace,
@@ -165,6 +165,11 @@ future<uint64_t> estimate_partitions(seastar::sharded<replica::database>& db, co
 // shards of the local node. Returns 0 if the table does not exist locally.
 future<uint64_t> local_table_on_disk_size(seastar::sharded<replica::database>& db, table_id table);
 
+// The hashes of the data of the table in each sub-range of the range on this node,
+// computed from the repair summaries of the sstables (see sstables/repair_summary.hh).
+// Empty if the range isn't made of whole sub-ranges. See sub_range_hashes.
+future<std::vector<std::optional<uint64_t>>> local_range_summary_hashes(seastar::sharded<replica::database>& db, table_id table, dht::token_range range);
+
 
 enum class repair_row_level_start_status: uint8_t {
     ok,
@@ -18,6 +18,7 @@
 #include <seastar/coroutine/exception.hh>
 #include "sstables/sstables.hh"
 #include "sstables/sstables_manager.hh"
+#include "sstables/repair_summary.hh"
 #include "mutation/mutation_fragment.hh"
 #include "mutation_writer/multishard_writer.hh"
 #include "dht/i_partitioner.hh"
@@ -196,6 +197,7 @@ struct row_level_repair_metrics {
     uint64_t inc_sst_skipped_bytes{0};
     uint64_t inc_sst_read_bytes{0};
     uint64_t tablet_time_ms{0};
+    uint64_t summary_skipped_sub_ranges{0};
     row_level_repair_metrics() {
         namespace sm = seastar::metrics;
         _metrics.add_group("repair", {
@@ -221,6 +223,8 @@ struct row_level_repair_metrics {
                             sm::description("Total number of bytes read from sstables for incremental repair on this shard.")),
             sm::make_counter("tablet_time_ms", tablet_time_ms,
                             sm::description("Time spent on tablet repair on this shard in milliseconds.")),
+            sm::make_counter("summary_skipped_sub_ranges", summary_skipped_sub_ranges,
+                            sm::description("Total number of sub-ranges which were found identical on all the replicas from their sstables' repair summaries, without reading them, on this shard.")),
         });
     }
 };
@@ -2970,6 +2974,10 @@ future<> repair_service::init_ms_handlers() {
         co_return co_await local_table_on_disk_size(get_db(), table);
     });
 
+    ser::repair_rpc_verbs::register_repair_get_range_summary(&ms, [this] (const rpc::client_info& cinfo, table_id table, dht::token_range range) -> future<std::vector<std::optional<uint64_t>>> {
+        co_return co_await local_range_summary_hashes(get_db(), table, std::move(range));
+    });
+
 
     return make_ready_future<>();
 }
@@ -3122,6 +3130,98 @@ class row_level_repair {
         return size;
     }
 
+    // Each range to sync costs a round of repair_row_level_start/stop RPCs, so
+    // close ranges which differ are synced together.
+    static constexpr size_t max_summary_ranges_to_sync = 16;
+
+    // Returns the parts of the range which may differ between the nodes, found by
+    // comparing the hashes of the sub-ranges computed from the repair summaries of
+    // the sstables (see sstables/repair_summary.hh). The other parts needn't be read.
+    //
+    // Incremental repair reads only part of the sstables, so the summaries don't
+    // apply to it.
+    dht::token_range_vector ranges_to_sync(bool incremental_repair) {
+        namespace rs = sstables::repair_summary;
+        if (incremental_repair || !_shard_task.rs.get_config().repair_range_summaries()
+                || !_shard_task.db.local().features().repair_range_summaries) {
+            return {_range};
+        }
+        try {
+            auto hashes = local_range_summary_hashes(_shard_task.db, _table_id, _range).get();
+            if (hashes.empty()) {
+                return {_range};
+            }
+            parallel_for_each(_all_live_peer_nodes, coroutine::lambda([&] (locator::host_id node) -> future<> {
+                auto peer_hashes = co_await ser::repair_rpc_verbs::send_repair_get_range_summary(&_shard_task.messaging.local(), node, _table_id, _range);
+                if (peer_hashes.size() != hashes.size()) {
+                    std::ranges::fill(hashes, std::nullopt);
+                    co_return;
+                }
+                // A sub-range is synced if its hash is known and the same on all the nodes.
+                for (size_t i = 0; i < hashes.size(); ++i) {
+                    if (peer_hashes[i] != hashes[i]) {
+                        hashes[i] = std::nullopt;
+                    }
+                }
+            })).get();
+
+            // The runs of consecutive sub-ranges to sync.
+            std::vector<std::pair<uint32_t, uint32_t>> runs;
+            for (uint32_t i = 0; i < hashes.size(); ++i) {
+                if (hashes[i]) {
+                    continue;
+                }
+                if (!runs.empty() && runs.back().second + 1 == i) {
+                    runs.back().second = i;
+                } else {
+                    runs.emplace_back(i, i);
+                }
+            }
+            auto skipped = hashes.size() - std::count(hashes.begin(), hashes.end(), std::nullopt);
+            _metrics.summary_skipped_sub_ranges += skipped;
+            rlogger.debug("repair[{}]: keyspace={}, cf={}, range={}: {} out of {} sub-ranges are identical on all nodes according to the repair summaries",
+                    _shard_task.global_repair_id.uuid(), _shard_task.get_keyspace(), _cf_name, _range, skipped, hashes.size());
+
+            if (runs.size() > max_summary_ranges_to_sync) {
+                // Merge the runs separated by the smallest gaps.
+                std::vector<std::pair<uint32_t, size_t>> gaps;
+                for (size_t i = 1; i < runs.size(); ++i) {
+                    gaps.emplace_back(runs[i].first - runs[i - 1].second, i);
+                }
+                auto nr_merged = runs.size() - max_summary_ranges_to_sync;
+                std::ranges::nth_element(gaps, gaps.begin() + nr_merged);
+                std::vector<bool> merge_with_previous(runs.size());
+                for (size_t i = 0; i < nr_merged; ++i) {
+                    merge_with_previous[gaps[i].second] = true;
+                }
+                std::vector<std::pair<uint32_t, uint32_t>> merged;
+                for (size_t i = 0; i < runs.size(); ++i) {
+                    if (merge_with_previous[i]) {
+                        merged.back().second = runs[i].second;
+                    } else {
+                        merged.push_back(runs[i]);
+                    }
+                }
+                runs = std::move(merged);
+            }
+
+            auto first = rs::aligned_sub_ranges(_range)->first;
+            dht::token_range_vector ranges;
+            for (auto [from, to] : runs) {
+                auto r = rs::token_range_of({first + from, first + to}).intersection(_range, dht::token_comparator());
+                if (r) {
+                    ranges.push_back(std::move(*r));
+                }
+            }
+            return ranges;
+        } catch (...) {
+            // The summaries only save reading parts of the range, so just read it.
+            rlogger.debug("repair[{}]: failed to compare the repair summaries of keyspace={}, cf={}, range={}: {}",
+                    _shard_task.global_repair_id.uuid(), _shard_task.get_keyspace(), _cf_name, _range, std::current_exception());
+            return {_range};
+        }
+    }
+
     // Step A: Negotiate sync boundary to use
     op_status negotiate_sync_boundary(repair_meta& master) {
         _shard_task.check_in_abort_or_shutdown();
@@ -3433,184 +3533,202 @@ class row_level_repair {
         co_return;
     }
 
-public:
-    future<> run() {
-        return seastar::async([this] {
-            _shard_task.check_in_abort_or_shutdown();
-            auto repair_meta_id = _shard_task.rs.get_next_repair_meta_id().get();
-            auto algorithm = get_common_diff_detect_algorithm(_shard_task.messaging.local(), _all_live_peer_nodes);
-            auto max_row_buf_size = get_max_row_buf_size(algorithm);
-            auto& cf = _shard_task.db.local().find_column_family(_table_id);
-            auto& sharder = cf.get_effective_replication_map()->get_sharder(*(cf.schema()));
-            auto master_node_shard_config = shard_config {
-                    this_shard_id(),
-                    sharder.shard_count(),
-                    sharder.sharding_ignore_msb()
-            };
-            auto s = cf.schema();
-            auto schema_version = s->version();
-            bool table_dropped = false;
-
-            auto& mem_sem = _shard_task.rs.memory_sem();
-            auto max = _shard_task.rs.max_repair_memory();
-            auto wanted = (_all_live_peer_nodes.size() + 1) * max_row_buf_size;
-            wanted = std::min(max, wanted);
-            rlogger.trace("repair[{}]: Started to get memory budget, wanted={}, available={}, max_repair_memory={}",
-                    _shard_task.global_repair_id.uuid(), wanted, mem_sem.current(), max);
-            auto mem_permit = seastar::get_units(mem_sem, wanted).get();
-            rlogger.trace("repair[{}]: Finished to get memory budget, wanted={}, available={}, max_repair_memory={}",
-                    _shard_task.global_repair_id.uuid(), wanted, mem_sem.current(), max);
-
-            auto permit = _shard_task.db.local().obtain_reader_permit(_shard_task.db.local().find_column_family(_table_id), "repair-meta", db::no_timeout, {}).get();
-
-            auto compaction_time = gc_clock::now();
-
-            std::optional<int64_t> repaired_at;
-            bool enable_incremental_repair = _shard_task.db.local().features().tablet_incremental_repair && _is_tablet &&
-                                              _shard_task.sched_info.incremental_mode != locator::tablet_repair_incremental_mode::disabled &&
-                                             _shard_task.sched_info.sched_by_scheduler &&
-                                             !_shard_task.sched_info.for_tablet_rebuild;
-            if (enable_incremental_repair) {
-                auto& table = _shard_task.db.local().find_column_family(_table_id);
-                auto erm = table.get_effective_replication_map();
-                auto& tmap = erm->get_token_metadata_ptr()->tablets().get_tablet_map(_table_id);
-                auto last_token = _range.end() ? _range.end()->value() : dht::maximum_token();
-                auto& tinfo = tmap.get_tablet_info(last_token);
-                auto sstables_repaired_at = tinfo.sstables_repaired_at;
-                repaired_at = sstables_repaired_at + 1;
+private:
+    bool incremental_repair_enabled() {
+        return _shard_task.db.local().features().tablet_incremental_repair && _is_tablet &&
+                _shard_task.sched_info.incremental_mode != locator::tablet_repair_incremental_mode::disabled &&
+                _shard_task.sched_info.sched_by_scheduler &&
+                !_shard_task.sched_info.for_tablet_rebuild;
+    }
+
+    // Syncs the range, a part of _range, between the nodes. Must be called in a seastar thread.
+    void sync_range(const dht::token_range& range, bool enable_incremental_repair) {
+        _shard_task.check_in_abort_or_shutdown();
+        _sync_boundaries.clear();
+        _combined_hashes.clear();
+        _common_sync_boundary = {};
+        _skipped_sync_boundary = {};
+        _zero_rows = false;
+        _estimated_partitions = 0;
+        auto repair_meta_id = _shard_task.rs.get_next_repair_meta_id().get();
+        auto algorithm = get_common_diff_detect_algorithm(_shard_task.messaging.local(), _all_live_peer_nodes);
+        auto max_row_buf_size = get_max_row_buf_size(algorithm);
+        auto& cf = _shard_task.db.local().find_column_family(_table_id);
+        auto& sharder = cf.get_effective_replication_map()->get_sharder(*(cf.schema()));
+        auto master_node_shard_config = shard_config {
+                this_shard_id(),
+                sharder.shard_count(),
+                sharder.sharding_ignore_msb()
+        };
+        auto s = cf.schema();
+        auto schema_version = s->version();
+        bool table_dropped = false;
+
+        auto& mem_sem = _shard_task.rs.memory_sem();
+        auto max = _shard_task.rs.max_repair_memory();
+        auto wanted = (_all_live_peer_nodes.size() + 1) * max_row_buf_size;
+        wanted = std::min(max, wanted);
+        rlogger.trace("repair[{}]: Started to get memory budget, wanted={}, available={}, max_repair_memory={}",
+                _shard_task.global_repair_id.uuid(), wanted, mem_sem.current(), max);
+        auto mem_permit = seastar::get_units(mem_sem, wanted).get();
+        rlogger.trace("repair[{}]: Finished to get memory budget, wanted={}, available={}, max_repair_memory={}",
+                _shard_task.global_repair_id.uuid(), wanted, mem_sem.current(), max);
+
+        auto permit = _shard_task.db.local().obtain_reader_permit(_shard_task.db.local().find_column_family(_table_id), "repair-meta", db::no_timeout, {}).get();
+
+        auto compaction_time = gc_clock::now();
+
+        std::optional<int64_t> repaired_at;
+        if (enable_incremental_repair) {
+            auto& table = _shard_task.db.local().find_column_family(_table_id);
+            auto erm = table.get_effective_replication_map();
+            auto& tmap = erm->get_token_metadata_ptr()->tablets().get_tablet_map(_table_id);
+            auto last_token = _range.end() ? _range.end()->value() : dht::maximum_token();
+            auto& tinfo = tmap.get_tablet_info(last_token);
+            auto sstables_repaired_at = tinfo.sstables_repaired_at;
+            repaired_at = sstables_repaired_at + 1;
+        }
+
+        repair_meta master(_shard_task.rs,
+                _shard_task.db.local().find_column_family(_table_id),
+                s,
+                std::move(permit),
+                range,
+                algorithm,
+                max_row_buf_size,
+                _seed,
+                repair_master::yes,
+                repair_meta_id,
+                _shard_task.reason(),
+                std::move(master_node_shard_config),
+                _all_live_peer_nodes,
+                _all_live_peer_nodes.size(),
+                _all_live_peer_shards,
+                this,
+                compaction_time,
+                _topo_guard,
+                repaired_at,
+                _shard_task.sched_info.incremental_mode);
+        auto auto_stop_master = defer([&master] noexcept {
+            try {
+                master.stop().get();
+            } catch (...) {
+                std::exception_ptr ep = std::current_exception();
+                rlogger.warn("Failed auto-stopping Row Level Repair (Master): {}. Ignored.", ep);
             }
+        });
 
-            repair_meta master(_shard_task.rs,
-                    _shard_task.db.local().find_column_family(_table_id),
-                    s,
-                    std::move(permit),
-                    _range,
-                    algorithm,
-                    max_row_buf_size,
-                    _seed,
-                    repair_master::yes,
-                    repair_meta_id,
-                    _shard_task.reason(),
-                    std::move(master_node_shard_config),
-                    _all_live_peer_nodes,
-                    _all_live_peer_nodes.size(),
-                    _all_live_peer_shards,
-                    this,
-                    compaction_time,
-                    _topo_guard,
-                    repaired_at,
-                    _shard_task.sched_info.incremental_mode);
-            auto auto_stop_master = defer([&master] noexcept {
-                try {
-                    master.stop().get();
-                } catch (...) {
-                    std::exception_ptr ep = std::current_exception();
-                    rlogger.warn("Failed auto-stopping Row Level Repair (Master): {}. Ignored.", ep);
-                }
-            });
+        rlogger.debug(">>> Started Row Level Repair (Master): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, schema_version={}, range={}, seed={}, max_row_buf_size={}",
+                master.myhostid(), _all_live_peer_nodes, master.repair_meta_id(), _shard_task.get_keyspace(), _cf_name, schema_version, range, _seed, max_row_buf_size);
 
-            rlogger.debug(">>> Started Row Level Repair (Master): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, schema_version={}, range={}, seed={}, max_row_buf_size={}",
-                    master.myhostid(), _all_live_peer_nodes, master.repair_meta_id(), _shard_task.get_keyspace(), _cf_name, schema_version, _range, _seed, max_row_buf_size);
+        std::exception_ptr ex = nullptr;
+        std::vector<repair_node_state> nodes_to_stop;
+        nodes_to_stop.reserve(master.all_nodes().size());
+        try {
+            parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
+                const auto& node = ns.node;
+                ns.state = repair_state::row_level_start_started;
+                co_await master.repair_row_level_start(node, _shard_task.get_keyspace(), _cf_name, range, schema_version, _shard_task.reason(), compaction_time, ns.shard);
+                ns.state = repair_state::row_level_start_finished;
+                nodes_to_stop.push_back(ns);
+                ns.state = repair_state::get_estimated_partitions_started;
+                uint64_t partitions = co_await master.repair_get_estimated_partitions(node, ns.shard);
+                ns.state = repair_state::get_estimated_partitions_finished;
+                rlogger.trace("Get repair_get_estimated_partitions for node={}, estimated_partitions={}", node, partitions);
+                _estimated_partitions += partitions;
+            })).get();
 
-            std::exception_ptr ex = nullptr;
-            std::vector<repair_node_state> nodes_to_stop;
-            nodes_to_stop.reserve(master.all_nodes().size());
-            try {
-                parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
-                    const auto& node = ns.node;
-                    ns.state = repair_state::row_level_start_started;
-                    co_await master.repair_row_level_start(node, _shard_task.get_keyspace(), _cf_name, _range, schema_version, _shard_task.reason(), compaction_time, ns.shard);
-                    ns.state = repair_state::row_level_start_finished;
-                    nodes_to_stop.push_back(ns);
-                    ns.state = repair_state::get_estimated_partitions_started;
-                    uint64_t partitions = co_await master.repair_get_estimated_partitions(node, ns.shard);
-                    ns.state = repair_state::get_estimated_partitions_finished;
-                    rlogger.trace("Get repair_get_estimated_partitions for node={}, estimated_partitions={}", node, partitions);
-                    _estimated_partitions += partitions;
-                })).get();
-
-                if (!master.all_nodes().empty()) {
-                    // Use the average number of partitions, instead of the sum
-                    // of the partitions, as the estimated partitions in a
-                    // given range. The bigger the estimated partitions, the
-                    // more memory bloom filter for the sstable would consume.
-                    _estimated_partitions /= master.all_nodes().size();
-
-                    // In addition, estimate the difference between nodes is
-                    // less than the specified ratio for regular repair.
-                    // Underestimation will not be a big problem since those
-                    // sstables produced by repair will go through off-strategy
-                    // later anyway. The worst case is that we have a worse
-                    // false positive ratio than expected temporarily when the
-                    // sstable is still in maintenance set.
-                    //
-                    // To save memory and have less different conditions, we
-                    // use the estimation for RBNO repair as well.
-
-                    _estimated_partitions *= _shard_task.rs.get_config().repair_partition_count_estimation_ratio();
-                }
+            if (!master.all_nodes().empty()) {
+                // Use the average number of partitions, instead of the sum
+                // of the partitions, as the estimated partitions in a
+                // given range. The bigger the estimated partitions, the
+                // more memory bloom filter for the sstable would consume.
+                _estimated_partitions /= master.all_nodes().size();
+
+                // In addition, estimate the difference between nodes is
+                // less than the specified ratio for regular repair.
+                // Underestimation will not be a big problem since those
+                // sstables produced by repair will go through off-strategy
+                // later anyway. The worst case is that we have a worse
+                // false positive ratio than expected temporarily when the
+                // sstable is still in maintenance set.
+                //
+                // To save memory and have less different conditions, we
+                // use the estimation for RBNO repair as well.
+
+                _estimated_partitions *= _shard_task.rs.get_config().repair_partition_count_estimation_ratio();
+            }
 
-                parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
-                    const auto& node = ns.node;
-                    rlogger.trace("Get repair_set_estimated_partitions for node={}, estimated_partitions={}", node, _estimated_partitions);
-                    ns.state = repair_state::set_estimated_partitions_started;
-                    co_await master.repair_set_estimated_partitions(node, _estimated_partitions, ns.shard);
-                    ns.state = repair_state::set_estimated_partitions_finished;
-                })).get();
-
-                while (true) {
-                    auto status = negotiate_sync_boundary(master);
-                    if (status == op_status::next_round) {
-                        continue;
-                    } else if (status == op_status::all_done) {
-                        break;
-                    }
-                    status = get_missing_rows_from_follower_nodes(master);
-                    if (status == op_status::next_round) {
-                        continue;
-                    }
-                    send_missing_rows_to_follower_nodes(master);
+            parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
+                const auto& node = ns.node;
+                rlogger.trace("Get repair_set_estimated_partitions for node={}, estimated_partitions={}", node, _estimated_partitions);
+                ns.state = repair_state::set_estimated_partitions_started;
+                co_await master.repair_set_estimated_partitions(node, _estimated_partitions, ns.shard);
+                ns.state = repair_state::set_estimated_partitions_finished;
+            })).get();
+
+            while (true) {
+                auto status = negotiate_sync_boundary(master);
+                if (status == op_status::next_round) {
+                    continue;
+                } else if (status == op_status::all_done) {
+                    break;
                 }
-            } catch (replica::no_such_column_family& e) {
-                table_dropped = true;
-                rlogger.warn("repair[{}]: shard={}, keyspace={}, cf={}, range={}, got error in row level repair: {}",
-                        _shard_task.global_repair_id.uuid(), this_shard_id(), _shard_task.get_keyspace(), _cf_name, _range, e);
-                _failed = true;
-            } catch (std::exception& e) {
-                rlogger.warn("repair[{}]: shard={}, keyspace={}, cf={}, range={}, got error in row level repair: {}",
-                        _shard_task.global_repair_id.uuid(), this_shard_id(), _shard_task.get_keyspace(), _cf_name, _range, e);
-                // In case the repair process fail, we need to call repair_row_level_stop to clean up repair followers
-                _failed = true;
-                ex = std::current_exception();
+                status = get_missing_rows_from_follower_nodes(master);
+                if (status == op_status::next_round) {
+                    continue;
+                }
+                send_missing_rows_to_follower_nodes(master);
             }
+        } catch (replica::no_such_column_family& e) {
+            table_dropped = true;
+            rlogger.warn("repair[{}]: shard={}, keyspace={}, cf={}, range={}, got error in row level repair: {}",
+                    _shard_task.global_repair_id.uuid(), this_shard_id(), _shard_task.get_keyspace(), _cf_name, range, e);
+            _failed = true;
+        } catch (std::exception& e) {
+            rlogger.warn("repair[{}]: shard={}, keyspace={}, cf={}, range={}, got error in row level repair: {}",
+                    _shard_task.global_repair_id.uuid(), this_shard_id(), _shard_task.get_keyspace(), _cf_name, range, e);
+            // In case the repair process fail, we need to call repair_row_level_stop to clean up repair followers
+            _failed = true;
+            ex = std::current_exception();
+        }
 
-            bool mark_as_repaired = false;
-            if (master.is_incremental_repair() && !_failed) {
-                mark_as_repaired = true;
-            }
+        bool mark_as_repaired = false;
+        if (master.is_incremental_repair() && !_failed) {
+            mark_as_repaired = true;
+        }
 
-            utils::get_local_injector().inject("repair_finish_wait", utils::wait_for_message(300s)).get();
+        utils::get_local_injector().inject("repair_finish_wait", utils::wait_for_message(300s)).get();
 
-            parallel_for_each(nodes_to_stop, coroutine::lambda([&] (repair_node_state& ns) -> future<> {
-                auto node = ns.node;
-                master.set_repair_state(repair_state::row_level_stop_started, node);
-                co_await master.repair_row_level_stop(node, _shard_task.get_keyspace(), _cf_name, _range, ns.shard, mark_as_repaired);
-                master.set_repair_state(repair_state::row_level_stop_finished, node);
-            })).get();
+        parallel_for_each(nodes_to_stop, coroutine::lambda([&] (repair_node_state& ns) -> future<> {
+            auto node = ns.node;
+            master.set_repair_state(repair_state::row_level_stop_started, node);
+            co_await master.repair_row_level_stop(node, _shard_task.get_keyspace(), _cf_name, range, ns.shard, mark_as_repaired);
+            master.set_repair_state(repair_state::row_level_stop_finished, node);
+        })).get();
 
-            _shard_task.update_statistics(master.stats());
-            if (_failed) {
-                if (table_dropped) {
-                    throw replica::no_such_column_family(_shard_task.get_keyspace(),  _cf_name);
-                } else {
-                    throw nested_exception(std::make_exception_ptr(std::runtime_error(fmt::format("Failed to repair for keyspace={}, cf={}, range={}", _shard_task.get_keyspace(),
-                                            _cf_name, _range))), std::move(ex));
-                }
+        _shard_task.update_statistics(master.stats());
+        if (_failed) {
+            if (table_dropped) {
+                throw replica::no_such_column_family(_shard_task.get_keyspace(),  _cf_name);
             } else {
-                update_system_repair_table().get();
+                throw nested_exception(std::make_exception_ptr(std::runtime_error(fmt::format("Failed to repair for keyspace={}, cf={}, range={}", _shard_task.get_keyspace(),
+                                        _cf_name, range))), std::move(ex));
+            }
+        }
+        rlogger.debug("<<< Finished Row Level Repair (Master): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, range={}, tx_hashes_nr={}, rx_hashes_nr={}, tx_row_nr={}, rx_row_nr={}, row_from_disk_bytes={}, row_from_disk_nr={}",
+                master.myhostid(), _all_live_peer_nodes, master.repair_meta_id(), _shard_task.get_keyspace(), _cf_name, range, master.stats().tx_hashes_nr, master.stats().rx_hashes_nr, master.stats().tx_row_nr, master.stats().rx_row_nr, master.stats().row_from_disk_bytes, master.stats().row_from_disk_nr);
+    }
+
+public:
+    future<> run() {
+        return seastar::async([this] {
+            _shard_task.check_in_abort_or_shutdown();
+            bool enable_incremental_repair = incremental_repair_enabled();
+            for (const auto& range : ranges_to_sync(enable_incremental_repair)) {
+                sync_range(range, enable_incremental_repair);
             }
-            rlogger.debug("<<< Finished Row Level Repair (Master): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, range={}, tx_hashes_nr={}, rx_hashes_nr={}, tx_row_nr={}, rx_row_nr={}, row_from_disk_bytes={}, row_from_disk_nr={}",
-                    master.myhostid(), _all_live_peer_nodes, master.repair_meta_id(), _shard_task.get_keyspace(), _cf_name, _range, master.stats().tx_hashes_nr, master.stats().rx_hashes_nr, master.stats().tx_row_nr, master.stats().rx_row_nr, master.stats().row_from_disk_bytes, master.stats().row_from_disk_nr);
+            update_system_repair_table().get();
         });
     }
 };
@@ -118,6 +118,7 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
         utils::updateable_value<float> critical_disk_utilization_level = utils::updateable_value<float>(0.98);
         utils::updateable_value<uint64_t> repair_multishard_reader_buffer_hint_size = utils::updateable_value<uint64_t>(1024 * 1024);
         utils::updateable_value<uint64_t> repair_multishard_reader_enable_read_ahead = utils::updateable_value<uint64_t>(0);
+        utils::updateable_value<bool> repair_range_summaries = utils::updateable_value<bool>(false);
     };
 
 private:
@@ -17,6 +17,7 @@
 #include "locator/tablets.hh"
 #include "locator/token_metadata_fwd.hh"
 #include "replica/logstor/compaction.hh"
+#include "replica/logstor/compression.hh"
 #include "replica/logstor/types.hh"
 #include "utils/log.hh"
 #include "replica/database_fwd.hh"
@@ -386,7 +387,12 @@ static auto configure_sstables_manager(const db::config& cfg, const database_con
         .memory_reclaim_threshold = cfg.components_memory_reclaim_threshold,
         .data_file_directories = cfg.data_file_directories(),
         .format = cfg.sstable_format,
+        .blocked_bloom_filter = cfg.sstable_blocked_bloom_filter,
+        .combined_sstable_filter = cfg.sstable_set_combined_filter,
+        .decompressed_chunk_cache = cfg.cache_decompressed_chunks,
+        .adaptive_compression_chunk_length = cfg.sstable_compression_adaptive_chunk_length,
         .large_data_records_per_sstable = cfg.compaction_large_data_records_per_sstable,
+        .repair_summaries = cfg.sstable_repair_summaries,
         .ignore_component_digest_mismatch = cfg.ignore_component_digest_mismatch(),
         .enable_dangerous_direct_import_of_cassandra_counters = cfg.enable_dangerous_direct_import_of_cassandra_counters(),
     };
@@ -494,6 +500,8 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     setup_metrics();
 
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    _row_cache_tracker.set_admission_filter(_cfg.cache_admission_filter.operator utils::updateable_value<bool>());
+    _row_cache_tracker.get_lru().set_protected_fraction(_cfg.cache_protected_fraction());
 
     setup_scylla_memory_diagnostics_producer();
 }
@@ -966,6 +974,7 @@ database::init_logstor() {
             .file_size = _cfg.logstor_file_size_in_mb() * 1024ull * 1024ull,
             .disk_size = _cfg.logstor_disk_size_in_mb() * 1024ull * 1024ull,
             .format_on_startup = _cfg.logstor_format_on_startup(),
+            .compaction_cold_data_age = std::chrono::seconds(_cfg.logstor_compaction_cold_data_age_in_s()),
             .compaction_sg = _dbcfg.compaction_scheduling_group,
             .compaction_static_shares = _cfg.compaction_static_shares,
             .separator_sg = _dbcfg.memtable_scheduling_group,
@@ -985,6 +994,15 @@ database::init_logstor() {
         (void)flush_logstor_separator(seq_num);
     });
 
+    auto update_record_compression = [this] {
+        logstor::local_record_compression().set_enabled(_cfg.logstor_record_compression() && features().logstor_record_compression);
+    };
+    _logstor_record_compression_feature_listener = features().logstor_record_compression.when_enabled(update_record_compression);
+    _logstor_record_compression_observer.emplace(_cfg.logstor_record_compression.observe([update_record_compression] (bool) {
+        update_record_compression();
+    }));
+    update_record_compression();
+
     dblog.info("logstor initialized");
     co_return;
 }
@@ -1656,6 +1674,7 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.data_listeners = &db.data_listeners();
     cfg.enable_compacting_data_for_streaming_and_repair = db_config.enable_compacting_data_for_streaming_and_repair;
     cfg.enable_tombstone_gc_for_streaming_and_repair = db_config.enable_tombstone_gc_for_streaming_and_repair;
+    cfg.memtable_flush_concurrency = db_config.memtable_flush_concurrency;
     cfg.guardrail_config = db::guardrail_config{
         .partition_size_fail_threshold_mb = db_config.large_partition_fail_threshold_mb,
         .partition_size_warn_threshold_mb = db_config.compaction_large_partition_warning_threshold_mb,
@@ -3046,6 +3065,24 @@ future<> database::flush_logstor_separator(std::optional<logstor::segment_sequen
     });
 }
 
+future<> database::set_logstor_compression_dictionary_on_all_shards(sharded<database>& sharded_db, table_id table, std::span<const std::byte> dict) {
+    return sharded_db.invoke_on_all([table, dict] (replica::database& db) -> future<> {
+        if (!db._logstor) {
+            return make_ready_future<>();
+        }
+        return db._logstor->set_compression_dictionary(table, dict);
+    });
+}
+
+future<> database::add_logstor_compression_dictionary_on_all_shards(sharded<database>& sharded_db, std::vector<std::byte> dict) {
+    co_await sharded_db.invoke_on_all([&dict] (replica::database& db) -> future<> {
+        if (!db._logstor) {
+            return make_ready_future<>();
+        }
+        return db._logstor->add_compression_dictionary(dict);
+    });
+}
+
 future<logstor::table_segment_stats> database::get_logstor_table_segment_stats(table_id table) const {
     return find_column_family(table).get_logstor_segment_stats();
 }
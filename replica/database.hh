@@ -24,6 +24,7 @@
 #include "cell_locking.hh"
 #include "db_clock.hh"
 #include "gc_clock.hh"
+#include <any>
 #include <chrono>
 #include <seastar/core/sharded.hh>
 #include <functional>
@@ -485,6 +486,7 @@ class table : public enable_lw_shared_from_this<table>
         unsigned x_log2_compaction_groups{0};
         utils::updateable_value<bool> enable_compacting_data_for_streaming_and_repair;
         utils::updateable_value<bool> enable_tombstone_gc_for_streaming_and_repair;
+        utils::updateable_value<uint32_t> memtable_flush_concurrency{1};
         db::guardrail_config guardrail_config;
     };
 
@@ -1461,6 +1463,16 @@ class table : public enable_lw_shared_from_this<table>
     // Takes snapshot of current sstable set all compaction groups.
     future<utils::chunked_vector<sstables::shared_sstable>> take_sstable_set_snapshot();
 
+    // The sstables and memtables of all storage groups that overlap with the given
+    // ranges, which the indexes with the 'local' engine are built from, see
+    // replica/local_index.hh. Like for reads, the sstables are taken from the storage
+    // groups, as they might move across compaction groups in the background.
+    struct local_index_sources {
+        std::vector<sstables::shared_sstable> sstables;
+        std::vector<lw_shared_ptr<memtable>> memtables;
+    };
+    local_index_sources get_local_index_sources(const dht::partition_range_vector& ranges) const;
+
     future<utils::chunked_vector<logstor::segment_snapshot>> take_logstor_snapshot(dht::token_range tr);
     future<std::unique_ptr<logstor::segment_stream_sink>> create_logstor_segment_sink(replica::database&);
 
@@ -1778,6 +1790,9 @@ class database : public peering_sharded_service<database>, qos::qos_configuratio
     querier_cache _querier_cache;
 
     std::unique_ptr<logstor::logstor> _logstor;
+    // Record compression is enabled by the config once the cluster feature is enabled.
+    std::any _logstor_record_compression_feature_listener; // gms::feature::listener_registration
+    std::optional<utils::observer<bool>> _logstor_record_compression_observer;
 
     std::unique_ptr<db::large_data_handler> _large_data_handler;
     std::unique_ptr<db::large_data_handler> _nop_large_data_handler;
@@ -2141,6 +2156,13 @@ class database : public peering_sharded_service<database>, qos::qos_configuratio
     static future<> flush_logstor_separator_on_all_shards(sharded<database>& sharded_db);
     future<> flush_logstor_separator(std::optional<logstor::segment_sequence> seq_num = std::nullopt);
     future<logstor::table_segment_stats> get_logstor_table_segment_stats(table_id table) const;
+    static future<> set_logstor_compression_dictionary_on_all_shards(sharded<database>& sharded_db, table_id table, std::span<const std::byte> dict);
+    static future<> add_logstor_compression_dictionary_on_all_shards(sharded<database>& sharded_db, std::vector<std::byte> dict);
+    // Loads the logstor segments and dictionaries of a snapshot of the table that
+    // were copied into its upload directory, and removes them from the directory.
+    // A segment is loaded into the shard that snapshotted it, so the tablets of
+    // the table should still be placed like when the snapshot was taken.
+    static future<> load_logstor_upload_dir(sharded<database>& sharded_db, table_id table);
     size_t get_logstor_memory_usage() const;
 
     static future<db_clock::time_point> get_all_tables_flushed_at(sharded<database>& sharded_db);
@@ -0,0 +1,500 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "replica/local_index.hh"
+
+#include "cql3/functions/vector_similarity_fcts.hh"
+#include "cql3/statements/index_target.hh"
+#include "index/inverted_index.hh"
+#include "index/target_parser.hh"
+#include "index/vector_index.hh"
+#include "partition_slice_builder.hh"
+#include "readers/mutation_reader.hh"
+#include "replica/database.hh"
+#include "types/vector.hh"
+#include "utils/log.hh"
+#include "vector_search/hnsw_index.hh"
+
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/when_all.hh>
+#include <seastar/coroutine/as_future.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+
+namespace replica {
+
+static logging::logger lilogger("local_index");
+
+namespace {
+
+using secondary_index::fulltext::inverted_index;
+using vector_search::hnsw_index;
+
+struct row_key {
+    dht::decorated_key partition;
+    clustering_key_prefix clustering;
+};
+
+// The index of the rows of a single sstable, whose labels (or document ids)
+// are the positions of the keys of the rows in `keys`.
+template <typename Index>
+struct sstable_index {
+    utils::chunked_vector<row_key> keys;
+    Index index;
+};
+
+template <typename Index>
+using sstable_index_ptr = lw_shared_ptr<const sstable_index<Index>>;
+
+// The indexes of the sstables of a local index on this shard.
+template <typename Index>
+struct local_index_state {
+    std::unordered_map<sstables::generation_type, shared_future<sstable_index_ptr<Index>>> sstables;
+    lowres_clock::time_point last_used;
+};
+
+// By the id of the index.
+template <typename Index>
+thread_local std::unordered_map<table_id, local_index_state<Index>> local_indexes;
+
+// The sstable indexes of dropped indexes are dropped once they weren't queried for that long.
+constexpr auto idle_index_expiry = std::chrono::hours(1);
+
+struct vector_index_info {
+    schema_ptr schema;
+    const column_definition* column;
+    vector_dimension_t dimension;
+    cql3::functions::similarity_kernels similarity;
+    hnsw_index::config hnsw;
+};
+
+using vector_index_info_ptr = lw_shared_ptr<const vector_index_info>;
+
+struct fulltext_index_info {
+    schema_ptr schema;
+    const column_definition* column;
+    secondary_index::fulltext::analyzer analyzer;
+};
+
+using fulltext_index_info_ptr = lw_shared_ptr<const fulltext_index_info>;
+
+hnsw_index::config hnsw_config(const index_options_map& options) {
+    hnsw_index::config cfg;
+    auto set = [&] (const char* name, unsigned& value) {
+        if (auto it = options.find(name); it != options.end()) {
+            value = std::stoul(it->second);
+        }
+    };
+    set("maximum_node_connections", cfg.max_node_connections);
+    set("construction_beam_width", cfg.construction_beam_width);
+    set("search_beam_width", cfg.search_beam_width);
+    return cfg;
+}
+
+const column_definition& get_target_column(const schema& s, const index_metadata& im) {
+    auto target = secondary_index::target_parser::get_target_column_name_from_string(
+            im.options().at(cql3::statements::index_target::target_option_name));
+    const auto* column = s.get_column_definition(to_bytes(target));
+    if (!column) {
+        throw std::runtime_error(format("Target column {} of index {} of {}.{} does not exist", target, im.name(), s.ks_name(), s.cf_name()));
+    }
+    return *column;
+}
+
+vector_index_info_ptr get_vector_index_info(schema_ptr s, const index_metadata& im, const column_definition& column) {
+    const auto& options = im.options();
+    auto dimension = static_cast<const vector_type_impl&>(*column.type).get_dimension();
+    auto similarity = cql3::functions::SIMILARITY_FUNCTIONS.at(
+            cql3::functions::function_name::native_function(secondary_index::vector_index::get_cql_similarity_function_name(options)));
+    return make_lw_shared<const vector_index_info>(std::move(s), &column, dimension, similarity, hnsw_config(options));
+}
+
+fulltext_index_info_ptr get_fulltext_index_info(schema_ptr s, const index_metadata& im, const column_definition& column) {
+    auto analyzer = im.options().find("analyzer");
+    return make_lw_shared<const fulltext_index_info>(std::move(s), &column,
+            secondary_index::fulltext::analyzer_from_option(analyzer != im.options().end() ? analyzer->second : "standard"));
+}
+
+query::partition_slice make_column_slice(const schema& s, const column_definition& column, std::vector<query::clustering_range> ranges = {query::clustering_range::make_open_ended_both_sides()}) {
+    return partition_slice_builder(s)
+            .with_no_static_columns()
+            .with_regular_column(column.name())
+            .with_ranges(std::move(ranges))
+            .build();
+}
+
+// Calls `consume` with the key and the value of each row of the reader
+// which has a live cell in `column`. Tombstones are ignored.
+future<> for_each_live_cell(mutation_reader reader, const column_definition& column,
+        noncopyable_function<void(const dht::decorated_key&, const clustering_key_prefix&, atomic_cell_value_view)> consume) {
+    std::exception_ptr ex;
+    try {
+        std::optional<dht::decorated_key> dk;
+        while (auto mf = co_await reader()) {
+            if (mf->is_partition_start()) {
+                dk = mf->as_partition_start().key();
+            } else if (mf->is_clustering_row()) {
+                const auto& cr = mf->as_clustering_row();
+                if (auto cell = cr.cells().find_cell(column.id)) {
+                    auto ac = cell->as_atomic_cell(column);
+                    if (ac.is_live()) {
+                        consume(*dk, cr.key(), ac.value());
+                    }
+                }
+            }
+            co_await coroutine::maybe_yield();
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await reader.close();
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+}
+
+std::vector<float> to_float_vector(bytes_view value, vector_dimension_t dimension) {
+    return cql3::functions::detail::extract_float_vector(bytes(value), dimension);
+}
+
+std::string_view to_text(bytes_view value) {
+    return std::string_view(reinterpret_cast<const char*>(value.data()), value.size());
+}
+
+// Reads the rows of an sstable with a live cell in `column`, passes the value
+// of each to `add`, along with the position of its key in the result.
+// The index built from them is shared by all the queries which need it, so
+// the scan outlives the query which started it, and has no timeout.
+future<utils::chunked_vector<row_key>> scan_sstable(database& db, table& t, schema_ptr s, const column_definition& column, sstables::shared_sstable sst,
+        noncopyable_function<void(size_t, bytes_view)> add) {
+    auto holder = t.async_gate().hold();
+    auto permit = co_await db.obtain_reader_permit(t, "local-index-build", db::no_timeout, {});
+    auto slice = make_column_slice(*s, column);
+    utils::chunked_vector<row_key> keys;
+    lilogger.debug("Building the index of {}", sst->get_filename());
+    co_await for_each_live_cell(sst->make_reader(s, std::move(permit), query::full_partition_range, slice), column,
+            [&] (const dht::decorated_key& dk, const clustering_key_prefix& ck, atomic_cell_value_view value) {
+        // Don't hold up the table's shutdown.
+        if (t.async_gate().is_closed()) {
+            throw gate_closed_exception();
+        }
+        add(keys.size(), to_bytes(value));
+        keys.push_back(row_key{dk, ck});
+    });
+    lilogger.debug("Built the index of {} with {} rows", sst->get_filename(), keys.size());
+    co_return keys;
+}
+
+future<sstable_index_ptr<hnsw_index>> build_vector_sstable_index(database& db, table& t, vector_index_info_ptr info, sstables::shared_sstable sst) {
+    hnsw_index index(info->dimension, info->similarity.native, info->hnsw);
+    auto keys = co_await scan_sstable(db, t, info->schema, *info->column, std::move(sst), [&] (size_t pos, bytes_view value) {
+        index.insert(pos, to_float_vector(value, info->dimension));
+    });
+    co_return make_lw_shared<const sstable_index<hnsw_index>>(std::move(keys), std::move(index));
+}
+
+future<sstable_index_ptr<inverted_index>> build_fulltext_sstable_index(database& db, table& t, fulltext_index_info_ptr info, sstables::shared_sstable sst) {
+    secondary_index::fulltext::inverted_index_builder builder(info->analyzer);
+    auto keys = co_await scan_sstable(db, t, info->schema, *info->column, std::move(sst), [&] (size_t, bytes_view value) {
+        builder.add(to_text(value));
+    });
+    co_return make_lw_shared<const sstable_index<inverted_index>>(std::move(keys), std::move(builder).build());
+}
+
+// Returns the indexes of the sstables, building the missing ones, and drops
+// the indexes of sstables which aren't in the table anymore, e.g. because
+// compaction replaced them.
+template <typename Index>
+future<std::vector<sstable_index_ptr<Index>>> get_sstable_indexes(table& t, const index_metadata& im, const std::vector<sstables::shared_sstable>& sstables,
+        db::timeout_clock::time_point timeout, noncopyable_function<future<sstable_index_ptr<Index>>(sstables::shared_sstable)> build) {
+    auto now = lowres_clock::now();
+    std::erase_if(local_indexes<Index>, [&] (const auto& e) {
+        return e.second.last_used + idle_index_expiry < now;
+    });
+    auto& state = local_indexes<Index>[im.id()];
+    state.last_used = now;
+
+    std::unordered_set<sstables::generation_type> live;
+    t.get_sstable_set().for_each_sstable([&] (const sstables::shared_sstable& sst) {
+        live.insert(sst->generation());
+    });
+    for (const auto& sst : sstables) {
+        live.insert(sst->generation());
+    }
+    std::erase_if(state.sstables, [&] (const auto& e) {
+        return !live.contains(e.first) || e.second.failed();
+    });
+
+    std::vector<future<sstable_index_ptr<Index>>> indexes;
+    indexes.reserve(sstables.size());
+    for (const auto& sst : sstables) {
+        auto it = state.sstables.find(sst->generation());
+        if (it == state.sstables.end()) {
+            it = state.sstables.emplace(sst->generation(), build(sst)).first;
+        }
+        indexes.push_back(it->second.get_future(timeout));
+    }
+    co_return co_await when_all_succeed(indexes.begin(), indexes.end());
+}
+
+bool contains(const schema& s, const dht::partition_range_vector& ranges, const dht::decorated_key& dk) {
+    return std::ranges::any_of(ranges, [&] (const dht::partition_range& r) {
+        return r.contains(dht::ring_position(dk), dht::ring_position_comparator(s));
+    });
+}
+
+// The candidate rows, by partition.
+using candidates_map = std::map<dht::decorated_key, std::set<clustering_key_prefix, clustering_key_prefix::less_compare>, dht::decorated_key::less_comparator>;
+
+void add_candidate(const schema& s, candidates_map& candidates, const dht::decorated_key& dk, const clustering_key_prefix& ck) {
+    auto it = candidates.find(dk);
+    if (it == candidates.end()) {
+        it = candidates.emplace(dk, std::set<clustering_key_prefix, clustering_key_prefix::less_compare>(clustering_key_prefix::less_compare(s))).first;
+    }
+    it->second.insert(ck);
+}
+
+// Adds the k best rows of an index out of the rows of `ranges`. `search(n)`
+// returns the positions of the n best rows of the index. An sstable holds the
+// rows of all of its ranges, so its index is searched for more rows until k
+// of them are in `ranges`.
+template <typename Search>
+void add_index_candidates(const schema& s, candidates_map& candidates, const utils::chunked_vector<row_key>& keys, size_t k,
+        const dht::partition_range_vector& ranges, Search search) {
+    for (size_t n = k; ; n *= 2) {
+        std::vector<size_t> found = search(n);
+        size_t added = 0;
+        for (auto pos : found) {
+            const auto& key = keys[pos];
+            if (contains(s, ranges, key.partition)) {
+                add_candidate(s, candidates, key.partition, key.clustering);
+                if (++added == k) {
+                    return;
+                }
+            }
+        }
+        if (found.size() < n) {
+            return;
+        }
+    }
+}
+
+// Adds the k rows of the memtable which are the most similar to the query,
+// out of the rows of `ranges`.
+future<> add_memtable_candidates(const vector_index_info& info, candidates_map& candidates, memtable& mt, std::span<const float> query, size_t k,
+        const dht::partition_range_vector& ranges, reader_permit permit, tracing::trace_state_ptr trace_state) {
+    const auto& s = *info.schema;
+    // A min-heap of the k most similar rows found so far.
+    std::vector<std::pair<float, row_key>> best;
+    auto cmp = [] (const auto& a, const auto& b) { return a.first > b.first; };
+    auto slice = make_column_slice(s, *info.column);
+    for (const auto& range : ranges) {
+        co_await for_each_live_cell(mt.make_mutation_reader(info.schema, permit, range, slice, trace_state), *info.column,
+                [&] (const dht::decorated_key& dk, const clustering_key_prefix& ck, atomic_cell_value_view value) {
+            auto similarity = info.similarity.native(query, to_float_vector(to_bytes(value), info.dimension));
+            if (best.size() == k) {
+                if (similarity <= best.front().first) {
+                    return;
+                }
+                std::ranges::pop_heap(best, cmp);
+                best.pop_back();
+            }
+            best.emplace_back(similarity, row_key{dk, ck});
+            std::ranges::push_heap(best, cmp);
+        });
+    }
+    for (auto& [similarity, key] : best) {
+        add_candidate(s, candidates, key.partition, key.clustering);
+    }
+}
+
+// The inverted index of the rows of `ranges` in a memtable. Unlike the ones
+// of sstables, it is built by every query, as memtables keep changing.
+future<sstable_index<inverted_index>> index_memtable_text(const fulltext_index_info& info, memtable& mt, const dht::partition_range_vector& ranges,
+        reader_permit permit, tracing::trace_state_ptr trace_state) {
+    secondary_index::fulltext::inverted_index_builder builder(info.analyzer);
+    utils::chunked_vector<row_key> keys;
+    auto slice = make_column_slice(*info.schema, *info.column);
+    for (const auto& range : ranges) {
+        co_await for_each_live_cell(mt.make_mutation_reader(info.schema, permit, range, slice, trace_state), *info.column,
+                [&] (const dht::decorated_key& dk, const clustering_key_prefix& ck, atomic_cell_value_view value) {
+            builder.add(to_text(to_bytes(value)));
+            keys.push_back(row_key{dk, ck});
+        });
+    }
+    co_return sstable_index<inverted_index>{std::move(keys), std::move(builder).build()};
+}
+
+struct candidate_row {
+    partition_key partition;
+    clustering_key_prefix clustering;
+    bytes value;
+};
+
+// Reads the current value of each candidate from the table. The candidates
+// which were deleted or expired since they were indexed are left out.
+future<std::vector<candidate_row>> read_candidates(table& t, schema_ptr s, const column_definition& column, const candidates_map& candidates,
+        reader_permit permit, tracing::trace_state_ptr trace_state) {
+    std::vector<candidate_row> rows;
+    for (const auto& [dk, cks] : candidates) {
+        auto ck_ranges = cks | std::views::transform([] (const clustering_key_prefix& ck) {
+            return query::clustering_range::make_singular(ck);
+        }) | std::ranges::to<std::vector>();
+        auto slice = make_column_slice(*s, column, std::move(ck_ranges));
+        auto pr = dht::partition_range::make_singular(dk);
+        auto reader = t.make_mutation_reader(s, permit, pr, slice, trace_state);
+        auto m = co_await coroutine::as_future(read_mutation_from_mutation_reader(reader));
+        co_await reader.close();
+        auto mopt = m.get();
+        if (!mopt) {
+            continue;
+        }
+        mopt->partition().compact_for_query(*s, dk, gc_clock::now(), slice.row_ranges(*s, dk.key()), false, query::max_rows);
+        for (const rows_entry& e : mopt->partition().clustered_rows()) {
+            if (auto cell = e.row().cells().find_cell(column.id)) {
+                auto ac = cell->as_atomic_cell(column);
+                if (ac.is_live()) {
+                    rows.push_back(candidate_row{dk.key(), e.key(), to_bytes(ac.value())});
+                }
+            }
+        }
+        co_await coroutine::maybe_yield();
+    }
+    co_return rows;
+}
+
+future<local_index_result> search_vector_index(database& db, table& t, const index_metadata& im, vector_index_info_ptr info,
+        const local_index_request& req, const table::local_index_sources& sources, reader_permit permit,
+        tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout) {
+    const auto& s = *info->schema;
+    if (req.vector.size() != info->dimension) {
+        throw std::runtime_error(format("Query vector of dimension {} for index {} of dimension {}", req.vector.size(), req.index_name, info->dimension));
+    }
+
+    auto indexes = co_await get_sstable_indexes<hnsw_index>(t, im, sources.sstables, timeout, [&db, &t, info] (sstables::shared_sstable sst) {
+        return build_vector_sstable_index(db, t, info, std::move(sst));
+    });
+    candidates_map candidates(dht::decorated_key::less_comparator(info->schema));
+    for (const auto& idx : indexes) {
+        add_index_candidates(s, candidates, idx->keys, req.limit, req.ranges, [&] (size_t n) {
+            return idx->index.search(req.vector, n) | std::views::transform(&hnsw_index::result::label) | std::ranges::to<std::vector<size_t>>();
+        });
+        co_await coroutine::maybe_yield();
+    }
+    for (const auto& mt : sources.memtables) {
+        co_await add_memtable_candidates(*info, candidates, *mt, req.vector, req.limit, req.ranges, permit, trace_state);
+    }
+
+    tracing::trace(trace_state, "Reading {} candidate partitions", candidates.size());
+    auto rows = co_await read_candidates(t, info->schema, *info->column, candidates, std::move(permit), std::move(trace_state));
+    // The candidates are scored straight from their serialized vectors, all at once.
+    auto values = rows | std::views::transform([] (const candidate_row& row) { return bytes_view(row.value); }) | std::ranges::to<std::vector<bytes_view>>();
+    std::vector<float> scores(rows.size());
+    info->similarity.batch(req.vector, values, scores);
+    local_index_result result;
+    result.matches.reserve(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        result.matches.push_back(local_index_match{std::move(rows[i].partition), std::move(rows[i].clustering), scores[i]});
+    }
+    merge_local_index_results(result, {}, req.limit);
+    co_return result;
+}
+
+// The documents are scored relative to the statistics of all the sstables and
+// memtables searched on this shard. The other shards and replicas score
+// theirs relative to their own statistics, which are close, but not equal.
+future<local_index_result> search_fulltext_index(database& db, table& t, const index_metadata& im, fulltext_index_info_ptr info,
+        const local_index_request& req, const table::local_index_sources& sources, reader_permit permit,
+        tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout) {
+    const auto& s = *info->schema;
+    auto terms = secondary_index::fulltext::query_terms(req.text, info->analyzer);
+    if (terms.empty()) {
+        co_return local_index_result{};
+    }
+
+    auto indexes = co_await get_sstable_indexes<inverted_index>(t, im, sources.sstables, timeout, [&db, &t, info] (sstables::shared_sstable sst) {
+        return build_fulltext_sstable_index(db, t, info, std::move(sst));
+    });
+    std::vector<sstable_index<inverted_index>> memtable_indexes;
+    for (const auto& mt : sources.memtables) {
+        memtable_indexes.push_back(co_await index_memtable_text(*info, *mt, req.ranges, permit, trace_state));
+    }
+
+    secondary_index::fulltext::corpus_stats stats;
+    for (const auto& idx : indexes) {
+        idx->index.add_stats(stats, terms);
+    }
+    for (const auto& idx : memtable_indexes) {
+        idx.index.add_stats(stats, terms);
+    }
+    candidates_map candidates(dht::decorated_key::less_comparator(info->schema));
+    auto add_candidates = [&] (const sstable_index<inverted_index>& idx) {
+        add_index_candidates(s, candidates, idx.keys, req.limit, req.ranges, [&] (size_t n) {
+            return idx.index.search(terms, n, stats) | std::views::transform(&secondary_index::fulltext::scored_doc::doc)
+                    | std::ranges::to<std::vector<size_t>>();
+        });
+    };
+    for (const auto& idx : indexes) {
+        add_candidates(*idx);
+        co_await coroutine::maybe_yield();
+    }
+    for (const auto& idx : memtable_indexes) {
+        add_candidates(idx);
+        co_await coroutine::maybe_yield();
+    }
+
+    tracing::trace(trace_state, "Reading {} candidate partitions", candidates.size());
+    auto rows = co_await read_candidates(t, info->schema, *info->column, candidates, std::move(permit), std::move(trace_state));
+    local_index_result result;
+    for (auto& row : rows) {
+        auto score = secondary_index::fulltext::bm25_score(terms, secondary_index::fulltext::tokenize(to_text(row.value), info->analyzer), stats);
+        // Zero if the row was overwritten by a document which doesn't match the query.
+        if (score > 0) {
+            result.matches.push_back(local_index_match{std::move(row.partition), std::move(row.clustering), score});
+        }
+    }
+    merge_local_index_results(result, {}, req.limit);
+    co_return result;
+}
+
+} // anonymous namespace
+
+future<local_index_result> search_local_index(database& db, table& t, schema_ptr s, const local_index_request& req,
+        tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout) {
+    auto holder = t.async_gate().hold();
+    auto im = s->all_indices().find(req.index_name);
+    if (im == s->all_indices().end()) {
+        throw std::runtime_error(format("No index {} on {}.{}", req.index_name, s->ks_name(), s->cf_name()));
+    }
+    const auto& column = get_target_column(*s, im->second);
+    if (req.limit == 0) {
+        co_return local_index_result{};
+    }
+
+    auto permit = co_await db.obtain_reader_permit(t, "local-index-search", timeout, trace_state);
+    auto sources = t.get_local_index_sources(req.ranges);
+    tracing::trace(trace_state, "Searching index {} in {} sstables and {} memtables", req.index_name, sources.sstables.size(), sources.memtables.size());
+
+    // Of the indexes with the 'local' engine, only vector indexes are on
+    // vector columns, and fulltext indexes on text ones.
+    if (column.type->is_vector()) {
+        co_return co_await search_vector_index(db, t, im->second, get_vector_index_info(s, im->second, column), req, sources,
+                std::move(permit), std::move(trace_state), timeout);
+    }
+    co_return co_await search_fulltext_index(db, t, im->second, get_fulltext_index_info(s, im->second, column), req, sources,
+            std::move(permit), std::move(trace_state), timeout);
+}
+
+void merge_local_index_results(local_index_result& result, local_index_result other, size_t limit) {
+    std::ranges::move(other.matches, std::back_inserter(result.matches));
+    std::ranges::sort(result.matches, std::greater<>{}, &local_index_match::score);
+    if (result.matches.size() > limit) {
+        result.matches.erase(result.matches.begin() + limit, result.matches.end());
+    }
+}
+
+} // namespace replica
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include "db/timeout_clock.hh"
+#include "dht/i_partitioner_fwd.hh"
+#include "keys/keys.hh"
+#include "schema/schema_fwd.hh"
+#include "tracing/trace_state.hh"
+#include "tracing/tracing.hh"
+
+#include <seastar/core/future.hh>
+
+#include <vector>
+
+// Indexes with the 'local' engine are served by the replicas, from indexes of
+// the data they store, instead of by the Vector Store.
+//
+// Every sstable gets an index of its own, an HNSW index for vector indexes and
+// an inverted index for fulltext ones, built on the shard which owns it by the
+// first query which needs it. As sstables are immutable, so are their indexes:
+// compaction replaces the indexes of its input sstables by the indexes of the
+// sstables it writes. The rows still in memtables are searched exhaustively
+// by every query.
+//
+// An sstable or a memtable can hold a row which was overwritten or deleted
+// by a newer one, so the candidates found in all of them are read again from
+// the table, and ranked by their current values.
+namespace replica {
+
+class database;
+class table;
+
+struct local_index_request {
+    table_schema_version schema_version;
+    sstring index_name;
+    // The query vector of an ANN query.
+    std::vector<float> vector;
+    // The query text of a BM25 query.
+    sstring text;
+    // The number of rows to return.
+    uint32_t limit;
+    // The ranges to search, which the recipient is a replica of.
+    dht::partition_range_vector ranges;
+    std::optional<tracing::trace_info> trace_info;
+};
+
+struct local_index_match {
+    partition_key partition;
+    clustering_key_prefix clustering;
+    // The similarity of the row to the query vector, or its BM25 score for
+    // the query text, higher is better.
+    float score;
+};
+
+struct local_index_result {
+    // In decreasing score order.
+    std::vector<local_index_match> matches;
+};
+
+// Returns the req.limit rows with the best score, out of the rows of
+// req.ranges stored by this shard.
+future<local_index_result> search_local_index(database& db, table& t, schema_ptr s, const local_index_request& req,
+        tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout);
+
+// Merges `other` into `result`, keeping the `limit` matches with the best score.
+void merge_local_index_results(local_index_result& result, local_index_result other, size_t limit);
+
+} // namespace replica
@@ -11,6 +11,7 @@
 #include "utils/chunked_vector.hh"
 #include "write_buffer.hh"
 #include "utils/log_heap.hh"
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include "mutation_writer/token_group_based_splitting_writer.hh"
 
@@ -35,10 +36,26 @@ struct segment_descriptor : public log_heap_hook<segment_descriptor_hist_options
     size_t record_count{0};
     segment_set* owner{nullptr}; // non-owning, set when added to a segment_set
     int ref_count{0};
+    // Approximate age of the data in the segment, in segment sequence numbers.
+    // Set to the sequence number of the segment when it's written, except for
+    // cold segments written by compaction, which inherit the age of the youngest
+    // compacted segment. Used by compaction for choosing victim segments.
+    segment_sequence data_seq{0};
+    // No record in the segment was written after this time. Set to the time the
+    // segment is written by the separator or found by recovery, and inherited
+    // from the compacted segments by the segments written by compaction.
+    // Used by compaction for telling cold records from hot ones, since the
+    // timestamps of the records are set by the clients.
+    seastar::lowres_clock::time_point written_at;
+    // The dictionaries of the compressed records in the segment, released when it's freed.
+    dictionary_refs dictionaries;
 
     void reset(size_t segment_size) noexcept {
         free_space = segment_size;
         record_count = 0;
+        data_seq = segment_sequence{0};
+        written_at = {};
+        dictionaries.release();
     }
 
     size_t net_data_size(size_t segment_size) const noexcept {
@@ -70,7 +87,15 @@ struct segment_set {
     segment_descriptor_hist _segments;
     size_t _segment_count{0};
 
+    // Net data bytes written into the set's segments, for tracking write amplification.
+    // The separator writes each record once when it's placed in the compaction group,
+    // and any further writes are rewrites by compaction.
+    uint64_t _separator_data_bytes_written{0};
+    uint64_t _compaction_data_bytes_written{0};
+
     future<> merge(segment_set& other) {
+        _separator_data_bytes_written += std::exchange(other._separator_data_bytes_written, 0);
+        _compaction_data_bytes_written += std::exchange(other._compaction_data_bytes_written, 0);
         while (!other._segments.empty()) {
             auto& desc = other._segments.one_of_largest();
             other._segments.erase(desc);
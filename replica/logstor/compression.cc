@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#define ZSTD_STATIC_LINKING_ONLY
+#include <zstd.h>
+
+#include "replica/logstor/compression.hh"
+
+#include <algorithm>
+#include <ranges>
+
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/on_internal_error.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/coroutine/exception.hh>
+#include <seastar/util/file.hh>
+#include <seastar/util/log.hh>
+
+#include "schema/schema.hh"
+#include "utils/crc.hh"
+#include "utils/lister.hh"
+
+namespace replica::logstor {
+
+extern seastar::logger logstor_logger;
+
+static constexpr int compression_level = 1;
+// Payloads smaller than this rarely get smaller even with a dictionary.
+static constexpr size_t min_compressed_payload_size = 32;
+static constexpr std::string_view dictionary_file_prefix = "ls_dict-";
+static constexpr std::string_view dictionary_file_suffix = ".zstd";
+
+class record_dictionary {
+    dictionary_id _id;
+    std::vector<std::byte> _data;
+    std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> _cdict{nullptr, ZSTD_freeCDict};
+    std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)> _ddict{nullptr, ZSTD_freeDDict};
+public:
+    explicit record_dictionary(std::span<const std::byte> data)
+        : _id(id_of(data))
+        , _data(data.begin(), data.end())
+        , _cdict(ZSTD_createCDict(_data.data(), _data.size(), compression_level), ZSTD_freeCDict)
+        , _ddict(ZSTD_createDDict(_data.data(), _data.size()), ZSTD_freeDDict)
+    {
+        if (!_cdict || !_ddict) {
+            throw std::bad_alloc();
+        }
+    }
+
+    dictionary_id id() const noexcept { return _id; }
+    std::span<const std::byte> data() const noexcept { return _data; }
+    const ZSTD_CDict* cdict() const noexcept { return _cdict.get(); }
+    const ZSTD_DDict* ddict() const noexcept { return _ddict.get(); }
+
+    static dictionary_id id_of(std::span<const std::byte> data) {
+        utils::crc32 c;
+        c.process(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        // 0 is reserved for "no dictionary"
+        return std::max<dictionary_id>(c.get(), 1);
+    }
+};
+
+static ZSTD_CCtx* local_cctx() {
+    static thread_local auto cctx = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    return cctx.get();
+}
+
+static ZSTD_DCtx* local_dctx() {
+    static thread_local auto dctx = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    return dctx.get();
+}
+
+record_compression& local_record_compression() {
+    static thread_local record_compression instance;
+    return instance;
+}
+
+record_compression::~record_compression() = default;
+
+std::filesystem::path record_compression::dictionary_path(dictionary_id id) const {
+    return _dir / fmt::format("{}{:08x}{}", dictionary_file_prefix, id, dictionary_file_suffix);
+}
+
+future<> record_compression::start(std::filesystem::path dir) {
+    _dir = std::move(dir);
+
+    std::vector<std::filesystem::path> files;
+    co_await lister::scan_dir(_dir, lister::dir_entry_types::of<directory_entry_type::regular>(),
+            [&files] (fs::path dir, directory_entry de) {
+        if (is_dictionary_file_name(de.name)) {
+            files.push_back(dir / de.name);
+        }
+        return make_ready_future<>();
+    });
+
+    for (const auto& path : files) {
+        auto content = co_await seastar::util::read_entire_file_contiguous(path);
+        auto dict = make_lw_shared<const record_dictionary>(std::as_bytes(std::span(content.data(), content.size())));
+        if (dictionary_path(dict->id()) != path) {
+            logstor_logger.warn("Ignoring logstor dictionary file {} with mismatching content", path.string());
+            continue;
+        }
+        _dictionaries.emplace(dict->id(), std::move(dict));
+    }
+    logstor_logger.debug("Loaded {} logstor compression dictionaries", _dictionaries.size());
+
+    // The dictionaries set before, e.g. when loading the group0 snapshot, can be persisted now.
+    _started = true;
+    auto pending = std::exchange(_pending_table_dictionaries, {});
+    for (const auto& [table, data] : pending) {
+        co_await set_table_dictionary(table, data);
+    }
+
+    // The recovered segments reference all the dictionaries their records need.
+    auto ids = _dictionaries | std::views::keys | std::ranges::to<std::vector<dictionary_id>>();
+    for (auto id : ids) {
+        maybe_remove_dictionary(id);
+    }
+}
+
+future<> record_compression::stop() {
+    co_await _gate.close();
+}
+
+bool record_compression::is_table_dictionary(dictionary_id id) const noexcept {
+    return std::ranges::any_of(_table_dictionaries | std::views::values, [id] (const auto& dict) {
+        return dict->id() == id;
+    });
+}
+
+bool record_compression::has_dictionary(dictionary_id id) const noexcept {
+    // Before start(), the segments of the shard may not have been recovered yet.
+    return !_started || _dictionaries.contains(id);
+}
+
+void record_compression::ref_dictionary(dictionary_id id) {
+    _dictionary_refs[id]++;
+}
+
+void record_compression::unref_dictionary(dictionary_id id) noexcept {
+    auto it = _dictionary_refs.find(id);
+    if (it == _dictionary_refs.end()) {
+        on_internal_error_noexcept(logstor_logger, format("Releasing unreferenced compression dictionary {}", id));
+        return;
+    }
+    if (--it->second == 0) {
+        _dictionary_refs.erase(it);
+        maybe_remove_dictionary(id);
+    }
+}
+
+void record_compression::maybe_remove_dictionary(dictionary_id id) noexcept {
+    if (!_started || _dictionary_refs.contains(id) || is_table_dictionary(id) || !_dictionaries.erase(id)) {
+        return;
+    }
+    logstor_logger.debug("Dropped unused compression dictionary {}", id);
+
+    if (_gate.is_closed()) {
+        return;
+    }
+    // Other shards may still use the dictionary, and only shard 0 removes files.
+    (void)with_gate(_gate, [id] {
+        return smp::submit_to(0, [id] {
+            return local_record_compression().remove_dictionary_file(id);
+        });
+    }).handle_exception([id] (std::exception_ptr ex) {
+        logstor_logger.warn("Failed to remove compression dictionary {}: {}", id, ex);
+    });
+}
+
+future<> record_compression::remove_dictionary_file(dictionary_id id) {
+    auto units = co_await get_units(_files_lock, 1);
+    for (unsigned shard = 0; shard < smp::count; ++shard) {
+        if (co_await smp::submit_to(shard, [id] { return local_record_compression().has_dictionary(id); })) {
+            co_return;
+        }
+    }
+    auto path = dictionary_path(id);
+    if (!co_await file_exists(path.string())) {
+        co_return;
+    }
+    co_await remove_file(path.string());
+    co_await sync_directory(_dir.string());
+    logstor_logger.info("Removed unused compression dictionary {}", id);
+}
+
+future<lw_shared_ptr<const record_dictionary>> record_compression::persist_dictionary(std::span<const std::byte> data) {
+    auto id = record_dictionary::id_of(data);
+    if (auto it = _dictionaries.find(id); it != _dictionaries.end()) {
+        if (!std::ranges::equal(it->second->data(), data)) {
+            logstor_logger.warn("Not using compression dictionary: id {} collides with an existing dictionary", id);
+            co_return nullptr;
+        }
+        co_return it->second;
+    }
+
+    auto dict = make_lw_shared<const record_dictionary>(data);
+
+    // Persist the dictionary before any record that references it is written.
+    // Each shard writes its own temporary file, and they all have the same content.
+    auto path = dictionary_path(id);
+    auto tmp_path = fmt::format("{}.{}.tmp", path.string(), this_shard_id());
+    auto f = co_await open_file_dma(tmp_path, open_flags::wo | open_flags::create | open_flags::truncate);
+    auto out = co_await make_file_output_stream(std::move(f));
+    std::exception_ptr ex;
+    try {
+        co_await out.write(reinterpret_cast<const char*>(dict->data().data()), dict->data().size());
+        co_await out.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await out.close();
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    // The dictionary is added under the lock of the files so that shard 0 doesn't
+    // remove the file after it's renamed and before the dictionary is used.
+    auto shard = this_shard_id();
+    co_await smp::submit_to(0, [&, shard] {
+        return with_semaphore(local_record_compression()._files_lock, 1, [&, shard] {
+            return smp::submit_to(shard, [&] {
+                return rename_file(tmp_path, path.string()).then([&] {
+                    return sync_directory(_dir.string());
+                }).then([&] {
+                    dict = _dictionaries.emplace(id, std::move(dict)).first->second;
+                });
+            });
+        });
+    });
+    co_return dict;
+}
+
+future<> record_compression::set_table_dictionary(table_id table, std::span<const std::byte> data) {
+    if (!_started) {
+        if (data.empty()) {
+            _pending_table_dictionaries.erase(table);
+        } else {
+            _pending_table_dictionaries[table] = std::vector<std::byte>(data.begin(), data.end());
+        }
+        co_return;
+    }
+
+    lw_shared_ptr<const record_dictionary> dict;
+    if (!data.empty()) {
+        dict = co_await persist_dictionary(data);
+        if (!dict) {
+            co_return;
+        }
+    }
+
+    lw_shared_ptr<const record_dictionary> previous;
+    if (auto it = _table_dictionaries.find(table); it != _table_dictionaries.end()) {
+        previous = std::exchange(it->second, dict);
+        if (!dict) {
+            _table_dictionaries.erase(it);
+        }
+    } else if (dict) {
+        _table_dictionaries.emplace(table, dict);
+    }
+    if (dict) {
+        logstor_logger.info("Using compression dictionary {} of size {} for table {}", dict->id(), data.size(), table);
+    }
+    if (previous) {
+        maybe_remove_dictionary(previous->id());
+    }
+}
+
+future<> record_compression::add_dictionary(std::span<const std::byte> data) {
+    if (!_started) {
+        throw std::runtime_error("Can't add a logstor compression dictionary before logstor is started");
+    }
+    co_await persist_dictionary(data);
+}
+
+std::vector<std::filesystem::path> record_compression::dictionary_files() const {
+    return _dictionaries | std::views::keys | std::views::transform([this] (dictionary_id id) {
+        return dictionary_path(id);
+    }) | std::ranges::to<std::vector<std::filesystem::path>>();
+}
+
+bool is_dictionary_file_name(std::string_view name) noexcept {
+    return name.starts_with(dictionary_file_prefix) && name.ends_with(dictionary_file_suffix);
+}
+
+bool record_compression::enabled_for(const schema& s) const {
+    if (!_enabled) {
+        return false;
+    }
+    auto algorithm = s.get_compressor_params().get_algorithm();
+    return algorithm == compression_parameters::algorithm::zstd
+        || algorithm == compression_parameters::algorithm::zstd_with_dicts;
+}
+
+void dictionary_refs::add(dictionary_id id) {
+    if (id == 0 || std::ranges::contains(_ids, id)) {
+        return;
+    }
+    _ids.reserve(_ids.size() + 1);
+    local_record_compression().ref_dictionary(id);
+    _ids.push_back(id);
+}
+
+void dictionary_refs::add(const dictionary_refs& o) {
+    for (auto id : o._ids) {
+        add(id);
+    }
+}
+
+void dictionary_refs::release() noexcept {
+    for (auto id : std::exchange(_ids, {})) {
+        local_record_compression().unref_dictionary(id);
+    }
+}
+
+dictionary_id compressed_dictionary_id(bytes_view compressed) noexcept {
+    if (compressed.size() < compressed_header_size) {
+        return 0;
+    }
+    return read_le<uint32_t>(reinterpret_cast<const char*>(compressed.data()) + sizeof(uint32_t));
+}
+
+std::optional<bytes> record_compression::compress(const schema& s, bytes_view payload) {
+    if (payload.size() < min_compressed_payload_size || payload.size() > max_uncompressed_record_size) {
+        _stats.records_not_compressed++;
+        return std::nullopt;
+    }
+
+    const record_dictionary* dict = nullptr;
+    if (s.get_compressor_params().uses_dictionary_compressor()) {
+        if (auto it = _table_dictionaries.find(s.id()); it != _table_dictionaries.end()) {
+            dict = it->second.get();
+        }
+    }
+
+    bytes out(bytes::initialized_later(), compressed_header_size + ZSTD_compressBound(payload.size()));
+    auto* dst = reinterpret_cast<char*>(out.data()) + compressed_header_size;
+    auto dst_size = out.size() - compressed_header_size;
+    size_t ret = dict
+        ? ZSTD_compress_usingCDict(local_cctx(), dst, dst_size, payload.data(), payload.size(), dict->cdict())
+        : ZSTD_compressCCtx(local_cctx(), dst, dst_size, payload.data(), payload.size(), compression_level);
+    if (ZSTD_isError(ret)) {
+        throw std::runtime_error(fmt::format("ZSTD compression failure: {}", ZSTD_getErrorName(ret)));
+    }
+
+    auto compressed_size = compressed_header_size + ret;
+    if (compressed_size >= payload.size()) {
+        _stats.records_not_compressed++;
+        return std::nullopt;
+    }
+
+    write_le<uint32_t>(reinterpret_cast<char*>(out.data()), payload.size());
+    write_le<uint32_t>(reinterpret_cast<char*>(out.data()) + sizeof(uint32_t), dict ? dict->id() : 0);
+    out.resize(compressed_size);
+
+    _stats.records_compressed++;
+    _stats.bytes_before_compression += payload.size();
+    _stats.bytes_after_compression += compressed_size;
+    return out;
+}
+
+bytes record_compression::decompress(bytes_view compressed) {
+    if (compressed.size() < compressed_header_size) {
+        throw std::runtime_error(fmt::format("Truncated compressed log record of size {}", compressed.size()));
+    }
+    auto uncompressed_size = read_le<uint32_t>(reinterpret_cast<const char*>(compressed.data()));
+    auto id = read_le<uint32_t>(reinterpret_cast<const char*>(compressed.data()) + sizeof(uint32_t));
+    compressed.remove_prefix(compressed_header_size);
+
+    // Don't trust the size before allocating for it.
+    if (uncompressed_size > max_uncompressed_record_size) {
+        throw std::runtime_error(fmt::format("Compressed log record size {} exceeds the maximum {}", uncompressed_size, max_uncompressed_record_size));
+    }
+    auto frame_content_size = ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+    if (frame_content_size != uncompressed_size) {
+        throw std::runtime_error(fmt::format("Compressed log record size {} doesn't match the size of its frame {}", uncompressed_size, frame_content_size));
+    }
+
+    const ZSTD_DDict* ddict = nullptr;
+    if (id != 0) {
+        auto it = _dictionaries.find(id);
+        if (it == _dictionaries.end()) {
+            throw std::runtime_error(fmt::format("Log record compressed with unknown dictionary {}", id));
+        }
+        ddict = it->second->ddict();
+    }
+
+    bytes out(bytes::initialized_later(), uncompressed_size);
+    size_t ret = ddict
+        ? ZSTD_decompress_usingDDict(local_dctx(), out.data(), out.size(), compressed.data(), compressed.size(), ddict)
+        : ZSTD_decompressDCtx(local_dctx(), out.data(), out.size(), compressed.data(), compressed.size());
+    if (ZSTD_isError(ret)) {
+        throw std::runtime_error(fmt::format("ZSTD decompression failure: {}", ZSTD_getErrorName(ret)));
+    }
+    if (ret != uncompressed_size) {
+        throw std::runtime_error(fmt::format("Decompressed log record size {} doesn't match the expected size {}", ret, uncompressed_size));
+    }
+    _stats.records_decompressed++;
+    return out;
+}
+
+} // namespace replica::logstor
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_ptr.hh>
+#include "bytes.hh"
+#include "schema/schema_fwd.hh"
+
+namespace replica::logstor {
+
+// Compression of log record payloads.
+//
+// Records are compressed individually so that they stay addressable by their
+// log_location, and only the serialized mutation is compressed. The record header
+// is kept uncompressed since it's read by segment scans during compaction and recovery.
+//
+// Small records compress poorly on their own, so a table may have a zstd dictionary
+// trained on its data. Dictionaries are identified by a hash of their content,
+// which is stored with each compressed record, and are persisted in the logstor
+// directory so that records remain readable after a restart even when the table's
+// dictionary is replaced.
+//
+// A dictionary is kept for as long as it's the dictionary of a table or records
+// compressed with it may still be read. Every segment, write buffer and record writer
+// holding such records references the dictionary through dictionary_refs. Once a
+// dictionary is unused on a shard it's dropped from the shard's memory, and its file
+// is removed once it's unused on all shards.
+//
+// Compressed records can't be read by nodes that don't support the
+// LOGSTOR_RECORD_COMPRESSION cluster feature, so records are written compressed
+// only after the feature is enabled, and only when logstor_record_compression is set.
+//
+// The layout of a compressed payload is:
+//   uint32_t uncompressed_size
+//   uint32_t dictionary_id         // 0 when compressed without a dictionary
+//   zstd frame
+
+using dictionary_id = uint32_t;
+
+static constexpr size_t compressed_header_size = 2 * sizeof(uint32_t);
+
+// Records whose data is larger than this are not compressed, and compressed
+// records claiming to be larger are rejected as corrupt.
+static constexpr size_t max_uncompressed_record_size = 128 * 1024 * 1024;
+
+class record_dictionary;
+
+class record_compression {
+public:
+    struct stats {
+        uint64_t records_compressed{0};
+        uint64_t records_not_compressed{0};
+        uint64_t bytes_before_compression{0};
+        uint64_t bytes_after_compression{0};
+        uint64_t records_decompressed{0};
+    };
+
+private:
+    std::unordered_map<dictionary_id, lw_shared_ptr<const record_dictionary>> _dictionaries;
+    // The number of references to each dictionary, by segments, write buffers and
+    // record writers of this shard. Counted also before start(), by recovery.
+    std::unordered_map<dictionary_id, uint64_t> _dictionary_refs;
+    std::unordered_map<table_id, lw_shared_ptr<const record_dictionary>> _table_dictionaries;
+    // Dictionaries set before start(), which can't be persisted yet, and so aren't used yet.
+    std::unordered_map<table_id, std::vector<std::byte>> _pending_table_dictionaries;
+    std::filesystem::path _dir;
+    bool _started = false;
+    bool _enabled = false;
+    stats _stats;
+    seastar::gate _gate;
+    // Serializes adding and removing dictionary files. Used on shard 0 only.
+    semaphore _files_lock{1};
+
+    std::filesystem::path dictionary_path(dictionary_id) const;
+    future<lw_shared_ptr<const record_dictionary>> persist_dictionary(std::span<const std::byte>);
+    bool is_table_dictionary(dictionary_id) const noexcept;
+    // Whether the dictionary may still be needed on this shard.
+    bool has_dictionary(dictionary_id) const noexcept;
+    // Drops the dictionary if it's unused on this shard, and removes its file in
+    // the background if it's unused on all shards.
+    void maybe_remove_dictionary(dictionary_id) noexcept;
+    future<> remove_dictionary_file(dictionary_id);
+
+public:
+    record_compression() = default;
+    ~record_compression();
+
+    // Loads all persisted dictionaries from the given directory, and persists
+    // dictionaries added later to it, including the ones set before start().
+    // Dictionaries which are unused once the segments were recovered are removed.
+    future<> start(std::filesystem::path dir);
+
+    // Waits for the background removal of dictionary files.
+    future<> stop();
+
+    // Sets the dictionary used for compressing the table's records. The dictionary
+    // is persisted before it's used, so before start() it's only remembered. An empty
+    // dictionary stops using a dictionary for the table, but records that were
+    // compressed with the previous one remain readable.
+    future<> set_table_dictionary(table_id, std::span<const std::byte> dict);
+
+    // Persists a dictionary which records may be compressed with, without using
+    // it for compression, e.g. one received with segments streamed from another node.
+    future<> add_dictionary(std::span<const std::byte> dict);
+
+    void ref_dictionary(dictionary_id);
+    void unref_dictionary(dictionary_id) noexcept;
+
+    // The files of the dictionaries used by this shard.
+    std::vector<std::filesystem::path> dictionary_files() const;
+
+    // Enables compressing records. Compressed records are always readable.
+    void set_enabled(bool enabled) noexcept { _enabled = enabled; }
+
+    // Returns the compressed payload, or nullopt if compression doesn't make the payload smaller.
+    std::optional<bytes> compress(const schema&, bytes_view payload);
+
+    bytes decompress(bytes_view compressed);
+
+    const stats& get_stats() const noexcept { return _stats; }
+
+    // Whether records of the table should be compressed, once compression is enabled.
+    // Records are compressed with zstd, so only tables which use zstd are compressed.
+    bool enabled_for(const schema&) const;
+};
+
+// References to the dictionaries of a set of compressed records, which keep the
+// dictionaries of the local_record_compression() from being removed.
+class dictionary_refs {
+    std::vector<dictionary_id> _ids;
+public:
+    dictionary_refs() = default;
+    dictionary_refs(dictionary_refs&& o) noexcept : _ids(std::exchange(o._ids, {})) {}
+    dictionary_refs& operator=(dictionary_refs&& o) noexcept {
+        if (this != &o) {
+            release();
+            _ids = std::exchange(o._ids, {});
+        }
+        return *this;
+    }
+    ~dictionary_refs() { release(); }
+
+    // Adds a reference to the dictionary, unless there's one already.
+    // The id 0, of records compressed without a dictionary, is ignored.
+    void add(dictionary_id);
+    void add(const dictionary_refs&);
+    void release() noexcept;
+
+    const std::vector<dictionary_id>& ids() const noexcept { return _ids; }
+};
+
+// The dictionary a compressed payload was compressed with, or 0 if none.
+dictionary_id compressed_dictionary_id(bytes_view compressed) noexcept;
+
+// Whether the file name is that of a persisted dictionary.
+bool is_dictionary_file_name(std::string_view name) noexcept;
+
+// The record compression of the current shard, used for compressing records when
+// they're serialized and decompressing them when they're deserialized.
+record_compression& local_record_compression();
+
+} // namespace replica::logstor
@@ -13,11 +13,13 @@
 #include "query/query-request.hh"
 #include "readers/from_mutations.hh"
 #include "keys/keys.hh"
+#include "replica/logstor/compression.hh"
 #include "replica/logstor/segment_manager.hh"
 #include "replica/logstor/types.hh"
 #include "utils/managed_bytes.hh"
 #include <openssl/ripemd.h>
 #include <openssl/evp.h>
+#include <deque>
 
 namespace replica::logstor {
 
@@ -43,7 +45,8 @@ static api::timestamp_type extract_logstor_record_timestamp(const mutation& m) {
 }
 
 logstor::logstor(logstor_config config, ::cache_tracker& shared_cache_tracker)
-    : _segment_manager(config.segment_manager_cfg)
+    : _base_dir(config.segment_manager_cfg.base_dir)
+    , _segment_manager(config.segment_manager_cfg)
     , _write_buffer(buffered_writer_config{
             .buffer_size = _segment_manager.get_segment_size(),
             .ring_size = config.write_buffer_ring_size,
@@ -59,11 +62,23 @@ logstor::logstor(logstor_config config, ::cache_tracker& shared_cache_tracker)
                        sm::description("Number of writes currently queued in the write buffer.")),
         sm::make_counter("write_failures", [this] { return _stats.write_failures; },
                        sm::description("Number of writes that failed to be persisted.")),
+        sm::make_counter("records_compressed", [] { return local_record_compression().get_stats().records_compressed; },
+                       sm::description("Number of records written compressed.")),
+        sm::make_counter("records_not_compressed", [] { return local_record_compression().get_stats().records_not_compressed; },
+                       sm::description("Number of records of tables with compression enabled that were written uncompressed because compression didn't make them smaller.")),
+        sm::make_counter("compression_input_bytes", [] { return local_record_compression().get_stats().bytes_before_compression; },
+                       sm::description("Size of the data of compressed records before compression.")),
+        sm::make_counter("compression_output_bytes", [] { return local_record_compression().get_stats().bytes_after_compression; },
+                       sm::description("Size of the data of compressed records after compression.")),
+        sm::make_counter("records_decompressed", [] { return local_record_compression().get_stats().records_decompressed; },
+                       sm::description("Number of compressed records read.")),
     });
 }
 
 future<> logstor::do_recovery(replica::database& db) {
     co_await _segment_manager.do_recovery(db);
+    // the dictionaries are needed only for reading record data, and recovery reads only record headers.
+    co_await local_record_compression().start(_base_dir);
 }
 
 future<> logstor::start() {
@@ -84,6 +99,7 @@ future<> logstor::stop() {
     co_await _async_gate.close();
     co_await _write_buffer.stop();
     co_await _segment_manager.stop();
+    co_await local_record_compression().stop();
 
     logstor_logger.info("logstor stopped");
 }
@@ -134,7 +150,7 @@ future<> logstor::write(const mutation& m, compaction_group& cg, seastar::gate::
         .mut = canonical_mutation(m)
     };
 
-    auto writer = log_record_writer(std::move(record));
+    auto writer = log_record_writer(std::move(record), *m.schema());
 
     auto result_f = co_await coroutine::as_future(_write_buffer.write(std::move(writer), timeout, &cg, std::move(cg_holder)));
     if (result_f.failed()){
@@ -149,6 +165,26 @@ future<> logstor::write(const mutation& m, compaction_group& cg, seastar::gate::
     index.insert(key, std::move(new_entry));
 }
 
+// Converts a record read from `location` for the key `dk` into a mutation, and
+// populates the cache with it, unless the key was overwritten while we read.
+// We must re-find the entry since the iterator may have been invalidated while we read.
+static mutation record_to_mutation(const schema& s, const primary_index& index, cache_tracker* cache,
+        const dht::decorated_key& dk, log_location location, log_record& record) {
+    if (record.mut.key() != dk.key()) [[unlikely]] {
+        on_internal_error(logstor_logger, format("Key mismatch reading log entry: expected {}, got {}", dk.key(), record.mut.key()));
+    }
+
+    mutation m = record.mut.to_mutation(s.shared_from_this());
+
+    if (cache) {
+        auto it = index.find(dk);
+        if (it != index.end() && it->entry().location == location) {
+            cache->populate(*it, m);
+        }
+    }
+    return m;
+}
+
 future<std::optional<mutation>> logstor::read(const schema& s, const primary_index& index, const dht::decorated_key& dk, const query::partition_slice& slice) {
     auto gate_holder = _async_gate.hold();
 
@@ -175,36 +211,80 @@ future<std::optional<mutation>> logstor::read(const schema& s, const primary_ind
     const index_entry entry_for_read = it->entry();
     auto record = co_await _segment_manager.read(entry_for_read.location);
 
-    if (record.mut.key() != dk.key()) [[unlikely]] {
-        on_internal_error(logstor_logger, format("Key mismatch reading log entry: expected {}, got {}", dk.key(), record.mut.key()));
-    }
+    co_return record_to_mutation(s, index, cache, dk, entry_for_read.location, record);
+}
 
-    mutation m = record.mut.to_mutation(s.shared_from_this());
+future<std::vector<std::optional<mutation>>> logstor::read_many(const schema& s, const primary_index& index,
+        std::vector<dht::decorated_key> keys, const query::partition_slice& slice, reader_permit permit) {
+    auto gate_holder = _async_gate.hold();
 
-    // Populate the cache with the freshly deserialized mutation.
-    // Skipped when bypass_cache is set.
-    // We must re-find the entry because the iterator may have been invalidated
-    // across the co_await above.
-    if (cache) {
-        auto it = index.find(dk);
-        if (it != index.end() && it->entry().location == entry_for_read.location) {
-            cache->populate(*it, m);
+    auto op = index.start_read();
+
+    const auto bypass_cache = slice.options.contains(query::partition_slice::option::bypass_cache);
+    auto* cache = bypass_cache ? nullptr : index.cache_tracker();
+
+    std::vector<std::optional<mutation>> result(keys.size());
+
+    // Look up all keys first and collect the locations of the cache misses.
+    // The entries are copied since they may change while we read.
+    std::vector<size_t> missed;
+    std::vector<log_location> locations;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto it = index.find(keys[i]);
+        if (it == index.end()) {
+            continue;
         }
+        if (cache) {
+            auto cached_mut = cache->lookup(*it, s.shared_from_this());
+            if (cached_mut) {
+                result[i] = std::move(*cached_mut);
+                continue;
+            }
+        }
+        missed.push_back(i);
+        locations.push_back(it->entry().location);
     }
 
-    co_return std::move(m);
+    if (locations.empty()) {
+        co_return std::move(result);
+    }
+
+    auto records = co_await _segment_manager.read_many(locations, std::move(permit));
+
+    for (size_t j = 0; j < missed.size(); ++j) {
+        result[missed[j]] = record_to_mutation(s, index, cache, keys[missed[j]], locations[j], records[j]);
+    }
+
+    co_return std::move(result);
 }
 
+// Reads the partitions of a range in batches of consecutive keys. The records of a
+// batch are read with I/O sorted by their location on disk and coalesced, and the
+// next batch is read ahead while the current one is consumed, so that scanning
+// large ranges is bound by sequential disk throughput rather than by random reads.
 mutation_reader logstor::make_reader(schema_ptr schema, const primary_index& index, reader_permit permit, const dht::partition_range& pr,
         const query::partition_slice& slice, tracing::trace_state_ptr trace_state) {
 
     class logstor_range_reader : public mutation_reader::impl {
+        // Limits on the size of a batch of keys read together.
+        static constexpr size_t max_batch_keys = 256;
+        static constexpr size_t max_batch_bytes = 1024 * 1024;
+
+        using batch = std::vector<std::optional<mutation>>;
+
         logstor* _logstor;
         const primary_index& _index;
         dht::partition_range _pr;
         query::partition_slice _slice;
         tracing::trace_state_ptr _trace_state;
-        std::optional<dht::decorated_key> _last_key; // owns the key, safe across yields
+        std::optional<dht::decorated_key> _last_key; // last key added to a batch, owns the key, safe across yields
+        bool _index_exhausted = false;
+        std::optional<future<batch>> _read_ahead;
+        std::deque<mutation> _ready;
+        // The memory of the batch being read ahead and of the ready one, estimated
+        // by the size of their records, is charged to the permit.
+        reader_permit::resource_units _read_ahead_units;
+        reader_permit::resource_units _ready_units;
         mutation_reader_opt _current_partition_reader;
         dht::ring_position_comparator _cmp;
 
@@ -236,6 +316,50 @@ mutation_reader logstor::make_reader(schema_ptr schema, const primary_index& ind
             return _pr.end()->is_inclusive() ? c > 0 : c >= 0;
         }
 
+        // Collects the next keys of the range from the index, without yielding,
+        // and starts reading them.
+        void start_next_batch() {
+            std::vector<dht::decorated_key> keys;
+            size_t bytes = 0;
+            for (auto it = find_next(); it != _index.end() && !exceeds_range_end(*it); ++it) {
+                if (keys.size() >= max_batch_keys || bytes >= max_batch_bytes) {
+                    break;
+                }
+                keys.push_back(it->key());
+                bytes += it->entry().location.size;
+            }
+            if (keys.empty()) {
+                _index_exhausted = true;
+                return;
+            }
+            _last_key = keys.back();
+            tracing::trace(_trace_state, "logstor_range_reader: reading {} keys starting at {}", keys.size(), keys.front());
+            _read_ahead_units.reset_to(reader_resources::with_memory(bytes));
+            _read_ahead = _logstor->read_many(*_schema, _index, std::move(keys), _slice, _permit);
+        }
+
+        future<> discard_read_ahead() noexcept {
+            if (!_read_ahead) {
+                return make_ready_future<>();
+            }
+            auto f = std::move(*_read_ahead);
+            _read_ahead = std::nullopt;
+            return f.discard_result().handle_exception([] (std::exception_ptr) {}).finally([this] {
+                _read_ahead_units.reset_to_zero();
+            });
+        }
+
+        future<> reset() noexcept {
+            _ready.clear();
+            _ready_units.reset_to_zero();
+            auto f = discard_read_ahead();
+            if (_current_partition_reader) {
+                f = when_all_succeed(std::move(f), _current_partition_reader->close()).discard_result();
+                _current_partition_reader = std::nullopt;
+            }
+            return f;
+        }
+
     public:
         logstor_range_reader(schema_ptr s, const primary_index& idx, reader_permit p,
                     logstor* ls, dht::partition_range pr,
@@ -243,6 +367,8 @@ mutation_reader logstor::make_reader(schema_ptr schema, const primary_index& ind
             : impl(std::move(s), std::move(p))
             , _logstor(ls), _index(idx), _pr(std::move(pr))
             , _slice(std::move(slice)), _trace_state(std::move(ts))
+            , _read_ahead_units(_permit.consume_memory())
+            , _ready_units(_permit.consume_memory())
             , _cmp(*_schema)
         {}
 
@@ -257,34 +383,41 @@ mutation_reader logstor::make_reader(schema_ptr schema, const primary_index& ind
                     }
                     co_await _current_partition_reader->close();
                     _current_partition_reader = std::nullopt;
-                    // _last_key was already set when we opened the reader
                 }
 
-                // Find next key in range (safe after co_await since we use _last_key)
-                auto it = find_next();
-                if (it == _index.end() || exceeds_range_end(*it)) {
+                if (!_ready.empty()) {
+                    _current_partition_reader = make_mutation_reader_from_mutations(
+                        _schema, _permit, std::move(_ready.front()),
+                        _slice, streamed_mutation::forwarding::no
+                    );
+                    _ready.pop_front();
+                    continue;
+                }
+
+                if (!_read_ahead && !_index_exhausted) {
+                    start_next_batch();
+                }
+                if (!_read_ahead) {
                     _end_of_stream = true;
                     break;
                 }
 
-                // Snapshot the key before yielding
-                auto current_key = it->key();
-
+                auto f = std::move(*_read_ahead);
+                _read_ahead = std::nullopt;
                 auto guard = reader_permit::awaits_guard(_permit);
-                auto mut = co_await _logstor->read(*_schema, _index, current_key, _slice);
-
-                _last_key = current_key; // mark as visited even if not found (tombstoned)
-
-                if (!mut) {
-                    continue; // key was removed between index lookup and read
+                auto muts = co_await std::move(f);
+                std::swap(_ready_units, _read_ahead_units);
+                _read_ahead_units.reset_to_zero();
+
+                // Keys removed between the index lookup and the read are skipped.
+                for (auto& m : muts) {
+                    if (m) {
+                        _ready.push_back(std::move(*m));
+                    }
                 }
 
-                tracing::trace(_trace_state, "logstor_range_reader: fetched key {}", current_key);
-
-                _current_partition_reader = make_mutation_reader_from_mutations(
-                    _schema, _permit, std::move(*mut),
-                    _slice, streamed_mutation::forwarding::no
-                );
+                // Read ahead the next batch while this one is consumed.
+                start_next_batch();
             }
         }
 
@@ -305,12 +438,8 @@ mutation_reader logstor::make_reader(schema_ptr schema, const primary_index& ind
             _end_of_stream = false;
             _pr = pr;
             _last_key = std::nullopt;      // re-position from new range start
-            if (_current_partition_reader) {
-                auto fut = _current_partition_reader->close();
-                _current_partition_reader = std::nullopt;
-                return fut;
-            }
-            return make_ready_future<>();
+            _index_exhausted = false;
+            return reset();
         }
 
         virtual future<> fast_forward_to(position_range pr) override {
@@ -322,10 +451,7 @@ mutation_reader logstor::make_reader(schema_ptr schema, const primary_index& ind
         }
 
         virtual future<> close() noexcept override {
-            if (_current_partition_reader) {
-                return _current_partition_reader->close();
-            }
-            return make_ready_future<>();
+            return reset();
         }
     };
 
@@ -334,6 +460,16 @@ mutation_reader logstor::make_reader(schema_ptr schema, const primary_index& ind
     );
 }
 
+future<> logstor::set_compression_dictionary(table_id table, std::span<const std::byte> dict) {
+    auto gate_holder = _async_gate.hold();
+    co_await local_record_compression().set_table_dictionary(table, dict);
+}
+
+future<> logstor::add_compression_dictionary(std::span<const std::byte> dict) {
+    auto gate_holder = _async_gate.hold();
+    co_await local_record_compression().add_dictionary(dict);
+}
+
 void logstor::set_trigger_compaction_hook(std::function<void()> fn) {
     _segment_manager.set_trigger_compaction_hook(std::move(fn));
 }
@@ -44,6 +44,7 @@ class logstor {
         uint64_t write_failures{0};
     };
 
+    std::filesystem::path _base_dir;
     segment_manager _segment_manager;
     buffered_writer _write_buffer;
     cache_tracker _cache_tracker;
@@ -77,6 +78,11 @@ class logstor {
 
     future<std::optional<mutation>> read(const schema&, const primary_index&, const dht::decorated_key&, const query::partition_slice&);
 
+    /// Read many keys at once, with the disk reads sorted by location and coalesced.
+    /// The results are in the order of the given keys. The disk reads are charged to the permit.
+    future<std::vector<std::optional<mutation>>> read_many(const schema&, const primary_index&, std::vector<dht::decorated_key>, const query::partition_slice&,
+            reader_permit);
+
     /// Create a mutation reader for a specific key
     mutation_reader make_reader(schema_ptr schema,
                                        const primary_index& index,
@@ -85,6 +91,14 @@ class logstor {
                                        const query::partition_slice& slice,
                                        tracing::trace_state_ptr trace_state = nullptr);
 
+    /// Set the compression dictionary for the table's records, or stop using
+    /// a dictionary if it's empty. See compression.hh.
+    future<> set_compression_dictionary(table_id, std::span<const std::byte> dict);
+
+    /// Add a dictionary which records may be compressed with, without using it
+    /// for compressing new records. See compression.hh.
+    future<> add_compression_dictionary(std::span<const std::byte> dict);
+
     void set_trigger_compaction_hook(std::function<void()> fn);
     void set_trigger_separator_flush_hook(std::function<void(segment_sequence)> fn);
 };
@@ -58,9 +58,16 @@ static_assert(segment_header_size % record_alignment == 0, "Segment header size
 
 struct record_header {
     uint32_t header_size; // size of the serialized log_record_header
-    uint32_t data_size;   // size of the serialized canonical_mutation
+    uint32_t data_size;   // size of the serialized canonical_mutation, as stored
+    bool compressed = false; // the data is compressed, see compression.hh
 };
 
+// The compressed flag is stored in the most significant bit of data_size,
+// which is otherwise unused since records are never larger than a segment.
+// Nodes which don't know the flag read it as part of the size, so it's set only
+// once the LOGSTOR_RECORD_COMPRESSION cluster feature is enabled.
+static constexpr uint32_t record_compressed_flag = uint32_t(1) << 31;
+
 static constexpr size_t record_header_size = 2 * sizeof(uint32_t);
 
 bool validate_header(const buffer_header& bh);
@@ -140,14 +147,16 @@ struct serializer<replica::logstor::ondisk::record_header> {
     template <typename Output>
     static void write(Output& out, const replica::logstor::ondisk::record_header& h) {
         serializer<uint32_t>::write(out, h.header_size);
-        serializer<uint32_t>::write(out, h.data_size);
+        serializer<uint32_t>::write(out, h.data_size | (h.compressed ? replica::logstor::ondisk::record_compressed_flag : 0));
     }
 
     template <typename Input>
     static replica::logstor::ondisk::record_header read(Input& in) {
         replica::logstor::ondisk::record_header h;
         h.header_size = serializer<uint32_t>::read(in);
-        h.data_size = serializer<uint32_t>::read(in);
+        auto data_size = serializer<uint32_t>::read(in);
+        h.data_size = data_size & ~replica::logstor::ondisk::record_compressed_flag;
+        h.compressed = data_size & replica::logstor::ondisk::record_compressed_flag;
         return h;
     }
 
@@ -8,6 +8,9 @@
 
 #include "replica/logstor/segment_io.hh"
 #include "replica/logstor/logstor.hh"
+#include "replica/logstor/compression.hh"
+
+#include <numeric>
 
 #include <seastar/core/align.hh>
 #include <seastar/core/simple-stream.hh>
@@ -67,6 +70,15 @@ future<std::optional<segment_header>> read_segment_header(seastar::input_stream<
     co_return make_segment_header(bh, sh);
 }
 
+static canonical_mutation deserialize_record_data(const ondisk::record_header& rh, simple_memory_input_stream data_stream) {
+    if (!rh.compressed) {
+        return ser::deserialize(data_stream, std::type_identity<canonical_mutation>{});
+    }
+    auto compressed = data_stream.read_substream(rh.data_size);
+    auto data = local_record_compression().decompress(bytes_view(reinterpret_cast<const int8_t*>(compressed.begin()), compressed.size()));
+    return ser::deserialize_from_buffer(data, std::type_identity<canonical_mutation>{});
+}
+
 log_record deserialize_log_record(simple_memory_input_stream buf_stream) {
     auto rh_stream = buf_stream.read_substream(ondisk::record_header_size);
     auto rh = ser::deserialize(rh_stream, std::type_identity<ondisk::record_header>{});
@@ -75,7 +87,7 @@ log_record deserialize_log_record(simple_memory_input_stream buf_stream) {
 
     return log_record {
         .header = ser::deserialize(header_stream, std::type_identity<log_record_header>{}),
-        .mut = ser::deserialize(data_stream, std::type_identity<canonical_mutation>{})
+        .mut = deserialize_record_data(rh, data_stream)
     };
 }
 
@@ -87,12 +99,40 @@ future<log_record> read_log_record(seastar::input_stream<char>& in, log_location
     co_return deserialize_log_record(simple_memory_input_stream(buf.begin(), buf.size()));
 }
 
+std::vector<coalesced_read> plan_coalesced_reads(std::span<const log_location> locations, read_coalescing_options opts) {
+    std::vector<size_t> order(locations.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&] (size_t a, size_t b) {
+        return std::tie(locations[a].segment, locations[a].offset) < std::tie(locations[b].segment, locations[b].offset);
+    });
+
+    std::vector<coalesced_read> reads;
+    for (auto i : order) {
+        const auto& loc = locations[i];
+        if (!reads.empty()) {
+            auto& last = reads.back();
+            const uint64_t last_end = uint64_t(last.offset) + last.size;
+            const uint64_t new_end = std::max<uint64_t>(last_end, uint64_t(loc.offset) + loc.size);
+            if (last.segment == loc.segment
+                    && loc.offset <= last_end + opts.max_gap
+                    && new_end - last.offset <= opts.max_read_size) {
+                last.size = new_end - last.offset;
+                last.records.push_back(i);
+                continue;
+            }
+        }
+        reads.push_back(coalesced_read{loc.segment, loc.offset, loc.size, {i}});
+    }
+    return reads;
+}
+
 future<> scan_segment(seastar::input_stream<char>& in,
         log_segment_id segment_id,
         size_t segment_size,
         segment_header_consumer on_segment_header,
         record_header_consumer on_record_header,
-        record_consumer on_record) {
+        record_consumer on_record,
+        dictionary_consumer on_dictionary) {
     size_t current_position = 0;
     std::optional<segment_sequence> segment_seq;
 
@@ -183,11 +223,21 @@ future<> scan_segment(seastar::input_stream<char>& in,
                 if (mut_buf.size() < rh.data_size) {
                     break;
                 }
-                auto mut = ser::deserialize_from_buffer(mut_buf, std::type_identity<canonical_mutation>{});
+                if (rh.compressed && on_dictionary) {
+                    on_dictionary(compressed_dictionary_id(bytes_view(reinterpret_cast<const int8_t*>(mut_buf.get()), mut_buf.size())));
+                }
+                auto mut = deserialize_record_data(rh, simple_memory_input_stream(mut_buf.get(), mut_buf.size()));
                 co_await on_record(loc, log_record{std::move(record_header), std::move(mut)});
             } else {
+                size_t data_read = 0;
+                if (rh.compressed && on_dictionary) {
+                    // Only the compressed payload's header, which has the dictionary id.
+                    auto compressed_header_buf = co_await in.read_exactly(std::min<size_t>(rh.data_size, compressed_header_size));
+                    data_read = compressed_header_buf.size();
+                    on_dictionary(compressed_dictionary_id(bytes_view(reinterpret_cast<const int8_t*>(compressed_header_buf.get()), compressed_header_buf.size())));
+                }
                 // Skip the canonical_mutation bytes without reading them
-                co_await in.skip(rh.data_size);
+                co_await in.skip(rh.data_size - data_read);
                 current_position += rh.data_size;
             }
 
@@ -16,6 +16,7 @@
 #include <seastar/core/fstream.hh>
 #include <seastar/core/temporary_buffer.hh>
 
+#include "replica/logstor/compression.hh"
 #include "replica/logstor/ondisk.hh"
 
 namespace replica::logstor {
@@ -40,18 +41,42 @@ using record_header_consumer = std::function<want_data(log_location, const log_r
 using record_consumer = std::function<future<>(log_location, log_record)>;
 using segment_header_consumer = std::function<future<>(const segment_header&)>;
 using streamed_buffer_consumer = std::function<future<>(bytes_view)>;
+using dictionary_consumer = std::function<void(dictionary_id)>;
 
 future<std::optional<segment_header>> read_segment_header(seastar::input_stream<char>& in);
 
 log_record deserialize_log_record(simple_memory_input_stream);
 future<log_record> read_log_record(seastar::input_stream<char>& in, log_location loc);
 
+struct read_coalescing_options {
+    // Records separated by at most this many bytes are read together; the gap is read and discarded.
+    uint32_t max_gap = 32 * 1024;
+    // A single read never exceeds this size, unless it's for a single larger record.
+    uint32_t max_read_size = 1024 * 1024;
+};
+
+// A single disk read that covers one or more records of a segment.
+struct coalesced_read {
+    log_segment_id segment;
+    uint32_t offset;
+    uint32_t size;
+    // Positions in the input locations of the covered records, in offset order.
+    std::vector<size_t> records;
+};
+
+// Groups record reads into as few disk reads as possible, ordered by
+// (segment, offset), so that reading many records, e.g. for a range scan,
+// is done with sequential I/O. Duplicate locations are covered by the same read.
+std::vector<coalesced_read> plan_coalesced_reads(std::span<const log_location> locations, read_coalescing_options opts = {});
+
 future<> scan_segment(seastar::input_stream<char>& in,
         log_segment_id segment_id,
         size_t segment_size,
         segment_header_consumer on_segment_header,
         record_header_consumer on_record_header,
-        record_consumer on_record);
+        record_consumer on_record,
+        // Called with the dictionary of every compressed record, when set.
+        dictionary_consumer on_dictionary = {});
 
 // Rewrites the initial streamed logstor buffer header to the local segment sequence and
 // forwards subsequent bytes unchanged. This preserves the current branch's streaming
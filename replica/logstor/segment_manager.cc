@@ -14,6 +14,7 @@
 #include "replica/logstor/types.hh"
 #include "replica/logstor/compaction.hh"
 #include <absl/container/flat_hash_map.h>
+#include <charconv>
 #include <chrono>
 #include <linux/if_link.h>
 #include <seastar/core/file.hh>
@@ -55,11 +56,15 @@ class segment {
 
 public:
     segment(log_segment_id id, seastar::file file, uint64_t file_offset, uint64_t max_size);
+    segment(segment&&) noexcept = default;
 
     virtual ~segment() = default;
 
     future<log_record> read(log_location);
 
+    // Reads `size` bytes of the segment starting at `offset`.
+    future<temporary_buffer<char>> read_bytes(uint32_t offset, uint32_t size);
+
     log_segment_id id() const noexcept { return _id; }
     seastar::file& get_file() noexcept { return _file; }
 
@@ -137,13 +142,17 @@ segment::segment(log_segment_id id, seastar::file file, uint64_t file_offset, ui
     , _max_size(max_size) {
 }
 
-future<log_record> segment::read(log_location loc) {
-    if (loc.offset + loc.size > _max_size) [[unlikely]] {
+future<temporary_buffer<char>> segment::read_bytes(uint32_t offset, uint32_t size) {
+    if (uint64_t(offset) + size > _max_size) [[unlikely]] {
         throw std::runtime_error(fmt::format("Read beyond end of segment {}: offset {} + size {} > max_size {}",
-                                             _id, loc.offset, loc.size, _max_size));
+                                             _id, offset, size, _max_size));
     }
 
-    return _file.dma_read_exactly<char>(absolute_offset(loc.offset), loc.size).then([] (temporary_buffer<char> buf) {
+    return _file.dma_read_exactly<char>(absolute_offset(offset), size);
+}
+
+future<log_record> segment::read(log_location loc) {
+    return read_bytes(loc.offset, loc.size).then([] (temporary_buffer<char> buf) {
         return deserialize_log_record(simple_memory_input_stream(buf.begin(), buf.size()));
     });
 }
@@ -494,12 +503,36 @@ std::optional<file_id_t> file_manager::file_name_to_file_id(const std::string& f
     return std::nullopt;
 }
 
+static constexpr std::string_view segment_snapshot_file_prefix = "logstor_segment_";
+
+sstring segment_snapshot_file_name(unsigned shard, log_segment_id segment_id) {
+    return format("{}{}_{}", segment_snapshot_file_prefix, shard, segment_id);
+}
+
+bool is_segment_snapshot_file_name(std::string_view name) noexcept {
+    return name.starts_with(segment_snapshot_file_prefix);
+}
+
+std::optional<unsigned> segment_snapshot_file_shard(std::string_view name) noexcept {
+    if (!is_segment_snapshot_file_name(name)) {
+        return std::nullopt;
+    }
+    auto shard_and_id = name.substr(segment_snapshot_file_prefix.size());
+    unsigned shard;
+    auto [ptr, ec] = std::from_chars(shard_and_id.data(), shard_and_id.data() + shard_and_id.size(), shard);
+    if (ec != std::errc() || ptr == shard_and_id.data() + shard_and_id.size() || *ptr != '_') {
+        return std::nullopt;
+    }
+    return shard;
+}
+
 class compaction_manager_impl : public compaction_manager {
 public:
 
     struct compaction_config {
         bool compaction_enabled;
         size_t max_segments_per_compaction;
+        std::chrono::seconds cold_data_age;
         seastar::scheduling_group compaction_sg;
         utils::updateable_value<float> compaction_static_shares;
         seastar::scheduling_group separator_sg;
@@ -516,6 +549,7 @@ class compaction_manager_impl : public compaction_manager {
         uint64_t compaction_segments_freed{0};
         uint64_t compaction_records_skipped{0};
         uint64_t compaction_records_rewritten{0};
+        uint64_t compaction_cold_records_rewritten{0};
         uint64_t separator_buffer_flushed{0};
         uint64_t separator_segments_freed{0};
     } _stats;
@@ -696,6 +730,8 @@ class segment_manager_impl {
         std::array<uint64_t, write_source_count> bytes_written{0};
         std::array<uint64_t, write_source_count> data_bytes_written{0};
         uint64_t bytes_read{0};
+        uint64_t coalesced_reads{0};
+        uint64_t coalesced_records_read{0};
         uint64_t bytes_freed{0};
         uint64_t segments_allocated{0};
         uint64_t segments_freed{0};
@@ -771,9 +807,12 @@ class segment_manager_impl {
     future<> stop();
 
     future<> write(write_buffer&);
-    future<> write_full_segment(write_buffer&, compaction_group&, write_source);
+    future<> write_full_segment(write_buffer&, compaction_group&, write_source, std::optional<segment_sequence> data_seq = std::nullopt,
+            std::optional<lowres_clock::time_point> written_at = std::nullopt);
 
+    future<segment> open_segment_for_read(log_segment_id);
     future<log_record> read(log_location);
+    future<std::vector<log_record>> read_many(std::vector<log_location>, reader_permit);
 
     void on_add_record(log_location) noexcept;
     void on_free_record(log_location) noexcept;
@@ -833,6 +872,7 @@ class segment_manager_impl {
     }
 
     future<> discard_segments(segment_set&);
+    future<> invalidate_segment_header(log_segment_id);
 
     size_t get_memory_usage() const {
         return _cfg.max_separator_memory + sizeof(_segment_descs);
@@ -888,7 +928,8 @@ class segment_manager_impl {
     future<> scan_segment(log_segment_id segment_id,
                           std::function<future<>(const segment_header&)> header_callback,
                           std::function<want_data(log_location, const log_record_header&)> on_header,
-                          std::function<future<>(log_location, log_record)> on_record);
+                          std::function<future<>(log_location, log_record)> on_record,
+                          dictionary_consumer on_dictionary = {});
 
     segment_ref make_segment_ref(log_segment_id seg_id) {
         auto& desc = get_segment_descriptor(seg_id);
@@ -964,6 +1005,7 @@ segment_manager_impl::segment_manager_impl(segment_manager_config config)
     , _compaction_mgr(*this, compaction_manager_impl::compaction_config{
             .compaction_enabled = config.compaction_enabled,
             .max_segments_per_compaction = config.max_segments_per_compaction,
+            .cold_data_age = config.compaction_cold_data_age,
             .compaction_sg = config.compaction_sg,
             .compaction_static_shares = config.compaction_static_shares,
             .separator_sg = config.separator_sg
@@ -987,7 +1029,8 @@ segment_manager_impl::segment_manager_impl(segment_manager_config config)
 
     // pre-allocate write buffers for compaction
     // at most a single compaction/split running at a time
-    // and at most two buffers used at a time by split.
+    // and at most two buffers used at a time, by split, and by compaction
+    // when it separates cold records from hot ones.
     size_t compaction_buffer_count = 2;
     _available_compaction_buffers.reserve(compaction_buffer_count);
     _compaction_buffer_pool.reserve(compaction_buffer_count);
@@ -1034,6 +1077,10 @@ segment_manager_impl::segment_manager_impl(segment_manager_config config)
                        sm::description("Counts number of data bytes written to the disk.")),
         sm::make_counter("bytes_read", _stats.bytes_read,
                        sm::description("Counts number of bytes read from the disk.")),
+        sm::make_counter("coalesced_reads", _stats.coalesced_reads,
+                       sm::description("Counts number of disk reads issued for reading multiple records at once.")),
+        sm::make_counter("coalesced_records_read", _stats.coalesced_records_read,
+                       sm::description("Counts number of records read by coalesced disk reads.")),
         sm::make_counter("bytes_freed", _stats.bytes_freed,
                        sm::description("Counts number of data bytes freed.")),
         sm::make_counter("segments_allocated", _stats.segments_allocated,
@@ -1054,6 +1101,8 @@ segment_manager_impl::segment_manager_impl(segment_manager_config config)
                        sm::description("Counts number of records skipped during compaction.")),
         sm::make_counter("compaction_records_rewritten", _compaction_mgr.get_stats().compaction_records_rewritten,
                        sm::description("Counts number of records rewritten during compaction.")),
+        sm::make_counter("compaction_cold_records_rewritten", _compaction_mgr.get_stats().compaction_cold_records_rewritten,
+                       sm::description("Counts number of records rewritten during compaction into cold segments.")),
         sm::make_counter("separator_bytes_written", _stats.bytes_written[static_cast<size_t>(write_source::separator)],
                        sm::description("Counts number of bytes written to the separator.")),
         sm::make_counter("separator_data_bytes_written", _stats.data_bytes_written[static_cast<size_t>(write_source::separator)],
@@ -1155,6 +1204,7 @@ future<> segment_manager_impl::write(write_buffer& wb) {
 
         bytes_view data(reinterpret_cast<const int8_t*>(wb.data()), wb.serialized_size());
         auto loc = co_await seg->write_reserved(std::move(*reservation), data);
+        get_segment_descriptor(seg->id()).dictionaries.add(wb.dictionaries());
 
         _stats.bytes_written[static_cast<size_t>(source)] += data.size();
         _stats.data_bytes_written[static_cast<size_t>(source)] += wb.net_data_size();
@@ -1176,7 +1226,8 @@ future<> segment_manager_impl::write(write_buffer& wb) {
     }
 }
 
-future<> segment_manager_impl::write_full_segment(write_buffer& wb, compaction_group& cg, write_source source) {
+future<> segment_manager_impl::write_full_segment(write_buffer& wb, compaction_group& cg, write_source source, std::optional<segment_sequence> data_seq,
+        std::optional<lowres_clock::time_point> written_at) {
     auto holder = _async_gate.hold();
 
     const auto sealed_size = wb.sealed_size(block_alignment);
@@ -1192,15 +1243,25 @@ future<> segment_manager_impl::write_full_segment(write_buffer& wb, compaction_g
     bytes_view data(reinterpret_cast<const int8_t*>(wb.data()), wb.serialized_size());
 
     auto loc = co_await seg->append(data);
+    get_segment_descriptor(seg->id()).dictionaries.add(wb.dictionaries());
 
     _stats.bytes_written[static_cast<size_t>(source)] += data.size();
     _stats.data_bytes_written[static_cast<size_t>(source)] += wb.net_data_size();
 
+    auto& ss = cg.logstor_segments();
+    if (source == write_source::compaction) {
+        ss._compaction_data_bytes_written += wb.net_data_size();
+    } else {
+        ss._separator_data_bytes_written += wb.net_data_size();
+    }
+
     co_await wb.complete_writes(loc);
     co_await seg->stop();
 
     // add the segment after all index updates are completed.
     auto& desc = get_segment_descriptor(seg->id());
+    desc.data_seq = data_seq.value_or(seg->seq_num());
+    desc.written_at = written_at.value_or(lowres_clock::now());
     cg.add_logstor_segment(desc);
 }
 
@@ -1226,16 +1287,45 @@ void segment_manager_impl::on_free_record(log_location location) noexcept {
     _stats.bytes_freed += location.size;
 }
 
+future<segment> segment_manager_impl::open_segment_for_read(log_segment_id seg_id) {
+    auto [file_id, file_offset] = segment_id_to_file_location(seg_id);
+    auto file = co_await _file_mgr.get_file_for_read(file_id);
+    co_return segment(seg_id, std::move(file), file_offset, _cfg.segment_size);
+}
+
 future<log_record> segment_manager_impl::read(log_location location) {
     auto holder = _async_gate.hold();
-    auto [file_id, file_offset] = segment_id_to_file_location(location.segment);
-    auto file = co_await _file_mgr.get_file_for_read(file_id);
-    segment seg(location.segment, file, file_offset, _cfg.segment_size);
+    auto seg = co_await open_segment_for_read(location.segment);
     auto record = co_await seg.read(location);
     _stats.bytes_read += location.size;
     co_return std::move(record);
 }
 
+future<std::vector<log_record>> segment_manager_impl::read_many(std::vector<log_location> locations, reader_permit permit) {
+    auto holder = _async_gate.hold();
+    static constexpr size_t max_concurrent_reads = 4;
+
+    std::vector<std::optional<log_record>> records(locations.size());
+    auto reads = plan_coalesced_reads(locations);
+
+    co_await max_concurrent_for_each(reads, max_concurrent_reads, [this, &locations, &records, &permit] (const coalesced_read& r) -> future<> {
+        auto units = permit.consume_memory(r.size);
+        auto seg = co_await open_segment_for_read(r.segment);
+        auto buf = co_await seg.read_bytes(r.offset, r.size);
+        for (auto i : r.records) {
+            const auto& loc = locations[i];
+            records[i] = deserialize_log_record(simple_memory_input_stream(buf.get() + (loc.offset - r.offset), loc.size));
+        }
+        _stats.bytes_read += r.size;
+        _stats.coalesced_reads++;
+        _stats.coalesced_records_read += r.records.size();
+    });
+
+    co_return records | std::views::transform([] (std::optional<log_record>& r) {
+        return std::move(*r);
+    }) | std::ranges::to<std::vector<log_record>>();
+}
+
 future<> segment_manager_impl::request_segment_switch() {
     if (!_switch_segment_fut) {
         auto f = switch_active_segment();
@@ -1352,6 +1442,7 @@ void segment_manager_impl::free_segment(log_segment_id segment_id) noexcept {
     if (desc.ref_count != 0) {
         on_internal_error(logstor_logger, format("Freeing segment {} with non-zero reference count", segment_id));
     }
+    desc.dictionaries.release();
     if (segment_id.value < _max_segments.configured) {
         _free_segments.push_back(segment_id);
         _segment_freed_cv.signal();
@@ -1382,16 +1473,20 @@ future<> segment_manager_impl::discard_segments(segment_set& ss) {
         segments.push_back(seg_id);
     }
 
-    // Invalidate the first header block so recovery treats the slot as empty.
     co_await max_concurrent_for_each(segments, 32, [this] (log_segment_id seg_id) -> future<> {
         logstor_logger.trace("Discard segment {}", seg_id);
-        auto [file_id, file_offset] = segment_id_to_file_location(seg_id);
-        auto file = co_await _file_mgr.get_file_for_write(file_id);
-        co_await _file_mgr.format_file_region(file, file_offset, block_alignment);
+        co_await invalidate_segment_header(seg_id);
         free_segment(seg_id);
     });
 }
 
+future<> segment_manager_impl::invalidate_segment_header(log_segment_id seg_id) {
+    // Invalidate the first header block so recovery treats the slot as empty.
+    auto [file_id, file_offset] = segment_id_to_file_location(seg_id);
+    auto file = co_await _file_mgr.get_file_for_write(file_id);
+    co_await _file_mgr.format_file_region(file, file_offset, block_alignment);
+}
+
 future<std::optional<segment_header>> segment_manager_impl::read_segment_header(log_segment_id segment_id) {
     auto in = co_await create_segment_input_stream(segment_id, file_input_stream_options {
         .buffer_size = block_alignment,
@@ -1405,13 +1500,14 @@ future<std::optional<segment_header>> segment_manager_impl::read_segment_header(
 future<> segment_manager_impl::scan_segment(log_segment_id segment_id,
                                 std::function<future<>(const segment_header&)> header_callback,
                                 std::function<want_data(log_location, const log_record_header&)> on_header,
-                                std::function<future<>(log_location, log_record)> on_record) {
+                                std::function<future<>(log_location, log_record)> on_record,
+                                dictionary_consumer on_dictionary) {
     auto in = co_await create_segment_input_stream(segment_id, seastar::file_input_stream_options {
         .buffer_size = std::min<size_t>(_cfg.segment_size, 128 * 1024),
         .read_ahead = 1,
     });
     co_await ::replica::logstor::scan_segment(in, segment_id, _cfg.segment_size,
-            std::move(header_callback), std::move(on_header), std::move(on_record));
+            std::move(header_callback), std::move(on_header), std::move(on_record), std::move(on_dictionary));
     co_await in.close();
 }
 
@@ -1490,30 +1586,74 @@ compaction_reenabler compaction_manager_impl::disable_compaction_no_wait(compact
     });
 }
 
+// Victim segments are chosen by the cost-benefit policy of LFS: compacting a segment
+// with utilization u costs reading it and rewriting u of it, and frees 1-u of it, and
+// the free space of old segments is worth more because it's less likely to be
+// freed soon by overwrites. The segments are ranked by (1-u) * age / (1+u).
+//
+// An old, nearly full segment can outrank a young, emptier one, so every segment
+// with free space is scored, and only the best max_segments_per_compaction of them
+// are kept, in a min-heap by score.
 std::vector<log_segment_id> compaction_manager_impl::select_segments_for_compaction(const segment_descriptor_hist& segments) {
+    const auto segment_size = _sm.get_segment_size();
+    const auto current_seq = _sm._next_segment_seq;
+    const size_t max_candidates = _cfg.max_segments_per_compaction;
+
+    struct candidate {
+        const segment_descriptor* desc;
+        double score;
+    };
+    auto worse_first = [] (const candidate& a, const candidate& b) {
+        return a.score > b.score;
+    };
+    std::vector<candidate> scored;
+    scored.reserve(max_candidates + 1);
+
+    for (const auto& desc : segments) {
+        if (desc.free_space == 0) {
+            continue;
+        }
+        double u = double(desc.net_data_size(segment_size)) / segment_size;
+        auto age = current_seq.value - std::min(desc.data_seq.value, current_seq.value) + 1;
+        auto score = (1 - u) * age / (1 + u);
+        if (scored.size() == max_candidates) {
+            if (max_candidates == 0 || score <= scored.front().score) {
+                continue;
+            }
+            std::ranges::pop_heap(scored, worse_first);
+            scored.pop_back();
+        }
+        scored.push_back(candidate{&desc, score});
+        std::ranges::push_heap(scored, worse_first);
+    }
+
+    std::ranges::sort(scored, std::greater<>(), &candidate::score);
+
+    // Separating hot and cold records may leave two partially filled segments instead of one.
+    const uint64_t extra_segments = _cfg.cold_data_age.count() > 0 ? 1 : 0;
+
     uint64_t accum_net_data_size = 0;
     uint64_t accum_record_count = 0;
     int64_t max_gain = 0;
     uint64_t best_count = 0;
     std::vector<log_segment_id> candidates;
-    const auto segment_size = _sm.get_segment_size();
 
-    for (const auto& desc : segments) {
+    for (const auto& [desc, score] : scored) {
         if (candidates.size() >= _cfg.max_segments_per_compaction) {
             break;
         }
 
-        auto seg_id = _sm.desc_to_segment_id(desc);
+        auto seg_id = _sm.desc_to_segment_id(*desc);
         candidates.push_back(seg_id);
 
-        accum_net_data_size += desc.net_data_size(segment_size);
-        accum_record_count += desc.record_count;
+        accum_net_data_size += desc->net_data_size(segment_size);
+        accum_record_count += desc->record_count;
 
         auto required_segments = raw_write_buffer::estimate_required_segments(
-            accum_net_data_size, accum_record_count, segment_size);
+            accum_net_data_size, accum_record_count, segment_size) + extra_segments;
 
-        logstor_logger.trace("Evaluating compaction candidate {} with net data size {} accumulated {} required segments {}",
-                           seg_id, desc.net_data_size(segment_size), accum_net_data_size, required_segments);
+        logstor_logger.trace("Evaluating compaction candidate {} with net data size {} score {} accumulated {} required segments {}",
+                           seg_id, desc->net_data_size(segment_size), score, accum_net_data_size, required_segments);
 
         auto gain = static_cast<int64_t>(candidates.size()) - static_cast<int64_t>(required_segments);
         if (gain > max_gain) {
@@ -1524,9 +1664,8 @@ std::vector<log_segment_id> compaction_manager_impl::select_segments_for_compact
 
     logstor_logger.debug("Selected {} segments for compaction for estimated gain of {} segments", best_count, max_gain);
 
-    return candidates
-            | std::views::take(best_count)
-            | std::ranges::to<std::vector<log_segment_id>>();
+    candidates.resize(best_count);
+    return candidates;
 }
 
 future<> compaction_manager_impl::do_compact(compaction_group& cg, abort_source& as) {
@@ -1557,6 +1696,12 @@ struct compaction_buffer {
     write_buffer* buf = nullptr;
     compaction_group& cg;
     std::vector<future<>> pending_updates;
+    // The data age assigned to the segments written from this buffer, see segment_descriptor::data_seq.
+    // When not set, the new segments are considered as young as their sequence number.
+    std::optional<segment_sequence> data_seq;
+    // The latest segment_descriptor::written_at of the segments the records
+    // in the buffer were read from.
+    lowres_clock::time_point written_at;
 
     struct stats {
         size_t flush_count{0};
@@ -1576,7 +1721,7 @@ struct compaction_buffer {
 
     compaction_buffer(compaction_buffer&& o) noexcept
         : sm(o.sm), buf(std::exchange(o.buf, nullptr)), cg(o.cg)
-        , pending_updates(std::move(o.pending_updates)), stats(o.stats) {}
+        , pending_updates(std::move(o.pending_updates)), data_seq(o.data_seq), written_at(o.written_at), stats(o.stats) {}
 
     ~compaction_buffer() {
         if (buf) {
@@ -1590,13 +1735,14 @@ struct compaction_buffer {
     future<> flush() {
         if (buf->has_data()) {
             stats.flush_count++;
-            co_await sm.write_full_segment(*buf, cg, write_source::compaction);
+            co_await sm.write_full_segment(*buf, cg, write_source::compaction, data_seq, written_at);
             logstor_logger.trace("Compaction buffer flushed with {} bytes", buf->net_data_size());
         }
         co_await when_all_succeed(pending_updates.begin(), pending_updates.end());
         co_await buf->close();
         buf->reset();
         pending_updates.clear();
+        written_at = {};
     }
 
     future<> close() {
@@ -1611,11 +1757,12 @@ struct compaction_buffer {
     future<> rewrite_record(primary_index& index, log_location read_location, log_record record) {
         auto* index_ptr = &index;
         auto key = record.header.key;
-        log_record_writer writer(std::move(record));
+        log_record_writer writer(std::move(record), *cg.schema());
 
         if (!buf->can_fit(writer)) {
             co_await flush();
         }
+        written_at = std::max(written_at, sm.get_segment_descriptor(read_location).written_at);
 
         auto write_and_update_index = buf->write(std::move(writer)).then_unpack(
                 [this, index_ptr, key = std::move(key), read_location]
@@ -1632,30 +1779,56 @@ struct compaction_buffer {
     }
 };
 
+// Live records are rewritten into two sets of segments: cold records, which weren't
+// written for `cold_data_age`, and hot records. Mixing them would cause the cold
+// records to be rewritten again every time the hot records sharing their segment
+// are overwritten. A record is cold when the segment it is read from was written
+// long enough ago, see segment_descriptor::written_at. The timestamps of the records
+// aren't used since they are set by the clients, e.g. with USING TIMESTAMP.
+// The cold segments inherit the age of the youngest compacted segment so that,
+// being full and old, they are not chosen again for compaction soon.
 future<> compaction_manager_impl::compact_segments(compaction_group& cg, std::vector<log_segment_id> segments) {
     logstor_logger.trace("Starting compaction of segments {} in compaction group {}:{}", segments, cg.schema()->id(), cg.group_id());
 
-    compaction_buffer cb(_sm, cg);
+    compaction_buffer hot(_sm, cg);
+    std::optional<compaction_buffer> cold;
+    if (_cfg.cold_data_age.count() > 0) {
+        cold.emplace(_sm, cg);
+        cold->data_seq = std::ranges::max(segments | std::views::transform([this] (log_segment_id seg_id) {
+            return _sm.get_segment_descriptor(seg_id).data_seq;
+        }));
+    }
+    const auto cold_written_at = lowres_clock::now() - _cfg.cold_data_age;
 
     auto& index = cg.get_logstor_index();
 
     co_await _sm.for_each_record(segments,
-        [&index, &cb] (log_location read_location, const log_record_header& record_header) -> want_data {
+        [&index, &hot] (log_location read_location, const log_record_header& record_header) -> want_data {
             if (!index.is_record_alive(record_header.key, read_location)) {
-                cb.stats.records_skipped++;
+                hot.stats.records_skipped++;
                 return want_data::no;
             }
             return want_data::yes;
         },
-        [&index, &cb] (log_location read_location, log_record record) -> future<> {
+        [this, &index, &hot, &cold, cold_written_at] (log_location read_location, log_record record) -> future<> {
+            auto& cb = cold && _sm.get_segment_descriptor(read_location).written_at < cold_written_at ? *cold : hot;
             co_await cb.rewrite_record(index, read_location, std::move(record));
         }
     );
 
-    co_await cb.close();
+    co_await hot.close();
+    if (cold) {
+        co_await cold->close();
+    }
+
+    const auto cold_flush_count = cold ? cold->stats.flush_count : 0;
+    const auto cold_records_rewritten = cold ? cold->stats.records_rewritten : 0;
+    const auto flush_count = hot.stats.flush_count + cold_flush_count;
+    const auto records_rewritten = hot.stats.records_rewritten + cold_records_rewritten;
+    const auto records_skipped = hot.stats.records_skipped + (cold ? cold->stats.records_skipped : 0);
 
-    logstor_logger.debug("Compaction complete: {} records rewritten, {} skipped from {} segments, flushed {} times",
-                       cb.stats.records_rewritten, cb.stats.records_skipped, segments.size(), cb.stats.flush_count);
+    logstor_logger.debug("Compaction complete: {} records rewritten ({} cold), {} skipped from {} segments, flushed {} times",
+                       records_rewritten, cold_records_rewritten, records_skipped, segments.size(), flush_count);
 
     // wait for read operations that use the old locations
     co_await index.await_pending_reads();
@@ -1672,13 +1845,14 @@ future<> compaction_manager_impl::compact_segments(compaction_group& cg, std::ve
         }
     }
 
-    uint64_t new_segments = segments.size() > cb.stats.flush_count ? segments.size() - cb.stats.flush_count : 0;
+    uint64_t new_segments = segments.size() > flush_count ? segments.size() - flush_count : 0;
     _stats.segments_compacted += segments.size();
     _stats.compaction_segments_freed += new_segments;
-    _stats.compaction_records_rewritten += cb.stats.records_rewritten;
-    _stats.compaction_records_skipped += cb.stats.records_skipped;
+    _stats.compaction_records_rewritten += records_rewritten;
+    _stats.compaction_cold_records_rewritten += cold_records_rewritten;
+    _stats.compaction_records_skipped += records_skipped;
 
-    _controller.update(cb.stats.flush_count, new_segments);
+    _controller.update(flush_count, new_segments);
 }
 
 void compaction_manager_impl::controller::update(size_t segment_write_count, uint64_t new_segments) {
@@ -1823,7 +1997,7 @@ future<> segment_manager_impl::write_to_separator(write_buffer& wb, segment_ref
 void segment_manager_impl::write_to_separator(table& t, log_location prev_loc, log_record record, segment_ref seg_ref) {
     auto key = record.header.key;
     auto* index_ptr = &t.logstor_index();
-    log_record_writer writer(std::move(record));
+    log_record_writer writer(std::move(record), *t.schema());
 
     auto& buf = t.get_logstor_separator_buffer(key.dk.token(), writer.size());
 
@@ -1977,6 +2151,7 @@ future<> segment_manager_impl::do_recovery(replica::database& db) {
         co_await coroutine::maybe_yield();
         log_segment_id seg_id(seg_idx);
         if (!used_segments.test(seg_idx)) {
+            get_segment_descriptor(seg_id).dictionaries.release();
             if (seg_idx < _max_segments.configured) {
                 _free_segments.push_back(seg_id);
                 free_segment_count++;
@@ -2027,8 +2202,12 @@ future<> segment_manager_impl::recover_segment(replica::database& db, log_segmen
     desc.reset(_cfg.segment_size);
 
     co_await scan_segment(segment_id,
-        [segment_id, on_header = std::move(on_header)] (const segment_header& seg_hdr) mutable {
+        [segment_id, &desc, on_header = std::move(on_header)] (const segment_header& seg_hdr) mutable {
             logstor_logger.trace("Recovering segment {} with sequence {}", segment_id, seg_hdr.segment_seq);
+            desc.data_seq = seg_hdr.segment_seq;
+            // The time the records were written isn't known, so they are
+            // treated as if they were written now.
+            desc.written_at = lowres_clock::now();
             on_header(seg_hdr);
             return make_ready_future<>();
         },
@@ -2055,6 +2234,9 @@ future<> segment_manager_impl::recover_segment(replica::database& db, log_segmen
         [] (log_location, log_record) {
             // we don't read record data, only headers.
             return make_ready_future<>();
+        },
+        [&desc] (dictionary_id id) {
+            desc.dictionaries.add(id);
         });
 }
 
@@ -2180,6 +2362,10 @@ future<log_record> segment_manager::read(log_location location) {
     return _impl->read(location);
 }
 
+future<std::vector<log_record>> segment_manager::read_many(std::vector<log_location> locations, reader_permit permit) {
+    return _impl->read_many(std::move(locations), std::move(permit));
+}
+
 void segment_manager::set_trigger_compaction_hook(std::function<void()> fn) {
     _impl->set_trigger_compaction_hook(std::move(fn));
 }
@@ -2265,7 +2451,10 @@ class segment_stream_sink_impl : public segment_stream_sink {
         co_await _sm.load_segment(_db, _seg->id());
     }
     future<> abort() override {
-        co_return;
+        // Don't let recovery load the partially received segment after a restart.
+        // The segment is freed when the last reference to it is released.
+        co_await _seg->stop();
+        co_await _sm.invalidate_segment_header(_seg->id());
     }
 };
 
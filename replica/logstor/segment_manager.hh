@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
 #include <seastar/core/shared_future.hh>
@@ -19,6 +20,7 @@
 #include <seastar/util/bool_class.hh>
 #include "bytes_fwd.hh"
 #include "mutation_writer/token_group_based_splitting_writer.hh"
+#include "reader_permit.hh"
 #include "replica/logstor/segment_io.hh"
 #include "replica/logstor/write_buffer.hh"
 #include "replica/logstor/compaction.hh"
@@ -48,6 +50,10 @@ struct segment_manager_config {
     bool format_on_startup = true;
     bool compaction_enabled = true;
     size_t max_segments_per_compaction = 8;
+    // Records in segments written longer than this ago are considered cold, and
+    // compaction rewrites them into separate segments from the hot records.
+    // 0 disables the separation.
+    std::chrono::seconds compaction_cold_data_age{3600};
     seastar::scheduling_group compaction_sg;
     utils::updateable_value<float> compaction_static_shares;
     seastar::scheduling_group separator_sg;
@@ -69,11 +75,24 @@ struct table_segment_histogram_bucket {
 struct table_segment_stats {
     size_t compaction_group_count{0};
     size_t segment_count{0};
+    uint64_t separator_data_bytes_written{0};
+    uint64_t compaction_data_bytes_written{0};
     std::vector<table_segment_histogram_bucket> histogram;
 
+    // Total data bytes written to the table's segments per byte placed by the separator.
+    // Doesn't include the initial write to the shared log.
+    double write_amplification() const noexcept {
+        if (!separator_data_bytes_written) {
+            return 1.0;
+        }
+        return double(separator_data_bytes_written + compaction_data_bytes_written) / separator_data_bytes_written;
+    }
+
     table_segment_stats& operator+=(table_segment_stats& other) {
         compaction_group_count += other.compaction_group_count;
         segment_count += other.segment_count;
+        separator_data_bytes_written += other.separator_data_bytes_written;
+        compaction_data_bytes_written += other.compaction_data_bytes_written;
         histogram.resize(std::max(histogram.size(), other.histogram.size()));
         for (size_t i = 0; i < other.histogram.size(); i++) {
             histogram[i] += other.histogram[i];
@@ -122,6 +141,10 @@ class segment_manager : public space_accounting_subscriber {
 
     future<log_record> read(log_location location);
 
+    // Reads many records with coalesced, sequential I/O. The records are returned
+    // in the order of the given locations. The read buffers are charged to the permit.
+    future<std::vector<log_record>> read_many(std::vector<log_location> locations, reader_permit permit);
+
     void on_add_record(log_location location) noexcept override;
     void on_free_record(log_location location) noexcept override;
 
@@ -149,5 +172,15 @@ class segment_manager : public space_accounting_subscriber {
 
 };
 
+// The name of the file a snapshot stores a segment of the given shard in.
+sstring segment_snapshot_file_name(unsigned shard, log_segment_id);
+
+// Whether the file name is that of a segment stored by a snapshot.
+bool is_segment_snapshot_file_name(std::string_view name) noexcept;
+
+// The shard in the name of a segment stored by a snapshot, or nullopt if the
+// name is malformed.
+std::optional<unsigned> segment_snapshot_file_shard(std::string_view name) noexcept;
+
 }
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "dht/token.hh"
 #include "bytes_fwd.hh"
 #include "logstor.hh"
+#include "compression.hh"
 #include "replica/logstor/types.hh"
 #include <chrono>
 #include <seastar/core/simple-stream.hh>
@@ -25,19 +26,41 @@
 
 namespace replica::logstor {
 
+log_record_writer::log_record_writer(log_record record, const schema& s)
+    : _record(std::move(record))
+{
+    if (local_record_compression().enabled_for(s)) {
+        auto data = ser::serialize_to_buffer<bytes>(_record.mut);
+        _compressed_data = local_record_compression().compress(s, data);
+        if (!_compressed_data) {
+            _data_size = data.size();
+        } else {
+            _dictionary.add(compressed_dictionary_id(*_compressed_data));
+        }
+    }
+}
+
 void log_record_writer::compute_sizes() const {
     seastar::measuring_output_stream ms_header;
     ser::serialize(ms_header, _record.header);
     _header_size = ms_header.size();
 
-    seastar::measuring_output_stream ms_data;
-    ser::serialize(ms_data, _record.mut);
-    _data_size = ms_data.size();
+    if (_compressed_data) {
+        _data_size = _compressed_data->size();
+    } else if (!_data_size) {
+        seastar::measuring_output_stream ms_data;
+        ser::serialize(ms_data, _record.mut);
+        _data_size = ms_data.size();
+    }
 }
 
 void log_record_writer::write(ostream& out) const {
     ser::serialize(out, _record.header);
-    ser::serialize(out, _record.mut);
+    if (_compressed_data) {
+        out.write(reinterpret_cast<const char*>(_compressed_data->data()), _compressed_data->size());
+    } else {
+        ser::serialize(out, _record.mut);
+    }
 }
 
 // raw_write_buffer
@@ -61,6 +84,7 @@ void raw_write_buffer::reset() {
     _record_count = 0;
     _min_token = std::nullopt;
     _max_token = std::nullopt;
+    _dictionaries.release();
     _sealed = false;
 }
 
@@ -88,11 +112,13 @@ raw_write_buffer::append_result raw_write_buffer::append(const log_record_writer
     if (content_size == 0) {
         throw std::runtime_error("Cannot write empty record");
     }
+    _dictionaries.add(writer.dictionaries());
 
     size_t record_header_offset = offset_in_buffer();
     auto rh = ondisk::record_header {
         .header_size = static_cast<uint32_t>(writer.header_size()),
-        .data_size = static_cast<uint32_t>(writer.data_size())
+        .data_size = static_cast<uint32_t>(writer.data_size()),
+        .compressed = writer.compressed(),
     };
     ser::serialize(_stream, rh);
 
@@ -21,6 +21,7 @@
 #include <seastar/core/timed_out_error.hh>
 
 #include "replica/exceptions.hh"
+#include "replica/logstor/compression.hh"
 #include "replica/logstor/ondisk.hh"
 #include "schema/schema_fwd.hh"
 #include "types.hh"
@@ -40,6 +41,10 @@ class log_record_writer {
     log_record _record;
     mutable std::optional<size_t> _header_size;
     mutable std::optional<size_t> _data_size;
+    // The compressed serialized mutation, when the record is compressed.
+    std::optional<bytes> _compressed_data;
+    // The dictionary the record is compressed with, kept until the record is appended to a buffer.
+    dictionary_refs _dictionary;
 
     void compute_sizes() const;
 
@@ -48,6 +53,10 @@ class log_record_writer {
         : _record(std::move(record))
     {}
 
+    // Compresses the record's data if record compression is enabled and the
+    // table's compression options enable it.
+    log_record_writer(log_record record, const schema& s);
+
     // Get serialized sizes (computed lazily)
     size_t header_size() const {
         if (!_header_size) {
@@ -68,6 +77,14 @@ class log_record_writer {
         return header_size() + data_size();
     }
 
+    bool compressed() const noexcept {
+        return bool(_compressed_data);
+    }
+
+    const dictionary_refs& dictionaries() const noexcept {
+        return _dictionary;
+    }
+
     // Write the record to an output stream
     void write(ostream& out) const;
 
@@ -123,6 +140,9 @@ class raw_write_buffer {
     size_t _record_count{0};
     std::optional<dht::token> _min_token;
     std::optional<dht::token> _max_token;
+    // The dictionaries of the appended records, kept until the segment the buffer
+    // is written to references them.
+    dictionary_refs _dictionaries;
 
     bool _sealed{false};
 
@@ -157,6 +177,7 @@ class raw_write_buffer {
     size_t net_data_size() const noexcept { return _net_data_size; }
     size_t record_count() const noexcept { return _record_count; }
     segment_kind kind() const noexcept { return _segment_kind; }
+    const dictionary_refs& dictionaries() const noexcept { return _dictionaries; }
 
     append_result append(const log_record_writer& writer);
     size_t sealed_size(size_t alignment) const noexcept;
@@ -245,6 +266,7 @@ class write_buffer {
     size_t max_record_size() const noexcept { return _raw.max_record_size(); }
     size_t net_data_size() const noexcept { return _raw.net_data_size(); }
     size_t record_count() const noexcept { return _raw.record_count(); }
+    const dictionary_refs& dictionaries() const noexcept { return _raw.dictionaries(); }
 
     size_t sealed_size(size_t alignment) {
         return _raw.sealed_size(alignment);
@@ -634,9 +634,9 @@ class flush_reader final : public mutation_reader::impl, private iterator_reader
     mutation_reader_opt _partition_reader;
     flush_memory_accounter _flushed_memory;
 public:
-    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m)
+    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m, const dht::partition_range& range)
         : impl(s, std::move(permit))
-        , iterator_reader(std::move(s), m, query::full_partition_range)
+        , iterator_reader(std::move(s), m, range)
         , _flushed_memory(*m)
     {}
     flush_reader(const flush_reader&) = delete;
@@ -753,17 +753,41 @@ memtable::make_mutation_reader_opt(schema_ptr query_schema,
 }
 
 mutation_reader
-memtable::make_flush_reader(schema_ptr s, reader_permit permit) {
+memtable::make_flush_reader(schema_ptr s, reader_permit permit, const dht::partition_range& range) {
     if (!_merged_into_cache) {
         revert_flushed_memory();
-        return make_mutation_reader<flush_reader>(std::move(s), std::move(permit), shared_from_this());
+        return make_mutation_reader<flush_reader>(std::move(s), std::move(permit), shared_from_this(), range);
     } else {
         auto& full_slice = s->full_slice();
         return make_mutation_reader<scanning_reader>(std::move(s), shared_from_this(), std::move(permit),
-                      query::full_partition_range, full_slice, mutation_reader::forwarding::no);
+                      range, full_slice, mutation_reader::forwarding::no);
     }
 }
 
+dht::partition_range_vector
+memtable::make_flush_ranges(unsigned n) const {
+    n = std::min<size_t>(n, nr_partitions);
+    if (n <= 1) {
+        return {query::full_partition_range};
+    }
+    auto first = partitions.begin()->key().token().unbias();
+    auto last = std::prev(partitions.end())->key().token().unbias();
+    auto step = (last - first) / n;
+    if (step == 0) {
+        return {query::full_partition_range};
+    }
+    dht::partition_range_vector ranges;
+    ranges.reserve(n);
+    std::optional<dht::partition_range::bound> start;
+    for (unsigned i = 1; i < n; ++i) {
+        auto boundary = dht::ring_position::starting_at(dht::token::bias(first + i * step));
+        ranges.emplace_back(std::move(start), dht::partition_range::bound(boundary, false));
+        start = dht::partition_range::bound(std::move(boundary), true);
+    }
+    ranges.emplace_back(std::move(start), std::nullopt);
+    return ranges;
+}
+
 void
 memtable::update(db::rp_handle&& h) {
     db::replay_position rp = h;
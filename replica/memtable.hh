@@ -329,7 +329,16 @@ class memtable final
         return make_mutation_reader(s, std::move(permit), range, full_slice);
     }
 
-    mutation_reader make_flush_reader(schema_ptr, reader_permit permit);
+    // The range must be kept alive until the reader is closed.
+    // Flush readers of disjoint ranges can be used to flush the memtable in parallel,
+    // but they all have to be created before any of them is read from.
+    mutation_reader make_flush_reader(schema_ptr, reader_permit permit,
+                                      const dht::partition_range& range = query::full_partition_range);
+
+    // Splits the memtable into at most n consecutive partition ranges, which cover
+    // the whole ring, for flushing them in parallel. Tokens are assumed to be evenly
+    // distributed, so the ranges hold roughly the same number of partitions.
+    dht::partition_range_vector make_flush_ranges(unsigned n) const;
 
     mutation_source as_data_source();
 
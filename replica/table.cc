@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
  */
 
+#include <set>
+
 #include <seastar/core/seastar.hh>
 #include <seastar/core/shard_id.hh>
 #include <seastar/core/coroutine.hh>
@@ -18,6 +20,7 @@
 #include <seastar/core/bitops.hh>
 #include <seastar/util/closeable.hh>
 #include <seastar/util/defer.hh>
+#include <seastar/util/read_entire_file.hh>
 
 #include "dht/decorated_key.hh"
 #include "readers/mutation_reader.hh"
@@ -25,6 +28,8 @@
 #include "replica/data_dictionary_impl.hh"
 #include "replica/compaction_group.hh"
 #include "replica/logstor/compaction.hh"
+#include "replica/logstor/compression.hh"
+#include "replica/logstor/segment_manager.hh"
 #include "replica/query_state.hh"
 #include "sstables/shared_sstable.hh"
 #include "sstables/sstable_set.hh"
@@ -1662,6 +1667,27 @@ future<utils::chunked_vector<sstables::shared_sstable>> table::take_sstable_set_
     co_return result;
 }
 
+table::local_index_sources table::get_local_index_sources(const dht::partition_range_vector& ranges) const {
+    local_index_sources ret;
+    std::unordered_set<const storage_group*> seen;
+    for (const auto& range : ranges) {
+        for (auto& sg : storage_groups_for_token_range(range.transform(std::mem_fn(&dht::ring_position::token)))) {
+            if (!seen.insert(sg.get()).second) {
+                continue;
+            }
+            sg->make_sstable_set()->for_each_sstable([&] (const sstables::shared_sstable& sst) {
+                ret.sstables.push_back(sst);
+            });
+            sg->for_each_compaction_group([&] (const compaction_group_ptr& cg) {
+                for (auto& mt : *cg->memtables()) {
+                    ret.memtables.push_back(mt);
+                }
+            });
+        }
+    }
+    return ret;
+}
+
 future<utils::chunked_vector<logstor::segment_snapshot>> table::take_logstor_snapshot(dht::token_range tr) {
     utils::chunked_vector<logstor::segment_snapshot> snp;
     for (auto& sg : storage_groups_for_token_range(tr)) {
@@ -2135,7 +2161,14 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
     auto metadata = mutation_source_metadata{};
     metadata.min_timestamp = old->get_min_timestamp();
     metadata.max_timestamp = old->get_max_timestamp();
+    // Large memtables are split into token ranges, which are written into separate
+    // sstables concurrently. Each range has to be worth the overhead of an sstable.
+    static constexpr uint64_t min_flush_range_size = 32 << 20;
+    auto flush_concurrency = std::min<uint64_t>(std::max<uint32_t>(_config.memtable_flush_concurrency(), 1),
+            std::max<uint64_t>(old->occupancy().used_space() / min_flush_range_size, 1));
+    auto flush_ranges = old->make_flush_ranges(flush_concurrency);
     auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, old->partition_count(), _schema);
+    estimated_partitions = (estimated_partitions + flush_ranges.size() - 1) / flush_ranges.size();
 
     if (!cg.async_gate().is_closed()) {
         co_await _compaction_manager.maybe_wait_for_sstable_count_reduction(cg.view_for_unrepaired_data());
@@ -2162,9 +2195,31 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
       co_await coroutine::return_exception_ptr(std::move(ex));
     });
 
-    auto f = consumer(old->make_flush_reader(
-        old->schema(),
-        compaction_concurrency_semaphore().make_tracking_only_permit(old->schema(), "try_flush_memtable_to_sstable()", db::no_timeout, {})));
+    auto read_permit = compaction_concurrency_semaphore().make_tracking_only_permit(old->schema(), "try_flush_memtable_to_sstable()", db::no_timeout, {});
+    // All the flush readers have to be created before any of them is read from.
+    std::vector<mutation_reader> readers;
+    readers.reserve(flush_ranges.size());
+    std::exception_ptr ex;
+    try {
+        for (const auto& range : flush_ranges) {
+            readers.push_back(old->make_flush_reader(old->schema(), read_permit, range));
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        co_await coroutine::parallel_for_each(readers, [] (mutation_reader& reader) {
+            return reader.close();
+        });
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    if (readers.size() > 1) {
+        tlogger.debug("Flushing memtable of {}.{} into {} token ranges in parallel", old->schema()->ks_name(), old->schema()->cf_name(), readers.size());
+    }
+
+    auto f = parallel_for_each(readers, [&consumer] (mutation_reader& reader) {
+        return consumer(std::move(reader));
+    });
 
     // Switch back to default scheduling group for post-flush actions, to avoid them being staved by the memtable flush
     // controller. Cache update does not affect the input of the memtable cpu controller, so it can be subject to
@@ -2806,6 +2861,8 @@ future<logstor::table_segment_stats> table::get_logstor_segment_stats() const {
 
         result.compaction_group_count++;
         result.segment_count += cg_segments.segment_count();
+        result.separator_data_bytes_written += cg_segments._separator_data_bytes_written;
+        result.compaction_data_bytes_written += cg_segments._compaction_data_bytes_written;
 
         for (const auto& desc : cg_segments._segments) {
             co_await coroutine::maybe_yield();
@@ -4219,6 +4276,135 @@ class local_snapshot_writer : public snapshot_writer {
     }
 };
 
+static future<> copy_to_snapshot(input_stream<char> in, snapshot_writer& writer, sstring component) {
+    auto out = co_await writer.stream_for(std::move(component));
+    std::exception_ptr ex;
+    try {
+        co_await seastar::copy(in, out);
+        co_await out.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await in.close();
+    co_await out.close();
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+}
+
+// Logstor segments are regions of large files that are shared by all the tables
+// of the shard, so unlike sstables they can't be hard-linked into the snapshot.
+// Each sealed segment of the table is copied into its own file instead. The file
+// is an image of the segment, so it can be streamed back as is, and the receiving
+// side rebuilds the index from the record headers, like in tablet migration.
+//
+// Returns the compression dictionaries known to the shard, which the records
+// of the segments may need to be read.
+static future<std::vector<std::filesystem::path>> snapshot_logstor_segments(table& t, snapshot_writer& writer, const sstring& name) {
+    co_await t.flush_separator();
+    auto segments = co_await t.take_logstor_snapshot(dht::token_range::make_open_ended_both_sides());
+    tlogger.debug("snapshot {}: copying {} logstor segments", name, segments.size());
+
+    const auto opts = file_input_stream_options{.buffer_size = 128 * 1024, .read_ahead = 2};
+    for (auto& seg : segments) {
+        co_await copy_to_snapshot(co_await seg.source(opts), writer,
+                logstor::segment_snapshot_file_name(this_shard_id(), seg.segment_id));
+    }
+    co_return logstor::local_record_compression().dictionary_files();
+}
+
+// The dictionaries are kept in the logstor directory, which is shared by all
+// shards, so they are copied once, under their own names.
+static future<> snapshot_logstor_dictionaries(snapshot_writer& writer, const std::vector<std::vector<std::filesystem::path>>& dictionaries_on_shards, const sstring& name) {
+    std::set<std::filesystem::path> dictionaries;
+    for (const auto& shard_dictionaries : dictionaries_on_shards) {
+        dictionaries.insert(shard_dictionaries.begin(), shard_dictionaries.end());
+    }
+    tlogger.debug("snapshot {}: copying {} logstor dictionaries", name, dictionaries.size());
+    for (const auto& path : dictionaries) {
+        auto f = co_await open_checked_file_dma(general_disk_error_handler, path.native(), open_flags::ro);
+        co_await copy_to_snapshot(make_file_input_stream(std::move(f)), writer, path.filename().native());
+    }
+}
+
+future<> database::load_logstor_upload_dir(sharded<database>& sharded_db, table_id tid) {
+    auto upload_dir = std::visit(overloaded_functor{
+        [] (const data_dictionary::storage_options::local& loc) {
+            return loc.dir / sstables::upload_dir;
+        },
+        [] (const data_dictionary::storage_options::s3&) -> std::filesystem::path {
+            throw std::runtime_error("Loading logstor segments of non-local tables is not implemented");
+        }
+    }, sharded_db.local().find_column_family(tid).get_storage_options().value);
+
+    std::vector<std::filesystem::path> dictionaries;
+    std::vector<std::vector<std::filesystem::path>> segments_on_shards(smp::count);
+    co_await lister::scan_dir(upload_dir, lister::dir_entry_types::of<directory_entry_type::regular>(), [&] (std::filesystem::path dir, directory_entry de) {
+        if (logstor::is_dictionary_file_name(de.name)) {
+            dictionaries.push_back(dir / de.name);
+        } else if (logstor::is_segment_snapshot_file_name(de.name)) {
+            // The segment was snapshotted by the shard in its name, which
+            // owned the records when the snapshot was taken.
+            auto shard = logstor::segment_snapshot_file_shard(de.name);
+            if (!shard) {
+                throw std::runtime_error(format("Malformed logstor segment file name {}", de.name));
+            }
+            if (*shard >= smp::count) {
+                throw std::runtime_error(format("Can't load logstor segment {} of shard {} on a node with {} shards", de.name, *shard, smp::count));
+            }
+            segments_on_shards[*shard].push_back(dir / de.name);
+        }
+        return make_ready_future<>();
+    });
+
+    if (dictionaries.empty() && std::ranges::all_of(segments_on_shards, [] (const auto& segments) { return segments.empty(); })) {
+        co_return;
+    }
+
+    // The dictionaries are needed for reading the records of the segments,
+    // so they are added before the segments.
+    for (const auto& path : dictionaries) {
+        auto content = co_await util::read_entire_file_contiguous(path);
+        auto dict = std::as_bytes(std::span(content.data(), content.size()));
+        co_await add_logstor_compression_dictionary_on_all_shards(sharded_db, std::vector<std::byte>(dict.begin(), dict.end()));
+    }
+
+    co_await sharded_db.invoke_on_all([tid, &segments_on_shards] (database& db) -> future<> {
+        auto& t = db.find_column_family(tid);
+        for (const auto& path : segments_on_shards[this_shard_id()]) {
+            tlogger.debug("Loading logstor segment {} of {}.{}", path.native(), t.schema()->ks_name(), t.schema()->cf_name());
+            auto sink = co_await t.create_logstor_segment_sink(db);
+            std::exception_ptr ex;
+            try {
+                auto f = co_await open_checked_file_dma(general_disk_error_handler, path.native(), open_flags::ro);
+                auto in = make_file_input_stream(std::move(f));
+                auto out = co_await sink->output();
+                try {
+                    co_await seastar::copy(in, out);
+                    co_await out.flush();
+                } catch (...) {
+                    ex = std::current_exception();
+                }
+                co_await in.close();
+                co_await out.close();
+            } catch (...) {
+                ex = std::current_exception();
+            }
+            if (ex) {
+                co_await sink->abort();
+                co_await coroutine::return_exception_ptr(std::move(ex));
+            }
+            co_await sink->close();
+            co_await remove_file(path.native());
+        }
+    });
+
+    for (const auto& path : dictionaries) {
+        co_await remove_file(path.native());
+    }
+    co_await sync_directory(upload_dir.native());
+}
+
 // Runs the orchestration code on an arbitrary shard to balance the load.
 future<> database::snapshot_table_on_all_shards(sharded<database>& sharded_db, const global_table_ptr& table_shards, sstring name, db::snapshot_options opts, snapshot_callback ssc) {
     auto writer = std::visit(overloaded_functor{
@@ -4245,14 +4431,21 @@ future<> database::snapshot_table_on_all_shards(sharded<database>& sharded_db, c
         tlogger.debug("Taking snapshot of {}.{}: name={}", s->ks_name(), s->cf_name(), name);
 
         std::vector<snapshot_sstable_set> sstable_sets(this_smp_shard_count());
+        std::vector<std::vector<std::filesystem::path>> logstor_dictionaries(this_smp_shard_count());
 
         co_await writer->init();
         co_await smp::invoke_on_all([&] -> future<> {
             auto& t = *table_shards;
+            if (t.uses_logstor()) {
+                logstor_dictionaries[this_shard_id()] = co_await snapshot_logstor_segments(t, *writer, name);
+            }
             auto [tables, permit] = co_await t.snapshot_sstables();
             auto sstables_metadata = co_await t.get_sstables_manager().take_snapshot(std::move(tables), name);
             sstable_sets[this_shard_id()] = make_foreign(std::make_unique<utils::chunked_vector<sstables::sstable_snapshot_metadata>>(std::move(sstables_metadata)));
         });
+        if (t.uses_logstor()) {
+            co_await snapshot_logstor_dictionaries(*writer, logstor_dictionaries, name);
+        }
         co_await writer->sync();
 
         std::exception_ptr ex;
@@ -36,6 +36,7 @@
 #include "utils/rjson.hh"
 #include "tombstone_gc_options.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/value_log_extension.hh"
 #include "db/tags/utils.hh"
 #include "db/tags/extension.hh"
 #include "index/target_parser.hh"
@@ -609,6 +610,7 @@ bool operator==(const schema::user_properties& lhs, const schema::user_propertie
         && lhs.compaction_strategy_options == rhs.compaction_strategy_options
         && lhs.compaction_enabled == rhs.compaction_enabled
         && lhs.storage_engine == rhs.storage_engine
+        && lhs.filter_type == rhs.filter_type
         && lhs.caching_options == rhs.caching_options
         && lhs.tablet_options == rhs.tablet_options
         && lhs.get_paxos_grace_seconds() == rhs.get_paxos_grace_seconds()
@@ -716,6 +718,10 @@ table_schema_version schema::calculate_digest(const schema::raw_schema& r) {
     feed_hash(h, r._indices_by_name);
     feed_hash(h, r._is_counter);
     feed_hash(h, r._props.storage_engine);
+    // Fed only when non-default, so that the version of existing tables doesn't change.
+    if (r._props.filter_type != sstable_filter_type::bloom) {
+        feed_hash(h, r._props.filter_type);
+    }
 
     for (auto&& [name, ext] : r._props.extensions) {
         feed_hash(h, name);
@@ -909,6 +915,9 @@ auto fmt::formatter<schema>::format(const schema& s, fmt::format_context& ctx) c
     if (s.storage_engine() != storage_engine_type::normal) {
         out = fmt::format_to(out, ",storage_engine={}", storage_engine_type_to_sstring(s.storage_engine()));
     }
+    if (s.filter_type() != sstable_filter_type::bloom) {
+        out = fmt::format_to(out, ",filterType={}", sstable_filter_type_to_sstring(s.filter_type()));
+    }
     out = fmt::format_to(out, ",tablets={{");
     if (s._raw._props.tablet_options) {
         n = 0;
@@ -1248,6 +1257,9 @@ fragmented_ostringstream& schema::schema_properties(const schema_describe_helper
 
     os << "\n    AND crc_check_chance = " << fmt::to_string(crc_check_chance());
     os << "\n    AND default_time_to_live = " << fmt::to_string(default_time_to_live().count());
+    if (filter_type() != sstable_filter_type::bloom) {
+        os << "\n    AND filter_type = '" << sstable_filter_type_to_sstring(filter_type()) << "'";
+    }
     os << "\n    AND gc_grace_seconds = " << fmt::to_string(gc_grace_seconds().count());
     os << "\n    AND max_index_interval = " << fmt::to_string(max_index_interval());
     os << "\n    AND memtable_flush_period_in_ms = " << fmt::to_string(memtable_flush_period());
@@ -1745,6 +1757,13 @@ schema_ptr schema_builder::build(schema::raw_schema& new_raw) {
         new_raw._per_partition_rate_limit_options = ext->get_options();
     }
 
+    // cache the `value_log` parameters, they are checked for every written cell.
+    if (auto ext = get_schema_extension<db::value_log_extension>(
+                new_raw._props.extensions,
+                db::value_log_extension::NAME)) {
+        new_raw._value_log_options = ext->get_options();
+    }
+
     if (_static_props.use_null_sharder) {
         new_raw._sharder = get_sharder(1, 0);
     }
@@ -1879,6 +1898,11 @@ schema_builder& schema_builder::with_per_partition_rate_limit_options(const db::
     return *this;
 }
 
+schema_builder& schema_builder::with_value_log_options(const db::value_log_options& opts) {
+    add_extension(db::value_log_extension::NAME, ::make_shared<db::value_log_extension>(opts));
+    return *this;
+}
+
 schema_builder& schema_builder::set_paxos_grace_seconds(int32_t seconds) {
     add_extension(db::paxos_grace_seconds_extension::NAME, ::make_shared<db::paxos_grace_seconds_extension>(seconds));
     return *this;
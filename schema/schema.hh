@@ -31,6 +31,7 @@
 #include "mutation/timestamp.hh"
 #include "tombstone_gc_options.hh"
 #include "db/per_partition_rate_limit_options.hh"
+#include "db/value_log_options.hh"
 #include "db/tablet_options.hh"
 #include "schema_fwd.hh"
 #include "db/view/base_info.hh"
@@ -191,6 +192,35 @@ inline sstring storage_engine_type_to_sstring(storage_engine_type t) {
     throw std::invalid_argument(format("unknown storage engine type: {:d}\n", uint8_t(t)));
 }
 
+// The kind of filter sstables of a table use for skipping partitions they don't hold.
+enum class sstable_filter_type {
+    bloom,
+    // See utils::filter::binary_fuse_filter. Smaller than a bloom filter with the same
+    // false-positive chance, but only sstables whose filter is built after all their
+    // keys are known (i.e. those with a BTI index) use it, others use a bloom filter.
+    binary_fuse,
+};
+
+inline sstring sstable_filter_type_to_sstring(sstable_filter_type t) {
+    switch (t) {
+    case sstable_filter_type::bloom:
+        return "bloom";
+    case sstable_filter_type::binary_fuse:
+        return "binary_fuse";
+    }
+    throw std::invalid_argument(format("unknown sstable filter type: {:d}\n", uint8_t(t)));
+}
+
+inline std::optional<sstable_filter_type> sstable_filter_type_from_sstring(std::string_view name) {
+    if (name == "bloom") {
+        return sstable_filter_type::bloom;
+    }
+    if (name == "binary_fuse") {
+        return sstable_filter_type::binary_fuse;
+    }
+    return std::nullopt;
+}
+
 using index_options_map = std::unordered_map<sstring, sstring>;
 
 enum class index_metadata_kind {
@@ -549,6 +579,7 @@ class schema final : public enable_lw_shared_from_this<schema> {
         std::map<sstring, sstring> compaction_strategy_options;
         bool compaction_enabled = true;
         storage_engine_type storage_engine = storage_engine_type::normal;
+        sstable_filter_type filter_type = sstable_filter_type::bloom;
         ::caching_options caching_options;
         std::optional<std::map<sstring, sstring>> tablet_options;
 
@@ -575,6 +606,7 @@ class schema final : public enable_lw_shared_from_this<schema> {
         bool _is_counter = false;
         cf_type _type = cf_type::standard;
         db::per_partition_rate_limit_options _per_partition_rate_limit_options;
+        db::value_log_options _value_log_options;
         table_schema_version _version;
         std::unordered_map<sstring, dropped_column> _dropped_columns;
         std::map<bytes, data_type> _collections;
@@ -773,6 +805,10 @@ class schema final : public enable_lw_shared_from_this<schema> {
         return _raw._props.storage_engine == storage_engine_type::logstor;
     }
 
+    sstable_filter_type filter_type() const {
+        return _raw._props.filter_type;
+    }
+
     const cdc::options& cdc_options() const {
         return _raw._props.get_cdc_options();
     }
@@ -787,6 +823,10 @@ class schema final : public enable_lw_shared_from_this<schema> {
         return _raw._per_partition_rate_limit_options;
     }
 
+    const db::value_log_options& value_log_options() const {
+        return _raw._value_log_options;
+    }
+
     bool large_data_guardrails_enabled() const {
         return _raw._large_data_guardrails_enabled;
     }
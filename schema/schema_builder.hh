@@ -284,6 +284,11 @@ struct schema_builder {
         return *this;
     }
 
+    schema_builder& set_filter_type(sstable_filter_type type) {
+        _raw._props.filter_type = type;
+        return *this;
+    }
+
     class default_names {
     public:
         default_names(const schema_builder&);
@@ -340,6 +345,7 @@ struct schema_builder {
     schema_builder& with_cdc_options(const cdc::options&);
     schema_builder& with_tombstone_gc_options(const tombstone_gc_options& opts);
     schema_builder& with_per_partition_rate_limit_options(const db::per_partition_rate_limit_options&);
+    schema_builder& with_value_log_options(const db::value_log_options&);
 
     default_names get_default_names() const {
         return default_names(_raw);
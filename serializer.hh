@@ -17,6 +17,7 @@
 #include <boost/variant/variant.hpp>
 #include "bytes_ostream.hh"
 #include "utils/fragment_range.hh"
+#include <bit>
 #include <variant>
 
 #include <type_traits>
@@ -246,6 +247,21 @@ template<> struct serializer<uint32_t> : public integral_serializer<uint32_t> {}
 template<> struct serializer<int64_t> : public integral_serializer<int64_t> {};
 template<> struct serializer<uint64_t> : public integral_serializer<uint64_t> {};
 
+template<> struct serializer<float> {
+    template <typename Input>
+    static float read(Input& i) {
+        return std::bit_cast<float>(deserialize_integral<uint32_t>(i));
+    }
+    template <typename Output>
+    static void write(Output& out, float v) {
+        serialize_integral(out, std::bit_cast<uint32_t>(v));
+    }
+    template <typename Input>
+    static void skip(Input& i) {
+        read(i);
+    }
+};
+
 template<typename Output>
 void safe_serialize_as_uint32(Output& output, uint64_t data);
 
@@ -14,6 +14,7 @@
 
 #include <fmt/ranges.h>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/when_any.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/util/later.hh>
 #include <seastar/coroutine/try_future.hh>
@@ -58,6 +59,7 @@
 #include "db/timeout_clock.hh"
 #include "replica/multishard_query.hh"
 #include "replica/database.hh"
+#include "replica/local_index.hh"
 #include "db/consistency_level_validations.hh"
 #include "cdc/log.hh"
 #include "cdc/stats.hh"
@@ -178,6 +180,14 @@ static future<ResultTuple> add_replica_exception_to_query_result(const gms::feat
     return encode_replica_exception_for_rpc<ResultTuple>(features, f.get_exception());
 }
 
+// The results a replica returns for the partitions of a read_data_multi request.
+static query::result_options multi_partition_result_options(query::digest_algorithm da, bool only_digest) {
+    if (only_digest) {
+        return query::result_options::only_digest(da);
+    }
+    return query::result_options{da == query::digest_algorithm::none ? query::result_request::only_result : query::result_request::result_and_digest, da};
+}
+
 gms::inet_address storage_proxy::my_address() const noexcept {
     return _shared_token_metadata.get()->get_topology().my_address();
 }
@@ -275,6 +285,8 @@ class storage_proxy::remote {
         ser::storage_proxy_rpc_verbs::register_read_data(&_ms, std::bind_front(&remote::handle_read_data, this));
         ser::storage_proxy_rpc_verbs::register_read_mutation_data(&_ms, std::bind_front(&remote::handle_read_mutation_data, this));
         ser::storage_proxy_rpc_verbs::register_read_digest(&_ms, std::bind_front(&remote::handle_read_digest, this));
+        ser::storage_proxy_rpc_verbs::register_read_data_multi(&_ms, std::bind_front(&remote::handle_read_data_multi, this));
+        ser::storage_proxy_rpc_verbs::register_local_index_search(&_ms, std::bind_front(&remote::handle_local_index_search, this));
         ser::storage_proxy_rpc_verbs::register_truncate(&_ms, std::bind_front(&remote::handle_truncate, this));
         ser::storage_proxy_rpc_verbs::register_truncate_with_tablets(&_ms, std::bind_front(&remote::handle_truncate_with_tablets, this));
         ser::storage_proxy_rpc_verbs::register_snapshot_with_tablets(&_ms, std::bind_front(&remote::handle_snapshot_with_tablets, this));
@@ -419,6 +431,27 @@ class storage_proxy::remote {
         co_return rpc::tuple{make_foreign(::make_lw_shared<query::result>(std::move(result))), hit_rate.value_or(cache_temperature::invalid())};
     }
 
+    future<std::vector<foreign_ptr<lw_shared_ptr<query::result>>>>
+    send_read_data_multi(
+            locator::host_id addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
+            const std::vector<query::read_command>& cmds, const dht::partition_range_vector& prs,
+            query::digest_algorithm digest_algo, bool only_digest, fencing_token fence) {
+        auto&& [results, exception] =
+            co_await ser::storage_proxy_rpc_verbs::send_read_data_multi(&_ms, addr, timeout, cmds, prs, digest_algo, only_digest, fence);
+        if (exception) {
+            co_await coroutine::return_exception_ptr(exception.into_exception_ptr());
+        }
+
+        co_return results | std::views::transform([] (query::result& r) {
+            return make_foreign(::make_lw_shared<query::result>(std::move(r)));
+        }) | std::ranges::to<std::vector>();
+    }
+
+    future<replica::local_index_result>
+    send_local_index_search(locator::host_id addr, storage_proxy::clock_type::time_point timeout, const replica::local_index_request& req) {
+        return ser::storage_proxy_rpc_verbs::send_local_index_search(&_ms, addr, timeout, req);
+    }
+
     future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature, std::optional<full_position>>>
     send_read_digest(
             locator::host_id addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
@@ -983,6 +1016,94 @@ class storage_proxy::remote {
             std::move(pr), oda, rate_limit_info_opt, fence);
     }
 
+    using read_data_multi_result_t = rpc::tuple<std::vector<query::result>, replica::exception_variant>;
+    future<read_data_multi_result_t> handle_read_data_multi(
+            const rpc::client_info& cinfo, rpc::opt_time_point t,
+            std::vector<query::read_command> cmds1, dht::partition_range_vector prs,
+            query::digest_algorithm da, bool only_digest, service::fencing_token fence) {
+        tracing::trace_state_ptr trace_state_ptr;
+        auto src_addr = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+        auto src_shard = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+        shared_ptr<storage_proxy> p = _sp.shared_from_this();
+
+        auto invalid = [&] (sstring msg) {
+            return encode_replica_exception_for_rpc<read_data_multi_result_t>(p->features(),
+                    std::make_exception_ptr(std::runtime_error(format("READ_DATA_MULTI called with {}", msg))));
+        };
+        if (cmds1.empty() || cmds1.size() != prs.size()) {
+            co_return co_await invalid(format("{} commands for {} partition ranges", cmds1.size(), prs.size()));
+        }
+        if (only_digest && da == query::digest_algorithm::none) {
+            co_return co_await invalid("only_digest and no digest algorithm");
+        }
+        if (cmds1.front().trace_info) {
+            trace_state_ptr = tracing::tracing::get_local_tracing_instance().create_session(*cmds1.front().trace_info);
+            tracing::begin(trace_state_ptr);
+            tracing::trace(trace_state_ptr, "read_data_multi: message received from /{}", src_addr);
+        }
+
+        if (auto f = _sp.apply_fence_result<read_data_multi_result_t>(fence, src_addr)) {
+            co_return co_await std::move(*f);
+        }
+
+        auto timeout = t ? *t : db::no_timeout;
+        auto f_s = co_await coroutine::as_future(get_schema_for_read(cmds1.front().schema_version, src_addr, src_shard, timeout));
+        if (f_s.failed()) {
+            co_return co_await encode_replica_exception_for_rpc<read_data_multi_result_t>(p->features(), f_s.get_exception());
+        }
+        schema_ptr s = f_s.get();
+
+        auto& cfg = _sp.local_db().get_config();
+        std::vector<lw_shared_ptr<query::read_command>> cmds;
+        cmds.reserve(cmds1.size());
+        for (size_t i = 0; i < cmds1.size(); ++i) {
+            if (cmds1[i].schema_version != s->version()) {
+                co_return co_await invalid("commands of different schema versions");
+            }
+            if (!prs[i].is_singular()) {
+                co_return co_await invalid("a non-singular range");
+            }
+            if (!cmds1[i].max_result_size) {
+                cmds1[i].max_result_size.emplace(cfg.max_memory_for_unlimited_query_soft_limit(), cfg.max_memory_for_unlimited_query_hard_limit());
+            }
+            cmds.push_back(make_lw_shared<query::read_command>(std::move(cmds1[i])));
+        }
+
+        // This erm ensures that tablet migrations wait for replica requests,
+        // even if the coordinator is no longer available.
+        auto erm = s->table().get_effective_replication_map();
+        p->get_stats().replica_multi_data_reads++;
+        auto f = co_await coroutine::as_future(p->query_result_local_multi(std::move(erm), std::move(s), std::move(cmds), std::move(prs),
+                multi_partition_result_options(da, only_digest), trace_state_ptr, timeout));
+        tracing::trace(trace_state_ptr, "read_data_multi handling is done, sending a response to /{}", src_addr);
+
+        if (auto f = _sp.apply_fence_result<read_data_multi_result_t>(fence, src_addr)) {
+            co_return co_await std::move(*f);
+        }
+        if (f.failed()) {
+            co_return co_await encode_replica_exception_for_rpc<read_data_multi_result_t>(p->features(), f.get_exception());
+        }
+        co_return rpc::tuple(f.get() | std::views::transform([] (foreign_ptr<lw_shared_ptr<query::result>>& r) {
+            return std::move(*r);
+        }) | std::ranges::to<std::vector>(), replica::exception_variant{});
+    }
+
+    future<replica::local_index_result> handle_local_index_search(const rpc::client_info& cinfo, rpc::opt_time_point t, replica::local_index_request req) {
+        tracing::trace_state_ptr trace_state_ptr;
+        auto src_addr = cinfo.retrieve_auxiliary<locator::host_id>("host_id");
+        auto src_shard = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+        if (req.trace_info) {
+            trace_state_ptr = tracing::tracing::get_local_tracing_instance().create_session(*req.trace_info);
+            tracing::begin(trace_state_ptr);
+            tracing::trace(trace_state_ptr, "local_index_search: message received from /{}", src_addr);
+        }
+        auto timeout = t ? *t : db::no_timeout;
+        auto s = co_await get_schema_for_read(req.schema_version, src_addr, src_shard, timeout);
+        auto result = co_await _sp.query_local_index_locally(std::move(s), req, timeout, trace_state_ptr);
+        tracing::trace(trace_state_ptr, "local_index_search handling is done, sending a response to /{}", src_addr);
+        co_return result;
+    }
+
     future<> handle_truncate(rpc::opt_time_point timeout, sstring ksname, sstring cfname) {
         co_await replica::database::truncate_table_on_all_shards(_sp._db, _sys_ks, ksname, cfname);
     }
@@ -3137,6 +3258,14 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of speculative data read requests that were sent"),
                        {storage_proxy_stats::current_scheduling_group_label(), basic_level}).set_skip_when_empty(),
 
+        sm::make_total_operations("multi_partition_reads", multi_partition_reads,
+                       sm::description("number of read requests for several partitions that were sent to a replica"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("multi_partition_read_fallbacks", multi_partition_read_fallbacks,
+                       sm::description("number of partitions of multi-partition reads that were read again on their own, because a replica failed or the replicas disagreed"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_summary("cas_read_latency_summary", sm::description("CAS read latency summary"), [this] {return to_metrics_summary(cas_read.summary());})(storage_proxy_stats::current_scheduling_group_label())(basic_level)(cas_label).set_skip_when_empty(),
         sm::make_summary("cas_write_latency_summary", sm::description("CAS write latency summary"), [this] {return to_metrics_summary(cas_write.summary());})(storage_proxy_stats::current_scheduling_group_label())(basic_level)(cas_label).set_skip_when_empty(),
 
@@ -3232,17 +3361,21 @@ void storage_proxy_stats::stats::register_stats() {
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
         sm::make_total_operations("reads", replica_data_reads,
-                       sm::description("number of remote reads this Node received. op_type label could be data, mutation_data or digest"),
+                       sm::description("number of remote reads this Node received. op_type label could be data, mutation_data, multi_data or digest"),
                        {storage_proxy_stats::current_scheduling_group_label(), storage_proxy_stats::op_type_label("data")}).set_skip_when_empty(),
 
         sm::make_total_operations("reads", replica_mutation_data_reads,
-                       sm::description("number of remote reads this Node received. op_type label could be data, mutation_data or digest"),
+                       sm::description("number of remote reads this Node received. op_type label could be data, mutation_data, multi_data or digest"),
                        {storage_proxy_stats::current_scheduling_group_label(), storage_proxy_stats::op_type_label("mutation_data")}).set_skip_when_empty(),
 
         sm::make_total_operations("reads", replica_digest_reads,
-                       sm::description("number of remote reads this Node received. op_type label could be data, mutation_data or digest"),
+                       sm::description("number of remote reads this Node received. op_type label could be data, mutation_data, multi_data or digest"),
                        {storage_proxy_stats::current_scheduling_group_label(), storage_proxy_stats::op_type_label("digest")}).set_skip_when_empty(),
 
+        sm::make_total_operations("reads", replica_multi_data_reads,
+                       sm::description("number of remote reads this Node received. op_type label could be data, mutation_data, multi_data or digest"),
+                       {storage_proxy_stats::current_scheduling_group_label(), storage_proxy_stats::op_type_label("multi_data")}).set_skip_when_empty(),
+
         sm::make_total_operations("cross_shard_ops", replica_cross_shard_ops,
                        sm::description("number of operations that crossed a shard boundary"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -6324,6 +6457,46 @@ storage_proxy::query_result_local(locator::effective_replication_map_ptr erm, sc
     }
 }
 
+future<std::vector<foreign_ptr<lw_shared_ptr<query::result>>>>
+storage_proxy::query_result_local_multi(locator::effective_replication_map_ptr erm, schema_ptr query_schema,
+        std::vector<lw_shared_ptr<query::read_command>> cmds, dht::partition_range_vector prs, query::result_options opts,
+        tracing::trace_state_ptr trace_state, storage_proxy::clock_type::time_point timeout) {
+    // Each shard reads its partitions in parallel with the other shards, and
+    // receives them with a single cross-shard message.
+    const auto& sharder = erm->get_sharder(*query_schema);
+    std::vector<std::vector<size_t>> partitions_by_shard(smp::count);
+    for (size_t i = 0; i < prs.size(); ++i) {
+        cmds[i]->slice.options.set_if<query::partition_slice::option::with_digest>(opts.request != query::result_request::only_result);
+        partitions_by_shard[sharder.shard_for_reads(prs[i].start()->value().token())].push_back(i);
+    }
+    tracing::trace(trace_state, "Start querying {} singular ranges", prs.size());
+    std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results(prs.size());
+    co_await coroutine::parallel_for_each(std::views::iota(0u, smp::count), [&] (unsigned shard) -> future<> {
+        const auto& partitions = partitions_by_shard[shard];
+        if (partitions.empty()) {
+            co_return;
+        }
+        get_stats().replica_cross_shard_ops += shard != this_shard_id();
+        auto shard_results = co_await _db.invoke_on(shard, _read_smp_service_group, [&, gs = global_schema_ptr(query_schema), gt = tracing::global_trace_state_ptr(trace_state)] (replica::database& db)
+                -> future<std::vector<foreign_ptr<lw_shared_ptr<query::result>>>> {
+            schema_ptr s = gs;
+            auto trace_state = gt.get();
+            std::vector<foreign_ptr<lw_shared_ptr<query::result>>> shard_results(partitions.size());
+            co_await coroutine::parallel_for_each(std::views::iota(size_t(0), partitions.size()), [&] (size_t j) -> future<> {
+                const auto i = partitions[j];
+                auto [r, ht] = co_await db.query(s, *cmds[i], opts, dht::partition_range_vector({prs[i]}), trace_state, timeout, std::monostate());
+                shard_results[j] = make_foreign(std::move(r));
+            });
+            co_return shard_results;
+        });
+        for (size_t j = 0; j < partitions.size(); ++j) {
+            results[partitions[j]] = std::move(shard_results[j]);
+        }
+    });
+    tracing::trace(trace_state, "Querying is done");
+    co_return results;
+}
+
 void storage_proxy::handle_read_error(std::variant<exceptions::coordinator_exception_container, std::exception_ptr> failure, bool range) {
     // All errors are handled, it's OK to discard the result.
     (void)utils::result_try([&] () -> result<> {
@@ -6822,6 +6995,253 @@ storage_proxy::query_result(schema_ptr query_schema,
     return do_query(query_schema, cmd, std::move(partition_ranges), cl, std::move(query_options), std::move(shard));
 }
 
+std::vector<future<result<storage_proxy::coordinator_query_result>>>
+storage_proxy::query_partitions(schema_ptr s,
+    std::vector<lw_shared_ptr<query::read_command>> cmds,
+    dht::partition_range_vector partition_ranges,
+    db::consistency_level cl,
+    storage_proxy::coordinator_query_options query_options)
+{
+    SCYLLA_ASSERT(cmds.size() == partition_ranges.size());
+    std::vector<future<result<coordinator_query_result>>> ret;
+    ret.reserve(cmds.size());
+    auto query_alone = [&] (size_t i) {
+        return query_result(s, cmds[i], dht::partition_range_vector({partition_ranges[i]}), cl, query_options);
+    };
+
+    // Options which only the per-partition path knows how to handle.
+    // Per-partition rate limiting accounts each partition on its replicas
+    // separately, and the error injection is only checked by query_result().
+    auto& db = _db.local();
+    bool can_group = _features.multi_partition_reads && cmds.size() > 1
+            && !db::is_serial_consistency(cl)
+            && query_options.preferred_replicas.empty()
+            && !query_options.read_repair_decision
+            && !query_options.node_local_only
+            && db.column_family_exists(s->id())
+            && !(db.can_apply_per_partition_rate_limit(*s, db::operation_type::read)
+                    && std::ranges::any_of(cmds, [] (const auto& cmd) { return bool(cmd->allow_limit); }))
+            && utils::get_local_injector().get_injection_parameters("alternator_query_result_timeout").empty();
+    if (!can_group) {
+        for (size_t i = 0; i < cmds.size(); ++i) {
+            ret.push_back(query_alone(i));
+        }
+        return ret;
+    }
+
+    utils::latency_counter lc;
+    lc.start();
+    auto& cf = db.find_column_family(s->id());
+    auto erm = cf.get_effective_replication_map();
+    const size_t block_for = db::block_for(*erm, cl);
+    const auto digest_algo = block_for > 1 ? digest_algorithm(*this) : query::digest_algorithm::none;
+    const auto& sr = s->speculative_retry();
+    std::optional<clock_type::duration> speculate_after;
+    switch (sr.get_type()) {
+    case speculative_retry::type::NONE:
+        break;
+    case speculative_retry::type::ALWAYS:
+        speculate_after = clock_type::duration::zero();
+        break;
+    case speculative_retry::type::PERCENTILE:
+        speculate_after = std::min(cf.get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_timeout_config.read_timeout_in_ms() / 2));
+        break;
+    case speculative_retry::type::CUSTOM:
+        speculate_after = std::chrono::milliseconds(unsigned(sr.get_value()));
+        break;
+    }
+
+    // Choose the replicas of each partition as the per-partition path does, except
+    // for the cache hit rate based balancing, which would spread the partitions
+    // of the same replicas over different requests. The first replica sends the
+    // data of the partition and the others its digest.
+    std::vector<host_id_vector_replica_set> targets(cmds.size());
+    std::vector<std::optional<locator::host_id>> extra_replicas(cmds.size());
+    std::unordered_map<locator::host_id, std::vector<size_t>> partitions_by_data_replica;
+    std::unordered_map<locator::host_id, std::vector<size_t>> partitions_by_digest_replica;
+    auto local_dc_filter = erm->get_topology().get_local_dc_filter();
+    for (size_t i = 0; i < cmds.size(); ++i) {
+        const auto& token = partition_ranges[i].start()->value().token();
+        auto all_replicas = get_endpoints_for_reading(*s, *erm, token, node_local_only::no);
+        auto& extra = extra_replicas[i];
+        auto replicas = filter_replicas_for_read(cl, *erm, all_replicas, {}, db::read_repair_decision::NONE, speculate_after ? &extra : nullptr, nullptr);
+        if (replicas.size() < block_for) {
+            // Let the per-partition path report the unavailable replicas.
+            continue;
+        }
+        replicas.resize(block_for);
+        if (extra && (std::ranges::contains(replicas, *extra) || (is_datacenter_local(cl) && !local_dc_filter(*extra)))) {
+            extra.reset();
+        }
+        partitions_by_data_replica[replicas[0]].push_back(i);
+        for (auto ep : replicas | std::views::drop(1)) {
+            partitions_by_digest_replica[ep].push_back(i);
+        }
+        targets[i] = std::move(replicas);
+    }
+
+    const auto fence = get_fence(*erm);
+    const auto timeout = query_options.timeout(*this);
+    std::vector<std::vector<multi_partition_reply>> replies(cmds.size());
+    auto read_group = [&] (locator::host_id ep, const std::vector<size_t>& partitions, bool only_digest) {
+        auto group_cmds = partitions | std::views::transform([&] (size_t i) { return cmds[i]; }) | std::ranges::to<std::vector>();
+        auto group_prs = partitions | std::views::transform([&] (size_t i) { return partition_ranges[i]; }) | std::ranges::to<dht::partition_range_vector>();
+        auto f = read_partitions_from(erm, s, ep, group_cmds, group_prs, digest_algo, only_digest, fence, timeout, query_options.trace_state);
+
+        // The positions in the group of the partitions of each extra replica.
+        std::unordered_map<locator::host_id, std::vector<size_t>> by_extra_replica;
+        for (size_t j = 0; j < partitions.size(); ++j) {
+            if (auto& extra = extra_replicas[partitions[j]]) {
+                by_extra_replica[*extra].push_back(j);
+            }
+        }
+        if (!by_extra_replica.empty()) {
+            f = speculate_multi_partition_read(std::move(f), *speculate_after, [p = shared_from_this(), erm, s, group_cmds = std::move(group_cmds), group_prs = std::move(group_prs),
+                    by_extra_replica = std::move(by_extra_replica), digest_algo, only_digest, fence, timeout, trace_state = query_options.trace_state] {
+                std::vector<future<multi_partition_read_results>> reads;
+                for (const auto& [extra, positions] : by_extra_replica) {
+                    if (only_digest) {
+                        p->get_stats().speculative_digest_reads++;
+                    } else {
+                        p->get_stats().speculative_data_reads++;
+                    }
+                    tracing::trace(trace_state, "read_data_multi: launching speculative retry of {} partitions to /{}", positions.size(), extra);
+                    reads.push_back(p->read_partitions_from(erm, s, extra,
+                            positions | std::views::transform([&] (size_t j) { return group_cmds[j]; }) | std::ranges::to<std::vector>(),
+                            positions | std::views::transform([&] (size_t j) { return group_prs[j]; }) | std::ranges::to<dht::partition_range_vector>(),
+                            digest_algo, only_digest, fence, timeout, trace_state));
+                }
+                auto positions = by_extra_replica | std::views::values | std::ranges::to<std::vector>();
+                return when_all_succeed(reads.begin(), reads.end()).then([positions = std::move(positions), n = group_cmds.size()] (std::vector<multi_partition_read_results> extra_results) {
+                    // Partitions without an extra replica are left without a result.
+                    auto results = make_lw_shared<std::vector<foreign_ptr<lw_shared_ptr<query::result>>>>(n);
+                    for (size_t k = 0; k < extra_results.size(); ++k) {
+                        for (size_t j = 0; j < positions[k].size(); ++j) {
+                            (*results)[positions[k][j]] = std::move((*extra_results[k])[j]);
+                        }
+                    }
+                    return results;
+                });
+            });
+        }
+        auto results = shared_future<multi_partition_read_results>(std::move(f));
+        for (size_t j = 0; j < partitions.size(); ++j) {
+            replies[partitions[j]].push_back(multi_partition_reply{results, j});
+        }
+    };
+    // The data replies go first.
+    for (const auto& [ep, partitions] : partitions_by_data_replica) {
+        read_group(ep, partitions, false);
+    }
+    for (const auto& [ep, partitions] : partitions_by_digest_replica) {
+        read_group(ep, partitions, true);
+    }
+
+    for (size_t i = 0; i < cmds.size(); ++i) {
+        if (targets[i].empty()) {
+            ret.push_back(query_alone(i));
+        } else {
+            ret.push_back(query_partition_from_replies(s, cmds[i], std::move(partition_ranges[i]), cl, query_options,
+                    std::move(targets[i]), std::move(replies[i]), lc));
+        }
+    }
+    return ret;
+}
+
+future<storage_proxy::multi_partition_read_results>
+storage_proxy::read_partitions_from(locator::effective_replication_map_ptr erm,
+    schema_ptr s,
+    locator::host_id replica,
+    std::vector<lw_shared_ptr<query::read_command>> cmds,
+    dht::partition_range_vector prs,
+    query::digest_algorithm digest_algo,
+    bool only_digest,
+    fencing_token fence,
+    clock_type::time_point timeout,
+    tracing::trace_state_ptr trace_state)
+{
+    auto p = shared_from_this();
+    ++get_stats().multi_partition_reads;
+    std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results;
+    if (is_me(*erm, replica)) {
+        tracing::trace(trace_state, "read_data_multi: querying {} partitions locally", cmds.size());
+        auto local_replica = my_host_id(*erm);
+        results = co_await apply_fence_on_ready(query_result_local_multi(std::move(erm), std::move(s), std::move(cmds), std::move(prs),
+                multi_partition_result_options(digest_algo, only_digest), trace_state, timeout), fence, local_replica);
+    } else {
+        tracing::trace(trace_state, "read_data_multi: sending {} partitions to /{}", cmds.size(), replica);
+        auto remote_cmds = cmds | std::views::transform([] (const auto& cmd) { return *cmd; }) | std::ranges::to<std::vector>();
+        results = co_await remote().send_read_data_multi(replica, timeout, trace_state, remote_cmds, prs, digest_algo, only_digest, fence);
+    }
+    co_return make_lw_shared(std::move(results));
+}
+
+future<storage_proxy::multi_partition_read_results>
+storage_proxy::speculate_multi_partition_read(future<multi_partition_read_results> primary,
+    clock_type::duration delay,
+    noncopyable_function<future<multi_partition_read_results>()> speculate)
+{
+    auto primary_results = shared_future<multi_partition_read_results>(std::move(primary));
+    auto f = co_await coroutine::as_future(with_timeout(clock_type::now() + delay, primary_results.get_future()));
+    if (!f.failed()) {
+        co_return f.get();
+    }
+    f.ignore_ready_future();
+    std::vector<future<multi_partition_read_results>> reads;
+    reads.push_back(primary_results.get_future());
+    reads.push_back(speculate());
+    auto first = co_await when_any(reads.begin(), reads.end());
+    auto& winner = first.futures[first.index];
+    if (!winner.failed()) {
+        co_return winner.get();
+    }
+    winner.ignore_ready_future();
+    co_return co_await std::move(first.futures[1 - first.index]);
+}
+
+future<result<storage_proxy::coordinator_query_result>>
+storage_proxy::query_partition_from_replies(schema_ptr s,
+    lw_shared_ptr<query::read_command> cmd,
+    dht::partition_range pr,
+    db::consistency_level cl,
+    storage_proxy::coordinator_query_options query_options,
+    host_id_vector_replica_set targets,
+    std::vector<multi_partition_reply> replies,
+    utils::latency_counter lc)
+{
+    auto p = shared_from_this();
+    foreign_ptr<lw_shared_ptr<query::result>> result;
+    bool agreed = true;
+    // The first reply has the data of the partition, the others its digest.
+    // Wait for all the replies, even after a failure, so that no failure is left unobserved.
+    for (size_t k = 0; k < replies.size(); ++k) {
+        auto f = co_await coroutine::as_future(replies[k].results.get_future());
+        if (f.failed()) {
+            slogger.debug("Multi-partition read of {} failed: {}", pr, f.get_exception());
+            agreed = false;
+            continue;
+        }
+        auto results = f.get();
+        auto& r = (*results)[replies[k].index];
+        if (!r) {
+            // A speculative read which didn't cover the partition.
+            agreed = false;
+        } else if (k == 0) {
+            result = std::move(r);
+        } else if (!result || !result->digest() || result->digest() != r->digest()) {
+            agreed = false;
+        }
+    }
+    if (!agreed) {
+        ++get_stats().multi_partition_read_fallbacks;
+        co_return co_await query_result(std::move(s), std::move(cmd), dht::partition_range_vector({std::move(pr)}), cl, std::move(query_options));
+    }
+    get_stats().read.mark(lc.stop().latency());
+    replicas_per_token_range used_replicas;
+    used_replicas.emplace(dht::token_range::make_singular(pr.start()->value().token()), targets | std::ranges::to<std::vector<locator::host_id>>());
+    co_return coordinator_query_result(std::move(result), std::move(used_replicas));
+}
+
 future<result<storage_proxy::coordinator_query_result>>
 storage_proxy::do_query(schema_ptr s,
     lw_shared_ptr<query::read_command> cmd,
@@ -7347,6 +7767,52 @@ future<> storage_proxy::stop_remote() {
     _remote = nullptr;
 }
 
+future<replica::local_index_result>
+storage_proxy::query_local_index(schema_ptr s, replica::local_index_request req, clock_type::time_point timeout, tracing::trace_state_ptr trace_state) {
+    auto erm = s->table().get_effective_replication_map();
+    auto me = my_host_id(*erm);
+    std::map<locator::host_id, dht::partition_range_vector> ranges_per_replica;
+    query_ranges_to_vnodes_generator ranges_to_vnodes(erm->make_splitter(), s, {query::full_partition_range});
+    for (auto ranges = ranges_to_vnodes(1); !ranges.empty(); ranges = ranges_to_vnodes(1)) {
+        auto live_endpoints = get_endpoints_for_reading(*s, *erm, end_token(ranges.front()), node_local_only::no);
+        if (live_endpoints.empty()) {
+            throw exceptions::unavailable_exception(db::consistency_level::ONE, 1, 0);
+        }
+        // Prefer this node, which saves a round trip.
+        auto replica = std::ranges::contains(live_endpoints, me) ? me : live_endpoints.front();
+        ranges_per_replica[replica].push_back(std::move(ranges.front()));
+        co_await coroutine::maybe_yield();
+    }
+
+    tracing::trace(trace_state, "Searching index {} on {} replicas", req.index_name, ranges_per_replica.size());
+    req.schema_version = s->version();
+    req.trace_info = tracing::make_trace_info(trace_state);
+    replica::local_index_result result;
+    co_await coroutine::parallel_for_each(ranges_per_replica, [&] (auto& replica_ranges) -> future<> {
+        auto replica_req = req;
+        replica_req.ranges = std::move(replica_ranges.second);
+        auto replica_result = replica_ranges.first == me
+                ? co_await query_local_index_locally(s, replica_req, timeout, trace_state)
+                : co_await remote().send_local_index_search(replica_ranges.first, timeout, replica_req);
+        replica::merge_local_index_results(result, std::move(replica_result), req.limit);
+    });
+    co_return result;
+}
+
+future<replica::local_index_result>
+storage_proxy::query_local_index_locally(schema_ptr s, const replica::local_index_request& req, clock_type::time_point timeout, tracing::trace_state_ptr trace_state) {
+    replica::local_index_result result;
+    co_await coroutine::parallel_for_each(std::views::iota(0u, smp::count), [&] (unsigned shard) -> future<> {
+        auto shard_result = co_await _db.invoke_on(shard, {_read_smp_service_group, timeout}, [&req, gs = global_schema_ptr(s),
+                gt = tracing::global_trace_state_ptr(trace_state), timeout] (replica::database& db) {
+            schema_ptr s = gs;
+            return replica::search_local_index(db, db.find_column_family(s), s, req, gt.get(), timeout);
+        });
+        replica::merge_local_index_results(result, std::move(shard_result), req.limit);
+    });
+    co_return result;
+}
+
 future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>>
 storage_proxy::query_mutations_locally(schema_ptr query_schema, lw_shared_ptr<query::read_command> cmd, const dht::partition_range& pr,
                                        storage_proxy::clock_type::time_point timeout,
@@ -67,6 +67,11 @@ namespace cdc {
     class cdc_service;
 }
 
+namespace replica {
+struct local_index_request;
+struct local_index_result;
+}
+
 namespace gms {
 class gossiper;
 class feature_service;
@@ -441,6 +446,48 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
             tracing::trace_state_ptr trace_state,
             clock_type::time_point timeout,
             db::per_partition_rate_limit::info rate_limit_info);
+    // Reads the singular partition ranges, each with its own command, on the
+    // shards owning them.
+    future<std::vector<foreign_ptr<lw_shared_ptr<query::result>>>> query_result_local_multi(
+            locator::effective_replication_map_ptr,
+            schema_ptr,
+            std::vector<lw_shared_ptr<query::read_command>> cmds,
+            dht::partition_range_vector prs,
+            query::result_options opts,
+            tracing::trace_state_ptr trace_state,
+            clock_type::time_point timeout);
+    using multi_partition_read_results = lw_shared_ptr<std::vector<foreign_ptr<lw_shared_ptr<query::result>>>>;
+    // Reads the partitions from a replica with a single read_data_multi request,
+    // asking for their digests only if only_digest.
+    future<multi_partition_read_results> read_partitions_from(locator::effective_replication_map_ptr,
+            schema_ptr,
+            locator::host_id replica,
+            std::vector<lw_shared_ptr<query::read_command>> cmds,
+            dht::partition_range_vector prs,
+            query::digest_algorithm digest_algo,
+            bool only_digest,
+            fencing_token fence,
+            clock_type::time_point timeout,
+            tracing::trace_state_ptr trace_state);
+    // Returns the results of `primary`, or, if it doesn't resolve within the delay,
+    // the first successful one of `primary` and of `speculate()`, which reads the
+    // same partitions from other replicas.
+    future<multi_partition_read_results> speculate_multi_partition_read(future<multi_partition_read_results> primary,
+            clock_type::duration delay,
+            noncopyable_function<future<multi_partition_read_results>()> speculate);
+    // The result of a partition in the read_data_multi reply of one of its replicas.
+    struct multi_partition_reply {
+        shared_future<multi_partition_read_results> results;
+        size_t index;
+    };
+    future<result<coordinator_query_result>> query_partition_from_replies(schema_ptr,
+            lw_shared_ptr<query::read_command> cmd,
+            dht::partition_range pr,
+            db::consistency_level cl,
+            coordinator_query_options optional_params,
+            host_id_vector_replica_set targets,
+            std::vector<multi_partition_reply> replies,
+            utils::latency_counter lc);
     future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature, std::optional<full_position>>> query_result_local_digest(
             locator::effective_replication_map_ptr,
             schema_ptr,
@@ -846,6 +893,40 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
         coordinator_query_options optional_params,
         std::optional<cas_shard> cas_shard = {});
 
+    /*
+     * Reads several single partitions, each with its own command, as query_result()
+     * does for each of them separately. The partitions are grouped by the replicas
+     * they are read from, which get one read_data_multi request for the partitions
+     * they send the data of, and one for the partitions they send digests of,
+     * rather than one request per partition. Like with query_result(), a request
+     * which is slower than the table's speculative_retry allows is sent to the extra
+     * replicas of its partitions too. A partition whose replicas fail, or disagree,
+     * is read again on its own, which takes care of read repair.
+     *
+     * Returns a future per partition, in the order of partition_ranges.
+     */
+    std::vector<future<result<coordinator_query_result>>> query_partitions(schema_ptr,
+        std::vector<lw_shared_ptr<query::read_command>> cmds,
+        dht::partition_range_vector partition_ranges,
+        db::consistency_level cl,
+        coordinator_query_options optional_params);
+
+    /*
+     * Searches an index with the 'local' engine, see replica/local_index.hh.
+     * Each range is searched on one of its live replicas, and the req.limit best
+     * rows found by all of them are returned. The ranges of req are ignored.
+     */
+    future<replica::local_index_result> query_local_index(schema_ptr,
+        replica::local_index_request req,
+        clock_type::time_point timeout,
+        tracing::trace_state_ptr trace_state);
+
+    // Searches the ranges of req on all shards of this node.
+    future<replica::local_index_result> query_local_index_locally(schema_ptr,
+        const replica::local_index_request& req,
+        clock_type::time_point timeout,
+        tracing::trace_state_ptr trace_state);
+
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> query_mutations_locally(
         schema_ptr, lw_shared_ptr<query::read_command> cmd, const dht::partition_range&,
         clock_type::time_point timeout,
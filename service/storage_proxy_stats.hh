@@ -159,6 +159,7 @@ struct stats : public write_stats {
     uint64_t replica_data_reads = 0;
     uint64_t replica_digest_reads = 0;
     uint64_t replica_mutation_data_reads = 0;
+    uint64_t replica_multi_data_reads = 0;
 
     uint64_t replica_cross_shard_ops = 0;
 
@@ -174,6 +175,10 @@ struct stats : public write_stats {
     uint64_t read_retries = 0; // read is retried with new limit
     uint64_t speculative_digest_reads = 0;
     uint64_t speculative_data_reads = 0;
+    // read_data_multi requests sent, and partitions which had to be read
+    // again on their own after one of them failed or the replicas disagreed
+    uint64_t multi_partition_reads = 0;
+    uint64_t multi_partition_read_fallbacks = 0;
 
     uint64_t cas_read_unfinished_commit = 0;
     uint64_t cas_foreground = 0;
@@ -5429,7 +5429,10 @@ future<> storage_service::stream_tablet(locator::global_tablet_id tablet) {
         });
 
         auto& table = _db.local().find_column_family(tablet.table);
-        const bool file_stream_enabled = _feature_service.file_stream && _db.local().get_config().enable_file_stream();
+        // The value files of a table with value_log aren't sstable components, so its sstables
+        // are streamed as mutations, with the values read from the value files.
+        const bool file_stream_enabled = _feature_service.file_stream && _db.local().get_config().enable_file_stream()
+                && !table.schema()->value_log_options().enabled();
         if (table.uses_logstor() && !file_stream_enabled) {
             throw std::runtime_error(fmt::format("Table {}.{} uses logstor, which requires file streaming to be enabled", table.schema()->ks_name(), table.schema()->cf_name()));
         }
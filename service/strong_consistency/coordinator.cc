@@ -86,6 +86,10 @@ void stats::register_stats() {
             sm::description("number of strong consistency write requests bounced to another shard"))
             .set_skip_when_empty(),
 
+        sm::make_counter("write_conditions_failed", write_conditions_failed,
+            sm::description("number of strong consistency conditional write requests whose condition did not hold"))
+            .set_skip_when_empty(),
+
         sm::make_summary("read_latency_summary", sm::description("Strong consistency read latency summary"),
             [this] { return to_metrics_summary(linearizable_read.summary()); })(read_type_label("linearizable"))
             .set_skip_when_empty(),
@@ -257,11 +261,49 @@ coordinator::coordinator(groups_manager& groups_manager, replica::database& db,
     _stats.register_stats();
 }
 
+struct coordinator::write_condition {
+    const dht::decorated_key& key;
+    const query::read_command& cmd;
+    conditional_mutation_gen& mutation_gen;
+    tracing::trace_state_ptr trace_state;
+};
+
 future<value_or_redirect<>> coordinator::mutate(schema_ptr schema,
         const dht::token& token,
         mutation_gen&& mutation_gen,
         timeout_clock::time_point timeout,
         abort_source& as)
+{
+    auto result = co_await do_mutate(std::move(schema), token, &mutation_gen, nullptr, timeout, as);
+    if (auto* redirect = get_if<need_redirect>(&result)) {
+        co_return std::move(*redirect);
+    }
+    co_return std::monostate{};
+}
+
+future<value_or_redirect<bool>> coordinator::mutate_if(schema_ptr schema,
+        const dht::decorated_key& key,
+        const query::read_command& cmd,
+        conditional_mutation_gen&& mutation_gen,
+        tracing::trace_state_ptr trace_state,
+        timeout_clock::time_point timeout,
+        abort_source& as)
+{
+    auto condition = write_condition{key, cmd, mutation_gen, std::move(trace_state)};
+    return do_mutate(std::move(schema), key.token(), nullptr, &condition, timeout, as);
+}
+
+// Either mutation_gen or condition is set. Returns whether the mutation was written.
+//
+// Writes wait for their entries to be applied on the leader, so that a conditional
+// write can tell when the earlier writes of its token are visible to a local read,
+// see raft_server::wait_for_earlier_writes().
+future<value_or_redirect<bool>> coordinator::do_mutate(schema_ptr schema,
+        const dht::token& token,
+        mutation_gen* mutation_gen,
+        write_condition* condition,
+        timeout_clock::time_point timeout,
+        abort_source& as)
 {
     auto aoe = abort_on_expiry<timeout_clock>(timeout);
     [[maybe_unused]] const auto sub = utils::chain_abort_source(aoe.abort_source(), as);
@@ -312,6 +354,9 @@ future<value_or_redirect<>> coordinator::mutate(schema_ptr schema,
             return ex;
         }
     };
+    auto is_retriable = [] (const std::exception_ptr& ex) {
+        return try_catch<raft::not_a_leader>(ex) || try_catch<raft::dropped_entry>(ex);
+    };
 
     auto op_result_future = co_await coroutine::as_future(
             create_operation_ctx(*schema, token, aoe.abort_source(), true));
@@ -326,6 +371,10 @@ future<value_or_redirect<>> coordinator::mutate(schema_ptr schema,
         co_return std::move(*redirect);
     }
     auto& op = get<operation_ctx>(op_result);
+    tid = op.tablet_id;
+
+    // Set once a failed condition was confirmed by a read barrier.
+    bool read_barrier_done = false;
 
     while (true) {
         co_await utils::get_local_injector().inject("sc_coordinator_wait_before_begin_mutate",
@@ -351,12 +400,79 @@ future<value_or_redirect<>> coordinator::mutate(schema_ptr schema,
             continue;
         }
 
-        api::timestamp_type ts;
-        auto disposition_result = get<raft_server::timestamp_with_term>(disposition);
-        std::tie(ts, term) = {disposition_result.timestamp, disposition_result.term};
+        const auto ts = get<raft_server::timestamp_with_term>(disposition);
+        term = ts.term;
+        // Must be tracked before the next preemption point, so that conditional
+        // writes with later timestamps wait for it.
+        std::optional<raft_server::pending_write> pending = op.raft_server.track_write(token, ts);
+
+        std::optional<mutation> m;
+        if (!condition) {
+            m = (*mutation_gen)(ts.timestamp);
+        } else {
+            auto wait_future = co_await coroutine::as_future(
+                op.raft_server.wait_for_earlier_writes(token, ts, aoe.abort_source()));
+            if (wait_future.failed()) {
+                co_await coroutine::return_exception_ptr(filter_error(std::move(wait_future).get_exception()));
+            }
+            if (!wait_future.get()) {
+                // The term has changed, get a timestamp in the new one or redirect.
+                continue;
+            }
+
+            if (op.raft_server.has_orphaned_writes(token, ts)) {
+                // An entry added now is applied after the orphaned ones are applied, or dropped.
+                logger.debug("mutate_if(): token {} has orphaned writes, adding an empty entry, term {}", token, term);
+                raft::command raft_cmd;
+                ser::serialize(raft_cmd, raft_command{.mutation{mutation(schema, condition->key)}});
+                auto f = co_await coroutine::as_future(op.raft_server.server().add_entry(std::move(raft_cmd),
+                    raft::wait_type::applied,
+                    &aoe.abort_source()));
+                if (f.failed()) {
+                    auto ex = std::move(f).get_exception();
+                    if (is_retriable(ex)) {
+                        continue;
+                    }
+                    co_await coroutine::return_exception_ptr(filter_error(std::move(ex)));
+                }
+                op.raft_server.clear_orphaned_writes(token, ts);
+            }
+
+            const auto ranges = dht::partition_range_vector{dht::partition_range::make_singular(condition->key)};
+            auto query_future = co_await coroutine::as_future(_db.query(schema, condition->cmd,
+                query::result_options::only_result(), ranges, condition->trace_state, timeout));
+            if (query_future.failed()) {
+                co_await coroutine::return_exception_ptr(filter_error(std::move(query_future).get_exception()));
+            }
+            auto [result, cache_temp] = std::move(query_future).get();
+            m = condition->mutation_gen(std::move(result), ts.timestamp);
+
+            if (!m) {
+                if (read_barrier_done) {
+                    ++_stats.write_conditions_failed;
+                    co_return false;
+                }
+                // The read may have missed writes done by a new leader, if this node
+                // has lost leadership without noticing. The read barrier waits for all
+                // the committed entries to be applied, and the write is retried once.
+                pending.reset();
+                auto f = co_await coroutine::as_future(op.raft_server.server().read_barrier(&aoe.abort_source()));
+                if (f.failed()) {
+                    co_await coroutine::return_exception_ptr(filter_error(std::move(f).get_exception()));
+                }
+                read_barrier_done = true;
+                continue;
+            }
+
+            if (op.raft_server.server().get_current_term() != term) {
+                // The entry would be added in a later term, in which writes not seen by
+                // the read may be ordered before it.
+                continue;
+            }
+        }
 
         const raft_command command {
-            .mutation{mutation_gen(ts)}
+            .mutation{*m}
         };
         raft::command raft_cmd;
         ser::serialize(raft_cmd, command);
@@ -369,21 +485,23 @@ future<value_or_redirect<>> coordinator::mutate(schema_ptr schema,
 
         future<> add_entry_result = co_await coroutine::as_future(
             op.raft_server.server().add_entry(std::move(raft_cmd),
-                raft::wait_type::committed,
+                raft::wait_type::applied,
                 &aoe.abort_source()));
 
         if (!add_entry_result.failed()) {
-            co_return std::monostate{};
+            co_return true;
         }
 
         auto ex = std::move(add_entry_result).get_exception();
-        if (try_catch<raft::not_a_leader>(ex) || try_catch<raft::dropped_entry>(ex)) {
+        if (is_retriable(ex)) {
             logger.debug("mutate(): add_entry, got retriable error {}, table {}.{}, tablet {}, term {}",
                 ex, schema->ks_name(), schema->cf_name(), op.tablet_id, term);
 
             continue;
         }
 
+        // The entry may still be applied.
+        pending->orphan();
         co_await coroutine::return_exception_ptr(filter_error(std::move(ex)));
     }
 }
@@ -52,6 +52,7 @@ struct stats {
     uint64_t write_errors_other = 0;
     uint64_t write_node_bounces = 0;
     uint64_t write_shard_bounces = 0;
+    uint64_t write_conditions_failed = 0;
 
     utils::timed_rate_moving_average_summary_and_histogram linearizable_read;
     utils::timed_rate_moving_average_summary_and_histogram non_linearizable_read;
@@ -68,6 +69,11 @@ struct stats {
 class coordinator : public peering_sharded_service<coordinator> {
 public:
     using timeout_clock = typename db::timeout_clock;
+    using mutation_gen = noncopyable_function<mutation(api::timestamp_type)>;
+
+    // Generates the mutation of a conditional write from the current contents of
+    // the partition, or returns std::nullopt if the condition doesn't hold.
+    using conditional_mutation_gen = noncopyable_function<std::optional<mutation>(lw_shared_ptr<query::result>, api::timestamp_type)>;
 
 private:
     groups_manager& _groups_manager;
@@ -80,18 +86,40 @@ class coordinator : public peering_sharded_service<coordinator> {
         const dht::token& token,
         abort_source& as,
         bool use_leader_cache);
+
+    struct write_condition;
+    future<value_or_redirect<bool>> do_mutate(schema_ptr schema,
+        const dht::token& token,
+        mutation_gen* mutation_gen,
+        write_condition* condition,
+        timeout_clock::time_point timeout,
+        abort_source& as);
 public:
     coordinator(groups_manager& groups_manager, replica::database& db, gms::gossiper& gossiper);
 
     stats& get_stats() { return _stats; }
 
-    using mutation_gen = noncopyable_function<mutation(api::timestamp_type)>;
     future<value_or_redirect<>> mutate(schema_ptr schema, 
         const dht::token& token,
         mutation_gen&& mutation_gen,
         timeout_clock::time_point timeout,
         abort_source& as);
 
+    // Writes the mutation generated from the partition read with `cmd`, if its condition holds.
+    // Returns whether the condition held.
+    //
+    // The partition is read on the leader, which only waits for the earlier writes of the
+    // token to be applied locally, so a write takes a single Raft round trip, instead of
+    // the read and the Paxos rounds of a lightweight transaction. A failed condition
+    // is confirmed with a read barrier, in case this node is no longer the leader.
+    future<value_or_redirect<bool>> mutate_if(schema_ptr schema,
+        const dht::decorated_key& key,
+        const query::read_command& cmd,
+        conditional_mutation_gen&& mutation_gen,
+        tracing::trace_state_ptr trace_state,
+        timeout_clock::time_point timeout,
+        abort_source& as);
+
     using query_result_type = value_or_redirect<lw_shared_ptr<query::result>>;
     future<query_result_type> query(schema_ptr schema,
         const query::read_command& cmd,
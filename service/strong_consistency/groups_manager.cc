@@ -117,6 +117,90 @@ auto raft_server::begin_mutate(abort_source& as) -> begin_mutate_result {
     return timestamp_with_term{new_ts, term};
 }
 
+auto raft_server::find_pending_writes(groups_manager::raft_group_state& state, const dht::token& token, raft::term_t term)
+        -> pending_writes_map* {
+    if (!state.leader_info || state.leader_info->term != term) {
+        return nullptr;
+    }
+    auto it = state.leader_info->pending_writes.find(token);
+    return it == state.leader_info->pending_writes.end() ? nullptr : &it->second;
+}
+
+raft_server::pending_write::pending_write(groups_manager::raft_group_state& state, const dht::token& token, const timestamp_with_term& ts)
+    : _state(&state)
+    , _term(ts.term)
+    , _token(token)
+    , _timestamp(ts.timestamp)
+{
+    state.leader_info->pending_writes[token].emplace(ts.timestamp, false);
+}
+
+raft_server::pending_write::pending_write(pending_write&& o) noexcept
+    : _state(std::exchange(o._state, nullptr))
+    , _term(o._term)
+    , _token(o._token)
+    , _timestamp(o._timestamp)
+{
+}
+
+raft_server::pending_write::~pending_write() {
+    if (!_state) {
+        return;
+    }
+    // The entry is gone if the term has ended.
+    if (auto* writes = find_pending_writes(*_state, _token, _term)) {
+        writes->erase(_timestamp);
+        if (writes->empty()) {
+            _state->leader_info->pending_writes.erase(_token);
+        }
+        _state->pending_writes_cond.broadcast();
+    }
+}
+
+void raft_server::pending_write::orphan() noexcept {
+    if (auto* writes = find_pending_writes(*_state, _token, _term)) {
+        (*writes)[_timestamp] = true;
+        _state->pending_writes_cond.broadcast();
+    }
+    _state = nullptr;
+}
+
+auto raft_server::track_write(const dht::token& token, const timestamp_with_term& ts) -> pending_write {
+    return pending_write(_state, token, ts);
+}
+
+future<bool> raft_server::wait_for_earlier_writes(const dht::token& token, const timestamp_with_term& ts, abort_source& as) {
+    while (true) {
+        if (!_state.leader_info || _state.leader_info->term != ts.term) {
+            co_return false;
+        }
+        const auto* writes = find_pending_writes(_state, token, ts.term);
+        const bool earlier_write_pending = writes && std::ranges::any_of(
+                std::ranges::subrange(writes->begin(), writes->lower_bound(ts.timestamp)),
+                [] (const auto& w) { return !w.second; });
+        if (!earlier_write_pending) {
+            co_return true;
+        }
+        co_await wait_with_abort_source(_state.pending_writes_cond, as);
+    }
+}
+
+bool raft_server::has_orphaned_writes(const dht::token& token, const timestamp_with_term& ts) const {
+    const auto* writes = find_pending_writes(_state, token, ts.term);
+    return writes && std::ranges::any_of(
+            std::ranges::subrange(writes->begin(), writes->lower_bound(ts.timestamp)),
+            [] (const auto& w) { return w.second; });
+}
+
+void raft_server::clear_orphaned_writes(const dht::token& token, const timestamp_with_term& ts) {
+    if (auto* writes = find_pending_writes(_state, token, ts.term)) {
+        std::erase_if(*writes, [&] (const auto& w) { return w.first < ts.timestamp && w.second; });
+        if (writes->empty()) {
+            _state.leader_info->pending_writes.erase(token);
+        }
+    }
+}
+
 auto raft_server::begin_read(abort_source& as) -> begin_read_result {
     const auto leader = _state.server->current_leader();
     if (!leader) {
@@ -365,9 +449,14 @@ future<> groups_manager::leader_info_updater(raft_group_state& state, global_tab
                 // There's no reason to abort this operation in any other case.
                 co_await state.server->read_barrier(nullptr);
 
+                // Writes of the same term may still be in flight.
+                auto pending_writes = state.leader_info && state.leader_info->term == current_term
+                        ? std::move(state.leader_info->pending_writes)
+                        : decltype(leader_info::pending_writes){};
                 state.leader_info = leader_info {
                     .term = current_term,
-                    .last_timestamp = schema->table().get_max_timestamp_for_tablet(tablet.tablet)
+                    .last_timestamp = schema->table().get_max_timestamp_for_tablet(tablet.tablet),
+                    .pending_writes = std::move(pending_writes)
                 };
                 logger.debug("leader_info_updater({}-{}): read_barrier() completed, "
                     "new leader term {}, last_timestamp {}",
@@ -380,6 +469,7 @@ future<> groups_manager::leader_info_updater(raft_group_state& state, global_tab
                 state.leader_info = std::nullopt;
             }
             state.leader_info_cond.broadcast();
+            state.pending_writes_cond.broadcast();
 
             // We intentionally pass nullptr here. If the tablet is leaving this node,
             // the Raft server will be aborted and the loop will break.
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <map>
+
 #include "locator/abstract_replication_strategy.hh"
 #include "locator/tablets.hh"
 #include "message/messaging_service.hh"
@@ -109,6 +111,11 @@ class groups_manager : public peering_sharded_service<groups_manager> {
 
         // The last timestamp used for mutations in this term.
         api::timestamp_type last_timestamp;
+
+        // Writes of this term which may not be applied locally yet, by token and
+        // timestamp, see raft_server::wait_for_earlier_writes(). The flag is set
+        // for orphaned writes, whose outcome is unknown.
+        std::unordered_map<dht::token, std::map<api::timestamp_type, bool>> pending_writes = {};
     };
 
     struct raft_group_state : public boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
@@ -127,6 +134,9 @@ class groups_manager : public peering_sharded_service<groups_manager> {
         std::optional<leader_info> leader_info = std::nullopt;
         condition_variable leader_info_cond = condition_variable();
         future<> leader_info_updater = make_ready_future<>();
+
+        // Signalled when a pending write is done and when leader_info changes.
+        condition_variable pending_writes_cond = condition_variable();
     };
 
     netw::messaging_service& _ms;
@@ -211,6 +221,9 @@ class raft_server {
     groups_manager::raft_group_state& _state;
     gate::holder _holder;
 
+    using pending_writes_map = std::map<api::timestamp_type, bool>;
+    static pending_writes_map* find_pending_writes(groups_manager::raft_group_state& state, const dht::token& token, raft::term_t term);
+
 public:
     raft_server(groups_manager::raft_group_state& state, gate::holder holder);
 
@@ -232,6 +245,42 @@ class raft_server {
     using begin_mutate_result = std::variant<timestamp_with_term, raft::not_a_leader, need_wait_for_leader>;
     begin_mutate_result begin_mutate(abort_source&);
 
+    // Keeps a write, with a timestamp returned by begin_mutate(), pending until
+    // it's destroyed. It must be destroyed only after the write is applied locally,
+    // or when it's known that the write won't be applied, or orphan() must be called.
+    class pending_write {
+        groups_manager::raft_group_state* _state;
+        raft::term_t _term;
+        dht::token _token;
+        api::timestamp_type _timestamp;
+    public:
+        pending_write(groups_manager::raft_group_state& state, const dht::token& token, const timestamp_with_term& ts);
+        pending_write(pending_write&& o) noexcept;
+        pending_write& operator=(pending_write&&) = delete;
+        ~pending_write();
+
+        // The outcome of the write is unknown, e.g. because it timed out: it may be
+        // applied later, so it stays pending until the end of the term, or until
+        // clear_orphaned_writes() is called.
+        void orphan() noexcept;
+    };
+    pending_write track_write(const dht::token& token, const timestamp_with_term& ts);
+
+    // Waits until the writes of the token with timestamps smaller than `ts` are applied
+    // locally, so that a read on the leader sees all the writes which are ordered before
+    // a write with the timestamp `ts`. Orphaned writes aren't waited for.
+    //
+    // Returns false if this node is no longer the leader in the term of `ts`.
+    future<bool> wait_for_earlier_writes(const dht::token& token, const timestamp_with_term& ts, abort_source& as);
+
+    // Whether the token has orphaned writes with timestamps smaller than `ts`.
+    bool has_orphaned_writes(const dht::token& token, const timestamp_with_term& ts) const;
+
+    // Forgets the orphaned writes of the token with timestamps smaller than `ts`,
+    // once an entry added after they were orphaned is applied locally: the earlier
+    // entries are then either applied, or were dropped in a later term.
+    void clear_orphaned_writes(const dht::token& token, const timestamp_with_term& ts);
+
     // Possible results:
     //   ok - this node is the leader, proceed with read_barrier() locally
     //   raft::not_a_leader - this node is not a leader, redirect to the leader
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <optional>
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/later.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/util/defer.hh>
+
+#include "sstables/combined_filter.hh"
+#include "sstables/sstables.hh"
+#include "sstables/sstables_manager.hh"
+#include "utils/bloom_filter.hh"
+#include "utils/stall_free.hh"
+
+namespace sstables {
+
+extern logging::logger sstlog;
+
+using utils::filter::blocked_bloom_filter;
+
+thread_local combined_filter::stats combined_filter::_shard_stats;
+
+static constexpr size_t words_per_block = blocked_bloom_filter::words_per_block;
+
+// The block of a filter with 2^log2_blocks blocks the hash maps to, like in
+// blocked_bloom_filter.
+static size_t folded_block_of(uint64_t hash, unsigned log2_blocks) noexcept {
+    return (static_cast<unsigned __int128>(hash) << log2_blocks) >> 64;
+}
+
+const uint64_t* combined_filter::page::block(size_t i, unsigned slot) const noexcept {
+    // A block doesn't cross the chunks of the vector, since they are a
+    // multiple of its size.
+    return &words[(i * sstables.size() + slot) * words_per_block];
+}
+
+combined_filter::combined_filter(sstables_manager& manager)
+        : _filter_replaced_observer(manager.observe_filter_replaced([this] (sstable& sst) {
+            on_filter_replaced(sst);
+        }))
+{}
+
+combined_filter::~combined_filter() {
+    _shard_stats.memory_size -= memory_size();
+    _shard_stats.sstables_pending -= _pending.size();
+}
+
+const blocked_bloom_filter* combined_filter::foldable_filter(const sstable& sst) noexcept {
+    auto filter = dynamic_cast<const blocked_bloom_filter*>(sst.get_filter());
+    return filter && filter->nr_blocks() ? filter : nullptr;
+}
+
+void combined_filter::enqueue(shared_sstable sst) {
+    _pending.push_back(std::move(sst));
+    _shard_stats.sstables_pending++;
+    maybe_start_folding();
+}
+
+void combined_filter::drop_pending(const sstable& sst) noexcept {
+    auto it = std::ranges::find_if(_pending, [&sst] (const shared_sstable& x) { return x.get() == &sst; });
+    if (it != _pending.end()) {
+        _pending.erase(it);
+        _shard_stats.sstables_pending--;
+    }
+}
+
+void combined_filter::release_slot(entry& e) noexcept {
+    auto p = std::exchange(e.p, nullptr);
+    p->sstables[e.slot] = nullptr;
+    if (--p->live) {
+        // Rebuild the page without the slot.
+        maybe_start_folding();
+    } else {
+        replace_page(p, nullptr);
+    }
+}
+
+// The caller reserves room for the new page.
+void combined_filter::replace_page(const lw_shared_ptr<page>& old, lw_shared_ptr<page> p) noexcept {
+    if (old) {
+        if (auto it = std::ranges::find(_pages, old); it != _pages.end()) {
+            _shard_stats.memory_size -= old->words.memory_size();
+            _pages.erase(it);
+        }
+    }
+    if (p) {
+        _shard_stats.memory_size += p->words.memory_size();
+        _pages.push_back(std::move(p));
+    }
+}
+
+bool combined_filter::add(const shared_sstable& sst) noexcept {
+    try {
+        if (auto it = _entries.find(sst.get()); it != _entries.end()) {
+            it->second.refs++;
+            return true;
+        }
+        if (!foldable_filter(*sst)) {
+            return false;
+        }
+        auto it = _entries.emplace(sst.get(), entry{.refs = 1}).first;
+        try {
+            enqueue(sst);
+        } catch (...) {
+            _entries.erase(it);
+            throw;
+        }
+        return true;
+    } catch (...) {
+        sstlog.warn("Failed to add sstable {} to the combined filter: {}", sst->get_filename(), std::current_exception());
+        return false;
+    }
+}
+
+void combined_filter::remove(const sstable& sst) noexcept {
+    auto it = _entries.find(&sst);
+    if (it == _entries.end() || --it->second.refs) {
+        return;
+    }
+    if (it->second.p) {
+        release_slot(it->second);
+    } else {
+        drop_pending(sst);
+    }
+    _entries.erase(it);
+}
+
+void combined_filter::on_filter_replaced(sstable& sst) noexcept {
+    auto it = _entries.find(&sst);
+    if (it == _entries.end()) {
+        return;
+    }
+    // The folded copy of the old filter goes with it.
+    if (it->second.p) {
+        release_slot(it->second);
+    }
+    if (!foldable_filter(sst) || std::ranges::any_of(_pending, [&sst] (const shared_sstable& x) { return x.get() == &sst; })) {
+        return;
+    }
+    try {
+        enqueue(sst.shared_from_this());
+    } catch (...) {
+        sstlog.warn("Failed to add sstable {} to the combined filter: {}", sst.get_filename(), std::current_exception());
+    }
+}
+
+void combined_filter::maybe_start_folding() noexcept {
+    if (_folding) {
+        return;
+    }
+    _folding = true;
+    // fold() doesn't fail, and keeps the filter alive until it's done.
+    (void)fold();
+}
+
+future<lw_shared_ptr<combined_filter::page>> combined_filter::build_page(lw_shared_ptr<page> old, const shared_sstable& sst, const blocked_bloom_filter* filter) {
+    auto p = make_lw_shared<page>();
+    p->log2_blocks = old ? old->log2_blocks : std::bit_width(filter->nr_blocks()) - 1;
+    utils::small_vector<unsigned, max_slots_per_page> old_slots;
+    if (old) {
+        for (unsigned slot = 0; slot < old->sstables.size(); ++slot) {
+            if (old->sstables[slot]) {
+                p->sstables.push_back(old->sstables[slot]);
+                old_slots.push_back(slot);
+            }
+        }
+    }
+    if (sst) {
+        p->sstables.push_back(sst.get());
+    }
+
+    const size_t nr_folded_blocks = size_t(1) << p->log2_blocks;
+    co_await utils::reserve_gently(p->words, nr_folded_blocks * p->sstables.size() * words_per_block);
+    // The filter goes away when its memory is reclaimed.
+    if (sst && foldable_filter(*sst) != filter) {
+        co_return nullptr;
+    }
+    for (size_t i = 0; i < nr_folded_blocks; ++i) {
+        for (auto slot : old_slots) {
+            const uint64_t* src = old->block(i, slot);
+            for (size_t w = 0; w < words_per_block; ++w) {
+                p->words.push_back(src[w]);
+            }
+        }
+        if (sst) {
+            const auto nr_blocks = filter->nr_blocks();
+            // The hashes which map to the i-th folded block map to this range of blocks of the filter.
+            size_t first = (static_cast<unsigned __int128>(i) * nr_blocks) >> p->log2_blocks;
+            size_t last = (((static_cast<unsigned __int128>(i + 1) << (64 - p->log2_blocks)) - 1) * nr_blocks) >> 64;
+            std::array<uint64_t, words_per_block> folded = {};
+            for (size_t b = first; b <= last; ++b) {
+                const uint64_t* src = filter->block(b);
+                for (size_t w = 0; w < words_per_block; ++w) {
+                    folded[w] |= src[w];
+                }
+            }
+            for (auto w : folded) {
+                p->words.push_back(w);
+            }
+        }
+        co_await coroutine::maybe_yield();
+        if (sst && foldable_filter(*sst) != filter) {
+            co_return nullptr;
+        }
+    }
+    co_return p;
+}
+
+future<> combined_filter::fold() {
+    auto self = shared_from_this();
+    // Don't fold in the context of the caller which added or removed the sstable.
+    co_await seastar::yield();
+    try {
+        while (true) {
+            shared_sstable sst;
+            const blocked_bloom_filter* filter = nullptr;
+            lw_shared_ptr<page> old;
+            // The sstable counts as pending until it's folded.
+            auto count_folded = [] () noexcept { _shard_stats.sstables_pending--; };
+            std::optional<deferred_action<decltype(count_folded)>> folded;
+            if (!_pending.empty()) {
+                sst = std::move(_pending.front());
+                _pending.pop_front();
+                folded.emplace(std::move(count_folded));
+                auto it = _entries.find(sst.get());
+                filter = foldable_filter(*sst);
+                if (it == _entries.end() || it->second.p || !filter) {
+                    continue;
+                }
+                // Add the sstable to the page of its size class with the fewest sstables, if it has room.
+                const unsigned log2_blocks = std::bit_width(filter->nr_blocks()) - 1;
+                for (auto& p : _pages) {
+                    if (p->log2_blocks == log2_blocks && p->live < max_slots_per_page && (!old || p->live < old->live)) {
+                        old = p;
+                    }
+                }
+            } else if (auto it = std::ranges::find_if(_pages, [] (const lw_shared_ptr<page>& p) { return p->live < p->sstables.size(); }); it != _pages.end()) {
+                // Compact the page, without the slots of removed sstables.
+                old = *it;
+            } else {
+                break;
+            }
+
+            auto p = co_await build_page(old, sst, filter);
+            if (!p || (sst && foldable_filter(*sst) != filter)) {
+                continue;
+            }
+
+            // Move the sstables which are still where the page was built from to
+            // it. The ones removed meanwhile leave empty slots.
+            _pages.reserve(_pages.size() + 1);
+            for (unsigned slot = 0; slot < p->sstables.size(); ++slot) {
+                auto it = _entries.find(p->sstables[slot]);
+                if (it != _entries.end() && (p->sstables[slot] == sst.get() ? !it->second.p : it->second.p == old)) {
+                    it->second.p = p;
+                    it->second.slot = slot;
+                    p->live++;
+                } else {
+                    p->sstables[slot] = nullptr;
+                }
+            }
+            replace_page(old, p->live ? p : nullptr);
+        }
+    } catch (...) {
+        sstlog.warn("Failed to fold sstable filters into the combined filter: {}", std::current_exception());
+    }
+    _folding = false;
+}
+
+utils::small_vector<const sstable*, 16> combined_filter::candidates(const utils::hashed_key& key) const {
+    utils::small_vector<const sstable*, 16> ret;
+    for (auto& p : _pages) {
+        // The key's blocks of all the sstables of the page are next to each other.
+        const size_t i = folded_block_of(key.hash()[0], p->log2_blocks);
+        for (unsigned slot = 0; slot < p->sstables.size(); ++slot) {
+            if (p->sstables[slot] && blocked_bloom_filter::block_has_key(p->block(i, slot), key)) {
+                ret.push_back(p->sstables[slot]);
+            }
+        }
+    }
+    return ret;
+}
+
+size_t combined_filter::memory_size() const noexcept {
+    size_t ret = 0;
+    for (auto& p : _pages) {
+        ret += p->words.memory_size();
+    }
+    return ret;
+}
+
+}
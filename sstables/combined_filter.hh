@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include <seastar/core/future.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include "sstables/shared_sstable.hh"
+#include "utils/chunked_vector.hh"
+#include "utils/i_filter.hh"
+#include "utils/observable.hh"
+#include "utils/small_vector.hh"
+
+namespace utils::filter {
+class blocked_bloom_filter;
+}
+
+namespace sstables {
+
+class sstables_manager;
+
+// Tells which sstables of a set may contain a partition, so that a
+// single-partition read doesn't have to probe the filter of each sstable in turn.
+//
+// It combines the blocked bloom filters (see utils::filter::blocked_bloom_filter) of
+// the sstables. The filter of each sstable is folded to 2^n blocks, the largest power
+// of two not above its number of blocks, by or-ing the blocks which cover the same
+// range of hashes. Up to max_slots_per_page sstables with the same number of folded
+// blocks are laid out block by block in a page, so a lookup reads the key's block of
+// all the sstables of a page from a single contiguous range of memory.
+//
+// Folding raises the false-positive rate, so the sstables returned by a lookup should
+// still be checked with their own filter: the point is to skip most sstables without
+// touching their filters. Sstables with other kinds of filters aren't indexed, and
+// must always be checked.
+//
+// Folding takes time proportional to the size of the filters, so it's done in the
+// background: pages are rebuilt with the added sstables, and without the removed
+// ones, and replace the old pages once complete. Sstables which aren't folded yet
+// aren't indexed. An sstable whose filter is reclaimed stops being indexed, since
+// the combined filter holds a copy of its filter, until its filter is reloaded.
+//
+// The filter is shared by all the versions (clones) of an sstable set. Each set holds a
+// reference to the indexed sstables it contains, and an sstable is dropped from the
+// filter when no set refers to it anymore.
+class combined_filter : public enable_lw_shared_from_this<combined_filter> {
+public:
+    static constexpr unsigned max_slots_per_page = 8;
+
+    struct stats {
+        uint64_t memory_size = 0;
+        uint64_t lookups = 0;
+        uint64_t sstables_skipped = 0;
+        uint64_t sstables_pending = 0;
+    };
+private:
+    struct page {
+        unsigned log2_blocks;
+        // The sstables of the slots. The slots of the sstables removed
+        // since the page was built are null, until the page is rebuilt.
+        utils::small_vector<const sstable*, max_slots_per_page> sstables;
+        size_t live = 0;
+        // The words of the i-th block of the sstable in slot s start at
+        // (i * sstables.size() + s) * words_per_block.
+        utils::chunked_vector<uint64_t> words;
+
+        const uint64_t* block(size_t i, unsigned slot) const noexcept;
+    };
+    struct entry {
+        // The page holding the folded filter of the sstable, or null while
+        // the sstable waits to be folded, or while its filter is reclaimed.
+        lw_shared_ptr<page> p;
+        unsigned slot = 0;
+        unsigned refs = 0;
+    };
+    std::vector<lw_shared_ptr<page>> _pages;
+    std::unordered_map<const sstable*, entry> _entries;
+    // The sstables waiting to be folded, in the order they were added.
+    std::deque<shared_sstable> _pending;
+    bool _folding = false;
+    utils::observer<sstable&> _filter_replaced_observer;
+
+    static thread_local stats _shard_stats;
+
+    static const utils::filter::blocked_bloom_filter* foldable_filter(const sstable& sst) noexcept;
+    void enqueue(shared_sstable sst);
+    void drop_pending(const sstable& sst) noexcept;
+    void release_slot(entry& e) noexcept;
+    void replace_page(const lw_shared_ptr<page>& old, lw_shared_ptr<page> p) noexcept;
+    void on_filter_replaced(sstable& sst) noexcept;
+    void maybe_start_folding() noexcept;
+    future<> fold();
+    // Builds a page of the size class of `old`, or of `sst`, with the live
+    // sstables of `old` and `sst`. Returns null if the filter of `sst` was
+    // replaced meanwhile.
+    future<lw_shared_ptr<page>> build_page(lw_shared_ptr<page> old, const shared_sstable& sst, const utils::filter::blocked_bloom_filter* filter);
+public:
+    explicit combined_filter(sstables_manager& manager);
+    combined_filter(const combined_filter&) = delete;
+    ~combined_filter();
+
+    // Adds a reference to the sstable, scheduling it to be indexed if it's
+    // not indexed yet. Returns false if the sstable can't be indexed, because
+    // its filter isn't a blocked bloom filter (or it was reclaimed), or on
+    // allocation failure, in which case no reference is added. Sstables which
+    // aren't indexed are simply never skipped, so failing to add one isn't an error.
+    bool add(const shared_sstable& sst) noexcept;
+    // Drops a reference to an sstable added with add().
+    void remove(const sstable& sst) noexcept;
+    // Whether the sstable is indexed, i.e. whether candidates() may skip it.
+    bool indexes(const sstable& sst) const noexcept {
+        auto it = _entries.find(&sst);
+        return it != _entries.end() && it->second.p;
+    }
+    size_t size() const noexcept {
+        return _entries.size();
+    }
+
+    // The indexed sstables which may contain the key.
+    utils::small_vector<const sstable*, 16> candidates(const utils::hashed_key& key) const;
+
+    size_t memory_size() const noexcept;
+
+    // Counts a lookup, which allowed skipping the given number of sstables.
+    static void account_lookup(size_t sstables_skipped) noexcept {
+        _shard_stats.lookups++;
+        _shard_stats.sstables_skipped += sstables_skipped;
+    }
+
+    static const stats& get_shard_stats() noexcept {
+        return _shard_stats;
+    }
+};
+
+}
@@ -24,6 +24,7 @@
 #include "utils/class_registrator.hh"
 #include "reader_permit.hh"
 #include "data_source_types.hh"
+#include "decompressed_chunk_cache.hh"
 
 namespace sstables {
 
@@ -278,6 +279,27 @@ compression::locate(uint64_t position, const compression::segmented_offsets::acc
     return { chunk_start, chunk_end - chunk_start, chunk_offset };
 }
 
+compression::chunk_and_offset
+compression::locate_sub_chunk(uint64_t position, const compression::segmented_offsets::accessor& chunk_accessor,
+        const compression::segmented_offsets::accessor& sub_chunk_accessor) {
+    auto scl = uncompressed_sub_chunk_length();
+    auto sub_chunk_index = position / scl;
+    decltype(scl) sub_chunk_offset = position % scl;
+    auto sub_chunk_start = sub_chunk_accessor.at(sub_chunk_index);
+    uint64_t sub_chunk_end;
+    if ((sub_chunk_index + 1) % (uncompressed_chunk_length() / scl) != 0 && sub_chunk_index + 1 != sub_chunk_offsets.size()) {
+        sub_chunk_end = sub_chunk_accessor.at(sub_chunk_index + 1);
+    } else {
+        // The last sub-chunk of a chunk is followed by the checksum of the chunk.
+        auto chunk_index = position / uncompressed_chunk_length();
+        auto chunk_end = (chunk_index + 1 == offsets.size())
+                ? _compressed_file_length
+                : chunk_accessor.at(chunk_index + 1);
+        sub_chunk_end = chunk_end - 4;
+    }
+    return { sub_chunk_start, sub_chunk_end - sub_chunk_start, sub_chunk_offset };
+}
+
 std::map<sstring, sstring> options_from_compression(const compression& c) {
     std::map<sstring, sstring> result;
     result.emplace(compression_parameters::SSTABLE_COMPRESSION, sstring(c.name.value.begin(), c.name.value.end()));
@@ -305,23 +327,45 @@ enum class compressed_checksum_mode {
 
 template <ChecksumUtils ChecksumType, bool check_digest, compressed_checksum_mode mode>
 class compressed_file_data_source_impl : public data_source_impl {
-    std::function<future<input_stream<char>>()> _stream_creator;
+    // Opens the underlying stream at the given position of the compressed file.
+    std::function<future<input_stream<char>>(uint64_t)> _stream_creator;
     std::optional<input_stream<char>> _input_stream;
     sstables::compression* _compression_metadata;
     sstables::compression::segmented_offsets::accessor _offsets;
+    sstables::compression::segmented_offsets::accessor _sub_chunk_offsets;
     [[no_unique_address]] sstables::digest_members<check_digest> _digests;
     reader_permit _permit;
+    sstables::decompressed_chunk_cache* _chunk_cache;
+    // Read only the sub-chunks which overlap the read range, instead of whole chunks.
+    // Chunks are still read whole when they're cached, or when the digest is checked.
+    bool _read_sub_chunks;
+    // Position of _input_stream in the compressed file, when engaged.
     uint64_t _underlying_pos;
     uint64_t _pos;
     uint64_t _beg_pos;
     uint64_t _end_pos;
+private:
+    // Positions the underlying stream at the chunk at the given position of the compressed
+    // file. The stream is opened lazily, and skipped lazily, so that reads served by the
+    // chunk cache don't cause any I/O.
+    future<> seek_underlying(uint64_t chunk_start) {
+        if (!_input_stream) {
+            _input_stream = co_await _stream_creator(chunk_start);
+        } else if (chunk_start > _underlying_pos) {
+            co_await _input_stream->skip(chunk_start - _underlying_pos);
+        }
+        _underlying_pos = chunk_start;
+    }
 public:
     compressed_file_data_source_impl(sstables::stream_creator_fn stream_creator, sstables::compression* cm,
                 uint64_t pos, size_t len, file_input_stream_options options,
-                reader_permit permit, std::optional<uint32_t> digest)
+                reader_permit permit, std::optional<uint32_t> digest, sstables::decompressed_chunk_cache* chunk_cache)
             : _compression_metadata(cm)
             , _offsets(_compression_metadata->offsets.get_accessor())
+            , _sub_chunk_offsets(_compression_metadata->sub_chunk_offsets.get_accessor())
             , _permit(std::move(permit))
+            , _chunk_cache(check_digest ? nullptr : chunk_cache)
+            , _read_sub_chunks(!check_digest && !_chunk_cache && _compression_metadata->has_sub_chunks())
     {
         _pos = _beg_pos = pos;
         if (pos > _compression_metadata->uncompressed_file_length()) {
@@ -354,8 +398,13 @@ class compressed_file_data_source_impl : public data_source_impl {
         // and open a file_input_stream to read that range.
         auto start = _compression_metadata->locate(_beg_pos, _offsets);
         auto end = _compression_metadata->locate(_end_pos - 1, _offsets);
-        _stream_creator = [stream_creator{std::move(stream_creator)}, start = start.chunk_start, length = end.chunk_start + end.chunk_len - start.chunk_start, options] mutable {
-            return stream_creator(start, length, std::move(options));
+        auto end_pos = end.chunk_start + end.chunk_len;
+        if (_read_sub_chunks) {
+            auto sub_end = _compression_metadata->locate_sub_chunk(_end_pos - 1, _offsets, _sub_chunk_offsets);
+            end_pos = sub_end.chunk_start + sub_end.chunk_len;
+        }
+        _stream_creator = [stream_creator{std::move(stream_creator)}, end = end_pos, options] (uint64_t start) mutable {
+            return stream_creator(start, end - start, std::move(options));
         };
         _underlying_pos = start.chunk_start;
     }
@@ -364,9 +413,6 @@ class compressed_file_data_source_impl : public data_source_impl {
             co_return temporary_buffer<char>();
         }
 
-        if (!_input_stream) {
-            _input_stream = co_await _stream_creator();
-        }
         auto addr = _compression_metadata->locate(_pos, _offsets);
         // Uncompress the next chunk. We need to skip part of the first
         // chunk, but then continue to read from beginning of chunks.
@@ -376,21 +422,35 @@ class compressed_file_data_source_impl : public data_source_impl {
         if (!addr.chunk_len) {
             sstables::throw_malformed_sstable_exception(format("compressed chunk_len must be greater than zero, chunk_start={}", addr.chunk_start));
         }
-        auto buf = co_await _input_stream->read_exactly(addr.chunk_len);
-        if (buf.size() != addr.chunk_len) {
-            sstables::throw_malformed_sstable_exception(format("compressed reader hit premature end-of-file at file offset {}, expected chunk_len={}, actual={}", _underlying_pos, addr.chunk_len, buf.size()));
+
+        if (_read_sub_chunks) {
+            co_return co_await get_sub_chunks();
+        }
+
+        if (_chunk_cache) {
+            auto chunk_idx = _pos / _compression_metadata->uncompressed_chunk_length();
+            auto res_units = co_await _permit.request_memory(_compression_metadata->uncompressed_chunk_length());
+            temporary_buffer<char> out(_compression_metadata->uncompressed_chunk_length());
+            if (auto len = _chunk_cache->get(chunk_idx, std::span<char>(out.get_write(), out.size()))) {
+                out.trim(*len);
+            } else {
+                co_await seek_underlying(addr.chunk_start);
+                auto buf = co_await read_chunk(addr);
+                verify_checksum(buf, addr, ChecksumType::checksum(buf.get(), addr.chunk_len - 4));
+                out.trim(uncompress_chunk(buf, addr, out));
+                _chunk_cache->populate(chunk_idx, std::span<const char>(out.get(), out.size()));
+            }
+            out.trim_front(addr.offset);
+            _pos += out.size();
+            co_return make_tracked_temporary_buffer(std::move(out), std::move(res_units));
         }
+
+        co_await seek_underlying(addr.chunk_start);
+        auto buf = co_await read_chunk(addr);
         auto res_units = co_await _permit.request_memory(_compression_metadata->uncompressed_chunk_length());
-        // The last 4 bytes of the chunk are the adler32/crc32 checksum
-        // of the rest of the (compressed) chunk.
         auto compressed_len = addr.chunk_len - 4;
-        // FIXME: Do not always calculate checksum - Cassandra has a
-        // probability (defaulting to 1.0, but still...)
-        auto expected_checksum = read_be<uint32_t>(buf.get() + compressed_len);
         auto actual_checksum = ChecksumType::checksum(buf.get(), compressed_len);
-        if (expected_checksum != actual_checksum) {
-            sstables::throw_malformed_sstable_exception(format("compressed chunk of size {} at file offset {} failed checksum, expected={}, actual={}", addr.chunk_len, _underlying_pos, expected_checksum, actual_checksum));
-        }
+        verify_checksum(buf, addr, actual_checksum);
 
         if constexpr (check_digest) {
             if (_digests.can_calculate_digest) {
@@ -407,15 +467,9 @@ class compressed_file_data_source_impl : public data_source_impl {
         // chunk_length bytes (or less, if reading the last chunk).
         temporary_buffer<char> out(
                 _compression_metadata->uncompressed_chunk_length());
-        // The compressed data is the whole chunk, minus the last 4
-        // bytes (which contain the checksum verified above).
-
-        auto len = _compression_metadata->get_compressor().uncompress(buf.get(), compressed_len, out.get_write(), out.size());
-
-        out.trim(len);
+        out.trim(uncompress_chunk(buf, addr, out));
         out.trim_front(addr.offset);
         _pos += out.size();
-        _underlying_pos += addr.chunk_len;
 
         if constexpr (check_digest) {
             if (_digests.can_calculate_digest
@@ -427,6 +481,93 @@ class compressed_file_data_source_impl : public data_source_impl {
         co_return make_tracked_temporary_buffer(std::move(out), std::move(res_units));
     }
 
+private:
+    // Reads the compressed chunk at the position of the underlying stream.
+    future<temporary_buffer<char>> read_chunk(const sstables::compression::chunk_and_offset& addr) {
+        auto buf = co_await _input_stream->read_exactly(addr.chunk_len);
+        if (buf.size() != addr.chunk_len) {
+            sstables::throw_malformed_sstable_exception(format("compressed reader hit premature end-of-file at file offset {}, expected chunk_len={}, actual={}", _underlying_pos, addr.chunk_len, buf.size()));
+        }
+        _underlying_pos += addr.chunk_len;
+        co_return buf;
+    }
+
+    void verify_checksum(const temporary_buffer<char>& buf, const sstables::compression::chunk_and_offset& addr, uint32_t actual_checksum) {
+        // The last 4 bytes of the chunk are the adler32/crc32 checksum
+        // of the rest of the (compressed) chunk.
+        // FIXME: Do not always calculate checksum - Cassandra has a
+        // probability (defaulting to 1.0, but still...)
+        auto expected_checksum = read_be<uint32_t>(buf.get() + addr.chunk_len - 4);
+        if (expected_checksum != actual_checksum) {
+            sstables::throw_malformed_sstable_exception(format("compressed chunk of size {} at file offset {} failed checksum, expected={}, actual={}", addr.chunk_len, addr.chunk_start, expected_checksum, actual_checksum));
+        }
+    }
+
+    // Uncompresses the chunk at _pos, which was already verified, into out.
+    // Returns the size of the uncompressed chunk.
+    size_t uncompress_chunk(const temporary_buffer<char>& buf, const sstables::compression::chunk_and_offset& addr, temporary_buffer<char>& out) {
+        if (_compression_metadata->has_sub_chunks()) {
+            // The checksum of the chunk covers the checksums of its sub-chunks.
+            auto chunk_pos = _pos - addr.offset;
+            auto chunk_end_pos = std::min(chunk_pos + _compression_metadata->uncompressed_chunk_length(), _compression_metadata->uncompressed_file_length());
+            return uncompress_sub_chunks(buf, addr.chunk_start, chunk_pos, chunk_end_pos, out, false);
+        }
+        // The compressed data is the whole chunk, minus the last 4
+        // bytes (which contain the checksum).
+        return _compression_metadata->get_compressor().uncompress(buf.get(), addr.chunk_len - 4, out.get_write(), out.size());
+    }
+
+    // Uncompresses the sub-chunks covering the range [pos, end_pos) of the uncompressed data
+    // into out, pos being the start of a sub-chunk. buf holds the compressed data read from
+    // position buf_start of the file. Returns the uncompressed size.
+    size_t uncompress_sub_chunks(const temporary_buffer<char>& buf, uint64_t buf_start, uint64_t pos, uint64_t end_pos,
+            temporary_buffer<char>& out, bool verify) {
+        auto& compressor = _compression_metadata->get_compressor();
+        size_t out_len = 0;
+        for (; pos < end_pos; pos += _compression_metadata->uncompressed_sub_chunk_length()) {
+            auto addr = _compression_metadata->locate_sub_chunk(pos, _offsets, _sub_chunk_offsets);
+            if (addr.chunk_len < 4 || addr.chunk_start < buf_start || addr.chunk_start - buf_start + addr.chunk_len > buf.size()) {
+                sstables::throw_malformed_sstable_exception(format("compressed sub-chunk at file offset {} of size {} is out of the read range [{}, {})",
+                        addr.chunk_start, addr.chunk_len, buf_start, buf_start + buf.size()));
+            }
+            auto data = buf.get() + (addr.chunk_start - buf_start);
+            auto compressed_len = addr.chunk_len - 4;
+            if (verify) {
+                auto expected_checksum = read_be<uint32_t>(data + compressed_len);
+                auto actual_checksum = ChecksumType::checksum(data, compressed_len);
+                if (expected_checksum != actual_checksum) {
+                    sstables::throw_malformed_sstable_exception(format("compressed sub-chunk of size {} at file offset {} failed checksum, expected={}, actual={}", addr.chunk_len, addr.chunk_start, expected_checksum, actual_checksum));
+                }
+            }
+            out_len += compressor.uncompress(data, compressed_len, out.get_write() + out_len, out.size() - out_len);
+        }
+        return out_len;
+    }
+
+    // Reads and uncompresses only the sub-chunks of the chunk at _pos which overlap the read range.
+    future<temporary_buffer<char>> get_sub_chunks() {
+        const auto chunk_len = _compression_metadata->uncompressed_chunk_length();
+        const auto sub_chunk_len = _compression_metadata->uncompressed_sub_chunk_length();
+        auto end_pos = std::min(_end_pos, (_pos / chunk_len + 1) * chunk_len);
+        auto first = _compression_metadata->locate_sub_chunk(_pos, _offsets, _sub_chunk_offsets);
+        auto last = _compression_metadata->locate_sub_chunk(end_pos - 1, _offsets, _sub_chunk_offsets);
+        if (last.chunk_start + last.chunk_len <= first.chunk_start) {
+            sstables::throw_malformed_sstable_exception(format("compressed sub-chunks must be non-empty, first={}, last={}", first.chunk_start, last.chunk_start));
+        }
+
+        co_await seek_underlying(first.chunk_start);
+        auto buf = co_await read_chunk({first.chunk_start, last.chunk_start + last.chunk_len - first.chunk_start, 0});
+        auto first_pos = _pos - first.offset;
+        auto out_len = align_up(end_pos - first_pos, uint64_t(sub_chunk_len));
+        auto res_units = co_await _permit.request_memory(out_len);
+        temporary_buffer<char> out(out_len);
+        out.trim(uncompress_sub_chunks(buf, first.chunk_start, first_pos, end_pos, out, true));
+        out.trim_front(first.offset);
+        _pos += out.size();
+        co_return make_tracked_temporary_buffer(std::move(out), std::move(res_units));
+    }
+
+public:
     virtual future<> close() override {
         if (!_input_stream) {
             return make_ready_future<>();
@@ -445,17 +586,8 @@ class compressed_file_data_source_impl : public data_source_impl {
             on_internal_error(sstables::sstlog, format("Skipping over the end position is disallowed: current pos={}, end pos={}, skip len={}", _pos, _end_pos, n));
         }
         _pos += n;
-        if (_pos == _end_pos) {
-            co_return temporary_buffer<char>();
-        }
-        auto addr = _compression_metadata->locate(_pos, _offsets);
-        auto underlying_n = addr.chunk_start - _underlying_pos;
-        _underlying_pos = addr.chunk_start;
+        // The underlying stream is skipped by the next get(), if it needs to read from it.
         _beg_pos = _pos;
-        if (!_input_stream) {
-            _input_stream = co_await _stream_creator();
-        }
-        co_await _input_stream->skip(underlying_n);
         co_return temporary_buffer<char>();
     }
 };
@@ -578,23 +710,38 @@ class compressed_file_data_source : public data_source {
 public:
     compressed_file_data_source(sstables::stream_creator_fn stream_creator, sstables::compression* cm,
             uint64_t offset, size_t len, file_input_stream_options options, reader_permit permit,
-            std::optional<uint32_t> digest)
+            std::optional<uint32_t> digest, sstables::decompressed_chunk_cache* chunk_cache)
         : data_source(std::make_unique<compressed_file_data_source_impl<ChecksumType, check_digest, mode>>(
-                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest))
+                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, chunk_cache))
         {}
 };
 
 template <ChecksumUtils ChecksumType, compressed_checksum_mode mode>
 inline input_stream<char> make_compressed_file_input_stream(sstables::stream_creator_fn stream_creator, sstables::compression *cm, uint64_t offset, size_t len,
         file_input_stream_options options, reader_permit permit,
-        std::optional<uint32_t> digest)
+        std::optional<uint32_t> digest, sstables::decompressed_chunk_cache* chunk_cache = nullptr)
 {
     if (digest) [[unlikely]] {
         return input_stream<char>(compressed_file_data_source<ChecksumType, true, mode>(
-                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest));
+                std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, nullptr));
     }
     return input_stream<char>(compressed_file_data_source<ChecksumType, false, mode>(
-            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest));
+            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, chunk_cache));
+}
+
+// Sets the chunk length of the compressed file being written, and the length of its
+// sub-chunks, if it has any. Sub-chunks which wouldn't be smaller than the chunks are
+// pointless, so they're dropped.
+static void set_chunk_length(sstables::compression* cm, uint32_t chunk_length, std::optional<int> sub_chunk_length) {
+    cm->set_uncompressed_chunk_length(chunk_length);
+    if (sub_chunk_length && uint32_t(*sub_chunk_length) < chunk_length) {
+        cm->set_uncompressed_sub_chunk_length(*sub_chunk_length);
+        // Versions which don't know about sub-chunks refuse to read the
+        // sstable, because of the unknown option.
+        const auto& k = compression_parameters::SUB_CHUNK_LENGTH_KB;
+        auto v = to_sstring(*sub_chunk_length / 1024);
+        cm->options.elements.push_back({{bytes(k.begin(), k.end())}, {bytes(v.begin(), v.end())}});
+    }
 }
 
 // compressed_file_data_sink_impl works as a filter for a file output stream,
@@ -606,25 +753,60 @@ class compressed_file_data_sink_impl : public data_sink_impl {
     output_stream<char> _out;
     sstables::compression* _compression_metadata;
     sstables::compression::segmented_offsets::writer _offsets;
+    sstables::compression::segmented_offsets::writer _sub_chunk_offsets;
     size_t _pos = 0;
     uint32_t _full_checksum;
+    // Engaged until the chunk length is chosen, if it isn't fixed.
+    sstables::chunk_length_chooser _choose_chunk_length;
+    std::optional<int> _sub_chunk_length;
 public:
-    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm)
+    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm,
+            sstables::chunk_length_chooser choose_chunk_length, std::optional<int> sub_chunk_length)
             : _out(std::move(out))
             , _compression_metadata(cm)
             , _offsets(_compression_metadata->offsets.get_writer())
+            , _sub_chunk_offsets(_compression_metadata->sub_chunk_offsets.get_writer())
             , _full_checksum(ChecksumType::init_checksum())
+            , _choose_chunk_length(std::move(choose_chunk_length))
+            , _sub_chunk_length(sub_chunk_length)
     {}
 
 private:
+    size_t compress_max_size(size_t input_len) const {
+        auto& compressor = _compression_metadata->get_compressor();
+        if (!_compression_metadata->has_sub_chunks()) {
+            return compressor.compress_max_size(input_len);
+        }
+        const size_t sub_chunk_len = _compression_metadata->uncompressed_sub_chunk_length();
+        const size_t sub_chunks = (input_len + sub_chunk_len - 1) / sub_chunk_len;
+        return sub_chunks * (compressor.compress_max_size(sub_chunk_len) + 4);
+    }
+
+    // Compresses each sub-chunk of the chunk independently, followed by
+    // the checksum of its compressed data. Returns the compressed length.
+    size_t compress_sub_chunks(const temporary_buffer<char>& buf, char* output, size_t output_len) {
+        auto& compressor = _compression_metadata->get_compressor();
+        const size_t sub_chunk_len = _compression_metadata->uncompressed_sub_chunk_length();
+        size_t len = 0;
+        for (size_t pos = 0; pos < buf.size(); pos += sub_chunk_len) {
+            _sub_chunk_offsets.push_back(_pos + len);
+            auto sub_len = compressor.compress(buf.get() + pos, std::min(sub_chunk_len, buf.size() - pos), output + len, output_len - len - 4);
+            write_be<uint32_t>(output + len + sub_len, ChecksumType::checksum(output + len, sub_len));
+            len += sub_len + 4;
+        }
+        return len;
+    }
+
     future<> do_put(temporary_buffer<char> buf) {
-        auto output_len = _compression_metadata->get_compressor().compress_max_size(buf.size());
+        auto output_len = compress_max_size(buf.size());
 
         // account space for checksum that goes after compressed data.
         temporary_buffer<char> compressed(output_len + 4);
 
         // compress flushed data.
-        auto len = _compression_metadata->get_compressor().compress(buf.get(), buf.size(), compressed.get_write(), output_len);
+        auto len = _compression_metadata->has_sub_chunks()
+                ? compress_sub_chunks(buf, compressed.get_write(), output_len)
+                : _compression_metadata->get_compressor().compress(buf.get(), buf.size(), compressed.get_write(), output_len);
         if (len > output_len) {
             return make_exception_future(std::runtime_error("possible overflow during compression"));
         }
@@ -657,19 +839,38 @@ class compressed_file_data_sink_impl : public data_sink_impl {
         auto f = _out.write(compressed.get(), compressed.size());
         return f.then([compressed = std::move(compressed)] {});
     }
+
+    void maybe_choose_chunk_length() {
+        if (_choose_chunk_length) {
+            set_chunk_length(_compression_metadata, _choose_chunk_length(), _sub_chunk_length);
+            _choose_chunk_length = {};
+        }
+    }
+
+    // Until the chunk length is chosen, the buffers are max_adaptive_chunk_length
+    // long (except for the last one), so they can be split to any chunk length.
+    future<> do_put_chunks(temporary_buffer<char> buf) {
+        maybe_choose_chunk_length();
+        const size_t chunk_len = _compression_metadata->uncompressed_chunk_length();
+        for (size_t pos = 0; pos < buf.size(); pos += chunk_len) {
+            co_await do_put(buf.share(pos, std::min(chunk_len, buf.size() - pos)));
+        }
+    }
 public:
     virtual future<> put(std::span<temporary_buffer<char>> bufs) override {
         return data_sink_impl::fallback_put(bufs, [this] (temporary_buffer<char>&& buf) {
-            return do_put(std::move(buf));
+            return do_put_chunks(std::move(buf));
         });
     }
 
     virtual future<> close() override {
+        // Nothing was written, but CompressionInfo still needs a chunk length.
+        maybe_choose_chunk_length();
         return _out.close();
     }
 
     virtual size_t buffer_size() const noexcept override {
-        return _compression_metadata->uncompressed_chunk_length();
+        return _choose_chunk_length ? sstables::max_adaptive_chunk_length : _compression_metadata->uncompressed_chunk_length();
     }
 };
 
@@ -677,9 +878,10 @@ template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 class compressed_file_data_sink : public data_sink {
 public:
-    compressed_file_data_sink(output_stream<char> out, sstables::compression* cm)
+    compressed_file_data_sink(output_stream<char> out, sstables::compression* cm,
+            sstables::chunk_length_chooser choose_chunk_length, std::optional<int> sub_chunk_length)
         : data_sink(std::make_unique<compressed_file_data_sink_impl<ChecksumType, mode>>(
-                std::move(out), cm)) {}
+                std::move(out), cm, std::move(choose_chunk_length), sub_chunk_length)) {}
 };
 
 template <typename ChecksumType, compressed_checksum_mode mode>
@@ -687,17 +889,21 @@ requires ChecksumUtils<ChecksumType>
 inline output_stream<char> make_compressed_file_output_stream(output_stream<char> out,
          sstables::compression* cm,
          const compression_parameters& cp,
-         compressor_ptr p) {
+         compressor_ptr p,
+         sstables::chunk_length_chooser choose_chunk_length) {
     cm->set_compressor(std::move(p));
-    // buffer of output stream is set to chunk length, because flush must
-    // happen every time a chunk was filled up.
-    cm->set_uncompressed_chunk_length(cp.chunk_length());
     // FIXME: crc_check_chance can be configured by the user.
     // probability to verify the checksum of a compressed chunk we read.
     // defaults to 1.0.
     cm->options.elements.push_back({{"crc_check_chance"}, {"1.0"}});
+    // buffer of output stream is set to chunk length, because flush must
+    // happen every time a chunk was filled up. When the chunk length is
+    // chosen later, the sink splits the buffers into chunks.
+    if (!choose_chunk_length) {
+        set_chunk_length(cm, cp.chunk_length(), cp.sub_chunk_length());
+    }
 
-    return output_stream<char>(compressed_file_data_sink<ChecksumType, mode>(std::move(out), cm));
+    return output_stream<char>(compressed_file_data_sink<ChecksumType, mode>(std::move(out), cm, std::move(choose_chunk_length), cp.sub_chunk_length()));
 }
 
 input_stream<char> sstables::make_compressed_file_k_l_format_input_stream(stream_creator_fn stream_creator,
@@ -712,17 +918,18 @@ input_stream<char> sstables::make_compressed_file_k_l_format_input_stream(stream
 input_stream<char> sstables::make_compressed_file_m_format_input_stream(stream_creator_fn stream_creator,
         sstables::compression *cm, uint64_t offset, size_t len,
         class file_input_stream_options options, reader_permit permit,
-        std::optional<uint32_t> digest) {
+        std::optional<uint32_t> digest, decompressed_chunk_cache* chunk_cache) {
     return make_compressed_file_input_stream<crc32_utils, compressed_checksum_mode::checksum_all>(
-            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest);
+            std::move(stream_creator), cm, offset, len, std::move(options), std::move(permit), digest, chunk_cache);
 }
 
 output_stream<char> sstables::make_compressed_file_m_format_output_stream(output_stream<char> out,
         sstables::compression* cm,
         const compression_parameters& cp,
-        compressor_ptr p) {
+        compressor_ptr p,
+        chunk_length_chooser choose_chunk_length) {
     return make_compressed_file_output_stream<crc32_utils, compressed_checksum_mode::checksum_all>(
-            std::move(out), cm, cp, std::move(p));
+            std::move(out), cm, cp, std::move(p), std::move(choose_chunk_length));
 }
 
 input_stream<char> sstables::make_compressed_raw_file_input_stream(sstables::stream_creator_fn stream_creator, sstables::compression *cm,
@@ -32,6 +32,15 @@
 // This implementation does not cache the compressed disk blocks (which
 // are read using O_DIRECT), nor uncompressed data. We intend to cache high-
 // level Cassandra rows, not disk blocks.
+//
+// As a Scylla extension, chunks can be split into sub-chunks (see the
+// sub_chunk_length_in_kb compression option), which are compressed
+// independently. Each sub-chunk is followed by a 4-byte checksum of its
+// compressed data, and the last one by the checksum of the whole chunk, so
+// the chunks can still be read and verified as a whole. The offsets of the
+// sub-chunks are stored in CompressionInfo after the offsets of the chunks,
+// which lets reads of a small range fetch and decompress only the sub-chunks
+// which cover it.
 
 #include "utils/assert.hh"
 #include <vector>
@@ -291,6 +300,8 @@ struct compression {
     disk_array<uint32_t, option> options;
     uint64_t data_len = 0;
     segmented_offsets offsets;
+    // Empty if the chunks aren't split into sub-chunks.
+    segmented_offsets sub_chunk_offsets;
 
 private:
     // Variables *not* found in the "Compression Info" file (added by update()):
@@ -300,6 +311,7 @@ struct compression {
     // accessed via uncompressed_chunk_length()/set_uncompressed_chunk_length().
     uint32_t chunk_len = 0;
     uint32_t _full_checksum = 0;
+    uint32_t _sub_chunk_len = 0;
     compressor_ptr _compressor;
 public:
     // Set the compressor algorithm, please check the definition of enum compressor.
@@ -326,6 +338,11 @@ struct compression {
         unsigned offset; // offset into chunk after uncompressing it
     };
     chunk_and_offset locate(uint64_t position, const compression::segmented_offsets::accessor& accessor);
+    // Like locate(), but locates the sub-chunk containing the given position.
+    // The returned range doesn't include the checksum of the chunk, which follows
+    // its last sub-chunk. Can only be used if has_sub_chunks().
+    chunk_and_offset locate_sub_chunk(uint64_t position, const compression::segmented_offsets::accessor& chunk_accessor,
+            const compression::segmented_offsets::accessor& sub_chunk_accessor);
 
     unsigned uncompressed_chunk_length() const noexcept {
         return chunk_len;
@@ -337,6 +354,20 @@ struct compression {
         offsets.init(chunk_len);
     }
 
+    bool has_sub_chunks() const noexcept {
+        return _sub_chunk_len != 0;
+    }
+
+    unsigned uncompressed_sub_chunk_length() const noexcept {
+        return _sub_chunk_len;
+    }
+
+    void set_uncompressed_sub_chunk_length(uint32_t scl) {
+        _sub_chunk_len = scl;
+
+        sub_chunk_offsets.init(_sub_chunk_len);
+    }
+
     uint64_t uncompressed_file_length() const noexcept {
         return data_len;
     }
@@ -363,6 +394,8 @@ struct compression {
     friend class sstable;
 };
 
+class decompressed_chunk_cache;
+
 using stream_creator_fn = std::function<future<input_stream<char>>(uint64_t, uint64_t, file_input_stream_options)>;
 
 // Note: compression_metadata is passed by reference; The caller is
@@ -375,20 +408,31 @@ input_stream<char> make_compressed_file_k_l_format_input_stream(stream_creator_f
                 class file_input_stream_options options, reader_permit permit,
                 std::optional<uint32_t> digest);
 
+// When chunk_cache is given, decompressed chunks are looked up in it before
+// being read from disk, and populated into it after being read. It's not used
+// when a digest is given, as the digest is computed over the compressed chunks.
 input_stream<char> make_compressed_file_m_format_input_stream(stream_creator_fn stream_creator,
                 sstables::compression* cm, uint64_t offset, size_t len,
                 class file_input_stream_options options, reader_permit permit,
-                std::optional<uint32_t> digest);
+                std::optional<uint32_t> digest, decompressed_chunk_cache* chunk_cache = nullptr);
 
 // Raw compressed data stream function that return compressed chunks without decompression
 // while still calculating digests and verifying checksums. Compatible with SSTables version 3.x and later.
 input_stream<char> make_compressed_raw_file_input_stream(sstables::stream_creator_fn stream_creator, sstables::compression *cm,
         file_input_stream_options options, reader_permit permit, std::optional<uint32_t> digest);
 
+// Chooses the chunk length of a compressed file when it's written, instead of
+// using the one from the compression parameters. It's called once, when the first
+// max_adaptive_chunk_length bytes are flushed, or when the stream is closed if it's
+// shorter. It must return a power of two, not larger than max_adaptive_chunk_length.
+using chunk_length_chooser = std::function<uint32_t()>;
+constexpr uint32_t max_adaptive_chunk_length = 64 * 1024;
+
 output_stream<char> make_compressed_file_m_format_output_stream(output_stream<char> out,
                 sstables::compression* cm,
                 const compression_parameters& cp,
-                compressor_ptr);
+                compressor_ptr,
+                chunk_length_chooser choose_chunk_length = {});
 
 
 std::map<sstring, sstring> options_from_compression(const compression& c);
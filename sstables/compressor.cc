@@ -415,6 +415,7 @@ const sstring compression_parameters::SSTABLE_COMPRESSION = "sstable_compression
 const sstring compression_parameters::CHUNK_LENGTH_KB = "chunk_length_in_kb";
 const sstring compression_parameters::CHUNK_LENGTH_KB_ERR = "chunk_length_kb";
 const sstring compression_parameters::CRC_CHECK_CHANCE = "crc_check_chance";
+const sstring compression_parameters::SUB_CHUNK_LENGTH_KB = "sub_chunk_length_in_kb";
 
 compression_parameters::compression_parameters()
     : compression_parameters(algorithm::lz4)
@@ -510,6 +511,14 @@ compression_parameters::compression_parameters(const std::map<sstring, sstring>&
         }
     }
 
+    if (auto v = get_option(SUB_CHUNK_LENGTH_KB)) {
+        try {
+            _sub_chunk_length = std::stoi(*v) * 1024;
+        } catch (const std::exception& e) {
+            throw exceptions::syntax_exception(sstring("Invalid integer value ") + *v + " for " + SUB_CHUNK_LENGTH_KB);
+        }
+    }
+
     if (auto v = get_option(CRC_CHECK_CHANCE)) {
         try {
             _crc_check_chance = std::stod(*v);
@@ -565,6 +574,25 @@ void compression_parameters::validate(dicts_feature_enabled dicts_enabled) const
                 fmt::format("{}/{} must be 128 or less.", CHUNK_LENGTH_KB, CHUNK_LENGTH_KB_ERR));
         }
     }
+    if (_sub_chunk_length) {
+        auto sub_chunk_length = _sub_chunk_length.value();
+        if (sub_chunk_length <= 0 || (sub_chunk_length & (sub_chunk_length - 1))) {
+            throw exceptions::configuration_exception(
+                fmt::format("{} must be a positive power of 2.", SUB_CHUNK_LENGTH_KB));
+        }
+        if (sub_chunk_length >= chunk_length()) {
+            throw exceptions::configuration_exception(
+                fmt::format("{} must be smaller than {}.", SUB_CHUNK_LENGTH_KB, CHUNK_LENGTH_KB));
+        }
+        if (sub_chunk_length > MAX_SUB_CHUNK_LENGTH) {
+            throw exceptions::configuration_exception(
+                fmt::format("{} must be {} or less.", SUB_CHUNK_LENGTH_KB, MAX_SUB_CHUNK_LENGTH / 1024));
+        }
+        if (!compression_enabled()) {
+            throw exceptions::configuration_exception(
+                fmt::format("{} requires compression to be enabled.", SUB_CHUNK_LENGTH_KB));
+        }
+    }
     if (_crc_check_chance && (_crc_check_chance.value() < 0.0 || _crc_check_chance.value() > 1.0)) {
         throw exceptions::configuration_exception(sstring(CRC_CHECK_CHANCE) + " must be between 0.0 and 1.0.");
     }
@@ -586,6 +614,9 @@ std::map<sstring, sstring> compression_parameters::get_options() const {
     if (_chunk_length) {
         opts.emplace(sstring(CHUNK_LENGTH_KB), std::to_string(_chunk_length.value() / 1024));
     }
+    if (_sub_chunk_length) {
+        opts.emplace(sstring(SUB_CHUNK_LENGTH_KB), std::to_string(_sub_chunk_length.value() / 1024));
+    }
     if (_crc_check_chance) {
         opts.emplace(sstring(CRC_CHECK_CHANCE), std::to_string(_crc_check_chance.value()));
     }
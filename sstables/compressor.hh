@@ -89,9 +89,15 @@ class compression_parameters {
     static const sstring CHUNK_LENGTH_KB;
     static const sstring CHUNK_LENGTH_KB_ERR;
     static const sstring CRC_CHECK_CHANCE;
+    static const sstring SUB_CHUNK_LENGTH_KB;
+
+    // Sub-chunks must be small enough for the offsets of incompressible
+    // ones to fit in compression::segmented_offsets.
+    static constexpr int32_t MAX_SUB_CHUNK_LENGTH = 8 * 1024;
 private:
     algorithm _algorithm;
     std::optional<int> _chunk_length;
+    std::optional<int> _sub_chunk_length;
     std::optional<double> _crc_check_chance;
     std::optional<int> _zstd_compression_level;
 public:
@@ -101,7 +107,13 @@ class compression_parameters {
     ~compression_parameters();
 
     int32_t chunk_length() const { return _chunk_length.value_or(int(DEFAULT_CHUNK_LENGTH)); }
+    // False if chunk_length_in_kb wasn't set, and chunk_length() is the default.
+    bool has_chunk_length() const { return _chunk_length.has_value(); }
     double crc_check_chance() const { return _crc_check_chance.value_or(double(DEFAULT_CRC_CHECK_CHANCE)); }
+    // When set, each chunk is split into sub-chunks of this length, which are
+    // compressed independently, so that reads can decompress only the sub-chunks
+    // they need. See sstables::compression.
+    std::optional<int> sub_chunk_length() const { return _sub_chunk_length; }
     algorithm get_algorithm() const { return _algorithm; }
     std::optional<int> zstd_compression_level() const { return _zstd_compression_level; }
 
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <seastar/core/align.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+
+#include "sstables/decompressed_chunk_cache.hh"
+#include "utils/assert.hh"
+#include "utils/log.hh"
+
+namespace sstables {
+
+extern logging::logger sstlog;
+
+decompressed_chunk_cache::cached_chunk::cached_chunk(decompressed_chunk_cache* parent, chunk_idx_type idx, std::span<const char> data)
+    : parent(parent)
+    , idx(idx)
+    , size(data.size())
+    // lsa buffers are aligned to 4 KiB, so smaller sizes would just waste the rest.
+    , buf(parent->_region.alloc_buf(align_up(data.size(), alignment)))
+{
+    std::ranges::copy(data, buf.get());
+}
+
+void decompressed_chunk_cache::cached_chunk::on_evicted() noexcept {
+    parent->on_evicted(*this);
+    with_allocator(standard_allocator(), [this] {
+        cache_type::iterator it(this);
+        it.erase(chunk_idx_less_comparator());
+    });
+}
+
+decompressed_chunk_cache::decompressed_chunk_cache(cached_file_stats& stats, lru& l, logalloc::region& region)
+    : _stats(stats)
+    , _lru(l)
+    , _region(region)
+    , _as(abstract_formatter([] (fmt::format_context& ctx) {
+        fmt::format_to(ctx.out(), "decompressed_chunk_cache");
+    }))
+    , _cache(chunk_idx_less_comparator())
+{ }
+
+decompressed_chunk_cache::~decompressed_chunk_cache() {
+    with_allocator(standard_allocator(), [&] {
+        auto disposer = [] (auto* p) noexcept {};
+        auto i = _cache.begin();
+        while (i != _cache.end()) {
+            _lru.remove(*i);
+            on_evicted(*i);
+            i = i.erase_and_dispose(disposer, chunk_idx_less_comparator());
+        }
+    });
+    SCYLLA_ASSERT(_cache.empty());
+}
+
+void decompressed_chunk_cache::on_evicted(cached_chunk& c) noexcept {
+    _stats.cached_bytes -= c.size_in_allocator();
+    _cached_bytes -= c.size_in_allocator();
+    ++_stats.page_evictions;
+}
+
+std::optional<size_t> decompressed_chunk_cache::get(chunk_idx_type idx, std::span<char> out) noexcept {
+    // Nothing here allocates, so the chunk can't be evicted nor moved while it's copied.
+    auto i = _cache.lower_bound(idx);
+    if (i == _cache.end() || i->idx != idx) {
+        ++_stats.page_misses;
+        return std::nullopt;
+    }
+    SCYLLA_ASSERT(i->size <= out.size());
+    ++_stats.page_hits;
+    _lru.touch(*i);
+    std::copy_n(i->buf.get(), i->size, out.data());
+    return i->size;
+}
+
+void decompressed_chunk_cache::populate(chunk_idx_type idx, std::span<const char> data) noexcept {
+    if (data.size() > max_chunk_size) {
+        return;
+    }
+    try {
+        // _cache.emplace() needs to run under allocating section even though it lives in the std space
+        // because bplus::tree operations are not reentrant, so we need to prevent memory reclamation.
+        auto [c, inserted] = _as(_region, [&] {
+            return _cache.emplace(idx, this, idx, data);
+        });
+        if (inserted) {
+            ++_stats.page_populations;
+            _stats.cached_bytes += c->size_in_allocator();
+            _cached_bytes += c->size_in_allocator();
+            _lru.add(*c);
+        }
+    } catch (...) {
+        // The read already has the chunk, it's not worth failing it.
+        sstlog.debug("Failed to cache decompressed chunk {}: {}", idx, std::current_exception());
+    }
+}
+
+future<> decompressed_chunk_cache::evict_gently() {
+    auto i = _cache.begin();
+    while (i != _cache.end()) {
+        _lru.remove(*i);
+        on_evicted(*i);
+        i = i.erase(chunk_idx_less_comparator());
+        if (need_preempt() && i != _cache.end()) {
+            auto key = i->idx;
+            co_await coroutine::maybe_yield();
+            i = _cache.lower_bound(key);
+        }
+    }
+}
+
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <optional>
+
+#include <seastar/core/future.hh>
+#include <seastar/core/temporary_buffer.hh>
+
+#include "utils/bptree.hh"
+#include "utils/cached_file_stats.hh"
+#include "utils/logalloc.hh"
+#include "utils/lru.hh"
+
+namespace sstables {
+
+/// \brief A cache of the decompressed chunks of a compressed Data component.
+///
+/// Saves single-partition reads of partitions which were evicted from the row cache
+/// the I/O and the decompression of their chunks. The chunks are kept in LSA memory
+/// and linked in the LRU shared with the row cache and the index caches, so they're
+/// evicted like cached rows under memory pressure.
+///
+/// The stats are shared by all the instances, see cache_tracker::get_data_chunk_cache_stats().
+class decompressed_chunk_cache {
+public:
+    using chunk_idx_type = uint64_t;
+
+    // Larger chunks aren't cached, to keep them well within LSA segments.
+    static constexpr size_t max_chunk_size = 64 * 1024;
+    static constexpr size_t alignment = 4096;
+private:
+    class cached_chunk final : public evictable {
+    public:
+        decompressed_chunk_cache* parent;
+        chunk_idx_type idx;
+        size_t size;
+        logalloc::lsa_buffer buf;
+    public:
+        cached_chunk(decompressed_chunk_cache* parent, chunk_idx_type idx, std::span<const char> data);
+
+        cached_chunk(cached_chunk&&) noexcept {
+            // Required by bplus::tree, but chunks are never moved, see cached_file::cached_page.
+            abort();
+        }
+
+        size_t size_in_allocator() const noexcept {
+            return buf.size();
+        }
+
+        void on_evicted() noexcept override;
+    };
+
+    struct chunk_idx_less_comparator {
+        bool operator()(chunk_idx_type lhs, chunk_idx_type rhs) const noexcept {
+            return lhs < rhs;
+        }
+    };
+
+    using cache_type = bplus::tree<chunk_idx_type, cached_chunk, chunk_idx_less_comparator, 12, bplus::key_search::linear>;
+
+    cached_file_stats& _stats;
+    lru& _lru;
+    logalloc::region& _region;
+    logalloc::allocating_section _as;
+    cache_type _cache;
+    uint64_t _cached_bytes = 0;
+private:
+    void on_evicted(cached_chunk& c) noexcept;
+public:
+    decompressed_chunk_cache(cached_file_stats& stats, lru& l, logalloc::region& region);
+    decompressed_chunk_cache(decompressed_chunk_cache&&) = delete; // captured this
+    ~decompressed_chunk_cache();
+
+    /// \brief Copies the contents of the given chunk into out, if cached.
+    ///
+    /// out must be large enough for any chunk. Returns the size of the chunk
+    /// on a hit, and std::nullopt on a miss.
+    std::optional<size_t> get(chunk_idx_type idx, std::span<char> out) noexcept;
+
+    /// \brief Caches the contents of the given chunk.
+    ///
+    /// Caching is best-effort: chunks which are too large, or for which there's
+    /// no memory, are simply not cached.
+    void populate(chunk_idx_type idx, std::span<const char> data) noexcept;
+
+    /// \brief Returns the number of bytes cached.
+    uint64_t cached_bytes() const noexcept {
+        return _cached_bytes;
+    }
+
+    /// \brief Evicts all the chunks.
+    future<> evict_gently();
+};
+
+}
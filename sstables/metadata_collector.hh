@@ -180,6 +180,10 @@ class metadata_collector {
         _cardinality.offer_hashed(hashed);
     }
 
+    const utils::estimated_histogram& estimated_partition_size() const {
+        return _estimated_partition_size;
+    }
+
     void add_partition_size(uint64_t partition_size) {
         _estimated_partition_size.add(partition_size);
     }
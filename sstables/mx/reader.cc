@@ -1338,6 +1338,10 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
     abstract_index_reader& get_index_reader() {
         return *_index_reader;
     }
+    // Reads which bypass the row cache don't populate the chunk cache either.
+    sstable::use_chunk_cache use_chunk_cache() const {
+        return sstable::use_chunk_cache(!_slice.options.contains(query::partition_slice::option::bypass_cache));
+    }
     future<> advance_to_next_partition() {
         sstlog.trace("reader {}: advance_to_next_partition()", fmt::ptr(this));
         _before_partition = true;
@@ -1587,11 +1591,12 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
                     on_internal_error(sstlog, "mx reader: integrity checking not supported for single-partition reversed reads");
                 }
                 auto reversed_context = data_consume_reversed_partition<DataConsumeRowsContext>(
-                        *_schema, _sst, *_index_reader, _consumer, { begin, *end });
+                        *_schema, _sst, *_index_reader, _consumer, { begin, *end }, use_chunk_cache());
                 _context = std::move(reversed_context.the_context);
                 _reversed_read_sstable_position = &reversed_context.current_position_in_sstable;
             } else {
-                _context = co_await data_consume_single_partition<DataConsumeRowsContext>(*_schema, _sst, _consumer, { begin, *end }, _integrity);
+                _context = co_await data_consume_single_partition<DataConsumeRowsContext>(*_schema, _sst, _consumer, { begin, *end }, _integrity,
+                        use_chunk_cache());
             }
         } else {
             sstable::disk_read_range drr{begin, *end};
@@ -9,6 +9,8 @@
 #include "sstables/mx/writer.hh"
 #include "sstables/writer.hh"
 #include "sstables/trie/bti_index.hh"
+#include "sstables/repair_summary.hh"
+#include "sstables/value_log.hh"
 #include "encoding_stats.hh"
 #include "schema/schema.hh"
 #include "mutation/mutation_fragment.hh"
@@ -22,6 +24,7 @@
 #include "db/corrupt_data_handler.hh"
 #include "keys/keys.hh"
 
+#include <bit>
 #include <functional>
 #include <queue>
 #include <boost/iterator/iterator_facade.hpp>
@@ -622,6 +625,8 @@ class writer : public sstable_writer::writer_impl {
     } _pi_write_m;
     run_id _run_identifier;
     bool _write_regular_as_static; // See #4139
+    std::optional<repair_summary::builder> _repair_summary;
+    std::optional<value_log::writer> _value_log;
     // Size threshold used by can_split_partition_at_clustering_boundary() in consume(clustering_row&&)
     // to decide whether the current partition may be split at a clustering boundary.
     // Derived once from _cfg.max_sstable_size, which never changes for the lifetime of the writer.
@@ -673,6 +678,7 @@ class writer : public sstable_writer::writer_impl {
     }
 
     void init_file_writers();
+    uint32_t choose_compression_chunk_length() const;
 
     // Returns the closed writer
     std::unique_ptr<file_writer> close_writer(std::unique_ptr<file_writer>& w);
@@ -897,10 +903,20 @@ class writer : public sstable_writer::writer_impl {
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
         if (!_delayed_filter) {
-            _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), utils::filter_format::m_format);
+            // A binary fuse filter is built from the complete set of keys, which is
+            // only available when the filter is delayed.
+            _features.disable(BinaryFuseFilter);
+            _sst.set_features(_features);
+            _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), _sst.bloom_filter_format());
         }
         _pi_write_m.promoted_index_block_size = cfg.promoted_index_block_size;
         _pi_write_m.promoted_index_auto_scale_threshold = cfg.promoted_index_auto_scale_threshold;
+        if (cfg.repair_summary) {
+            _repair_summary.emplace(_schema);
+        }
+        if (_schema.value_log_options().enabled() || cfg.value_log_sources) {
+            _value_log.emplace(_sst, _schema, cfg.value_log_sources);
+        }
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
         _index_sampling_state.max_partitions_per_page = _cfg.summary_max_partitions_per_page;
       if (_index_writer) {
@@ -993,6 +1009,22 @@ void writer::maybe_add_pi_block() {
     }
 }
 
+// Smaller chunks compress poorly, and don't save much I/O.
+static constexpr uint32_t min_adaptive_chunk_length = compression_parameters::DEFAULT_CHUNK_LENGTH;
+
+// Picks a chunk length about the size of the partitions written so far, so that
+// reading a partition reads about one chunk: small partitions get small chunks,
+// which keep single-partition reads cheap, and large ones get large chunks, which
+// compress better. Called when the first max_adaptive_chunk_length bytes are
+// flushed, so if no partition was completed by then, they're large.
+uint32_t writer::choose_compression_chunk_length() const {
+    const auto& partition_sizes = _collector.estimated_partition_size();
+    uint64_t partition_size = partition_sizes.count() ? partition_sizes.mean() : max_adaptive_chunk_length;
+    auto chunk_length = std::clamp<uint64_t>(std::bit_ceil(partition_size), min_adaptive_chunk_length, max_adaptive_chunk_length);
+    sstlog.debug("Chose compression chunk length {} for {}, mean partition size: {}", chunk_length, _sst.get_filename(), partition_size);
+    return chunk_length;
+}
+
 void writer::init_file_writers() {
     auto out = _sst._storage->make_data_or_index_sink(_sst, component_type::Data).get();
 
@@ -1000,12 +1032,17 @@ void writer::init_file_writers() {
         _data_writer = std::make_unique<crc32_checksummed_file_writer>(std::move(out), _sst.sstable_buffer_size, _sst.get_filename());
     } else {
         auto compressor = _sst.manager().get_compressor_factory().make_compressor_for_writing(_sst._schema).get();
+        chunk_length_chooser choose_chunk_length;
+        if (_cfg.adaptive_compression_chunk_length && !_sst._schema->get_compressor_params().has_chunk_length()) {
+            choose_chunk_length = [this] { return choose_compression_chunk_length(); };
+        }
         _data_writer = std::make_unique<file_writer>(
             make_compressed_file_m_format_output_stream(
                 output_stream<char>(std::move(out)),
                 &_sst._components->compression,
                 _sst._schema->get_compressor_params(),
-                std::move(compressor)), _sst.get_filename());
+                std::move(compressor),
+                std::move(choose_chunk_length)), _sst.get_filename());
     }
 
     if (_sst.has_component(component_type::Index)) {
@@ -1121,6 +1158,10 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
 
     _tombstone_written = false;
     _static_row_written = false;
+
+    if (_repair_summary) {
+        _repair_summary->consume_new_partition(dk);
+    }
 }
 
 void writer::consume(tombstone t) {
@@ -1134,6 +1175,9 @@ void writer::consume(tombstone t) {
 
     _tombstone_written = true;
 
+    if (_repair_summary) {
+        _repair_summary->consume(t);
+    }
     if (t) {
         _collector.update_min_max_components(position_in_partition_view::before_all_clustered_rows());
         _collector.update_min_max_components(position_in_partition_view::after_all_clustered_rows());
@@ -1336,7 +1380,10 @@ void writer::write_cell(bytes_ostream& writer, const clustering_key_prefix* clus
             });
         }
     } else {
-        if (has_value) {
+        if (has_value && _value_log && value_log::is_separable(cdef)) {
+            auto value = _value_log->write(cell.value());
+            write_cell_value(_sst.get_version(), writer, *cdef.type, value ? managed_bytes_view(*value) : cell.value());
+        } else if (has_value) {
             write_cell_value(_sst.get_version(), writer, *cdef.type, cell.value());
         }
     }
@@ -1520,6 +1567,9 @@ void writer::write_static_row(const row& static_row, column_kind kind) {
 
 stop_iteration writer::consume(static_row&& sr) {
     ensure_tombstone_is_written();
+    if (_repair_summary) {
+        _repair_summary->consume(sr);
+    }
     write_static_row(sr.cells(), column_kind::static_column);
     return stop_iteration::no;
 }
@@ -1599,6 +1649,9 @@ void writer::record_corrupt_row(clustering_row&& clustered_row) {
 stop_iteration writer::consume(clustering_row&& cr) {
     if (_write_regular_as_static) {
         ensure_tombstone_is_written();
+        if (_repair_summary) {
+            _repair_summary->consume(cr);
+        }
         write_static_row(cr.cells(), column_kind::regular_column);
         return stop_iteration::no;
     }
@@ -1606,6 +1659,9 @@ stop_iteration writer::consume(clustering_row&& cr) {
         record_corrupt_row(std::move(cr));
         return stop_iteration::no;
     }
+    if (_repair_summary) {
+        _repair_summary->consume(cr);
+    }
 
     ensure_tombstone_is_written();
     ensure_static_row_is_written_if_needed();
@@ -1713,6 +1769,9 @@ stop_iteration writer::consume(range_tombstone_change&& rtc) {
     if (!_current_tombstone && !rtc.tombstone()) {
         return stop_iteration::no;
     }
+    if (_repair_summary) {
+        _repair_summary->consume(rtc);
+    }
     tombstone prev_tombstone = std::exchange(_current_tombstone, rtc.tombstone());
     if (!prev_tombstone) { // start bound
         auto bv = pos.as_start_bound_view();
@@ -1761,6 +1820,10 @@ stop_iteration writer::consume_end_of_partition() {
 
     write_promoted_index();
 
+    if (_repair_summary) {
+        _repair_summary->consume_end_of_partition();
+    }
+
     if (_bti_partition_index_writer) {
         auto partitions_db_payload = _bti_row_index_writer->finish(
             _sst.get_version(),
@@ -1880,7 +1943,15 @@ void writer::consume_end_of_stream() {
             ld_records = scylla_metadata::large_data_records{.elements = std::move(records)};
         }
     }
-    _sst.write_scylla_metadata(_shard, std::move(identifier), std::move(ld_stats), std::move(ts_stats), std::move(ld_records));
+    std::optional<scylla_metadata::repair_summary> summary;
+    if (_repair_summary) {
+        summary = std::move(*_repair_summary).build();
+    }
+    std::optional<scylla_metadata::value_log> value_log;
+    if (_value_log) {
+        value_log = _value_log->finish();
+    }
+    _sst.write_scylla_metadata(_shard, std::move(identifier), std::move(ld_stats), std::move(ts_stats), std::move(ld_records), std::move(summary), std::move(value_log));
     if (!_cfg.leave_unsealed) {
         _sst.seal_sstable(_cfg.backup).get();
     }
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <algorithm>
+
+#include "sstables/repair_summary.hh"
+#include "sstables/sstables.hh"
+#include "mutation/atomic_cell_hash.hh"
+#include "mutation/mutation_fragment.hh"
+#include "mutation/mutation_fragment_v2.hh"
+#include "schema/schema.hh"
+#include "utils/hashing.hh"
+
+namespace sstables::repair_summary {
+
+static constexpr uint32_t nr_sub_ranges = uint32_t(1) << sub_range_bits;
+static constexpr uint64_t sub_range_width = uint64_t(1) << (64 - sub_range_bits);
+
+// Distinguishes the fragments of a partition in the hash.
+enum class fragment_tag : uint8_t {
+    partition_tombstone = 1,
+    static_row = 2,
+    clustering_row = 3,
+    range_tombstone_change = 4,
+    end_of_partition = 5,
+};
+
+uint32_t sub_range_of(const dht::token& t) noexcept {
+    return dht::compaction_group_of(sub_range_bits, t);
+}
+
+std::optional<std::pair<uint32_t, uint32_t>> aligned_sub_ranges(const dht::token_range& range) {
+    if (range.is_wrap_around(dht::token_comparator())) {
+        return std::nullopt;
+    }
+    uint32_t first = 0;
+    if (range.start() && !range.start()->value().is_minimum()) {
+        const auto& t = range.start()->value();
+        if (t.is_maximum()) {
+            return std::nullopt;
+        }
+        auto i = sub_range_of(t);
+        if (range.start()->is_inclusive()) {
+            // The first key token is one past the start of sub-range 0.
+            if (t.unbias() % sub_range_width != 0 && !t.is_first()) {
+                return std::nullopt;
+            }
+            first = i;
+        } else {
+            if (t != dht::last_token_of_compaction_group(sub_range_bits, i) || i == nr_sub_ranges - 1) {
+                return std::nullopt;
+            }
+            first = i + 1;
+        }
+    }
+    uint32_t last = nr_sub_ranges - 1;
+    if (range.end() && !range.end()->value().is_maximum()) {
+        const auto& t = range.end()->value();
+        if (t.is_minimum()) {
+            return std::nullopt;
+        }
+        auto i = sub_range_of(t);
+        if (range.end()->is_inclusive()) {
+            if (t != dht::last_token_of_compaction_group(sub_range_bits, i)) {
+                return std::nullopt;
+            }
+            last = i;
+        } else {
+            if (i == 0 || t.unbias() % sub_range_width != 0) {
+                return std::nullopt;
+            }
+            last = i - 1;
+        }
+    }
+    if (first > last) {
+        return std::nullopt;
+    }
+    return std::pair(first, last);
+}
+
+void builder::finish_sub_range() {
+    if (_sub_range) {
+        _entries.push_back(repair_summary_entry{*_sub_range, _hasher.finalize_uint64()});
+    }
+}
+
+void builder::consume_new_partition(const dht::decorated_key& dk) {
+    auto sub_range = sub_range_of(dk.token());
+    if (sub_range != _sub_range) {
+        finish_sub_range();
+        _sub_range = sub_range;
+        _hasher = xx_hasher();
+    }
+    feed_hash(_hasher, dk.key(), _schema);
+}
+
+// Producers may or may not emit empty partition tombstones, static rows and range
+// tombstone changes, so they're not hashed, as they aren't written.
+void builder::consume(tombstone t) {
+    if (t) {
+        feed_hash(_hasher, fragment_tag::partition_tombstone);
+        feed_hash(_hasher, t);
+    }
+}
+
+void builder::consume(const static_row& sr) {
+    if (sr.empty()) {
+        return;
+    }
+    feed_hash(_hasher, fragment_tag::static_row);
+    sr.cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
+        auto&& col = _schema.static_column_at(id);
+        feed_hash(_hasher, col.id);
+        feed_hash(_hasher, cell, col);
+    });
+}
+
+void builder::consume(const clustering_row& cr) {
+    feed_hash(_hasher, fragment_tag::clustering_row);
+    feed_hash(_hasher, cr.key(), _schema);
+    feed_hash(_hasher, cr.tomb());
+    feed_hash(_hasher, cr.marker());
+    cr.cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
+        auto&& col = _schema.regular_column_at(id);
+        feed_hash(_hasher, col.id);
+        feed_hash(_hasher, cell, col);
+    });
+}
+
+void builder::consume(const range_tombstone_change& rtc) {
+    auto pos = rtc.position();
+    feed_hash(_hasher, fragment_tag::range_tombstone_change);
+    feed_hash(_hasher, pos.region());
+    feed_hash(_hasher, pos.get_bound_weight());
+    if (pos.has_key()) {
+        feed_hash(_hasher, pos.key(), _schema);
+    }
+    feed_hash(_hasher, rtc.tombstone());
+}
+
+void builder::consume_end_of_partition() {
+    feed_hash(_hasher, fragment_tag::end_of_partition);
+}
+
+scylla_metadata::repair_summary builder::build() && {
+    finish_sub_range();
+    _sub_range.reset();
+    return scylla_metadata::repair_summary{
+        .sub_range_bits = sub_range_bits,
+        .entries = {std::move(_entries)},
+    };
+}
+
+dht::token_range token_range_of(std::pair<uint32_t, uint32_t> sub_ranges) {
+    auto [first, last] = sub_ranges;
+    std::optional<dht::token_range::bound> start, end;
+    if (first > 0) {
+        start.emplace(dht::last_token_of_compaction_group(sub_range_bits, first - 1), false);
+    }
+    if (last < nr_sub_ranges - 1) {
+        end.emplace(dht::last_token_of_compaction_group(sub_range_bits, last), true);
+    }
+    return dht::token_range(std::move(start), std::move(end));
+}
+
+static void merge_hash(std::optional<uint64_t>& hash, std::optional<uint64_t> other) {
+    if (!hash || *hash == no_data_hash) {
+        hash = hash ? other : std::nullopt;
+    } else if (!other || *other != no_data_hash) {
+        // Data of the sub-range in both.
+        hash = std::nullopt;
+    }
+}
+
+sub_range_hashes collect_hashes(const std::vector<shared_sstable>& sstables, std::pair<uint32_t, uint32_t> sub_ranges) {
+    auto [first, last] = sub_ranges;
+    sub_range_hashes hashes(last - first + 1, no_data_hash);
+    for (const auto& sst : sstables) {
+        auto* sm = sst->get_scylla_metadata();
+        auto* summary = sm ? sm->get_repair_summary() : nullptr;
+        if (!summary || summary->sub_range_bits != sub_range_bits) {
+            // Only the sub-ranges the sstable spans are unknown.
+            auto from = std::max(sub_range_of(sst->get_first_decorated_key().token()), first);
+            auto to = std::min(sub_range_of(sst->get_last_decorated_key().token()), last);
+            for (auto i = from; i <= to; ++i) {
+                hashes[i - first] = std::nullopt;
+            }
+            continue;
+        }
+        const auto& entries = summary->entries.elements;
+        auto it = std::ranges::lower_bound(entries, first, std::less<>(), &repair_summary_entry::sub_range);
+        for (; it != entries.end() && it->sub_range <= last; ++it) {
+            merge_hash(hashes[it->sub_range - first], it->hash);
+        }
+    }
+    return hashes;
+}
+
+void merge(sub_range_hashes& hashes, const sub_range_hashes& other) {
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        merge_hash(hashes[i], other[i]);
+    }
+}
+
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "dht/i_partitioner_fwd.hh"
+#include "dht/token.hh"
+#include "mutation/tombstone.hh"
+#include "sstables/shared_sstable.hh"
+#include "sstables/types.hh"
+#include "utils/xx_hasher.hh"
+
+class schema;
+class static_row;
+class clustering_row;
+class range_tombstone_change;
+
+namespace sstables {
+
+// Hashes of the contents of an sstable over fixed sub-ranges of the token ring,
+// kept in the Scylla component, see docs/dev/sstable-scylla-format.md.
+//
+// The ring is split into 2^sub_range_bits sub-ranges by the most significant bits
+// of the tokens, so the sub-ranges are aligned with tablets, as long as a table has
+// fewer tablets than sub-ranges. Before reading a range, repair compares the hashes
+// of the sub-ranges of the range on all the replicas, and only reads the sub-ranges
+// whose hashes differ.
+//
+// The hash of a sub-range only describes the contents of the sstable, so it
+// describes the data of the replica only when no other sstable, nor memtable,
+// has data in the sub-range.
+namespace repair_summary {
+
+constexpr unsigned sub_range_bits = 12;
+
+uint32_t sub_range_of(const dht::token& t) noexcept;
+
+// The first and the last sub-ranges covered by the range, if the range starts and
+// ends on sub-range boundaries, std::nullopt otherwise.
+std::optional<std::pair<uint32_t, uint32_t>> aligned_sub_ranges(const dht::token_range& range);
+
+// Computes the summary of an sstable from the fragments which are written to it.
+class builder {
+    const schema& _schema;
+    utils::chunked_vector<repair_summary_entry> _entries;
+    std::optional<uint32_t> _sub_range;
+    xx_hasher _hasher;
+private:
+    void finish_sub_range();
+public:
+    explicit builder(const schema& s) : _schema(s) {}
+
+    void consume_new_partition(const dht::decorated_key& dk);
+    void consume(tombstone t);
+    void consume(const static_row& sr);
+    void consume(const clustering_row& cr);
+    void consume(const range_tombstone_change& rtc);
+    void consume_end_of_partition();
+
+    scylla_metadata::repair_summary build() &&;
+};
+
+// The token range made of the sub-ranges [first, last].
+dht::token_range token_range_of(std::pair<uint32_t, uint32_t> sub_ranges);
+
+// The hash of a sub-range without data.
+constexpr uint64_t no_data_hash = 0;
+
+// The hashes of consecutive sub-ranges: no_data_hash for a sub-range without
+// data, and std::nullopt for a sub-range whose data the summaries don't describe,
+// because it is in more than one sstable, or in an sstable without a summary.
+using sub_range_hashes = std::vector<std::optional<uint64_t>>;
+
+// The hashes of the data of the sstables in the sub-ranges [first, last].
+sub_range_hashes collect_hashes(const std::vector<shared_sstable>& sstables, std::pair<uint32_t, uint32_t> sub_ranges);
+
+// Adds the hashes of data disjoint from the one of `hashes`, e.g. of another
+// shard, for the same sub-ranges, to `hashes`.
+void merge(sub_range_hashes& hashes, const sub_range_hashes& other);
+
+}
+
+}
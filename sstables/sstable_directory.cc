@@ -27,6 +27,8 @@
 #include "utils/directories.hh"
 #include "utils/s3/client.hh"
 #include "replica/database.hh"
+#include "replica/logstor/compression.hh"
+#include "replica/logstor/segment_manager.hh"
 #include "dht/auto_refreshing_sharder.hh"
 
 static logging::logger dirlog("sstable_directory");
@@ -38,6 +40,10 @@ bool manifest_json_filter(const fs::path&, const directory_entry& entry) {
     if (entry.type.value_or(directory_entry_type::regular) != directory_entry_type::directory && (entry.name == "manifest.json" || entry.name == "schema.cql")) {
         return false;
     }
+    // Logstor segments and dictionaries of a snapshot, which aren't sstable components.
+    if (replica::logstor::is_segment_snapshot_file_name(entry.name) || replica::logstor::is_dictionary_file_name(entry.name)) {
+        return false;
+    }
 
     return true;
 }
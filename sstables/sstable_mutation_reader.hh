@@ -147,10 +147,10 @@ struct reversed_context {
 template <typename DataConsumeRowsContext>
 inline reversed_context<DataConsumeRowsContext> data_consume_reversed_partition(
         const schema& s, shared_sstable sst, abstract_index_reader& ir,
-        typename DataConsumeRowsContext::consumer& consumer, sstable::disk_read_range toread) {
+        typename DataConsumeRowsContext::consumer& consumer, sstable::disk_read_range toread, sstable::use_chunk_cache chunk_cache) {
     auto reversing_data_source = sstables::mx::make_partition_reversing_data_source(
             s, sst, ir, toread.start, toread.end - toread.start,
-            consumer.permit(), consumer.trace_state());
+            consumer.permit(), consumer.trace_state(), chunk_cache);
     return reversed_context<DataConsumeRowsContext> {
         .the_context = std::make_unique<DataConsumeRowsContext>(
                 s, std::move(sst), consumer, input_stream<char>(std::move(reversing_data_source.the_source)),
@@ -161,9 +161,10 @@ inline reversed_context<DataConsumeRowsContext> data_consume_reversed_partition(
 
 template <typename DataConsumeRowsContext>
 inline future<std::unique_ptr<DataConsumeRowsContext>> data_consume_single_partition(const schema& s, shared_sstable sst, typename DataConsumeRowsContext::consumer& consumer,
-        sstable::disk_read_range toread, integrity_check integrity) {
+        sstable::disk_read_range toread, integrity_check integrity, sstable::use_chunk_cache chunk_cache) {
     auto input = co_await sst->data_stream(toread.start, toread.end - toread.start,
-            consumer.permit(), consumer.trace_state(), sst->_single_partition_history, sstable::raw_stream::no, integrity);
+            consumer.permit(), consumer.trace_state(), sst->_single_partition_history, sstable::raw_stream::no, integrity,
+            throwing_integrity_error_handler, chunk_cache);
     co_return std::make_unique<DataConsumeRowsContext>(s, std::move(sst), consumer, std::move(input), toread.start, toread.end - toread.start);
 }
 
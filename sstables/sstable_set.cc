@@ -335,18 +335,44 @@ static std::unordered_map<run_id, shared_sstable_run> clone_runs(const std::unor
 }
 
 partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const interval_map_type& leveled_sstables,
-        const lw_shared_ptr<sstable_list>& all, const std::unordered_map<run_id, shared_sstable_run>& all_runs, dht::token_range token_range, file_size_stats bytes_on_disk)
+        const lw_shared_ptr<sstable_list>& all, const std::unordered_map<run_id, shared_sstable_run>& all_runs, dht::token_range token_range, file_size_stats bytes_on_disk,
+        lw_shared_ptr<combined_filter> combined_filter)
         : sstable_set_impl(bytes_on_disk)
         , _schema(schema)
         , _unleveled_sstables(unleveled_sstables)
         , _leveled_sstables(leveled_sstables)
         , _all(make_lw_shared<sstable_list>(*all))
         , _all_runs(clone_runs(all_runs))
-        , _token_range(std::move(token_range)) {
+        , _token_range(std::move(token_range))
+        , _combined_filter(std::move(combined_filter)) {
+    if (_combined_filter) {
+        for (auto& sst : _unleveled_sstables) {
+            _combined_filter->add(sst);
+        }
+    }
+}
+
+partitioned_sstable_set::~partitioned_sstable_set() {
+    if (_combined_filter) {
+        for (auto& sst : _unleveled_sstables) {
+            _combined_filter->remove(*sst);
+        }
+    }
 }
 
 std::unique_ptr<sstable_set_impl> partitioned_sstable_set::clone() const {
-    return std::make_unique<partitioned_sstable_set>(_schema, _unleveled_sstables, _leveled_sstables, _all, _all_runs, _token_range, _file_size_stats);
+    // Sets are replaced by clones as sstables are added and removed, so
+    // disabling the combined filter drops it along with the old sets.
+    lw_shared_ptr<combined_filter> filter;
+    if (combined_filter_enabled()) {
+        filter = _combined_filter;
+    }
+    return std::make_unique<partitioned_sstable_set>(_schema, _unleveled_sstables, _leveled_sstables, _all, _all_runs, _token_range, _file_size_stats,
+            std::move(filter));
+}
+
+bool partitioned_sstable_set::combined_filter_enabled() const {
+    return !_unleveled_sstables.empty() && _unleveled_sstables.front()->manager().get_config().combined_sstable_filter();
 }
 
 std::vector<shared_sstable> partitioned_sstable_set::select(const dht::partition_range& range) const {
@@ -359,6 +385,26 @@ std::vector<shared_sstable> partitioned_sstable_set::select(const dht::partition
     return r;
 }
 
+std::vector<shared_sstable> partitioned_sstable_set::select_by_key(const dht::partition_range& range, const utils::hashed_key& key) const {
+    auto ssts = select(range);
+    if (!combined_filter_enabled()) {
+        return ssts;
+    }
+    if (!_combined_filter) {
+        // The filters are folded in the background, so this read doesn't benefit yet.
+        _combined_filter = make_lw_shared<combined_filter>(_unleveled_sstables.front()->manager());
+        for (auto& sst : _unleveled_sstables) {
+            _combined_filter->add(sst);
+        }
+    }
+    auto candidates = _combined_filter->candidates(key);
+    auto skipped = std::erase_if(ssts, [&] (const shared_sstable& sst) {
+        return _combined_filter->indexes(*sst) && std::ranges::find(candidates, sst.get()) == candidates.end();
+    });
+    combined_filter::account_lookup(skipped);
+    return ssts;
+}
+
 lw_shared_ptr<const sstable_list> partitioned_sstable_set::all() const {
     return _all;
 }
@@ -414,6 +460,9 @@ bool partitioned_sstable_set::insert(shared_sstable sst) {
 
     if (store_as_unleveled(sst)) {
         _unleveled_sstables.push_back(sst);
+        if (_combined_filter) {
+            _combined_filter->add(sst);
+        }
     } else {
         _leveled_sstables_change_cnt++;
         _leveled_sstables.add({make_interval(*sst), value_set({sst})});
@@ -435,7 +484,11 @@ bool partitioned_sstable_set::erase(shared_sstable sst) {
         sub_file_size_stats(sst->get_file_size_stats());
     }
     if (store_as_unleveled(sst)) {
-        _unleveled_sstables.erase(std::remove(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst), _unleveled_sstables.end());
+        auto it = std::remove(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst);
+        if (_combined_filter && it != _unleveled_sstables.end()) {
+            _combined_filter->remove(*sst);
+        }
+        _unleveled_sstables.erase(it, _unleveled_sstables.end());
     } else {
         _leveled_sstables_change_cnt++;
         _leveled_sstables.subtract({make_interval(*sst), value_set({sst})});
@@ -983,7 +1036,7 @@ sstable_set_impl::create_single_key_sstable_reader(
 {
     const auto& pos = pr.start()->value();
     auto hash = utils::make_hashed_key(static_cast<bytes_view>(key::from_partition_key(*schema, *pos.key())));
-    auto selected_sstables = filter_sstable_for_reader(select(pr), *schema, pos, hash, predicate);
+    auto selected_sstables = filter_sstable_for_reader(select_by_key(pr, hash), *schema, pos, hash, predicate);
     auto num_sstables = selected_sstables.size();
     if (!num_sstables) {
         return make_empty_mutation_reader(schema, permit);
@@ -1384,11 +1437,12 @@ sstable_set::make_range_sstable_reader(
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor_generator& monitor_generator,
-        integrity_check integrity) const
+        integrity_check integrity,
+        value_log::reconciler* reconciler) const
 {
-    auto reader_factory_fn = [s, permit, &slice, trace_state, fwd, fwd_mr, &monitor_generator, integrity]
+    auto reader_factory_fn = [s, permit, &slice, trace_state, fwd, fwd_mr, &monitor_generator, integrity, reconciler]
             (shared_sstable& sst, const dht::partition_range& pr) mutable {
-        return sst->make_reader(s, permit, pr, slice, trace_state, fwd, fwd_mr, monitor_generator(sst), integrity);
+        return sst->make_reader(s, permit, pr, slice, trace_state, fwd, fwd_mr, monitor_generator(sst), integrity, nullptr, reconciler);
     };
     return make_combined_reader(s, std::move(permit), std::make_unique<incremental_reader_selector>(s,
                     shared_from_this(),
@@ -1411,15 +1465,16 @@ sstable_set::make_local_shard_sstable_reader(
         read_monitor_generator& monitor_generator,
         const sstable_predicate& predicate,
         combined_reader_statistics* statistics,
-        integrity_check integrity) const
+        integrity_check integrity,
+        value_log::reconciler* reconciler) const
 {
-    auto reader_factory_fn = [s, permit, &slice, trace_state, fwd, fwd_mr, &monitor_generator, &predicate, integrity]
+    auto reader_factory_fn = [s, permit, &slice, trace_state, fwd, fwd_mr, &monitor_generator, &predicate, integrity, reconciler]
             (shared_sstable& sst, const dht::partition_range& pr) mutable {
         SCYLLA_ASSERT(!sst->is_shared());
         if (!predicate(*sst)) {
             return make_empty_mutation_reader(s, permit);
         }
-        auto reader = sst->make_reader(s, permit, pr, slice, trace_state, fwd, fwd_mr, monitor_generator(sst), integrity);
+        auto reader = sst->make_reader(s, permit, pr, slice, trace_state, fwd, fwd_mr, monitor_generator(sst), integrity, nullptr, reconciler);
         // Auto-closed sstable reader is only enabled in the context of fast-forward to partition ranges
         if (!fwd && fwd_mr) {
             return make_auto_closed_sstable_reader(sst, std::move(reader), permit);
@@ -1446,11 +1501,12 @@ mutation_reader sstable_set::make_full_scan_reader(
         reader_permit permit,
         tracing::trace_state_ptr trace_ptr,
         read_monitor_generator& monitor_generator,
-        integrity_check integrity) const {
+        integrity_check integrity,
+        value_log::reconciler* reconciler) const {
     std::vector<mutation_reader> readers;
     readers.reserve(size());
     for_each_sstable([&] (const shared_sstable& sst) mutable {
-        readers.emplace_back(sst->make_full_scan_reader(schema, permit, trace_ptr, monitor_generator(sst), integrity));
+        readers.emplace_back(sst->make_full_scan_reader(schema, permit, trace_ptr, monitor_generator(sst), integrity, reconciler));
     });
     return make_combined_reader(schema, std::move(permit), std::move(readers), streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
 }
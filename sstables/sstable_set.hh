@@ -22,6 +22,7 @@
 
 namespace utils {
 class estimated_histogram;
+class hashed_key;
 }
 
 struct combined_reader_statistics;
@@ -91,6 +92,11 @@ class sstable_set_impl {
     virtual ~sstable_set_impl() {}
     virtual std::unique_ptr<sstable_set_impl> clone() const = 0;
     virtual std::vector<shared_sstable> select(const dht::partition_range& range) const = 0;
+    // Like select(), for a singular range of the given key. May leave out
+    // sstables which are known not to contain the key.
+    virtual std::vector<shared_sstable> select_by_key(const dht::partition_range& range, const utils::hashed_key& key) const {
+        return select(range);
+    }
     virtual std::vector<frozen_sstable_run> all_sstable_runs() const;
     virtual lw_shared_ptr<const sstable_list> all() const = 0;
     virtual stop_iteration for_each_sstable_until(std::function<stop_iteration(const shared_sstable&)> func) const = 0;
@@ -240,7 +246,8 @@ class sstable_set : public enable_lw_shared_from_this<sstable_set> {
         streamed_mutation::forwarding,
         mutation_reader::forwarding,
         read_monitor_generator& rmg = default_read_monitor_generator(),
-        integrity_check integrity = integrity_check::no) const;
+        integrity_check integrity = integrity_check::no,
+        value_log::reconciler* reconciler = nullptr) const;
 
     // Filters out mutations that don't belong to the current shard.
     mutation_reader make_local_shard_sstable_reader(
@@ -254,14 +261,16 @@ class sstable_set : public enable_lw_shared_from_this<sstable_set> {
         read_monitor_generator& rmg = default_read_monitor_generator(),
         const sstable_predicate& p = default_sstable_predicate(),
         combined_reader_statistics* statistics = nullptr,
-        integrity_check integrity = integrity_check::no) const;
+        integrity_check integrity = integrity_check::no,
+        value_log::reconciler* reconciler = nullptr) const;
 
     mutation_reader make_full_scan_reader(
             schema_ptr,
             reader_permit,
             tracing::trace_state_ptr,
             read_monitor_generator& rmg = default_read_monitor_generator(),
-            integrity_check integrity = integrity_check::no) const;
+            integrity_check integrity = integrity_check::no,
+            value_log::reconciler* reconciler = nullptr) const;
 
     friend class compound_sstable_set;
 };
@@ -12,6 +12,7 @@
 
 #include "dht/ring_position.hh"
 #include "sstable_set.hh"
+#include "sstables/combined_filter.hh"
 #include "readers/clustering_combined.hh"
 #include "sstables/types_fwd.hh"
 
@@ -35,6 +36,9 @@ class partitioned_sstable_set : public sstable_set_impl {
     uint64_t _leveled_sstables_change_cnt = 0;
     // Token range spanned by the compaction group owning this sstable set.
     dht::token_range _token_range;
+    // Indexes the filters of _unleveled_sstables. Created by the first single-key read when
+    // enabled, and shared with the clones of the set made while it's enabled.
+    mutable lw_shared_ptr<combined_filter> _combined_filter;
 private:
     static interval_type make_interval(const schema& s, const dht::partition_range& range);
     interval_type make_interval(const dht::partition_range& range) const;
@@ -44,6 +48,7 @@ class partitioned_sstable_set : public sstable_set_impl {
     std::pair<map_iterator, map_iterator> query(const dht::partition_range& range) const;
     // SSTables are stored separately to avoid interval map's fragmentation issue when level 0 falls behind.
     bool store_as_unleveled(const shared_sstable& sst) const;
+    bool combined_filter_enabled() const;
 public:
     static dht::ring_position to_ring_position(const dht::compatible_ring_position_or_view& crp);
     static dht::partition_range to_partition_range(const interval_type& i);
@@ -59,10 +64,13 @@ class partitioned_sstable_set : public sstable_set_impl {
         const lw_shared_ptr<sstable_list>& all,
         const std::unordered_map<run_id, shared_sstable_run>& all_runs,
         dht::token_range token_range,
-        file_size_stats bytes_on_disk);
+        file_size_stats bytes_on_disk,
+        lw_shared_ptr<combined_filter> combined_filter);
+    ~partitioned_sstable_set();
 
     virtual std::unique_ptr<sstable_set_impl> clone() const override;
     virtual std::vector<shared_sstable> select(const dht::partition_range& range) const override;
+    virtual std::vector<shared_sstable> select_by_key(const dht::partition_range& range, const utils::hashed_key& key) const override;
     virtual std::vector<frozen_sstable_run> all_sstable_runs() const override;
     virtual lw_shared_ptr<const sstable_list> all() const override;
     virtual stop_iteration for_each_sstable_until(std::function<stop_iteration(const shared_sstable&)> func) const override;
@@ -52,6 +52,7 @@
 #include "metadata_collector.hh"
 #include "progress_monitor.hh"
 #include "compress.hh"
+#include "compressor.hh"
 #include "checksummed_data_source.hh"
 #include "digest_checked_data_source.hh"
 #include "index_reader.hh"
@@ -59,9 +60,11 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
 #include <seastar/core/align.hh>
+#include <seastar/core/memory.hh>
 #include "mutation/range_tombstone_list.hh"
 #include "binary_search.hh"
 #include "utils/bloom_filter.hh"
+#include "utils/binary_fuse_filter.hh"
 #include "utils/cached_file.hh"
 #include "utils/stall_free.hh"
 #include "utils/checked-file-impl.hh"
@@ -86,12 +89,15 @@
 #include "readers/reversing.hh"
 #include "readers/forwardable.hh"
 #include "sstables/trie/bti_index.hh"
+#include "sstables/combined_filter.hh"
+#include "sstables/decompressed_chunk_cache.hh"
 #include "partition_slice_builder.hh"
 
 #include "release.hh"
 #include "utils/build_id.hh"
 #include "utils/labels.hh"
 #include "utils/io-wrappers.hh"
+#include "sstables/value_log.hh"
 
 #include <boost/lexical_cast.hpp>
 
@@ -859,6 +865,42 @@ void write(sstable_version_types v, file_writer& out, const commitlog_interval&
     write(v, out, ci.end);
 }
 
+static future<> parse_offsets(const schema& s, sstable_version_types v, random_access_reader& in, compression::segmented_offsets& o) {
+    uint32_t len = 0;
+    compression::segmented_offsets::writer offsets = o.get_writer();
+    co_await parse(s, v, in, len);
+    auto eoarr = [&o, &len] { return o.size() == len; };
+
+    while (!eoarr()) {
+        auto now = std::min(len - o.size(), 100000 / sizeof(uint64_t));
+        auto buf = co_await in.read_exactly(now * sizeof(uint64_t));
+        for (size_t i = 0; i < now; ++i) {
+            uint64_t value = read_unaligned<uint64_t>(buf.get() + i * sizeof(uint64_t));
+            offsets.push_back(net::ntoh(value));
+        }
+    }
+}
+
+// The length of the sub-chunks, if the chunks are split into sub-chunks.
+static std::optional<uint32_t> parse_sub_chunk_length(const compression& c) {
+    for (const auto& [k, v] : c.options.elements) {
+        if (to_string_view(k.value) != compression_parameters::SUB_CHUNK_LENGTH_KB) {
+            continue;
+        }
+        uint32_t sub_chunk_len = 0;
+        try {
+            sub_chunk_len = std::stoul(sstring(to_string_view(v.value))) * 1024;
+        } catch (...) {
+            throw_malformed_sstable_exception(format("CompressionInfo is malformed: invalid {}: {}", to_string_view(k.value), to_string_view(v.value)));
+        }
+        if (sub_chunk_len == 0 || sub_chunk_len >= c.uncompressed_chunk_length() || c.uncompressed_chunk_length() % sub_chunk_len) {
+            throw_malformed_sstable_exception(format("CompressionInfo is malformed: sub_chunk_len={} doesn't divide chunk_len={}", sub_chunk_len, c.uncompressed_chunk_length()));
+        }
+        return sub_chunk_len;
+    }
+    return std::nullopt;
+}
+
 future<> parse(const schema& s, sstable_version_types v, random_access_reader& in, compression& c) {
     uint64_t data_len = 0;
     uint32_t chunk_len = 0;
@@ -870,34 +912,25 @@ future<> parse(const schema& s, sstable_version_types v, random_access_reader& i
     c.set_uncompressed_chunk_length(chunk_len);
     c.set_uncompressed_file_length(data_len);
 
-    uint32_t len = 0;
-    compression::segmented_offsets::writer offsets = c.offsets.get_writer();
-    co_await parse(s, v, in, len);
-    auto eoarr = [&c, &len] { return c.offsets.size() == len; };
+    co_await parse_offsets(s, v, in, c.offsets);
 
-    while (!eoarr()) {
-        auto now = std::min(len - c.offsets.size(), 100000 / sizeof(uint64_t));
-        auto buf = co_await in.read_exactly(now * sizeof(uint64_t));
-        for (size_t i = 0; i < now; ++i) {
-            uint64_t value = read_unaligned<uint64_t>(buf.get() + i * sizeof(uint64_t));
-            offsets.push_back(net::ntoh(value));
-        }
+    if (auto sub_chunk_len = parse_sub_chunk_length(c)) {
+        c.set_uncompressed_sub_chunk_length(*sub_chunk_len);
+        co_await parse_offsets(s, v, in, c.sub_chunk_offsets);
     }
 }
 
-void write(sstable_version_types v, file_writer& out, const compression& c) {
-    write(v, out, c.name, c.options, c.uncompressed_chunk_length(), c.uncompressed_file_length());
-
-    write(v, out, static_cast<uint32_t>(c.offsets.size()));
+static void write_offsets(sstable_version_types v, file_writer& out, const compression::segmented_offsets& offsets) {
+    write(v, out, static_cast<uint32_t>(offsets.size()));
 
     std::vector<uint64_t> tmp;
     const size_t per_loop = 100000 / sizeof(uint64_t);
     tmp.resize(per_loop);
     size_t idx = 0;
-    while (idx != c.offsets.size()) {
-        auto now = std::min(c.offsets.size() - idx, per_loop);
+    while (idx != offsets.size()) {
+        auto now = std::min(offsets.size() - idx, per_loop);
         // copy offsets into tmp converting each entry into big-endian representation.
-        auto nr = c.offsets.begin() + idx;
+        auto nr = offsets.begin() + idx;
         for (size_t i = 0; i < now; i++) {
             tmp[i] = net::hton(nr[i]);
         }
@@ -908,6 +941,19 @@ void write(sstable_version_types v, file_writer& out, const compression& c) {
     }
 }
 
+void write(sstable_version_types v, file_writer& out, const compression& c) {
+    write(v, out, c.name, c.options, c.uncompressed_chunk_length(), c.uncompressed_file_length());
+
+    write_offsets(v, out, c.offsets);
+
+    // The sub-chunk offsets follow the chunk offsets. They're written only
+    // for sstables with the sub_chunk_length_in_kb option, which other
+    // implementations can't read anyway.
+    if (c.has_sub_chunks()) {
+        write_offsets(v, out, c.sub_chunk_offsets);
+    }
+}
+
 static inline sstring parent_path(const sstring& fname) {
     return fs::canonical(fs::path(fname)).parent_path().string();
 }
@@ -1849,6 +1895,10 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
 
     if (this->has_component(component_type::CompressionInfo)) {
         _components->compression.update(st.st_size);
+        _chunk_cache = seastar::make_shared<decompressed_chunk_cache>(
+            _manager.get_cache_tracker().get_data_chunk_cache_stats(),
+            _manager.get_cache_tracker().get_lru(),
+            _manager.get_cache_tracker().region());
     }
     _data_file_size = st.st_size;
     _data_file_write_time = db_clock::from_time_t(st.st_mtime);
@@ -1901,6 +1951,16 @@ future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
     if (cfg.load_first_and_last_position_metadata) {
         co_await load_first_and_last_position_in_partition();
     }
+
+    // A value file is linked by each sstable which points into it, so that its
+    // size is counted once in the size of a set of sstables.
+    _value_files_size_on_disk = 0;
+    if (auto* vl = get_value_log()) {
+        for (auto& f : vl->files.elements) {
+            auto sd = co_await sstable_io_check(_read_error_handler, file_stat, value_file_name(f.id), follow_symlink::yes);
+            _value_files_size_on_disk += sd.size / std::max(sd.number_of_links, uint64_t(1));
+        }
+    }
 }
 
 future<> sstable::create_data() noexcept {
@@ -1923,12 +1983,17 @@ future<> sstable::drop_caches() {
     if (_cached_rows_file) {
         co_await _cached_rows_file->evict_gently();
     }
+    if (_chunk_cache) {
+        co_await _chunk_cache->evict_gently();
+    }
     co_await _index_cache->evict_gently();
 }
 
-// Return the filter format for the given sstable version
-static inline utils::filter_format get_filter_format(sstable_version_types version) {
-    return (version >= sstable_version_types::mc)
+utils::filter_format sstable::bloom_filter_format() const {
+    if (has_feature(sstable_feature::BlockedBloomFilter)) {
+        return utils::filter_format::blocked_format;
+    }
+    return (_version >= sstable_version_types::mc)
                ? utils::filter_format::m_format
                : utils::filter_format::k_l_format;
 }
@@ -1942,9 +2007,13 @@ future<> sstable::read_filter(sstable_open_config cfg) {
     return seastar::async([this] () mutable {
         sstables::filter filter;
         read_simple_and_verify_digest<component_type::Filter>(filter).get();
+        if (has_feature(sstable_feature::BinaryFuseFilter)) {
+            _components->filter = std::make_unique<utils::filter::binary_fuse_filter>(filter.hashes, std::move(filter.buckets.elements));
+            return;
+        }
         auto nr_bits = filter.buckets.elements.size() * std::numeric_limits<typename decltype(filter.buckets.elements)::value_type>::digits;
         large_bitset bs(nr_bits, std::move(filter.buckets.elements));
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), get_filter_format(_version));
+        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), bloom_filter_format());
     });
 }
 
@@ -1953,7 +2022,14 @@ void sstable::write_filter() {
         return;
     }
 
-    auto f = downcast_ptr<utils::filter::murmur3_bloom_filter>(_components->filter.get());
+    if (has_feature(sstable_feature::BinaryFuseFilter)) {
+        auto f = downcast_ptr<utils::filter::binary_fuse_filter>(_components->filter.get());
+        auto filter_ref = sstables::filter_ref(f->fingerprint_bits(), f->data());
+        _components_digests.map[component_type::Filter] = write_simple_with_digest<component_type::Filter>(filter_ref);
+        return;
+    }
+
+    auto f = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get());
 
     auto&& bs = f->bits();
     auto filter_ref = sstables::filter_ref(f->num_hashes(), bs.get_storage());
@@ -1974,9 +2050,9 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     // false positive rate.
     auto curr_bitset_size = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get())->bits().memory_size();
     auto bitset_size_lower_bound = utils::i_filter::get_filter_size(num_partitions,
-                                                                    _schema->bloom_filter_fp_chance() * 1.25);
+                                                                    _schema->bloom_filter_fp_chance() * 1.25, bloom_filter_format());
     auto bitset_size_upper_bound = utils::i_filter::get_filter_size(num_partitions,
-                                                                    _schema->bloom_filter_fp_chance() * 0.75);
+                                                                    _schema->bloom_filter_fp_chance() * 0.75, bloom_filter_format());
     if (bitset_size_lower_bound <= curr_bitset_size && curr_bitset_size <= bitset_size_upper_bound) {
         return;
     }
@@ -1988,7 +2064,7 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     //    - to avoid downsizing when the savings are minimal.
     //    - the fp rate is also already at least at the configured value, so no gain there.
     // 3. Do not resize filters of garbage_collected sstables.
-    const auto optimal_filter_size = utils::i_filter::get_filter_size(num_partitions, _schema->bloom_filter_fp_chance());
+    const auto optimal_filter_size = utils::i_filter::get_filter_size(num_partitions, _schema->bloom_filter_fp_chance(), bloom_filter_format());
     const auto filter_size_diff = std::abs<int64_t>(optimal_filter_size - curr_bitset_size);
     if (filter_size_diff < 1024 || filter_size_diff < 0.1 * curr_bitset_size || // [1]
             (curr_bitset_size > optimal_filter_size && curr_bitset_size < 16384) || // [2]
@@ -2007,7 +2083,7 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     };
 
     // Create a new filter that can optimally represent the given num_partitions.
-    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), get_filter_format(_version));
+    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), bloom_filter_format());
     sstlog.info("Rebuilding bloom filter {}: resizing bitset from {} bytes to {} bytes. sstable origin: {}", filename(component_type::Filter), curr_bitset_size,
                 downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
 
@@ -2045,50 +2121,98 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
 }
 
 void sstable::build_delayed_filter(uint64_t num_partitions) {
-    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), get_filter_format(_version));
-    sstlog.debug("Building delayed bloom filter {}: {} filter bytes. sstable origin: {}", filename(component_type::Filter),
-        downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
-
     auto hashes_file = open_file(component_type::TemporaryHashes, open_flags::ro).get();
     auto hashes_file_closer = deferred_close(hashes_file);
     constexpr uint64_t murmur_hash_size_bytes = 16;
 
-    file_input_stream_options options = {
-        .buffer_size = sstable_buffer_size,
-        .read_ahead = 1,
-    };
-    auto in = make_file_input_stream(hashes_file, 0, num_partitions * murmur_hash_size_bytes, options);
-    auto in_closer = deferred_close(in);
-
-    constexpr uint64_t batch_size_bytes = 4096;
-    static_assert(batch_size_bytes % murmur_hash_size_bytes == 0, "Batch size must be a multiple of hash size");
-
-    size_t processed_hashes = 0;
-    while (processed_hashes < num_partitions) {
-        auto buf = in.read_exactly(batch_size_bytes).get();
-        auto p = buf.get();
-        for (uint64_t offset = 0; offset + murmur_hash_size_bytes <= buf.size(); offset += murmur_hash_size_bytes) {
-            std::array<uint64_t, 2> hash;
-            std::memcpy(hash.data(), p + offset, sizeof(hash));
-            hash[0] = seastar::le_to_cpu(hash[0]);
-            hash[1] = seastar::le_to_cpu(hash[1]);
-            auto hashed_key = utils::hashed_key(hash);
-            optimal_filter->add(hashed_key);
-            processed_hashes++;
+    auto for_each_hash = [&] (auto&& func) {
+        file_input_stream_options options = {
+            .buffer_size = sstable_buffer_size,
+            .read_ahead = 1,
+        };
+        auto in = make_file_input_stream(hashes_file, 0, num_partitions * murmur_hash_size_bytes, options);
+        auto in_closer = deferred_close(in);
+
+        constexpr uint64_t batch_size_bytes = 4096;
+        static_assert(batch_size_bytes % murmur_hash_size_bytes == 0, "Batch size must be a multiple of hash size");
+
+        size_t processed_hashes = 0;
+        while (processed_hashes < num_partitions) {
+            auto buf = in.read_exactly(batch_size_bytes).get();
+            auto p = buf.get();
+            for (uint64_t offset = 0; offset + murmur_hash_size_bytes <= buf.size(); offset += murmur_hash_size_bytes) {
+                std::array<uint64_t, 2> hash;
+                std::memcpy(hash.data(), p + offset, sizeof(hash));
+                hash[0] = seastar::le_to_cpu(hash[0]);
+                hash[1] = seastar::le_to_cpu(hash[1]);
+                func(utils::hashed_key(hash));
+                processed_hashes++;
+            }
+            if (buf.size() < batch_size_bytes) {
+                break;
+            }
         }
-        if (buf.size() < batch_size_bytes) {
-            break;
+        if (processed_hashes != num_partitions) {
+            throw_malformed_sstable_exception(fmt::format("Temporary hashes file {} was supposed to contain {} hashes, but it contains only {} hashes",
+                filename(component_type::TemporaryHashes), num_partitions, processed_hashes));
+        }
+    };
+
+    utils::filter_ptr optimal_filter;
+    if (has_feature(sstable_feature::BinaryFuseFilter)) {
+        optimal_filter = build_binary_fuse_filter(num_partitions, for_each_hash);
+        if (!optimal_filter) {
+            _features.disable(sstable_feature::BinaryFuseFilter);
         }
     }
-    if (processed_hashes != num_partitions) {
-        throw_malformed_sstable_exception(fmt::format("Temporary hashes file {} was supposed to contain {} hashes, but it contains only {} hashes",
-            filename(component_type::TemporaryHashes), num_partitions, processed_hashes));
+    if (!optimal_filter) {
+        optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), bloom_filter_format());
+        for_each_hash([&] (const utils::hashed_key& hashed_key) {
+            optimal_filter->add(hashed_key);
+        });
+        sstlog.debug("Built delayed bloom filter {}: {} filter bytes. sstable origin: {}", filename(component_type::Filter),
+            downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
     }
 
     _components->filter.swap(optimal_filter);
     unlink_component(component_type::TemporaryHashes).get();
 }
 
+template <typename ForEachHash>
+utils::filter_ptr sstable::build_binary_fuse_filter(uint64_t num_partitions, ForEachHash&& for_each_hash) {
+    using utils::filter::binary_fuse_filter;
+
+    auto fingerprint_bits = binary_fuse_filter::fingerprint_bits_for(_schema->bloom_filter_fp_chance());
+    if (!fingerprint_bits) {
+        sstlog.debug("Using a bloom filter for {}: no binary fuse filter provides false-positive chance {}",
+                filename(component_type::Filter), _schema->bloom_filter_fp_chance());
+        return nullptr;
+    }
+    // The construction needs all the keys at once, so avoid it when they'd
+    // take a considerable part of the shard's memory.
+    auto build_memory = num_partitions * sizeof(uint64_t) + binary_fuse_filter::get_build_memory_size(num_partitions);
+    auto max_build_memory = memory::stats().total_memory() / 10;
+    if (build_memory > max_build_memory) {
+        sstlog.info("Using a bloom filter for {}: building a binary fuse filter for {} partitions needs {} bytes, above the limit of {} bytes",
+                filename(component_type::Filter), num_partitions, build_memory, max_build_memory);
+        return nullptr;
+    }
+
+    binary_fuse_filter::storage keys;
+    keys.reserve(num_partitions);
+    for_each_hash([&] (const utils::hashed_key& hashed_key) {
+        keys.push_back(hashed_key.hash()[0]);
+    });
+    auto filter = binary_fuse_filter::build(keys, fingerprint_bits);
+    if (!filter) {
+        sstlog.warn("Failed to build a binary fuse filter for {}, using a bloom filter instead", filename(component_type::Filter));
+        return nullptr;
+    }
+    sstlog.debug("Built binary fuse filter {}: {} filter bytes. sstable origin: {}", filename(component_type::Filter),
+        filter->memory_size(), _origin);
+    return filter;
+}
+
 size_t sstable::total_reclaimable_memory_size() const {
     if (!_total_reclaimable_memory) {
         _total_reclaimable_memory = _components->filter ? _components->filter->memory_size() : 0;
@@ -2112,6 +2236,9 @@ size_t sstable::reclaim_memory_from_components() {
 
     _total_reclaimable_memory.reset();
     _total_memory_reclaimed += memory_reclaimed_this_iteration;
+    if (memory_reclaimed_this_iteration) {
+        _manager.notify_filter_replaced(*this);
+    }
     return memory_reclaimed_this_iteration;
 }
 
@@ -2130,6 +2257,7 @@ future<> sstable::reload_reclaimed_components() {
     co_await read_filter();
     _total_reclaimable_memory.reset();
     _total_memory_reclaimed -= _components->filter->memory_size();
+    _manager.notify_filter_replaced(*this);
     sstlog.info("Reloaded bloom filter of {}", get_filename());
 }
 
@@ -2482,7 +2610,8 @@ static sstable_column_kind to_sstable_column_kind(column_kind k) {
 void
 sstable::write_scylla_metadata(shard_id shard, struct run_identifier identifier,
         std::optional<scylla_metadata::large_data_stats> ld_stats, std::optional<scylla_metadata::ext_timestamp_stats> ts_stats,
-        std::optional<scylla_metadata::large_data_records> ld_records) {
+        std::optional<scylla_metadata::large_data_records> ld_records, std::optional<scylla_metadata::repair_summary> repair_summary,
+        std::optional<scylla_metadata::value_log> value_log) {
     auto&& first_key = get_first_decorated_key();
     auto&& last_key = get_last_decorated_key();
 
@@ -2508,6 +2637,12 @@ sstable::write_scylla_metadata(shard_id shard, struct run_identifier identifier,
     if (ld_records) {
         _components->scylla_metadata->data.set<scylla_metadata_type::LargeDataRecords>(std::move(*ld_records));
     }
+    if (repair_summary) {
+        _components->scylla_metadata->data.set<scylla_metadata_type::RepairSummary>(std::move(*repair_summary));
+    }
+    if (value_log) {
+        _components->scylla_metadata->data.set<scylla_metadata_type::ValueLog>(std::move(*value_log));
+    }
     if (!_origin.empty()) {
         scylla_metadata::sstable_origin o;
         o.value = bytes(to_bytes_view(std::string_view(_origin)));
@@ -2890,8 +3025,8 @@ file_size_stats sstable::get_file_size_stats() const {
     uint64_t size_without_data = _metadata_size_on_disk + _index_file_size + _partitions_file_size + _rows_file_size;
 
     file_size_stats stats;
-    stats.on_disk = size_without_data + _data_file_size;
-    stats.before_compression = size_without_data + data_size();
+    stats.on_disk = size_without_data + _data_file_size + _value_files_size_on_disk;
+    stats.before_compression = size_without_data + data_size() + _value_files_size_on_disk;
     return stats;
 }
 
@@ -3009,9 +3144,40 @@ std::vector<std::pair<component_type, sstring>> sstable::all_components() const
     for (auto& c : _unrecognized_components) {
         all.push_back(std::make_pair(component_type::Unknown, c));
     }
+    // Value files aren't listed in the TOC, see sstables/value_log.hh.
+    if (auto* vl = get_value_log()) {
+        for (auto& f : vl->files.elements) {
+            all.push_back(std::make_pair(component_type::Unknown, value_log::component_name(f.id)));
+        }
+    } else {
+        for (auto& id : _new_value_files) {
+            all.push_back(std::make_pair(component_type::Unknown, value_log::component_name(id)));
+        }
+    }
     return all;
 }
 
+sstring sstable::value_file_name(value_file_id id) const {
+    return fmt::format("{}/{}", _storage->prefix(), component_basename(_schema->ks_name(), _schema->cf_name(), _version, _generation, _format, value_log::component_name(id)));
+}
+
+future<file> sstable::get_value_file(value_file_id id) {
+    auto it = _value_files.find(id);
+    if (it == _value_files.end()) {
+        it = _value_files.emplace(id, open_checked_file_dma(_read_error_handler, value_file_name(id), open_flags::ro)).first;
+    }
+    return it->second.get_future();
+}
+
+future<file> sstable::create_value_file(value_file_id id) {
+    add_value_file(id);
+    return open_checked_file_dma(_write_error_handler, value_file_name(id), open_flags::wo | open_flags::create | open_flags::exclusive);
+}
+
+void sstable::add_value_file(value_file_id id) {
+    _new_value_files.push_back(id);
+}
+
 future<> sstable::snapshot(const sstring& name) const {
     auto lock = co_await get_units(_mutate_sem, 1);
     co_await _storage->snapshot(*this, format("{}/{}", sstables::snapshots_dir, name));
@@ -3039,6 +3205,34 @@ future<> delayed_commit_changes::commit() {
 
 mutation_reader
 sstable::make_reader(
+        schema_ptr query_schema,
+        reader_permit permit,
+        const dht::partition_range& range,
+        const query::partition_slice& slice,
+        tracing::trace_state_ptr trace_state,
+        streamed_mutation::forwarding fwd,
+        mutation_reader::forwarding fwd_mr,
+        read_monitor& mon,
+        integrity_check integrity,
+        const utils::hashed_key* single_partition_read_murmur_hash,
+        value_log::reconciler* reconciler
+) {
+    auto rd = make_data_file_reader(std::move(query_schema), std::move(permit), range, slice, std::move(trace_state),
+            fwd, fwd_mr, mon, integrity, single_partition_read_murmur_hash);
+    if (reconciler) {
+        if (!has_value_log()) {
+            rd = value_log::make_escaping_reader(std::move(rd));
+        }
+        return reconciler->make_recording_reader(shared_from_this(), std::move(rd));
+    }
+    if (has_value_log()) {
+        return value_log::make_resolving_reader(shared_from_this(), std::move(rd), &slice);
+    }
+    return rd;
+}
+
+mutation_reader
+sstable::make_data_file_reader(
         schema_ptr query_schema,
         reader_permit permit,
         const dht::partition_range& range,
@@ -3105,6 +3299,27 @@ sstable::make_reader(
 
 mutation_reader
 sstable::make_full_scan_reader(
+        schema_ptr schema,
+        reader_permit permit,
+        tracing::trace_state_ptr trace_state,
+        read_monitor& monitor,
+        integrity_check integrity,
+        value_log::reconciler* reconciler) {
+    auto rd = make_data_file_full_scan_reader(std::move(schema), std::move(permit), std::move(trace_state), monitor, integrity);
+    if (reconciler) {
+        if (!has_value_log()) {
+            rd = value_log::make_escaping_reader(std::move(rd));
+        }
+        return reconciler->make_recording_reader(shared_from_this(), std::move(rd));
+    }
+    if (has_value_log()) {
+        return value_log::make_resolving_reader(shared_from_this(), std::move(rd), nullptr);
+    }
+    return rd;
+}
+
+mutation_reader
+sstable::make_data_file_full_scan_reader(
         schema_ptr schema,
         reader_permit permit,
         tracing::trace_state_ptr trace_state,
@@ -3243,19 +3458,19 @@ component_type sstable::component_from_sstring(version_types v, const sstring &s
 
 future<input_stream<char>> sstable::data_stream(uint64_t pos, size_t len,
         reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw,
-        integrity_check integrity, integrity_error_handler error_handler) {
+        integrity_check integrity, integrity_error_handler error_handler, use_chunk_cache chunk_cache) {
     file_input_stream_options options;
     options.buffer_size = sstable_buffer_size;
     options.read_ahead = 4;
     options.dynamic_adjustments = std::move(history);
-    return data_stream(pos, len, permit, std::move(trace_state), history, std::move(options), raw, integrity, std::move(error_handler));
+    return data_stream(pos, len, permit, std::move(trace_state), history, std::move(options), raw, integrity, std::move(error_handler), chunk_cache);
 }
 
 future<input_stream<char>> sstable::data_stream(uint64_t pos, size_t len,
         reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history,
         file_input_stream_options options,
         raw_stream raw, integrity_check integrity,
-        integrity_error_handler error_handler) {
+        integrity_error_handler error_handler, use_chunk_cache chunk_cache) {
 
     file f = make_tracked_file(_data_file, permit);
     if (trace_state) {
@@ -3271,8 +3486,9 @@ future<input_stream<char>> sstable::data_stream(uint64_t pos, size_t len,
     };
     if (_components->compression && raw == raw_stream::no) {
         if (_version >= sstable_version_types::mc) {
+            auto cache = chunk_cache && _manager.get_config().decompressed_chunk_cache() ? _chunk_cache.get() : nullptr;
             co_return make_compressed_file_m_format_input_stream(stream_creator, &_components->compression,
-               pos, len, std::move(options), permit, digest);
+               pos, len, std::move(options), permit, digest, cache);
         } else {
             co_return make_compressed_file_k_l_format_input_stream(stream_creator, &_components->compression,
                 pos, len, std::move(options), permit, digest);
@@ -3297,8 +3513,9 @@ future<input_stream<char>> sstable::data_stream(uint64_t pos, size_t len,
     co_return co_await stream_creator(pos, len, std::move(options));
 }
 
-future<temporary_buffer<char>> sstable::data_read(uint64_t pos, size_t len, reader_permit permit) {
-    auto stream = co_await data_stream(pos, len, std::move(permit), tracing::trace_state_ptr(), {});
+future<temporary_buffer<char>> sstable::data_read(uint64_t pos, size_t len, reader_permit permit, use_chunk_cache chunk_cache) {
+    auto stream = co_await data_stream(pos, len, std::move(permit), tracing::trace_state_ptr(), {}, raw_stream::no, integrity_check::no,
+            throwing_integrity_error_handler, chunk_cache);
     auto buff = co_await stream.read_exactly(len);
     co_await stream.close();
     co_return buff;
@@ -3707,6 +3924,19 @@ future<> sstable::close_files() {
             general_disk_error();
         }));
     }
+    for (auto& [id, f] : std::exchange(_value_files, {})) {
+        close_futures.push_back(f.get_future().then_wrapped([me = shared_from_this()] (future<file> f) {
+            // A value file which failed to open has nothing to close.
+            if (f.failed()) {
+                f.ignore_ready_future();
+                return make_ready_future<>();
+            }
+            return f.get().close().handle_exception([me] (auto ep) {
+                sstlog.warn("sstable close value file failed: {}", ep);
+                general_disk_error();
+            });
+        }));
+    }
 
     if (_marked_for_deletion != mark_for_deletion::none && !_unlinked_at) {
         // If a deletion fails for some reason we
@@ -4028,6 +4258,22 @@ void register_index_page_cache_metrics(seastar::metrics::metric_groups& metrics,
     });
 }
 
+void register_data_chunk_cache_metrics(seastar::metrics::metric_groups& metrics, cached_file_stats& m) {
+    namespace sm = seastar::metrics;
+    metrics.add_group("sstables", {
+        sm::make_counter("data_chunk_cache_hits", [&m] { return m.page_hits; },
+            sm::description("Decompressed data chunk requests which were served from cache")),
+        sm::make_counter("data_chunk_cache_misses", [&m] { return m.page_misses; },
+            sm::description("Decompressed data chunk requests which had to read and decompress the chunk")),
+        sm::make_counter("data_chunk_cache_evictions", [&m] { return m.page_evictions; },
+            sm::description("Total number of decompressed data chunks which have been evicted from the cache")),
+        sm::make_counter("data_chunk_cache_populations", [&m] { return m.page_populations; },
+            sm::description("Total number of decompressed data chunks which were inserted into the cache")),
+        sm::make_gauge("data_chunk_cache_bytes", [&m] { return m.cached_bytes; },
+            sm::description("Total number of bytes cached in the decompressed data chunk cache")),
+    });
+}
+
 void register_index_page_metrics(seastar::metrics::metric_groups& metrics, partition_index_cache_stats& m) {
     namespace sm = seastar::metrics;
     metrics.add_group("sstables", {
@@ -4128,6 +4374,18 @@ future<> init_metrics() {
 
         sm::make_gauge("bloom_filter_memory_size", [] { return utils::filter::bloom_filter::get_shard_stats().memory_size; },
             sm::description("Bloom filter memory usage in bytes.")),
+
+        sm::make_gauge("binary_fuse_filter_memory_size", [] { return utils::filter::binary_fuse_filter::get_shard_stats().memory_size; },
+            sm::description("Binary fuse filter memory usage in bytes.")),
+
+        sm::make_gauge("combined_filter_memory_size", [] { return combined_filter::get_shard_stats().memory_size; },
+            sm::description("Memory used by the combined filters of sstable sets, in bytes.")),
+        sm::make_counter("combined_filter_lookups", [] { return combined_filter::get_shard_stats().lookups; },
+            sm::description("Number of single-partition reads which probed the combined filter of an sstable set")),
+        sm::make_counter("combined_filter_sstables_skipped", [] { return combined_filter::get_shard_stats().sstables_skipped; },
+            sm::description("Number of sstables skipped by single-partition reads thanks to the combined filter, without probing their own filters")),
+        sm::make_gauge("combined_filter_sstables_pending", [] { return combined_filter::get_shard_stats().sstables_pending; },
+            sm::description("Number of sstables waiting for their filters to be folded into the combined filters of sstable sets")),
     });
   });
 }
@@ -4211,6 +4469,9 @@ future<> sstable::destroy() {
     if (_cached_index_file) {
         co_await _cached_index_file->evict_gently();
     }
+    if (_chunk_cache) {
+        co_await _chunk_cache->evict_gently();
+    }
     co_await _storage->destroy(*this);
 
     if (ex) {
@@ -19,6 +19,7 @@
 #include <seastar/core/sstring.hh>
 #include <seastar/core/enum.hh>
 #include <seastar/core/shared_ptr.hh>
+#include <seastar/core/shared_future.hh>
 #include <unordered_set>
 #include <unordered_map>
 #include <variant>
@@ -81,11 +82,16 @@ namespace mc {
 class writer;
 }
 
+namespace value_log {
+struct sources;
+}
+
 namespace fs = std::filesystem;
 
 extern logging::logger sstlog;
 class sstable_writer;
 class sstables_manager;
+class decompressed_chunk_cache;
 
 struct foreign_sstable_open_info;
 
@@ -126,7 +132,16 @@ struct sstable_writer_config {
     uint64_t summary_max_partitions_per_page;
     sstring origin;
     bool correct_pi_block_width = true;
+    bool blocked_bloom_filter = false;
+    // Choose the compression chunk length of the sstable from the size of its
+    // partitions, unless the table sets chunk_length_in_kb.
+    bool adaptive_compression_chunk_length = false;
     uint32_t large_data_records_per_sstable = 10;
+    // Write the hashes used by repair to skip identical token sub-ranges, see sstables/repair_summary.hh.
+    bool repair_summary = false;
+    // The value files of the input sstables of a compaction, which reads them with
+    // a value_log::reconciler, see sstables/value_log.hh.
+    lw_shared_ptr<const value_log::sources> value_log_sources;
 
 private:
     explicit sstable_writer_config() {}
@@ -298,6 +313,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     // Returns a mutation_reader for given range of partitions.
     //
+    // The values which are in value files are read, unless a reconciler is
+    // passed, see sstables/value_log.hh.
+    //
     // Precondition: if the slice is reversed, the schema must be reversed as well.
     mutation_reader make_reader(
             schema_ptr query_schema,
@@ -309,7 +327,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
             mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::yes,
             read_monitor& monitor = default_read_monitor(),
             integrity_check integrity = integrity_check::no,
-            const utils::hashed_key* single_partition_read_murmur_hash = nullptr
+            const utils::hashed_key* single_partition_read_murmur_hash = nullptr,
+            value_log::reconciler* reconciler = nullptr
         );
 
     // A reader which doesn't use the index at all. It reads everything from the
@@ -319,7 +338,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
             reader_permit permit,
             tracing::trace_state_ptr trace_state = {},
             read_monitor& monitor = default_read_monitor(),
-            integrity_check integrity = integrity_check::no);
+            integrity_check integrity = integrity_check::no,
+            value_log::reconciler* reconciler = nullptr);
 
     // Returns mutation_source containing all writes contained in this sstable.
     // The mutation_source shares ownership of this sstable.
@@ -561,6 +581,13 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     std::unordered_set<component_type, enum_hash<component_type>> _recognized_components;
     std::vector<sstring> _unrecognized_components;
+    // The value files created or linked by the sstable writer, until the Scylla
+    // component lists them.
+    std::vector<value_file_id> _new_value_files;
+    std::unordered_map<value_file_id, shared_future<file>> _value_files;
+    // The share of the sstable in the on-disk size of its value files, which is
+    // divided between the sstables which link to each file when it's opened.
+    uint64_t _value_files_size_on_disk = 0;
 
     foreign_ptr<lw_shared_ptr<shareable_components>> _components = make_foreign(make_lw_shared<shareable_components>());
     column_translation _column_translation;
@@ -576,6 +603,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     std::optional<trie::bti_partitions_db_footer> _partitions_db_footer;
     file _rows_file;
     seastar::shared_ptr<cached_file> _cached_rows_file;
+    // Set for compressed sstables.
+    seastar::shared_ptr<decompressed_chunk_cache> _chunk_cache;
     uint64_t _data_file_size;
     uint64_t _index_file_size = 0;
     uint64_t _partitions_file_size = 0;
@@ -689,6 +718,26 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     static future<std::pair<std::vector<sstring>, uint32_t>> read_and_parse_toc(file f);
 private:
     void unused(); // Called when reference count drops to zero
+
+    // The readers of what the data file has, with the pointers to the values in
+    // value files, see make_reader() and make_full_scan_reader().
+    mutation_reader make_data_file_reader(
+            schema_ptr query_schema,
+            reader_permit permit,
+            const dht::partition_range& range,
+            const query::partition_slice& slice,
+            tracing::trace_state_ptr trace_state,
+            streamed_mutation::forwarding fwd,
+            mutation_reader::forwarding fwd_mr,
+            read_monitor& monitor,
+            integrity_check integrity,
+            const utils::hashed_key* single_partition_read_murmur_hash);
+    mutation_reader make_data_file_full_scan_reader(
+            schema_ptr schema,
+            reader_permit permit,
+            tracing::trace_state_ptr trace_state,
+            read_monitor& monitor,
+            integrity_check integrity);
     future<file> open_file(component_type, open_flags, file_open_options = {}) const noexcept;
 
     template <component_type Type, typename T>
@@ -743,13 +792,16 @@ class sstable : public enable_lw_shared_from_this<sstable> {
                                run_identifier identifier,
                                std::optional<scylla_metadata::large_data_stats> ld_stats,
                                std::optional<scylla_metadata::ext_timestamp_stats> ts_stats,
-                               std::optional<scylla_metadata::large_data_records> ld_records = std::nullopt);
+                               std::optional<scylla_metadata::large_data_records> ld_records = std::nullopt,
+                               std::optional<scylla_metadata::repair_summary> repair_summary = std::nullopt,
+                               std::optional<scylla_metadata::value_log> value_log = std::nullopt);
     sstable_id ensure_sstable_identifier();
     // Verifies that the sstable identifier persisted in the Scylla metadata
     // agrees with the one this sstable is known by, when both are known.
     void validate_sstable_identifier() const;
 
     future<> read_filter(sstable_open_config cfg = {});
+    utils::filter_format bloom_filter_format() const;
 
     void write_filter();
     // Rebuild a bloom filter from the index with the given number of
@@ -758,7 +810,13 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // This should be called only before an sstable is sealed.
     void maybe_rebuild_filter_from_index(uint64_t num_partitions);
 
+    // Builds the filter from the TemporaryHashes component, which holds the
+    // hashes of all the partition keys of the sstable.
     void build_delayed_filter(uint64_t num_partitions);
+    // Returns nullptr if a binary fuse filter can't be used for the sstable,
+    // in which case it should get a bloom filter.
+    template <typename ForEachHash>
+    utils::filter_ptr build_binary_fuse_filter(uint64_t num_partitions, ForEachHash&& for_each_hash);
 
     future<> update_info_for_opened_data(sstable_open_config cfg = {});
 
@@ -861,21 +919,29 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // logic when a checksum or digest mismatch is detected on an
     // integrity-checked stream with no compression. The parameter is ignored
     // if integrity checking is disabled or the SSTable is compressed.
+    //
+    // When created with `use_chunk_cache::yes`, decompressed chunks of a
+    // compressed sstable are read from, and populated into, the chunk cache
+    // (see decompressed_chunk_cache), if it's enabled. Meant for single-partition
+    // reads, which are likely to read the same chunks again.
     enum class raw_stream {
         no,
         yes,
         compressed_chunks
     };
+    using use_chunk_cache = bool_class<class use_chunk_cache_tag>;
     future<input_stream<char>> data_stream(uint64_t pos, size_t len,
             reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history,
             raw_stream raw = raw_stream::no, integrity_check integrity = integrity_check::no,
-            integrity_error_handler error_handler = throwing_integrity_error_handler);
+            integrity_error_handler error_handler = throwing_integrity_error_handler,
+            use_chunk_cache chunk_cache = use_chunk_cache::no);
 
     future<input_stream<char>> data_stream(uint64_t pos, size_t len,
         reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history,
         file_input_stream_options options,
         raw_stream raw = raw_stream::no, integrity_check integrity = integrity_check::no,
-        integrity_error_handler error_handler = throwing_integrity_error_handler);
+        integrity_error_handler error_handler = throwing_integrity_error_handler,
+        use_chunk_cache chunk_cache = use_chunk_cache::no);
 
     // Read exactly the specific byte range from the data file (after
     // uncompression, if the file is compressed). This can be used to read
@@ -883,7 +949,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // determined using the index file).
     // This function is intended (and optimized for) random access, not
     // for iteration through all the rows.
-    future<temporary_buffer<char>> data_read(uint64_t pos, size_t len, reader_permit permit);
+    future<temporary_buffer<char>> data_read(uint64_t pos, size_t len, reader_permit permit,
+            use_chunk_cache chunk_cache = use_chunk_cache::no);
 
 private:
     future<summary_entry&> read_summary_entry(size_t i);
@@ -978,6 +1045,21 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     }
     future<std::unique_ptr<scylla_metadata>> copy_scylla_metadata();
 
+    // The value files which the sstable points into, see sstables/value_log.hh.
+    const scylla_metadata::value_log* get_value_log() const {
+        return _components->scylla_metadata ? _components->scylla_metadata->get_value_log() : nullptr;
+    }
+    bool has_value_log() const {
+        return get_value_log() != nullptr;
+    }
+    sstring value_file_name(value_file_id id) const;
+    // Returns the value file, which is opened on first use, and closed with the sstable.
+    future<file> get_value_file(value_file_id id);
+    // Creates a value file of the sstable being written.
+    future<file> create_value_file(value_file_id id);
+    // Adds a value file linked by the sstable being written to its components.
+    void add_value_file(value_file_id id);
+
     run_id run_identifier() const {
         return _run_identifier;
     }
@@ -1006,6 +1088,12 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return filter_has_key(key::from_partition_key(s, key));
     }
 
+    // The filter currently used by the sstable. It's replaced when its memory
+    // is reclaimed, see reclaim_memory_from_components().
+    const utils::i_filter* get_filter() const noexcept {
+        return _components->filter.get();
+    }
+
     static utils::hashed_key make_hashed_key(const schema& s, const partition_key& key);
 
     filter_tracker& get_filter_tracker() { return _filter_tracker; }
@@ -1228,7 +1316,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     data_consume_rows(const schema&, shared_sstable, typename DataConsumeRowsContext::consumer&, disk_read_range, uint64_t, integrity_check);
     template <typename DataConsumeRowsContext>
     friend future<std::unique_ptr<DataConsumeRowsContext>>
-    data_consume_single_partition(const schema&, shared_sstable, typename DataConsumeRowsContext::consumer&, disk_read_range, integrity_check);
+    data_consume_single_partition(const schema&, shared_sstable, typename DataConsumeRowsContext::consumer&, disk_read_range, integrity_check, use_chunk_cache);
     template <typename DataConsumeRowsContext>
     friend future<std::unique_ptr<DataConsumeRowsContext>>
     data_consume_rows(const schema&, shared_sstable, typename DataConsumeRowsContext::consumer&, integrity_check);
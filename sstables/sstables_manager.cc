@@ -317,6 +317,10 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
 
     cfg.origin = std::move(origin);
     cfg.large_data_records_per_sstable = _config.large_data_records_per_sstable();
+    // Older versions would read the filter as a classic bloom filter.
+    cfg.blocked_bloom_filter = _config.blocked_bloom_filter() && _features.blocked_bloom_filter;
+    cfg.adaptive_compression_chunk_length = _config.adaptive_compression_chunk_length();
+    cfg.repair_summary = _config.repair_summaries();
 
     return cfg;
 }
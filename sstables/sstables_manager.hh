@@ -29,6 +29,7 @@
 #include <boost/intrusive/list.hpp>
 #include "sstable_compressor_factory.hh"
 #include "sstables/sstables_manager_subscription.hh"
+#include "utils/observable.hh"
 
 namespace db {
 
@@ -147,7 +148,12 @@ class sstables_manager {
         utils::updateable_value<double> memory_reclaim_threshold = utils::updateable_value<double>(0.2);
         const std::vector<sstring>& data_file_directories;
         utils::updateable_value<sstring> format = utils::updateable_value<sstring>(fmt::to_string(sstable_version_types::me));
+        utils::updateable_value<bool> blocked_bloom_filter = utils::updateable_value<bool>(false);
+        utils::updateable_value<bool> combined_sstable_filter = utils::updateable_value<bool>(false);
+        utils::updateable_value<bool> decompressed_chunk_cache = utils::updateable_value<bool>(false);
+        utils::updateable_value<bool> adaptive_compression_chunk_length = utils::updateable_value<bool>(false);
         utils::updateable_value<uint32_t> large_data_records_per_sstable = utils::updateable_value<uint32_t>(10);
+        utils::updateable_value<bool> repair_summaries = utils::updateable_value<bool>(false);
         bool ignore_component_digest_mismatch = false;
         bool enable_dangerous_direct_import_of_cassandra_counters = false;
     };
@@ -203,6 +209,8 @@ class sstables_manager {
     named_gate _signal_gate;
     signal_type _signal_source;
 
+    utils::observable<sstable&> _filter_replaced;
+
 public:
     explicit sstables_manager(
             sstring name,
@@ -311,6 +319,15 @@ class sstables_manager {
         return *_sstables_registry;
     }
 
+    // Observes the replacement of the filter of an sstable, when its memory
+    // is reclaimed and when it's reloaded.
+    utils::observer<sstable&> observe_filter_replaced(std::function<void(sstable&)> fn) {
+        return _filter_replaced.observe(std::move(fn));
+    }
+    void notify_filter_replaced(sstable& sst) {
+        _filter_replaced(sst);
+    }
+
     atomic_deletion make_atomic_deletion(std::vector<shared_sstable> ssts);
     future<utils::chunked_vector<sstable_snapshot_metadata>> take_snapshot(std::vector<shared_sstable> ssts, sstring jsondir);
     future<lw_shared_ptr<const data_dictionary::storage_options>> init_table_storage(const schema& s, const data_dictionary::storage_options& so);
@@ -509,7 +509,9 @@ enum sstable_feature : uint8_t {
     CorrectEmptyCounters = 4, // See #4363
     CorrectUDTsInCollections = 5, // See #6130
     CorrectLastPiBlockWidth = 6,
-    End = 7,
+    BlockedBloomFilter = 7, // The Filter component holds a utils::filter::blocked_bloom_filter
+    BinaryFuseFilter = 8, // The Filter component holds a utils::filter::binary_fuse_filter
+    End = 9,
 };
 
 // Scylla-specific features enabled for a particular sstable.
@@ -557,6 +559,8 @@ enum class scylla_metadata_type : uint32_t {
     Schema = 11,
     ComponentsDigests = 12,
     LargeDataRecords = 13,
+    RepairSummary = 14,
+    ValueLog = 15,
 };
 
 // UUID is used for uniqueness across nodes, such that an imported sstable
@@ -675,6 +679,43 @@ struct sstable_schema_type {
     auto describe_type(sstable_version_types v, Describer f) { return f(id, version, keyspace_name, table_name, columns); }
 };
 
+// The hash of the contents of an sstable in one token sub-range, see sstables/repair_summary.hh.
+struct repair_summary_entry {
+    uint32_t sub_range;
+    uint64_t hash;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(sub_range, hash); }
+};
+
+struct repair_summary_type {
+    // The ring is split into 2^sub_range_bits sub-ranges.
+    uint8_t sub_range_bits;
+    // Only the sub-ranges in which the sstable has data, in sub-range order.
+    disk_array<uint32_t, repair_summary_entry> entries;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(sub_range_bits, entries); }
+};
+
+// A value file referenced by an sstable, see sstables/value_log.hh.
+struct value_log_file {
+    value_file_id id;
+    uint64_t size;
+    // The bytes of the values of the file which the sstable points to.
+    uint64_t referenced_bytes;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(id, size, referenced_bytes); }
+};
+
+struct value_log_type {
+    disk_array<uint32_t, value_log_file> files;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(files); }
+};
+
 struct scylla_metadata {
     using extension_attributes = disk_hash<uint32_t, disk_string<uint32_t>, disk_string<uint32_t>>;
     using large_data_stats = disk_hash<uint32_t, large_data_type, large_data_stats_entry>;
@@ -686,6 +727,8 @@ struct scylla_metadata {
     using sstable_identifier = sstable_identifier_type;
     using sstable_schema = sstable_schema_type;
     using components_digests = disk_hash<uint32_t, component_type, uint32_t>;
+    using repair_summary = repair_summary_type;
+    using value_log = value_log_type;
 
     disk_set_of_tagged_union<scylla_metadata_type,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::Sharding, sharding_metadata>,
@@ -700,7 +743,9 @@ struct scylla_metadata {
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableIdentifier, sstable_identifier>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::Schema, sstable_schema>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ComponentsDigests, components_digests>,
-            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::LargeDataRecords, large_data_records>
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::LargeDataRecords, large_data_records>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::RepairSummary, repair_summary>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ValueLog, value_log>
             > data;
     std::optional<uint32_t> digest;
 
@@ -750,6 +795,12 @@ struct scylla_metadata {
     const components_digests* get_components_digests() const {
         return data.get<scylla_metadata_type::ComponentsDigests, components_digests>();
     }
+    const repair_summary* get_repair_summary() const {
+        return data.get<scylla_metadata_type::RepairSummary, repair_summary>();
+    }
+    const value_log* get_value_log() const {
+        return data.get<scylla_metadata_type::ValueLog, value_log>();
+    }
 };
 
 static constexpr int DEFAULT_CHUNK_SIZE = 65536;
@@ -17,5 +17,12 @@ namespace sstables {
 using run_id = utils::tagged_uuid<struct run_id_tag>;
 using integrity_check = bool_class<class integrity_check_tag>;
 using update_sstable_id = bool_class<struct update_sstable_id_tag>;
+using value_file_id = utils::tagged_uuid<struct value_file_id_tag>;
+
+namespace value_log {
+// Passed to the readers of a compaction, which return the values which are in
+// value files as pointers, see sstables/value_log.hh.
+class reconciler;
+}
 
 } // namespace sstables
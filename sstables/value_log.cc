@@ -0,0 +1,782 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <algorithm>
+#include <ranges>
+
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/coroutine/exception.hh>
+
+#include "sstables/value_log.hh"
+#include "sstables/sstables.hh"
+#include "sstables/sstable_set.hh"
+#include "sstables/exceptions.hh"
+#include "db/value_log_options.hh"
+#include "mutation/mutation_fragment_v2.hh"
+#include "readers/mutation_reader.hh"
+#include "schema/schema.hh"
+#include "utils/crc.hh"
+#include "utils/fragment_range.hh"
+
+namespace sstables {
+
+extern logging::logger sstlog;
+
+namespace value_log {
+
+// magic, tag, uuid, offset, size.
+static constexpr size_t encoded_pointer_size = magic.size() + sizeof(int8_t) + 2 * sizeof(int64_t) + sizeof(uint64_t) + sizeof(uint32_t);
+
+// The values which a resolving reader reads at the same time.
+static constexpr size_t max_concurrent_reads = 16;
+
+// The buffer of the stream which reads a value.
+static constexpr size_t read_buffer_size = 64 * 1024;
+
+static bytes_view magic_view() noexcept {
+    return bytes_view(magic.data(), magic.size());
+}
+
+bool is_separable(const column_definition& cdef) noexcept {
+    return (cdef.is_regular() || cdef.is_static()) && cdef.is_atomic() && !cdef.is_counter() && !cdef.type->value_length_if_fixed();
+}
+
+bool is_encoded(managed_bytes_view value) noexcept {
+    return value.size_bytes() > magic.size() && compare_unsigned(value.prefix(magic.size()), single_fragmented_view(magic_view())) == 0;
+}
+
+managed_bytes escape(managed_bytes_view value) {
+    managed_bytes out(managed_bytes::initialized_later(), magic.size() + sizeof(int8_t) + value.size_bytes());
+    auto v = managed_bytes_mutable_view(out);
+    write_fragmented(v, single_fragmented_view(magic_view()));
+    write<int8_t>(v, int8_t(tag::escaped));
+    write_fragmented(v, value);
+    return out;
+}
+
+managed_bytes encode(const pointer& p) {
+    managed_bytes out(managed_bytes::initialized_later(), encoded_pointer_size);
+    auto v = managed_bytes_mutable_view(out);
+    write_fragmented(v, single_fragmented_view(magic_view()));
+    write<int8_t>(v, int8_t(tag::pointer));
+    write<int64_t>(v, p.file.uuid().get_most_significant_bits());
+    write<int64_t>(v, p.file.uuid().get_least_significant_bits());
+    write<uint64_t>(v, p.offset);
+    write<uint32_t>(v, p.size);
+    return out;
+}
+
+std::variant<pointer, managed_bytes_view> decode(managed_bytes_view encoded) {
+    encoded.remove_prefix(magic.size());
+    auto t = tag(read_simple<int8_t>(encoded));
+    switch (t) {
+    case tag::escaped:
+        return encoded;
+    case tag::pointer: {
+        auto msb = read_simple<int64_t>(encoded);
+        auto lsb = read_simple<int64_t>(encoded);
+        auto offset = read_simple<uint64_t>(encoded);
+        auto size = read_simple<uint32_t>(encoded);
+        return pointer{value_file_id(utils::UUID(msb, lsb)), offset, size};
+    }
+    }
+    throw malformed_sstable_exception(format("Unknown tag {} of an encoded value", int(t)));
+}
+
+sstring component_name(value_file_id id) {
+    return format("Values.{:016x}{:016x}.db", uint64_t(id.uuid().get_most_significant_bits()), uint64_t(id.uuid().get_least_significant_bits()));
+}
+
+future<managed_bytes> read_value(file f, const pointer& p, sstring file_name) {
+    auto len = uint64_t(p.size) + checksum_size;
+    auto in = make_file_input_stream(std::move(f), p.offset, len, file_input_stream_options{.buffer_size = read_buffer_size});
+    std::exception_ptr ex;
+    managed_bytes value(managed_bytes::initialized_later(), p.size);
+    try {
+        utils::crc32 crc;
+        auto out = managed_bytes_mutable_view(value);
+        while (!out.empty()) {
+            auto frag = out.current_fragment();
+            auto buf = co_await in.read_exactly(frag.size());
+            if (buf.size() != frag.size()) {
+                throw malformed_sstable_exception(format("Value of {} bytes at offset {} is past the end of value file {}", p.size, p.offset, file_name));
+            }
+            std::copy_n(reinterpret_cast<const bytes::value_type*>(buf.get()), buf.size(), frag.data());
+            crc.process(reinterpret_cast<const uint8_t*>(buf.get()), buf.size());
+            out.remove_current();
+        }
+        auto buf = co_await in.read_exactly(checksum_size);
+        if (buf.size() != checksum_size) {
+            throw malformed_sstable_exception(format("Value of {} bytes at offset {} is past the end of value file {}", p.size, p.offset, file_name));
+        }
+        if (auto expected = read_be<uint32_t>(buf.get()); expected != crc.get()) {
+            throw malformed_sstable_exception(format("Checksum mismatch of the value of {} bytes at offset {} of value file {}: expected {:#x}, got {:#x}",
+                    p.size, p.offset, file_name, expected, crc.get()));
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await in.close();
+    if (ex) {
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    co_return value;
+}
+
+static const row* cells_of(const mutation_fragment_v2& mf) {
+    if (mf.is_static_row()) {
+        return &mf.as_static_row().cells();
+    }
+    if (mf.is_clustering_row()) {
+        return &mf.as_clustering_row().cells();
+    }
+    return nullptr;
+}
+
+static column_kind kind_of(const mutation_fragment_v2& mf) {
+    return mf.is_static_row() ? column_kind::static_column : column_kind::regular_column;
+}
+
+// Calls fn(cdef, cell) for each live cell of a separable column of the row.
+template <typename Row, typename Func>
+static void for_each_separable_cell(const schema& s, column_kind kind, Row& r, Func&& fn) {
+    using cell_type = std::conditional_t<std::is_const_v<Row>, const atomic_cell_or_collection&, atomic_cell_or_collection&>;
+    r.for_each_cell([&] (column_id id, cell_type c) {
+        auto& cdef = s.column_at(kind, id);
+        if (!is_separable(cdef)) {
+            return;
+        }
+        auto cell = c.as_atomic_cell(cdef);
+        if (cell.is_live()) {
+            fn(cdef, c, cell);
+        }
+    });
+}
+
+// Replaces the value of a cell, keeping its timestamp and ttl.
+static atomic_cell_or_collection with_value(const column_definition& cdef, atomic_cell_view cell, managed_bytes_view value) {
+    if (cell.is_live_and_has_ttl()) {
+        return atomic_cell::make_live(*cdef.type, cell.timestamp(), value, cell.expiry(), cell.ttl());
+    }
+    return atomic_cell::make_live(*cdef.type, cell.timestamp(), value);
+}
+
+template <typename Func>
+static void mutate_cells(const schema& s, mutation_fragment_v2& mf, Func&& fn) {
+    if (mf.is_static_row()) {
+        mf.mutate_as_static_row(s, [&] (static_row& sr) {
+            fn(sr.cells());
+        });
+    } else {
+        mf.mutate_as_clustering_row(s, [&] (clustering_row& cr) {
+            fn(cr.cells());
+        });
+    }
+}
+
+class resolving_reader : public mutation_reader::impl {
+    mutation_reader _rd;
+    shared_sstable _sst;
+    // The columns whose values are read, all of them if null.
+    const query::partition_slice* _selection;
+private:
+    bool selected(column_kind kind, column_id id) const {
+        if (!_selection) {
+            return true;
+        }
+        auto& ids = kind == column_kind::static_column ? _selection->static_columns : _selection->regular_columns;
+        return std::ranges::find(ids, id) != ids.end();
+    }
+
+    // Calls fn(cdef, c, cell) for each cell of the fragment whose value is
+    // replaced.
+    template <typename Row, typename Func>
+    void for_each_encoded_cell(const mutation_fragment_v2& mf, Row& r, Func&& fn) const {
+        auto kind = kind_of(mf);
+        for_each_separable_cell(*_schema, kind, r, [&] (const column_definition& cdef, auto& c, atomic_cell_view cell) {
+            if (is_encoded(cell.value()) && selected(kind, cdef.id)) {
+                fn(cdef, c, cell);
+            }
+        });
+    }
+
+    void collect_pointers(const mutation_fragment_v2& mf, std::vector<pointer>& pointers, size_t& bytes) const {
+        auto* cells = cells_of(mf);
+        if (!cells) {
+            return;
+        }
+        for_each_encoded_cell(mf, *cells, [&] (const column_definition&, const atomic_cell_or_collection&, atomic_cell_view cell) {
+            auto decoded = decode(cell.value());
+            if (auto* p = std::get_if<pointer>(&decoded)) {
+                pointers.push_back(*p);
+                bytes += p->size;
+            }
+        });
+    }
+
+    // Replaces the encoded values of the fragment, taking the values of its
+    // pointers from `values`, in the order of collect_pointers().
+    void resolve(mutation_fragment_v2& mf, std::vector<managed_bytes>& values, size_t& next) const {
+        auto* cells = cells_of(mf);
+        if (!cells) {
+            return;
+        }
+        bool encoded = false;
+        for_each_encoded_cell(mf, *cells, [&] (const column_definition&, const atomic_cell_or_collection&, atomic_cell_view) {
+            encoded = true;
+        });
+        if (!encoded) {
+            return;
+        }
+        mutate_cells(*_schema, mf, [&] (row& r) {
+            for_each_encoded_cell(mf, r, [&] (const column_definition& cdef, atomic_cell_or_collection& c, atomic_cell_view cell) {
+                auto decoded = decode(cell.value());
+                if (auto* escaped = std::get_if<managed_bytes_view>(&decoded)) {
+                    c = with_value(cdef, cell, *escaped);
+                } else {
+                    auto value = std::move(values[next++]);
+                    c = with_value(cdef, cell, value);
+                }
+            });
+        });
+    }
+public:
+    resolving_reader(shared_sstable sst, mutation_reader rd, const query::partition_slice* slice)
+        : impl(rd.schema(), rd.permit())
+        , _rd(std::move(rd))
+        , _sst(std::move(sst))
+        , _selection(slice && slice->options.contains(query::partition_slice::option::bypass_cache) ? slice : nullptr) {
+    }
+    virtual future<> fill_buffer() override {
+        while (!is_buffer_full() && !is_end_of_stream()) {
+            if (_rd.is_buffer_empty()) {
+                if (_rd.is_end_of_stream()) {
+                    _end_of_stream = true;
+                    break;
+                }
+                co_await _rd.fill_buffer();
+            }
+            // The values of a batch of fragments are read concurrently.
+            std::vector<mutation_fragment_v2> batch;
+            std::vector<pointer> pointers;
+            size_t bytes = 0;
+            while (!_rd.is_buffer_empty() && bytes < max_buffer_size_in_bytes) {
+                auto mf = _rd.pop_mutation_fragment();
+                collect_pointers(mf, pointers, bytes);
+                batch.push_back(std::move(mf));
+            }
+            std::vector<managed_bytes> values(pointers.size());
+            if (!pointers.empty()) {
+                auto units = co_await _permit.request_memory(std::min(pointers.size(), max_concurrent_reads) * read_buffer_size);
+                co_await max_concurrent_for_each(std::views::iota(size_t(0), pointers.size()), max_concurrent_reads, [&] (size_t i) -> future<> {
+                    auto& p = pointers[i];
+                    auto f = co_await _sst->get_value_file(p.file);
+                    values[i] = co_await read_value(std::move(f), p, _sst->value_file_name(p.file));
+                });
+            }
+            size_t next = 0;
+            for (auto& mf : batch) {
+                resolve(mf, values, next);
+                push_mutation_fragment(std::move(mf));
+            }
+        }
+    }
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty()) {
+            _end_of_stream = false;
+            return _rd.next_partition();
+        }
+        return make_ready_future<>();
+    }
+    virtual future<> fast_forward_to(const dht::partition_range& pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(pr);
+    }
+    virtual future<> fast_forward_to(position_range pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(std::move(pr));
+    }
+    virtual future<> close() noexcept override {
+        return _rd.close();
+    }
+};
+
+mutation_reader make_resolving_reader(shared_sstable sst, mutation_reader rd, const query::partition_slice* slice) {
+    return make_mutation_reader<resolving_reader>(std::move(sst), std::move(rd), slice);
+}
+
+class escaping_reader : public mutation_reader::impl {
+    mutation_reader _rd;
+private:
+    void escape_values(mutation_fragment_v2& mf) const {
+        auto* cells = cells_of(mf);
+        if (!cells) {
+            return;
+        }
+        bool encoded = false;
+        for_each_separable_cell(*_schema, kind_of(mf), *cells, [&] (const column_definition&, const atomic_cell_or_collection&, atomic_cell_view cell) {
+            encoded |= is_encoded(cell.value());
+        });
+        if (!encoded) {
+            return;
+        }
+        mutate_cells(*_schema, mf, [&] (row& r) {
+            for_each_separable_cell(*_schema, kind_of(mf), r, [&] (const column_definition& cdef, atomic_cell_or_collection& c, atomic_cell_view cell) {
+                if (is_encoded(cell.value())) {
+                    c = with_value(cdef, cell, escape(cell.value()));
+                }
+            });
+        });
+    }
+public:
+    explicit escaping_reader(mutation_reader rd)
+        : impl(rd.schema(), rd.permit())
+        , _rd(std::move(rd)) {
+    }
+    virtual future<> fill_buffer() override {
+        return do_until([this] { return is_buffer_full() || is_end_of_stream(); }, [this] {
+            return _rd.fill_buffer().then([this] {
+                while (!_rd.is_buffer_empty()) {
+                    auto mf = _rd.pop_mutation_fragment();
+                    escape_values(mf);
+                    push_mutation_fragment(std::move(mf));
+                }
+                _end_of_stream = _rd.is_end_of_stream();
+            });
+        });
+    }
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty()) {
+            _end_of_stream = false;
+            return _rd.next_partition();
+        }
+        return make_ready_future<>();
+    }
+    virtual future<> fast_forward_to(const dht::partition_range& pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(pr);
+    }
+    virtual future<> fast_forward_to(position_range pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(std::move(pr));
+    }
+    virtual future<> close() noexcept override {
+        return _rd.close();
+    }
+};
+
+mutation_reader make_escaping_reader(mutation_reader rd) {
+    return make_mutation_reader<escaping_reader>(std::move(rd));
+}
+
+// Whether the merge of two live cells is decided by their values, see
+// compare_atomic_cell_for_merge().
+static bool ties(atomic_cell_view a, atomic_cell_view b) {
+    if (a.timestamp() != b.timestamp() || a.is_live_and_has_ttl() != b.is_live_and_has_ttl()) {
+        return false;
+    }
+    return !a.is_live_and_has_ttl() || (a.expiry() == b.expiry() && a.ttl() == b.ttl());
+}
+
+// Returns the value of a cell read by a recording reader from sst.
+static future<managed_bytes> resolve_value(const shared_sstable& sst, managed_bytes_view value) {
+    if (!is_encoded(value)) {
+        co_return managed_bytes(value);
+    }
+    auto decoded = decode(value);
+    if (auto* escaped = std::get_if<managed_bytes_view>(&decoded)) {
+        co_return managed_bytes(*escaped);
+    }
+    auto& p = std::get<pointer>(decoded);
+    auto f = co_await sst->get_value_file(p.file);
+    co_return co_await read_value(std::move(f), p, sst->value_file_name(p.file));
+}
+
+class reconciler::recording_reader : public mutation_reader::impl {
+    mutation_reader _rd;
+    reconciler& _reconciler;
+    shared_sstable _sst;
+    std::optional<dht::decorated_key> _dk;
+public:
+    recording_reader(reconciler& r, shared_sstable sst, mutation_reader rd)
+        : impl(rd.schema(), rd.permit())
+        , _rd(std::move(rd))
+        , _reconciler(r)
+        , _sst(std::move(sst)) {
+    }
+    virtual future<> fill_buffer() override {
+        return do_until([this] { return is_buffer_full() || is_end_of_stream(); }, [this] {
+            return _rd.fill_buffer().then([this] {
+                while (!_rd.is_buffer_empty()) {
+                    auto mf = _rd.pop_mutation_fragment();
+                    if (mf.is_partition_start()) {
+                        _dk = mf.as_partition_start().key();
+                    } else if (_dk) {
+                        _reconciler.record(_sst, *_dk, mf);
+                    }
+                    push_mutation_fragment(std::move(mf));
+                }
+                _end_of_stream = _rd.is_end_of_stream();
+            });
+        });
+    }
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty()) {
+            _end_of_stream = false;
+            return _rd.next_partition();
+        }
+        return make_ready_future<>();
+    }
+    virtual future<> fast_forward_to(const dht::partition_range& pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(pr);
+    }
+    virtual future<> fast_forward_to(position_range pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(std::move(pr));
+    }
+    virtual future<> close() noexcept override {
+        return _rd.close();
+    }
+};
+
+class reconciler::reconciling_reader : public mutation_reader::impl {
+    mutation_reader _rd;
+    reconciler& _reconciler;
+    std::optional<dht::decorated_key> _dk;
+public:
+    reconciling_reader(reconciler& r, mutation_reader rd)
+        : impl(rd.schema(), rd.permit())
+        , _rd(std::move(rd))
+        , _reconciler(r) {
+    }
+    virtual future<> fill_buffer() override {
+        while (!is_buffer_full() && !is_end_of_stream()) {
+            if (_rd.is_buffer_empty()) {
+                if (_rd.is_end_of_stream()) {
+                    _end_of_stream = true;
+                    break;
+                }
+                co_await _rd.fill_buffer();
+                continue;
+            }
+            auto mf = _rd.pop_mutation_fragment();
+            if (mf.is_partition_start()) {
+                _dk = mf.as_partition_start().key();
+                _reconciler.purge_before(*_dk);
+            } else if (mf.is_end_of_partition()) {
+                _reconciler.purge(*_dk);
+            } else if (cells_of(mf)) {
+                co_await _reconciler.reconcile(*_dk, mf);
+            }
+            push_mutation_fragment(std::move(mf));
+        }
+    }
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty()) {
+            _end_of_stream = false;
+            return _rd.next_partition();
+        }
+        return make_ready_future<>();
+    }
+    virtual future<> fast_forward_to(const dht::partition_range& pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(pr);
+    }
+    virtual future<> fast_forward_to(position_range pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(std::move(pr));
+    }
+    virtual future<> close() noexcept override {
+        return _rd.close();
+    }
+};
+
+reconciler::reconciler(schema_ptr s)
+    : _schema(s)
+    , _candidates(dht::decorated_key::less_comparator(std::move(s))) {
+}
+
+void reconciler::record(const shared_sstable& sst, const dht::decorated_key& dk, const mutation_fragment_v2& mf) {
+    auto* cells = cells_of(mf);
+    if (!cells) {
+        return;
+    }
+    row_candidates* rc = nullptr;
+    for_each_separable_cell(*_schema, kind_of(mf), *cells, [&] (const column_definition& cdef, const atomic_cell_or_collection& c, atomic_cell_view) {
+        if (!rc) {
+            auto& pc = _candidates.try_emplace(dk, position_in_partition::less_compare(*_schema)).first->second;
+            rc = &pc[position_in_partition(mf.position())];
+        }
+        (*rc)[cdef.id].push_back(candidate{sst, c.copy(*cdef.type)});
+    });
+}
+
+future<> reconciler::reconcile(const dht::decorated_key& dk, mutation_fragment_v2& mf) {
+    auto pit = _candidates.find(dk);
+    if (pit == _candidates.end()) {
+        co_return;
+    }
+    auto& pc = pit->second;
+    auto rit = pc.find(position_in_partition(mf.position()));
+    if (rit == pc.end()) {
+        co_return;
+    }
+    // The cells of the other sstables which tie with the merged ones, by column.
+    std::vector<std::pair<column_id, std::vector<candidate>>> tied;
+    for_each_separable_cell(*_schema, kind_of(mf), *cells_of(mf), [&] (const column_definition& cdef, const atomic_cell_or_collection&, atomic_cell_view cell) {
+        auto cit = rit->second.find(cdef.id);
+        if (cit == rit->second.end() || cit->second.size() < 2) {
+            return;
+        }
+        std::vector<candidate> candidates;
+        for (auto& c : cit->second) {
+            auto view = c.cell.as_atomic_cell(cdef);
+            if (view.is_live() && ties(view, cell)) {
+                candidates.push_back(candidate{c.sst, c.cell.copy(*cdef.type)});
+            }
+        }
+        if (candidates.size() > 1) {
+            tied.emplace_back(cdef.id, std::move(candidates));
+        }
+    });
+    pc.erase(pc.begin(), std::next(rit));
+    if (tied.empty()) {
+        co_return;
+    }
+
+    auto kind = kind_of(mf);
+    std::unordered_map<column_id, atomic_cell_or_collection> winners;
+    for (auto& [id, candidates] : tied) {
+        auto& cdef = _schema->column_at(kind, id);
+        const candidate* winner = nullptr;
+        managed_bytes winner_value;
+        for (auto& c : candidates) {
+            auto value = co_await resolve_value(c.sst, c.cell.as_atomic_cell(cdef).value());
+            if (!winner || compare_unsigned(managed_bytes_view(value), managed_bytes_view(winner_value)) > 0) {
+                winner = &c;
+                winner_value = std::move(value);
+            }
+        }
+        winners.emplace(id, winner->cell.copy(*cdef.type));
+    }
+    mutate_cells(*_schema, mf, [&] (row& r) {
+        for_each_separable_cell(*_schema, kind, r, [&] (const column_definition& cdef, atomic_cell_or_collection& c, atomic_cell_view cell) {
+            auto it = winners.find(cdef.id);
+            if (it != winners.end() && compare_unsigned(cell.value(), it->second.as_atomic_cell(cdef).value()) != 0) {
+                c = std::move(it->second);
+            }
+        });
+    });
+}
+
+void reconciler::purge_before(const dht::decorated_key& dk) {
+    _candidates.erase(_candidates.begin(), _candidates.lower_bound(dk));
+}
+
+void reconciler::purge(const dht::decorated_key& dk) {
+    _candidates.erase(dk);
+}
+
+mutation_reader reconciler::make_recording_reader(shared_sstable sst, mutation_reader rd) {
+    return make_mutation_reader<recording_reader>(*this, std::move(sst), std::move(rd));
+}
+
+mutation_reader reconciler::make_reconciling_reader(mutation_reader rd) {
+    return make_mutation_reader<reconciling_reader>(*this, std::move(rd));
+}
+
+std::unordered_map<value_file_id, double> garbage_ratios(const sstable_set& set) {
+    struct usage {
+        uint64_t size = 0;
+        uint64_t referenced_bytes = 0;
+    };
+    std::unordered_map<value_file_id, usage> files;
+    set.for_each_sstable([&] (const shared_sstable& sst) {
+        if (auto* vl = sst->get_value_log()) {
+            for (auto& f : vl->files.elements) {
+                auto& u = files[f.id];
+                u.size = f.size;
+                u.referenced_bytes += f.referenced_bytes;
+            }
+        }
+    });
+    std::unordered_map<value_file_id, double> ratios;
+    for (auto& [id, u] : files) {
+        if (u.size) {
+            ratios.emplace(id, 1.0 - double(std::min(u.referenced_bytes, u.size)) / u.size);
+        }
+    }
+    return ratios;
+}
+
+lw_shared_ptr<const sources> make_sources(const std::vector<shared_sstable>& input, const sstable_set* all, double gc_garbage_ratio) {
+    auto ret = make_lw_shared<sources>();
+    for (auto& sst : input) {
+        if (auto* vl = sst->get_value_log()) {
+            for (auto& f : vl->files.elements) {
+                ret->files.emplace(f.id, sources::file{sst, f.size});
+            }
+        }
+    }
+    if (all && !ret->files.empty()) {
+        for (auto& [id, ratio] : garbage_ratios(*all)) {
+            if (ratio >= gc_garbage_ratio && ret->files.contains(id)) {
+                sstlog.debug("Relocating the values of value file {}, {:.2f} of which is garbage", id, ratio);
+                ret->relocated.insert(id);
+            }
+        }
+    }
+    return ret;
+}
+
+bool writer::separates_values(const sstable& sst, const schema& s) {
+    if (!s.value_log_options().enabled() || sst.get_storage().is_object_storage()) {
+        return false;
+    }
+    // Value files aren't written through the file I/O extensions, e.g. encryption,
+    // so the values of sstables which an extension applies to stay in the data file.
+    for (auto* ext : sst.manager().file_io_extensions()) {
+        if (auto f = ext->wrap_file(sst, component_type::Data, create_noop_file(), open_flags::wo).get()) {
+            f.close().get();
+            return false;
+        }
+    }
+    return true;
+}
+
+writer::writer(sstable& sst, const schema& s, lw_shared_ptr<const sources> sources)
+    : _sst(sst)
+    , _min_value_size(s.value_log_options().min_value_size())
+    , _separate(separates_values(sst, s))
+    , _sources(std::move(sources)) {
+}
+
+writer::~writer() {
+    if (_out) {
+        try {
+            _out->close().get();
+        } catch (...) {
+            sstlog.error("writer failed to close value file {}: {}", _sst.value_file_name(*_file), std::current_exception());
+        }
+    }
+}
+
+managed_bytes writer::append(managed_bytes_view value) {
+    if (!_out) {
+        _file = value_file_id::create_random_id();
+        auto f = _sst.create_value_file(*_file).get();
+        file_output_stream_options options;
+        options.buffer_size = _sst.sstable_buffer_size;
+        options.write_behind = 10;
+        _out.emplace(make_file_output_stream(std::move(f), options).get());
+    }
+    pointer p{*_file, _file_size, uint32_t(value.size_bytes())};
+    utils::crc32 crc;
+    for (bytes_view frag : fragment_range(value)) {
+        _out->write(reinterpret_cast<const char*>(frag.data()), frag.size()).get();
+        crc.process(reinterpret_cast<const uint8_t*>(frag.data()), frag.size());
+    }
+    std::array<char, checksum_size> checksum;
+    write_be<uint32_t>(checksum.data(), crc.get());
+    _out->write(checksum.data(), checksum.size()).get();
+    _file_size += p.size + checksum_size;
+    _referenced_bytes[p.file] += p.size + checksum_size;
+    return encode(p);
+}
+
+managed_bytes writer::read(const pointer& p, const sources::file& src) {
+    auto f = src.sst->get_value_file(p.file).get();
+    return read_value(std::move(f), p, src.sst->value_file_name(p.file)).get();
+}
+
+managed_bytes_opt writer::write_value(managed_bytes_view value) {
+    if (!_separate) {
+        return std::nullopt;
+    }
+    if (value.size_bytes() >= _min_value_size) {
+        _encoded = true;
+        return append(value);
+    }
+    if (is_encoded(value)) {
+        _encoded = true;
+        return escape(value);
+    }
+    return std::nullopt;
+}
+
+managed_bytes_opt writer::write(managed_bytes_view value) {
+    // Without sources, the values come from a memtable or from another node, so
+    // none of them is encoded.
+    if (!_sources || !is_encoded(value)) {
+        return write_value(value);
+    }
+    auto decoded = decode(value);
+    if (auto* escaped = std::get_if<managed_bytes_view>(&decoded)) {
+        if (auto encoded = write_value(*escaped)) {
+            return encoded;
+        }
+        return managed_bytes(*escaped);
+    }
+    auto& p = std::get<pointer>(decoded);
+    auto it = _sources->files.find(p.file);
+    if (it == _sources->files.end()) {
+        throw malformed_sstable_exception(format("Value file {} is not a value file of the input sstables", p.file));
+    }
+    if (_separate && !_sources->relocated.contains(p.file)) {
+        _encoded = true;
+        _referenced_bytes[p.file] += p.size + checksum_size;
+        return std::nullopt;
+    }
+    auto v = read(p, it->second);
+    if (auto encoded = write_value(v)) {
+        return encoded;
+    }
+    return v;
+}
+
+std::optional<scylla_metadata::value_log> writer::finish() {
+    if (_out) {
+        auto out = std::move(*_out);
+        _out.reset();
+        out.close().get();
+    }
+    if (!_encoded) {
+        return std::nullopt;
+    }
+    scylla_metadata::value_log ret;
+    for (auto& [id, referenced_bytes] : _referenced_bytes) {
+        uint64_t size = _file_size;
+        if (id != _file) {
+            auto& src = _sources->files.at(id);
+            _sst.sstable_write_io_check(idempotent_link_file, src.sst->value_file_name(id), _sst.value_file_name(id)).get();
+            _sst.add_value_file(id);
+            size = src.size;
+        }
+        ret.files.elements.push_back(value_log_file{id, size, referenced_bytes});
+    }
+    return ret;
+}
+
+}
+
+}
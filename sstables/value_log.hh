@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+
+#include <seastar/core/file.hh>
+#include <seastar/core/iostream.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include "dht/decorated_key.hh"
+#include "mutation/atomic_cell_or_collection.hh"
+#include "mutation/mutation_fragment_fwd.hh"
+#include "mutation/position_in_partition.hh"
+#include "readers/mutation_reader_fwd.hh"
+#include "sstables/shared_sstable.hh"
+#include "sstables/types.hh"
+#include "utils/managed_bytes.hh"
+
+class column_definition;
+class schema;
+
+namespace sstables {
+
+class sstable_set;
+
+// Key-value separation, for tables with the value_log option.
+//
+// The sstable writer appends the values of at least min_value_size bytes to a
+// value file of the sstable, and writes a pointer to the value into the data
+// file, in place of the value. Compaction copies the pointers, not the values,
+// so the value files of the input sstables are linked into the output sstables,
+// and the values are written only once.
+//
+// A value file is named after the sstable which created it, and each sstable
+// which points into it has a link to it, as one of its components. So the file
+// is removed with the last sstable which points into it. The values which no
+// sstable points to are garbage, which is reclaimed by rewriting the values which
+// are still pointed to into a new value file, when compaction finds that enough
+// of the file is garbage, see `sources`.
+//
+// Only the values of atomic regular and static columns of variable-length types
+// are separated. In the data file of an sstable which has value files, such a
+// value starts with `magic` when it's encoded: either a pointer, or an escaped
+// value, which is a value which happens to start with `magic`. The other values
+// are written as is.
+namespace value_log {
+
+constexpr std::array<int8_t, 8> magic = { -0x73, 0x56, 0x4c, 0x4f, 0x47, -0x4d, 0x1e, 0x7a };
+
+enum class tag : int8_t {
+    escaped = 0,
+    pointer = 1,
+};
+
+// A value in a value file. The value is followed by its crc32.
+struct pointer {
+    value_file_id file;
+    uint64_t offset;
+    uint32_t size;
+};
+
+constexpr size_t checksum_size = sizeof(uint32_t);
+
+bool is_separable(const column_definition& cdef) noexcept;
+
+bool is_encoded(managed_bytes_view value) noexcept;
+
+managed_bytes escape(managed_bytes_view value);
+
+managed_bytes encode(const pointer& p);
+
+// Decodes an encoded value into either a pointer, or the original value of an escaped one.
+std::variant<pointer, managed_bytes_view> decode(managed_bytes_view encoded);
+
+// The name of the component of an sstable which links to the value file.
+sstring component_name(value_file_id id);
+
+// Reads the value a pointer points to from its value file, and checks its checksum.
+future<managed_bytes> read_value(file f, const pointer& p, sstring file_name);
+
+// Returns a reader which replaces the pointers and the escaped values read from
+// an sstable with value files with the values.
+//
+// When the slice bypasses the cache, only the values of the columns it selects
+// are read, and the values of the other columns are returned encoded. Otherwise
+// the read may populate the cache, which keeps the whole rows read from the
+// sstables, so all the values are read. Without a slice, all the values are read.
+mutation_reader make_resolving_reader(shared_sstable sst, mutation_reader rd, const query::partition_slice* slice);
+
+// Returns a reader which escapes the values read from an sstable without value
+// files, so that they can be written to an sstable with value files.
+mutation_reader make_escaping_reader(mutation_reader rd);
+
+// The value files pointed to by the sstables which compaction reads with a
+// reconciler.
+struct sources {
+    struct file {
+        // An input sstable which links to the file. It's held until the end of
+        // the compaction, even when the compaction releases its exhausted input
+        // sstables early, since an output sstable links to the file when it's
+        // sealed.
+        shared_sstable sst;
+        uint64_t size;
+    };
+    std::unordered_map<value_file_id, file> files;
+    // The files whose values are rewritten into the value file of the output sstable,
+    // instead of the output sstable linking to them.
+    std::unordered_set<value_file_id> relocated;
+};
+
+// The ratio of the bytes of each value file which aren't pointed to by any
+// sstable of the set. An sstable which isn't in the set, and points into one
+// of the files, makes the ratio higher than the actual one, so the file may be
+// relocated earlier than needed. This costs I/O, but never loses values, since
+// relocation copies the values which the input sstables point to.
+std::unordered_map<value_file_id, double> garbage_ratios(const sstable_set& set);
+
+// Collects the value files of the input sstables of a compaction. The files with
+// at least gc_garbage_ratio of garbage in `all` are relocated.
+lw_shared_ptr<const sources> make_sources(const std::vector<shared_sstable>& input, const sstable_set* all, double gc_garbage_ratio);
+
+// Reads the input sstables of a compaction with the pointers to the values,
+// so that they are written to the output sstables as is, and reconciles the
+// cells read from different sstables as if they had their values.
+//
+// The combined reader reconciles two live cells with the same timestamp and
+// expiry on their values (see compare_atomic_cell_for_merge()), which for a
+// pointer or an escaped value are the encoded bytes. So the reconciler records
+// the live cells of separable columns read from each sstable, until the merged
+// row reaches the reconciling reader, which replaces a merged cell which tied
+// with cells of other sstables with the one with the largest value.
+class reconciler {
+    struct candidate {
+        shared_sstable sst;
+        atomic_cell_or_collection cell;
+    };
+    using row_candidates = std::unordered_map<column_id, std::vector<candidate>>;
+    using partition_candidates = std::map<position_in_partition, row_candidates, position_in_partition::less_compare>;
+
+    schema_ptr _schema;
+    std::map<dht::decorated_key, partition_candidates, dht::decorated_key::less_comparator> _candidates;
+
+    class recording_reader;
+    class reconciling_reader;
+private:
+    void record(const shared_sstable& sst, const dht::decorated_key& dk, const mutation_fragment_v2& mf);
+    // Replaces the cells of a merged row which tied with cells of other sstables.
+    future<> reconcile(const dht::decorated_key& dk, mutation_fragment_v2& mf);
+    // Drops the cells of the partitions which the merged stream has passed.
+    void purge_before(const dht::decorated_key& dk);
+    void purge(const dht::decorated_key& dk);
+public:
+    explicit reconciler(schema_ptr s);
+
+    // Returns a reader which records the cells read by rd from sst. rd returns
+    // the values as they are in the data file of sst, with them escaped if sst
+    // has no value files.
+    mutation_reader make_recording_reader(shared_sstable sst, mutation_reader rd);
+
+    // Returns a reader over the merged recording readers.
+    mutation_reader make_reconciling_reader(mutation_reader rd);
+};
+
+// Writes the values of an sstable to its value file, and keeps track of the value
+// files which the sstable points into. Used by the sstable writer, in a seastar
+// thread.
+class writer {
+    sstable& _sst;
+    uint64_t _min_value_size;
+    // Whether the sstable has value files, otherwise the values which are read
+    // from the sources are written as is.
+    bool _separate;
+    lw_shared_ptr<const sources> _sources;
+    std::optional<value_file_id> _file;
+    std::optional<output_stream<char>> _out;
+    uint64_t _file_size = 0;
+    std::map<value_file_id, uint64_t> _referenced_bytes;
+    // Whether an encoded value was written to the data file.
+    bool _encoded = false;
+private:
+    managed_bytes append(managed_bytes_view value);
+    managed_bytes read(const pointer& p, const sources::file& src);
+    managed_bytes_opt write_value(managed_bytes_view value);
+public:
+    // Returns whether the values of an sstable of the schema are written to value files.
+    static bool separates_values(const sstable& sst, const schema& s);
+
+    writer(sstable& sst, const schema& s, lw_shared_ptr<const sources> sources);
+    ~writer();
+
+    // Returns the value to write to the data file instead of `value`, if any.
+    managed_bytes_opt write(managed_bytes_view value);
+
+    // Closes the value file, and links the value files of the sources which the
+    // sstable points into. Returns the value files of the sstable, if its data file
+    // has encoded values.
+    std::optional<scylla_metadata::value_log> finish();
+};
+
+}
+
+}
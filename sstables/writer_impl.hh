@@ -38,6 +38,12 @@ struct sstable_writer::writer_impl {
         if (!cfg.correct_pi_block_width) {
             _features.disable(CorrectLastPiBlockWidth);
         }
+        if (!cfg.blocked_bloom_filter) {
+            _features.disable(BlockedBloomFilter);
+        }
+        if (_schema.filter_type() != sstable_filter_type::binary_fuse) {
+            _features.disable(BinaryFuseFilter);
+        }
         sst.set_features(_features);
     }
 
@@ -699,6 +699,10 @@ future<> sstables_loader::load_new_sstables(sstring ks_name, sstring cf_name,
     llog.info("Loading new SSTables for keyspace={}, table={}, load_and_stream={}, primary_replica_only={}, skip_cleanup={}, skip_reshape={}, scope={}",
             ks_name, cf_name, load_and_stream_desc, primary, skip_cleanup, skip_reshape, scope);
     try {
+        // Logstor segments of a snapshot are loaded into the local shards, before the sstables.
+        if (auto& t = _db.local().find_column_family(ks_name, cf_name); t.uses_logstor()) {
+            co_await replica::database::load_logstor_upload_dir(_db, t.schema()->id());
+        }
         if (load_and_stream) {
             ::table_id table_id;
             std::vector<std::vector<sstables::shared_sstable>> sstables_on_shards;
@@ -14,8 +14,10 @@
 #include "streaming/stream_plan.hh"
 #include "utils/pretty_printers.hh"
 #include "utils/error_injection.hh"
+#include "utils/memory_data_sink.hh"
 #include "locator/host_id.hh"
 #include "replica/database.hh"
+#include "replica/logstor/compression.hh"
 #include "sstables/sstables.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/storage.hh"
@@ -265,7 +267,8 @@ future<> stream_blob_handler(replica::database& db,
         // Reject any file_ops that is not support by this node
         if (meta.fops != streaming::file_ops::stream_sstables &&
             meta.fops != streaming::file_ops::load_sstables &&
-            meta.fops != streaming::file_ops::stream_logstor_segments) {
+            meta.fops != streaming::file_ops::stream_logstor_segments &&
+            meta.fops != streaming::file_ops::stream_logstor_dictionary) {
             auto msg = format("fstream[{}] Unsupported file_ops={} peer={} file={}",
                     meta.ops_id, int(meta.fops), from, meta.filename);
             blogger.warn("{}", msg);
@@ -502,6 +505,26 @@ future<> stream_blob_handler(replica::database& db, db::view::view_building_work
                 },
                 std::move(out)
             };
+        } else if (meta.fops == file_ops::stream_logstor_dictionary) {
+            blogger.debug("stream_logstor_segments[{}] Receiving logstor compression dictionary {}", meta.ops_id, meta.filename);
+            auto bufs = std::make_unique<memory_data_sink_buffers>();
+            auto out = output_stream<char>(data_sink(std::make_unique<memory_data_sink>(*bufs)));
+
+            co_return output_result{
+                [bufs = std::move(bufs), &db] (store_result res) -> future<> {
+                    if (res != store_result::ok) {
+                        co_return;
+                    }
+                    std::vector<std::byte> dict;
+                    dict.reserve(bufs->size());
+                    for (const auto& buf : bufs->buffers()) {
+                        auto data = std::as_bytes(std::span(buf.get(), buf.size()));
+                        dict.insert(dict.end(), data.begin(), data.end());
+                    }
+                    co_await replica::database::add_logstor_compression_dictionary_on_all_shards(db.container(), std::move(dict));
+                },
+                std::move(out)
+            };
         } else {
             throw std::runtime_error(format("Unexpected file_ops={} in stream_blob_handler", int(meta.fops)));
         }
@@ -777,6 +800,21 @@ future<stream_files_response> tablet_stream_files_handler(replica::database& db,
     bool is_logstor_table = table.uses_logstor();
 
     if (is_logstor_table) {
+        // Records of the segments may be compressed with dictionaries the targets
+        // don't have, e.g. ones replaced before they joined, so the dictionaries are
+        // sent before the segments. Records are compressed only once all nodes
+        // support the feature, and so know how to receive dictionaries.
+        if (db.features().logstor_record_compression) {
+            for (auto& path : replica::logstor::local_record_compression().dictionary_files()) {
+                auto& info = files.emplace_back();
+                info.filename = path.filename().native();
+                info.fops = file_ops::stream_logstor_dictionary;
+                info.source = [path] (const file_input_stream_options& options) -> future<input_stream<char>> {
+                    auto f = co_await open_file_dma(path.native(), open_flags::ro);
+                    co_return make_file_input_stream(std::move(f), options);
+                };
+            }
+        }
         auto segments = co_await table.take_logstor_snapshot(req.range);
         co_await utils::get_local_injector().inject("wait_before_tablet_stream_files_after_snapshot", utils::wait_for_message(std::chrono::seconds(60)));
         for (auto& seg : segments) {
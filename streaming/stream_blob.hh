@@ -45,6 +45,8 @@ enum class file_ops : uint16_t {
     stream_sstables,
     load_sstables,
     stream_logstor_segments,
+    // A compression dictionary which records of streamed logstor segments may be compressed with.
+    stream_logstor_dictionary,
 };
 
 // For STREAM_BLOB verb
@@ -314,6 +314,18 @@ def test_batch_get_item_count(test_table_s, metrics):
         test_table_s.meta.client.batch_get_item(RequestItems = {
             test_table_s.name: {'Keys': [{'p': random_string()}, {'p': random_string()}], 'ConsistentRead': True}})
 
+# BatchGetItem reads the partitions which have the same replicas with one
+# request to each replica, and still returns all the items.
+def test_batch_get_item_multi_partition_reads(test_table_s, metrics):
+    items = [{'p': random_string(), 'a': random_string()} for _ in range(10)]
+    with test_table_s.batch_writer() as batch:
+        for item in items:
+            batch.put_item(item)
+    with check_increases_metric(metrics, ['scylla_storage_proxy_coordinator_multi_partition_reads']):
+        got = test_table_s.meta.client.batch_get_item(RequestItems = {
+            test_table_s.name: {'Keys': [{'p': item['p']} for item in items], 'ConsistentRead': True}})
+    assert sorted(got['Responses'][test_table_s.name], key=lambda item: item['p']) == sorted(items, key=lambda item: item['p'])
+
 KB = 1024
 def test_rcu(test_table_s, metrics):
     with check_increases_metric_exact(metrics, 'scylla_alternator_rcu_total', [[2, None]]):
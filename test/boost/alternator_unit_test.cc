@@ -234,6 +234,57 @@ BOOST_AUTO_TEST_CASE(test_magnitude_and_precision) {
     BOOST_CHECK(res.magnitude < -1000);
 }
 
+// Check that alternator::item_json_writer writes the same JSON text as
+// printing the items built with alternator::deserialize_item(), for values of
+// all the types, including those stored as JSON text (NOT_SUPPORTED_YET).
+BOOST_AUTO_TEST_CASE(test_item_json_writer) {
+    std::vector<std::string> values = {
+        R"({"S": "hello"})",
+        R"({"S": "quote\" backslash\\ newline\n tab\t control\u0001 unicode\u00e9"})",
+        R"({"B": "dGhpcyB0ZXh0IGlzIGJhc2U2NC1lbmNvZGVk"})",
+        R"({"BOOL": true})",
+        R"({"BOOL": false})",
+        R"({"N": "123.45"})",
+        R"({"N": "-1e-7"})",
+        R"({"NULL": true})",
+        R"({"L": [{"S": "Cookies"}, {"N": "3.14159"}]})",
+        R"({"M": {"Name": {"S": "Joe"}, "Age": {"N": "35"}}})",
+        R"({"SS": ["Giraffe", "Hippo", "Zebra"]})",
+        R"({"FLOAT32VECTOR": [1.5, -2.25, 0, 3.4e38]})",
+    };
+    std::vector<bytes> serialized;
+    for (const auto& v : values) {
+        serialized.push_back(alternator::serialize_item(rjson::parse(v)));
+    }
+
+    bytes_ostream out;
+    alternator::item_json_writer writer(out);
+    rjson::value expected = rjson::empty_array();
+    // One item with all the values, and one item with each of them.
+    writer.start_item();
+    rjson::value all = rjson::empty_object();
+    for (size_t i = 0; i < serialized.size(); ++i) {
+        auto name = fmt::format("a{}", i);
+        writer.write_attribute(name, serialized[i]);
+        rjson::add_with_string_name(all, name, alternator::deserialize_item(serialized[i]));
+    }
+    writer.end_item();
+    rjson::push_back(expected, std::move(all));
+    for (const auto& bv : serialized) {
+        writer.start_item();
+        writer.write_attribute("attr", bv);
+        writer.end_item();
+        rjson::value item = rjson::empty_object();
+        rjson::add(item, "attr", alternator::deserialize_item(bv));
+        rjson::push_back(expected, std::move(item));
+    }
+
+    std::string text = "[";
+    text += to_string_view(out.linearize());
+    text += "]";
+    BOOST_REQUIRE_EQUAL(text, rjson::print(expected));
+}
+
 // parsed expression cache tests:
 
 // ANTLR3 leaks memory when it tries to recover from missing token.
@@ -7,6 +7,7 @@
  */
 
 #include <seastar/testing/test_case.hh>
+#include <seastar/testing/thread_test_case.hh>
 
 #include "sstables/sstable_writer.hh"
 #include "test/lib/eventually.hh"
@@ -14,9 +15,12 @@
 #include "test/lib/sstable_test_env.hh"
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/random_utils.hh"
+#include "test/lib/log.hh"
 
 #include "db/config.hh"
 #include "readers/from_mutations.hh"
+#include "schema/schema_builder.hh"
+#include "utils/binary_fuse_filter.hh"
 #include "utils/bloom_filter.hh"
 #include "utils/error_injection.hh"
 #include "utils/i_filter.hh"
@@ -508,3 +512,158 @@ SEASTAR_TEST_CASE(test_rebuild_from_temporary_hashes) {
         }
     });
 }
+
+SEASTAR_THREAD_TEST_CASE(test_blocked_bloom_filter_false_positive_rate) {
+    constexpr int64_t num_elements = 100000;
+    for (double fp_chance : {0.1, 0.01, 0.001}) {
+        auto filter = utils::i_filter::get_filter(num_elements, fp_chance, utils::filter_format::blocked_format);
+        auto& blocked = dynamic_cast<utils::filter::blocked_bloom_filter&>(*filter);
+        BOOST_REQUIRE_EQUAL(blocked.bits().size() % utils::filter::blocked_bloom_filter::block_bits, 0);
+        BOOST_REQUIRE_EQUAL(blocked.bits().size() / 8, utils::i_filter::get_filter_size(num_elements, fp_chance, utils::filter_format::blocked_format));
+        // Blocking costs some bits per element compared to the classic filter, but not too many.
+        BOOST_REQUIRE_GE(blocked.bits().size() / 8, utils::i_filter::get_filter_size(num_elements, fp_chance));
+        BOOST_REQUIRE_LE(blocked.bits().size() / 8, utils::i_filter::get_filter_size(num_elements, fp_chance) * 3 / 2);
+
+        std::vector<bytes> keys;
+        for (int64_t i = 0; i < num_elements; ++i) {
+            keys.push_back(tests::random::get_bytes(16));
+            filter->add(keys.back());
+        }
+        for (const auto& key : keys) {
+            BOOST_REQUIRE(filter->is_present(key));
+        }
+
+        int false_positives = 0;
+        for (int64_t i = 0; i < num_elements; ++i) {
+            // Longer than the added keys, so they're all absent.
+            false_positives += filter->is_present(tests::random::get_bytes(17));
+        }
+        auto rate = double(false_positives) / num_elements;
+        testlog.info("blocked bloom filter: fp_chance={} rate={} bits={}", fp_chance, rate, blocked.bits().size());
+        BOOST_REQUIRE_LE(rate, fp_chance * 1.5);
+    }
+}
+
+SEASTAR_TEST_CASE(test_sstable_with_blocked_bloom_filter) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto schema = ss.schema();
+        auto pks = ss.make_pkeys(1000);
+        utils::chunked_vector<mutation> mutations;
+        for (auto pk : pks) {
+            auto mut = mutation(schema, pk);
+            mut.partition().apply_insert(*schema, ss.make_ckey(1), ss.new_timestamp());
+            mutations.push_back(std::move(mut));
+        }
+
+        auto check = [&] (shared_sstable sst, bool expect_blocked) {
+            BOOST_REQUIRE_EQUAL(sst->has_feature(sstables::sstable_feature::BlockedBloomFilter), expect_blocked);
+            auto filter = sstables::test(sst).get_filter().get();
+            BOOST_REQUIRE_EQUAL(dynamic_cast<utils::filter::blocked_bloom_filter*>(filter) != nullptr, expect_blocked);
+            for (auto pk : pks) {
+                BOOST_REQUIRE(filter->is_present(key::from_partition_key(*schema, pk.key()).get_bytes()));
+            }
+        };
+
+        for (const auto version : {sstable_version_types::me, sstable_version_types::ms}) {
+            for (bool blocked : {false, true}) {
+                env.manager().set_blocked_bloom_filter(blocked);
+                auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(schema, env.make_reader_permit(), mutations),
+                                             env.manager().configure_writer(), version, pks.size());
+                check(sst, blocked);
+                // The format is decided by the sstable's features when it's loaded, not by the configuration.
+                env.manager().set_blocked_bloom_filter(!blocked);
+                check(env.reusable_sst(sst).get(), blocked);
+            }
+        }
+        env.manager().set_blocked_bloom_filter(false);
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_binary_fuse_filter) {
+    using utils::filter::binary_fuse_filter;
+
+    for (size_t num_elements : {0, 1, 2, 10, 1000, 100000}) {
+        for (unsigned fingerprint_bits : {8, 16}) {
+            std::vector<bytes> keys;
+            binary_fuse_filter::storage hashes;
+            for (size_t i = 0; i < num_elements; ++i) {
+                keys.push_back(tests::random::get_bytes(16));
+                hashes.push_back(utils::make_hashed_key(keys.back()).hash()[0]);
+            }
+            if (num_elements) {
+                // Duplicates are tolerated.
+                hashes.push_back(hashes.front());
+            }
+            auto filter = binary_fuse_filter::build(hashes, fingerprint_bits);
+            BOOST_REQUIRE(filter);
+            BOOST_REQUIRE_EQUAL(filter->memory_size(), binary_fuse_filter::get_filter_size(num_elements, fingerprint_bits));
+            BOOST_REQUIRE_THROW(filter->add(keys.empty() ? bytes() : keys.front()), std::logic_error);
+
+            auto loaded = binary_fuse_filter(fingerprint_bits, binary_fuse_filter::storage(filter->data()));
+            for (const auto& key : keys) {
+                BOOST_REQUIRE(filter->is_present(key));
+                BOOST_REQUIRE(loaded.is_present(key));
+            }
+
+            if (num_elements < 1000) {
+                continue;
+            }
+            constexpr int probes = 100000;
+            int false_positives = 0;
+            for (int i = 0; i < probes; ++i) {
+                false_positives += filter->is_present(tests::random::get_bytes(17));
+            }
+            auto rate = double(false_positives) / probes;
+            auto expected_rate = std::ldexp(1.0, -int(fingerprint_bits));
+            testlog.info("binary fuse filter: elements={} fingerprint_bits={} rate={} bytes={}", num_elements, fingerprint_bits, rate, filter->memory_size());
+            BOOST_REQUIRE_LE(rate, expected_rate * 1.5 + 10.0 / probes);
+            if (num_elements >= 100000) {
+                // The point of the filter: it's considerably smaller than a bloom filter with the same false-positive chance.
+                BOOST_REQUIRE_LE(filter->memory_size(), utils::i_filter::get_filter_size(num_elements, expected_rate) * 85 / 100);
+            }
+        }
+    }
+
+    BOOST_REQUIRE_EQUAL(binary_fuse_filter::fingerprint_bits_for(0.01), 8);
+    BOOST_REQUIRE_EQUAL(binary_fuse_filter::fingerprint_bits_for(0.001), 16);
+    BOOST_REQUIRE_EQUAL(binary_fuse_filter::fingerprint_bits_for(0.000001), 0);
+
+    // Malformed filters are rejected.
+    BOOST_REQUIRE_THROW(binary_fuse_filter(8, binary_fuse_filter::storage{}), std::invalid_argument);
+    BOOST_REQUIRE_THROW(binary_fuse_filter(12, binary_fuse_filter::storage{0, 1ull << 32 | 4, 0}), std::invalid_argument);
+    BOOST_REQUIRE_THROW(binary_fuse_filter(8, binary_fuse_filter::storage{0, 1ull << 32 | 3, 0}), std::invalid_argument);
+    BOOST_REQUIRE_THROW(binary_fuse_filter(8, binary_fuse_filter::storage{0, 1ull << 32 | 4, 0, 0, 0}), std::invalid_argument);
+}
+
+SEASTAR_TEST_CASE(test_sstable_with_binary_fuse_filter) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto schema = schema_builder(ss.schema()).set_filter_type(sstable_filter_type::binary_fuse).build();
+        auto pks = ss.make_pkeys(1000);
+        utils::chunked_vector<mutation> mutations;
+        for (auto pk : pks) {
+            auto mut = mutation(schema, pk);
+            mut.partition().apply_insert(*schema, ss.make_ckey(1), ss.new_timestamp());
+            mutations.push_back(std::move(mut));
+        }
+
+        auto check = [&] (shared_sstable sst, bool expect_binary_fuse) {
+            BOOST_REQUIRE_EQUAL(sst->has_feature(sstables::sstable_feature::BinaryFuseFilter), expect_binary_fuse);
+            auto filter = sstables::test(sst).get_filter().get();
+            BOOST_REQUIRE_EQUAL(dynamic_cast<utils::filter::binary_fuse_filter*>(filter) != nullptr, expect_binary_fuse);
+            for (auto pk : pks) {
+                BOOST_REQUIRE(sst->filter_has_key(key::from_partition_key(*schema, pk.key())));
+            }
+        };
+
+        // Only sstables with a BTI index build their filter once all the keys are known.
+        for (const auto version : {sstable_version_types::me, sstable_version_types::ms}) {
+            bool expect_binary_fuse = version == sstable_version_types::ms;
+            auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(schema, env.make_reader_permit(), mutations),
+                                         env.manager().configure_writer(), version, pks.size());
+            check(sst, expect_binary_fuse);
+            check(env.reusable_sst(sst).get(), expect_binary_fuse);
+        }
+    });
+}
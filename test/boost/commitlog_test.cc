@@ -39,6 +39,7 @@
 #include "db/commitlog/commitlog_extensions.hh"
 #include "db/commitlog/rp_set.hh"
 #include "db/extensions.hh"
+#include "schema/schema_builder.hh"
 #include "readers/combined.hh"
 #include "utils/log.hh"
 #include "test/lib/exception_utils.hh"
@@ -1246,6 +1247,68 @@ SEASTAR_TEST_CASE(test_commitlog_add_mutation_entries) {
     });
 }
 
+// Compressed and uncompressed entries can be mixed in a segment, and are
+// both read back transparently.
+SEASTAR_TEST_CASE(test_commitlog_compressed_entries) {
+    commitlog::config cfg;
+    cfg.metrics_category_name = "commitlog";
+    cfg.compress_entries = true;
+    return cl_test(cfg, [](commitlog& log) {
+        return seastar::async([&] {
+            using force_sync = commitlog_mutation_entry_writer::force_sync;
+
+            auto s = schema_builder(this_smp_shard_count(), "ks", "cf")
+                    .with_column("pk", utf8_type, column_kind::partition_key)
+                    .with_column("v", utf8_type)
+                    .build();
+            auto make_mutation = [&] (size_t value_size) {
+                mutation m(s, partition_key::from_single_value(*s, to_bytes(fmt::format("key{}", value_size))));
+                m.set_clustered_cell(clustering_key::make_empty(), "v", data_value(sstring(value_size, 'x')), api::new_timestamp());
+                return freeze(m);
+            };
+
+            utils::chunked_vector<frozen_mutation> mutations;
+            for (auto size : {1, 16, 4096, 64 * 1024, 1024 * 1024}) {
+                mutations.emplace_back(make_mutation(size));
+            }
+
+            utils::chunked_vector<commitlog_mutation_entry_writer> writers;
+            for (auto& fm : mutations) {
+                writers.emplace_back(s, fm, force_sync::no);
+            }
+
+            {
+                commitlog_mutation_entry_writer w(s, mutations[2], force_sync::no);
+                w.setup_for_segment("", true, false);
+                auto uncompressed_size = w.size();
+                w.setup_for_segment("", true, true);
+                BOOST_REQUIRE_LT(w.size(), uncompressed_size / 4);
+            }
+
+            std::vector<replay_position> rps;
+            for (auto& h : log.add_entries(writers, db::timeout_clock::now() + 60s).get()) {
+                rps.emplace_back(h.rp());
+            }
+
+            log.sync_all_segments().get();
+            std::unordered_set<replay_position> result;
+            for (auto& seg : log.get_active_segment_names()) {
+                db::commitlog::read_log_file(seg, db::commitlog::descriptor::FILENAME_PREFIX, [&](db::commitlog::buffer_and_replay_position buf_rp) {
+                    auto i = std::find(rps.begin(), rps.end(), buf_rp.position);
+                    if (i != rps.end()) {
+                        commitlog_entry_reader r(buf_rp.buffer);
+                        auto& me = std::get<mutation_entry>(r.entry().item);
+                        BOOST_CHECK_EQUAL(me.mutation().unfreeze(s), mutations.at(std::distance(rps.begin(), i)).unfreeze(s));
+                        result.emplace(buf_rp.position);
+                    }
+                    return make_ready_future<>();
+                }).get();
+            }
+            BOOST_CHECK_EQUAL(result.size(), rps.size());
+        });
+    });
+}
+
 // #16298 - check entry offsets so that we report the correct file positions both
 // when reading and writing CL data.
 SEASTAR_TEST_CASE(test_commitlog_entry_offsets) {
@@ -2605,6 +2668,70 @@ SEASTAR_TEST_CASE(test_commitlog_replay_segment_order) {
     });
 }
 
+// The segments of a shard are replayed concurrently. Verify that all the
+// entries are replayed, including one fragmented over several segments,
+// whose fragments may be read out of order.
+SEASTAR_TEST_CASE(test_commitlog_replay_segments_concurrently) {
+    cql_test_config cfg;
+    cfg.db_config->commitlog_segment_size_in_mb(1);
+    return do_with_cql_env_thread([](cql_test_env& env) {
+        env.execute_cql("create table t (pk text primary key, v text)").get();
+
+        auto& db = env.local_db();
+        auto& table = db.find_column_family("ks", "t");
+        auto& cl = *table.commitlog();
+        auto s = table.schema();
+        auto memtables = active_memtables(table);
+
+        // Keep rp_handles alive so segments are not recycled.
+        std::vector<rp_handle> handles;
+        std::map<dht::decorated_key, mutation, dht::decorated_key::less_comparator> expected(dht::decorated_key::less_comparator(s));
+        auto add_entry = [&] (size_t value_size) {
+            auto dk = tests::generate_partition_key(s);
+            mutation m(s, dk);
+            m.set_clustered_cell(clustering_key::make_empty(), "v", data_value(sstring(value_size, 'x')), api::new_timestamp());
+            auto fm = freeze(m);
+            commitlog_mutation_entry_writer cew(s, fm, db::commitlog::force_sync::yes);
+            handles.push_back(cl.add_entry(m.column_family_id(), cew, db::no_timeout).get());
+            expected.emplace(std::move(dk), std::move(m));
+        };
+
+        constexpr int num_segments = 4;
+        for (int i = 0; i < num_segments; ++i) {
+            add_entry(100);
+            cl.force_new_active_segment().get();
+        }
+        // Larger than a segment, so it's fragmented over several of them.
+        add_entry(3 * 1024 * 1024);
+        add_entry(100);
+
+        cl.sync_all_segments().get();
+        auto paths = cl.get_active_segment_names();
+        BOOST_REQUIRE_GT(paths.size(), num_segments + 2);
+        BOOST_REQUIRE(std::ranges::all_of(memtables, std::mem_fn(&replica::memtable::empty)));
+
+        auto rp = db::commitlog_replayer::create_replayer(env.db(), env.get_system_keyspace()).get();
+        rp.recover(paths, db::commitlog::descriptor::FILENAME_PREFIX).get();
+
+        std::vector<mutation_reader> readers;
+        readers.reserve(memtables.size());
+        auto permit = db.get_reader_concurrency_semaphore().make_tracking_only_permit(s, "test", db::no_timeout, {});
+        for (auto mt : memtables) {
+            readers.push_back(mt->make_mutation_reader(s, permit));
+        }
+        auto rd = make_combined_reader(s, permit, std::move(readers));
+        auto close_rd = deferred_close(rd);
+        size_t replayed = 0;
+        while (auto mopt = read_mutation_from_mutation_reader(rd).get()) {
+            auto it = expected.find(mopt->decorated_key());
+            BOOST_REQUIRE(it != expected.end());
+            BOOST_REQUIRE_EQUAL(*mopt, it->second);
+            ++replayed;
+        }
+        BOOST_REQUIRE_EQUAL(replayed, expected.size());
+    }, cfg);
+}
+
 // Helper: verify column mapping is included in the first entry for a schema
 // version within a chunk, and omitted in subsequent entries.
 // `use_variant_format`: if true, use variant entry format with descriptor_tag;
@@ -7,6 +7,7 @@
  */
 
 #include <algorithm>
+#include <random>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
@@ -515,4 +516,52 @@ SEASTAR_THREAD_TEST_CASE(test_extract_float_vector) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(test_similarity_kernels_agree) {
+    // The serialized and batched kernels must produce the same scores as the
+    // native one, for dimensions that do and do not fill whole SIMD registers.
+    auto serialize = [](const std::vector<float>& values) {
+        auto vector_type = vector_type_impl::get_instance(float_type, values.size());
+        std::vector<data_value> data_vals(values.begin(), values.end());
+        return vector_type->decompose(make_list_value(vector_type, std::move(data_vals)));
+    };
+
+    std::mt19937 g(0);
+    std::uniform_real_distribution<float> dist(-1, 1);
+    for (size_t dim : {1, 3, 7, 8, 9, 16, 31, 128, 1536}) {
+        std::vector<float> query(dim);
+        std::ranges::generate(query, [&] { return dist(g); });
+        auto serialized_query = serialize(query);
+
+        std::vector<bytes> rows;
+        std::vector<std::vector<float>> native_rows;
+        for (int i = 0; i < 5; ++i) {
+            native_rows.emplace_back(dim);
+            std::ranges::generate(native_rows.back(), [&] { return dist(g); });
+            rows.push_back(serialize(native_rows.back()));
+        }
+        std::vector<bytes_view> row_views(rows.begin(), rows.end());
+
+        for (const auto& [name, kernels] : cql3::functions::SIMILARITY_FUNCTIONS) {
+            std::vector<float> batch_results(rows.size());
+            kernels.batch(query, row_views, batch_results);
+            for (size_t i = 0; i < rows.size(); ++i) {
+                auto expected = kernels.native(query, native_rows[i]);
+                BOOST_CHECK_CLOSE(kernels.serialized(serialized_query, rows[i]), expected, 1e-3);
+                BOOST_CHECK_CLOSE(batch_results[i], expected, 1e-3);
+            }
+        }
+    }
+
+    // A vector of the wrong size is rejected by the batched kernel
+    std::vector<float> query(3, 1.0f);
+    auto too_short = serialize({1.0f, 2.0f});
+    std::vector<bytes_view> row_views{too_short};
+    std::vector<float> results(1);
+    BOOST_REQUIRE_EXCEPTION(
+        cql3::functions::SIMILARITY_FUNCTIONS.at(cql3::functions::SIMILARITY_COSINE_FUNCTION_NAME).batch(query, row_views, results),
+        exceptions::invalid_request_exception,
+        seastar::testing::exception_predicate::message_contains("Invalid vector size")
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include "index/inverted_index.hh"
+#include <fmt/format.h>
+#include <random>
+
+using namespace secondary_index::fulltext;
+
+BOOST_AUTO_TEST_CASE(test_tokenize) {
+    using v = std::vector<std::string>;
+    BOOST_REQUIRE(tokenize("Hello, World! foo-bar 42", analyzer::standard) == (v{"hello", "world", "foo", "bar", "42"}));
+    BOOST_REQUIRE(tokenize("Hello, World! foo-bar 42", analyzer::simple) == (v{"hello", "world", "foo", "bar"}));
+    BOOST_REQUIRE(tokenize("Hello, World! foo-bar 42", analyzer::whitespace) == (v{"Hello,", "World!", "foo-bar", "42"}));
+    // Non-ASCII characters are kept as part of words.
+    BOOST_REQUIRE(tokenize("zażółć gęślą", analyzer::standard) == (v{"zażółć", "gęślą"}));
+    BOOST_REQUIRE(tokenize("  ", analyzer::standard).empty());
+
+    BOOST_REQUIRE(analyzer_from_option("Simple") == analyzer::simple);
+    BOOST_REQUIRE(analyzer_from_option("whitespace") == analyzer::whitespace);
+    BOOST_REQUIRE(analyzer_from_option("english") == analyzer::standard);
+}
+
+BOOST_AUTO_TEST_CASE(test_postings_round_trip) {
+    std::mt19937 g(0);
+    for (size_t count : std::initializer_list<size_t>{0, 1, 5, postings_block_size - 1, postings_block_size, postings_block_size + 1, 1000}) {
+        std::vector<posting> postings;
+        doc_id doc = 0;
+        for (size_t i = 0; i < count; ++i) {
+            // Mix small and large gaps and frequencies, so that blocks get different bit widths.
+            doc += 1 + g() % (i % 7 == 0 ? 100000 : 10);
+            postings.push_back(posting{doc, 1 + uint32_t(g() % (i % 5 == 0 ? 1000 : 3))});
+        }
+        auto encoded = encode_postings(postings);
+        BOOST_REQUIRE(decode_postings(encoded, doc + 1) == postings);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_postings) {
+    std::vector<posting> postings{{0, 1}, {3, 2}, {7, 1}};
+    auto encoded = encode_postings(postings);
+    BOOST_REQUIRE(decode_postings(encoded, 8) == postings);
+    // A doc id beyond the documents of the segment.
+    BOOST_REQUIRE_THROW(decode_postings(encoded, 7), std::runtime_error);
+    // More postings than documents.
+    BOOST_REQUIRE_THROW(decode_postings(encoded, 2), std::runtime_error);
+    // A repeated doc id.
+    BOOST_REQUIRE_THROW(decode_postings(encode_postings(std::vector<posting>{{3, 1}, {3, 1}}), 8), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_postings_are_compact) {
+    std::vector<posting> postings;
+    for (doc_id doc = 0; doc < 10000; ++doc) {
+        postings.push_back(posting{doc, 1});
+    }
+    // Consecutive ids and single occurrences need one bit per delta and none per frequency.
+    BOOST_REQUIRE_LT(encode_postings(postings).size(), 10000 / 8 + 200);
+}
+
+BOOST_AUTO_TEST_CASE(test_bm25_search) {
+    inverted_index_builder builder(analyzer::standard);
+    builder.add("the quick brown fox");
+    builder.add("the lazy dog");
+    builder.add("a quick fox jumps over the lazy dog and another quick fox");
+    builder.add("nothing to see here");
+    auto index = std::move(builder).build();
+
+    BOOST_REQUIRE_EQUAL(index.doc_count(), 4);
+    BOOST_REQUIRE_EQUAL(index.stats("the").doc_frequency, 3);
+    BOOST_REQUIRE_EQUAL(index.stats("missing").doc_frequency, 0);
+    BOOST_REQUIRE(index.postings("quick") == (std::vector<posting>{{0, 1}, {2, 2}}));
+
+    auto results = index.search("Quick FOX", 10);
+    BOOST_REQUIRE_EQUAL(results.size(), 2);
+    BOOST_REQUIRE_GE(results[0].score, results[1].score);
+    for (auto& r : results) {
+        BOOST_REQUIRE(r.doc == 0 || r.doc == 2);
+        BOOST_REQUIRE_GT(r.score, 0);
+    }
+
+    // A rare term weighs more than a common one.
+    auto dog = index.search("dog", 10);
+    auto the = index.search("the", 10);
+    BOOST_REQUIRE_GT(dog[0].score, the[0].score);
+
+    BOOST_REQUIRE_EQUAL(index.search("the", 1).size(), 1);
+    BOOST_REQUIRE(index.search("unknown words", 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_bm25_search_across_segments) {
+    std::vector<std::string> docs;
+    for (int i = 0; i < 300; ++i) {
+        docs.push_back(fmt::format("doc{} common term{}", i, i % 7));
+    }
+    inverted_index_builder whole_builder(analyzer::whitespace);
+    inverted_index_builder first_builder(analyzer::whitespace);
+    inverted_index_builder second_builder(analyzer::whitespace);
+    for (size_t i = 0; i < docs.size(); ++i) {
+        whole_builder.add(docs[i]);
+        (i < 100 ? first_builder : second_builder).add(docs[i]);
+    }
+    auto whole = std::move(whole_builder).build();
+    auto first = std::move(first_builder).build();
+    auto second = std::move(second_builder).build();
+
+    // Segments searched with the statistics of all of them score their
+    // documents as a single index of all the documents does.
+    auto terms = query_terms("common term3 term3", analyzer::whitespace);
+    BOOST_REQUIRE(terms == (std::vector<std::string>{"common", "term3"}));
+    corpus_stats stats;
+    first.add_stats(stats, terms);
+    second.add_stats(stats, terms);
+    BOOST_REQUIRE_EQUAL(stats.doc_count, whole.doc_count());
+    BOOST_REQUIRE_EQUAL(stats.average_doc_length(), whole.average_doc_length());
+    BOOST_REQUIRE_EQUAL(stats.doc_frequencies["term3"], whole.stats("term3").doc_frequency);
+
+    auto expected = whole.search("common term3", whole.doc_count());
+    BOOST_REQUIRE_EQUAL(expected.size(), whole.doc_count());
+    auto results = second.search(terms, 5, stats);
+    BOOST_REQUIRE_EQUAL(results.size(), 5);
+    for (const auto& r : results) {
+        auto it = std::ranges::find(expected, r.doc + 100, &scored_doc::doc);
+        BOOST_REQUIRE(it != expected.end());
+        BOOST_REQUIRE_CLOSE(r.score, it->score, 0.001);
+    }
+
+    // A document is scored from its text as by the index.
+    auto tokens = tokenize(docs[expected[0].doc], analyzer::whitespace);
+    BOOST_REQUIRE_CLOSE(bm25_score(terms, tokens, stats), expected[0].score, 0.001);
+    BOOST_REQUIRE_EQUAL(bm25_score(terms, tokenize("unrelated words", analyzer::whitespace), stats), 0);
+}
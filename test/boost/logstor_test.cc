@@ -9,14 +9,18 @@
 #include <algorithm>
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <stdexcept>
 #include <vector>
 #include <fmt/format.h>
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/seastar.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/util/memory-data-source.hh>
 #include <seastar/util/defer.hh>
 
+#include "replica/logstor/compression.hh"
 #include "replica/logstor/index.hh"
 #include "replica/logstor/ondisk.hh"
 #include "replica/logstor/write_buffer.hh"
@@ -25,9 +29,11 @@
 #include "idl/logstor.dist.hh"
 #include "idl/logstor.dist.impl.hh"
 #include "replica/logstor/segment_io.hh"
+#include "replica/logstor/segment_manager.hh"
 #include "schema/schema_builder.hh"
 #include <seastar/core/simple-stream.hh>
 #include "test/lib/mutation_assertions.hh"
+#include "test/lib/tmpdir.hh"
 
 using namespace replica::logstor;
 
@@ -328,6 +334,150 @@ SEASTAR_THREAD_TEST_CASE(test_logstor_write_buffer_record_and_header_serializati
     BOOST_REQUIRE_EQUAL(sh.last_token, expected.header.key.dk.token());
 }
 
+// Checks that records of tables with compression enabled are compressed once record
+// compression is enabled, and read back through the record header's compressed flag.
+SEASTAR_THREAD_TEST_CASE(test_logstor_compressed_record_round_trip) {
+    auto make_schema = [] (compression_parameters cp) {
+        return schema_builder("ks", "compressed_kv")
+                .with_column("pk", utf8_type, column_kind::partition_key)
+                .with_column("v", utf8_type)
+                .set_compressor_params(cp)
+                .build();
+    };
+    auto value = sstring(fmt::format("{:>4096}", "compressible"));
+
+    auto round_trip = [&] (schema_ptr schema, bool expect_compressed) {
+        auto expected = make_log_record(schema, "pk0", value, api::timestamp_type(7));
+        auto writer = log_record_writer(expected, *schema);
+        BOOST_REQUIRE_EQUAL(writer.compressed(), expect_compressed);
+
+        raw_write_buffer wb(32 * 1024, segment_kind::full);
+        auto res = wb.append(writer);
+        wb.seal(segment_sequence{1}, schema->id(), ondisk::block_alignment);
+        auto segment = make_serialized_buffer_copy(wb);
+
+        auto loc = log_location{
+            .segment = log_segment_id{0},
+            .offset = static_cast<uint32_t>(res.record_header_offset),
+            .size = static_cast<uint32_t>(res.total_size),
+        };
+        auto actual = read_record_at_location(segment, loc);
+        assert_log_record_matches(schema, actual, expected);
+        return res.total_size;
+    };
+
+    auto zstd_schema = make_schema(compression_parameters(compression_parameters::algorithm::zstd));
+
+    // Records are written in the old format until compression is enabled.
+    round_trip(zstd_schema, false);
+
+    local_record_compression().set_enabled(true);
+    auto disable = defer([] { local_record_compression().set_enabled(false); });
+
+    auto uncompressed_size = round_trip(make_schema(compression_parameters(compression_parameters::algorithm::none)), false);
+    // Records are compressed with zstd, so tables which use another algorithm aren't compressed.
+    round_trip(make_schema(compression_parameters(compression_parameters::algorithm::lz4)), false);
+    auto compressed_size = round_trip(zstd_schema, true);
+    BOOST_REQUIRE_LT(compressed_size, uncompressed_size);
+}
+
+// Checks that table dictionaries set before start() are used only once they are
+// persisted, that persisted dictionaries are loaded by start(), and that dictionaries
+// added without a table are used only for decompression.
+SEASTAR_THREAD_TEST_CASE(test_logstor_record_compression_dictionaries) {
+    tmpdir dir;
+    auto schema = schema_builder("ks", "dict_kv")
+            .with_column("pk", utf8_type, column_kind::partition_key)
+            .with_column("v", utf8_type)
+            .set_compressor_params(compression_parameters(compression_parameters::algorithm::zstd_with_dicts))
+            .build();
+    auto payload = bytes(bytes::initialized_later(), 4096);
+    std::ranges::fill(payload, ' ');
+    auto dict = std::vector<std::byte>(4096, std::byte(' '));
+    auto dictionary_of = [] (const bytes& compressed) {
+        return read_le<uint32_t>(reinterpret_cast<const char*>(compressed.data()) + sizeof(uint32_t));
+    };
+
+    {
+        record_compression rc;
+        rc.set_table_dictionary(schema->id(), dict).get();
+        // The dictionary can't be persisted before start(), so it's not used yet.
+        auto compressed = rc.compress(*schema, payload);
+        BOOST_REQUIRE(compressed);
+        BOOST_REQUIRE_EQUAL(dictionary_of(*compressed), 0);
+        BOOST_REQUIRE(rc.dictionary_files().empty());
+
+        rc.start(dir.path()).get();
+        compressed = rc.compress(*schema, payload);
+        BOOST_REQUIRE(compressed);
+        BOOST_REQUIRE_NE(dictionary_of(*compressed), 0);
+        BOOST_REQUIRE_EQUAL(rc.dictionary_files().size(), 1);
+        BOOST_REQUIRE(file_exists(rc.dictionary_files().front().native()).get());
+        BOOST_REQUIRE(rc.decompress(*compressed) == payload);
+
+        // e.g. a dictionary received with streamed segments
+        rc.add_dictionary(std::vector<std::byte>(4096, std::byte('x'))).get();
+        BOOST_REQUIRE_EQUAL(rc.dictionary_files().size(), 2);
+        BOOST_REQUIRE_EQUAL(dictionary_of(*rc.compress(*schema, payload)), dictionary_of(*compressed));
+
+        // After a restart, records compressed with the dictionary are still readable,
+        // as long as the recovered segments reference it. Unreferenced ones are dropped.
+        record_compression restarted;
+        restarted.ref_dictionary(dictionary_of(*compressed));
+        restarted.start(dir.path()).get();
+        BOOST_REQUIRE_EQUAL(restarted.dictionary_files().size(), 1);
+        BOOST_REQUIRE(restarted.decompress(*compressed) == payload);
+
+        // Corrupted sizes are rejected before allocating for them.
+        auto corrupted = *compressed;
+        write_le<uint32_t>(reinterpret_cast<char*>(corrupted.data()), std::numeric_limits<uint32_t>::max());
+        BOOST_REQUIRE_THROW(restarted.decompress(corrupted), std::runtime_error);
+        write_le<uint32_t>(reinterpret_cast<char*>(corrupted.data()), payload.size() + 1);
+        BOOST_REQUIRE_THROW(restarted.decompress(corrupted), std::runtime_error);
+
+        restarted.stop().get();
+        rc.stop().get();
+    }
+}
+
+// Checks that a dictionary which is no longer the table's dictionary is kept while
+// records compressed with it are referenced, and dropped after that.
+SEASTAR_THREAD_TEST_CASE(test_logstor_record_compression_unused_dictionaries) {
+    tmpdir dir;
+    auto schema = schema_builder("ks", "dict_kv")
+            .with_column("pk", utf8_type, column_kind::partition_key)
+            .with_column("v", utf8_type)
+            .set_compressor_params(compression_parameters(compression_parameters::algorithm::zstd_with_dicts))
+            .build();
+    auto payload = bytes(bytes::initialized_later(), 4096);
+    std::ranges::fill(payload, ' ');
+
+    record_compression rc;
+    rc.start(dir.path()).get();
+    rc.set_table_dictionary(schema->id(), std::vector<std::byte>(4096, std::byte(' '))).get();
+    auto referenced = *rc.compress(*schema, payload);
+    rc.ref_dictionary(compressed_dictionary_id(referenced));
+
+    // Replacing the table's dictionary keeps the referenced one.
+    rc.set_table_dictionary(schema->id(), std::vector<std::byte>(4096, std::byte('y'))).get();
+    auto unreferenced = *rc.compress(*schema, payload);
+    BOOST_REQUIRE_NE(compressed_dictionary_id(unreferenced), compressed_dictionary_id(referenced));
+    BOOST_REQUIRE_EQUAL(rc.dictionary_files().size(), 2);
+    BOOST_REQUIRE(rc.decompress(referenced) == payload);
+
+    // Clearing the table's dictionary drops the unreferenced one.
+    rc.set_table_dictionary(schema->id(), {}).get();
+    BOOST_REQUIRE_EQUAL(rc.dictionary_files().size(), 1);
+    BOOST_REQUIRE_THROW(rc.decompress(unreferenced), std::runtime_error);
+    BOOST_REQUIRE(rc.decompress(referenced) == payload);
+
+    rc.unref_dictionary(compressed_dictionary_id(referenced));
+    BOOST_REQUIRE(rc.dictionary_files().empty());
+    BOOST_REQUIRE_THROW(rc.decompress(referenced), std::runtime_error);
+
+    rc.stop().get();
+}
+
 // Checks that a raw write buffer can hold and seal a record whose serialized size is exactly max_record_size().
 SEASTAR_THREAD_TEST_CASE(test_logstor_write_buffer_accepts_record_at_max_record_size) {
     auto schema = make_kv_schema();
@@ -1421,3 +1571,67 @@ SEASTAR_THREAD_TEST_CASE(test_logstor_buffered_writer_flush_failure_fails_all_wr
     BOOST_REQUIRE_EQUAL(flush_ctl.started_count, 1u);
     BOOST_REQUIRE(flush_ctl.flushed_buffers.empty());
 }
+
+SEASTAR_THREAD_TEST_CASE(test_logstor_segment_set_write_amplification_accounting) {
+    table_segment_stats empty;
+    BOOST_REQUIRE_EQUAL(empty.write_amplification(), 1.0);
+
+    segment_set a;
+    segment_set b;
+    a._separator_data_bytes_written = 1000;
+    a._compaction_data_bytes_written = 500;
+    b._separator_data_bytes_written = 1000;
+    b._compaction_data_bytes_written = 1500;
+
+    // Merging compaction groups keeps the history of both.
+    a.merge(b).get();
+    BOOST_REQUIRE_EQUAL(a._separator_data_bytes_written, 2000);
+    BOOST_REQUIRE_EQUAL(a._compaction_data_bytes_written, 2000);
+    BOOST_REQUIRE_EQUAL(b._separator_data_bytes_written, 0);
+    BOOST_REQUIRE_EQUAL(b._compaction_data_bytes_written, 0);
+
+    table_segment_stats shard1{.separator_data_bytes_written = 2000, .compaction_data_bytes_written = 2000};
+    table_segment_stats shard2{.separator_data_bytes_written = 2000, .compaction_data_bytes_written = 0};
+    shard1 += shard2;
+    BOOST_REQUIRE_EQUAL(shard1.separator_data_bytes_written, 4000);
+    BOOST_REQUIRE_EQUAL(shard1.compaction_data_bytes_written, 2000);
+    BOOST_REQUIRE_EQUAL(shard1.write_amplification(), 1.5);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_logstor_plan_coalesced_reads) {
+    auto loc = [] (uint32_t seg, uint32_t offset, uint32_t size) {
+        return log_location{log_segment_id{seg}, offset, size};
+    };
+    std::vector<log_location> locations{
+        loc(2, 0, 100),
+        loc(1, 4096, 100),
+        loc(1, 0, 100),
+        loc(1, 200, 100),
+        loc(2, 0, 100),          // duplicate
+        loc(1, 1 << 20, 100),    // beyond the max gap
+    };
+
+    auto reads = plan_coalesced_reads(locations, read_coalescing_options{.max_gap = 4096, .max_read_size = 8192});
+    BOOST_REQUIRE_EQUAL(reads.size(), 3);
+
+    BOOST_REQUIRE(reads[0].segment == log_segment_id{1});
+    BOOST_REQUIRE_EQUAL(reads[0].offset, 0);
+    BOOST_REQUIRE_EQUAL(reads[0].size, 4196);
+    BOOST_REQUIRE(reads[0].records == (std::vector<size_t>{2, 3, 1}));
+
+    BOOST_REQUIRE(reads[1].segment == log_segment_id{1});
+    BOOST_REQUIRE_EQUAL(reads[1].offset, 1 << 20);
+    BOOST_REQUIRE(reads[1].records == (std::vector<size_t>{5}));
+
+    BOOST_REQUIRE(reads[2].segment == log_segment_id{2});
+    BOOST_REQUIRE_EQUAL(reads[2].size, 100);
+    BOOST_REQUIRE(reads[2].records == (std::vector<size_t>{0, 4}));
+
+    // Reads are split when they would exceed the maximum read size.
+    reads = plan_coalesced_reads(locations, read_coalescing_options{.max_gap = 4096, .max_read_size = 1024});
+    BOOST_REQUIRE_EQUAL(reads.size(), 4);
+    BOOST_REQUIRE(reads[0].records == (std::vector<size_t>{2, 3}));
+    BOOST_REQUIRE(reads[1].records == (std::vector<size_t>{1}));
+
+    BOOST_REQUIRE(plan_coalesced_reads({}).empty());
+}
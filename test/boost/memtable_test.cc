@@ -237,6 +237,52 @@ SEASTAR_TEST_CASE(test_memtable_flush_reader) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_memtable_parallel_flush_readers) {
+    schema_ptr s = schema_builder(this_smp_shard_count(), "ks", "cf")
+            .with_column("pk", bytes_type, column_kind::partition_key)
+            .with_column("col", bytes_type, column_kind::regular_column)
+            .build();
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+
+    replica::dirty_memory_manager mgr;
+    replica::memtable_table_shared_data table_shared_data;
+    replica::table_stats tbl_stats;
+    auto mt = make_lw_shared<replica::memtable>(s, mgr, table_shared_data, tbl_stats);
+
+    auto ring = make_ring(s, 64);
+    for (auto& m : ring) {
+        set_column(m, "col");
+        mt->apply(m);
+    }
+
+    BOOST_REQUIRE_EQUAL(mt->make_flush_ranges(1).size(), 1);
+
+    auto ranges = mt->make_flush_ranges(4);
+    BOOST_REQUIRE_EQUAL(ranges.size(), 4);
+    BOOST_REQUIRE(!ranges.front().start());
+    BOOST_REQUIRE(!ranges.back().end());
+
+    // All the readers are created up front, as when flushing.
+    std::vector<mutation_reader> readers;
+    for (const auto& range : ranges) {
+        readers.push_back(mt->make_flush_reader(s, semaphore.make_permit(), range));
+    }
+
+    auto cmp = dht::ring_position_comparator(*s);
+    size_t partitions = 0;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        auto rd = assert_that(std::move(readers[i]));
+        for (const auto& m : ring) {
+            if (ranges[i].contains(m.decorated_key(), cmp)) {
+                rd.produces(m);
+                ++partitions;
+            }
+        }
+        rd.produces_end_of_stream();
+    }
+    BOOST_REQUIRE_EQUAL(partitions, ring.size());
+}
+
 SEASTAR_TEST_CASE(test_adding_a_column_during_reading_doesnt_affect_read_result) {
     return seastar::async([] {
         auto common_builder = schema_builder(this_smp_shard_count(), "ks", "cf")
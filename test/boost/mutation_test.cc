@@ -951,6 +951,77 @@ SEASTAR_TEST_CASE(test_cell_ordering) {
     return make_ready_future<>();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_compact_live_cells) {
+    auto value = long_type->decompose(int64_t(0x0102030405060708));
+    const auto max_compact_timestamp = (api::timestamp_type(1) << 52) - 1;
+
+    for (api::timestamp_type ts : {api::timestamp_type(0), api::timestamp_type(1), api::new_timestamp(), max_compact_timestamp}) {
+        auto c = atomic_cell::make_live(*long_type, ts, value);
+        BOOST_REQUIRE(c.is_live());
+        BOOST_REQUIRE(!c.is_live_and_has_ttl());
+        BOOST_REQUIRE(!c.is_counter_update());
+        BOOST_REQUIRE_EQUAL(c.timestamp(), ts);
+        BOOST_REQUIRE(c.value() == managed_bytes_view(bytes_view(value)));
+        // The cell fits in managed_bytes' inline storage.
+        BOOST_REQUIRE_EQUAL(atomic_cell_or_collection(std::move(c)).external_memory_usage(*long_type), 0);
+    }
+
+    for (api::timestamp_type ts : {api::timestamp_type(-1), max_compact_timestamp + 1, api::max_timestamp}) {
+        auto c = atomic_cell::make_live(*long_type, ts, value);
+        BOOST_REQUIRE_EQUAL(c.timestamp(), ts);
+        BOOST_REQUIRE(c.value() == managed_bytes_view(bytes_view(value)));
+    }
+
+    // Compact cells merge like the regular ones.
+    auto older = atomic_cell::make_live(*long_type, max_compact_timestamp, value);
+    auto newer = atomic_cell::make_live(*long_type, max_compact_timestamp + 1, value);
+    BOOST_REQUIRE(compare_atomic_cell_for_merge(older, newer) < 0);
+    auto expiring = atomic_cell::make_live(*long_type, 1, value, gc_clock::now() + std::chrono::hours(1), std::chrono::hours(1));
+    BOOST_REQUIRE(compare_atomic_cell_for_merge(atomic_cell::make_live(*long_type, 1, value), expiring) < 0);
+
+    // Counter cells keep the full timestamp, since it's updated in place.
+    auto counter = atomic_cell::make_live(*counter_type, 1, bytes());
+    counter.set_timestamp(api::max_timestamp);
+    BOOST_REQUIRE_EQUAL(counter.timestamp(), api::max_timestamp);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_compact_collection_cells) {
+    auto map_type = map_type_impl::get_instance(int32_type, utf8_type, true);
+    auto s = schema_builder(this_smp_shard_count(), some_keyspace, some_column_family)
+                .with_column("p1", utf8_type, column_kind::partition_key)
+                .with_column("c1", int32_type, column_kind::clustering_key)
+                .with_column("s1", map_type, column_kind::static_column)
+                .build();
+    auto& column = *s->get_column_definition("s1");
+    auto ts = api::new_timestamp();
+    auto key = int32_type->decompose(1);
+    auto value = utf8_type->decompose(sstring("v"));
+
+    auto compact = atomic_cell::make_live(*utf8_type, ts, value, atomic_cell::collection_member::yes);
+    auto full_bytes = atomic_cell_type::make_live(ts, single_fragment_range(bytes_view(value)));
+    auto full = atomic_cell(*utf8_type, atomic_cell_view::from_bytes(managed_bytes_view(full_bytes)));
+
+    // Collections read from the wire use the compact layout, like the ones built in memory.
+    mutation m(s, partition_key::from_exploded(*s, {to_bytes("key1")}));
+    m.set_static_cell(column, make_collection_mutation({}, key, atomic_cell(*utf8_type, compact)));
+    auto unfrozen = freeze(m).unfreeze(s);
+    auto* cell = unfrozen.partition().static_row().find_cell(column.id);
+    BOOST_REQUIRE(cell);
+    BOOST_REQUIRE(cell->as_collection_mutation().data == m.partition().static_row().find_cell(column.id)->as_collection_mutation().data);
+
+    // Equal collections compare equal whatever the layout of their cells.
+    atomic_cell_or_collection with_compact(make_collection_mutation({}, key, atomic_cell(*utf8_type, compact)));
+    atomic_cell_or_collection with_full(make_collection_mutation({}, key, atomic_cell(*utf8_type, full)));
+    BOOST_REQUIRE(with_compact.as_collection_mutation().data != with_full.as_collection_mutation().data);
+    BOOST_REQUIRE(with_compact.equals(*map_type, with_full));
+    BOOST_REQUIRE(with_full.equals(*map_type, with_compact));
+
+    atomic_cell_or_collection newer(make_collection_mutation({}, key, atomic_cell::make_live(*utf8_type, ts + 1, value, atomic_cell::collection_member::yes)));
+    BOOST_REQUIRE(!with_full.equals(*map_type, newer));
+    atomic_cell_or_collection deleted(make_collection_mutation(tombstone(ts, gc_clock::now()), key, atomic_cell(*utf8_type, compact)));
+    BOOST_REQUIRE(!with_compact.equals(*map_type, deleted));
+}
+
 static query::partition_slice make_full_slice(const schema& s) {
     return partition_slice_builder(s).build();
 }
@@ -5643,4 +5643,128 @@ SEASTAR_THREAD_TEST_CASE(test_cache_read_concurrent_to_nonpopulating_reader) {
         .produces_end_of_stream();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_cache_admission_filter) {
+    auto s = make_schema();
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+
+    utils::chunked_vector<mutation> mutations = make_ring(s, 4);
+    auto mt = make_memtable(s, mutations).get();
+
+    cache_tracker tracker;
+    tracker.set_admission_filter(utils::updateable_value<bool>(true));
+    row_cache cache(s, snapshot_source_from_snapshot(mt->as_data_source()), tracker);
+
+    // A scan misses each partition once, so none of them is admitted.
+    auto rd = assert_that(cache.make_reader(s, semaphore.make_permit(), query::full_partition_range));
+    for (auto& m : mutations) {
+        rd.produces(m);
+    }
+    rd.produces_end_of_stream();
+    BOOST_REQUIRE_EQUAL(tracker.partitions(), 0);
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions_not_admitted, mutations.size());
+
+    // The partitions which are missed again are.
+    auto pr = dht::partition_range::make_singular(mutations[1].decorated_key());
+    assert_that(cache.make_reader(s, semaphore.make_permit(), pr))
+        .produces(mutations[1])
+        .produces_end_of_stream();
+    BOOST_REQUIRE_EQUAL(tracker.partitions(), 1);
+
+    auto hits = tracker.get_stats().partition_hits;
+    assert_that(cache.make_reader(s, semaphore.make_permit(), pr))
+        .produces(mutations[1])
+        .produces_end_of_stream();
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_hits, hits + 1);
+
+    // Without the filter, partitions are admitted on the first miss, also when they turn out to be missing.
+    tracker.set_admission_filter(utils::updateable_value<bool>(false));
+    auto pkey = make_new_mutation(s).decorated_key();
+    assert_that(cache.make_reader(s, semaphore.make_permit(), dht::partition_range::make_singular(pkey)))
+        .produces_end_of_stream();
+    BOOST_REQUIRE_EQUAL(tracker.partitions(), 2);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_cache_protects_partitions_read_again) {
+    auto s = make_schema();
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+
+    utils::chunked_vector<mutation> mutations = make_ring(s, 10);
+    auto mt = make_memtable(s, mutations).get();
+
+    cache_tracker tracker;
+    tracker.get_lru().set_protected_fraction(0.5);
+    row_cache cache(s, snapshot_source_from_snapshot(mt->as_data_source()), tracker);
+
+    auto read = [&] (const mutation& m) {
+        assert_that(cache.make_reader(s, semaphore.make_permit(), dht::partition_range::make_singular(m.decorated_key())))
+            .produces(m)
+            .produces_end_of_stream();
+    };
+
+    // The first partition is read twice, the others only once.
+    for (auto& m : mutations) {
+        read(m);
+    }
+    read(mutations[0]);
+    BOOST_REQUIRE_GT(tracker.get_lru().protected_size(), 0);
+
+    // The partitions read once are evicted first.
+    while (tracker.get_lru().size() > tracker.get_lru().protected_size()) {
+        tracker.region().evict_some();
+    }
+    BOOST_REQUIRE_EQUAL(tracker.partitions(), 1);
+
+    auto hits = tracker.get_stats().partition_hits;
+    read(mutations[0]);
+    BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_hits, hits + 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_cache_new_versions_are_evicted_after_protected_ones) {
+    auto s = make_schema();
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+
+    utils::chunked_vector<mutation> mutations = make_ring(s, 10);
+    memtable_snapshot_source underlying(s);
+    for (auto& m : mutations) {
+        underlying.apply(m);
+    }
+
+    cache_tracker tracker;
+    tracker.get_lru().set_protected_fraction(0.5);
+    row_cache cache(s, snapshot_source([&] { return underlying(); }), tracker);
+
+    auto read = [&] (const mutation& m) {
+        assert_that(cache.make_reader(s, semaphore.make_permit(), dht::partition_range::make_singular(m.decorated_key())))
+            .produces(m)
+            .produces_end_of_stream();
+    };
+
+    for (auto& m : mutations) {
+        read(m);
+    }
+    read(mutations[0]);
+    auto protected_rows = tracker.get_lru().protected_size();
+    BOOST_REQUIRE_GT(protected_rows, 0);
+
+    // The reader keeps a snapshot of the protected partition, so the update adds a new version to it.
+    auto rd = cache.make_reader(s, semaphore.make_permit(), dht::partition_range::make_singular(mutations[0].decorated_key()));
+    auto close_rd = deferred_close(rd);
+    rd.fill_buffer().get();
+
+    auto m2 = make_new_mutation(s, mutations[0].key());
+    auto mt = make_lw_shared<replica::memtable>(s);
+    mt->apply(m2);
+    cache.update(row_cache::external_updater([&] { underlying.apply(m2); }), *mt).get();
+
+    // The rows of the new version must be evicted after the protected rows of the older one.
+    BOOST_REQUIRE_GT(tracker.get_lru().protected_size(), protected_rows);
+
+    rd.close().get();
+    close_rd.cancel();
+    while (tracker.get_lru().size() > tracker.get_lru().protected_size()) {
+        tracker.region().evict_some();
+    }
+    read(mutations[0] + m2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -37,6 +37,7 @@
 #include "partition_slice_builder.hh"
 #include "compaction/time_window_compaction_strategy.hh"
 #include "compaction/leveled_compaction_strategy.hh"
+#include "compaction/lazy_leveled_compaction_strategy.hh"
 #include "compaction/incremental_backlog_tracker.hh"
 #include "compaction/size_tiered_backlog_tracker.hh"
 #include "test/lib/mutation_assertions.hh"
@@ -73,6 +74,8 @@
 #include "utils/pretty_printers.hh"
 #include "sstables/exceptions.hh"
 #include "sstables/storage.hh"
+#include "sstables/value_log.hh"
+#include "db/value_log_options.hh"
 
 BOOST_AUTO_TEST_SUITE(sstable_compaction_test)
 
@@ -2418,6 +2421,64 @@ SEASTAR_FIXTURE_TEST_CASE(size_tiered_beyond_max_threshold_gcs_test, gcs_fixture
                                    test_env_config{.storage = make_test_object_storage_options("GS")});
 }
 
+SEASTAR_TEST_CASE(lazy_leveled_merge_into_last_level_test) {
+    return test_env::do_with_async([](test_env& env) {
+        auto schema = table_for_tests::make_default_schema();
+        auto cf = env.make_table_for_tests(schema);
+        auto stop_cf = deferred_stop(cf);
+        std::map<sstring, sstring> options = {
+            {"sstable_size_in_mb", "1"},
+            {"size_ratio", "10"},
+        };
+        auto cs = compaction::make_compaction_strategy(compaction::compaction_strategy_type::lazy_leveled, options);
+        constexpr uint64_t mb = 1024 * 1024;
+
+        const auto keys = tests::generate_partition_keys(20, schema);
+        auto add_sstable = [&] (uint64_t data_size, int level, const dht::decorated_key& first, const dht::decorated_key& last) {
+            auto sst = env.make_sstable(schema);
+            sstables::test(sst).set_values_for_leveled_strategy(data_size, level, 0 /*max ts*/, first.key(), last.key());
+            column_family_test(cf).add_sstable(sst).get();
+            return sst;
+        };
+
+        // A last level of 10 disjoint sstables of 1MB.
+        std::vector<shared_sstable> last_level;
+        for (size_t i = 0; i < keys.size(); i += 2) {
+            last_level.push_back(add_sstable(mb, 1, keys[i], keys[i + 1]));
+        }
+
+        // Tiers smaller than the last level / size_ratio are compacted with each other.
+        std::vector<shared_sstable> tiers;
+        for (auto i = 0; i < 4; i++) {
+            tiers.push_back(add_sstable(mb / 16, 0, keys.front(), keys.back()));
+        }
+        auto candidates = last_level;
+        std::ranges::copy(tiers, std::back_inserter(candidates));
+        auto desc = get_sstables_for_compaction(cs, cf.as_compaction_group_view(), candidates).get();
+        BOOST_REQUIRE_EQUAL(desc.sstables.size(), tiers.size());
+        BOOST_REQUIRE_EQUAL(desc.level, 0);
+
+        // Once they reach that size, they're merged with the whole last level.
+        for (auto i = 0; i < 3; i++) {
+            tiers.push_back(add_sstable(mb / 4, 0, keys.front(), keys.back()));
+        }
+        candidates = last_level;
+        std::ranges::copy(tiers, std::back_inserter(candidates));
+        desc = get_sstables_for_compaction(cs, cf.as_compaction_group_view(), candidates).get();
+        BOOST_REQUIRE_EQUAL(desc.sstables.size(), last_level.size() + tiers.size());
+        BOOST_REQUIRE_EQUAL(desc.level, 1);
+        BOOST_REQUIRE_EQUAL(desc.max_sstable_bytes, mb);
+
+        // Unless an sstable of the last level is being compacted.
+        candidates = std::vector<shared_sstable>(last_level.begin() + 1, last_level.end());
+        std::ranges::copy(tiers, std::back_inserter(candidates));
+        desc = get_sstables_for_compaction(cs, cf.as_compaction_group_view(), candidates).get();
+        BOOST_REQUIRE(!desc.sstables.empty());
+        BOOST_REQUIRE(std::ranges::none_of(desc.sstables, compaction::lazy_leveled_compaction_strategy::in_last_level));
+        BOOST_REQUIRE_EQUAL(desc.level, 0);
+    });
+}
+
 void sstable_expired_data_ratio(test_env& env) {
     auto make_schema = [&] (std::string_view cf, compaction::compaction_strategy_type cst) {
         auto builder = schema_builder(this_smp_shard_count(), "tests", cf)
@@ -4876,6 +4937,10 @@ future<> run_controller_test(compaction::compaction_strategy_type compaction_str
                         break;
                     }
                     int level = compaction_strategy_type == compaction::compaction_strategy_type::leveled ? tier_idx : 0;
+                    // With lazy leveling, perfectly compacted data is all in the last level.
+                    if (compaction_strategy_type == compaction::compaction_strategy_type::lazy_leveled) {
+                        level = compaction::lazy_leveled_compaction_strategy::last_level;
+                    }
                     add_sstable(t, tier_size, level);
                     available_space -= std::min(available_space, uint64_t(tier_size));
                 }
@@ -4918,6 +4983,10 @@ SEASTAR_TEST_CASE(simple_backlog_controller_test_incremental) {
     return run_controller_test(compaction::compaction_strategy_type::incremental);
 }
 
+SEASTAR_TEST_CASE(simple_backlog_controller_test_lazy_leveled) {
+    return run_controller_test(compaction::compaction_strategy_type::lazy_leveled);
+}
+
 SEASTAR_TEST_CASE(simple_backlog_controller_test_size_tiered_s3, *boost::unit_test::precondition(tests::has_scylla_test_env)) {
     return run_controller_test(compaction::compaction_strategy_type::size_tiered, test_env_config{.storage = make_test_object_storage_options("S3")});
 }
@@ -6881,4 +6950,254 @@ SEASTAR_TEST_CASE(test_compaction_output_is_not_leaked_when_attach_fails) {
     });
 }
 
+static schema_ptr make_value_log_schema(schema_builder builder) {
+    return builder
+            .with_value_log_options(db::value_log_options({{"enabled", "true"}, {"min_value_size_in_kb", "1"}, {"gc_garbage_ratio", "0.5"}}))
+            .build();
+}
+
+static schema_ptr make_value_log_schema() {
+    return make_value_log_schema(schema_builder("ks", "cf")
+            .with_column("pk", utf8_type, column_kind::partition_key)
+            .with_column("v", bytes_type));
+}
+
+static mutation make_value_mutation(schema_ptr s, const dht::decorated_key& pk, api::timestamp_type ts, const bytes& value) {
+    mutation m(s, pk);
+    m.set_clustered_cell(clustering_key::make_empty(), *s->get_column_definition("v"), atomic_cell::make_live(*bytes_type, ts, value));
+    return m;
+}
+
+static const sstables::value_log_file& single_value_file(const shared_sstable& sst) {
+    auto* vl = sst->get_value_log();
+    BOOST_REQUIRE(vl);
+    BOOST_REQUIRE_EQUAL(vl->files.elements.size(), 1);
+    return vl->files.elements.front();
+}
+
+static void require_same_file(const sstring& a, const sstring& b) {
+    auto sa = file_stat(a).get();
+    auto sb = file_stat(b).get();
+    BOOST_REQUIRE_EQUAL(sa.device_id, sb.device_id);
+    BOOST_REQUIRE_EQUAL(sa.inode_number, sb.inode_number);
+}
+
+// The compaction of an sstable with two large values, and of an sstable which
+// overwrites one of them with a small value, outputs an sstable which points
+// into half of the value file of the first one.
+struct value_log_compaction {
+    schema_ptr s;
+    shared_sstable with_values;
+    shared_sstable output;
+    std::vector<mutation> expected;
+};
+
+static value_log_compaction compact_overwritten_values(test_env& env, table_for_tests& cf) {
+    auto s = cf.schema();
+    auto sst_gen = env.make_sst_factory(s);
+    auto ts = api::new_timestamp();
+    auto pks = tests::generate_partition_keys(2, s);
+    auto large1 = tests::random::get_bytes(2048);
+    auto large2 = tests::random::get_bytes(2048);
+    auto small = tests::random::get_bytes(16);
+
+    auto with_values = make_sstable_containing(sst_gen, {make_value_mutation(s, pks[0], ts, large1), make_value_mutation(s, pks[1], ts, large2)}).get();
+    auto overwrite = make_sstable_containing(sst_gen, {make_value_mutation(s, pks[0], ts + 1, small)}).get();
+    BOOST_REQUIRE(!overwrite->has_value_log());
+
+    auto ret = compact_sstables(env, compaction::compaction_descriptor({with_values, overwrite}), cf, sst_gen).get();
+    BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1);
+    return value_log_compaction{s, with_values, ret.new_sstables.front(),
+            {make_value_mutation(s, pks[0], ts + 1, small), make_value_mutation(s, pks[1], ts, large2)}};
+}
+
+static void require_values(test_env& env, const shared_sstable& sst, schema_ptr s, const std::vector<mutation>& expected) {
+    auto rd = assert_that(sstable_reader(sst, s, env.make_reader_permit()));
+    for (const auto& m : expected) {
+        rd.produces(m);
+    }
+    rd.produces_end_of_stream();
+}
+
+SEASTAR_TEST_CASE(test_value_log_compaction_links_value_files) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto cf = env.make_table_for_tests(make_value_log_schema());
+        auto close_cf = deferred_stop(cf);
+        auto c = compact_overwritten_values(env, cf);
+        auto& input = single_value_file(c.with_values);
+
+        // The output points into the value file of the input, which it links to.
+        auto& output = single_value_file(c.output);
+        BOOST_REQUIRE_EQUAL(output.id, input.id);
+        BOOST_REQUIRE_EQUAL(output.size, input.size);
+        BOOST_REQUIRE_EQUAL(output.referenced_bytes, input.size / 2);
+        require_same_file(c.output->value_file_name(output.id), c.with_values->value_file_name(input.id));
+        require_values(env, c.output, c.s, c.expected);
+
+        // The file is counted once in the sizes of the sstables which link to it.
+        auto reloaded = env.reusable_sst(c.with_values).get();
+        BOOST_REQUIRE_EQUAL(reloaded->bytes_on_disk() + input.size / 2, c.with_values->bytes_on_disk());
+    });
+}
+
+SEASTAR_TEST_CASE(test_value_log_compaction_relocates_garbage) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto cf = env.make_table_for_tests(make_value_log_schema());
+        auto close_cf = deferred_stop(cf);
+        auto c = compact_overwritten_values(env, cf);
+        auto& input = single_value_file(c.output);
+
+        // Half of the file isn't pointed to by the sstables of the table, which
+        // reaches gc_garbage_ratio, so the values are rewritten to a new file.
+        column_family_test(cf).add_sstable(c.output).get();
+        auto ret = compact_sstables(env, compaction::compaction_descriptor({c.output}), cf, env.make_sst_factory(c.s)).get();
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1);
+        auto relocated = ret.new_sstables.front();
+        auto& output = single_value_file(relocated);
+        BOOST_REQUIRE_NE(output.id, input.id);
+        BOOST_REQUIRE_EQUAL(output.size, input.size / 2);
+        BOOST_REQUIRE_EQUAL(output.referenced_bytes, output.size);
+        require_values(env, relocated, c.s, c.expected);
+    });
+}
+
+SEASTAR_TEST_CASE(test_value_log_gc_job) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto cf = env.make_table_for_tests(make_value_log_schema());
+        auto close_cf = deferred_stop(cf);
+        cf->set_compaction_strategy(compaction::compaction_strategy_type::size_tiered);
+        auto& cm = cf->get_compaction_manager();
+        auto c = compact_overwritten_values(env, cf);
+        auto garbage = single_value_file(c.output).id;
+
+        // The strategy has nothing to compact in a single sstable, so the
+        // compaction manager rewrites it to reclaim the garbage of its value file.
+        column_family_test(cf).add_sstable(c.output).get();
+        cf->trigger_compaction();
+        BOOST_REQUIRE(eventually_true([&] {
+            return cm.get_stats().completed_tasks > 0 && cm.get_stats().pending_tasks == 0 && cm.get_stats().active_tasks == 0;
+        }));
+        BOOST_REQUIRE_EQUAL(cm.get_stats().errors, 0);
+        auto ssts = cf->get_sstables();
+        BOOST_REQUIRE_EQUAL(ssts->size(), 1);
+        auto sst = *ssts->begin();
+        BOOST_REQUIRE_NE(single_value_file(sst).id, garbage);
+        require_values(env, sst, c.s, c.expected);
+    });
+}
+
+SEASTAR_TEST_CASE(test_value_log_compaction_escapes_values) {
+    return test_env::do_with_async([] (test_env& env) {
+        // An sstable written before the option was enabled has no value files,
+        // and may have values which start with the magic bytes.
+        auto plain_schema = schema_builder("ks", "cf")
+                .with_column("pk", utf8_type, column_kind::partition_key)
+                .with_column("v", bytes_type)
+                .build();
+        auto s = make_value_log_schema(schema_builder(plain_schema));
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+        auto ts = api::new_timestamp();
+        auto pks = tests::generate_partition_keys(3, s);
+        auto large = tests::random::get_bytes(2048);
+        auto magic = bytes(reinterpret_cast<const int8_t*>(sstables::value_log::magic.data()), sstables::value_log::magic.size()) + tests::random::get_bytes(16);
+        auto separated = tests::random::get_bytes(2048);
+
+        auto plain = make_sstable_containing(env.make_sstable(plain_schema),
+                {make_value_mutation(plain_schema, pks[0], ts, large), make_value_mutation(plain_schema, pks[1], ts, magic)}).get();
+        BOOST_REQUIRE(!plain->has_value_log());
+        plain = env.reusable_sst(s, plain).get();
+        auto sst_gen = env.make_sst_factory(s);
+        auto with_values = make_sstable_containing(sst_gen, {make_value_mutation(s, pks[2], ts, separated)}).get();
+        auto linked = single_value_file(with_values).id;
+
+        auto ret = compact_sstables(env, compaction::compaction_descriptor({plain, with_values}), cf, sst_gen).get();
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1);
+        auto output = ret.new_sstables.front();
+
+        // The large value of the plain sstable is separated into a new value
+        // file, and the output links to the file of the other sstable.
+        auto* vl = output->get_value_log();
+        BOOST_REQUIRE(vl);
+        BOOST_REQUIRE_EQUAL(vl->files.elements.size(), 2);
+        BOOST_REQUIRE(std::ranges::count(vl->files.elements, linked, &sstables::value_log_file::id) == 1);
+        require_values(env, output, s, {
+                make_value_mutation(s, pks[0], ts, large),
+                make_value_mutation(s, pks[1], ts, magic),
+                make_value_mutation(s, pks[2], ts, separated)});
+    });
+}
+
+SEASTAR_TEST_CASE(test_value_log_compaction_reconciles_values) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto cf = env.make_table_for_tests(make_value_log_schema());
+        auto close_cf = deferred_stop(cf);
+        auto s = cf.schema();
+        auto sst_gen = env.make_sst_factory(s);
+        auto pk = tests::generate_partition_key(s);
+
+        // Cells with the same timestamp are reconciled on their values, not on
+        // the pointers to them, which are random. So repeat, for the pointers
+        // to be in both orders.
+        for (int i = 0; i < 8; ++i) {
+            auto ts = api::new_timestamp();
+            std::vector<bytes> values{tests::random::get_bytes(2048), tests::random::get_bytes(2048), tests::random::get_bytes(16)};
+            std::vector<shared_sstable> ssts;
+            for (auto& v : values) {
+                ssts.push_back(make_sstable_containing(sst_gen, {make_value_mutation(s, pk, ts, v)}).get());
+            }
+            auto expected = make_value_mutation(s, pk, ts, *std::ranges::max_element(values, [] (const bytes& a, const bytes& b) {
+                return compare_unsigned(a, b) < 0;
+            }));
+
+            auto ret = compact_sstables(env, compaction::compaction_descriptor(ssts), cf, sst_gen).get();
+            BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1);
+            require_values(env, ret.new_sstables.front(), s, {expected});
+        }
+    });
+}
+
+SEASTAR_TEST_CASE(test_value_log_file_removed_with_last_sstable) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto cf = env.make_table_for_tests(make_value_log_schema());
+        auto close_cf = deferred_stop(cf);
+        auto c = compact_overwritten_values(env, cf);
+        auto id = single_value_file(c.output).id;
+        auto input_file = c.with_values->value_file_name(id);
+        auto output_file = c.output->value_file_name(id);
+
+        // The input sstable is deleted when the compaction replaces it, and the
+        // output still reads the values from its own link to the file.
+        c.with_values->unlink().get();
+        BOOST_REQUIRE(!file_exists(input_file).get());
+        BOOST_REQUIRE(file_exists(output_file).get());
+        require_values(env, c.output, c.s, c.expected);
+
+        c.output->unlink().get();
+        BOOST_REQUIRE(!file_exists(output_file).get());
+    });
+}
+
+SEASTAR_TEST_CASE(test_value_log_snapshot) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto cf = env.make_table_for_tests(make_value_log_schema());
+        auto close_cf = deferred_stop(cf);
+        auto c = compact_overwritten_values(env, cf);
+        auto id = single_value_file(c.output).id;
+
+        // A snapshot links to the value files of its sstables, so it keeps the
+        // values when the sstables are deleted.
+        c.output->snapshot("snap").get();
+        auto snapshot_dir = (env.tempdir().path() / sstables::snapshots_dir / "snap").native();
+        auto snapshot_file = snapshot_dir + "/" + std::filesystem::path(c.output->value_file_name(id)).filename().native();
+        require_same_file(snapshot_file, c.output->value_file_name(id));
+
+        auto generation = c.output->generation();
+        c.with_values->unlink().get();
+        c.output->unlink().get();
+        auto restored = env.reusable_sst(c.s, snapshot_dir, generation).get();
+        require_values(env, restored, c.s, c.expected);
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
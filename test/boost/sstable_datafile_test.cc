@@ -19,6 +19,7 @@
 
 #include "sstables/sstables.hh"
 #include "sstables/compress.hh"
+#include "sstables/repair_summary.hh"
 #include "sstables/compressor.hh"
 #include "sstables/sstable_compressor_factory.hh"
 #include "sstables/metadata_collector.hh"
@@ -61,6 +62,8 @@
 #include "test/lib/cql_assertions.hh"
 #include "test/lib/gcs_fixture.hh"
 #include "sstables/exceptions.hh"
+#include "sstables/value_log.hh"
+#include "db/value_log_options.hh"
 
 namespace fs = std::filesystem;
 
@@ -3552,3 +3555,380 @@ SEASTAR_THREAD_TEST_CASE(test_small_sstable_has_reasonable_memory_usage) {
     BOOST_REQUIRE_GE(growth, lower_bound);
 #endif
 }
+
+SEASTAR_TEST_CASE(test_decompressed_chunk_cache) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        BOOST_REQUIRE(s->get_compressor_params().get_algorithm() != compression_parameters::algorithm::none);
+
+        utils::chunked_vector<mutation> muts;
+        for (const auto& pk : tests::generate_partition_keys(100, s)) {
+            mutation m(s, pk);
+            ss.add_row(m, ss.make_ckey(0), make_random_string(1000));
+            muts.push_back(std::move(m));
+        }
+        auto sst = make_sstable_containing(env.make_sstable(s), muts).get();
+
+        auto& stats = env.manager().get_cache_tracker().get_data_chunk_cache_stats();
+        auto read_all = [&] {
+            for (const auto& m : muts) {
+                assert_that(sst->make_reader(s, env.make_reader_permit(), dht::partition_range::make_singular(m.decorated_key()), s->full_slice()))
+                    .produces(m)
+                    .produces_end_of_stream();
+            }
+        };
+
+        // Disabled by default.
+        auto hits = stats.page_hits;
+        auto misses = stats.page_misses;
+        auto cached_bytes = stats.cached_bytes;
+        read_all();
+        BOOST_REQUIRE_EQUAL(stats.page_hits, hits);
+        BOOST_REQUIRE_EQUAL(stats.page_misses, misses);
+
+        env.db_config().cache_decompressed_chunks.set(true);
+
+        auto populations = stats.page_populations;
+        read_all();
+        BOOST_REQUIRE_GT(stats.page_populations, populations);
+        BOOST_REQUIRE_GT(stats.cached_bytes, cached_bytes);
+
+        hits = stats.page_hits;
+        misses = stats.page_misses;
+        read_all();
+        BOOST_REQUIRE_GT(stats.page_hits, hits);
+        BOOST_REQUIRE_EQUAL(stats.page_misses, misses);
+
+        sst->drop_caches().get();
+        BOOST_REQUIRE_EQUAL(stats.cached_bytes, cached_bytes);
+    });
+}
+
+SEASTAR_TEST_CASE(test_decompressed_chunk_cache_reversed_and_forwarding_reads) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto rs = s->make_reversed();
+
+        // Partitions spanning a few chunks, so that reversed reads go through
+        // the reversing data source, which reads the partition chunk by chunk.
+        utils::chunked_vector<mutation> muts;
+        for (const auto& pk : tests::generate_partition_keys(10, s)) {
+            mutation m(s, pk);
+            for (int i = 0; i < 20; ++i) {
+                ss.add_row(m, ss.make_ckey(i), make_random_string(1000));
+            }
+            muts.push_back(std::move(m));
+        }
+        auto sst = make_sstable_containing(env.make_sstable(s), muts).get();
+        env.db_config().cache_decompressed_chunks.set(true);
+
+        auto& stats = env.manager().get_cache_tracker().get_data_chunk_cache_stats();
+        auto rev_slice = partition_slice_builder(*rs, rs->full_slice())
+                .with_option<query::partition_slice::option::reversed>()
+                .build();
+        auto read_reversed = [&] (const query::partition_slice& slice) {
+            for (const auto& m : muts) {
+                assert_that(sst->make_reader(rs, env.make_reader_permit(), dht::partition_range::make_singular(m.decorated_key()), slice))
+                    .produces(reverse(m))
+                    .produces_end_of_stream();
+            }
+        };
+        auto read_forwarding = [&] {
+            for (const auto& m : muts) {
+                assert_that(sst->make_reader(s, env.make_reader_permit(), dht::partition_range::make_singular(m.decorated_key()), s->full_slice(),
+                                nullptr, streamed_mutation::forwarding::yes))
+                    .produces_partition_start(m.decorated_key())
+                    .produces_end_of_stream()
+                    .fast_forward_to(position_range(
+                        position_in_partition::for_key(ss.make_ckey(5)),
+                        position_in_partition::for_key(ss.make_ckey(7))))
+                    .produces_row_with_key(ss.make_ckey(5))
+                    .produces_row_with_key(ss.make_ckey(6))
+                    .produces_end_of_stream()
+                    .fast_forward_to(position_range(
+                        position_in_partition::for_key(ss.make_ckey(15)),
+                        position_in_partition::after_all_clustered_rows()))
+                    .produces_row_with_key(ss.make_ckey(15))
+                    .produces_row_with_key(ss.make_ckey(16))
+                    .produces_row_with_key(ss.make_ckey(17))
+                    .produces_row_with_key(ss.make_ckey(18))
+                    .produces_row_with_key(ss.make_ckey(19))
+                    .produces_end_of_stream();
+            }
+        };
+
+        // Reads which bypass the cache don't populate it.
+        auto bypass_slice = partition_slice_builder(*rs, rev_slice)
+                .with_option<query::partition_slice::option::bypass_cache>()
+                .build();
+        auto populations = stats.page_populations;
+        auto hits = stats.page_hits;
+        read_reversed(bypass_slice);
+        BOOST_REQUIRE_EQUAL(stats.page_populations, populations);
+        BOOST_REQUIRE_EQUAL(stats.page_hits, hits);
+
+        read_reversed(rev_slice);
+        BOOST_REQUIRE_GT(stats.page_populations, populations);
+
+        // The reversed reads populated every chunk of the partitions, so both
+        // reversed and fast-forwarding reads are served from the cache.
+        hits = stats.page_hits;
+        auto misses = stats.page_misses;
+        read_reversed(rev_slice);
+        BOOST_REQUIRE_GT(stats.page_hits, hits);
+        BOOST_REQUIRE_EQUAL(stats.page_misses, misses);
+
+        hits = stats.page_hits;
+        read_forwarding();
+        BOOST_REQUIRE_GT(stats.page_hits, hits);
+        BOOST_REQUIRE_EQUAL(stats.page_misses, misses);
+
+        // Fast-forwarding reads populate the cache too.
+        sst->drop_caches().get();
+        populations = stats.page_populations;
+        read_forwarding();
+        BOOST_REQUIRE_GT(stats.page_populations, populations);
+        hits = stats.page_hits;
+        misses = stats.page_misses;
+        read_forwarding();
+        BOOST_REQUIRE_GT(stats.page_hits, hits);
+        BOOST_REQUIRE_EQUAL(stats.page_misses, misses);
+    });
+}
+
+SEASTAR_TEST_CASE(test_compression_sub_chunks) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = schema_builder(ss.schema())
+            .set_compressor_params(compression_parameters({
+                {compression_parameters::SSTABLE_COMPRESSION, "LZ4Compressor"},
+                {compression_parameters::CHUNK_LENGTH_KB, "16"},
+                {compression_parameters::SUB_CHUNK_LENGTH_KB, "4"},
+            }))
+            .build();
+
+        // Partitions of a few KiB, so that reads start and end in the middle of chunks.
+        utils::chunked_vector<mutation> muts;
+        for (const auto& pk : tests::generate_partition_keys(50, s)) {
+            mutation m(s, pk);
+            for (int i = 0; i < 10; ++i) {
+                ss.add_row(m, ss.make_ckey(i), make_random_string(300));
+            }
+            muts.push_back(std::move(m));
+        }
+        auto sst = make_sstable_containing(env.make_sstable(s), muts).get();
+        sst = env.reusable_sst(sst).get();
+
+        const auto& c = sst->get_compression();
+        BOOST_REQUIRE(c.has_sub_chunks());
+        BOOST_REQUIRE_EQUAL(c.uncompressed_sub_chunk_length(), 4096);
+        BOOST_REQUIRE_EQUAL(c.sub_chunk_offsets.size(), (c.uncompressed_file_length() + 4095) / 4096);
+
+        for (const auto& m : muts) {
+            assert_that(sst->make_reader(s, env.make_reader_permit(), dht::partition_range::make_singular(m.decorated_key()), s->full_slice()))
+                .produces(m)
+                .produces_end_of_stream();
+        }
+
+        // Skips within the partitions.
+        auto ranges = query::clustering_row_ranges{query::clustering_range::make_singular(ss.make_ckey(7))};
+        auto slice = partition_slice_builder(*s).with_ranges(ranges).build();
+        for (const auto& m : muts) {
+            assert_that(sst->make_reader(s, env.make_reader_permit(), dht::partition_range::make_singular(m.decorated_key()), slice))
+                .produces(m.sliced(ranges))
+                .produces_end_of_stream();
+        }
+
+        auto rd = assert_that(sst->make_reader(s, env.make_reader_permit(), query::full_partition_range, s->full_slice()));
+        for (const auto& m : muts) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+
+        BOOST_REQUIRE(validate_checksums_and_digests(sst, env.make_reader_permit()).get().status == validate_checksums_status::valid);
+    });
+}
+
+SEASTAR_TEST_CASE(test_adaptive_compression_chunk_length) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        BOOST_REQUIRE(!s->get_compressor_params().has_chunk_length());
+        env.db_config().sstable_compression_adaptive_chunk_length.set(true);
+
+        auto write_and_check = [&] (int rows_per_partition, size_t row_size) {
+            utils::chunked_vector<mutation> muts;
+            for (const auto& pk : tests::generate_partition_keys(20, s)) {
+                mutation m(s, pk);
+                for (int i = 0; i < rows_per_partition; ++i) {
+                    ss.add_row(m, ss.make_ckey(i), make_random_string(row_size));
+                }
+                muts.push_back(std::move(m));
+            }
+            auto sst = make_sstable_containing(env.make_sstable(s), muts).get();
+            sst = env.reusable_sst(sst).get();
+            auto rd = assert_that(sst->make_reader(s, env.make_reader_permit(), query::full_partition_range, s->full_slice()));
+            for (const auto& m : muts) {
+                rd.produces(m);
+            }
+            rd.produces_end_of_stream();
+            return sst->get_compression().uncompressed_chunk_length();
+        };
+
+        // Small partitions get the smallest chunks.
+        BOOST_REQUIRE_EQUAL(write_and_check(1, 100), 4 * 1024);
+        // Partitions larger than the first chunks get the largest ones.
+        BOOST_REQUIRE_EQUAL(write_and_check(10, 10 * 1024), max_adaptive_chunk_length);
+        // And the ones in between, the size of the partitions.
+        BOOST_REQUIRE_EQUAL(write_and_check(3, 4 * 1024), 16 * 1024);
+    });
+}
+
+SEASTAR_TEST_CASE(test_sstable_repair_summary) {
+    return test_env::do_with_async([] (test_env& env) {
+        namespace rs = sstables::repair_summary;
+        simple_schema ss;
+        auto s = ss.schema();
+        env.db_config().sstable_repair_summaries.set(true);
+
+        utils::chunked_vector<mutation> muts;
+        for (const auto& pk : tests::generate_partition_keys(20, s)) {
+            mutation m(s, pk);
+            ss.add_row(m, ss.make_ckey(0), "v");
+            muts.push_back(std::move(m));
+        }
+        auto write = [&] (const utils::chunked_vector<mutation>& muts) {
+            auto sst = make_sstable_containing(env.make_sstable(s), muts).get();
+            sst = env.reusable_sst(sst).get();
+            auto* summary = sst->get_scylla_metadata()->get_repair_summary();
+            BOOST_REQUIRE(summary);
+            BOOST_REQUIRE_EQUAL(summary->sub_range_bits, rs::sub_range_bits);
+            return std::make_pair(sst, summary->entries.elements);
+        };
+        auto [sst1, entries1] = write(muts);
+        auto [sst2, entries2] = write(muts);
+
+        // One entry per sub-range with data, in order.
+        BOOST_REQUIRE(std::ranges::adjacent_find(entries1, std::greater_equal<>(), &sstables::repair_summary_entry::sub_range) == entries1.end());
+        for (const auto& m : muts) {
+            BOOST_REQUIRE(std::ranges::contains(entries1, rs::sub_range_of(m.token()), &sstables::repair_summary_entry::sub_range));
+        }
+        // The same data has the same hashes.
+        BOOST_REQUIRE_EQUAL(entries1.size(), entries2.size());
+        for (size_t i = 0; i < entries1.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(entries1[i].sub_range, entries2[i].sub_range);
+            BOOST_REQUIRE_EQUAL(entries1[i].hash, entries2[i].hash);
+        }
+
+        // Changing a row changes only the hash of its sub-range.
+        auto changed = muts;
+        ss.add_row(changed[0], ss.make_ckey(0), "w");
+        auto changed_sub_range = rs::sub_range_of(changed[0].token());
+        auto [sst3, entries3] = write(changed);
+        BOOST_REQUIRE_EQUAL(entries1.size(), entries3.size());
+        for (size_t i = 0; i < entries1.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(entries1[i].sub_range, entries3[i].sub_range);
+            BOOST_REQUIRE_EQUAL(entries1[i].hash != entries3[i].hash, entries1[i].sub_range == changed_sub_range);
+        }
+
+        // The hashes of a single sstable are the ones of its summary.
+        constexpr uint32_t nr_sub_ranges = 1u << rs::sub_range_bits;
+        auto all = std::pair<uint32_t, uint32_t>(0, nr_sub_ranges - 1);
+        auto hashes = rs::collect_hashes({sst1}, all);
+        BOOST_REQUIRE_EQUAL(hashes.size(), nr_sub_ranges);
+        auto entry = entries1.begin();
+        for (uint32_t i = 0; i < nr_sub_ranges; ++i) {
+            if (entry != entries1.end() && entry->sub_range == i) {
+                BOOST_REQUIRE(hashes[i] == entry->hash);
+                ++entry;
+            } else {
+                BOOST_REQUIRE(hashes[i] == rs::no_data_hash);
+            }
+        }
+        auto one = rs::collect_hashes({sst1}, {changed_sub_range, changed_sub_range});
+        BOOST_REQUIRE_EQUAL(one.size(), 1);
+        BOOST_REQUIRE(one[0] == hashes[changed_sub_range]);
+
+        // The hashes only describe sub-ranges with data in a single sstable, the
+        // other sub-ranges keep their hashes.
+        auto [sst4, entries4] = write({changed[0]});
+        auto both = rs::collect_hashes({sst1, sst4}, all);
+        for (uint32_t i = 0; i < nr_sub_ranges; ++i) {
+            BOOST_REQUIRE(i == changed_sub_range ? !both[i] : both[i] == hashes[i]);
+        }
+        // Likewise for sstables of different shards.
+        auto merged = rs::collect_hashes({sst1}, all);
+        rs::merge(merged, rs::collect_hashes({sst4}, all));
+        BOOST_REQUIRE(merged == both);
+        // And for the sub-ranges spanned by an sstable without a summary.
+        env.db_config().sstable_repair_summaries.set(false);
+        auto sst5 = env.reusable_sst(make_sstable_containing(env.make_sstable(s), {changed[0]}).get()).get();
+        BOOST_REQUIRE(!sst5->get_scylla_metadata()->get_repair_summary());
+        BOOST_REQUIRE(rs::collect_hashes({sst1, sst5}, all) == both);
+
+        // Tablet ranges are aligned with the sub-ranges.
+        constexpr unsigned log2_tablets = 4;
+        constexpr uint32_t sub_ranges_per_tablet = 1u << (rs::sub_range_bits - log2_tablets);
+        for (size_t i = 0; i < (1u << log2_tablets); ++i) {
+            auto start = i ? dht::last_token_of_compaction_group(log2_tablets, i - 1) : dht::minimum_token();
+            auto range = dht::token_range::make({start, false}, {dht::last_token_of_compaction_group(log2_tablets, i), true});
+            auto sub_ranges = rs::aligned_sub_ranges(range);
+            BOOST_REQUIRE(sub_ranges);
+            BOOST_REQUIRE_EQUAL(sub_ranges->first, i * sub_ranges_per_tablet);
+            BOOST_REQUIRE_EQUAL(sub_ranges->second, (i + 1) * sub_ranges_per_tablet - 1);
+            // Parts of the range made of whole sub-ranges are aligned too.
+            auto part = std::pair(sub_ranges->first + 1, sub_ranges->second - 1);
+            BOOST_REQUIRE(rs::aligned_sub_ranges(rs::token_range_of(part)) == part);
+        }
+        BOOST_REQUIRE(rs::aligned_sub_ranges(rs::token_range_of(all)) == all);
+        BOOST_REQUIRE(rs::aligned_sub_ranges(dht::token_range::make_open_ended_both_sides()));
+        BOOST_REQUIRE(!rs::aligned_sub_ranges(dht::token_range::make({dht::token::from_int64(0), false}, {dht::token::from_int64(100), true})));
+    });
+}
+
+SEASTAR_TEST_CASE(test_sstable_value_log) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("ks", "cf")
+                .with_column("pk", utf8_type, column_kind::partition_key)
+                .with_column("v", bytes_type)
+                .with_value_log_options(db::value_log_options({{"enabled", "true"}, {"min_value_size_in_kb", "1"}}))
+                .build();
+        auto& v = *s->get_column_definition("v");
+        auto ts = api::new_timestamp();
+
+        auto large = tests::random::get_bytes(2048);
+        auto small = tests::random::get_bytes(16);
+
+        // A small value which starts with the magic bytes is escaped in the data file.
+        auto magic = bytes(reinterpret_cast<const int8_t*>(sstables::value_log::magic.data()), sstables::value_log::magic.size()) + small;
+
+        utils::chunked_vector<mutation> muts;
+        auto pks = tests::generate_partition_keys(3, s);
+        for (auto&& [pk, value] : std::views::zip(pks, std::array{large, small, magic})) {
+            mutation m(s, pk);
+            m.set_clustered_cell(clustering_key::make_empty(), v, atomic_cell::make_live(*bytes_type, ts, value));
+            muts.push_back(std::move(m));
+        }
+
+        auto sst = make_sstable_containing(env.make_sstable(s), muts).get();
+        sst = env.reusable_sst(sst).get();
+
+        // Only the large value is written to the value file, followed by its checksum.
+        auto* vlog = sst->get_value_log();
+        BOOST_REQUIRE(vlog);
+        BOOST_REQUIRE_EQUAL(vlog->files.elements.size(), 1);
+        auto& vf = vlog->files.elements.front();
+        BOOST_REQUIRE_EQUAL(vf.size, large.size() + sstables::value_log::checksum_size);
+        BOOST_REQUIRE_EQUAL(vf.referenced_bytes, vf.size);
+        BOOST_REQUIRE(file_exists(sst->value_file_name(vf.id)).get());
+
+        // The values are resolved when read.
+        auto rd = assert_that(sstable_mutation_reader(sst, s, env.make_reader_permit()));
+        for (const auto& m : muts) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+    });
+}
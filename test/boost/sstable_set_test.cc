@@ -11,6 +11,7 @@
 #include <seastar/testing/test_case.hh>
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/loop.hh>
+#include <seastar/core/thread.hh>
 
 #include <fmt/ranges.h>
 #include "db/config.hh"
@@ -581,4 +582,143 @@ SEASTAR_TEST_CASE(test_tablet_sstable_set_preserves_arbitrary_boundaries) {
     }, std::move(cfg));
 }
 
+SEASTAR_TEST_CASE(test_partitioned_sstable_set_combined_filter) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto pks = ss.make_pkeys(202);
+        auto absent_pks = ss.make_pkeys(1000);
+        constexpr size_t nr_sstables = 10;
+        constexpr size_t keys_per_sstable = 20;
+
+        env.manager().set_blocked_bloom_filter(true);
+        env.db_config().sstable_set_combined_filter.set(true);
+
+        // Each sstable also contains the first and the last key, so that all of them
+        // span the token range of the set, and are stored as unleveled.
+        auto token_range = dht::token_range::make(pks.front().token(), pks.back().token());
+        std::unordered_map<const sstable*, size_t> sstable_index;
+        std::vector<shared_sstable> ssts;
+        for (size_t i = 0; i < nr_sstables; ++i) {
+            utils::chunked_vector<mutation> muts;
+            auto add = [&] (const dht::decorated_key& pk) {
+                muts.emplace_back(s, pk);
+                ss.add_row(muts.back(), ss.make_ckey(0), "val");
+            };
+            add(pks.front());
+            for (size_t j = 1 + i * keys_per_sstable; j < 1 + (i + 1) * keys_per_sstable; ++j) {
+                add(pks[j]);
+            }
+            add(pks.back());
+            auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations(s, env.make_reader_permit(), std::move(muts)),
+                    env.manager().configure_writer(), sstable_version_types::me, keys_per_sstable + 2);
+            sstable_index.emplace(sst.get(), i);
+            ssts.push_back(std::move(sst));
+        }
+
+        auto memory_size_before = combined_filter::get_shard_stats().memory_size;
+        auto set = std::make_unique<partitioned_sstable_set>(s, token_range);
+        for (auto& sst : ssts) {
+            set->insert(sst);
+        }
+
+        auto select_by_key = [&] (const sstable_set_impl& set, const dht::decorated_key& pk) {
+            return set.select_by_key(dht::partition_range::make_singular(pk), sstable::make_hashed_key(*s, pk.key()));
+        };
+        auto require_selected = [&] (const std::vector<shared_sstable>& selected, const dht::decorated_key& pk, const shared_sstable& sst) {
+            BOOST_REQUIRE_MESSAGE(std::ranges::find(selected, sst) != selected.end(),
+                    fmt::format("sstable {} wasn't selected for key {}", sstable_index[sst.get()], pk));
+        };
+
+        // The sets don't miss any sstable containing the key.
+        auto check_no_false_negatives = [&] (const sstable_set_impl& set, const std::vector<shared_sstable>& ssts) {
+            for (auto& sst : ssts) {
+                auto i = sstable_index[sst.get()];
+                for (size_t j = 1 + i * keys_per_sstable; j < 1 + (i + 1) * keys_per_sstable; ++j) {
+                    require_selected(select_by_key(set, pks[j]), pks[j], sst);
+                }
+            }
+            for (auto& pk : {pks.front(), pks.back()}) {
+                auto selected = select_by_key(set, pk);
+                for (auto& sst : ssts) {
+                    require_selected(selected, pk, sst);
+                }
+            }
+        };
+        // The filters are folded in the background, after the first single-key read.
+        auto wait_for_folding = [] {
+            while (combined_filter::get_shard_stats().sstables_pending) {
+                seastar::thread::yield();
+            }
+        };
+        check_no_false_negatives(*set, ssts);
+        BOOST_REQUIRE_GT(combined_filter::get_shard_stats().sstables_pending, 0);
+        wait_for_folding();
+        check_no_false_negatives(*set, ssts);
+        // The sstables have filters of the same size, and the pages hold just them.
+        auto folded_filter_size = combined_filter::get_shard_stats().memory_size - memory_size_before;
+        BOOST_REQUIRE_EQUAL(folded_filter_size % nr_sstables, 0);
+        folded_filter_size /= nr_sstables;
+        BOOST_REQUIRE_GT(folded_filter_size, 0);
+        BOOST_REQUIRE_LE(folded_filter_size, ssts.front()->filter_memory_size());
+
+        // Most sstables are skipped for keys which aren't in the set.
+        auto lookups_before = combined_filter::get_shard_stats().lookups;
+        auto skipped_before = combined_filter::get_shard_stats().sstables_skipped;
+        size_t selected = 0;
+        for (auto& pk : absent_pks) {
+            selected += select_by_key(*set, pk).size();
+        }
+        testlog.info("selected {} sstables for {} absent keys", selected, absent_pks.size());
+        BOOST_REQUIRE_LT(selected, absent_pks.size() * nr_sstables / 10);
+        BOOST_REQUIRE_EQUAL(combined_filter::get_shard_stats().lookups - lookups_before, absent_pks.size());
+        BOOST_REQUIRE_EQUAL(combined_filter::get_shard_stats().sstables_skipped - skipped_before, absent_pks.size() * nr_sstables - selected);
+
+        // An sstable whose filter is reclaimed isn't skipped anymore, and its
+        // folded filter is dropped, until its filter is reloaded.
+        auto count_selected = [&] (const sstable_set_impl& set, const shared_sstable& sst) {
+            return std::ranges::count_if(absent_pks, [&] (const dht::decorated_key& pk) {
+                auto selected = select_by_key(set, pk);
+                return std::ranges::find(selected, sst) != selected.end();
+            });
+        };
+        // Pages are rebuilt without the removed sstables in the background.
+        auto wait_for_folded_filters = [&] (size_t n) {
+            wait_for_folding();
+            while (combined_filter::get_shard_stats().memory_size - memory_size_before != n * folded_filter_size) {
+                seastar::thread::yield();
+            }
+        };
+        auto& reclaimed = ssts.back();
+        sstables::test(reclaimed).reclaim_memory_from_components();
+        BOOST_REQUIRE_EQUAL(count_selected(*set, reclaimed), absent_pks.size());
+        wait_for_folded_filters(nr_sstables - 1);
+        check_no_false_negatives(*set, ssts);
+        sstables::test(reclaimed).reload_reclaimed_components();
+        wait_for_folded_filters(nr_sstables);
+        BOOST_REQUIRE_LT(count_selected(*set, reclaimed), absent_pks.size() / 10);
+
+        // Clones share the filter, and keep it up to date.
+        auto clone = set->clone();
+        clone->erase(ssts.front());
+        check_no_false_negatives(*set, ssts);
+        check_no_false_negatives(*clone, std::vector<shared_sstable>(ssts.begin() + 1, ssts.end()));
+
+        // Removing an sstable from the last set shrinks its page.
+        set.reset();
+        check_no_false_negatives(*clone, std::vector<shared_sstable>(ssts.begin() + 1, ssts.end()));
+        wait_for_folded_filters(nr_sstables - 1);
+        check_no_false_negatives(*clone, std::vector<shared_sstable>(ssts.begin() + 1, ssts.end()));
+
+        // Disabling the combined filter makes reads select all the sstables again,
+        // and drops the filter along with the sets using it.
+        env.db_config().sstable_set_combined_filter.set(false);
+        BOOST_REQUIRE_EQUAL(select_by_key(*clone, absent_pks.front()).size(), nr_sstables - 1);
+        auto clone2 = clone->clone();
+        clone.reset();
+        BOOST_REQUIRE_EQUAL(combined_filter::get_shard_stats().memory_size, memory_size_before);
+        BOOST_REQUIRE_EQUAL(select_by_key(*clone2, absent_pks.front()).size(), nr_sstables - 1);
+    });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
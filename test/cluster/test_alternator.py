@@ -1280,6 +1280,159 @@ async def test_alternator_concurrent_rmw_same_partition_different_server(manager
         table.delete()
 
 
+async def test_alternator_strongly_consistent_rmw(manager: ManagerClient):
+    """Writes to a table in a strongly consistent keyspace are done by the
+       tablet's Raft group, without LWT. Check that concurrent read-modify-write
+       updates of the same item are isolated, and that conditions are checked.
+       On a single node, every request reaches the Raft leader.
+    """
+    config = alternator_config | {'experimental_features': ['strongly-consistent-tables']}
+    server = await manager.server_add(config=config)
+    cql = manager.get_cql()
+    alternator = get_alternator(server.ip_addr)
+    name = unique_table_name()
+    await cql.run_async(f"CREATE KEYSPACE \"alternator_{name}\" WITH replication = "
+        "{'class': 'NetworkTopologyStrategy', 'replication_factor': 1} "
+        "AND tablets = {'initial': 1} AND consistency = 'global'")
+    table = alternator.create_table(TableName=name,
+        BillingMode='PAY_PER_REQUEST',
+        KeySchema=[{'AttributeName': 'p', 'KeyType': 'HASH' }],
+        AttributeDefinitions=[{'AttributeName': 'p', 'AttributeType': 'N' }])
+    try:
+        table.put_item(Item={'p': 1, 'v': 'a'}, ConditionExpression='attribute_not_exists(p)')
+        with pytest.raises(ClientError, match='ConditionalCheckFailedException'):
+            table.put_item(Item={'p': 1, 'v': 'b'}, ConditionExpression='attribute_not_exists(p)')
+        assert table.get_item(Key={'p': 1}, ConsistentRead=True)['Item'] == {'p': 1, 'v': 'a'}
+
+        nthreads = 4
+        nincrements = 20
+        def run_rmw(i):
+            tbl = get_alternator(server.ip_addr).Table(name)
+            for n in range(nincrements):
+                tbl.update_item(Key={'p': 2},
+                    UpdateExpression='SET v = if_not_exists(v, :init) + :incr',
+                    ExpressionAttributeValues={':init': 0, ':incr': 1})
+        threads = [ThreadWrapper(target=run_rmw, args=(i,)) for i in range(nthreads)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert table.get_item(Key={'p': 2}, ConsistentRead=True)['Item'] == {'p': 2, 'v': nthreads * nincrements}
+
+        metrics = await manager.metrics.query(server.ip_addr)
+        assert metrics.get('scylla_alternator_write_using_raft')
+        assert not metrics.get('scylla_alternator_write_using_lwt')
+    finally:
+        table.delete()
+
+async def test_alternator_strongly_consistent_rmw_on_non_leader(manager: ManagerClient):
+    """A write to a strongly consistent table which reaches a node that isn't
+       the leader of the item's tablet is forwarded to the leader, instead of
+       falling back to LWT, which would bypass the Raft group. Check that
+       concurrent conditional writes sent to every node are isolated, and that
+       the items of a BatchWriteItem sent to every node are written.
+    """
+    config = alternator_config | {'experimental_features': ['strongly-consistent-tables']}
+    servers = await manager.servers_add(3, config=config, auto_rack_dc='dc1')
+    cql = manager.get_cql()
+    name = unique_table_name()
+    await cql.run_async(f"CREATE KEYSPACE \"alternator_{name}\" WITH replication = "
+        "{'class': 'NetworkTopologyStrategy', 'replication_factor': 3} "
+        "AND tablets = {'initial': 1} AND consistency = 'global'")
+    table = get_alternator(servers[0].ip_addr).create_table(TableName=name,
+        BillingMode='PAY_PER_REQUEST',
+        KeySchema=[{'AttributeName': 'p', 'KeyType': 'HASH' }],
+        AttributeDefinitions=[{'AttributeName': 'p', 'AttributeType': 'N' }])
+    try:
+        table.put_item(Item={'p': 1, 'v': 0})
+
+        nincrements = 10
+        def run_cas(server):
+            tbl = get_alternator(server.ip_addr).Table(name)
+            done = 0
+            while done < nincrements:
+                old = tbl.get_item(Key={'p': 1}, ConsistentRead=True)['Item']['v']
+                try:
+                    tbl.update_item(Key={'p': 1},
+                        UpdateExpression='SET v = :new',
+                        ConditionExpression='v = :old',
+                        ExpressionAttributeValues={':old': old, ':new': old + 1})
+                    done += 1
+                except ClientError as e:
+                    assert 'ConditionalCheckFailedException' in str(e)
+        threads = [ThreadWrapper(target=run_cas, args=(s,)) for s in servers]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        # Every increment which succeeded was applied exactly once.
+        assert table.get_item(Key={'p': 1}, ConsistentRead=True)['Item'] == {'p': 1, 'v': len(servers) * nincrements}
+
+        for i, s in enumerate(servers):
+            with get_alternator(s.ip_addr).Table(name).batch_writer() as batch:
+                for p in range(10):
+                    batch.put_item(Item={'p': 100 * (i + 1) + p, 'v': i})
+        for i in range(len(servers)):
+            for p in range(10):
+                assert table.get_item(Key={'p': 100 * (i + 1) + p}, ConsistentRead=True)['Item'] == {'p': 100 * (i + 1) + p, 'v': i}
+
+        # The writes were sent to every node, so the ones sent to the nodes
+        # which don't lead the tablet's Raft group were forwarded.
+        node_bounces = 0
+        for s in servers:
+            metrics = await manager.metrics.query(s.ip_addr)
+            assert not metrics.get('scylla_alternator_write_using_lwt')
+            node_bounces += metrics.get('scylla_alternator_node_bounce_for_raft') or 0
+        assert node_bounces > 0
+    finally:
+        table.delete()
+
+@pytest.mark.skip_mode(mode='release', reason='error injections are not supported in release mode')
+async def test_batch_get_item_replicas_disagree(manager: ManagerClient):
+    """BatchGetItem reads the items of a table with one request per replica,
+       taking the data of each item from one replica and its digest from the
+       others. Check that only the items whose replicas disagree are read
+       again on their own, which repairs them.
+    """
+    config = alternator_config | {'hinted_handoff_enabled': False}
+    servers = await manager.servers_add(3, config=config, auto_rack_dc='dc1')
+    table = get_alternator(servers[0].ip_addr).create_table(TableName=unique_table_name(),
+        BillingMode='PAY_PER_REQUEST',
+        KeySchema=[{'AttributeName': 'p', 'KeyType': 'HASH' }],
+        AttributeDefinitions=[{'AttributeName': 'p', 'AttributeType': 'N' }])
+    try:
+        # Read each item from exactly the two closest replicas.
+        await manager.get_cql().run_async(f'ALTER TABLE "alternator_{table.name}"."{table.name}" WITH speculative_retry = \'NONE\'')
+        nitems = 20
+        with table.batch_writer() as batch:
+            for p in range(nitems):
+                batch.put_item(Item={'p': p, 'v': 'old'})
+        # The last node misses the updates of the even items.
+        stale = servers[2]
+        await manager.api.enable_injection(stale.ip_addr, "database_apply", False,
+            parameters={"ks_name": f"alternator_{table.name}", "cf_name": table.name, "what": "throw"})
+        for p in range(0, nitems, 2):
+            table.put_item(Item={'p': p, 'v': 'new'})
+        await manager.api.disable_injection(stale.ip_addr, "database_apply")
+
+        # The stale node coordinates the reads, so it sends the data of the items.
+        alternator = get_alternator(stale.ip_addr)
+        async def batch_get_and_count_fallbacks():
+            metrics = await manager.metrics.query(stale.ip_addr)
+            before = metrics.get('scylla_storage_proxy_coordinator_multi_partition_read_fallbacks') or 0
+            items = alternator.batch_get_item(RequestItems={table.name: {
+                'Keys': [{'p': p} for p in range(nitems)], 'ConsistentRead': True}})['Responses'][table.name]
+            assert sorted(items, key=lambda item: item['p']) == [
+                {'p': p, 'v': 'new' if p % 2 == 0 else 'old'} for p in range(nitems)]
+            metrics = await manager.metrics.query(stale.ip_addr)
+            return (metrics.get('scylla_storage_proxy_coordinator_multi_partition_read_fallbacks') or 0) - before
+
+        assert await batch_get_and_count_fallbacks() == nitems // 2
+        # The fallback reads repaired the items.
+        assert await batch_get_and_count_fallbacks() == 0
+    finally:
+        table.delete()
+
 @pytest.mark.skip_mode(mode='release', reason='error injections are not supported in release mode')
 async def test_alternator_invalid_shard_for_lwt(manager: ManagerClient):
     """
@@ -12,6 +12,7 @@ from test.pylib.manager_client import ManagerClient
 from test.cluster.util import new_test_keyspace
 from cassandra import WriteFailure, WriteTimeout
 from cassandra.protocol import ConfigurationException, ServerError
+from cassandra.query import SimpleStatement
 import pytest
 import logging
 from test.pylib.tablets import get_tablet_count, get_tablet_replica
@@ -656,6 +657,170 @@ async def test_compaction(manager: ManagerClient):
             await manager.api.logstor_compaction(servers[0].ip_addr)
         await wait_for(segments_compacted, time.time() + 60)
 
+async def test_compaction_separates_cold_records(manager: ManagerClient):
+    """
+    Test that compaction rewrites records of segments written longer than
+    logstor_compaction_cold_data_age_in_s ago into cold segments.
+    """
+    cmdline = ['--logger-log-level', 'logstor=trace', '--smp=1']
+    cfg = {'experimental_features': ['logstor'], 'logstor_compaction_cold_data_age_in_s': 1}
+    servers = await manager.servers_add(1, cmdline=cmdline, config=cfg)
+    cql = manager.get_cql()
+
+    async with new_test_keyspace(manager, "WITH tablets={'initial':1}") as ks:
+        await cql.run_async(f"CREATE TABLE {ks}.test (pk int PRIMARY KEY, v text) WITH storage_engine = 'logstor'")
+
+        # a few records fit in each segment
+        value = 'x' * (30 * 1024)
+        for i in range(20):
+            await cql.run_async(f"INSERT INTO {ks}.test (pk, v) VALUES ({i}, '{value}')")
+        await manager.api.logstor_flush(servers[0].ip_addr)
+
+        # let the segments become cold
+        await asyncio.sleep(2)
+
+        # overwrite half of the keys so that every cold segment has dead data
+        for i in range(0, 20, 2):
+            await cql.run_async(f"INSERT INTO {ks}.test (pk, v) VALUES ({i}, '{value}')")
+        await manager.api.logstor_flush(servers[0].ip_addr)
+
+        await manager.api.logstor_compaction(servers[0].ip_addr)
+
+        async def cold_records_rewritten():
+            metrics = await manager.metrics.query(servers[0].ip_addr)
+            records_rewritten = metrics.get("scylla_logstor_sm_compaction_records_rewritten") or 0
+            cold_records_rewritten = metrics.get("scylla_logstor_sm_compaction_cold_records_rewritten") or 0
+            if cold_records_rewritten > 0:
+                # only the surviving records of the cold segments are cold
+                assert cold_records_rewritten <= 10
+                assert cold_records_rewritten <= records_rewritten
+                return True
+            await manager.api.logstor_compaction(servers[0].ip_addr)
+        await wait_for(cold_records_rewritten, time.time() + 60)
+
+        rows = await cql.run_async(f"SELECT pk FROM {ks}.test")
+        assert sorted(row.pk for row in rows) == list(range(20))
+
+async def test_range_scan(manager: ManagerClient):
+    """
+    Test range scans, which read the records in batches of keys with coalesced
+    disk reads and read-ahead, against the written data: full scans spanning
+    several batches, token range scans, paged scans and scans after overwrites
+    and deletions, with and without the cache.
+    """
+    cmdline = ['--logger-log-level', 'logstor=debug', '--smp=1']
+    cfg = {'experimental_features': ['logstor']}
+    servers = await manager.servers_add(1, cmdline=cmdline, config=cfg)
+    cql = manager.get_cql()
+
+    async with new_test_keyspace(manager, "WITH tablets={'initial':1}") as ks:
+        await cql.run_async(f"CREATE TABLE {ks}.test (pk int PRIMARY KEY, v text) WITH storage_engine = 'logstor'")
+
+        # more keys than in a batch, and larger records than in a coalesced read
+        expected = {}
+        for i in range(1000):
+            expected[i] = f"{i}-" + 'x' * (i % 7 * 1000)
+        insert = cql.prepare(f"INSERT INTO {ks}.test (pk, v) VALUES (?, ?)")
+        await asyncio.gather(*[cql.run_async(insert, [k, v]) for k, v in expected.items()])
+        await manager.api.logstor_flush(servers[0].ip_addr)
+
+        async def check_scans():
+            for bypass_cache in ["", " BYPASS CACHE"]:
+                rows = await cql.run_async(f"SELECT pk, v FROM {ks}.test{bypass_cache}")
+                assert {row.pk: row.v for row in rows} == expected
+
+                # scans of token ranges start and stop in the middle of batches
+                rows = await cql.run_async(f"SELECT pk, token(pk) AS t FROM {ks}.test{bypass_cache}")
+                tokens = {row.pk: row.t for row in rows}
+                lo, hi = sorted(tokens.values())[100], sorted(tokens.values())[600]
+                rows = await cql.run_async(f"SELECT pk, v FROM {ks}.test WHERE token(pk) > {lo} AND token(pk) <= {hi}{bypass_cache}")
+                assert {row.pk: row.v for row in rows} == {k: v for k, v in expected.items() if lo < tokens[k] <= hi}
+
+                # paging resumes the scan in the middle of batches
+                stmt = SimpleStatement(f"SELECT pk, v FROM {ks}.test{bypass_cache}", fetch_size=37)
+                rows = await cql.run_async(stmt, all_pages=True)
+                assert {row.pk: row.v for row in rows} == expected
+
+        await check_scans()
+
+        metrics = await manager.metrics.query(servers[0].ip_addr)
+        assert (metrics.get("scylla_logstor_sm_coalesced_records_read") or 0) > (metrics.get("scylla_logstor_sm_coalesced_reads") or 0)
+
+        # overwrite and delete some keys, so that the scans skip dead records
+        for i in range(0, 1000, 3):
+            expected[i] = f"{i}-new"
+            await cql.run_async(insert, [i, expected[i]])
+        for i in range(1, 1000, 5):
+            del expected[i]
+            await cql.run_async(f"DELETE FROM {ks}.test WHERE pk = {i}")
+        await manager.api.logstor_flush(servers[0].ip_addr)
+
+        await check_scans()
+
+def crc32c(data: bytes) -> int:
+    crc = 0
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = (crc >> 1) ^ (0x82F63B78 if crc & 1 else 0)
+    return crc
+
+async def test_snapshot_and_restore(manager: ManagerClient):
+    """
+    Test that a snapshot of a logstor table has its segments and the compression
+    dictionaries of the node, and that loading them from the upload directory
+    restores the data and the dictionaries after the logstor data was lost.
+    """
+    cmdline = ['--logger-log-level', 'logstor=debug', '--smp=1']
+    cfg = {'experimental_features': ['logstor']}
+    servers = await manager.servers_add(1, cmdline=cmdline, config=cfg)
+    server = servers[0]
+    cql = manager.get_cql()
+    workdir = Path(await manager.server_get_workdir(server.server_id))
+    logstor_dir = workdir / "logstor"
+
+    async with new_test_keyspace(manager, "WITH tablets={'initial':1}") as ks:
+        await cql.run_async(f"CREATE TABLE {ks}.test (pk int PRIMARY KEY, v text) WITH storage_engine = 'logstor'")
+
+        expected = {pk: f"value_{pk}_" + 'x' * 1000 for pk in range(200)}
+        await asyncio.gather(*[cql.run_async(f"INSERT INTO {ks}.test (pk, v) VALUES ({pk}, '{v}')") for pk, v in expected.items()])
+        await manager.api.logstor_flush(server.ip_addr)
+
+        # A dictionary is persisted under the name derived from its content,
+        # and is loaded on start.
+        dictionary = b"logstor dictionary " * 64
+        dictionary_name = f"ls_dict-{max(crc32c(dictionary), 1):08x}.zstd"
+        await manager.server_stop_gracefully(server.server_id)
+        (logstor_dir / dictionary_name).write_bytes(dictionary)
+        await manager.server_start(server.server_id)
+        cql, _ = await manager.get_ready_cql(servers)
+
+        await manager.api.take_snapshot(server.ip_addr, ks, "snap", ["test"])
+        table_dir = next((workdir / "data" / ks).glob("test-*"))
+        snapshot_dir = table_dir / "snapshots" / "snap"
+        snapshot_segments = list(snapshot_dir.glob("logstor_segment_*"))
+        assert snapshot_segments, "no logstor segments in the snapshot"
+        assert (snapshot_dir / dictionary_name).read_bytes() == dictionary
+
+        # Lose the logstor data, including the dictionary.
+        await manager.server_stop_gracefully(server.server_id)
+        for f in logstor_dir.glob("ls_*"):
+            f.unlink()
+        await manager.server_start(server.server_id)
+        cql, _ = await manager.get_ready_cql(servers)
+        assert not await cql.run_async(f"SELECT pk FROM {ks}.test")
+        assert not (logstor_dir / dictionary_name).exists()
+
+        upload_dir = table_dir / "upload"
+        for f in snapshot_segments + [snapshot_dir / dictionary_name]:
+            (upload_dir / f.name).write_bytes(f.read_bytes())
+        await manager.api.load_new_sstables(server.ip_addr, ks, "test")
+
+        rows = await cql.run_async(f"SELECT pk, v FROM {ks}.test")
+        assert {row.pk: row.v for row in rows} == expected
+        assert (logstor_dir / dictionary_name).read_bytes() == dictionary
+        assert not list(upload_dir.iterdir()), "the loaded files were not removed from the upload directory"
+
 async def test_drop_table(manager: ManagerClient):
     """
     Test that DROP TABLE works properly with logstor tables.
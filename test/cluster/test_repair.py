@@ -446,3 +446,49 @@ async def test_repair_rejects_equal_start_and_end_token(manager):
     with pytest.raises(HTTPError, match="Start and end tokens must be different"):
         await manager.api.client.post_json(f"/storage_service/repair_async/ks",
                                            host=servers[0].ip_addr, params=params)
+
+
+@pytest.mark.skip_mode(mode='release', reason='error injections are not supported in release mode')
+async def test_repair_skips_sub_ranges_with_identical_repair_summaries(manager):
+    """Verify that repair compares the repair summaries of the sstables of the
+    replicas with the repair_get_range_summary verb, and only syncs the
+    sub-ranges whose hashes differ.
+    """
+    config = {"sstable_repair_summaries": True}
+    cmdline = ["--smp", "1", "--hinted-handoff-enabled", "0"]
+    nodes = await manager.servers_add(2, config=config, cmdline=cmdline, auto_rack_dc="dc1")
+    node1, node2 = nodes
+
+    cql = manager.get_cql()
+    host1, host2 = await wait_for_cql_and_get_hosts(cql, nodes, time.time() + 30)
+
+    cql.execute("CREATE KEYSPACE ks WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 2} AND TABLETS = {'initial': 4}")
+    cql.execute("CREATE TABLE ks.tbl (pk int PRIMARY KEY, v int)")
+
+    for pk in range(100):
+        cql.execute(SimpleStatement(f"INSERT INTO ks.tbl (pk, v) VALUES ({pk}, {pk})", consistency_level=ConsistencyLevel.ALL))
+
+    # A row which only node1 has.
+    await manager.api.enable_injection(node2.ip_addr, "database_apply", False, parameters={"ks_name": "ks", "cf_name": "tbl", "what": "throw"})
+    cql.execute(SimpleStatement("INSERT INTO ks.tbl (pk, v) VALUES (1000, 1000)", consistency_level=ConsistencyLevel.ONE), host=host1)
+    await manager.api.disable_injection(node2.ip_addr, "database_apply")
+
+    # Leave a single sstable per sub-range and no data in memtables.
+    for node in nodes:
+        await manager.api.keyspace_flush(node.ip_addr, "ks")
+        await manager.api.keyspace_compaction(node.ip_addr, "ks")
+
+    async def skipped_sub_ranges():
+        total = 0
+        for node in nodes:
+            metrics = await manager.metrics.query(node.ip_addr)
+            total += metrics.get("scylla_repair_summary_skipped_sub_ranges") or 0
+        return total
+
+    before = await skipped_sub_ranges()
+    await manager.api.tablet_repair(node1.ip_addr, "ks", "tbl", "all", incremental_mode="disabled")
+    # All the sub-ranges of the 4 tablets are identical but the one of the row.
+    assert await skipped_sub_ranges() - before == (1 << 12) - 1
+
+    rows = list(cql.execute("SELECT * FROM MUTATION_FRAGMENTS(ks.tbl) WHERE pk = 1000", host=host2))
+    assert rows, "the differing sub-range was not repaired"
@@ -14,6 +14,7 @@ import pytest
 import re
 from test.pylib.skip_types import skip_env
 from .util import new_test_table, new_test_keyspace, new_function, unique_name
+from . import nodetool
 from cassandra.protocol import InvalidRequest, SyntaxException
 
 # Fulltext search is not allowed in tables using vnodes, so all tests in this file need tablets
@@ -718,3 +719,28 @@ def test_bm25_rejected_in_non_select_statements(cql, fulltext_table):
         cql.execute(f"UPDATE {fulltext_table} SET content = 'x' WHERE p = 1 AND BM25(content, 'hello') > 0")
     with pytest.raises(InvalidRequest, match="only supported in SELECT statements"):
         cql.execute(f"DELETE FROM {fulltext_table} WHERE p = 1 AND BM25(content, 'hello') > 0")
+
+
+def test_bm25_local_engine(cql, test_keyspace):
+    """With the 'local' engine, BM25 queries are served by inverted indexes of
+    the sstables and memtables of the replicas, so they return results
+    without the vector store, including the rows just written."""
+    schema = 'p int primary key, content text'
+    with new_test_table(cql, test_keyspace, schema) as table:
+        cql.execute(f"CREATE CUSTOM INDEX ON {table}(content) USING 'fulltext_index' WITH OPTIONS = {{'engine': 'local'}}")
+        cql.execute(f"INSERT INTO {table} (p, content) VALUES (1, 'the quick brown fox')")
+        cql.execute(f"INSERT INTO {table} (p, content) VALUES (2, 'the lazy dog')")
+        cql.execute(f"INSERT INTO {table} (p, content) VALUES (3, 'a quick fox jumps over another quick fox')")
+        rows = list(cql.execute(f"SELECT p FROM {table} WHERE BM25(content, 'quick fox') > 0 ORDER BY BM25(content, 'quick fox') LIMIT 10"))
+        # Document 2 matches none of the terms.
+        assert sorted(r.p for r in rows) == [1, 3]
+        # Once the documents are in sstables, writes still in memtables
+        # are seen right away.
+        nodetool.flush(cql, table)
+        cql.execute(f"DELETE FROM {table} WHERE p = 1")
+        cql.execute(f"UPDATE {table} SET content = 'the quick dog' WHERE p = 2")
+        cql.execute(f"UPDATE {table} SET content = 'no match' WHERE p = 3")
+        rows = list(cql.execute(f"SELECT p FROM {table} WHERE BM25(content, 'quick fox') > 0 ORDER BY BM25(content, 'quick fox') LIMIT 10"))
+        assert [r.p for r in rows] == [2]
+        with pytest.raises(InvalidRequest, match="Invalid value in option 'engine' for fulltext index"):
+            cql.execute(f"CREATE CUSTOM INDEX ON {table}(content) USING 'fulltext_index' WITH OPTIONS = {{'engine': 'invalid_value'}}")
@@ -23,6 +23,7 @@
 import pytest
 import json
 from .util import new_test_table, is_scylla, unique_name, config_value_context
+from . import nodetool
 from cassandra.protocol import InvalidRequest, ConfigurationException
 
 supported_filtering_types = [
@@ -1132,3 +1133,30 @@ def test_vector_index_option_rescoring_validation(cql, test_keyspace, scylla_onl
         for rescoring in ['invalid_value', '0', '1', ' true', 'false ']:
             with pytest.raises(InvalidRequest, match="Invalid value in option 'rescoring' for vector index"):
                 cql.execute(f"CREATE CUSTOM INDEX ON {table}(v) USING 'vector_index' WITH OPTIONS = {{'rescoring': '{rescoring}'}}")
+
+# The 'local' engine serves ANN queries from indexes of the sstables and
+# memtables of the replicas, so unlike with the vector store, the queries
+# return results in this test suite, including the rows just written.
+def test_vector_index_local_engine(cql, test_keyspace, scylla_only, skip_without_tablets):
+    schema = 'p int primary key, v vector<float, 2>'
+    with new_test_table(cql, test_keyspace, schema) as table:
+        cql.execute(f"CREATE CUSTOM INDEX ON {table}(v) USING 'vector_index' WITH OPTIONS = {{'engine': 'local', 'similarity_function': 'euclidean'}}")
+        for p in range(100):
+            cql.execute(f"INSERT INTO {table} (p, v) VALUES ({p}, [{p}, {p}])")
+        rows = list(cql.execute(f"SELECT p FROM {table} ORDER BY v ANN OF [10.1, 10.1] LIMIT 3"))
+        assert [r.p for r in rows] == [10, 11, 9]
+        # The same rows are found once they are in sstables.
+        nodetool.flush(cql, table)
+        rows = list(cql.execute(f"SELECT p FROM {table} ORDER BY v ANN OF [10.1, 10.1] LIMIT 3"))
+        assert [r.p for r in rows] == [10, 11, 9]
+        # Deletes and overwrites still in memtables are seen right away, and
+        # the rows they shadow in sstables aren't returned.
+        cql.execute(f"DELETE FROM {table} WHERE p = 10")
+        cql.execute(f"UPDATE {table} SET v = [50, 50] WHERE p = 11")
+        cql.execute(f"INSERT INTO {table} (p, v) VALUES (1000, [10, 10])")
+        rows = list(cql.execute(f"SELECT p FROM {table} ORDER BY v ANN OF [10.1, 10.1] LIMIT 3"))
+        assert [r.p for r in rows] == [1000, 9, 12]
+        with pytest.raises(InvalidRequest, match="Filtering is not supported by vector indexes with the local engine"):
+            cql.execute(f"SELECT p FROM {table} WHERE p = 1 ORDER BY v ANN OF [10.1, 10.1] LIMIT 3")
+        with pytest.raises(InvalidRequest, match="Invalid value in option 'engine' for vector index"):
+            cql.execute(f"CREATE CUSTOM INDEX ON {table}(v) USING 'vector_index' WITH OPTIONS = {{'engine': 'invalid_value'}}")
@@ -264,7 +264,11 @@ test_env::impl::impl(test_env_config cfg, sstable_compressor_factory& scfarg, ss
                 .memory_reclaim_threshold = db_config->components_memory_reclaim_threshold,
                 .data_file_directories = db_config->data_file_directories(),
                 .format = db_config->sstable_format,
+                .combined_sstable_filter = db_config->sstable_set_combined_filter,
+                .decompressed_chunk_cache = db_config->cache_decompressed_chunks,
+                .adaptive_compression_chunk_length = db_config->sstable_compression_adaptive_chunk_length,
                 .large_data_records_per_sstable = db_config->compaction_large_data_records_per_sstable,
+                .repair_summaries = db_config->sstable_repair_summaries,
             },
             feature_service,
             cache_tracker,
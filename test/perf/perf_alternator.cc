@@ -44,6 +44,7 @@ struct test_config {
     unsigned concurrency;
     unsigned scan_total_segments;
     unsigned batch_size;
+    unsigned rows_per_partition;
     bool flush;
     std::string remote_host;
     bool continue_after_error;
@@ -57,6 +58,7 @@ std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
            << ", duration_in_seconds=" << cfg.duration_in_seconds
            << ", operations-per-shard=" << cfg.operations_per_shard
            << ", batch_size=" << cfg.batch_size
+           << ", rows_per_partition=" << cfg.rows_per_partition
            << ", flush=" << cfg.flush
            << "}";
 }
@@ -255,7 +257,7 @@ static constexpr auto update_item_suffix = R"(
     }}
 )";
 
-static future<> update_item(const test_config& _, http::client& cli, uint64_t seq) {
+static future<> update_row(http::client& cli, uint64_t p, uint64_t c) {
     auto prefix = format(R"({{
             "TableName": "workloads_test",
             "Key": {{
@@ -265,11 +267,15 @@ static future<> update_item(const test_config& _, http::client& cli, uint64_t se
                 "c": {{
                     "S": "{}"
                 }}
-            }},)", seq, seq);
+            }},)", p, c);
 
     return make_request(cli, "UpdateItem", prefix + seastar::format(update_item_suffix, ""));
 }
 
+static future<> update_item(const test_config& _, http::client& cli, uint64_t seq) {
+    return update_row(cli, seq, seq);
+}
+
 static future<> update_item_gsi(const test_config& _, http::client& cli, uint64_t seq) {
     auto prefix = format(R"({{
             "TableName": "workloads_test",
@@ -398,6 +404,21 @@ static future<> scan(const test_config& c, http::client& cli, uint64_t seq) {
     co_await make_request(cli, "Scan", std::move(body));
 }
 
+static future<> query_partition(const test_config& c, http::client& cli, uint64_t seq) {
+    // Returns all the c.rows_per_partition items of the partition.
+    auto body = format(R"({{
+        "TableName": "workloads_test",
+        "KeyConditionExpression": "p = :p",
+        "ExpressionAttributeValues": {{
+            ":p": {{
+                "S": "{}"
+            }}
+        }},
+        "ConsistentRead": false
+    }})", seq);
+    co_await make_request(cli, "Query", std::move(body));
+}
+
 static void flush_table(const test_config& c) {
     auto cli = get_client(c, 10000);
     auto req = http::request::make("POST", "localhost", "/storage_service/keyspace_flush/alternator_workloads_test");
@@ -410,7 +431,13 @@ static void flush_table(const test_config& c) {
 static void create_partitions(const test_config& c, http::client& cli) {
     std::cout << "Creating " << c.partitions << " partitions..." << std::endl;
     for (unsigned seq = 0; seq < c.partitions; ++seq) {
-        update_item(c, cli, seq).get();
+        if (c.workload == "query") {
+            for (unsigned row = 0; row < c.rows_per_partition; ++row) {
+                update_row(cli, seq, row).get();
+            }
+        } else {
+            update_item(c, cli, seq).get();
+        }
     }
     if (c.flush) {
         std::cout << "Flushing partitions..." << std::endl;
@@ -449,6 +476,7 @@ void workload_main(const test_config& c, sharded<abort_source>* as) {
         {"read",  get_item},
         {"batch_read", batch_get_item},
         {"scan", scan},
+        {"query", query_partition},
         {"write", update_item},
         {"write_gsi", update_item_gsi},
         // needs to be executed together with --alternator-write-isolation only_rmw_uses_lwt
@@ -456,7 +484,7 @@ void workload_main(const test_config& c, sharded<abort_source>* as) {
         {"write_rmw", update_item_rmw},
     };
 
-    if (c.prepopulate_partitions && (c.workload == "read" || c.workload == "batch_read" || c.workload == "scan")) {
+    if (c.prepopulate_partitions && (c.workload == "read" || c.workload == "batch_read" || c.workload == "scan" || c.workload == "query")) {
         create_partitions(c, cli);
     }
 
@@ -491,6 +519,22 @@ void workload_main(const test_config& c, sharded<abort_source>* as) {
     aggregated_perf_results agg(results);
     std::cout << agg << std::endl;
 
+    // Scan and Query return many items per request, so also report the cost
+    // of an item, which is dominated by formatting the response. For scan,
+    // the number of items is an estimate, the segments aren't exactly equal.
+    double items_per_op = 1;
+    if (c.workload == "scan") {
+        items_per_op = double(c.partitions) / c.scan_total_segments;
+    } else if (c.workload == "query") {
+        items_per_op = c.rows_per_partition;
+    }
+    if (c.workload == "scan" || c.workload == "query") {
+        for (const auto& s : {"instructions_per_op", "cpu_cycles_per_op"}) {
+            auto& t = agg.stats.at(s);
+            fmt::print(std::cout, "{} per item:\n\tmean=   {:.2f}\n\tmedian= {:.2f}\n", s, t.mean / items_per_op, t.median / items_per_op);
+        }
+    }
+
     if (!c.json_result_file.empty()) {
         Json::Value params;
         params["workload"] = c.workload;
@@ -502,6 +546,8 @@ void workload_main(const test_config& c, sharded<abort_source>* as) {
         params["flush"] = c.flush;
         params["scan_total_segments"] = c.scan_total_segments;
         params["batch_size"] = c.batch_size;
+        params["rows_per_partition"] = c.rows_per_partition;
+        params["items_per_op"] = items_per_op;
         params["cpus"] = this_smp_shard_count();
 
         perf::write_json_result(c.json_result_file, agg, params, c.workload);
@@ -528,6 +574,7 @@ std::function<int(int, char**)> alternator(std::function<int(int, char**)> scyll
             ("remote-port", bpo::value<unsigned>()->default_value(8000), "address of remote alternator port")
             ("scan-total-segments", bpo::value<unsigned>()->default_value(10), "single scan operation will retrieve 1/scan-total-segments portion of a table")
             ("batch-size", bpo::value<unsigned>()->default_value(32), "number of keys read by a single request in the batch_read workload")
+            ("rows-per-partition", bpo::value<unsigned>()->default_value(100), "number of items in each partition, returned by a single request in the query workload")
             ("continue-after-error", bpo::value<bool>()->default_value(false), "continue test after failed request")
             ("json-result", bpo::value<std::string>()->default_value(""), "file to write json results to")
         ;
@@ -544,6 +591,7 @@ std::function<int(int, char**)> alternator(std::function<int(int, char**)> scyll
         c.remote_host = opts["remote-host"].as<std::string>();
         c.scan_total_segments = opts["scan-total-segments"].as<unsigned>();
         c.batch_size = opts["batch-size"].as<unsigned>();
+        c.rows_per_partition = opts["rows-per-partition"].as<unsigned>();
         c.continue_after_error = opts["continue-after-error"].as<bool>();
         c.json_result_file = opts["json-result"].as<std::string>();
 
@@ -551,6 +599,10 @@ std::function<int(int, char**)> alternator(std::function<int(int, char**)> scyll
             throw std::invalid_argument("scan-total-segments must be between 1 and 1'000'000");
         }
 
+        if (c.workload == "query" && c.rows_per_partition < 1) {
+            throw std::invalid_argument("rows-per-partition must be at least 1");
+        }
+
         // The keys of a batch must be distinct, so the batch cannot be larger than the key space.
         if (c.workload == "batch_read") {
             // maximum batch size allowed by BatchGetItem is 100
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/testing/random.hh>
+
+#include "utils/bloom_filter.hh"
+#include "utils/i_filter.hh"
+
+// Probes filters that are much larger than the CPU caches, like the filters
+// of the many sstables a partition read has to check, so each probe of a
+// classic filter misses the cache up to k times and a blocked one only once.
+class bloom_filter_probe {
+public:
+    static constexpr int64_t elements = 4'000'000;
+    static constexpr size_t probes = 1000;
+    static constexpr double fp_chance = 0.01;
+private:
+    utils::filter_ptr _classic;
+    utils::filter_ptr _blocked;
+    std::vector<utils::hashed_key> _present;
+    std::vector<utils::hashed_key> _absent;
+
+    static utils::hashed_key random_key(std::mt19937_64& eng) {
+        return utils::hashed_key(std::array<uint64_t, 2>{eng(), eng()});
+    }
+public:
+    bloom_filter_probe() {
+        // Fixtures are set up in a seastar thread, as get_filter() requires.
+        _classic = utils::i_filter::get_filter(elements, fp_chance, utils::filter_format::m_format);
+        _blocked = utils::i_filter::get_filter(elements, fp_chance, utils::filter_format::blocked_format);
+        std::mt19937_64 eng(seastar::testing::local_random_engine());
+        for (int64_t i = 0; i < elements; ++i) {
+            auto key = random_key(eng);
+            _classic->add(key);
+            _blocked->add(key);
+            if (_present.size() < probes) {
+                _present.push_back(key);
+            }
+        }
+        for (size_t i = 0; i < probes; ++i) {
+            _absent.push_back(random_key(eng));
+        }
+    }
+
+    size_t probe(utils::i_filter& filter, const std::vector<utils::hashed_key>& keys) {
+        for (const auto& key : keys) {
+            perf_tests::do_not_optimize(filter.is_present(key));
+        }
+        return keys.size();
+    }
+
+    utils::i_filter& classic() { return *_classic; }
+    utils::i_filter& blocked() { return *_blocked; }
+    const std::vector<utils::hashed_key>& present() const { return _present; }
+    const std::vector<utils::hashed_key>& absent() const { return _absent; }
+};
+
+PERF_TEST_F(bloom_filter_probe, classic_present) {
+    return probe(classic(), present());
+}
+
+PERF_TEST_F(bloom_filter_probe, classic_absent) {
+    return probe(classic(), absent());
+}
+
+PERF_TEST_F(bloom_filter_probe, blocked_present) {
+    return probe(blocked(), present());
+}
+
+PERF_TEST_F(bloom_filter_probe, blocked_absent) {
+    return probe(blocked(), absent());
+}
@@ -48,6 +48,8 @@ int main(int argc, char** argv) {
         ("trace", "Enables trace-level logging for the test actions")
         ("no-reads", "Disable reads during the test")
         ("seconds", bpo::value<unsigned>()->default_value(60), "Duration [s] after which the test terminates with a success")
+        ("scan", "Instead of writing to a partition while reading it, read a small set of hot partitions while scanning a table larger than the cache")
+        ("protected-fraction", bpo::value<double>()->default_value(0), "The fraction of the cache protected from entries used only once (cache_protected_fraction)")
         ;
 
     return app.run(argc, argv, [&app] {
@@ -63,9 +65,11 @@ int main(int argc, char** argv) {
         auto& cfg = *cfg_ptr;
         cfg.enable_commitlog(false);
         cfg.enable_cache(true);
+        cfg.cache_protected_fraction(app.configuration()["protected-fraction"].as<double>());
 
         return do_with_cql_env_thread([&app] (cql_test_env& env) {
             auto reads_enabled = !app.configuration().contains("no-reads");
+            auto scan = app.configuration().contains("scan");
             auto seconds = app.configuration()["seconds"].as<unsigned>();
 
             auto stop_test = defer([] noexcept {
@@ -141,6 +145,54 @@ int main(int argc, char** argv) {
 
             using clock = std::chrono::steady_clock;
 
+            if (scan) {
+                // The hot partitions fit in cache many times over, while the scanned
+                // table is twice as large as the whole memory. Without protection, every
+                // pass of the scan flushes the hot partitions out of cache.
+                const int hot_partitions = 100;
+                const int scanned_partitions = 2 * seastar::memory::stats().total_memory() / value.size();
+                env.execute_cql("CREATE TABLE ks.scanned (pk int PRIMARY KEY, v text)").get();
+                auto scanned_s = db.find_schema("ks", "scanned");
+                db.find_column_family(scanned_s->id()).set_compaction_strategy(compaction::compaction_strategy_type::null);
+                auto&& col = *s->get_column_definition(to_bytes("v"));
+                for (int i = 0; i < hot_partitions; ++i) {
+                    mutation m(s, make_pkey(format("hot{}", i)));
+                    m.set_clustered_cell(clustering_key::from_single_value(*s, serialized(0)), col,
+                            atomic_cell::make_live(*col.type, api::new_timestamp(), serialized(value)));
+                    db.apply(s, freeze(m), tracing::trace_state_ptr(), db::commitlog::force_sync::no, db::no_timeout).get();
+                }
+                auto&& scanned_col = *scanned_s->get_column_definition(to_bytes("v"));
+                for (int i = 0; i < scanned_partitions && !cancelled; ++i) {
+                    mutation m(scanned_s, partition_key::from_single_value(*scanned_s, serialized(i)));
+                    m.set_clustered_cell(clustering_key::make_empty(), scanned_col,
+                            atomic_cell::make_live(*scanned_col.type, api::new_timestamp(), serialized(value)));
+                    db.apply(scanned_s, freeze(m), tracing::trace_state_ptr(), db::commitlog::force_sync::no, db::no_timeout).get();
+                }
+                env.db().invoke_on_all(&replica::database::flush_all_memtables).get();
+                testlog.info("Populated {} hot and {} scanned partitions", hot_partitions, scanned_partitions);
+
+                auto hot_reader = seastar::async([&] {
+                    auto id = env.prepare("select * from ks.cf where pk = ?;").get();
+                    int i = 0;
+                    while (!cancelled) {
+                        auto t0 = clock::now();
+                        env.execute_prepared(id, {{cql3::raw_value::make_value(serialized(format("hot{}", i++ % hot_partitions)))}}).get();
+                        reads_hist.add(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - t0).count());
+                        ++reads;
+                    }
+                });
+                auto scanner = seastar::async([&] {
+                    while (!cancelled) {
+                        env.execute_cql("select count(*) from ks.scanned;").get();
+                    }
+                });
+                hot_reader.get();
+                scanner.get();
+                stats_printer.cancel();
+                completion_timer.cancel();
+                return;
+            }
+
             auto reader = seastar::async([&] {
                 if (!reads_enabled) {
                     return;
@@ -42,6 +42,9 @@ struct test_config {
 
     uint64_t min_flush_delay_in_ms;
     uint64_t max_flush_delay_in_ms;
+
+    // Keep the written segments, and read them back afterwards like commitlog replay.
+    bool replay = false;
 };
 
 using clperf_result = perf_result_with_aio_writes;
@@ -122,6 +125,10 @@ struct commitlog_service {
     future<> init(const db::commitlog::config& cfg) {
         SCYLLA_ASSERT(!log);
         log.emplace(co_await db::commitlog::create_commitlog(cfg));
+        if (this->cfg.replay) {
+            // Segments are never flushed, so they're all left for the replay.
+            co_return;
+        }
         fa.emplace(log->add_flush_handler(std::bind(&commitlog_service::flush_handler, this, std::placeholders::_1, std::placeholders::_2)));
     }
     future<> stop() {
@@ -152,6 +159,43 @@ static std::vector<clperf_result> do_commitlog_test(sharded<commitlog_service>&
     }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, true, &clperf_result::update);
 }
 
+struct replay_result {
+    uint64_t entries = 0;
+    uint64_t bytes = 0;
+
+    replay_result operator+(const replay_result& r) const {
+        return replay_result{entries + r.entries, bytes + r.bytes};
+    }
+};
+
+// Reads the segments written by the test back, on all the shards in parallel,
+// and reports the throughput. Only the reading part of the replay is measured,
+// the entries aren't applied, since there's no database.
+static future<> do_replay_test(sharded<commitlog_service>& cls) {
+    co_await cls.invoke_on_all([] (commitlog_service& s) {
+        return s.log->sync_all_segments();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    auto res = co_await cls.map_reduce0([] (commitlog_service& s) -> future<replay_result> {
+        replay_result r;
+        db::commitlog::replay_state state;
+        for (auto& name : s.log->get_active_segment_names()) {
+            co_await db::commitlog::read_log_file(state, name, db::commitlog::descriptor::FILENAME_PREFIX, [&r] (db::commitlog::buffer_and_replay_position buf_rp) {
+                ++r.entries;
+                r.bytes += buf_rp.buffer.size_bytes();
+                return make_ready_future<>();
+            });
+        }
+        co_return r;
+    }, replay_result(), std::plus<replay_result>());
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << format("\nreplay: {} entries, {:.2f} MiB in {:.3f}s\n{:.0f} entries/s, {:.2f} MiB/s\n",
+            res.entries, res.bytes / double(1024 * 1024), elapsed,
+            res.entries / elapsed, res.bytes / double(1024 * 1024) / elapsed);
+}
+
 int main(int argc, char** argv) {
     namespace bpo = boost::program_options;
     app_template app;
@@ -174,6 +218,8 @@ int main(int argc, char** argv) {
         ("min-flush-delay-in-ms", bpo::value<uint64_t>()->default_value(10), "minimum flush response delay")
         ("max-flush-delay-in-ms", bpo::value<uint64_t>()->default_value(800), "maximum flush response delay")
 
+        ("replay", bpo::value<bool>()->default_value(false), "keep the written segments and measure the throughput of reading them back, as commitlog replay does")
+
         ("json-result", bpo::value<std::string>(), "name of the json result file")
         ;
 
@@ -221,6 +267,7 @@ int main(int argc, char** argv) {
         cfg.max_data_size = app.configuration()["max-data-size"].as<size_t>();
         cfg.min_flush_delay_in_ms = app.configuration()["min-flush-delay-in-ms"].as<uint64_t>();
         cfg.max_flush_delay_in_ms = app.configuration()["min-flush-delay-in-ms"].as<uint64_t>();
+        cfg.replay = app.configuration()["replay"].as<bool>();
 
         if (cfg.min_data_size > cfg.max_data_size) {
             cfg.max_data_size = cfg.min_data_size;
@@ -232,6 +279,10 @@ int main(int argc, char** argv) {
         db::commitlog::config cl_cfg = db::commitlog::config::from_db_config(*db_cfg, current_scheduling_group(), memory::stats().total_memory());
         tmpdir tmp;
         cl_cfg.commit_log_location = tmp.path().string();
+        if (cfg.replay) {
+            // Nothing is flushed, so the disk usage only grows.
+            cl_cfg.allow_going_over_size_limit = true;
+        }
 
         sharded<commitlog_service> test_commitlog;
 
@@ -267,6 +318,10 @@ int main(int argc, char** argv) {
             if (app.configuration().contains("json-result")) {
                 write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, median_result, mad, max, min);
             }
+
+            if (cfg.replay) {
+                co_await do_replay_test(test_commitlog);
+            }
         } catch (...) {
             ex = std::current_exception();
         }
@@ -48,6 +48,28 @@ struct test_config {
     bool verbose = false;
 };
 
+// Outcome of a run, reported by every run and compared between the strategies
+// by --compare-strategies.
+struct run_summary {
+    sstring strategy;
+    double write_amp = 0;
+    double read_amp_avg = 0;
+    uint64_t read_amp_p99 = 0;
+    double space_amp = 0;
+    uint64_t final_sstable_count = 0;
+
+    Json::Value to_json() const {
+        Json::Value v;
+        v["strategy"] = std::string(strategy);
+        v["write_amplification"] = write_amp;
+        v["read_amp_avg"] = read_amp_avg;
+        v["read_amp_p99"] = Json::Value::UInt64(read_amp_p99);
+        v["space_amplification"] = space_amp;
+        v["final_sstable_count"] = Json::Value::UInt64(final_sstable_count);
+        return v;
+    }
+};
+
 struct metrics {
     uint64_t total_operations = 0;
     uint64_t unique_writes = 0;
@@ -97,15 +119,7 @@ struct metrics {
                        uint64_t total_bytes_on_disk, uint64_t major_compacted_bytes) const {
         auto sorted_ra = read_amp_samples;
         std::sort(sorted_ra.begin(), sorted_ra.end());
-
-        double avg_ra = 0;
-        if (!sorted_ra.empty()) {
-            avg_ra = std::accumulate(sorted_ra.begin(), sorted_ra.end(), 0.0) / sorted_ra.size();
-        }
-
-        double write_amp = flush_bytes_written > 0
-            ? static_cast<double>(compaction_bytes_written) / flush_bytes_written
-            : 0;
+        auto r = summarize(cfg, final_sstable_count, total_bytes_on_disk, major_compacted_bytes);
 
         fmt::print("\n=== Compaction Efficiency Benchmark Results ===\n");
         fmt::print("Strategy: {}\n", cfg.compaction_strategy);
@@ -127,33 +141,27 @@ struct metrics {
                    compaction_bytes_written / 1048576.0);
         fmt::print("Total data on disk: {:.1f} MB\n",
                    total_bytes_on_disk / 1048576.0);
-        fmt::print("Write amplification: {:.2f}x\n", write_amp);
+        fmt::print("Write amplification: {:.2f}x\n", r.write_amp);
         fmt::print("\n");
         fmt::print("Total fully compacted data on disk: {:.1f} MB\n",
                    major_compacted_bytes / 1048576.0);
-        double space_amp = major_compacted_bytes > 0
-            ? static_cast<double>(total_bytes_on_disk) / major_compacted_bytes
-            : 0;
-        fmt::print("Space amplification: {:.2f}x\n", space_amp);
+        fmt::print("Space amplification: {:.2f}x\n", r.space_amp);
         fmt::print("\n");
         fmt::print("Read amplification samples: {}\n", sorted_ra.size());
         if (!sorted_ra.empty()) {
-            fmt::print("Read amplification (avg sstables per probe): {:.1f}\n", avg_ra);
+            fmt::print("Read amplification (avg sstables per probe): {:.1f}\n", r.read_amp_avg);
             fmt::print("Read amplification (p50/p95/p99/max): {}/{}/{}/{}\n",
                        percentile(sorted_ra, 50),
                        percentile(sorted_ra, 95),
-                       percentile(sorted_ra, 99),
+                       r.read_amp_p99,
                        sorted_ra.back());
         }
 
         if (!compaction_efficiency_samples.empty()) {
             auto sorted_ce = compaction_efficiency_samples;
             std::sort(sorted_ce.begin(), sorted_ce.end());
-            double weighted_avg_ce = total_compaction_input_bytes > 0
-                ? (static_cast<int64_t>(total_compaction_input_bytes) - static_cast<int64_t>(total_compaction_output_bytes)) / static_cast<double>(total_compaction_input_bytes)
-                : 0;
             fmt::print("\nCompaction efficiency samples: {}\n", sorted_ce.size());
-            fmt::print("Compaction efficiency (weighted avg): {:.4f}\n", weighted_avg_ce);
+            fmt::print("Compaction efficiency (weighted avg): {:.4f}\n", weighted_avg_compaction_efficiency());
             fmt::print("Compaction efficiency (p50/p95/p99/max): {:.4f}/{:.4f}/{:.4f}/{:.4f}\n",
                        percentile_double(sorted_ce, 50),
                        percentile_double(sorted_ce, 95),
@@ -162,61 +170,68 @@ struct metrics {
         }
     }
 
-    void write_json(const test_config& cfg, uint64_t final_sstable_count,
-                    uint64_t total_bytes_on_disk, uint64_t major_compacted_bytes) const {
+    double weighted_avg_compaction_efficiency() const {
+        return total_compaction_input_bytes > 0
+            ? (static_cast<int64_t>(total_compaction_input_bytes) - static_cast<int64_t>(total_compaction_output_bytes)) / static_cast<double>(total_compaction_input_bytes)
+            : 0;
+    }
+
+    run_summary summarize(const test_config& cfg, uint64_t final_sstable_count,
+                          uint64_t total_bytes_on_disk, uint64_t major_compacted_bytes) const {
         auto sorted_ra = read_amp_samples;
         std::sort(sorted_ra.begin(), sorted_ra.end());
 
-        double avg_ra = 0;
+        run_summary r;
+        r.strategy = cfg.compaction_strategy;
+        r.write_amp = flush_bytes_written > 0
+            ? static_cast<double>(compaction_bytes_written) / flush_bytes_written
+            : 0;
         if (!sorted_ra.empty()) {
-            avg_ra = std::accumulate(sorted_ra.begin(), sorted_ra.end(), 0.0) / sorted_ra.size();
+            r.read_amp_avg = std::accumulate(sorted_ra.begin(), sorted_ra.end(), 0.0) / sorted_ra.size();
+            r.read_amp_p99 = percentile(sorted_ra, 99);
         }
-
-        double write_amp = flush_bytes_written > 0
-            ? static_cast<double>(compaction_bytes_written) / flush_bytes_written
+        r.space_amp = major_compacted_bytes > 0
+            ? static_cast<double>(total_bytes_on_disk) / major_compacted_bytes
             : 0;
+        r.final_sstable_count = final_sstable_count;
+        return r;
+    }
 
-        Json::Value root;
-        root["strategy"] = std::string(cfg.compaction_strategy);
+    void write_json(const test_config& cfg, uint64_t final_sstable_count,
+                    uint64_t total_bytes_on_disk, uint64_t major_compacted_bytes) const {
+        auto sorted_ra = read_amp_samples;
+        std::sort(sorted_ra.begin(), sorted_ra.end());
+        auto r = summarize(cfg, final_sstable_count, total_bytes_on_disk, major_compacted_bytes);
+
+        Json::Value root = r.to_json();
         root["random_seed"] = cfg.random_seed;
         root["total_operations"] = Json::Value::UInt64(total_operations);
         root["unique_writes"] = Json::Value::UInt64(unique_writes);
         root["rewrites"] = Json::Value::UInt64(rewrites);
         root["deletes"] = Json::Value::UInt64(deletes);
-        root["duration_seconds"] = fmt::format("{:.2f}", duration_seconds());
-        root["throughput_ops_per_sec"] = fmt::format("{:.2f}", total_operations / duration_seconds());
+        root["duration_seconds"] = duration_seconds();
+        root["throughput_ops_per_sec"] = total_operations / duration_seconds();
         root["total_flushes"] = Json::Value::UInt64(total_flushes);
-        root["final_sstable_count"] = Json::Value::UInt64(final_sstable_count);
         root["flush_bytes_written"] = Json::Value::UInt64(flush_bytes_written);
         root["compaction_bytes_written"] = Json::Value::UInt64(compaction_bytes_written);
         root["total_bytes_on_disk"] = Json::Value::UInt64(total_bytes_on_disk);
         root["major_compacted_bytes_on_disk"] = Json::Value::UInt64(major_compacted_bytes);
-        double space_amp = major_compacted_bytes > 0
-            ? static_cast<double>(total_bytes_on_disk) / major_compacted_bytes
-            : 0;
-        root["space_amplification"] = fmt::format("{:.2f}", space_amp);
-        root["write_amplification"] = fmt::format("{:.2f}", write_amp);
         root["read_amp_samples"] = Json::Value::UInt64(sorted_ra.size());
         if (!sorted_ra.empty()) {
-            root["read_amp_avg"] = fmt::format("{:.2f}", avg_ra);
             root["read_amp_p50"] = Json::Value::UInt64(percentile(sorted_ra, 50));
             root["read_amp_p95"] = Json::Value::UInt64(percentile(sorted_ra, 95));
-            root["read_amp_p99"] = Json::Value::UInt64(percentile(sorted_ra, 99));
             root["read_amp_max"] = Json::Value::UInt64(sorted_ra.back());
         }
 
         if (!compaction_efficiency_samples.empty()) {
             auto sorted_ce = compaction_efficiency_samples;
             std::sort(sorted_ce.begin(), sorted_ce.end());
-            double weighted_avg_ce = total_compaction_input_bytes > 0
-                ? (static_cast<int64_t>(total_compaction_input_bytes) - static_cast<int64_t>(total_compaction_output_bytes)) / static_cast<double>(total_compaction_input_bytes)
-                : 0;
             root["compaction_efficiency_samples"] = Json::Value::UInt64(sorted_ce.size());
-            root["compaction_efficiency_weighted_avg"] = fmt::format("{:.4f}", weighted_avg_ce);
-            root["compaction_efficiency_p50"] = fmt::format("{:.4f}", percentile_double(sorted_ce, 50));
-            root["compaction_efficiency_p95"] = fmt::format("{:.4f}", percentile_double(sorted_ce, 95));
-            root["compaction_efficiency_p99"] = fmt::format("{:.4f}", percentile_double(sorted_ce, 99));
-            root["compaction_efficiency_max"] = fmt::format("{:.4f}", sorted_ce.back());
+            root["compaction_efficiency_weighted_avg"] = weighted_avg_compaction_efficiency();
+            root["compaction_efficiency_p50"] = percentile_double(sorted_ce, 50);
+            root["compaction_efficiency_p95"] = percentile_double(sorted_ce, 95);
+            root["compaction_efficiency_p99"] = percentile_double(sorted_ce, 99);
+            root["compaction_efficiency_max"] = sorted_ce.back();
         }
 
         Json::StreamWriterBuilder builder;
@@ -409,7 +424,7 @@ double await_compactions(sharded<replica::database>& db, const schema_ptr& s, me
     return -1;
 }
 
-void do_compaction_efficiency_test(cql_test_env& env, test_config& cfg) {
+run_summary do_compaction_efficiency_test(cql_test_env& env, test_config& cfg) {
     using clk = std::chrono::steady_clock;
 
     // Create table with configured compaction strategy
@@ -632,6 +647,42 @@ void do_compaction_efficiency_test(cql_test_env& env, test_config& cfg) {
     } else {
         m.print_results(cfg, final_sstable_count, total_bytes_on_disk, major_compacted_bytes);
     }
+
+    // Let the next run, if any, start from an empty table.
+    env.execute_cql("DROP TABLE ks.perf_compaction").get();
+
+    return m.summarize(cfg, final_sstable_count, total_bytes_on_disk, major_compacted_bytes);
+}
+
+// The strategies compared by --compare-strategies, with the options which scale
+// their sstable sizes down to the size of the data written by the benchmark.
+// Each strategy runs with its own options only, so that one's options don't
+// skew the comparison of the others.
+const std::vector<std::pair<sstring, std::map<sstring, sstring>>> compared_strategies = {
+    {"SizeTieredCompactionStrategy", {{"min_sstable_size", "10000"}}},
+    {"LeveledCompactionStrategy", {{"sstable_size_in_mb", "1"}, {"min_sstable_size", "10000"}}},
+    {"IncrementalCompactionStrategy", {{"sstable_size_in_mb", "1"}, {"min_sstable_size", "10000"}}},
+    {"LazyLeveledCompactionStrategy", {{"sstable_size_in_mb", "1"}, {"min_sstable_size", "10000"}}},
+};
+
+void print_comparison(const test_config& cfg, const std::vector<run_summary>& summaries) {
+    if (cfg.output_format == "json") {
+        Json::Value root(Json::arrayValue);
+        for (auto& r : summaries) {
+            root.append(r.to_json());
+        }
+        Json::StreamWriterBuilder builder;
+        builder["indentation"] = "  ";
+        fmt::print("{}\n", Json::writeString(builder, root));
+        return;
+    }
+    fmt::print("\n=== Compaction Strategy Comparison (random seed {}) ===\n", cfg.random_seed);
+    fmt::print("{:<32} {:>10} {:>12} {:>12} {:>10} {:>10}\n",
+               "Strategy", "Write amp", "Read amp avg", "Read amp p99", "Space amp", "SSTables");
+    for (auto& r : summaries) {
+        fmt::print("{:<32} {:>9.2f}x {:>12.1f} {:>12} {:>9.2f}x {:>10}\n",
+                   r.strategy, r.write_amp, r.read_amp_avg, r.read_amp_p99, r.space_amp, r.final_sstable_count);
+    }
 }
 
 } // anonymous namespace
@@ -676,6 +727,9 @@ int scylla_compaction_efficiency_main(int argc, char** argv) {
             "output format: text, json")
         ("verbose", bpo::bool_switch()->default_value(false),
             "print per-shard sstable state after each flush and compaction")
+        ("compare-strategies", bpo::bool_switch()->default_value(false),
+            "run the same workload with STCS, LCS, ICS and LazyLeveledCompactionStrategy, each with its own options "
+            "(ignoring compaction-strategy, incompatible with compaction-options), and compare their write, read and space amplification")
         ;
 
     set_abort_on_internal_error(true);
@@ -749,6 +803,9 @@ int scylla_compaction_efficiency_main(int argc, char** argv) {
                 if (cfg.rewrite_ratio + cfg.delete_ratio > 1.0) {
                     throw std::invalid_argument(fmt::format("rewrite-ratio + delete-ratio must be <= 1.0, got {}", cfg.rewrite_ratio + cfg.delete_ratio));
                 }
+                if (app.configuration()["compare-strategies"].as<bool>() && !opts_str.empty()) {
+                    throw std::invalid_argument("compaction-options can't be used with compare-strategies, which runs each strategy with its own options");
+                }
 
                 if (cfg.output_format == "text") {
                     fmt::print("Compaction efficiency benchmark\n");
@@ -770,7 +827,19 @@ int scylla_compaction_efficiency_main(int argc, char** argv) {
                     }
                 }
 
-                do_compaction_efficiency_test(env, cfg);
+                if (!app.configuration()["compare-strategies"].as<bool>()) {
+                    do_compaction_efficiency_test(env, cfg);
+                    return;
+                }
+                // Every run replays the same workload, from the same seed.
+                std::vector<run_summary> summaries;
+                for (auto& [strategy, options] : compared_strategies) {
+                    auto run_cfg = cfg;
+                    run_cfg.compaction_strategy = strategy;
+                    run_cfg.compaction_options = options;
+                    summaries.push_back(do_compaction_efficiency_test(env, run_cfg));
+                }
+                print_comparison(cfg, summaries);
             }, std::move(cql_cfg)).get();
         });
     });
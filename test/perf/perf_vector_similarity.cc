@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2025-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/testing/random.hh>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <span>
+#include <unordered_map>
+
+#include "cql3/functions/vector_similarity_fcts.hh"
+#include "types/vector.hh"
+
+using namespace cql3::functions;
+
+namespace {
+
+// Copies of the scalar kernels which preceded the vectorized ones, kept as the baseline.
+namespace baseline {
+
+float cosine_similarity(std::span<const float> v1, std::span<const float> v2) {
+    #pragma clang fp contract(fast) reassociate(on)
+    float dot_product = 0.0;
+    float squared_norm_a = 0.0;
+    float squared_norm_b = 0.0;
+
+    for (size_t i = 0; i < v1.size(); ++i) {
+        float a = v1[i];
+        float b = v2[i];
+
+        dot_product += a * b;
+        squared_norm_a += a * a;
+        squared_norm_b += b * b;
+    }
+
+    if (squared_norm_a == 0 || squared_norm_b == 0) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    return (1 + (dot_product / (std::sqrt(squared_norm_a * squared_norm_b)))) / 2;
+}
+
+float euclidean_similarity(std::span<const float> v1, std::span<const float> v2) {
+    #pragma clang fp contract(fast) reassociate(on)
+    float sum = 0.0;
+
+    for (size_t i = 0; i < v1.size(); ++i) {
+        float diff = v1[i] - v2[i];
+        sum += diff * diff;
+    }
+
+    return (1 / (1 + sum));
+}
+
+float dot_product_similarity(std::span<const float> v1, std::span<const float> v2) {
+    #pragma clang fp contract(fast) reassociate(on)
+    float dot_product = 0.0;
+
+    for (size_t i = 0; i < v1.size(); ++i) {
+        dot_product += v1[i] * v2[i];
+    }
+
+    return ((1 + dot_product) / 2);
+}
+
+const std::unordered_map<function_name, similarity_function_t> functions = {
+    {SIMILARITY_COSINE_FUNCTION_NAME, cosine_similarity},
+    {SIMILARITY_EUCLIDEAN_FUNCTION_NAME, euclidean_similarity},
+    {SIMILARITY_DOT_PRODUCT_FUNCTION_NAME, dot_product_similarity},
+};
+
+} // namespace baseline
+
+} // namespace
+
+// Rescoring of ANN candidates: one query vector is compared against many
+// candidate rows, each holding a vector in its serialized (big-endian) form.
+template <vector_dimension_t Dimension>
+class vector_similarity {
+public:
+    static constexpr size_t rows = 1000;
+private:
+    std::vector<float> _query;
+    bytes_opt _serialized_query;
+    std::vector<bytes_opt> _serialized_rows;
+    std::vector<bytes_view> _row_views;
+    std::vector<float> _results;
+
+    static bytes serialize(const std::vector<float>& v) {
+        auto type = vector_type_impl::get_instance(float_type, Dimension);
+        std::vector<data_value> elements(v.begin(), v.end());
+        return type->decompose(make_list_value(type, std::move(elements)));
+    }
+public:
+    vector_similarity()
+        : _query(Dimension)
+        , _results(rows)
+    {
+        auto eng = seastar::testing::local_random_engine;
+        auto dist = std::uniform_real_distribution<float>{-1, 1};
+        std::ranges::generate(_query, [&] { return dist(eng); });
+        _serialized_query = serialize(_query);
+        for (size_t i = 0; i < rows; ++i) {
+            std::vector<float> row(Dimension);
+            std::ranges::generate(row, [&] { return dist(eng); });
+            _serialized_rows.push_back(serialize(row));
+            _row_views.push_back(*_serialized_rows.back());
+        }
+    }
+
+    // The pre-SIMD path: both arguments are deserialized into temporary vectors
+    // first, and compared by the scalar kernels.
+    size_t deserialize_and_compute(const function_name& name) {
+        auto native = baseline::functions.at(name);
+        for (const auto& row : _serialized_rows) {
+            auto v1 = detail::extract_float_vector(_serialized_query, Dimension);
+            auto v2 = detail::extract_float_vector(row, Dimension);
+            perf_tests::do_not_optimize(native(v1, v2));
+        }
+        return rows;
+    }
+
+    size_t compute_serialized(const function_name& name) {
+        auto serialized = SIMILARITY_FUNCTIONS.at(name).serialized;
+        for (const auto& row : _row_views) {
+            perf_tests::do_not_optimize(serialized(*_serialized_query, row));
+        }
+        return rows;
+    }
+
+    size_t compute_batch(const function_name& name) {
+        SIMILARITY_FUNCTIONS.at(name).batch(_query, _row_views, _results);
+        perf_tests::do_not_optimize(_results);
+        return rows;
+    }
+};
+
+using vector_similarity_128 = vector_similarity<128>;
+using vector_similarity_768 = vector_similarity<768>;
+using vector_similarity_1536 = vector_similarity<1536>;
+
+#define VECTOR_SIMILARITY_PERF_TESTS(fixture) \
+    PERF_TEST_F(fixture, cosine_deserialized) { return deserialize_and_compute(SIMILARITY_COSINE_FUNCTION_NAME); } \
+    PERF_TEST_F(fixture, cosine_serialized) { return compute_serialized(SIMILARITY_COSINE_FUNCTION_NAME); } \
+    PERF_TEST_F(fixture, cosine_batch) { return compute_batch(SIMILARITY_COSINE_FUNCTION_NAME); } \
+    PERF_TEST_F(fixture, euclidean_deserialized) { return deserialize_and_compute(SIMILARITY_EUCLIDEAN_FUNCTION_NAME); } \
+    PERF_TEST_F(fixture, euclidean_serialized) { return compute_serialized(SIMILARITY_EUCLIDEAN_FUNCTION_NAME); } \
+    PERF_TEST_F(fixture, euclidean_batch) { return compute_batch(SIMILARITY_EUCLIDEAN_FUNCTION_NAME); } \
+    PERF_TEST_F(fixture, dot_product_deserialized) { return deserialize_and_compute(SIMILARITY_DOT_PRODUCT_FUNCTION_NAME); } \
+    PERF_TEST_F(fixture, dot_product_serialized) { return compute_serialized(SIMILARITY_DOT_PRODUCT_FUNCTION_NAME); } \
+    PERF_TEST_F(fixture, dot_product_batch) { return compute_batch(SIMILARITY_DOT_PRODUCT_FUNCTION_NAME); }
+
+VECTOR_SIMILARITY_PERF_TESTS(vector_similarity_128)
+VECTOR_SIMILARITY_PERF_TESTS(vector_similarity_768)
+VECTOR_SIMILARITY_PERF_TESTS(vector_similarity_1536)
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2025-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "vector_search/hnsw_index.hh"
+#include "cql3/functions/vector_similarity_fcts.hh"
+#include <seastar/testing/test_case.hh>
+#include <algorithm>
+#include <random>
+#include <set>
+
+using namespace vector_search;
+
+namespace {
+
+hnsw_index::similarity_function euclidean_similarity() {
+    return cql3::functions::SIMILARITY_FUNCTIONS.at(cql3::functions::SIMILARITY_EUCLIDEAN_FUNCTION_NAME).native;
+}
+
+std::vector<float> random_vector(std::mt19937& g, size_t dimension) {
+    std::normal_distribution<float> dist;
+    std::vector<float> v(dimension);
+    std::ranges::generate(v, [&] { return dist(g); });
+    return v;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(search_on_empty_index_returns_nothing) {
+    hnsw_index index(3, euclidean_similarity(), {});
+    std::vector<float> query{1, 2, 3};
+
+    BOOST_CHECK(index.empty());
+    BOOST_CHECK(index.search(query, 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(insert_rejects_wrong_dimension) {
+    hnsw_index index(3, euclidean_similarity(), {});
+    std::vector<float> v{1, 2};
+
+    BOOST_CHECK_THROW(index.insert(0, v), std::invalid_argument);
+    BOOST_CHECK_THROW(index.search(v, 1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(search_returns_exact_match_first) {
+    std::mt19937 g(0);
+    hnsw_index index(8, euclidean_similarity(), {});
+    std::vector<std::vector<float>> vectors;
+    for (uint64_t i = 0; i < 100; ++i) {
+        vectors.push_back(random_vector(g, 8));
+        index.insert(i, vectors.back());
+    }
+
+    for (uint64_t i = 0; i < vectors.size(); ++i) {
+        auto res = index.search(vectors[i], 3);
+        BOOST_REQUIRE_EQUAL(res.size(), 3);
+        BOOST_CHECK_EQUAL(res[0].label, i);
+        BOOST_CHECK_EQUAL(res[0].similarity, 1.0f);
+        BOOST_CHECK_GE(res[0].similarity, res[1].similarity);
+        BOOST_CHECK_GE(res[1].similarity, res[2].similarity);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(removed_and_replaced_vectors_are_not_returned) {
+    std::mt19937 g(0);
+    hnsw_index index(4, euclidean_similarity(), {});
+    std::vector<std::vector<float>> vectors;
+    for (uint64_t i = 0; i < 50; ++i) {
+        vectors.push_back(random_vector(g, 4));
+        index.insert(i, vectors.back());
+    }
+
+    BOOST_CHECK(index.remove(7));
+    BOOST_CHECK(!index.remove(7));
+    auto replacement = random_vector(g, 4);
+    index.insert(8, replacement);
+
+    BOOST_CHECK_EQUAL(index.size(), 49);
+    BOOST_CHECK_GT(index.deleted_ratio(), 0.0f);
+    for (const auto& r : index.search(vectors[7], 49)) {
+        BOOST_CHECK_NE(r.label, 7);
+    }
+    auto res = index.search(replacement, 1);
+    BOOST_REQUIRE_EQUAL(res.size(), 1);
+    BOOST_CHECK_EQUAL(res[0].label, 8);
+}
+
+BOOST_AUTO_TEST_CASE(recall_against_brute_force) {
+    constexpr size_t dimension = 32;
+    constexpr size_t count = 2000;
+    constexpr size_t k = 10;
+    constexpr size_t queries = 50;
+
+    std::mt19937 g(0);
+    hnsw_index index(dimension, euclidean_similarity(), {});
+    std::vector<std::vector<float>> vectors;
+    for (uint64_t i = 0; i < count; ++i) {
+        vectors.push_back(random_vector(g, dimension));
+        index.insert(i, vectors.back());
+    }
+
+    size_t hits = 0;
+    for (size_t q = 0; q < queries; ++q) {
+        auto query = random_vector(g, dimension);
+        std::vector<std::pair<float, uint64_t>> exact;
+        for (uint64_t i = 0; i < count; ++i) {
+            exact.emplace_back(euclidean_similarity()(query, vectors[i]), i);
+        }
+        std::ranges::partial_sort(exact, exact.begin() + k, std::greater<>());
+        std::set<uint64_t> expected;
+        for (size_t i = 0; i < k; ++i) {
+            expected.insert(exact[i].second);
+        }
+        auto res = index.search(query, k);
+        BOOST_REQUIRE_EQUAL(res.size(), k);
+        for (const auto& r : res) {
+            hits += expected.contains(r.label);
+        }
+    }
+
+    auto recall = double(hits) / (queries * k);
+    BOOST_TEST_MESSAGE(fmt::format("recall@{}: {}", k, recall));
+    BOOST_CHECK_GE(recall, 0.9);
+}
+
+BOOST_AUTO_TEST_CASE(removed_vectors_do_not_take_result_slots) {
+    constexpr size_t dimension = 8;
+    constexpr size_t count = 500;
+    constexpr size_t k = 10;
+
+    std::mt19937 g(0);
+    hnsw_index index(dimension, euclidean_similarity(), {});
+    std::vector<std::vector<float>> vectors;
+    for (uint64_t i = 0; i < count; ++i) {
+        vectors.push_back(random_vector(g, dimension));
+        index.insert(i, vectors.back());
+    }
+    // Remove most of the vectors, so that the closest nodes to the query are
+    // mostly tombstones.
+    for (uint64_t i = 0; i < count; ++i) {
+        if (i % 4) {
+            index.remove(i);
+        }
+    }
+    BOOST_REQUIRE_EQUAL(index.size(), count / 4);
+
+    for (uint64_t i = 1; i < count; i += 4) {
+        // A beam as wide as k leaves no slack for the tombstones.
+        auto res = index.search(vectors[i], k, k);
+        BOOST_REQUIRE_EQUAL(res.size(), k);
+        for (const auto& r : res) {
+            BOOST_CHECK_EQUAL(r.label % 4, 0);
+        }
+    }
+}
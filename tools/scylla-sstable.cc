@@ -978,6 +978,16 @@ void write_compression_info_component(const sstables::shared_sstable& sst, json_
         writer.Uint64(offset);
     }
     writer.EndArray();
+    if (compression.has_sub_chunks()) {
+        writer.Key("sub_chunk_len");
+        writer.Uint(compression.uncompressed_sub_chunk_length());
+        writer.Key("sub_chunk_offsets");
+        writer.StartArray();
+        for (const auto& offset : compression.sub_chunk_offsets) {
+            writer.Uint64(offset);
+        }
+        writer.EndArray();
+    }
     writer.EndObject();
 }
 
@@ -1364,6 +1374,8 @@ const char* to_string(sstables::scylla_metadata_type t) {
         case sstables::scylla_metadata_type::Schema: return "schema";
         case sstables::scylla_metadata_type::ComponentsDigests: return "components_digests";
         case sstables::scylla_metadata_type::LargeDataRecords: return "large_data_records";
+        case sstables::scylla_metadata_type::RepairSummary: return "repair_summary";
+        case sstables::scylla_metadata_type::ValueLog: return "value_log";
     }
     std::abort();
 }
@@ -1428,6 +1440,8 @@ class scylla_metadata_visitor {
                 {sstables::sstable_feature::CorrectEmptyCounters, "CorrectEmptyCounters"},
                 {sstables::sstable_feature::CorrectUDTsInCollections, "CorrectUDTsInCollections"},
                 {sstables::sstable_feature::CorrectLastPiBlockWidth, "CorrectLastPiBlockWidth"},
+                {sstables::sstable_feature::BlockedBloomFilter, "BlockedBloomFilter"},
+                {sstables::sstable_feature::BinaryFuseFilter, "BinaryFuseFilter"},
         };
         _writer.StartObject();
         _writer.Key("mask");
@@ -1502,6 +1516,40 @@ class scylla_metadata_visitor {
         }
         _writer.EndObject();
     }
+    void operator()(const sstables::scylla_metadata::repair_summary& val) const {
+        _writer.StartObject();
+        _writer.Key("sub_range_bits");
+        _writer.Uint(val.sub_range_bits);
+        _writer.Key("entries");
+        _writer.StartArray();
+        for (const auto& e : val.entries.elements) {
+            _writer.StartObject();
+            _writer.Key("sub_range");
+            _writer.Uint(e.sub_range);
+            _writer.Key("hash");
+            _writer.Uint64(e.hash);
+            _writer.EndObject();
+        }
+        _writer.EndArray();
+        _writer.EndObject();
+    }
+    void operator()(const sstables::scylla_metadata::value_log& val) const {
+        _writer.StartObject();
+        _writer.Key("files");
+        _writer.StartArray();
+        for (const auto& f : val.files.elements) {
+            _writer.StartObject();
+            _writer.Key("id");
+            _writer.AsString(f.id);
+            _writer.Key("size");
+            _writer.Uint64(f.size);
+            _writer.Key("referenced_bytes");
+            _writer.Uint64(f.referenced_bytes);
+            _writer.EndObject();
+        }
+        _writer.EndArray();
+        _writer.EndObject();
+    }
     template <typename Size>
     void operator()(const sstables::disk_string<Size>& val) const {
         _writer.String(disk_string_to_string(val));
@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "binary_fuse_filter.hh"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <seastar/core/format.hh>
+#include <seastar/core/thread.hh>
+
+#include "utils/assert.hh"
+
+namespace utils {
+namespace filter {
+
+thread_local binary_fuse_filter::stats binary_fuse_filter::_shard_stats;
+
+// Each key is mapped to three slots.
+static constexpr uint32_t arity = 3;
+static constexpr uint32_t max_segment_length = 262144;
+// The construction succeeds with a high probability for each seed, the
+// probability of failing this many times in a row is negligible.
+static constexpr int max_construction_attempts = 100;
+
+namespace {
+
+struct layout {
+    uint32_t segment_length;
+    uint32_t segment_count;
+
+    uint64_t array_length() const noexcept {
+        return uint64_t(segment_count + arity - 1) * segment_length;
+    }
+};
+
+}
+
+// The parameters are taken from the reference implementation, which found
+// them to give a good trade-off between the size and the construction success rate.
+static layout layout_for(uint64_t num_elements) {
+    uint32_t segment_length = 4;
+    if (num_elements > 0) {
+        auto shift = int(std::floor(std::log(double(num_elements)) / std::log(3.33) + 2.25));
+        segment_length = shift >= 31 ? max_segment_length : std::min(uint32_t(1) << shift, max_segment_length);
+    }
+    uint64_t capacity = 0;
+    if (num_elements > 1) {
+        auto size_factor = std::max(1.125, 0.875 + 0.25 * std::log(1000000.0) / std::log(double(num_elements)));
+        capacity = std::llround(double(num_elements) * size_factor);
+    }
+    int64_t segment_count = int64_t((capacity + segment_length - 1) / segment_length) - int64_t(arity - 1);
+    return layout{segment_length, uint32_t(std::clamp<int64_t>(segment_count, 1, std::numeric_limits<uint32_t>::max() - arity))};
+}
+
+static size_t fingerprint_words(uint64_t array_length, unsigned fingerprint_bits) {
+    return (array_length * fingerprint_bits + 63) / 64;
+}
+
+static uint64_t murmur64(uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static uint64_t splitmix64(uint64_t& state) noexcept {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t mulhi(uint64_t a, uint64_t b) noexcept {
+    return (static_cast<unsigned __int128>(a) * b) >> 64;
+}
+
+static uint8_t mod3(uint8_t x) noexcept {
+    return x > 2 ? x - 3 : x;
+}
+
+static void maybe_yield(size_t i) {
+    if (i % 4096 == 0) {
+        seastar::thread::maybe_yield();
+    }
+}
+
+static void check_fingerprint_bits(unsigned fingerprint_bits) {
+    if (fingerprint_bits != 8 && fingerprint_bits != 16) {
+        throw std::invalid_argument(seastar::format("Unsupported binary fuse filter fingerprint width: {}", fingerprint_bits));
+    }
+}
+
+binary_fuse_filter::binary_fuse_filter(unsigned fingerprint_bits, uint64_t seed, uint32_t segment_length, uint32_t segment_count)
+    : _seed(seed)
+    , _segment_length(segment_length)
+    , _segment_length_mask(segment_length - 1)
+    , _segment_count_length(segment_count * segment_length)
+    , _array_length((segment_count + arity - 1) * segment_length)
+    , _fingerprint_bits(fingerprint_bits)
+{
+    check_fingerprint_bits(fingerprint_bits);
+    _data = storage(header_words + fingerprint_words(_array_length, _fingerprint_bits));
+    _data[0] = _seed;
+    _data[1] = uint64_t(segment_count) << 32 | segment_length;
+    _shard_stats.memory_size += memory_size();
+}
+
+binary_fuse_filter::binary_fuse_filter(unsigned fingerprint_bits, storage&& data)
+    : _data(std::move(data))
+    , _fingerprint_bits(fingerprint_bits)
+{
+    check_fingerprint_bits(fingerprint_bits);
+    if (_data.size() < header_words) {
+        throw std::invalid_argument(seastar::format("Truncated binary fuse filter of {} words", _data.size()));
+    }
+    _seed = _data[0];
+    _segment_length = uint32_t(_data[1]);
+    auto segment_count = uint32_t(_data[1] >> 32);
+    auto l = layout{_segment_length, segment_count};
+    if (!std::has_single_bit(_segment_length) || _segment_length > max_segment_length || segment_count == 0
+            || l.array_length() > std::numeric_limits<uint32_t>::max()
+            || _data.size() != header_words + fingerprint_words(l.array_length(), _fingerprint_bits)) {
+        throw std::invalid_argument(seastar::format("Invalid binary fuse filter with segment length {}, {} segments and {} words",
+                _segment_length, segment_count, _data.size()));
+    }
+    _segment_length_mask = _segment_length - 1;
+    _segment_count_length = segment_count * _segment_length;
+    _array_length = l.array_length();
+    _shard_stats.memory_size += memory_size();
+}
+
+binary_fuse_filter::~binary_fuse_filter() noexcept {
+    _shard_stats.memory_size -= memory_size();
+}
+
+binary_fuse_filter::hashes binary_fuse_filter::hashes_of(uint64_t hash) const noexcept {
+    uint32_t h0 = mulhi(hash, _segment_count_length);
+    uint32_t h1 = h0 + _segment_length;
+    uint32_t h2 = h1 + _segment_length;
+    h1 ^= uint32_t(hash >> 18) & _segment_length_mask;
+    h2 ^= uint32_t(hash) & _segment_length_mask;
+    return {h0, h1, h2};
+}
+
+uint32_t binary_fuse_filter::hash_of(unsigned index, uint64_t hash) const noexcept {
+    // Equivalent to the corresponding member of hashes_of().
+    uint64_t h = mulhi(hash, _segment_count_length) + index * _segment_length;
+    uint64_t hh = hash & ((uint64_t(1) << 36) - 1);
+    h ^= (hh >> (36 - 18 * index)) & _segment_length_mask;
+    return h;
+}
+
+uint64_t binary_fuse_filter::fingerprint(size_t i) const noexcept {
+    // Fingerprints never straddle words, since their width divides 64.
+    auto bit = i * _fingerprint_bits;
+    return (_data[header_words + bit / 64] >> (bit % 64)) & ((uint64_t(1) << _fingerprint_bits) - 1);
+}
+
+void binary_fuse_filter::set_fingerprint(size_t i, uint64_t fp) noexcept {
+    auto bit = i * _fingerprint_bits;
+    auto mask = ((uint64_t(1) << _fingerprint_bits) - 1) << (bit % 64);
+    auto& word = _data[header_words + bit / 64];
+    word = (word & ~mask) | ((fp << (bit % 64)) & mask);
+}
+
+uint64_t binary_fuse_filter::fingerprint_of_hash(uint64_t hash) const noexcept {
+    return (hash ^ (hash >> 32)) & ((uint64_t(1) << _fingerprint_bits) - 1);
+}
+
+// Assigns each key to one of its slots by peeling, i.e. repeatedly removing
+// keys which are alone in one of their slots, and then fills the fingerprints
+// in the reverse order, so that each key's slot is set after the other slots
+// of the key are final.
+bool binary_fuse_filter::populate(storage& keys) {
+    size_t size = keys.size();
+    const size_t capacity = _array_length;
+
+    utils::chunked_vector<uint64_t> reverse_order(size + 1);
+    utils::chunked_vector<uint8_t> reverse_h(size);
+    utils::chunked_vector<uint8_t> t2count(capacity);
+    utils::chunked_vector<uint64_t> t2hash(capacity);
+    utils::chunked_vector<uint32_t> alone(capacity);
+
+    // Keys are first bucketed by their segment, which makes the accesses to
+    // t2count and t2hash below mostly sequential.
+    uint32_t block_bits = 1;
+    while ((uint32_t(1) << block_bits) < _segment_count_length / _segment_length) {
+        block_bits += 1;
+    }
+    const uint32_t block = uint32_t(1) << block_bits;
+    std::vector<uint64_t> start_pos(block);
+
+    uint64_t rng = 0x726b2b9d438b9d4dULL;
+    _seed = splitmix64(rng);
+    reverse_order[size] = 1;
+    size_t stack_size = 0;
+    for (int attempt = 0;; ++attempt) {
+        if (attempt == max_construction_attempts) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < block; i++) {
+            start_pos[i] = (uint64_t(i) * size) >> block_bits;
+        }
+        for (size_t i = 0; i < size; i++) {
+            maybe_yield(i);
+            uint64_t hash = murmur64(keys[i] + _seed);
+            uint64_t segment_index = hash >> (64 - block_bits);
+            while (reverse_order[start_pos[segment_index]] != 0) {
+                segment_index = (segment_index + 1) & (block - 1);
+            }
+            reverse_order[start_pos[segment_index]] = hash;
+            start_pos[segment_index]++;
+        }
+
+        bool error = false;
+        size_t duplicates = 0;
+        for (size_t i = 0; i < size; i++) {
+            maybe_yield(i);
+            uint64_t hash = reverse_order[i];
+            uint32_t h0 = hash_of(0, hash);
+            uint32_t h1 = hash_of(1, hash);
+            uint32_t h2 = hash_of(2, hash);
+            // The low two bits of t2count hold the xor of the indexes (0, 1 or 2)
+            // of the slot in the keys which map to it, and the rest the number of keys.
+            t2count[h0] += 4;
+            t2hash[h0] ^= hash;
+            t2count[h1] += 4;
+            t2count[h1] ^= 1;
+            t2hash[h1] ^= hash;
+            t2count[h2] += 4;
+            t2count[h2] ^= 2;
+            t2hash[h2] ^= hash;
+            // A duplicate key cancels out the first one in t2hash, remove both.
+            if ((t2hash[h0] & t2hash[h1] & t2hash[h2]) == 0) {
+                if ((t2hash[h0] == 0 && t2count[h0] == 8)
+                        || (t2hash[h1] == 0 && t2count[h1] == 8)
+                        || (t2hash[h2] == 0 && t2count[h2] == 8)) {
+                    duplicates += 1;
+                    t2count[h0] -= 4;
+                    t2hash[h0] ^= hash;
+                    t2count[h1] -= 4;
+                    t2count[h1] ^= 1;
+                    t2hash[h1] ^= hash;
+                    t2count[h2] -= 4;
+                    t2count[h2] ^= 2;
+                    t2hash[h2] ^= hash;
+                }
+            }
+            // t2count overflowed
+            error = error || t2count[h0] < 4 || t2count[h1] < 4 || t2count[h2] < 4;
+        }
+
+        if (!error) {
+            size_t queue_size = 0;
+            for (size_t i = 0; i < capacity; i++) {
+                maybe_yield(i);
+                alone[queue_size] = i;
+                queue_size += (t2count[i] >> 2) == 1 ? 1 : 0;
+            }
+            stack_size = 0;
+            for (size_t iteration = 0; queue_size > 0; ++iteration) {
+                maybe_yield(iteration);
+                queue_size--;
+                uint32_t index = alone[queue_size];
+                if ((t2count[index] >> 2) != 1) {
+                    continue;
+                }
+                uint64_t hash = t2hash[index];
+                uint32_t h0 = hash_of(0, hash);
+                uint32_t h1 = hash_of(1, hash);
+                std::array<uint32_t, 5> h012 = {h0, h1, hash_of(2, hash), h0, h1};
+                uint8_t found = t2count[index] & 3;
+                reverse_h[stack_size] = found;
+                reverse_order[stack_size] = hash;
+                stack_size++;
+
+                uint32_t other_index1 = h012[found + 1];
+                alone[queue_size] = other_index1;
+                queue_size += (t2count[other_index1] >> 2) == 2 ? 1 : 0;
+                t2count[other_index1] -= 4;
+                t2count[other_index1] ^= mod3(found + 1);
+                t2hash[other_index1] ^= hash;
+
+                uint32_t other_index2 = h012[found + 2];
+                alone[queue_size] = other_index2;
+                queue_size += (t2count[other_index2] >> 2) == 2 ? 1 : 0;
+                t2count[other_index2] -= 4;
+                t2count[other_index2] ^= mod3(found + 2);
+                t2hash[other_index2] ^= hash;
+            }
+            if (stack_size + duplicates == size) {
+                break;
+            }
+            if (duplicates > 0) {
+                std::ranges::sort(keys);
+                auto [first, last] = std::ranges::unique(keys);
+                keys.resize(size - (last - first));
+                size = keys.size();
+                reverse_order[size] = 1;
+            }
+        }
+
+        std::fill_n(reverse_order.begin(), size, 0);
+        std::ranges::fill(t2count, 0);
+        std::ranges::fill(t2hash, 0);
+        _seed = splitmix64(rng);
+    }
+
+    for (size_t i = stack_size; i-- > 0;) {
+        maybe_yield(i);
+        uint64_t hash = reverse_order[i];
+        uint32_t h0 = hash_of(0, hash);
+        uint32_t h1 = hash_of(1, hash);
+        std::array<uint32_t, 5> h012 = {h0, h1, hash_of(2, hash), h0, h1};
+        uint8_t found = reverse_h[i];
+        set_fingerprint(h012[found], fingerprint_of_hash(hash) ^ fingerprint(h012[found + 1]) ^ fingerprint(h012[found + 2]));
+    }
+    _data[0] = _seed;
+    return true;
+}
+
+std::unique_ptr<binary_fuse_filter> binary_fuse_filter::build(storage& keys, unsigned fingerprint_bits) {
+    SCYLLA_ASSERT(seastar::thread::running_in_thread());
+
+    auto l = layout_for(keys.size());
+    if (l.array_length() > std::numeric_limits<uint32_t>::max()) {
+        return nullptr;
+    }
+    auto filter = std::unique_ptr<binary_fuse_filter>(new binary_fuse_filter(fingerprint_bits, 0, l.segment_length, l.segment_count));
+    if (!filter->populate(keys)) {
+        return nullptr;
+    }
+    return filter;
+}
+
+void binary_fuse_filter::add(const bytes_view& key) {
+    add(make_hashed_key(key));
+}
+
+void binary_fuse_filter::add(const hashed_key& key) {
+    throw std::logic_error("Keys cannot be added to a binary fuse filter after it's built");
+}
+
+bool binary_fuse_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
+bool binary_fuse_filter::is_present(hashed_key key) {
+    uint64_t hash = murmur64(key.hash()[0] + _seed);
+    auto h = hashes_of(hash);
+    return (fingerprint_of_hash(hash) ^ fingerprint(h.h0) ^ fingerprint(h.h1) ^ fingerprint(h.h2)) == 0;
+}
+
+unsigned binary_fuse_filter::fingerprint_bits_for(double max_false_pos_prob) noexcept {
+    // The false-positive rate is 2^-fingerprint_bits.
+    for (unsigned bits : {8, 16}) {
+        if (max_false_pos_prob >= std::ldexp(1.0, -int(bits))) {
+            return bits;
+        }
+    }
+    return 0;
+}
+
+size_t binary_fuse_filter::get_filter_size(uint64_t num_elements, unsigned fingerprint_bits) {
+    return (header_words + fingerprint_words(layout_for(num_elements).array_length(), fingerprint_bits)) * sizeof(uint64_t);
+}
+
+size_t binary_fuse_filter::get_build_memory_size(uint64_t num_elements) {
+    // t2count, t2hash and alone for each slot, reverse_order and reverse_h for each key.
+    return layout_for(num_elements).array_length() * (sizeof(uint8_t) + sizeof(uint64_t) + sizeof(uint32_t))
+            + (num_elements + 1) * (sizeof(uint64_t) + sizeof(uint8_t));
+}
+
+}
+}
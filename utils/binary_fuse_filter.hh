@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "i_filter.hh"
+#include "utils/chunked_vector.hh"
+
+namespace utils {
+namespace filter {
+
+// A binary fuse filter, see "Binary Fuse Filters: Fast and Smaller Than Xor Filters"
+// by Graf and Lemire. Each key is mapped to three slots in a table of fingerprints,
+// and is present if the xor of the three is its own fingerprint. The three slots are
+// within a window of a few consecutive segments, so they're close to each other.
+//
+// For a given false-positive rate it takes about 30% less memory than a bloom filter,
+// but it's static: it's built once from the complete set of keys and keys can't be
+// added to it later.
+//
+// The filter is stored as an array of little-endian 64-bit words, which is also its
+// serialized form:
+//   word 0: seed
+//   word 1: segment length (low 32 bits), number of segments (high 32 bits)
+//   fingerprints, packed (fingerprint_bits wide) from the low bits of each word
+class binary_fuse_filter: public i_filter {
+public:
+    using storage = utils::chunked_vector<uint64_t>;
+    static constexpr size_t header_words = 2;
+
+private:
+    storage _data;
+    uint64_t _seed;
+    uint32_t _segment_length;
+    uint32_t _segment_length_mask;
+    uint32_t _segment_count_length;
+    uint32_t _array_length;
+    unsigned _fingerprint_bits;
+
+    static thread_local struct stats {
+        uint64_t memory_size = 0;
+    } _shard_stats;
+
+    struct hashes {
+        uint32_t h0, h1, h2;
+    };
+
+    binary_fuse_filter(unsigned fingerprint_bits, uint64_t seed, uint32_t segment_length, uint32_t segment_count);
+
+    hashes hashes_of(uint64_t hash) const noexcept;
+    uint32_t hash_of(unsigned index, uint64_t hash) const noexcept;
+    uint64_t fingerprint(size_t i) const noexcept;
+    void set_fingerprint(size_t i, uint64_t fp) noexcept;
+    uint64_t fingerprint_of_hash(uint64_t hash) const noexcept;
+    bool populate(storage& keys);
+public:
+    // Loads a filter from its serialized form, see data().
+    // Throws std::invalid_argument if the data isn't a valid filter.
+    binary_fuse_filter(unsigned fingerprint_bits, storage&& data);
+    ~binary_fuse_filter() noexcept;
+
+    // Builds a filter for the given keys, which are the first halves of their
+    // hashed_key. The keys are reordered, and duplicates are removed.
+    // Returns nullptr in the (astronomically unlikely) case the construction fails.
+    //
+    // Must be called in a seastar thread, as it yields while building large filters.
+    static std::unique_ptr<binary_fuse_filter> build(storage& keys, unsigned fingerprint_bits);
+
+    virtual void add(const bytes_view& key) override;
+    virtual void add(const hashed_key& key) override;
+
+    virtual bool is_present(const bytes_view& key) override;
+    virtual bool is_present(hashed_key key) override;
+
+    virtual void close() override { }
+
+    virtual size_t memory_size() override {
+        return _data.memory_size();
+    }
+
+    unsigned fingerprint_bits() const noexcept { return _fingerprint_bits; }
+    const storage& data() const noexcept { return _data; }
+
+    // The narrowest supported fingerprint width which provides the requested
+    // false-positive rate, or 0 if no supported width provides it.
+    static unsigned fingerprint_bits_for(double max_false_pos_prob) noexcept;
+
+    // The size (in bytes) of a filter for the given number of keys.
+    static size_t get_filter_size(uint64_t num_elements, unsigned fingerprint_bits);
+
+    // Upper bound on the memory (in bytes) temporarily needed for building a filter
+    // for the given number of keys, on top of the keys and the filter itself.
+    static size_t get_build_memory_size(uint64_t num_elements);
+
+    static const stats& get_shard_stats() noexcept {
+        return _shard_stats;
+    }
+};
+
+}
+}
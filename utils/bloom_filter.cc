@@ -19,6 +19,13 @@
 #include "utils/bloom_calculations.hh"
 #include "bloom_filter.hh"
 
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace utils {
 namespace filter {
 
@@ -76,6 +83,109 @@ bool bloom_filter::is_present(const bytes_view& key) {
     return is_present(make_hashed_key(key));
 }
 
+// The odd constants used for picking a bit in each word of a block, see
+// "Split block Bloom filters" by Putze, Sanders and Singler, and the Parquet
+// bloom filter specification, which uses the same ones.
+static constexpr std::array<uint32_t, blocked_bloom_filter::hashes_per_block> block_salts = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U,
+};
+
+// The bit set for the key in the i-th 32-bit word of its block.
+static uint32_t block_word_bit(uint32_t key, int i) noexcept {
+    return (key * block_salts[i]) >> 27;
+}
+
+blocked_bloom_filter::blocked_bloom_filter(bitmap&& bs) noexcept
+    : bloom_filter(hashes_per_block, std::move(bs), filter_format::blocked_format)
+    , _nr_blocks(bits().size() / block_bits)
+{ }
+
+size_t blocked_bloom_filter::block_of(const hashed_key& key) const noexcept {
+    // Maps the hash uniformly to [0, nr_blocks) without a division.
+    return (static_cast<unsigned __int128>(key.hash()[0]) * _nr_blocks) >> 64;
+}
+
+const uint64_t* blocked_bloom_filter::block(size_t i) const noexcept {
+    // Blocks are aligned to their size and the bitset storage is split into chunks
+    // of a power-of-two size, so the words of a block are contiguous.
+    return &bits().get_storage()[i * words_per_block];
+}
+
+void blocked_bloom_filter::add(const bytes_view& key) {
+    add(make_hashed_key(key));
+}
+
+void blocked_bloom_filter::add(const hashed_key& key) {
+    auto first_bit = block_of(key) * block_bits;
+    auto k = static_cast<uint32_t>(key.hash()[1]);
+    for (int i = 0; i < hashes_per_block; ++i) {
+        bits().set(first_bit + i * 32 + block_word_bit(k, i));
+    }
+}
+
+bool blocked_bloom_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
+bool blocked_bloom_filter::is_present(hashed_key key) {
+    return block_has_key(block(block_of(key)), key);
+}
+
+bool blocked_bloom_filter::block_has_key(const uint64_t* block, const hashed_key& key) noexcept {
+    auto k = static_cast<uint32_t>(key.hash()[1]);
+#if defined(__AVX2__)
+    const auto salts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_salts.data()));
+    auto shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(k), salts), 27);
+    auto mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+    auto words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    // Present iff all the bits of the mask are set in the block.
+    return _mm256_testc_si256(words, mask);
+#else
+    for (int i = 0; i < hashes_per_block; ++i) {
+        auto word = static_cast<uint32_t>(block[i / 2] >> (32 * (i % 2)));
+        if (!(word & (uint32_t(1) << block_word_bit(k, i)))) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+double blocked_bloom_filter::false_positive_rate(double bits_per_element) {
+    // The number of keys in a block follows a Poisson distribution. With n keys
+    // in the block, a 32-bit word has a given bit set with probability
+    // 1 - (1 - 1/32)^n, and a probe must hit a set bit in all the words.
+    const double lambda = block_bits / bits_per_element;
+    const int max_keys = lambda + 10 * std::sqrt(lambda) + 10;
+    double p_keys = std::exp(-lambda);
+    double rate = 0;
+    for (int n = 0; n <= max_keys; ++n) {
+        if (n > 0) {
+            p_keys *= lambda / n;
+        }
+        rate += p_keys * std::pow(1 - std::pow(1 - 1.0 / 32, n), hashes_per_block);
+    }
+    return rate;
+}
+
+size_t blocked_bloom_filter::get_bitset_size(int64_t num_elements, double max_false_pos_prob) {
+    // Binary search for the smallest number of bits per element which provides the
+    // requested rate. Rates below what 64 bits per element can provide are capped.
+    double lo = 1;
+    double hi = 64;
+    for (int i = 0; i < 30; ++i) {
+        auto mid = (lo + hi) / 2;
+        if (false_positive_rate(mid) <= max_false_pos_prob) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    auto num_bits = static_cast<size_t>(std::ceil(std::max<int64_t>(num_elements, 1) * hi));
+    return align_up(num_bits, block_bits);
+}
+
 size_t get_bitset_size(int64_t num_elements, int buckets_per) {
     int64_t num_bits = (num_elements * buckets_per) + bloom_calculations::EXCESS;
     num_bits = align_up<int64_t>(num_bits, 64);  // Seems to be implied in origin
@@ -83,6 +193,12 @@ size_t get_bitset_size(int64_t num_elements, int buckets_per) {
 }
 
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format) {
+    if (format == filter_format::blocked_format) {
+        if (hash != blocked_bloom_filter::hashes_per_block || bitset.size() == 0 || bitset.size() % blocked_bloom_filter::block_bits) {
+            throw std::invalid_argument(seastar::format("Invalid blocked bloom filter with {} hashes and {} bits", hash, bitset.size()));
+        }
+        return std::make_unique<blocked_bloom_filter>(std::move(bitset));
+    }
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#include "utils/frequency_sketch.hh"
+
+namespace utils {
+
+static constexpr std::array<uint64_t, 4> seeds = {
+    0x97cb3127'2c1e2cd1ull,
+    0xc3a5c85c'97cb3127ull,
+    0xb492b66f'be98f273ull,
+    0x9ae16a3b'2f90404full,
+};
+
+// The murmur3 finalizer. Keys are often tokens, which are hashes already,
+// but each of the counters of a key has to be chosen independently.
+static uint64_t mix(uint64_t k) noexcept {
+    k ^= k >> 33;
+    k *= 0xff51afd7'ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe'1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+frequency_sketch::frequency_sketch(size_t nr_counters)
+    : _words(std::bit_ceil(std::max<size_t>(nr_counters, counters_per_word)) / counters_per_word)
+    , _word_mask(_words.size() - 1)
+    , _sample_size(10 * this->nr_counters())
+{ }
+
+frequency_sketch::counter_position frequency_sketch::position_of(uint64_t key, unsigned i) const noexcept {
+    static_assert(depth == seeds.size());
+    const uint64_t h = mix(key ^ seeds[i]);
+    // The top bits choose the counter in the word, the bottom ones the word.
+    return counter_position{h & _word_mask, unsigned(h >> 60) * 4};
+}
+
+void frequency_sketch::increment(uint64_t key) noexcept {
+    std::array<counter_position, depth> positions;
+    unsigned min = max_frequency;
+    for (unsigned i = 0; i < depth; ++i) {
+        positions[i] = position_of(key, i);
+        min = std::min(min, counter_at(positions[i]));
+    }
+    if (min == max_frequency) {
+        return;
+    }
+    for (auto p : positions) {
+        // Several positions may point at the same counter, which must be incremented once.
+        if (counter_at(p) == min) {
+            _words[p.word] += uint64_t(1) << p.shift;
+        }
+    }
+    if (++_additions == _sample_size) {
+        reset();
+    }
+}
+
+unsigned frequency_sketch::frequency(uint64_t key) const noexcept {
+    unsigned min = max_frequency;
+    for (unsigned i = 0; i < depth; ++i) {
+        min = std::min(min, counter_at(position_of(key, i)));
+    }
+    return min;
+}
+
+void frequency_sketch::reset() noexcept {
+    for (auto& w : _words) {
+        w = (w >> 1) & 0x7777'7777'7777'7777ull;
+    }
+    _additions /= 2;
+    ++_resets;
+}
+
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "utils/chunked_vector.hh"
+
+namespace utils {
+
+// Estimates how often keys were seen recently, in a fixed amount of memory.
+//
+// This is a count-min sketch with 4-bit counters, as used by the TinyLFU cache
+// admission policy. Each key is counted in `depth` counters, and its frequency is
+// estimated as the smallest of them, so the estimate can only be too high, never too
+// low. Counters are incremented conservatively (only the smallest ones are), which
+// keeps the estimates of infrequent keys lower.
+//
+// The sketch ages the counts: once the number of counted accesses reaches ten times
+// the number of counters, all the counters are halved. So frequencies reflect the
+// recent accesses, and keys which stop being accessed are forgotten.
+class frequency_sketch {
+public:
+    static constexpr unsigned max_frequency = 15;
+private:
+    static constexpr unsigned counters_per_word = 16;
+    static constexpr unsigned depth = 4;
+
+    utils::chunked_vector<uint64_t> _words;
+    size_t _word_mask;
+    size_t _sample_size;
+    size_t _additions = 0;
+    uint64_t _resets = 0;
+private:
+    struct counter_position {
+        size_t word;
+        unsigned shift;
+    };
+    counter_position position_of(uint64_t key, unsigned i) const noexcept;
+    unsigned counter_at(counter_position p) const noexcept {
+        return (_words[p.word] >> p.shift) & max_frequency;
+    }
+    void reset() noexcept;
+public:
+    // The number of counters is rounded up to a power of two, of at least counters_per_word.
+    explicit frequency_sketch(size_t nr_counters);
+
+    // Counts an access to the key.
+    void increment(uint64_t key) noexcept;
+
+    // The estimated number of recent accesses to the key, at most max_frequency.
+    unsigned frequency(uint64_t key) const noexcept;
+
+    size_t nr_counters() const noexcept {
+        return _words.size() * counters_per_word;
+    }
+    // The number of times the counters were halved.
+    uint64_t resets() const noexcept {
+        return _resets;
+    }
+    size_t memory_size() const noexcept {
+        return _words.memory_size();
+    }
+};
+
+}
@@ -28,16 +28,25 @@ filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_proba
         return std::make_unique<filter::always_present_filter>();
     }
 
+    if (fformat == filter_format::blocked_format) {
+        return std::make_unique<filter::blocked_bloom_filter>(
+                large_bitset(filter::blocked_bloom_filter::get_bitset_size(num_elements, max_false_pos_probability)));
+    }
+
     int buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
     auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, max_false_pos_probability);
     return filter::create_filter(spec.K, num_elements, spec.buckets_per_element, fformat);
 }
 
-size_t i_filter::get_filter_size(int64_t num_elements, double max_false_pos_probability) {
+size_t i_filter::get_filter_size(int64_t num_elements, double max_false_pos_probability, filter_format fformat) {
     if (max_false_pos_probability >= 1.0) {
         return 0;
     }
 
+    if (fformat == filter_format::blocked_format) {
+        return filter::blocked_bloom_filter::get_bitset_size(num_elements, max_false_pos_probability) / 8;
+    }
+
     int buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
     auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, max_false_pos_probability);
 
@@ -20,6 +20,9 @@ using filter_ptr = std::unique_ptr<i_filter>;
 enum class filter_format {
     k_l_format,
     m_format,
+    // Split-block filter: all the bits of a key are in a single 256-bit block.
+    // See utils::filter::blocked_bloom_filter.
+    blocked_format,
 };
 
 class hashed_key {
@@ -57,6 +60,6 @@ struct i_filter {
     /**
      * @return the size of the smallest filter (in bytes), according to the conditions described at get_filter()
      */
-    static size_t get_filter_size(int64_t num_elements, double max_false_pos_prob);
+    static size_t get_filter_size(int64_t num_elements, double max_false_pos_prob, filter_format format = filter_format::m_format);
 };
 }
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "utils/assert.hh"
+#include <algorithm>
 #include <boost/intrusive/list.hpp>
 #include <seastar/core/memory.hh>
 
@@ -32,6 +33,8 @@ class evictable {
     static_assert(std::is_nothrow_constructible_v<lru_link_type, lru_link_type&&>);
 private:
     lru_link_type _lru_link;
+    // Whether the evictable is in the protected segment of the lru.
+    bool _protected = false;
 protected:
     // Prevent destruction via evictable pointer. LRU is not aware of allocation strategy.
     // Prevent destruction of a linked evictable. While we could unlink the evictable here
@@ -54,6 +57,7 @@ class evictable {
 
     void swap(evictable& o) noexcept {
         _lru_link.swap_nodes(o._lru_link);
+        std::swap(_protected, o._protected);
     }
 
     virtual bool is_index() const noexcept {
@@ -77,12 +81,28 @@ class index_evictable : public evictable {
 };
 
 // Implements LRU cache replacement for row cache and sstable index cache.
+//
+// Optionally, the LRU is segmented (SLRU). Elements are added to the probationary
+// segment, and move to the protected segment when touched, that is when they're used
+// again. Elements are evicted from the probationary segment first, so that elements
+// which are used only once, like those read by scans, don't evict the ones which are
+// used repeatedly. The protected segment holds at most protected_fraction of the
+// elements. When it grows larger, its least recently used elements are moved back
+// to the probationary segment, where they're the most recently used ones.
+//
+// With protected_fraction == 0, the default, the protected segment is always empty,
+// and this is a plain LRU.
 class lru {
 private:
     using lru_type = boost::intrusive::list<evictable,
         boost::intrusive::member_hook<evictable, evictable::lru_link_type, &evictable::_lru_link>,
         boost::intrusive::constant_time_size<false>>; // we need this to have bi::auto_unlink on hooks.
     lru_type _list;
+    lru_type _protected_list;
+    // The lists can't keep their sizes, because of bi::auto_unlink.
+    size_t _size = 0;
+    size_t _protected_size = 0;
+    double _protected_fraction = 0;
 
     // See the comment to index_evictable.
     using index_lru_type = boost::intrusive::list<index_evictable,
@@ -92,17 +112,49 @@ class lru {
 
     using reclaiming_result = seastar::memory::reclaiming_result;
 
+    lru_type& list_of(const evictable& e) noexcept {
+        return e._protected ? _protected_list : _list;
+    }
+
+    // Moves the least recently used protected elements to the probationary segment,
+    // while the protected segment is too large. Moves a bounded number of elements,
+    // so that it doesn't stall when many probationary elements were just evicted;
+    // the segment shrinks back over the following calls.
+    void shrink_protected() noexcept {
+        for (int i = 0; i < 2 && _protected_size > _protected_fraction * _size; ++i) {
+            evictable& e = _protected_list.front();
+            _protected_list.pop_front();
+            e._protected = false;
+            --_protected_size;
+            _list.push_back(e);
+        }
+    }
 public:
     ~lru() {
-        while (!_list.empty()) {
-            evictable& e = _list.front();
-            remove(e);
-            e.on_evicted();
+        for (auto* l : {&_list, &_protected_list}) {
+            while (!l->empty()) {
+                evictable& e = l->front();
+                remove(e);
+                e.on_evicted();
+            }
         }
     }
 
+    // Sets the maximum fraction of the elements kept in the protected segment.
+    // Must be called before any element is added.
+    void set_protected_fraction(double fraction) noexcept {
+        SCYLLA_ASSERT(!_size);
+        _protected_fraction = std::clamp(fraction, 0.0, 1.0);
+    }
+
     void remove(evictable& e) noexcept {
-        _list.erase(_list.iterator_to(e));
+        auto& l = list_of(e);
+        l.erase(l.iterator_to(e));
+        --_size;
+        if (e._protected) {
+            e._protected = false;
+            --_protected_size;
+        }
         if (e.is_index()) {
             _index_list.erase(_index_list.iterator_to(static_cast<index_evictable&>(e)));
         }
@@ -110,28 +162,52 @@ class lru {
 
     void add(evictable& e) noexcept {
         _list.push_back(e);
+        ++_size;
         if (e.is_index()) {
             _index_list.push_back(static_cast<index_evictable&>(e));
         }
     }
 
+    // Like add(e), but makes sure that e is evicted after all the elements which are
+    // currently in the LRU, in the absence of later touches.
+    void add_last(evictable& e) noexcept {
+        if (!_protected_fraction) {
+            add(e);
+            return;
+        }
+        _protected_list.push_back(e);
+        e._protected = true;
+        ++_size;
+        ++_protected_size;
+        if (e.is_index()) {
+            _index_list.push_back(static_cast<index_evictable&>(e));
+        }
+        shrink_protected();
+    }
+
     // Like add(e) but makes sure that e is evicted right before "more_recent" in the absence of later touches.
     void add_before(evictable& more_recent, evictable& e) noexcept {
-        _list.insert(_list.iterator_to(more_recent), e);
+        auto& l = list_of(more_recent);
+        l.insert(l.iterator_to(more_recent), e);
+        e._protected = more_recent._protected;
+        ++_size;
+        _protected_size += e._protected;
     }
 
     void touch(evictable& e) noexcept {
         remove(e);
-        add(e);
+        add_last(e);
     }
 
     // Evicts a single element from the LRU
     template <bool Shallow = false>
     reclaiming_result do_evict(bool should_evict_index) noexcept {
-        if (_list.empty()) {
+        if (!_size) {
             return reclaiming_result::reclaimed_nothing;
         }
-        evictable& e = (should_evict_index && !_index_list.empty()) ? _index_list.front() : _list.front();
+        evictable& e = (should_evict_index && !_index_list.empty()) ? _index_list.front()
+                : !_list.empty() ? _list.front()
+                : _protected_list.front();
         remove(e);
         if constexpr (!Shallow) {
             e.on_evicted();
@@ -157,4 +233,11 @@ class lru {
     void evict_all() {
         while (evict() == reclaiming_result::reclaimed_something) {}
     }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+    size_t protected_size() const noexcept {
+        return _protected_size;
+    }
 };
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2025-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#include "vector_search/hnsw_index.hh"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <ranges>
+#include <stdexcept>
+#include <unordered_set>
+#include <fmt/format.h>
+
+namespace vector_search {
+
+// Caps the height of the graph. With the default of 16 connections per node
+// the expected number of nodes needed to reach this level is 16^16.
+static constexpr unsigned max_level = 16;
+
+hnsw_index::hnsw_index(size_t dimension, similarity_function similarity, config cfg, std::default_random_engine::result_type seed)
+    : _dimension(dimension)
+    , _similarity(similarity)
+    , _cfg(cfg)
+    , _level_multiplier(1.0 / std::log(std::max(2u, cfg.max_node_connections)))
+    , _rng(seed) {
+    if (_cfg.max_node_connections < 2) {
+        throw std::invalid_argument("HNSW index requires at least 2 connections per node");
+    }
+}
+
+unsigned hnsw_index::random_level() {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    // 1 - u is in (0, 1], so the logarithm is finite.
+    auto level = static_cast<unsigned>(-std::log(1.0 - dist(_rng)) * _level_multiplier);
+    return std::min(level, max_level);
+}
+
+unsigned hnsw_index::max_connections(unsigned level) const noexcept {
+    return level == 0 ? 2 * _cfg.max_node_connections : _cfg.max_node_connections;
+}
+
+float hnsw_index::similarity(std::span<const float> query, node_id id) const {
+    return _similarity(query, _nodes[id].vector);
+}
+
+hnsw_index::node_id hnsw_index::greedy_search(std::span<const float> query, node_id entry, unsigned from_level, unsigned to_level) const {
+    auto best = entry;
+    auto best_similarity = similarity(query, best);
+    for (int level = from_level; level >= int(to_level); --level) {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (auto n : _nodes[best].neighbours[level]) {
+                auto s = similarity(query, n);
+                if (s > best_similarity) {
+                    best = n;
+                    best_similarity = s;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+// Removed nodes are still visited, to keep the graph navigable, but with
+// skip_deleted they don't take any of the ef result slots.
+std::vector<hnsw_index::candidate> hnsw_index::search_layer(std::span<const float> query, node_id entry, unsigned ef, unsigned level, bool skip_deleted) const {
+    auto more_similar = [] (const candidate& a, const candidate& b) { return a.similarity > b.similarity; };
+    auto less_similar = [] (const candidate& a, const candidate& b) { return a.similarity < b.similarity; };
+    // Best candidate on top, to be expanded next.
+    std::priority_queue<candidate, std::vector<candidate>, decltype(less_similar)> to_visit(less_similar);
+    // Worst result on top, to be evicted once there are more than ef results.
+    std::priority_queue<candidate, std::vector<candidate>, decltype(more_similar)> found(more_similar);
+    std::unordered_set<node_id> visited;
+
+    candidate start{similarity(query, entry), entry};
+    auto is_result = [&] (node_id id) { return !skip_deleted || !_nodes[id].deleted; };
+    visited.insert(entry);
+    to_visit.push(start);
+    if (is_result(entry)) {
+        found.push(start);
+    }
+
+    while (!to_visit.empty()) {
+        auto current = to_visit.top();
+        if (found.size() >= ef && current.similarity < found.top().similarity) {
+            break;
+        }
+        to_visit.pop();
+        for (auto n : _nodes[current.id].neighbours[level]) {
+            if (!visited.insert(n).second) {
+                continue;
+            }
+            auto s = similarity(query, n);
+            if (found.size() < ef || s > found.top().similarity) {
+                to_visit.push({s, n});
+                if (is_result(n)) {
+                    found.push({s, n});
+                    if (found.size() > ef) {
+                        found.pop();
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<candidate> ret;
+    ret.reserve(found.size());
+    while (!found.empty()) {
+        ret.push_back(found.top());
+        found.pop();
+    }
+    std::ranges::reverse(ret);
+    return ret;
+}
+
+// The neighbour selection heuristic from the HNSW paper: a candidate is only
+// linked if it is closer to the base node than to any already selected
+// neighbour. This keeps links spread out in different directions, which
+// matters for clustered data. Pruned candidates fill up the remaining slots.
+std::vector<hnsw_index::node_id> hnsw_index::select_neighbours(std::vector<candidate> candidates, unsigned m) const {
+    std::ranges::sort(candidates, [] (const candidate& a, const candidate& b) { return a.similarity > b.similarity; });
+    std::vector<node_id> selected;
+    std::vector<node_id> pruned;
+    selected.reserve(m);
+    for (const auto& c : candidates) {
+        if (selected.size() >= m) {
+            break;
+        }
+        bool diverse = std::ranges::all_of(selected, [&] (node_id s) {
+            return _similarity(_nodes[c.id].vector, _nodes[s].vector) < c.similarity;
+        });
+        (diverse ? selected : pruned).push_back(c.id);
+    }
+    for (auto id : pruned) {
+        if (selected.size() >= m) {
+            break;
+        }
+        selected.push_back(id);
+    }
+    return selected;
+}
+
+void hnsw_index::connect(node_id from, node_id to, unsigned level) {
+    auto& adjacent = _nodes[from].neighbours[level];
+    adjacent.push_back(to);
+    auto m = max_connections(level);
+    if (adjacent.size() <= m) {
+        return;
+    }
+    std::vector<candidate> candidates;
+    candidates.reserve(adjacent.size());
+    for (auto n : adjacent) {
+        candidates.push_back({similarity(_nodes[from].vector, n), n});
+    }
+    _nodes[from].neighbours[level] = select_neighbours(std::move(candidates), m);
+}
+
+void hnsw_index::insert(label_type label, std::span<const float> vector) {
+    if (vector.size() != _dimension) {
+        throw std::invalid_argument(fmt::format("HNSW index expects vectors of dimension {}, got {}", _dimension, vector.size()));
+    }
+    remove(label);
+
+    auto id = node_id(_nodes.size());
+    auto level = random_level();
+    _nodes.push_back(node{
+        .label = label,
+        .vector = std::vector<float>(vector.begin(), vector.end()),
+        .neighbours = std::vector<std::vector<node_id>>(level + 1),
+    });
+    _labels.emplace(label, id);
+    ++_live_nodes;
+
+    if (!_entry_point) {
+        _entry_point = id;
+        return;
+    }
+
+    auto entry = *_entry_point;
+    unsigned top_level = _nodes[entry].neighbours.size() - 1;
+    if (top_level > level) {
+        entry = greedy_search(vector, entry, top_level, level + 1);
+    }
+    for (int l = std::min(level, top_level); l >= 0; --l) {
+        auto candidates = search_layer(vector, entry, std::max(_cfg.construction_beam_width, max_connections(l)), l);
+        entry = candidates.front().id;
+        for (auto n : select_neighbours(std::move(candidates), max_connections(l))) {
+            connect(id, n, l);
+            connect(n, id, l);
+        }
+    }
+    if (level > top_level) {
+        _entry_point = id;
+    }
+}
+
+bool hnsw_index::remove(label_type label) {
+    auto it = _labels.find(label);
+    if (it == _labels.end()) {
+        return false;
+    }
+    _nodes[it->second].deleted = true;
+    _labels.erase(it);
+    --_live_nodes;
+    return true;
+}
+
+std::vector<hnsw_index::result> hnsw_index::search(std::span<const float> query, size_t k, std::optional<unsigned> beam_width) const {
+    if (query.size() != _dimension) {
+        throw std::invalid_argument(fmt::format("HNSW index expects vectors of dimension {}, got {}", _dimension, query.size()));
+    }
+    std::vector<result> ret;
+    if (!_entry_point || k == 0 || _live_nodes == 0) {
+        return ret;
+    }
+
+    auto entry = *_entry_point;
+    unsigned top_level = _nodes[entry].neighbours.size() - 1;
+    if (top_level > 0) {
+        entry = greedy_search(query, entry, top_level, 1);
+    }
+    auto ef = std::max<size_t>(beam_width.value_or(_cfg.search_beam_width), k);
+    auto candidates = search_layer(query, entry, ef, 0, true);
+
+    ret.reserve(std::min(k, candidates.size()));
+    for (const auto& c : candidates | std::views::take(k)) {
+        ret.push_back({_nodes[c.id].label, c.similarity});
+    }
+    return ret;
+}
+
+float hnsw_index::deleted_ratio() const noexcept {
+    if (_nodes.empty()) {
+        return 0.0f;
+    }
+    return 1.0f - float(_live_nodes) / float(_nodes.size());
+}
+
+} // namespace vector_search
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2025-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: LicenseRef-ScyllaDB-Source-Available-1.1
+ */
+
+#pragma once
+
+#include "utils/chunked_vector.hh"
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace vector_search {
+
+/// An in-process Hierarchical Navigable Small World (HNSW) graph over float
+/// vectors, used to answer ANN queries on the replica without a round trip
+/// to the external vector store.
+///
+/// Each vector is identified by an opaque 64-bit label chosen by the caller
+/// (e.g. a position in a per-tablet key table). The index is not thread-safe
+/// and performs no I/O; it is meant to be owned by a single shard.
+///
+/// Similarity follows the vector store (and CQL similarity_* functions)
+/// convention: higher value means more similar.
+class hnsw_index {
+public:
+    using label_type = uint64_t;
+    using similarity_function = float (*)(std::span<const float>, std::span<const float>);
+
+    struct config {
+        /// Maximum number of neighbours of a node on the upper layers.
+        /// Layer 0 allows twice as many. Corresponds to the
+        /// 'maximum_node_connections' vector index option.
+        unsigned max_node_connections = 16;
+        /// Size of the dynamic candidate list used while inserting.
+        /// Corresponds to the 'construction_beam_width' vector index option.
+        unsigned construction_beam_width = 128;
+        /// Default size of the dynamic candidate list used while searching.
+        /// Corresponds to the 'search_beam_width' vector index option.
+        unsigned search_beam_width = 64;
+    };
+
+    struct result {
+        label_type label;
+        float similarity;
+    };
+
+private:
+    using node_id = uint32_t;
+
+    struct node {
+        label_type label;
+        std::vector<float> vector;
+        // neighbours[level] holds the adjacency list on the given layer.
+        std::vector<std::vector<node_id>> neighbours;
+        bool deleted = false;
+    };
+
+    struct candidate {
+        float similarity;
+        node_id id;
+    };
+
+    size_t _dimension;
+    similarity_function _similarity;
+    config _cfg;
+    double _level_multiplier;
+    std::default_random_engine _rng;
+    utils::chunked_vector<node> _nodes;
+    std::unordered_map<label_type, node_id> _labels;
+    std::optional<node_id> _entry_point;
+    size_t _live_nodes = 0;
+
+public:
+    hnsw_index(size_t dimension, similarity_function similarity, config cfg, std::default_random_engine::result_type seed = std::default_random_engine::default_seed);
+
+    size_t dimension() const noexcept { return _dimension; }
+
+    /// Number of live (not removed) vectors in the index.
+    size_t size() const noexcept { return _live_nodes; }
+    bool empty() const noexcept { return _live_nodes == 0; }
+
+    /// Insert a vector under the given label. If the label is already present,
+    /// the old vector is removed first.
+    /// Throws std::invalid_argument if the vector dimension does not match.
+    void insert(label_type label, std::span<const float> vector);
+
+    /// Remove the vector with the given label. Removed vectors stay in the
+    /// graph to keep it navigable, but are never returned by search().
+    /// Returns false if the label is not present.
+    bool remove(label_type label);
+
+    /// Return up to k labels most similar to the query, in decreasing
+    /// similarity order. beam_width defaults to the configured
+    /// search_beam_width and is raised to k if smaller.
+    std::vector<result> search(std::span<const float> query, size_t k, std::optional<unsigned> beam_width = std::nullopt) const;
+
+    /// Fraction of graph nodes that are tombstones. The owner should rebuild
+    /// the index (e.g. when the underlying sstables are compacted) once this
+    /// grows large, as tombstones still cost traversal time.
+    float deleted_ratio() const noexcept;
+
+private:
+    unsigned random_level();
+    unsigned max_connections(unsigned level) const noexcept;
+    float similarity(std::span<const float> query, node_id id) const;
+    node_id greedy_search(std::span<const float> query, node_id entry, unsigned from_level, unsigned to_level) const;
+    std::vector<candidate> search_layer(std::span<const float> query, node_id entry, unsigned ef, unsigned level, bool skip_deleted = false) const;
+    std::vector<node_id> select_neighbours(std::vector<candidate> candidates, unsigned m) const;
+    void connect(node_id from, node_id to, unsigned level);
+};
+
+} // namespace vector_search